@@ -24,6 +24,9 @@ PB_BIND(monado_metrics_SystemGpuInfo, monado_metrics_SystemGpuInfo, AUTO)
 PB_BIND(monado_metrics_SystemPresentInfo, monado_metrics_SystemPresentInfo, AUTO)
 
 
+PB_BIND(monado_metrics_DevicePrediction, monado_metrics_DevicePrediction, AUTO)
+
+
 PB_BIND(monado_metrics_Record, monado_metrics_Record, AUTO)
 
 
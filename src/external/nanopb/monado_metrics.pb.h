@@ -73,6 +73,21 @@ typedef struct _monado_metrics_SystemPresentInfo {
     uint64_t earliest_present_time_ns;
 } monado_metrics_SystemPresentInfo;
 
+typedef struct _monado_metrics_DevicePrediction {
+    char device_name[64];
+    uint64_t when_ns;
+    uint64_t exact_count;
+    uint64_t interpolated_count;
+    uint64_t predicted_count;
+    uint64_t reverse_predicted_count;
+    int64_t horizon_mean_ns;
+    int64_t horizon_max_ns;
+    int64_t extrapolation_mean_ns;
+    int64_t extrapolation_max_ns;
+    int64_t sample_age_mean_ns;
+    int64_t sample_age_max_ns;
+} monado_metrics_DevicePrediction;
+
 typedef struct _monado_metrics_Record {
     pb_size_t which_record;
     union {
@@ -82,6 +97,7 @@ typedef struct _monado_metrics_Record {
         monado_metrics_SystemFrame system_frame;
         monado_metrics_SystemGpuInfo system_gpu_info;
         monado_metrics_SystemPresentInfo system_present_info;
+        monado_metrics_DevicePrediction device_prediction;
     } record;
 } monado_metrics_Record;
 
@@ -97,6 +113,7 @@ extern "C" {
 #define monado_metrics_SystemFrame_init_default  {0, 0, 0, 0, 0, 0}
 #define monado_metrics_SystemGpuInfo_init_default {0, 0, 0, 0}
 #define monado_metrics_SystemPresentInfo_init_default {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define monado_metrics_DevicePrediction_init_default {"", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
 #define monado_metrics_Record_init_default       {0, {monado_metrics_Version_init_default}}
 #define monado_metrics_Version_init_zero         {0, 0}
 #define monado_metrics_SessionFrame_init_zero    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
@@ -104,6 +121,7 @@ extern "C" {
 #define monado_metrics_SystemFrame_init_zero     {0, 0, 0, 0, 0, 0}
 #define monado_metrics_SystemGpuInfo_init_zero   {0, 0, 0, 0}
 #define monado_metrics_SystemPresentInfo_init_zero {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define monado_metrics_DevicePrediction_init_zero {"", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
 #define monado_metrics_Record_init_zero          {0, {monado_metrics_Version_init_zero}}
 
 /* Field tags (for use in manual encoding/decoding) */
@@ -152,12 +170,25 @@ extern "C" {
 #define monado_metrics_SystemPresentInfo_present_margin_ns_tag 13
 #define monado_metrics_SystemPresentInfo_actual_present_time_ns_tag 14
 #define monado_metrics_SystemPresentInfo_earliest_present_time_ns_tag 15
+#define monado_metrics_DevicePrediction_device_name_tag 1
+#define monado_metrics_DevicePrediction_when_ns_tag 2
+#define monado_metrics_DevicePrediction_exact_count_tag 3
+#define monado_metrics_DevicePrediction_interpolated_count_tag 4
+#define monado_metrics_DevicePrediction_predicted_count_tag 5
+#define monado_metrics_DevicePrediction_reverse_predicted_count_tag 6
+#define monado_metrics_DevicePrediction_horizon_mean_ns_tag 7
+#define monado_metrics_DevicePrediction_horizon_max_ns_tag 8
+#define monado_metrics_DevicePrediction_extrapolation_mean_ns_tag 9
+#define monado_metrics_DevicePrediction_extrapolation_max_ns_tag 10
+#define monado_metrics_DevicePrediction_sample_age_mean_ns_tag 11
+#define monado_metrics_DevicePrediction_sample_age_max_ns_tag 12
 #define monado_metrics_Record_version_tag        1
 #define monado_metrics_Record_session_frame_tag  2
 #define monado_metrics_Record_used_tag           3
 #define monado_metrics_Record_system_frame_tag   4
 #define monado_metrics_Record_system_gpu_info_tag 5
 #define monado_metrics_Record_system_present_info_tag 6
+#define monado_metrics_Record_device_prediction_tag 7
 
 /* Struct field encoding specification for nanopb */
 #define monado_metrics_Version_FIELDLIST(X, a) \
@@ -229,13 +260,30 @@ X(a, STATIC,   SINGULAR, UINT64,   earliest_present_time_ns,  15)
 #define monado_metrics_SystemPresentInfo_CALLBACK NULL
 #define monado_metrics_SystemPresentInfo_DEFAULT NULL
 
+#define monado_metrics_DevicePrediction_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, STRING,   device_name,       1) \
+X(a, STATIC,   SINGULAR, UINT64,   when_ns,           2) \
+X(a, STATIC,   SINGULAR, UINT64,   exact_count,       3) \
+X(a, STATIC,   SINGULAR, UINT64,   interpolated_count,   4) \
+X(a, STATIC,   SINGULAR, UINT64,   predicted_count,   5) \
+X(a, STATIC,   SINGULAR, UINT64,   reverse_predicted_count,   6) \
+X(a, STATIC,   SINGULAR, INT64,    horizon_mean_ns,   7) \
+X(a, STATIC,   SINGULAR, INT64,    horizon_max_ns,    8) \
+X(a, STATIC,   SINGULAR, INT64,    extrapolation_mean_ns,   9) \
+X(a, STATIC,   SINGULAR, INT64,    extrapolation_max_ns,  10) \
+X(a, STATIC,   SINGULAR, INT64,    sample_age_mean_ns,  11) \
+X(a, STATIC,   SINGULAR, INT64,    sample_age_max_ns,  12)
+#define monado_metrics_DevicePrediction_CALLBACK NULL
+#define monado_metrics_DevicePrediction_DEFAULT NULL
+
 #define monado_metrics_Record_FIELDLIST(X, a) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (record,version,record.version),   1) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (record,session_frame,record.session_frame),   2) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (record,used,record.used),   3) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (record,system_frame,record.system_frame),   4) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (record,system_gpu_info,record.system_gpu_info),   5) \
-X(a, STATIC,   ONEOF,    MESSAGE,  (record,system_present_info,record.system_present_info),   6)
+X(a, STATIC,   ONEOF,    MESSAGE,  (record,system_present_info,record.system_present_info),   6) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (record,device_prediction,record.device_prediction),   7)
 #define monado_metrics_Record_CALLBACK NULL
 #define monado_metrics_Record_DEFAULT NULL
 #define monado_metrics_Record_record_version_MSGTYPE monado_metrics_Version
@@ -244,6 +292,7 @@ X(a, STATIC,   ONEOF,    MESSAGE,  (record,system_present_info,record.system_pre
 #define monado_metrics_Record_record_system_frame_MSGTYPE monado_metrics_SystemFrame
 #define monado_metrics_Record_record_system_gpu_info_MSGTYPE monado_metrics_SystemGpuInfo
 #define monado_metrics_Record_record_system_present_info_MSGTYPE monado_metrics_SystemPresentInfo
+#define monado_metrics_Record_record_device_prediction_MSGTYPE monado_metrics_DevicePrediction
 
 extern const pb_msgdesc_t monado_metrics_Version_msg;
 extern const pb_msgdesc_t monado_metrics_SessionFrame_msg;
@@ -251,6 +300,7 @@ extern const pb_msgdesc_t monado_metrics_Used_msg;
 extern const pb_msgdesc_t monado_metrics_SystemFrame_msg;
 extern const pb_msgdesc_t monado_metrics_SystemGpuInfo_msg;
 extern const pb_msgdesc_t monado_metrics_SystemPresentInfo_msg;
+extern const pb_msgdesc_t monado_metrics_DevicePrediction_msg;
 extern const pb_msgdesc_t monado_metrics_Record_msg;
 
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
@@ -260,10 +310,12 @@ extern const pb_msgdesc_t monado_metrics_Record_msg;
 #define monado_metrics_SystemFrame_fields &monado_metrics_SystemFrame_msg
 #define monado_metrics_SystemGpuInfo_fields &monado_metrics_SystemGpuInfo_msg
 #define monado_metrics_SystemPresentInfo_fields &monado_metrics_SystemPresentInfo_msg
+#define monado_metrics_DevicePrediction_fields &monado_metrics_DevicePrediction_msg
 #define monado_metrics_Record_fields &monado_metrics_Record_msg
 
 /* Maximum encoded size of messages (where known) */
-#define monado_metrics_Record_size               168
+#define monado_metrics_DevicePrediction_size     186
+#define monado_metrics_Record_size               189
 #define monado_metrics_SessionFrame_size         145
 #define monado_metrics_SystemFrame_size          66
 #define monado_metrics_SystemGpuInfo_size        44
@@ -0,0 +1,285 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Skew aware clock offset estimator.
+ * @author agent <agent@local>
+ * @ingroup aux_math
+ */
+
+#include "math/m_api.h"
+#include "math/m_clock_offset.h"
+#include "math/m_mathinclude.h"
+
+#include "util/u_misc.h"
+#include "util/u_var.h"
+
+
+/*!
+ * Need at least this many completed buckets before fitting a skew, with less
+ * the line is too short to say anything about the slope.
+ */
+#define MIN_SKEW_BUCKETS 4
+
+/*!
+ * Real clocks are well within this, anything bigger is a bad fit.
+ */
+#define MAX_SKEW (1000.0 / 1000000.0)
+
+/*!
+ * The host can not see an event before it happened, a sample this far below
+ * the line means that one of the clocks has jumped.
+ */
+#define NEGATIVE_RESET_NS (U_TIME_1MS_IN_NS * 5)
+
+/*!
+ * Delay spikes this large are ignored, but if they keep coming the device
+ * clock has probably jumped forward.
+ */
+#define OUTLIER_NS (U_TIME_1MS_IN_NS * 100)
+#define OUTLIER_RESET_COUNT 16
+
+//! Weight of new samples in the running delay statistics.
+#define STATS_ALPHA 0.01
+
+
+/*
+ *
+ * Helper functions.
+ *
+ */
+
+struct point
+{
+	double x, y;
+};
+
+static inline double
+cross(struct point o, struct point a, struct point b)
+{
+	return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+static inline time_duration_ns
+fit_offset(const struct m_clock_offset_estimator *est, timepoint_ns a)
+{
+	if (!est->fit.valid) {
+		return 0;
+	}
+
+	return est->fit.ref_a2b + (time_duration_ns)llround(est->fit.skew * (double)(a - est->fit.ref_a));
+}
+
+static void
+push_bucket(struct m_clock_offset_estimator *est, struct m_clock_offset_sample sample)
+{
+	uint32_t index = (est->bucket_head + est->bucket_count) % M_CLOCK_OFFSET_WINDOW_SIZE;
+	est->buckets[index] = sample;
+
+	if (est->bucket_count < M_CLOCK_OFFSET_WINDOW_SIZE) {
+		est->bucket_count++;
+	} else {
+		est->bucket_head = (est->bucket_head + 1) % M_CLOCK_OFFSET_WINDOW_SIZE;
+	}
+}
+
+static void
+refit(struct m_clock_offset_estimator *est)
+{
+	struct point points[M_CLOCK_OFFSET_WINDOW_SIZE + 1];
+	uint32_t count = 0;
+
+	// Everything relative to the newest point to keep the doubles precise.
+	const struct m_clock_offset_sample ref = est->current;
+
+	for (uint32_t i = 0; i < est->bucket_count; i++) {
+		const struct m_clock_offset_sample *s = &est->buckets[(est->bucket_head + i) % M_CLOCK_OFFSET_WINDOW_SIZE];
+		points[count++] = (struct point){(double)(s->a - ref.a), (double)(s->a2b - ref.a2b)};
+	}
+	points[count++] = (struct point){0.0, 0.0};
+
+	double skew = 0.0;
+
+	if (est->bucket_count >= MIN_SKEW_BUCKETS) {
+		// Lower convex hull, the points are already sorted on x.
+		struct point hull[M_CLOCK_OFFSET_WINDOW_SIZE + 1];
+		uint32_t hull_count = 0;
+		double x_mean = 0.0;
+
+		for (uint32_t i = 0; i < count; i++) {
+			while (hull_count >= 2 && cross(hull[hull_count - 2], hull[hull_count - 1], points[i]) <= 0.0) {
+				hull_count--;
+			}
+			hull[hull_count++] = points[i];
+			x_mean += points[i].x;
+		}
+		x_mean /= (double)count;
+
+		/*
+		 * Of all lines below every point the one that minimises the sum
+		 * of distances to them goes through the hull edge spanning the
+		 * mean of x.
+		 */
+		for (uint32_t i = 0; i + 1 < hull_count; i++) {
+			if (hull[i + 1].x >= x_mean) {
+				skew = (hull[i + 1].y - hull[i].y) / (hull[i + 1].x - hull[i].x);
+				break;
+			}
+		}
+
+		skew = CLAMP(skew, -MAX_SKEW, MAX_SKEW);
+	}
+
+	// Put the line under all of the points, for a hull edge it goes through it.
+	double c = points[0].y - skew * points[0].x;
+	for (uint32_t i = 1; i < count; i++) {
+		c = MIN(c, points[i].y - skew * points[i].x);
+	}
+
+	double residual = 0.0;
+	for (uint32_t i = 0; i < count; i++) {
+		residual += points[i].y - (c + skew * points[i].x);
+	}
+
+	est->fit.ref_a = ref.a;
+	est->fit.ref_a2b = ref.a2b + (time_duration_ns)llround(c);
+	est->fit.skew = skew;
+	est->fit.valid = true;
+
+	est->stats.skew_ppm = (float)(skew * 1000000.0);
+	est->stats.fit_residual_us = (float)(residual / (double)count / 1000.0);
+}
+
+static void
+update_stats(struct m_clock_offset_estimator *est, timepoint_ns a, time_duration_ns a2b)
+{
+	time_duration_ns offset = fit_offset(est, a);
+	double delay_us = (double)(a2b - offset) / 1000.0;
+
+	if (est->stats.sample_count == 1) {
+		est->stats.delay_mean_us = (float)delay_us;
+		est->stats.delay_var_us2 = 0.0;
+	} else {
+		double diff = delay_us - est->stats.delay_mean_us;
+		double mean = est->stats.delay_mean_us + STATS_ALPHA * diff;
+		est->stats.delay_var_us2 = (1.0 - STATS_ALPHA) * (est->stats.delay_var_us2 + STATS_ALPHA * diff * diff);
+		est->stats.delay_mean_us = (float)mean;
+	}
+
+	est->stats.jitter_us = (float)sqrt(est->stats.delay_var_us2);
+	est->stats.offset_ns = offset;
+}
+
+
+/*
+ *
+ * 'Exported' functions.
+ *
+ */
+
+void
+m_clock_offset_estimator_init(struct m_clock_offset_estimator *est, time_duration_ns bucket_ns)
+{
+	U_ZERO(est);
+
+	est->bucket_ns = bucket_ns > 0 ? bucket_ns : M_CLOCK_OFFSET_DEFAULT_BUCKET_NS;
+}
+
+void
+m_clock_offset_estimator_reset(struct m_clock_offset_estimator *est)
+{
+	est->bucket_head = 0;
+	est->bucket_count = 0;
+	est->has_current = false;
+	est->outlier_count = 0;
+	est->fit.valid = false;
+}
+
+timepoint_ns
+m_clock_offset_estimator_update(struct m_clock_offset_estimator *est, timepoint_ns a, timepoint_ns b)
+{
+	const struct m_clock_offset_sample sample = {a, b - a};
+	bool reset = false;
+
+	est->stats.sample_count++;
+
+	// The device clock went backwards.
+	if (est->has_current && a < est->last.a) {
+		reset = true;
+	}
+
+	if (!reset && est->fit.valid) {
+		time_duration_ns residual = sample.a2b - fit_offset(est, a);
+
+		if (residual < -NEGATIVE_RESET_NS) {
+			reset = true;
+		} else if (residual > OUTLIER_NS) {
+			reset = ++est->outlier_count > OUTLIER_RESET_COUNT;
+		} else {
+			est->outlier_count = 0;
+		}
+	}
+
+	if (reset) {
+		m_clock_offset_estimator_reset(est);
+		est->stats.reset_count++;
+	}
+
+	est->last = sample;
+
+	bool changed = false;
+	if (!est->has_current) {
+		est->current = sample;
+		est->current_start = a;
+		est->has_current = true;
+		changed = true;
+	} else if (a - est->current_start >= est->bucket_ns) {
+		push_bucket(est, est->current);
+		est->current = sample;
+		est->current_start = a;
+		changed = true;
+	} else if (sample.a2b < est->current.a2b) {
+		est->current = sample;
+		changed = true;
+	}
+
+	if (changed) {
+		refit(est);
+	}
+
+	update_stats(est, a, sample.a2b);
+
+	return a + fit_offset(est, a);
+}
+
+timepoint_ns
+m_clock_offset_estimator_a2b(const struct m_clock_offset_estimator *est, timepoint_ns a)
+{
+	return a + fit_offset(est, a);
+}
+
+timepoint_ns
+m_clock_offset_estimator_b2a(const struct m_clock_offset_estimator *est, timepoint_ns b)
+{
+	if (!est->fit.valid) {
+		return b;
+	}
+
+	// Solve b = a + ref_a2b + skew * (a - ref_a) for a.
+	double rel = (double)(b - est->fit.ref_a2b - est->fit.ref_a) / (1.0 + est->fit.skew);
+
+	return est->fit.ref_a + (timepoint_ns)llround(rel);
+}
+
+void
+m_clock_offset_estimator_add_vars(struct m_clock_offset_estimator *est, void *root, const char *name)
+{
+	u_var_add_gui_header(root, NULL, name);
+	u_var_add_ro_i64(root, &est->stats.offset_ns, "Offset (ns)");
+	u_var_add_ro_f32(root, &est->stats.skew_ppm, "Skew (ppm)");
+	u_var_add_ro_f32(root, &est->stats.delay_mean_us, "Delay above minimum (us)");
+	u_var_add_ro_f32(root, &est->stats.jitter_us, "Jitter (us)");
+	u_var_add_ro_f32(root, &est->stats.fit_residual_us, "Fit residual (us)");
+	u_var_add_ro_u64(root, &est->stats.sample_count, "Samples");
+	u_var_add_ro_u64(root, &est->stats.reset_count, "Resets");
+}
@@ -11,10 +11,18 @@
 
 #include "util/u_time.h"
 
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+//! Number of minimum delay buckets kept by @ref m_clock_offset_estimator.
+#define M_CLOCK_OFFSET_WINDOW_SIZE 64
+
+//! Default length of each bucket in @ref m_clock_offset_estimator.
+#define M_CLOCK_OFFSET_DEFAULT_BUCKET_NS (U_TIME_1MS_IN_NS * 250)
+
 /*!
  * Helper to estimate the offset between two clocks using exponential smoothing.
  *
@@ -45,6 +53,150 @@ m_clock_offset_a2b(float freq, timepoint_ns a, timepoint_ns b, time_duration_ns
 	return a + new_a2b;
 }
 
+
+/*
+ *
+ * Skew aware estimator.
+ *
+ */
+
+/*!
+ * A sample of the offset from clock A to clock B.
+ *
+ * @ingroup aux_math
+ */
+struct m_clock_offset_sample
+{
+	timepoint_ns a;
+	time_duration_ns a2b;
+};
+
+/*!
+ * Estimates both offset and skew between a device clock A and a host clock B.
+ *
+ * Each pair of timestamps is the time the device says an event happened and
+ * the time the host saw it, the host always sees it later by some transport
+ * delay that is never negative. So the offset is tracked as the lower envelope
+ * of the observed offsets: the minimum of each bucket of time is kept over a
+ * sliding window, and a line is fitted below all of them using the lower convex
+ * hull, picking the edge that minimises the total distance to the minima. The
+ * slope of that line is the skew between the clocks.
+ *
+ * Delay spikes only make the offset sample larger, so they are ignored instead
+ * of biasing the estimate like a moving average would.
+ *
+ * Not thread safe, the user needs to lock if used from multiple threads.
+ *
+ * @ingroup aux_math
+ */
+struct m_clock_offset_estimator
+{
+	//! Length of time each minimum delay bucket covers.
+	time_duration_ns bucket_ns;
+
+	//! Minima of the completed buckets, ring buffer.
+	struct m_clock_offset_sample buckets[M_CLOCK_OFFSET_WINDOW_SIZE];
+	uint32_t bucket_head;
+	uint32_t bucket_count;
+
+	//! Minimum of the bucket currently being filled.
+	struct m_clock_offset_sample current;
+	timepoint_ns current_start;
+	bool has_current;
+
+	//! Last sample given to the estimator.
+	struct m_clock_offset_sample last;
+
+	//! Number of consecutive samples way off the current fit.
+	uint32_t outlier_count;
+
+	//! The current fit, the offset at @p a is `ref_a2b + skew * (a - ref_a)`.
+	struct
+	{
+		timepoint_ns ref_a;
+		time_duration_ns ref_a2b;
+		double skew;
+		bool valid;
+	} fit;
+
+	//! Statistics, can be shown with @ref m_clock_offset_estimator_add_vars.
+	struct
+	{
+		//! Offset at the last sample.
+		int64_t offset_ns;
+
+		//! Estimated skew of clock B relative to A, in parts per million.
+		float skew_ppm;
+
+		//! Running mean of the delay above the fitted line.
+		float delay_mean_us;
+
+		//! Running standard deviation of the delay above the fitted line.
+		float jitter_us;
+
+		//! Mean distance of the bucket minima to the fitted line.
+		float fit_residual_us;
+
+		uint64_t sample_count;
+		uint64_t reset_count;
+
+		//! Running variance, used to compute @p jitter_us.
+		double delay_var_us2;
+	} stats;
+};
+
+/*!
+ * Initialise the estimator, @p bucket_ns of zero uses
+ * @ref M_CLOCK_OFFSET_DEFAULT_BUCKET_NS, the window then covers 16 seconds.
+ *
+ * @ingroup aux_math
+ */
+void
+m_clock_offset_estimator_init(struct m_clock_offset_estimator *est, time_duration_ns bucket_ns);
+
+/*!
+ * Add a pair of timestamps of the same event, @p a in the device clock and
+ * @p b the time it was seen in the host clock.
+ *
+ * @return timepoint_ns @p a in B clock using the updated estimate.
+ * @ingroup aux_math
+ */
+timepoint_ns
+m_clock_offset_estimator_update(struct m_clock_offset_estimator *est, timepoint_ns a, timepoint_ns b);
+
+/*!
+ * Map @p a into B clock using the current estimate, without adding a sample.
+ *
+ * @ingroup aux_math
+ */
+timepoint_ns
+m_clock_offset_estimator_a2b(const struct m_clock_offset_estimator *est, timepoint_ns a);
+
+/*!
+ * Map @p b into A clock using the current estimate.
+ *
+ * @ingroup aux_math
+ */
+timepoint_ns
+m_clock_offset_estimator_b2a(const struct m_clock_offset_estimator *est, timepoint_ns b);
+
+/*!
+ * Throw away all samples, used when one of the clocks has been reset.
+ *
+ * @ingroup aux_math
+ */
+void
+m_clock_offset_estimator_reset(struct m_clock_offset_estimator *est);
+
+/*!
+ * Add the statistics of the estimator to the given @ref u_var root, under a
+ * header named @p name.
+ *
+ * @ingroup aux_math
+ */
+void
+m_clock_offset_estimator_add_vars(struct m_clock_offset_estimator *est, void *root, const char *name);
+
 #ifdef __cplusplus
 }
 #endif
@@ -100,26 +100,27 @@ m_imu_3dof_add_vars(struct m_imu_3dof *f, void *root, const char *prefix)
 	u_var_add_bool(root, &f->gyro_bias.manually_fire, tmp);
 }
 
-static void
-gravity_correction(struct m_imu_3dof *f,
-                   uint64_t timestamp_ns,
-                   const struct xrt_vec3 *accel,
-                   const struct xrt_vec3 *gyro,
-                   double dt,
-                   float gyro_length)
+static uint64_t
+gravity_duration_ns(const struct m_imu_3dof *f)
 {
-	uint64_t dur_ns = 0;
 	if (f->flags & M_IMU_3DOF_USE_GRAVITY_DUR_20MS) {
-		dur_ns = DUR_20MS_IN_NS;
+		return DUR_20MS_IN_NS;
 	} else if (f->flags & M_IMU_3DOF_USE_GRAVITY_DUR_300MS) {
-		dur_ns = DUR_300MS_IN_NS;
+		return DUR_300MS_IN_NS;
 	} else {
-		return;
+		return 0;
 	}
+}
 
+/*!
+ * Tracks if the device is level, and if it has been so for long enough
+ * updates the error axis and angle, returns true if they were updated.
+ */
+static bool
+gravity_update_error(struct m_imu_3dof *f, uint64_t timestamp_ns, float accel_length, float gyro_length, uint64_t dur_ns)
+{
 	const float gravity_tolerance = .9f;
 	const float gyro_tolerance = .1f;
-	const float min_tilt_error = 0.05f;
 	const float max_tilt_error = 0.01f;
 
 	/*
@@ -128,7 +129,6 @@ gravity_correction(struct m_imu_3dof *f,
 	 * reset the counter and start over.
 	 */
 
-	float accel_length = m_vec3_len(*accel);
 	bool is_accel = fabsf(accel_length - 9.82f) >= gravity_tolerance;
 	bool is_rotating = gyro_length >= gyro_tolerance;
 	if (is_accel || is_rotating) {
@@ -142,67 +142,114 @@ gravity_correction(struct m_imu_3dof *f,
 	 * accelerometer filter queue (last n values) and use for correction.
 	 */
 	uint64_t level_ns = f->grav.level_timestamp_ns + dur_ns;
-	if (level_ns < timestamp_ns) {
-		// Reset the timepoint
-		f->grav.level_timestamp_ns = timestamp_ns;
+	if (level_ns >= timestamp_ns) {
+		return false;
+	}
 
-		struct xrt_vec3 accel_mean;
-		m_ff_vec3_f32_filter(f->word_accel_ff,      // Filter
-		                     timestamp_ns - dur_ns, // Start time
-		                     timestamp_ns,          // End time
-		                     &accel_mean);          // Results
-		if ((m_vec3_len(accel_mean) - 9.82f) < gravity_tolerance) {
-			/*
-			 * Calculate a cross product between what the device
-			 * thinks is up and what gravity indicates is down.
-			 * The values are optimized of what we would get out
-			 * from the cross product.
-			 */
-			struct xrt_vec3 tilt = {
-			    accel_mean.z,
-			    0,
-			    -accel_mean.x,
-			};
-
-			tilt = m_vec3_normalize(tilt);
-			accel_mean = m_vec3_normalize(accel_mean);
-
-			struct xrt_vec3 up = {0, 1.0f, 0};
-			float tilt_angle = m_vec3_angle(up, accel_mean);
-
-			if (tilt_angle > max_tilt_error) {
-				f->grav.error_angle = tilt_angle;
-				f->grav.error_axis = tilt;
-			}
-		}
+	// Reset the timepoint
+	f->grav.level_timestamp_ns = timestamp_ns;
+
+	struct xrt_vec3 accel_mean;
+	m_ff_vec3_f32_filter(f->word_accel_ff,      // Filter
+	                     timestamp_ns - dur_ns, // Start time
+	                     timestamp_ns,          // End time
+	                     &accel_mean);          // Results
+	if ((m_vec3_len(accel_mean) - 9.82f) >= gravity_tolerance) {
+		return false;
+	}
+
+	/*
+	 * Calculate a cross product between what the device
+	 * thinks is up and what gravity indicates is down.
+	 * The values are optimized of what we would get out
+	 * from the cross product.
+	 */
+	struct xrt_vec3 tilt = {
+	    accel_mean.z,
+	    0,
+	    -accel_mean.x,
+	};
+
+	tilt = m_vec3_normalize(tilt);
+	accel_mean = m_vec3_normalize(accel_mean);
+
+	struct xrt_vec3 up = {0, 1.0f, 0};
+	float tilt_angle = m_vec3_angle(up, accel_mean);
+
+	if (tilt_angle <= max_tilt_error) {
+		return false;
 	}
 
-	if (f->grav.error_angle > min_tilt_error) {
-		// Correct 180° over 5 seconds, when moving.
-		float max_radians = (float)M_PI * (float)dt / 5;
-		// Correct 180° over 60 seconds, when stationary.
-		float min_radians = (float)M_PI * (float)dt / 60;
-
-		/*
-		 * We're treating 0.5 * gyro_length as a unitless scale factor.
-		 * Tested in a headset, 0.5 felt nice.
-		 */
-		float correction_radians = 0.5f * gyro_length * max_radians;
-		// Clamp to the range [min_radians, max_radians]
-		correction_radians = fmaxf(min_radians, correction_radians);
-		correction_radians = fminf(max_radians, correction_radians);
-		// Do not exceed the remaining error to correct for
-		correction_radians = -fminf(correction_radians, f->grav.error_angle);
-
-		// Update how much is left.
-		f->grav.error_angle += correction_radians;
+	f->grav.error_angle = tilt_angle;
+	f->grav.error_axis = tilt;
 
+	return true;
+}
+
+/*!
+ * How much to correct around the error axis for this step, zero or negative,
+ * also updates how much error is left.
+ */
+static float
+gravity_step_radians(struct m_imu_3dof *f, double dt, float gyro_length)
+{
+	const float min_tilt_error = 0.05f;
+
+	if (f->grav.error_angle <= min_tilt_error) {
+		return 0.0f;
+	}
+
+	// Correct 180° over 5 seconds, when moving.
+	float max_radians = (float)M_PI * (float)dt / 5;
+	// Correct 180° over 60 seconds, when stationary.
+	float min_radians = (float)M_PI * (float)dt / 60;
+
+	/*
+	 * We're treating 0.5 * gyro_length as a unitless scale factor.
+	 * Tested in a headset, 0.5 felt nice.
+	 */
+	float correction_radians = 0.5f * gyro_length * max_radians;
+	// Clamp to the range [min_radians, max_radians]
+	correction_radians = fmaxf(min_radians, correction_radians);
+	correction_radians = fminf(max_radians, correction_radians);
+	// Do not exceed the remaining error to correct for
+	correction_radians = -fminf(correction_radians, f->grav.error_angle);
+
+	// Update how much is left.
+	f->grav.error_angle += correction_radians;
+
+	return correction_radians;
+}
+
+static void
+gravity_apply(struct m_imu_3dof *f, float correction_radians, const struct xrt_vec3 *axis)
+{
+	struct xrt_quat corr_quat;
+	struct xrt_quat old_orient;
+	math_quat_from_angle_vector(correction_radians, axis, &corr_quat);
+	old_orient = f->rot;
+	math_quat_rotate(&corr_quat, &old_orient, &f->rot);
+}
+
+static void
+gravity_correction(struct m_imu_3dof *f,
+                   uint64_t timestamp_ns,
+                   const struct xrt_vec3 *accel,
+                   const struct xrt_vec3 *gyro,
+                   double dt,
+                   float gyro_length)
+{
+	uint64_t dur_ns = gravity_duration_ns(f);
+	if (dur_ns == 0) {
+		return;
+	}
+
+	gravity_update_error(f, timestamp_ns, m_vec3_len(*accel), gyro_length, dur_ns);
+
+	float correction_radians = gravity_step_radians(f, dt, gyro_length);
+	if (correction_radians != 0.0f) {
 		// Perform the correction.
-		struct xrt_quat corr_quat;
-		struct xrt_quat old_orient;
-		math_quat_from_angle_vector(correction_radians, &f->grav.error_axis, &corr_quat);
-		old_orient = f->rot;
-		math_quat_rotate(&corr_quat, &old_orient, &f->rot);
+		gravity_apply(f, correction_radians, &f->grav.error_axis);
 	}
 }
 
@@ -298,3 +345,149 @@ m_imu_3dof_update(struct m_imu_3dof *f,
 	 */
 	math_quat_normalize(&f->rot);
 }
+
+void
+m_imu_3dof_update_many(struct m_imu_3dof *f, const struct m_imu_3dof_batch *batch)
+{
+	const uint32_t count = MIN(batch->count, M_IMU_3DOF_BATCH_MAX_SAMPLES);
+	uint32_t start = 0;
+
+	if (count == 0) {
+		return;
+	}
+
+	//! Skip the first sample.
+	if (f->state == M_IMU_3DOF_STATE_START) {
+		f->state = M_IMU_3DOF_STATE_RUNNING;
+		f->last.timestamp_ns = batch->timestamp_ns[0];
+		start = 1;
+	}
+
+	float dt[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+	float accel_length[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+	float gyro_length[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+	float gyro_biased_length[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+	float qx[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+	float qy[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+	float qz[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+	float qw[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+
+	uint64_t prev_ns = f->last.timestamp_ns;
+	for (uint32_t i = start; i < count; i++) {
+		// This code assumes all timestamps makes some forward progress.
+		assert(batch->timestamp_ns[i] >= prev_ns);
+		dt[i] = (float)((double)(batch->timestamp_ns[i] - prev_ns) / DUR_1S_IN_NS);
+		prev_ns = batch->timestamp_ns[i];
+	}
+
+	/*
+	 * No dependencies between samples here, these loops are written so
+	 * that the compiler can vectorise them.
+	 */
+	const struct xrt_vec3 bias = f->gyro_bias.value;
+	for (uint32_t i = start; i < count; i++) {
+		float ax = batch->accel_x[i];
+		float ay = batch->accel_y[i];
+		float az = batch->accel_z[i];
+		float gx = batch->gyro_x[i];
+		float gy = batch->gyro_y[i];
+		float gz = batch->gyro_z[i];
+		float bx = gx - bias.x;
+		float by = gy - bias.y;
+		float bz = gz - bias.z;
+
+		accel_length[i] = sqrtf(ax * ax + ay * ay + az * az);
+		gyro_length[i] = sqrtf(gx * gx + gy * gy + gz * gz);
+		gyro_biased_length[i] = sqrtf(bx * bx + by * by + bz * bz);
+	}
+
+	// Delta rotation of each sample, as a quaternion.
+	for (uint32_t i = start; i < count; i++) {
+		float len = gyro_biased_length[i];
+		float half_angle = 0.5f * len * dt[i];
+		float s = len > 0.0001f ? sinf(half_angle) / len : 0.0f;
+		float c = len > 0.0001f ? cosf(half_angle) : 1.0f;
+
+		qx[i] = (batch->gyro_x[i] - bias.x) * s;
+		qy[i] = (batch->gyro_y[i] - bias.y) * s;
+		qz[i] = (batch->gyro_z[i] - bias.z) * s;
+		qw[i] = c;
+	}
+
+	/*
+	 * The sequential part. Gravity corrections rotate in world space and
+	 * the gyro in device space, so they can be accumulated separately and
+	 * the corrections applied once, unless the error axis changes.
+	 */
+	uint64_t dur_ns = gravity_duration_ns(f);
+	float pending_radians = 0.0f;
+
+	for (uint32_t i = start; i < count; i++) {
+		uint64_t timestamp_ns = batch->timestamp_ns[i];
+		struct xrt_vec3 accel = {batch->accel_x[i], batch->accel_y[i], batch->accel_z[i]};
+		struct xrt_vec3 gyro = {batch->gyro_x[i], batch->gyro_y[i], batch->gyro_z[i]};
+
+		// Same as math_quat_rotate_vec3, inline: v + 2w(q x v) + 2q x (q x v).
+		const struct xrt_quat r = f->rot;
+		struct xrt_vec3 t = {
+		    2.0f * (r.y * accel.z - r.z * accel.y),
+		    2.0f * (r.z * accel.x - r.x * accel.z),
+		    2.0f * (r.x * accel.y - r.y * accel.x),
+		};
+		struct xrt_vec3 world_accel = {
+		    accel.x + r.w * t.x + (r.y * t.z - r.z * t.y),
+		    accel.y + r.w * t.y + (r.z * t.x - r.x * t.z),
+		    accel.z + r.w * t.z + (r.x * t.y - r.y * t.x),
+		};
+
+		m_ff_vec3_f32_push(f->word_accel_ff, &world_accel, timestamp_ns);
+		m_ff_vec3_f32_push(f->gyro_ff, &gyro, timestamp_ns);
+
+		// Hamilton product rot * delta, same as math_quat_rotate.
+		if (gyro_biased_length[i] > 0.0001f) {
+			struct xrt_quat a = f->rot;
+			f->rot.x = a.w * qx[i] + a.x * qw[i] + a.y * qz[i] - a.z * qy[i];
+			f->rot.y = a.w * qy[i] - a.x * qz[i] + a.y * qw[i] + a.z * qx[i];
+			f->rot.z = a.w * qz[i] + a.x * qy[i] - a.y * qx[i] + a.z * qw[i];
+			f->rot.w = a.w * qw[i] - a.x * qx[i] - a.y * qy[i] - a.z * qz[i];
+		}
+
+		if (dur_ns == 0) {
+			continue;
+		}
+
+		struct xrt_vec3 old_axis = f->grav.error_axis;
+		bool new_axis =
+		    gravity_update_error(f, timestamp_ns, accel_length[i], gyro_biased_length[i], dur_ns);
+		if (new_axis && pending_radians != 0.0f) {
+			gravity_apply(f, pending_radians, &old_axis);
+			pending_radians = 0.0f;
+		}
+
+		pending_radians += gravity_step_radians(f, dt[i], gyro_biased_length[i]);
+	}
+
+	if (pending_radians != 0.0f) {
+		gravity_apply(f, pending_radians, &f->grav.error_axis);
+	}
+
+	uint32_t last = count - 1;
+	if (last >= start) {
+		f->last.timestamp_ns = batch->timestamp_ns[last];
+		f->last.accel = (struct xrt_vec3){batch->accel_x[last], batch->accel_y[last], batch->accel_z[last]};
+		f->last.gyro = (struct xrt_vec3){batch->gyro_x[last], batch->gyro_y[last], batch->gyro_z[last]};
+		f->last.delta_ms = dt[last] * 1000.0;
+		f->last.accel_length = accel_length[last];
+		f->last.gyro_length = gyro_length[last];
+		f->last.gyro_biased_length = gyro_biased_length[last];
+	}
+
+	// Gyro bias calculations.
+	gyro_biasing(f, f->last.timestamp_ns);
+
+	/*
+	 * Mitigate drift due to floating point
+	 * inprecision with quat multiplication.
+	 */
+	math_quat_normalize(&f->rot);
+}
@@ -22,6 +22,9 @@ extern "C" {
 #define M_IMU_3DOF_USE_GRAVITY_DUR_300MS (1 << 0)
 #define M_IMU_3DOF_USE_GRAVITY_DUR_20MS (1 << 1)
 
+//! Max number of samples in a @ref m_imu_3dof_batch.
+#define M_IMU_3DOF_BATCH_MAX_SAMPLES (16)
+
 
 struct m_ff_vec3_f32;
 
@@ -90,6 +93,61 @@ m_imu_3dof_update(struct m_imu_3dof *f,
                   const struct xrt_vec3 *accel,
                   const struct xrt_vec3 *gyro);
 
+/*!
+ * A block of IMU samples stored as separate arrays per component, so that
+ * the per sample math in @ref m_imu_3dof_update_many can be vectorised.
+ */
+struct m_imu_3dof_batch
+{
+	uint64_t timestamp_ns[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+
+	float accel_x[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+	float accel_y[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+	float accel_z[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+
+	float gyro_x[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+	float gyro_y[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+	float gyro_z[M_IMU_3DOF_BATCH_MAX_SAMPLES];
+
+	uint32_t count;
+};
+
+/*!
+ * Add a sample to the batch, returns false if the batch is full.
+ */
+static inline bool
+m_imu_3dof_batch_add(struct m_imu_3dof_batch *b,
+                     uint64_t timestamp_ns,
+                     const struct xrt_vec3 *accel,
+                     const struct xrt_vec3 *gyro)
+{
+	if (b->count >= M_IMU_3DOF_BATCH_MAX_SAMPLES) {
+		return false;
+	}
+
+	uint32_t i = b->count++;
+	b->timestamp_ns[i] = timestamp_ns;
+	b->accel_x[i] = accel->x;
+	b->accel_y[i] = accel->y;
+	b->accel_z[i] = accel->z;
+	b->gyro_x[i] = gyro->x;
+	b->gyro_y[i] = gyro->y;
+	b->gyro_z[i] = gyro->z;
+
+	return true;
+}
+
+/*!
+ * Same as calling @ref m_imu_3dof_update for each sample in @p batch, but
+ * the lengths and gyro rotations of all samples are computed in one go.
+ * Gravity correction, gyro bias updates and normalisation happen once per
+ * batch instead of once per sample. The gravity error is still tracked per
+ * sample, so the final orientation only differs by rounding errors as long
+ * as batches are kept short, which they are by their max size.
+ */
+void
+m_imu_3dof_update_many(struct m_imu_3dof *f, const struct m_imu_3dof_batch *batch);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,924 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Batched, structure of arrays, pose and relation math.
+ * @author agent <agent@local>
+ * @ingroup aux_math
+ */
+
+#include "math/m_api.h"
+#include "math/m_mathinclude.h"
+#include "math/m_pose_batch.h"
+
+#include <assert.h>
+#include <float.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define M_BATCH_SSE
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define M_BATCH_NEON
+#endif
+
+
+/*!
+ * Number of relations worked on at the same time by the relation functions,
+ * kept small so that everything stays on the stack and in the L1 cache.
+ */
+#define CHUNK_SIZE (32)
+
+
+/*
+ *
+ * Lane functions, four floats at a time.
+ *
+ */
+
+#if defined(M_BATCH_SSE)
+
+typedef __m128 lane;
+
+static inline lane
+l_load(const float *p)
+{
+	return _mm_loadu_ps(p);
+}
+
+static inline void
+l_store(float *p, lane v)
+{
+	_mm_storeu_ps(p, v);
+}
+
+static inline lane
+l_set1(float f)
+{
+	return _mm_set1_ps(f);
+}
+
+static inline lane
+l_add(lane a, lane b)
+{
+	return _mm_add_ps(a, b);
+}
+
+static inline lane
+l_sub(lane a, lane b)
+{
+	return _mm_sub_ps(a, b);
+}
+
+static inline lane
+l_mul(lane a, lane b)
+{
+	return _mm_mul_ps(a, b);
+}
+
+static inline lane
+l_div(lane a, lane b)
+{
+	return _mm_div_ps(a, b);
+}
+
+static inline lane
+l_sqrt(lane a)
+{
+	return _mm_sqrt_ps(a);
+}
+
+static inline lane
+l_max(lane a, lane b)
+{
+	return _mm_max_ps(a, b);
+}
+
+static inline lane
+l_and(lane a, lane b)
+{
+	return _mm_and_ps(a, b);
+}
+
+#elif defined(M_BATCH_NEON)
+
+typedef float32x4_t lane;
+
+static inline lane
+l_load(const float *p)
+{
+	return vld1q_f32(p);
+}
+
+static inline void
+l_store(float *p, lane v)
+{
+	vst1q_f32(p, v);
+}
+
+static inline lane
+l_set1(float f)
+{
+	return vdupq_n_f32(f);
+}
+
+static inline lane
+l_add(lane a, lane b)
+{
+	return vaddq_f32(a, b);
+}
+
+static inline lane
+l_sub(lane a, lane b)
+{
+	return vsubq_f32(a, b);
+}
+
+static inline lane
+l_mul(lane a, lane b)
+{
+	return vmulq_f32(a, b);
+}
+
+static inline lane
+l_div(lane a, lane b)
+{
+	return vdivq_f32(a, b);
+}
+
+static inline lane
+l_sqrt(lane a)
+{
+	return vsqrtq_f32(a);
+}
+
+static inline lane
+l_max(lane a, lane b)
+{
+	return vmaxq_f32(a, b);
+}
+
+static inline lane
+l_and(lane a, lane b)
+{
+	return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+
+#else
+
+/*
+ * Plain C fallback, the loops are simple enough that most compilers will still
+ * turn these into vector instructions.
+ */
+typedef struct
+{
+	float v[4];
+} lane;
+
+static inline lane
+l_load(const float *p)
+{
+	lane r;
+	memcpy(r.v, p, sizeof(r.v));
+	return r;
+}
+
+static inline void
+l_store(float *p, lane v)
+{
+	memcpy(p, v.v, sizeof(v.v));
+}
+
+static inline lane
+l_set1(float f)
+{
+	lane r = {{f, f, f, f}};
+	return r;
+}
+
+#define LANE_OP(NAME, EXPR)                                                                                            \
+	static inline lane NAME(lane a, lane b)                                                                        \
+	{                                                                                                              \
+		lane r;                                                                                                \
+		for (int i = 0; i < 4; i++) {                                                                          \
+			r.v[i] = EXPR;                                                                                 \
+		}                                                                                                      \
+		return r;                                                                                              \
+	}
+
+LANE_OP(l_add, a.v[i] + b.v[i])
+LANE_OP(l_sub, a.v[i] - b.v[i])
+LANE_OP(l_mul, a.v[i] * b.v[i])
+LANE_OP(l_div, a.v[i] / b.v[i])
+LANE_OP(l_max, a.v[i] > b.v[i] ? a.v[i] : b.v[i])
+
+#undef LANE_OP
+
+static inline lane
+l_and(lane a, lane b)
+{
+	lane r;
+	for (int i = 0; i < 4; i++) {
+		uint32_t ua, ub;
+		memcpy(&ua, &a.v[i], sizeof(ua));
+		memcpy(&ub, &b.v[i], sizeof(ub));
+		ua &= ub;
+		memcpy(&r.v[i], &ua, sizeof(ua));
+	}
+	return r;
+}
+
+static inline lane
+l_sqrt(lane a)
+{
+	lane r;
+	for (int i = 0; i < 4; i++) {
+		r.v[i] = sqrtf(a.v[i]);
+	}
+	return r;
+}
+
+#endif
+
+/*!
+ * Loads @p n floats, the remaining lanes are zero.
+ */
+static inline lane
+l_load_n(const float *p, uint32_t n)
+{
+	if (n == 4) {
+		return l_load(p);
+	}
+
+	float tmp[4] = {0};
+	for (uint32_t i = 0; i < n; i++) {
+		tmp[i] = p[i];
+	}
+	return l_load(tmp);
+}
+
+/*!
+ * Makes a mask lane, all bits set in the first @p n lanes where the bit @p bit
+ * is set in @p flags, this is used to select valid parts of relations.
+ */
+static inline lane
+l_mask_n(const enum xrt_space_relation_flags *flags, int bit, uint32_t n)
+{
+	uint32_t tmp[4] = {0};
+	for (uint32_t i = 0; i < n; i++) {
+		tmp[i] = (flags[i] & bit) != 0 ? UINT32_MAX : 0;
+	}
+
+	float f[4];
+	memcpy(f, tmp, sizeof(f));
+	return l_load(f);
+}
+
+/*!
+ * Stores the first @p n lanes.
+ */
+static inline void
+l_store_n(float *p, lane v, uint32_t n)
+{
+	if (n == 4) {
+		l_store(p, v);
+		return;
+	}
+
+	float tmp[4];
+	l_store(tmp, v);
+	for (uint32_t i = 0; i < n; i++) {
+		p[i] = tmp[i];
+	}
+}
+
+
+/*
+ *
+ * Vector and quaternion helpers.
+ *
+ */
+
+struct lane_vec3
+{
+	lane x, y, z;
+};
+
+struct lane_quat
+{
+	lane x, y, z, w;
+};
+
+static inline struct lane_vec3
+lv_load(const struct m_vec3_soa *v, uint32_t i, uint32_t n)
+{
+	struct lane_vec3 r = {l_load_n(v->x + i, n), l_load_n(v->y + i, n), l_load_n(v->z + i, n)};
+	return r;
+}
+
+static inline void
+lv_store(struct m_vec3_soa *v, uint32_t i, uint32_t n, struct lane_vec3 r)
+{
+	l_store_n(v->x + i, r.x, n);
+	l_store_n(v->y + i, r.y, n);
+	l_store_n(v->z + i, r.z, n);
+}
+
+static inline struct lane_vec3
+lv_set1(const struct xrt_vec3 *v)
+{
+	struct lane_vec3 r = {l_set1(v->x), l_set1(v->y), l_set1(v->z)};
+	return r;
+}
+
+static inline struct lane_quat
+lq_load(const struct m_quat_soa *q, uint32_t i, uint32_t n)
+{
+	struct lane_quat r = {l_load_n(q->x + i, n), l_load_n(q->y + i, n), l_load_n(q->z + i, n),
+	                      l_load_n(q->w + i, n)};
+	return r;
+}
+
+static inline void
+lq_store(struct m_quat_soa *q, uint32_t i, uint32_t n, struct lane_quat r)
+{
+	l_store_n(q->x + i, r.x, n);
+	l_store_n(q->y + i, r.y, n);
+	l_store_n(q->z + i, r.z, n);
+	l_store_n(q->w + i, r.w, n);
+}
+
+static inline struct lane_quat
+lq_set1(const struct xrt_quat *q)
+{
+	struct lane_quat r = {l_set1(q->x), l_set1(q->y), l_set1(q->z), l_set1(q->w)};
+	return r;
+}
+
+static inline struct lane_vec3
+lv_add(struct lane_vec3 a, struct lane_vec3 b)
+{
+	struct lane_vec3 r = {l_add(a.x, b.x), l_add(a.y, b.y), l_add(a.z, b.z)};
+	return r;
+}
+
+static inline struct lane_vec3
+lv_cross(struct lane_vec3 a, struct lane_vec3 b)
+{
+	struct lane_vec3 r = {
+	    l_sub(l_mul(a.y, b.z), l_mul(a.z, b.y)),
+	    l_sub(l_mul(a.z, b.x), l_mul(a.x, b.z)),
+	    l_sub(l_mul(a.x, b.y), l_mul(a.y, b.x)),
+	};
+	return r;
+}
+
+/*!
+ * Same as Eigen, v + w * t + cross(q.xyz, t) where t = 2 * cross(q.xyz, v),
+ * requires @p q to be normalized.
+ */
+static inline struct lane_vec3
+lq_rotate(struct lane_quat q, struct lane_vec3 v)
+{
+	struct lane_vec3 u = {q.x, q.y, q.z};
+	lane two = l_set1(2.0f);
+
+	struct lane_vec3 t = lv_cross(u, v);
+	t.x = l_mul(t.x, two);
+	t.y = l_mul(t.y, two);
+	t.z = l_mul(t.z, two);
+
+	struct lane_vec3 c = lv_cross(u, t);
+
+	struct lane_vec3 r = {
+	    l_add(l_add(v.x, l_mul(q.w, t.x)), c.x),
+	    l_add(l_add(v.y, l_mul(q.w, t.y)), c.y),
+	    l_add(l_add(v.z, l_mul(q.w, t.z)), c.z),
+	};
+	return r;
+}
+
+//! Hamilton product, @p a * @p b.
+static inline struct lane_quat
+lq_mul(struct lane_quat a, struct lane_quat b)
+{
+	struct lane_quat r;
+	r.w = l_sub(l_sub(l_sub(l_mul(a.w, b.w), l_mul(a.x, b.x)), l_mul(a.y, b.y)), l_mul(a.z, b.z));
+	r.x = l_sub(l_add(l_add(l_mul(a.w, b.x), l_mul(a.x, b.w)), l_mul(a.y, b.z)), l_mul(a.z, b.y));
+	r.y = l_add(l_add(l_sub(l_mul(a.w, b.y), l_mul(a.x, b.z)), l_mul(a.y, b.w)), l_mul(a.z, b.x));
+	r.z = l_add(l_sub(l_add(l_mul(a.w, b.z), l_mul(a.x, b.y)), l_mul(a.y, b.x)), l_mul(a.z, b.w));
+	return r;
+}
+
+static inline struct lane_quat
+lq_conjugate(struct lane_quat q)
+{
+	lane zero = l_set1(0.0f);
+	struct lane_quat r = {l_sub(zero, q.x), l_sub(zero, q.y), l_sub(zero, q.z), q.w};
+	return r;
+}
+
+static inline struct lane_quat
+lq_normalize(struct lane_quat q)
+{
+	lane len2 = l_add(l_add(l_mul(q.x, q.x), l_mul(q.y, q.y)), l_add(l_mul(q.z, q.z), l_mul(q.w, q.w)));
+	// Keeps the zero padding lanes from producing NaNs.
+	lane len = l_max(l_sqrt(len2), l_set1(FLT_MIN));
+
+	struct lane_quat r = {l_div(q.x, len), l_div(q.y, len), l_div(q.z, len), l_div(q.w, len)};
+	return r;
+}
+
+
+/*
+ *
+ * Structure of arrays functions.
+ *
+ */
+
+void
+m_batch_quat_rotate_vec3(const struct m_quat_soa *q,
+                         const struct m_vec3_soa *v,
+                         struct m_vec3_soa *out,
+                         uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i += 4) {
+		uint32_t n = MIN(count - i, 4);
+
+		struct lane_quat lq = lq_load(q, i, n);
+		struct lane_vec3 lv = lv_load(v, i, n);
+
+		lv_store(out, i, n, lq_rotate(lq, lv));
+	}
+}
+
+void
+m_batch_pose_transform(const struct m_pose_soa *transform,
+                       const struct m_pose_soa *pose,
+                       struct m_pose_soa *out,
+                       uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i += 4) {
+		uint32_t n = MIN(count - i, 4);
+
+		struct lane_quat tq = lq_load(&transform->orientation, i, n);
+		struct lane_vec3 tp = lv_load(&transform->position, i, n);
+		struct lane_quat pq = lq_load(&pose->orientation, i, n);
+		struct lane_vec3 pp = lv_load(&pose->position, i, n);
+
+		lv_store(&out->position, i, n, lv_add(lq_rotate(tq, pp), tp));
+		lq_store(&out->orientation, i, n, lq_mul(tq, pq));
+	}
+}
+
+void
+m_batch_pose_transform_one(const struct xrt_pose *transform,
+                           const struct m_pose_soa *pose,
+                           struct m_pose_soa *out,
+                           uint32_t count)
+{
+	struct lane_quat tq = lq_set1(&transform->orientation);
+	struct lane_vec3 tp = lv_set1(&transform->position);
+
+	for (uint32_t i = 0; i < count; i += 4) {
+		uint32_t n = MIN(count - i, 4);
+
+		struct lane_quat pq = lq_load(&pose->orientation, i, n);
+		struct lane_vec3 pp = lv_load(&pose->position, i, n);
+
+		lv_store(&out->position, i, n, lv_add(lq_rotate(tq, pp), tp));
+		lq_store(&out->orientation, i, n, lq_mul(tq, pq));
+	}
+}
+
+void
+m_batch_vec3_lerp(const struct m_vec3_soa *a,
+                  const struct m_vec3_soa *b,
+                  const float *t,
+                  struct m_vec3_soa *out,
+                  uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i += 4) {
+		uint32_t n = MIN(count - i, 4);
+
+		struct lane_vec3 la = lv_load(a, i, n);
+		struct lane_vec3 lb = lv_load(b, i, n);
+		lane lt = l_load_n(t + i, n);
+
+		// Same order of operations as m_vec3_lerp.
+		struct lane_vec3 r = {
+		    l_add(la.x, l_mul(l_sub(lb.x, la.x), lt)),
+		    l_add(la.y, l_mul(l_sub(lb.y, la.y), lt)),
+		    l_add(la.z, l_mul(l_sub(lb.z, la.z), lt)),
+		};
+
+		lv_store(out, i, n, r);
+	}
+}
+
+void
+m_batch_quat_slerp(const struct m_quat_soa *a,
+                   const struct m_quat_soa *b,
+                   const float *t,
+                   struct m_quat_soa *out,
+                   uint32_t count)
+{
+	// Same threshold as Eigen uses to switch to a linear interpolation.
+	const float one = 1.0f - FLT_EPSILON;
+
+	for (uint32_t i = 0; i < count; i += 4) {
+		uint32_t n = MIN(count - i, 4);
+
+		struct lane_quat la = lq_load(a, i, n);
+		struct lane_quat lb = lq_load(b, i, n);
+
+		lane d = l_add(l_add(l_mul(la.x, lb.x), l_mul(la.y, lb.y)), l_add(l_mul(la.z, lb.z), l_mul(la.w, lb.w)));
+
+		float dots[4];
+		float scale0[4] = {0};
+		float scale1[4] = {0};
+		l_store(dots, d);
+
+		// The trigonometry is done per lane, there is no vector acos or sin.
+		for (uint32_t k = 0; k < n; k++) {
+			float abs_d = fabsf(dots[k]);
+			float tk = t[i + k];
+
+			if (abs_d >= one) {
+				scale0[k] = 1.0f - tk;
+				scale1[k] = tk;
+			} else {
+				float theta = acosf(abs_d);
+				float sin_theta = sinf(theta);
+				scale0[k] = sinf((1.0f - tk) * theta) / sin_theta;
+				scale1[k] = sinf(tk * theta) / sin_theta;
+			}
+
+			// Take the shortest path.
+			if (dots[k] < 0.0f) {
+				scale1[k] = -scale1[k];
+			}
+		}
+
+		lane s0 = l_load(scale0);
+		lane s1 = l_load(scale1);
+
+		struct lane_quat r = {
+		    l_add(l_mul(s0, la.x), l_mul(s1, lb.x)),
+		    l_add(l_mul(s0, la.y), l_mul(s1, lb.y)),
+		    l_add(l_mul(s0, la.z), l_mul(s1, lb.z)),
+		    l_add(l_mul(s0, la.w), l_mul(s1, lb.w)),
+		};
+
+		lq_store(out, i, n, r);
+	}
+}
+
+
+void
+m_batch_quat_finite_difference(const struct m_quat_soa *q0,
+                               const struct m_quat_soa *q1,
+                               float dt,
+                               struct m_vec3_soa *out,
+                               uint32_t count)
+{
+	assert(dt != 0.0f);
+
+	for (uint32_t i = 0; i < count; i += 4) {
+		uint32_t n = MIN(count - i, 4);
+
+		struct lane_quat inc = lq_mul(lq_load(q1, i, n), lq_conjugate(lq_load(q0, i, n)));
+
+		lane norm2 = l_add(l_add(l_mul(inc.x, inc.x), l_mul(inc.y, inc.y)), l_mul(inc.z, inc.z));
+
+		float vecnorm[4];
+		float w[4];
+		float scale[4] = {0};
+		l_store(vecnorm, l_sqrt(norm2));
+		l_store(w, inc.w);
+
+		// Same as the quaternion log in m_quatexpmap.cpp, per lane.
+		for (uint32_t k = 0; k < n; k++) {
+			float phi = atan2f(vecnorm[k], w[k]);
+			float phi_over_sin;
+			if (vecnorm[k] < 1e-4f) {
+				float phi2 = phi * phi;
+				phi_over_sin = 1.0f + phi2 / 6.0f + 7.0f * phi2 * phi2 / 360.0f +
+				               31.0f * phi2 * phi2 * phi2 / 15120.0f;
+			} else {
+				phi_over_sin = phi / sinf(phi);
+			}
+			scale[k] = 2.0f * phi_over_sin / dt;
+		}
+
+		lane ls = l_load(scale);
+		struct lane_vec3 r = {l_mul(inc.x, ls), l_mul(inc.y, ls), l_mul(inc.z, ls)};
+
+		lv_store(out, i, n, r);
+	}
+}
+
+
+/*
+ *
+ * Relation functions.
+ *
+ */
+
+/*!
+ * Storage for one chunk of relations as a structure of arrays.
+ */
+struct relation_chunk
+{
+	enum xrt_space_relation_flags flags[CHUNK_SIZE];
+	float qx[CHUNK_SIZE], qy[CHUNK_SIZE], qz[CHUNK_SIZE], qw[CHUNK_SIZE];
+	float px[CHUNK_SIZE], py[CHUNK_SIZE], pz[CHUNK_SIZE];
+	float lx[CHUNK_SIZE], ly[CHUNK_SIZE], lz[CHUNK_SIZE];
+	float ax[CHUNK_SIZE], ay[CHUNK_SIZE], az[CHUNK_SIZE];
+};
+
+static inline struct m_relation_soa
+chunk_soa(struct relation_chunk *c)
+{
+	struct m_relation_soa r = {
+	    c->flags,
+	    {{c->qx, c->qy, c->qz, c->qw}, {c->px, c->py, c->pz}},
+	    {c->lx, c->ly, c->lz},
+	    {c->ax, c->ay, c->az},
+	};
+	return r;
+}
+
+/*!
+ * Copies a relation into the chunk, the parts that are not valid are written
+ * as identity or zero, this makes it possible to do the math unconditionally.
+ */
+static inline void
+chunk_gather(struct relation_chunk *c, uint32_t k, const struct xrt_space_relation *r)
+{
+	enum xrt_space_relation_flags f = r->relation_flags;
+
+	struct xrt_quat q = XRT_QUAT_IDENTITY;
+	struct xrt_vec3 p = XRT_VEC3_ZERO;
+	struct xrt_vec3 l = XRT_VEC3_ZERO;
+	struct xrt_vec3 a = XRT_VEC3_ZERO;
+
+	if ((f & XRT_SPACE_RELATION_ORIENTATION_VALID_BIT) != 0) {
+		q = r->pose.orientation;
+	}
+	if ((f & XRT_SPACE_RELATION_POSITION_VALID_BIT) != 0) {
+		p = r->pose.position;
+	}
+	if ((f & XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT) != 0) {
+		l = r->linear_velocity;
+	}
+	if ((f & XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT) != 0) {
+		a = r->angular_velocity;
+	}
+
+	c->flags[k] = f;
+	c->qx[k] = q.x;
+	c->qy[k] = q.y;
+	c->qz[k] = q.z;
+	c->qw[k] = q.w;
+	c->px[k] = p.x;
+	c->py[k] = p.y;
+	c->pz[k] = p.z;
+	c->lx[k] = l.x;
+	c->ly[k] = l.y;
+	c->lz[k] = l.z;
+	c->ax[k] = a.x;
+	c->ay[k] = a.y;
+	c->az[k] = a.z;
+}
+
+static inline void
+chunk_scatter(const struct relation_chunk *c, uint32_t k, struct xrt_space_relation *out)
+{
+	out->relation_flags = c->flags[k];
+	out->pose.orientation.x = c->qx[k];
+	out->pose.orientation.y = c->qy[k];
+	out->pose.orientation.z = c->qz[k];
+	out->pose.orientation.w = c->qw[k];
+	out->pose.position.x = c->px[k];
+	out->pose.position.y = c->py[k];
+	out->pose.position.z = c->pz[k];
+	out->linear_velocity.x = c->lx[k];
+	out->linear_velocity.y = c->ly[k];
+	out->linear_velocity.z = c->lz[k];
+	out->angular_velocity.x = c->ax[k];
+	out->angular_velocity.y = c->ay[k];
+	out->angular_velocity.z = c->az[k];
+}
+
+static inline bool
+has_pose(enum xrt_space_relation_flags flags)
+{
+	return (flags & (XRT_SPACE_RELATION_POSITION_VALID_BIT | XRT_SPACE_RELATION_ORIENTATION_VALID_BIT)) != 0;
+}
+
+static inline void
+soa_write_zero(struct m_relation_soa *out, uint32_t i)
+{
+	out->flags[i] = XRT_SPACE_RELATION_BITMASK_NONE;
+	out->pose.orientation.x[i] = 0.0f;
+	out->pose.orientation.y[i] = 0.0f;
+	out->pose.orientation.z[i] = 0.0f;
+	out->pose.orientation.w[i] = 1.0f;
+	out->pose.position.x[i] = 0.0f;
+	out->pose.position.y[i] = 0.0f;
+	out->pose.position.z[i] = 0.0f;
+	out->linear_velocity.x[i] = 0.0f;
+	out->linear_velocity.y[i] = 0.0f;
+	out->linear_velocity.z[i] = 0.0f;
+	out->angular_velocity.x[i] = 0.0f;
+	out->angular_velocity.y[i] = 0.0f;
+	out->angular_velocity.z[i] = 0.0f;
+}
+
+//! Same flag rules as m_relation_chain_resolve.
+static inline enum xrt_space_relation_flags
+apply_flags(enum xrt_space_relation_flags af, enum xrt_space_relation_flags bf)
+{
+	int flags = XRT_SPACE_RELATION_POSITION_VALID_BIT | XRT_SPACE_RELATION_ORIENTATION_VALID_BIT;
+	int either = af | bf;
+
+	flags |= either & (XRT_SPACE_RELATION_POSITION_TRACKED_BIT | XRT_SPACE_RELATION_ORIENTATION_TRACKED_BIT |
+	                   XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT);
+
+	// Angular velocity of the base gives a linear velocity everywhere else.
+	if ((either & XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT) != 0 ||
+	    (bf & XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT) != 0) {
+		flags |= XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT;
+	}
+
+	return (enum xrt_space_relation_flags)flags;
+}
+
+void
+m_batch_relation_soa_apply_one(const struct xrt_space_relation *base,
+                               const struct m_relation_soa *relations,
+                               struct m_relation_soa *out,
+                               uint32_t count)
+{
+	const enum xrt_space_relation_flags bf = base->relation_flags;
+
+	// Same as m_relation_chain_resolve, nothing can be said if any step lacks a pose.
+	if (!has_pose(bf)) {
+		for (uint32_t i = 0; i < count; i++) {
+			soa_write_zero(out, i);
+		}
+		return;
+	}
+
+	struct relation_chunk b1;
+	chunk_gather(&b1, 0, base);
+
+	struct lane_quat bq = {l_set1(b1.qx[0]), l_set1(b1.qy[0]), l_set1(b1.qz[0]), l_set1(b1.qw[0])};
+	struct lane_vec3 bp = {l_set1(b1.px[0]), l_set1(b1.py[0]), l_set1(b1.pz[0])};
+	struct lane_vec3 bl = {l_set1(b1.lx[0]), l_set1(b1.ly[0]), l_set1(b1.lz[0])};
+	struct lane_vec3 ba = {l_set1(b1.ax[0]), l_set1(b1.ay[0]), l_set1(b1.az[0])};
+	lane one = l_set1(1.0f);
+
+	const int all_valid = XRT_SPACE_RELATION_ORIENTATION_VALID_BIT | XRT_SPACE_RELATION_POSITION_VALID_BIT |
+	                      XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT |
+	                      XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT;
+
+	for (uint32_t i = 0; i < count; i += 4) {
+		uint32_t n = MIN(count - i, 4);
+
+		const enum xrt_space_relation_flags *f = relations->flags + i;
+
+		struct lane_quat q = lq_load(&relations->pose.orientation, i, n);
+		struct lane_vec3 p = lv_load(&relations->pose.position, i, n);
+		struct lane_vec3 l = lv_load(&relations->linear_velocity, i, n);
+		struct lane_vec3 a = lv_load(&relations->angular_velocity, i, n);
+
+		int common = all_valid;
+		for (uint32_t k = 0; k < n; k++) {
+			common &= f[k];
+		}
+
+		// Invalid parts are made identity or zero so the math can be done unconditionally.
+		if (common != all_valid) {
+			lane mo = l_mask_n(f, XRT_SPACE_RELATION_ORIENTATION_VALID_BIT, n);
+			lane mp = l_mask_n(f, XRT_SPACE_RELATION_POSITION_VALID_BIT, n);
+			lane ml = l_mask_n(f, XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT, n);
+			lane ma = l_mask_n(f, XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT, n);
+
+			q.x = l_and(q.x, mo);
+			q.y = l_and(q.y, mo);
+			q.z = l_and(q.z, mo);
+			q.w = l_add(l_and(q.w, mo), l_sub(one, l_and(one, mo)));
+			p.x = l_and(p.x, mp);
+			p.y = l_and(p.y, mp);
+			p.z = l_and(p.z, mp);
+			l.x = l_and(l.x, ml);
+			l.y = l_and(l.y, ml);
+			l.z = l_and(l.z, ml);
+			a.x = l_and(a.x, ma);
+			a.y = l_and(a.y, ma);
+			a.z = l_and(a.z, ma);
+		}
+
+		// Pose, the rotated position is also needed for the lever arm.
+		struct lane_vec3 rotated_position = lq_rotate(bq, p);
+		p = lv_add(rotated_position, bp);
+		q = lq_normalize(lq_mul(bq, q));
+
+		l = lv_add(lv_add(lq_rotate(bq, l), bl), lv_cross(ba, rotated_position));
+		a = lv_add(lq_rotate(bq, a), ba);
+
+		// Read the flags before writing anything, the output may alias the input.
+		enum xrt_space_relation_flags in_flags[4];
+		for (uint32_t k = 0; k < n; k++) {
+			in_flags[k] = f[k];
+		}
+
+		lq_store(&out->pose.orientation, i, n, q);
+		lv_store(&out->pose.position, i, n, p);
+		lv_store(&out->linear_velocity, i, n, l);
+		lv_store(&out->angular_velocity, i, n, a);
+
+		for (uint32_t k = 0; k < n; k++) {
+			if (!has_pose(in_flags[k])) {
+				soa_write_zero(out, i + k);
+			} else {
+				out->flags[i + k] = apply_flags(in_flags[k], bf);
+			}
+		}
+	}
+}
+
+void
+m_batch_relation_interpolate(const struct xrt_space_relation *a,
+                             const struct xrt_space_relation *b,
+                             const float *t,
+                             struct xrt_space_relation *out,
+                             uint32_t count)
+{
+	struct relation_chunk ca;
+	struct relation_chunk cb;
+
+	for (uint32_t i = 0; i < count; i += CHUNK_SIZE) {
+		uint32_t n = MIN(count - i, CHUNK_SIZE);
+
+		for (uint32_t k = 0; k < n; k++) {
+			enum xrt_space_relation_flags flags = a[i + k].relation_flags & b[i + k].relation_flags;
+
+			// Only the common parts are interpolated, mask before gathering.
+			struct xrt_space_relation ra = a[i + k];
+			struct xrt_space_relation rb = b[i + k];
+			ra.relation_flags = flags;
+			rb.relation_flags = flags;
+
+			chunk_gather(&ca, k, &ra);
+			chunk_gather(&cb, k, &rb);
+		}
+
+		struct m_relation_soa sa = chunk_soa(&ca);
+		struct m_relation_soa sb = chunk_soa(&cb);
+
+		m_batch_quat_slerp(&sa.pose.orientation, &sb.pose.orientation, t + i, &sa.pose.orientation, n);
+		m_batch_vec3_lerp(&sa.pose.position, &sb.pose.position, t + i, &sa.pose.position, n);
+		m_batch_vec3_lerp(&sa.linear_velocity, &sb.linear_velocity, t + i, &sa.linear_velocity, n);
+		m_batch_vec3_lerp(&sa.angular_velocity, &sb.angular_velocity, t + i, &sa.angular_velocity, n);
+
+		for (uint32_t k = 0; k < n; k++) {
+			chunk_scatter(&ca, k, &out[i + k]);
+
+			// Invalid parts are zeroed, like a zero initialized relation.
+			if ((ca.flags[k] & XRT_SPACE_RELATION_ORIENTATION_VALID_BIT) == 0) {
+				out[i + k].pose.orientation = (struct xrt_quat){0};
+			}
+		}
+	}
+}
+
+void
+m_batch_relation_apply_one(const struct xrt_space_relation *base,
+                           const struct xrt_space_relation *relations,
+                           size_t stride,
+                           struct xrt_space_relation *out,
+                           uint32_t count)
+{
+	struct relation_chunk c;
+	struct m_relation_soa soa = chunk_soa(&c);
+
+	const char *src = (const char *)relations;
+
+	for (uint32_t i = 0; i < count; i += CHUNK_SIZE) {
+		uint32_t n = MIN(count - i, CHUNK_SIZE);
+
+		for (uint32_t k = 0; k < n; k++) {
+			chunk_gather(&c, k, (const struct xrt_space_relation *)(src + (i + k) * stride));
+		}
+
+		m_batch_relation_soa_apply_one(base, &soa, &soa, n);
+
+		for (uint32_t k = 0; k < n; k++) {
+			chunk_scatter(&c, k, &out[i + k]);
+		}
+	}
+}
@@ -0,0 +1,221 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Batched, structure of arrays, pose and relation math.
+ * @author agent <agent@local>
+ * @ingroup aux_math
+ *
+ * The functions here work on many poses at the same time, the data is laid out
+ * as a structure of arrays so that the compiler, and the SSE and NEON paths in
+ * the implementation, can work on four lanes at the same time. All functions
+ * give the same results as the single element functions in @ref m_api.h, up to
+ * floating point rounding. All outputs may alias the inputs.
+ */
+
+#pragma once
+
+#include "xrt/xrt_defines.h"
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*!
+ * A set of 3 element vectors as a structure of arrays.
+ *
+ * @ingroup aux_math
+ */
+struct m_vec3_soa
+{
+	float *x;
+	float *y;
+	float *z;
+};
+
+/*!
+ * A set of quaternions as a structure of arrays.
+ *
+ * @ingroup aux_math
+ */
+struct m_quat_soa
+{
+	float *x;
+	float *y;
+	float *z;
+	float *w;
+};
+
+/*!
+ * A set of poses as a structure of arrays.
+ *
+ * @ingroup aux_math
+ */
+struct m_pose_soa
+{
+	struct m_quat_soa orientation;
+	struct m_vec3_soa position;
+};
+
+
+/*!
+ * A set of relations as a structure of arrays, like with @ref
+ * xrt_space_relation only the parts marked valid in @ref flags are read.
+ *
+ * @ingroup aux_math
+ */
+struct m_relation_soa
+{
+	enum xrt_space_relation_flags *flags;
+	struct m_pose_soa pose;
+	struct m_vec3_soa linear_velocity;
+	struct m_vec3_soa angular_velocity;
+};
+
+
+/*
+ *
+ * Structure of arrays functions.
+ *
+ */
+
+/*!
+ * Rotate each vector in @p v by the quaternion of the same index in @p q.
+ *
+ * @see math_quat_rotate_vec3
+ * @ingroup aux_math
+ */
+void
+m_batch_quat_rotate_vec3(const struct m_quat_soa *q,
+                         const struct m_vec3_soa *v,
+                         struct m_vec3_soa *out,
+                         uint32_t count);
+
+/*!
+ * Transform each pose in @p pose by the pose of the same index in @p transform.
+ *
+ * @see math_pose_transform
+ * @ingroup aux_math
+ */
+void
+m_batch_pose_transform(const struct m_pose_soa *transform,
+                       const struct m_pose_soa *pose,
+                       struct m_pose_soa *out,
+                       uint32_t count);
+
+/*!
+ * Transform all poses in @p pose by the single pose @p transform, this is the
+ * common case of moving a set of joints or points into another space.
+ *
+ * @see math_pose_transform
+ * @ingroup aux_math
+ */
+void
+m_batch_pose_transform_one(const struct xrt_pose *transform,
+                           const struct m_pose_soa *pose,
+                           struct m_pose_soa *out,
+                           uint32_t count);
+
+/*!
+ * Linearly interpolate between each vector in @p a and @p b with the amount
+ * given in @p t.
+ *
+ * @see m_vec3_lerp
+ * @ingroup aux_math
+ */
+void
+m_batch_vec3_lerp(const struct m_vec3_soa *a,
+                  const struct m_vec3_soa *b,
+                  const float *t,
+                  struct m_vec3_soa *out,
+                  uint32_t count);
+
+/*!
+ * Spherically interpolate between each quaternion in @p a and @p b with the
+ * amount given in @p t, takes the shortest path.
+ *
+ * @see math_quat_slerp
+ * @ingroup aux_math
+ */
+void
+m_batch_quat_slerp(const struct m_quat_soa *a,
+                   const struct m_quat_soa *b,
+                   const float *t,
+                   struct m_quat_soa *out,
+                   uint32_t count);
+
+/*!
+ * Angular velocity that takes each quaternion in @p q0 to the one in @p q1 in
+ * @p dt seconds.
+ *
+ * @see math_quat_finite_difference
+ * @ingroup aux_math
+ */
+void
+m_batch_quat_finite_difference(const struct m_quat_soa *q0,
+                               const struct m_quat_soa *q1,
+                               float dt,
+                               struct m_vec3_soa *out,
+                               uint32_t count);
+
+
+/*
+ *
+ * Relation functions.
+ *
+ */
+
+/*!
+ * Apply the relation @p base to every relation in @p relations, same as
+ * @ref m_batch_relation_apply_one but without any copying in and out of
+ * structure of arrays form.
+ *
+ * @ingroup aux_math
+ */
+void
+m_batch_relation_soa_apply_one(const struct xrt_space_relation *base,
+                               const struct m_relation_soa *relations,
+                               struct m_relation_soa *out,
+                               uint32_t count);
+
+/*!
+ * Interpolate between each relation in @p a and @p b with the amount given in
+ * @p t, the resulting flags are the flags common to both relations and only the
+ * valid parts are interpolated, the rest is zeroed.
+ *
+ * @ingroup aux_math
+ */
+void
+m_batch_relation_interpolate(const struct xrt_space_relation *a,
+                             const struct xrt_space_relation *b,
+                             const float *t,
+                             struct xrt_space_relation *out,
+                             uint32_t count);
+
+/*!
+ * Apply the relation @p base to every relation in @p relations, gives the same
+ * result as pushing the relation and then @p base to a @ref xrt_relation_chain
+ * and resolving it, but for all relations in one go.
+ *
+ * The @p stride is the distance in bytes between each relation, so relations
+ * embedded in larger structs like @ref xrt_hand_joint_value can be used
+ * directly. The output is tightly packed.
+ *
+ * @see m_relation_chain_resolve
+ * @ingroup aux_math
+ */
+void
+m_batch_relation_apply_one(const struct xrt_space_relation *base,
+                           const struct xrt_space_relation *relations,
+                           size_t stride,
+                           struct xrt_space_relation *out,
+                           uint32_t count);
+
+
+#ifdef __cplusplus
+}
+#endif
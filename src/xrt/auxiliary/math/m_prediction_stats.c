@@ -0,0 +1,245 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Statistics on how far devices are asked to predict poses.
+ * @author agent <agent@local>
+ * @ingroup aux_math
+ */
+
+#include "math/m_prediction_stats.h"
+
+#include "util/u_time.h"
+#include "util/u_metrics.h"
+#include "util/u_telemetry.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define HORIZON_BIN_NS (5 * U_TIME_1MS_IN_NS)
+#define EXTRAPOLATION_BIN_NS (5 * U_TIME_1MS_IN_NS)
+#define SAMPLE_AGE_BIN_NS (2 * U_TIME_1MS_IN_NS)
+
+
+/*
+ *
+ * Helpers.
+ *
+ */
+
+//! Negative values go in the first bin, too large ones in the last.
+static inline void
+add_to_bins(float *bins, int64_t value_ns, int64_t bin_ns)
+{
+	int64_t index = value_ns / bin_ns;
+
+	if (index < 0) {
+		index = 0;
+	} else if (index >= M_PREDICTION_STATS_BIN_COUNT) {
+		index = M_PREDICTION_STATS_BIN_COUNT - 1;
+	}
+
+	bins[index] += 1.0f;
+}
+
+static inline int64_t
+max_i64(int64_t a, int64_t b)
+{
+	return a > b ? a : b;
+}
+
+static inline int64_t
+mean_ns(int64_t sum, uint64_t count)
+{
+	return count == 0 ? 0 : sum / (int64_t)count;
+}
+
+static uint64_t
+period_total(const struct m_prediction_stats_period *p)
+{
+	uint64_t total = 0;
+	for (int i = 0; i < M_PREDICTION_KIND_COUNT; i++) {
+		total += p->counts[i];
+	}
+
+	return total;
+}
+
+static void
+period_reset(struct m_prediction_stats_period *p, int64_t now_ns)
+{
+	memset(p, 0, sizeof(*p));
+	p->start_ns = now_ns;
+	p->horizon_max_ns = INT64_MIN;
+	p->extrapolation_max_ns = INT64_MIN;
+	p->sample_age_max_ns = INT64_MIN;
+}
+
+static void
+period_add(struct m_prediction_stats_period *p,
+           enum m_prediction_kind kind,
+           int64_t horizon_ns,
+           int64_t sample_age_ns,
+           int64_t extrapolation_ns)
+{
+	p->counts[kind]++;
+
+	p->horizon_sum_ns += horizon_ns;
+	p->horizon_max_ns = max_i64(p->horizon_max_ns, horizon_ns);
+	p->sample_age_sum_ns += sample_age_ns;
+	p->sample_age_max_ns = max_i64(p->sample_age_max_ns, sample_age_ns);
+
+	if (kind == M_PREDICTION_KIND_PREDICTED) {
+		p->extrapolated_count++;
+		p->extrapolation_sum_ns += extrapolation_ns;
+		p->extrapolation_max_ns = max_i64(p->extrapolation_max_ns, extrapolation_ns);
+	}
+}
+
+static void
+write_and_reset_period(struct m_prediction_stats *stats, int64_t now_ns)
+{
+	const struct m_prediction_stats_period *p = &stats->period;
+	uint64_t total = period_total(p);
+
+	if (total > 0 && u_metrics_is_active()) {
+		struct u_metrics_device_prediction umdp = {0};
+		snprintf(umdp.device_name, sizeof(umdp.device_name), "%s", stats->name);
+		umdp.when_ns = (uint64_t)now_ns;
+		umdp.exact_count = p->counts[M_PREDICTION_KIND_EXACT];
+		umdp.interpolated_count = p->counts[M_PREDICTION_KIND_INTERPOLATED];
+		umdp.predicted_count = p->counts[M_PREDICTION_KIND_PREDICTED];
+		umdp.reverse_predicted_count = p->counts[M_PREDICTION_KIND_REVERSE_PREDICTED];
+		umdp.horizon_mean_ns = mean_ns(p->horizon_sum_ns, total);
+		umdp.horizon_max_ns = p->horizon_max_ns;
+		umdp.extrapolation_mean_ns = mean_ns(p->extrapolation_sum_ns, p->extrapolated_count);
+		umdp.extrapolation_max_ns = p->extrapolated_count > 0 ? p->extrapolation_max_ns : 0;
+		umdp.sample_age_mean_ns = mean_ns(p->sample_age_sum_ns, total);
+		umdp.sample_age_max_ns = p->sample_age_max_ns;
+
+		u_metrics_write_device_prediction(&umdp);
+	}
+
+	period_reset(&stats->period, now_ns);
+}
+
+static void
+push_and_reset_telemetry_period(struct m_prediction_stats *stats, int64_t now_ns)
+{
+	const struct m_prediction_stats_period *p = &stats->telemetry_period;
+	uint64_t total = period_total(p);
+
+	if (total > 0) {
+		struct u_telemetry_device_poses utdp = {0};
+		snprintf(utdp.device_name, sizeof(utdp.device_name), "%s", stats->name);
+		utdp.period_ns = (uint64_t)(now_ns - p->start_ns);
+		utdp.sample_count = p->sample_count;
+		utdp.query_count = total;
+		utdp.predicted_count = p->counts[M_PREDICTION_KIND_PREDICTED];
+		utdp.horizon_mean_ns = mean_ns(p->horizon_sum_ns, total);
+		utdp.sample_age_mean_ns = mean_ns(p->sample_age_sum_ns, total);
+		utdp.sample_age_max_ns = p->sample_age_max_ns;
+
+		u_telemetry_push_device_poses((uint64_t)now_ns, &utdp);
+	}
+
+	period_reset(&stats->telemetry_period, now_ns);
+}
+
+
+/*
+ *
+ * 'Exported' functions.
+ *
+ */
+
+void
+m_prediction_stats_init(struct m_prediction_stats *stats, const char *name)
+{
+	memset(stats, 0, sizeof(*stats));
+
+	snprintf(stats->name, sizeof(stats->name), "%s", name);
+
+	stats->horizon_histogram.values = stats->horizon_bins;
+	stats->horizon_histogram.count = M_PREDICTION_STATS_BIN_COUNT;
+	stats->extrapolation_histogram.values = stats->extrapolation_bins;
+	stats->extrapolation_histogram.count = M_PREDICTION_STATS_BIN_COUNT;
+	stats->sample_age_histogram.values = stats->sample_age_bins;
+	stats->sample_age_histogram.count = M_PREDICTION_STATS_BIN_COUNT;
+
+	write_and_reset_period(stats, 0);
+}
+
+void
+m_prediction_stats_add(
+    struct m_prediction_stats *stats, enum m_prediction_kind kind, int64_t now_ns, int64_t at_ns, int64_t newest_ns)
+{
+	if (stats->period.start_ns == 0) {
+		stats->period.start_ns = now_ns;
+	} else if (now_ns - stats->period.start_ns >= U_TIME_1S_IN_NS) {
+		write_and_reset_period(stats, now_ns);
+	}
+
+	int64_t horizon_ns = at_ns - now_ns;
+	int64_t sample_age_ns = now_ns - newest_ns;
+	int64_t extrapolation_ns = at_ns - newest_ns;
+
+	stats->counts[kind]++;
+
+	add_to_bins(stats->horizon_bins, horizon_ns, HORIZON_BIN_NS);
+	add_to_bins(stats->sample_age_bins, sample_age_ns, SAMPLE_AGE_BIN_NS);
+	if (kind == M_PREDICTION_KIND_PREDICTED) {
+		add_to_bins(stats->extrapolation_bins, extrapolation_ns, EXTRAPOLATION_BIN_NS);
+	}
+
+	period_add(&stats->period, kind, horizon_ns, sample_age_ns, extrapolation_ns);
+
+	if (u_telemetry_is_active()) {
+		if (stats->telemetry_period.start_ns == 0) {
+			period_reset(&stats->telemetry_period, now_ns);
+		} else if (now_ns - stats->telemetry_period.start_ns >= M_PREDICTION_STATS_TELEMETRY_PERIOD_NS) {
+			push_and_reset_telemetry_period(stats, now_ns);
+		}
+
+		period_add(&stats->telemetry_period, kind, horizon_ns, sample_age_ns, extrapolation_ns);
+	} else if (stats->telemetry_period.start_ns != 0) {
+		// Nobody reading, start over once somebody is.
+		memset(&stats->telemetry_period, 0, sizeof(stats->telemetry_period));
+	}
+
+	uint64_t total = 0;
+	for (int i = 0; i < M_PREDICTION_KIND_COUNT; i++) {
+		total += stats->counts[i];
+	}
+
+	uint64_t extrapolated =
+	    stats->counts[M_PREDICTION_KIND_PREDICTED] + stats->counts[M_PREDICTION_KIND_REVERSE_PREDICTED];
+	stats->extrapolated_percent = (float)extrapolated * 100.0f / (float)total;
+}
+
+void
+m_prediction_stats_add_sample(struct m_prediction_stats *stats)
+{
+	stats->period.sample_count++;
+
+	// Only counted once the period has been started by a query.
+	if (stats->telemetry_period.start_ns != 0) {
+		stats->telemetry_period.sample_count++;
+	}
+}
+
+void
+m_prediction_stats_add_vars(struct m_prediction_stats *stats, void *root)
+{
+	u_var_add_gui_header_begin(root, NULL, "Prediction");
+	u_var_add_ro_u64(root, &stats->counts[M_PREDICTION_KIND_EXACT], "Exact");
+	u_var_add_ro_u64(root, &stats->counts[M_PREDICTION_KIND_INTERPOLATED], "Interpolated");
+	u_var_add_ro_u64(root, &stats->counts[M_PREDICTION_KIND_PREDICTED], "Predicted");
+	u_var_add_ro_u64(root, &stats->counts[M_PREDICTION_KIND_REVERSE_PREDICTED], "Reverse predicted");
+	u_var_add_ro_f32(root, &stats->extrapolated_percent, "Extrapolated (%)");
+	u_var_add_histogram_f32(root, &stats->horizon_histogram, "Horizon (5ms bins)");
+	u_var_add_histogram_f32(root, &stats->extrapolation_histogram, "Extrapolation (5ms bins)");
+	u_var_add_histogram_f32(root, &stats->sample_age_histogram, "Sample age (2ms bins)");
+	u_var_add_gui_header_end(root, NULL, NULL);
+}
@@ -0,0 +1,139 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Statistics on how far devices are asked to predict poses.
+ * @author agent <agent@local>
+ * @ingroup aux_math
+ */
+
+#pragma once
+
+#include "xrt/xrt_defines.h"
+#include "util/u_var.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Number of bins in each of the @ref m_prediction_stats histograms.
+#define M_PREDICTION_STATS_BIN_COUNT (16)
+
+//! Length of the periods pushed to the telemetry ring, see @ref u_telemetry_ring.
+#define M_PREDICTION_STATS_TELEMETRY_PERIOD_NS (20 * 1000 * 1000)
+
+/*!
+ * How the pose for a query was made.
+ *
+ * @ingroup aux_math
+ */
+enum m_prediction_kind
+{
+	M_PREDICTION_KIND_EXACT,             //!< A sample had the exact timestamp.
+	M_PREDICTION_KIND_INTERPOLATED,      //!< Between two samples.
+	M_PREDICTION_KIND_PREDICTED,         //!< Extrapolated past the newest sample.
+	M_PREDICTION_KIND_REVERSE_PREDICTED, //!< Before the oldest sample.
+	M_PREDICTION_KIND_COUNT,
+};
+
+/*!
+ * Statistics gathered over one period.
+ *
+ * @ingroup aux_math
+ */
+struct m_prediction_stats_period
+{
+	int64_t start_ns;
+	uint64_t counts[M_PREDICTION_KIND_COUNT];
+	uint64_t extrapolated_count;
+	int64_t horizon_sum_ns;
+	int64_t horizon_max_ns;
+	int64_t extrapolation_sum_ns;
+	int64_t extrapolation_max_ns;
+	int64_t sample_age_sum_ns;
+	int64_t sample_age_max_ns;
+	//! New samples the device got, for the sample rate.
+	uint64_t sample_count;
+};
+
+/*!
+ * Accumulates statistics on pose queries for one device, shown in the debug
+ * gui and written to the metrics file once a second, see @ref metrics. While
+ * somebody reads the telemetry ring shorter periods are also pushed to it.
+ *
+ * Not thread safe, callers are expected to hold the lock that protects the
+ * samples they are predicting from.
+ *
+ * @ingroup aux_math
+ */
+struct m_prediction_stats
+{
+	char name[64];
+
+	//! @name Totals since init, shown in the debug gui.
+	//! @{
+	uint64_t counts[M_PREDICTION_KIND_COUNT];
+	float extrapolated_percent;
+
+	//! Query time minus current time, 5ms bins.
+	float horizon_bins[M_PREDICTION_STATS_BIN_COUNT];
+	//! Query time minus newest sample time for extrapolated queries, 5ms bins.
+	float extrapolation_bins[M_PREDICTION_STATS_BIN_COUNT];
+	//! Current time minus newest sample time, 2ms bins.
+	float sample_age_bins[M_PREDICTION_STATS_BIN_COUNT];
+
+	struct u_var_histogram_f32 horizon_histogram;
+	struct u_var_histogram_f32 extrapolation_histogram;
+	struct u_var_histogram_f32 sample_age_histogram;
+	//! @}
+
+	//! Period that is written to the metrics file.
+	struct m_prediction_stats_period period;
+
+	//! Period that is pushed to the telemetry ring, only gathered while it has readers.
+	struct m_prediction_stats_period telemetry_period;
+};
+
+/*!
+ * @public @memberof m_prediction_stats
+ */
+void
+m_prediction_stats_init(struct m_prediction_stats *stats, const char *name);
+
+/*!
+ * Record one pose query.
+ *
+ * @param stats         Self.
+ * @param kind          How the returned pose was made.
+ * @param now_ns        Current monotonic time.
+ * @param at_ns         Time the pose was asked for.
+ * @param newest_ns     Timestamp of the newest sample the device had.
+ *
+ * @public @memberof m_prediction_stats
+ */
+void
+m_prediction_stats_add(
+    struct m_prediction_stats *stats, enum m_prediction_kind kind, int64_t now_ns, int64_t at_ns, int64_t newest_ns);
+
+/*!
+ * Record that the device got a new pose sample.
+ *
+ * @public @memberof m_prediction_stats
+ */
+void
+m_prediction_stats_add_sample(struct m_prediction_stats *stats);
+
+/*!
+ * Add the statistics to the debug gui under @p root, the stats must outlive
+ * the root.
+ *
+ * @public @memberof m_prediction_stats
+ */
+void
+m_prediction_stats_add_vars(struct m_prediction_stats *stats, void *root);
+
+
+#ifdef __cplusplus
+}
+#endif
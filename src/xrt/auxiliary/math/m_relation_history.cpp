@@ -13,6 +13,8 @@
 
 #include "math/m_api.h"
 #include "math/m_predict.h"
+#include "math/m_pose_batch.h"
+#include "math/m_prediction_stats.h"
 #include "math/m_vec3.h"
 #include "os/os_time.h"
 #include "util/u_logging.h"
@@ -45,6 +47,9 @@ struct m_relation_history
 {
 	HistoryBuffer<struct relation_history_entry, BufLen> impl;
 	os::Mutex mutex;
+
+	//! Only set if enabled, protected by the mutex.
+	std::unique_ptr<m_prediction_stats> stats;
 };
 
 
@@ -72,6 +77,10 @@ m_relation_history_push(struct m_relation_history *rh, struct xrt_space_relation
 			// in the history.
 			rh->impl.push_back(rhe);
 			ret = true;
+
+			if (rh->stats) {
+				m_prediction_stats_add_sample(rh->stats.get());
+			}
 		}
 	} catch (std::exception const &e) {
 		U_LOG_E("Caught exception: %s", e.what());
@@ -79,11 +88,9 @@ m_relation_history_push(struct m_relation_history *rh, struct xrt_space_relation
 	return ret;
 }
 
-enum m_relation_history_result
-m_relation_history_get(struct m_relation_history *rh, uint64_t at_timestamp_ns, struct xrt_space_relation *out_relation)
+static enum m_relation_history_result
+get_locked(struct m_relation_history *rh, uint64_t at_timestamp_ns, struct xrt_space_relation *out_relation)
 {
-	XRT_TRACE_MARKER();
-	std::unique_lock<os::Mutex> lock(rh->mutex);
 	try {
 		if (rh->impl.empty() || at_timestamp_ns == 0) {
 			// Do nothing. You push nothing to the buffer you get nothing from the buffer.
@@ -141,30 +148,10 @@ m_relation_history_get(struct m_relation_history *rh, uint64_t at_timestamp_ns,
 
 		float amount_to_lerp = (float)diff_before / (float)(diff_before + diff_after);
 
-		// Copy relation flags
-		xrt_space_relation result{};
-		result.relation_flags = (enum xrt_space_relation_flags)(predecessor.relation.relation_flags &
-		                                                        successor.relation.relation_flags);
-		// First-order implementation - lerp between the before and after
-		if (0 != (result.relation_flags & XRT_SPACE_RELATION_POSITION_VALID_BIT)) {
-			result.pose.position = m_vec3_lerp(predecessor.relation.pose.position,
-			                                   successor.relation.pose.position, amount_to_lerp);
-		}
-		if (0 != (result.relation_flags & XRT_SPACE_RELATION_ORIENTATION_VALID_BIT)) {
-
-			math_quat_slerp(&predecessor.relation.pose.orientation, &successor.relation.pose.orientation,
-			                amount_to_lerp, &result.pose.orientation);
-		}
-
+		// First-order implementation - lerp between the before and after, only the common flags are kept.
 		//! @todo Does interpolating the velocities make any sense?
-		if (0 != (result.relation_flags & XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT)) {
-			result.angular_velocity = m_vec3_lerp(predecessor.relation.angular_velocity,
-			                                      successor.relation.angular_velocity, amount_to_lerp);
-		}
-		if (0 != (result.relation_flags & XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT)) {
-			result.linear_velocity = m_vec3_lerp(predecessor.relation.linear_velocity,
-			                                     successor.relation.linear_velocity, amount_to_lerp);
-		}
+		xrt_space_relation result{};
+		m_batch_relation_interpolate(&predecessor.relation, &successor.relation, &amount_to_lerp, &result, 1);
 		*out_relation = result;
 		return M_RELATION_HISTORY_RESULT_INTERPOLATED;
 
@@ -174,6 +161,52 @@ m_relation_history_get(struct m_relation_history *rh, uint64_t at_timestamp_ns,
 	}
 }
 
+static void
+add_stats_locked(struct m_relation_history *rh, enum m_relation_history_result result, uint64_t at_timestamp_ns)
+{
+	enum m_prediction_kind kind;
+	switch (result) {
+	case M_RELATION_HISTORY_RESULT_EXACT: kind = M_PREDICTION_KIND_EXACT; break;
+	case M_RELATION_HISTORY_RESULT_INTERPOLATED: kind = M_PREDICTION_KIND_INTERPOLATED; break;
+	case M_RELATION_HISTORY_RESULT_PREDICTED: kind = M_PREDICTION_KIND_PREDICTED; break;
+	case M_RELATION_HISTORY_RESULT_REVERSE_PREDICTED: kind = M_PREDICTION_KIND_REVERSE_PREDICTED; break;
+	default: return;
+	}
+
+	int64_t now_ns = (int64_t)os_monotonic_get_ns();
+	int64_t newest_ns = (int64_t)rh->impl.back().timestamp;
+
+	m_prediction_stats_add(rh->stats.get(), kind, now_ns, (int64_t)at_timestamp_ns, newest_ns);
+}
+
+enum m_relation_history_result
+m_relation_history_get(struct m_relation_history *rh, uint64_t at_timestamp_ns, struct xrt_space_relation *out_relation)
+{
+	XRT_TRACE_MARKER();
+	std::unique_lock<os::Mutex> lock(rh->mutex);
+
+	enum m_relation_history_result result = get_locked(rh, at_timestamp_ns, out_relation);
+
+	if (rh->stats) {
+		add_stats_locked(rh, result, at_timestamp_ns);
+	}
+
+	return result;
+}
+
+void
+m_relation_history_enable_stats(struct m_relation_history *rh, void *root, const char *name)
+{
+	std::unique_lock<os::Mutex> lock(rh->mutex);
+	if (rh->stats) {
+		return;
+	}
+
+	rh->stats = std::make_unique<m_prediction_stats>();
+	m_prediction_stats_init(rh->stats.get(), name);
+	m_prediction_stats_add_vars(rh->stats.get(), root);
+}
+
 bool
 m_relation_history_estimate_motion(struct m_relation_history *rh,
                                    const struct xrt_space_relation *in_relation,
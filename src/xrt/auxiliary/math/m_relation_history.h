@@ -71,6 +71,17 @@ m_relation_history_get(struct m_relation_history *rh,
                        uint64_t at_timestamp_ns,
                        struct xrt_space_relation *out_relation);
 
+/*!
+ * Keep statistics on the @ref m_relation_history_get calls, how far ahead
+ * callers ask and how often the history has to extrapolate. They are shown in
+ * the debug gui under @p root, so the history must be destroyed after the root
+ * is removed, and written to the metrics file tagged with @p name.
+ *
+ * @public @memberof m_relation_history
+ */
+void
+m_relation_history_enable_stats(struct m_relation_history *rh, void *root, const char *name);
+
 /*!
  * Estimates the movement (velocity and angular velocity) of a new relation based on
  * the latest relation found in the buffer (as returned by m_relation_history_get_latest).
@@ -42,6 +42,52 @@ extern "C" {
  * @{
  */
 
+/*
+ *
+ * Thread classes
+ *
+ */
+
+/*!
+ * What kind of work a long lived thread does, used to look up the scheduling
+ * policy and CPU affinity it should get, see @ref u_linux_thread_class_apply.
+ */
+enum os_thread_class
+{
+	//! Not put into any class, left as it was created.
+	OS_THREAD_CLASS_DEFAULT = 0,
+	//! Compositor main loop and client frame pacing.
+	OS_THREAD_CLASS_COMPOSITOR,
+	//! Per client IPC threads in the service.
+	OS_THREAD_CLASS_IPC,
+	//! Driver threads reading from HID/USB/etc, where latency matters.
+	OS_THREAD_CLASS_DRIVER_IO,
+	//! Tracker threads like SLAM and the PS Move tracker.
+	OS_THREAD_CLASS_TRACKING,
+	//! Worker pool threads.
+	OS_THREAD_CLASS_WORKER,
+
+	OS_THREAD_CLASS_COUNT,
+};
+
+/*!
+ * Name of the thread class, also used as the key in the config file.
+ */
+static inline const char *
+os_thread_class_str(enum os_thread_class cls)
+{
+	switch (cls) {
+	case OS_THREAD_CLASS_DEFAULT: return "default";
+	case OS_THREAD_CLASS_COMPOSITOR: return "compositor";
+	case OS_THREAD_CLASS_IPC: return "ipc";
+	case OS_THREAD_CLASS_DRIVER_IO: return "driver_io";
+	case OS_THREAD_CLASS_TRACKING: return "tracking";
+	case OS_THREAD_CLASS_WORKER: return "worker";
+	default: return "unknown";
+	}
+}
+
+
 /*
  *
  * Mutex
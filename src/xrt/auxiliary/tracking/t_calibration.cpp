@@ -9,19 +9,33 @@
  * @ingroup aux_tracking
  */
 
+#include "os/os_time.h"
+#include "os/os_threading.h"
+
 #include "util/u_sink.h"
 #include "util/u_misc.h"
+#include "util/u_time.h"
 #include "util/u_debug.h"
 #include "util/u_frame.h"
 #include "util/u_format.h"
+#include "util/u_json.hpp"
 #include "util/u_logging.h"
+#include "util/u_worker.h"
+#include "util/u_worker.hpp"
 
 #include "tracking/t_tracking.h"
 #include "tracking/t_calibration_opencv.hpp"
 
 #include <opencv2/opencv.hpp>
 #include <sys/stat.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 #include <utility>
+#include <algorithm>
+#include <filesystem>
 
 #if CV_MAJOR_VERSION >= 4
 #define SB_CHEESBOARD_CORNERS_SUPPORTED
@@ -34,8 +48,25 @@
 DEBUG_GET_ONCE_BOOL_OPTION(hsv_filter, "T_DEBUG_HSV_FILTER", false)
 DEBUG_GET_ONCE_BOOL_OPTION(hsv_picker, "T_DEBUG_HSV_PICKER", false)
 DEBUG_GET_ONCE_BOOL_OPTION(hsv_viewer, "T_DEBUG_HSV_VIEWER", false)
+DEBUG_GET_ONCE_BOOL_OPTION(coarse_detect, "T_CALIBRATION_COARSE_DETECT", true)
+
+/*!
+ * Checkerboards are first detected on a image downscaled by a power of two,
+ * down to no less then this width, and then refined on the full image.
+ */
+#define COARSE_DETECT_MIN_COLS (480)
+
+//! Max number of pyramid levels the checkerboard detection goes down.
+#define COARSE_DETECT_MAX_LEVELS (2)
 
 namespace xrt::auxiliary::tracking {
+
+using xrt::auxiliary::util::json::JSONBuilder;
+using xrt::auxiliary::util::json::JSONNode;
+using xrt::auxiliary::util::SharedThreadGroup;
+using xrt::auxiliary::util::SharedThreadPool;
+using xrt::auxiliary::util::TaskCollection;
+
 /*
  *
  * Structs
@@ -80,18 +111,68 @@ struct ViewState
 	cv::Rect pre_rect = {};
 	cv::Rect post_rect = {};
 
+	//! Downscaled image used for coarse checkerboard detection.
+	cv::Mat coarse_gray = {};
+
 	bool maps_valid = false;
 	cv::Mat map1 = {};
 	cv::Mat map2 = {};
 };
 
+/*!
+ * Results from solving the calibration, produced on the solve thread and
+ * applied on the sink thread.
+ */
+struct CalibrationResult
+{
+	//! Undistortion/rectification maps for previewing each view.
+	cv::Mat map1[2] = {};
+	cv::Mat map2[2] = {};
+
+	//! Message to show to the user.
+	char text[512] = {};
+
+	//! Only produced for stereo calibrations.
+	struct t_stereo_camera_calibration *stereo_data = NULL;
+};
+
 /*!
  * Main class for doing calibration.
+ *
+ * @implements xrt_frame_sink
+ * @implements xrt_frame_node
  */
 class Calibration
 {
 public:
 	struct xrt_frame_sink base = {};
+	struct xrt_frame_node node = {};
+
+	//! Used to detect the board in the stereo views in parallel.
+	SharedThreadPool pool;
+	SharedThreadGroup group{pool};
+
+	/*!
+	 * The final solve can take many seconds, it is done on this thread so
+	 * that the preview keeps up with the camera.
+	 */
+	struct
+	{
+		struct os_thread_helper oth = {};
+
+		//! Has the solve been started, only used by the sink thread.
+		bool started = false;
+
+		//! Set when the results are ready, protected by the thread helper's mutex.
+		bool done = false;
+
+		uint64_t start_ns = 0;
+		int cols = 0;
+		int rows = 0;
+		bool stereo = false;
+
+		CalibrationResult result = {};
+	} solve;
 
 	struct
 	{
@@ -138,6 +219,9 @@ public:
 	//! What subpixel range for checkerboard enhancement.
 	int subpixel_size = 5;
 
+	//! Detect checkerboards on a downscaled image first.
+	bool coarse_detect = true;
+
 	//! Number of frames to wait for cooldown.
 	uint32_t num_cooldown_frames = 20;
 	//! Number of frames to wait for before collecting.
@@ -169,6 +253,14 @@ public:
 	char text[512] = {};
 
 	t_calibration_status *status;
+
+
+public:
+	//! For the live sink, two threads to detect the views in parallel.
+	Calibration() : pool{1, 2, "Calibration"} {}
+
+	//! Uses @p uwtp instead of spawning its own threads, adds a reference.
+	explicit Calibration(struct u_worker_thread_pool *uwtp) : pool{uwtp} {}
 };
 
 
@@ -292,8 +384,73 @@ do_view_coverage(class Calibration &c, struct ViewState &view, cv::Mat &gray, cv
 	cv::drawChessboardCorners(rgb, c.board.dims, view.current_f32, found);
 }
 
+static int
+calc_coarse_levels(class Calibration &c, const cv::Mat &gray)
+{
+	if (!c.coarse_detect) {
+		return 0;
+	}
+
+	int levels = 0;
+	int cols = gray.cols;
+	while (levels < COARSE_DETECT_MAX_LEVELS && (cols / 2) >= COARSE_DETECT_MIN_COLS) {
+		cols /= 2;
+		levels++;
+	}
+
+	return levels;
+}
+
+/*!
+ * Runs @p find on a downscaled copy of the image, if it's large enough, and
+ * scales the found corners back up. The corners must then be refined on the
+ * full resolution image, returns the number of levels that was used.
+ */
+template <typename Func>
+static int
+find_corners_coarse(class Calibration &c, struct ViewState &view, cv::Mat &gray, bool &out_found, Func find)
+{
+	int levels = calc_coarse_levels(c, gray);
+	if (levels == 0) {
+		out_found = find(gray);
+		return 0;
+	}
+
+	const int factor = 1 << levels;
+	const double scale = 1.0 / factor;
+
+	cv::resize(gray, view.coarse_gray, cv::Size(), scale, scale, cv::INTER_AREA);
+
+	out_found = find(view.coarse_gray);
+
+	// From the center of the downscaled pixels to full resolution pixels.
+	for (cv::Point2f &p : view.current_f32) {
+		p.x = (p.x + 0.5f) * factor - 0.5f;
+		p.y = (p.y + 0.5f) * factor - 0.5f;
+	}
+
+	return levels;
+}
+
+static void
+refine_corners(class Calibration &c, struct ViewState &view, cv::Mat &gray, int levels)
+{
+	int crit_flag = 0;
+	crit_flag |= cv::TermCriteria::EPS;
+	crit_flag |= cv::TermCriteria::COUNT;
+	cv::TermCriteria term_criteria = {crit_flag, 30, 0.1};
+
+	// Needs to at least cover the error from the coarse detection.
+	int half_size = std::max(c.subpixel_size, (1 << levels) + 1);
+
+	cv::Size size(half_size, half_size);
+	cv::Size zero(-1, -1);
+
+	cv::cornerSubPix(gray, view.current_f32, size, zero, term_criteria);
+}
+
 static bool
-do_view_chess(class Calibration &c, struct ViewState &view, cv::Mat &gray, cv::Mat &rgb)
+detect_chess(class Calibration &c, struct ViewState &view, cv::Mat &gray)
 {
 	/*
 	 * Fisheye requires measurement and model to be double, other functions
@@ -306,22 +463,17 @@ do_view_chess(class Calibration &c, struct ViewState &view, cv::Mat &gray, cv::M
 	flags += cv::CALIB_CB_ADAPTIVE_THRESH;
 	flags += cv::CALIB_CB_NORMALIZE_IMAGE;
 
-	bool found = cv::findChessboardCorners(gray,             // Image
-	                                       c.board.dims,     // patternSize
-	                                       view.current_f32, // corners
-	                                       flags);           // flags
-
-	// Improve the corner positions.
-	if (found && c.subpixel_enable) {
-		int crit_flag = 0;
-		crit_flag |= cv::TermCriteria::EPS;
-		crit_flag |= cv::TermCriteria::COUNT;
-		cv::TermCriteria term_criteria = {crit_flag, 30, 0.1};
-
-		cv::Size size(c.subpixel_size, c.subpixel_size);
-		cv::Size zero(-1, -1);
-
-		cv::cornerSubPix(gray, view.current_f32, size, zero, term_criteria);
+	bool found = false;
+	int levels = find_corners_coarse(c, view, gray, found, [&](cv::Mat &image) {
+		return cv::findChessboardCorners(image,            // Image
+		                                 c.board.dims,     // patternSize
+		                                 view.current_f32, // corners
+		                                 flags);           // flags
+	});
+
+	// Improve the corner positions, always needed after coarse detection.
+	if (found && (c.subpixel_enable || levels > 0)) {
+		refine_corners(c, view, gray, levels);
 	}
 
 	// Do the conversion here.
@@ -330,14 +482,12 @@ do_view_chess(class Calibration &c, struct ViewState &view, cv::Mat &gray, cv::M
 		view.current_f64.emplace_back(double(p.x), double(p.y));
 	}
 
-	do_view_coverage(c, view, gray, rgb, found);
-
 	return found;
 }
 
 #ifdef SB_CHEESBOARD_CORNERS_SUPPORTED
 static bool
-do_view_sb_checkers(class Calibration &c, struct ViewState &view, cv::Mat &gray, cv::Mat &rgb)
+detect_sb_checkers(class Calibration &c, struct ViewState &view, cv::Mat &gray)
 {
 	/*
 	 * Fisheye requires measurement and model to be double, other functions
@@ -357,10 +507,18 @@ do_view_sb_checkers(class Calibration &c, struct ViewState &view, cv::Mat &gray,
 	}
 #endif
 
-	bool found = cv::findChessboardCornersSB(gray,             // Image
-	                                         c.board.dims,     // patternSize
-	                                         view.current_f32, // corners
-	                                         flags);           // flags
+	bool found = false;
+	int levels = find_corners_coarse(c, view, gray, found, [&](cv::Mat &image) {
+		return cv::findChessboardCornersSB(image,            // Image
+		                                   c.board.dims,     // patternSize
+		                                   view.current_f32, // corners
+		                                   flags);           // flags
+	});
+
+	// The SB detector is accurate on its own, but not after coarse detection.
+	if (found && levels > 0) {
+		refine_corners(c, view, gray, levels);
+	}
 
 	// Do the conversion here.
 	view.current_f64.clear(); // Doesn't effect capacity.
@@ -368,14 +526,12 @@ do_view_sb_checkers(class Calibration &c, struct ViewState &view, cv::Mat &gray,
 		view.current_f64.emplace_back(double(p.x), double(p.y));
 	}
 
-	do_view_coverage(c, view, gray, rgb, found);
-
 	return found;
 }
 #endif
 
 static bool
-do_view_circles(class Calibration &c, struct ViewState &view, cv::Mat &gray, cv::Mat &rgb)
+detect_circles(class Calibration &c, struct ViewState &view, cv::Mat &gray)
 {
 	/*
 	 * Fisheye requires measurement and model to be double, other functions
@@ -399,34 +555,46 @@ do_view_circles(class Calibration &c, struct ViewState &view, cv::Mat &gray, cv:
 		view.current_f32.emplace_back(float(p.x), float(p.y));
 	}
 
-	do_view_coverage(c, view, gray, rgb, found);
-
 	return found;
 }
 
+/*!
+ * Finds the board in the image, only touches @p view so it's safe to call
+ * from multiple threads with different views.
+ */
 static bool
-do_view(class Calibration &c, struct ViewState &view, cv::Mat &gray, cv::Mat &rgb)
+detect_view(class Calibration &c, struct ViewState &view, cv::Mat &gray)
 {
 	bool found = false;
 
 	switch (c.board.pattern) {
 	case T_BOARD_CHECKERS: //
-		found = do_view_chess(c, view, gray, rgb);
+		found = detect_chess(c, view, gray);
 		break;
 #ifdef SB_CHEESBOARD_CORNERS_SUPPORTED
 	case T_BOARD_SB_CHECKERS: //
-		found = do_view_sb_checkers(c, view, gray, rgb);
+		found = detect_sb_checkers(c, view, gray);
 		break;
 #endif
 	case T_BOARD_CIRCLES: //
-		found = do_view_circles(c, view, gray, rgb);
+		found = detect_circles(c, view, gray);
 		break;
 	case T_BOARD_ASYMMETRIC_CIRCLES: //
-		found = do_view_circles(c, view, gray, rgb);
+		found = detect_circles(c, view, gray);
 		break;
 	default: assert(false);
 	}
 
+	return found;
+}
+
+static bool
+do_view(class Calibration &c, struct ViewState &view, cv::Mat &gray, cv::Mat &rgb)
+{
+	bool found = detect_view(c, view, gray);
+
+	do_view_coverage(c, view, gray, rgb, found);
+
 	if (c.mirror_rgb_image) {
 		cv::flip(rgb, rgb, +1);
 	}
@@ -505,6 +673,56 @@ build_board_position(class Calibration &c)
 	}
 }
 
+/*!
+ * Setup the board and the parameters shared by live and offline calibration.
+ */
+static void
+setup_from_params(class Calibration &c, const struct t_calibration_params *params)
+{
+	c.use_fisheye = params->use_fisheye;
+	c.stereo_sbs = params->stereo_sbs;
+	c.board.pattern = params->pattern;
+	switch (params->pattern) {
+	case T_BOARD_CHECKERS:
+		c.board.dims = {
+		    params->checkers.cols - 1,
+		    params->checkers.rows - 1,
+		};
+		c.board.spacing_meters = params->checkers.size_meters;
+		c.subpixel_enable = params->checkers.subpixel_enable;
+		c.subpixel_size = params->checkers.subpixel_size;
+		break;
+	case T_BOARD_SB_CHECKERS:
+		c.board.dims = {
+		    params->sb_checkers.cols,
+		    params->sb_checkers.rows,
+		};
+		c.board.spacing_meters = params->sb_checkers.size_meters;
+		c.board.marker = params->sb_checkers.marker;
+		c.board.normalize_image = params->sb_checkers.normalize_image;
+		break;
+	case T_BOARD_CIRCLES:
+		c.board.dims = {
+		    params->circles.cols,
+		    params->circles.rows,
+		};
+		c.board.spacing_meters = params->circles.distance_meters;
+		break;
+	case T_BOARD_ASYMMETRIC_CIRCLES:
+		c.board.dims = {
+		    params->asymmetric_circles.cols,
+		    params->asymmetric_circles.rows,
+		};
+		c.board.spacing_meters = params->asymmetric_circles.diagonal_distance_meters;
+		break;
+	default: assert(false);
+	}
+	c.coarse_detect = debug_get_bool_option_coarse_detect();
+
+	// Build the board model.
+	build_board_position(c);
+}
+
 static void
 push_model(Calibration &c)
 {
@@ -568,10 +786,8 @@ moved_state_check(struct ViewState &view)
 #define P(...) snprintf(c.text, sizeof(c.text), __VA_ARGS__)
 
 XRT_NO_INLINE static void
-process_stereo_samples(class Calibration &c, int cols, int rows)
+process_stereo_samples(class Calibration &c, int cols, int rows, CalibrationResult &res)
 {
-	c.state.calibrated = true;
-
 	cv::Size image_size(cols, rows);
 	cv::Size new_image_size(cols, rows);
 
@@ -620,17 +836,15 @@ process_stereo_samples(class Calibration &c, int cols, int rows)
 	}
 
 	// Tell the user what has happened.
-	P("CALIBRATION DONE RP ERROR %f", rp_error);
+	snprintf(res.text, sizeof(res.text), "CALIBRATION DONE RP ERROR %f", rp_error);
 
 	// Preview undistortion/rectification.
 	StereoRectificationMaps maps(wrapped.base);
-	c.state.view[0].map1 = maps.view[0].rectify.remap_x;
-	c.state.view[0].map2 = maps.view[0].rectify.remap_y;
-	c.state.view[0].maps_valid = true;
+	res.map1[0] = maps.view[0].rectify.remap_x;
+	res.map2[0] = maps.view[0].rectify.remap_y;
 
-	c.state.view[1].map1 = maps.view[1].rectify.remap_x;
-	c.state.view[1].map2 = maps.view[1].rectify.remap_y;
-	c.state.view[1].maps_valid = true;
+	res.map1[1] = maps.view[1].rectify.remap_x;
+	res.map2[1] = maps.view[1].rectify.remap_y;
 
 	std::cout << "#####\n";
 	std::cout << "calibration rp_error: " << rp_error << "\n";
@@ -655,13 +869,11 @@ process_stereo_samples(class Calibration &c, int cols, int rows)
 	// Validate that nothing has been re-allocated.
 	assert(wrapped.isDataStorageValid());
 
-	if (c.status != NULL) {
-		t_stereo_camera_calibration_reference(&c.status->stereo_data, wrapped.base);
-	}
+	t_stereo_camera_calibration_reference(&res.stereo_data, wrapped.base);
 }
 
 static void
-process_view_samples(class Calibration &c, struct ViewState &view, int cols, int rows)
+process_view_samples(class Calibration &c, struct ViewState &view, int cols, int rows, CalibrationResult &res)
 {
 
 	const cv::Size image_size = {cols, rows};
@@ -749,7 +961,7 @@ process_view_samples(class Calibration &c, struct ViewState &view, int cols, int
 		                                                   false);         // centerPrincipalPoint
 	}
 
-	P("CALIBRATION DONE RP ERROR %f", rp_error);
+	snprintf(res.text, sizeof(res.text), "CALIBRATION DONE RP ERROR %f", rp_error);
 
 	// clang-format off
 	std::cout << "image_size: " << image_size << "\n";
@@ -766,11 +978,8 @@ process_view_samples(class Calibration &c, struct ViewState &view, int cols, int
 		                                     new_intrinsics_mat, // P
 		                                     image_size,         // size
 		                                     CV_32FC1,           // m1type
-		                                     view.map1,          // map1
-		                                     view.map2);         // map2
-
-		// Set the maps as valid.
-		view.maps_valid = true;
+		                                     res.map1[0],        // map1
+		                                     res.map2[0]);       // map2
 	} else {
 		cv::initUndistortRectifyMap( //
 		    intrinsics_mat,          // K
@@ -779,14 +988,104 @@ process_view_samples(class Calibration &c, struct ViewState &view, int cols, int
 		    new_intrinsics_mat,      // P
 		    image_size,              // size
 		    CV_32FC1,                // m1type
-		    view.map1,               // map1
-		    view.map2);              // map2
+		    res.map1[0],             // map1
+		    res.map2[0]);            // map2
+	}
+}
+
+
+/*
+ *
+ * Background solving.
+ *
+ */
 
-		// Set the maps as valid.
-		view.maps_valid = true;
+static void *
+solve_thread(void *ptr)
+{
+	auto &c = *(class Calibration *)ptr;
+
+	// The sink thread doesn't touch the collected samples while solving.
+	if (c.solve.stereo) {
+		process_stereo_samples(c, c.solve.cols, c.solve.rows, c.solve.result);
+	} else {
+		process_view_samples(c, c.state.view[0], c.solve.cols, c.solve.rows, c.solve.result);
 	}
 
+	os_thread_helper_lock(&c.solve.oth);
+	c.solve.done = true;
+	os_thread_helper_unlock(&c.solve.oth);
+
+	return NULL;
+}
+
+static void
+start_solve(class Calibration &c, bool stereo, int cols, int rows)
+{
+	c.solve.started = true;
+	c.solve.stereo = stereo;
+	c.solve.cols = cols;
+	c.solve.rows = rows;
+	c.solve.start_ns = os_monotonic_get_ns();
+
+	P("SOLVING CALIBRATION");
+
+	int ret = os_thread_helper_start(&c.solve.oth, solve_thread, &c);
+	if (ret != 0) {
+		U_LOG_E("Failed to start solve thread, solving on the sink thread!");
+		solve_thread(&c);
+		return;
+	}
+
+	os_thread_helper_name(&c.solve.oth, "Calibration Solve");
+}
+
+/*!
+ * Applies the result if the solve has finished, returns true if it has.
+ */
+static bool
+check_solve(class Calibration &c)
+{
+	os_thread_helper_lock(&c.solve.oth);
+	bool done = c.solve.done;
+	os_thread_helper_unlock(&c.solve.oth);
+
+	if (!done) {
+		double seconds = time_ns_to_s(os_monotonic_get_ns() - c.solve.start_ns);
+		P("SOLVING CALIBRATION %.1fs", seconds);
+
+		if (c.status != NULL) {
+			c.status->solve_seconds = (float)seconds;
+		}
+		return false;
+	}
+
+	// Thread has finished, reap it.
+	os_thread_helper_stop_and_wait(&c.solve.oth);
+
+	CalibrationResult &res = c.solve.result;
+	for (int i = 0; i < 2; i++) {
+		if (res.map1[i].empty()) {
+			continue;
+		}
+
+		c.state.view[i].map1 = res.map1[i];
+		c.state.view[i].map2 = res.map2[i];
+		c.state.view[i].maps_valid = true;
+	}
+
+	memcpy(c.text, res.text, sizeof(c.text));
+
+	if (c.status != NULL) {
+		t_stereo_camera_calibration_reference(&c.status->stereo_data, res.stereo_data);
+		c.status->solving = false;
+		c.status->finished = true;
+	}
+	t_stereo_camera_calibration_reference(&res.stereo_data, NULL);
+
 	c.state.calibrated = true;
+
+	return true;
 }
 
 static void
@@ -798,6 +1097,7 @@ update_public_status(class Calibration &c, bool found)
 		c.status->cooldown = c.state.cooldown;
 		c.status->waits_remaining = c.state.waited_for;
 		c.status->found = found;
+		c.status->solving = c.solve.started && !c.state.calibrated;
 	}
 }
 
@@ -964,7 +1264,8 @@ make_calibration_frame_mono(class Calibration &c)
 	do_capture_logic_mono(c, c.state.view[0], found, gray, rgb);
 
 	if (c.state.board_models_f32.size() >= c.num_collect_total) {
-		process_view_samples(c, c.state.view[0], rgb.cols, rgb.rows);
+		start_solve(c, false, rgb.cols, rgb.rows);
+		update_public_status(c, found);
 	}
 
 	// Draw text and finally send the frame off.
@@ -990,14 +1291,22 @@ make_calibration_frame_sbs(class Calibration &c)
 	cv::Mat l_rgb(rows, cols, CV_8UC3, c.gui.frame->data, c.gui.frame->stride);
 	cv::Mat r_rgb(rows, cols, CV_8UC3, c.gui.frame->data + 3 * cols, c.gui.frame->stride);
 
-	bool found_left = do_view(c, c.state.view[0], l_gray, l_rgb);
-	bool found_right = do_view(c, c.state.view[1], r_gray, r_rgb);
+	bool found_left = false;
+	bool found_right = false;
+
+	// The views only touch their own state and half of the images.
+	TaskCollection tasks(c.group, {
+	                                  [&] { found_left = do_view(c, c.state.view[0], l_gray, l_rgb); },
+	                                  [&] { found_right = do_view(c, c.state.view[1], r_gray, r_rgb); },
+	                              });
+	tasks.waitAll();
 
 	do_capture_logic_stereo(c, gray, rgb, found_left, c.state.view[0], l_gray, l_rgb, found_right, c.state.view[1],
 	                        r_gray, r_rgb);
 
 	if (c.state.board_models_f32.size() >= c.num_collect_total) {
-		process_stereo_samples(c, cols, rows);
+		start_solve(c, true, cols, rows);
+		update_public_status(c, found_left && found_right);
 	}
 
 	// Draw text and finally send the frame off.
@@ -1153,7 +1462,7 @@ process_load_image(class Calibration &c, struct xrt_frame *xf)
 
 	for (uint32_t i = 0; i < c.load.num_images; i++) {
 		// Early out if the user requested less images.
-		if (c.state.calibrated) {
+		if (c.solve.started) {
 			break;
 		}
 
@@ -1194,6 +1503,408 @@ process_load_image(class Calibration &c, struct xrt_frame *xf)
 }
 
 
+/*
+ *
+ * Offline calibration.
+ *
+ */
+
+/*!
+ * One stereo image pair on disk and the boards found in it.
+ */
+struct OfflineImage
+{
+	//! File name, used as the key in the detection cache.
+	std::string name = {};
+
+	//! Left and right image, only the first for side by side images.
+	std::string path[2] = {};
+
+	//! Loaded from the detection cache, no need to detect again.
+	bool cached = false;
+
+	//! Image loaded and detected, false if loading failed.
+	bool loaded = false;
+
+	//! Board found in both views.
+	bool found = false;
+
+	//! Size of one view.
+	cv::Size size = {};
+
+	MeasurementF32 corners[2] = {};
+};
+
+/*!
+ * Data for a single detection task on the worker pool.
+ */
+struct OfflineTask
+{
+	class Calibration *c;
+	struct OfflineImage *image;
+};
+
+static bool
+is_image_file(const std::filesystem::path &path)
+{
+	std::string ext = path.extension().string();
+	std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+	return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".pgm" || ext == ".bmp";
+}
+
+static std::vector<std::filesystem::path>
+list_image_files(const std::filesystem::path &dir)
+{
+	std::vector<std::filesystem::path> files = {};
+
+	std::error_code ec;
+	for (const auto &entry : std::filesystem::directory_iterator(dir, ec)) {
+		if (entry.is_regular_file(ec) && is_image_file(entry.path())) {
+			files.push_back(entry.path());
+		}
+	}
+
+	// Timestamps and frame numbers sort in capture order.
+	std::sort(files.begin(), files.end());
+
+	return files;
+}
+
+/*!
+ * Either a EuRoC dataset from a stereo camera, or a directory of side by side
+ * stereo images like the ones saved by the live calibration.
+ */
+static bool
+find_offline_images(const char *path, std::vector<OfflineImage> &out_images)
+{
+	namespace fs = std::filesystem;
+
+	fs::path root = path;
+	fs::path cam0 = root / "mav0" / "cam0" / "data";
+	fs::path cam1 = root / "mav0" / "cam1" / "data";
+
+	std::error_code ec;
+	if (!fs::is_directory(root, ec)) {
+		U_LOG_E("'%s' is not a directory!", path);
+		return false;
+	}
+
+	if (!fs::is_directory(cam0, ec)) {
+		for (const fs::path &file : list_image_files(root)) {
+			OfflineImage image = {};
+			image.name = file.filename().string();
+			image.path[0] = file.string();
+			out_images.push_back(std::move(image));
+		}
+
+		return true;
+	}
+
+	if (!fs::is_directory(cam1, ec)) {
+		U_LOG_E("EuRoC dataset '%s' has no cam1, only stereo cameras are supported!", path);
+		return false;
+	}
+
+	for (const fs::path &file : list_image_files(cam0)) {
+		fs::path other = cam1 / file.filename();
+		if (!fs::exists(other, ec)) {
+			continue; // Only matching pairs can be used.
+		}
+
+		OfflineImage image = {};
+		image.name = file.filename().string();
+		image.path[0] = file.string();
+		image.path[1] = other.string();
+		out_images.push_back(std::move(image));
+	}
+
+	return true;
+}
+
+static bool
+load_offline_image(struct OfflineImage &image, cv::Mat (&gray)[2])
+{
+	if (image.path[1].empty()) {
+		cv::Mat sbs = cv::imread(image.path[0], cv::IMREAD_GRAYSCALE);
+		if (sbs.empty() || sbs.cols < 2) {
+			U_LOG_W("Could not load '%s'", image.path[0].c_str());
+			return false;
+		}
+
+		int cols = sbs.cols / 2;
+		gray[0] = sbs(cv::Rect(0, 0, cols, sbs.rows));
+		gray[1] = sbs(cv::Rect(cols, 0, cols, sbs.rows));
+		return true;
+	}
+
+	for (int i = 0; i < 2; i++) {
+		gray[i] = cv::imread(image.path[i], cv::IMREAD_GRAYSCALE);
+		if (gray[i].empty()) {
+			U_LOG_W("Could not load '%s'", image.path[i].c_str());
+			return false;
+		}
+	}
+
+	if (gray[0].size() != gray[1].size()) {
+		U_LOG_W("Views of '%s' have different sizes, skipping", image.name.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/*!
+ * Run on the worker pool, only touches the task's image.
+ */
+static void
+offline_detect_func(void *ptr)
+{
+	auto &task = *(struct OfflineTask *)ptr;
+	struct OfflineImage &image = *task.image;
+
+	cv::Mat gray[2] = {};
+	if (!load_offline_image(image, gray)) {
+		return;
+	}
+
+	image.size = gray[0].size();
+
+	bool found = true;
+	for (int i = 0; i < 2 && found; i++) {
+		ViewState view = {};
+		found = detect_view(*task.c, view, gray[i]);
+		image.corners[i] = std::move(view.current_f32);
+	}
+
+	image.found = found;
+	image.loaded = true;
+}
+
+static void
+offline_detect(class Calibration &c,
+               struct u_worker_thread_pool *pool,
+               std::vector<OfflineImage> &images,
+               uint32_t thread_count)
+{
+	std::vector<OfflineTask> tasks = {};
+	for (OfflineImage &image : images) {
+		if (!image.cached) {
+			tasks.push_back({&c, &image});
+		}
+	}
+
+	U_LOG_I("Detecting board in %zu images, %zu cached, using %u threads", tasks.size(),
+	        images.size() - tasks.size(), thread_count);
+
+	if (tasks.empty()) {
+		return;
+	}
+
+	struct u_worker_group *group = u_worker_group_create(pool);
+
+	for (OfflineTask &task : tasks) {
+		u_worker_group_push(group, offline_detect_func, &task);
+	}
+
+	u_worker_group_wait_all(group);
+
+	u_worker_group_reference(&group, NULL);
+}
+
+/*!
+ * Detections are only valid for the same board settings.
+ */
+static std::string
+offline_cache_board_key(class Calibration &c)
+{
+	char buf[256];
+	snprintf(buf, sizeof(buf), "pattern:%u dims:%ix%i subpixel:%u:%i coarse:%u marker:%u normalize:%u",
+	         (uint32_t)c.board.pattern, c.board.dims.width, c.board.dims.height, (uint32_t)c.subpixel_enable,
+	         c.subpixel_size, (uint32_t)c.coarse_detect, (uint32_t)c.board.marker,
+	         (uint32_t)c.board.normalize_image);
+
+	return buf;
+}
+
+/*!
+ * The cache lives outside of the dataset, so also key it on which dataset.
+ */
+static std::string
+offline_cache_dataset_key(const char *path)
+{
+	std::error_code ec;
+	std::filesystem::path abs = std::filesystem::absolute(path, ec);
+	if (ec) {
+		return path;
+	}
+
+	return abs.lexically_normal().string();
+}
+
+static bool
+load_offline_cache_corners(const JSONNode &node, size_t count, MeasurementF32 &out_corners)
+{
+	std::vector<JSONNode> values = node.asArray();
+	if (values.size() != count * 2) {
+		return false;
+	}
+
+	out_corners.clear();
+	out_corners.reserve(count);
+	for (size_t i = 0; i < count; i++) {
+		out_corners.emplace_back((float)values[i * 2].asDouble(), (float)values[i * 2 + 1].asDouble());
+	}
+
+	return true;
+}
+
+static void
+load_offline_cache(class Calibration &c,
+                   const char *cache_path,
+                   const std::string &dataset,
+                   std::vector<OfflineImage> &images)
+{
+	std::error_code ec;
+	if (!std::filesystem::exists(cache_path, ec)) {
+		return;
+	}
+
+	JSONNode json = JSONNode::loadFromFile(cache_path);
+	if (json.isInvalid() || !json.hasKey("board") || !json.hasKey("images")) {
+		U_LOG_W("Ignoring invalid detection cache '%s'", cache_path);
+		return;
+	}
+
+	if (!json.hasKey("dataset") || json["dataset"].asString() != dataset) {
+		U_LOG_I("Detection cache '%s' is for another dataset, ignoring it", cache_path);
+		return;
+	}
+
+	if (json["board"].asString() != offline_cache_board_key(c)) {
+		U_LOG_I("Board settings changed, ignoring detection cache '%s'", cache_path);
+		return;
+	}
+
+	std::map<std::string, JSONNode> cached = json["images"].asObject();
+	size_t count = c.board.model_f32.size();
+
+	for (OfflineImage &image : images) {
+		auto it = cached.find(image.name);
+		if (it == cached.end()) {
+			continue;
+		}
+
+		const JSONNode &entry = it->second;
+		image.found = entry["found"].asBool();
+		image.size = {entry["width"].asInt(), entry["height"].asInt()};
+
+		if (image.found) {
+			std::vector<JSONNode> views = entry["views"].asArray();
+			if (views.size() != 2 ||                                           //
+			    !load_offline_cache_corners(views[0], count, image.corners[0]) || //
+			    !load_offline_cache_corners(views[1], count, image.corners[1])) {
+				image.found = false;
+				continue; // Detect again.
+			}
+		}
+
+		image.cached = true;
+		image.loaded = true;
+	}
+}
+
+static void
+save_offline_cache(class Calibration &c,
+                   const char *cache_path,
+                   const std::string &dataset,
+                   const std::vector<OfflineImage> &images)
+{
+	JSONBuilder jb{};
+
+	jb << "{";
+	jb << "dataset" << dataset;
+	jb << "board" << offline_cache_board_key(c);
+	jb << "images";
+	jb << "{";
+
+	for (const OfflineImage &image : images) {
+		if (!image.loaded) {
+			continue; // Try again next time.
+		}
+
+		jb << image.name;
+		jb << "{";
+		jb << "found" << image.found;
+		jb << "width" << image.size.width;
+		jb << "height" << image.size.height;
+
+		if (image.found) {
+			jb << "views";
+			jb << "[";
+			for (const MeasurementF32 &corners : image.corners) {
+				jb << "[";
+				for (const cv::Point2f &p : corners) {
+					jb << (double)p.x << (double)p.y;
+				}
+				jb << "]";
+			}
+			jb << "]";
+		}
+
+		jb << "}";
+	}
+
+	jb << "}";
+	jb << "}";
+
+	if (!jb.getBuiltNode()->saveToFile(cache_path)) {
+		U_LOG_W("Failed to save detection cache '%s'", cache_path);
+	}
+}
+
+/*!
+ * Drops samples where the board hasn't moved, as a still camera produces many
+ * near identical samples, then evenly picks at most @p max_samples of them.
+ */
+static std::vector<const OfflineImage *>
+select_offline_samples(const std::vector<OfflineImage> &images, uint32_t max_samples)
+{
+	std::vector<const OfflineImage *> moved = {};
+
+	MeasurementF64 last = {};
+	for (const OfflineImage &image : images) {
+		if (!image.found) {
+			continue;
+		}
+
+		MeasurementF64 current = {};
+		current.reserve(image.corners[0].size());
+		for (const cv::Point2f &p : image.corners[0]) {
+			current.emplace_back(p.x, p.y);
+		}
+		if (!has_measurement_moved(last, current)) {
+			continue;
+		}
+
+		last = std::move(current);
+		moved.push_back(&image);
+	}
+
+	if (max_samples == 0 || moved.size() <= max_samples) {
+		return moved;
+	}
+
+	std::vector<const OfflineImage *> selected = {};
+	selected.reserve(max_samples);
+	for (uint32_t i = 0; i < max_samples; i++) {
+		selected.push_back(moved[(size_t)i * moved.size() / max_samples]);
+	}
+
+	return selected;
+}
+
+
 /*
  *
  * Interface functions.
@@ -1222,6 +1933,14 @@ t_calibration_frame(struct xrt_frame_sink *xsink, struct xrt_frame *xf)
 		return;
 	}
 
+	// Keep the preview going while solving in the background.
+	if (c.solve.started && !c.state.calibrated && !check_solve(c)) {
+		print_txt(c.gui.rgb, c.text, 1.5);
+
+		send_rgb_frame(c);
+		return;
+	}
+
 	// Don't do anything if we are done.
 	if (c.state.calibrated) {
 		make_remap_view(c, xf);
@@ -1241,6 +1960,27 @@ t_calibration_frame(struct xrt_frame_sink *xsink, struct xrt_frame *xf)
 	make_calibration_frame(c, xf);
 }
 
+extern "C" void
+t_calibration_break_apart(struct xrt_frame_node *node)
+{
+	auto &c = *container_of(node, Calibration, node);
+
+	// Can't interrupt OpenCV, so this waits for any solve to finish.
+	os_thread_helper_stop_and_wait(&c.solve.oth);
+}
+
+extern "C" void
+t_calibration_destroy(struct xrt_frame_node *node)
+{
+	auto *c = container_of(node, Calibration, node);
+
+	os_thread_helper_destroy(&c->solve.oth);
+	t_stereo_camera_calibration_reference(&c->solve.result.stereo_data, NULL);
+	xrt_frame_reference(&c->gui.frame, NULL);
+
+	delete c;
+}
+
 
 /*
  *
@@ -1273,47 +2013,20 @@ t_calibration_stereo_create(struct xrt_frame_context *xfctx,
 	// Basic setup.
 	c.gui.sink = gui;
 	c.base.push_frame = t_calibration_frame;
-	*out_sink = &c.base;
+	c.node.break_apart = t_calibration_break_apart;
+	c.node.destroy = t_calibration_destroy;
+
+	int ret = os_thread_helper_init(&c.solve.oth);
+	if (ret != 0) {
+		U_LOG_E("Failed to init solve thread helper!");
+		delete &c;
+		return ret;
+	}
+
+	xrt_frame_context_add(xfctx, &c.node);
 
 	// Copy the parameters.
-	c.use_fisheye = params->use_fisheye;
-	c.stereo_sbs = params->stereo_sbs;
-	c.board.pattern = params->pattern;
-	switch (params->pattern) {
-	case T_BOARD_CHECKERS:
-		c.board.dims = {
-		    params->checkers.cols - 1,
-		    params->checkers.rows - 1,
-		};
-		c.board.spacing_meters = params->checkers.size_meters;
-		c.subpixel_enable = params->checkers.subpixel_enable;
-		c.subpixel_size = params->checkers.subpixel_size;
-		break;
-	case T_BOARD_SB_CHECKERS:
-		c.board.dims = {
-		    params->sb_checkers.cols,
-		    params->sb_checkers.rows,
-		};
-		c.board.spacing_meters = params->sb_checkers.size_meters;
-		c.board.marker = params->sb_checkers.marker;
-		c.board.normalize_image = params->sb_checkers.normalize_image;
-		break;
-	case T_BOARD_CIRCLES:
-		c.board.dims = {
-		    params->circles.cols,
-		    params->circles.rows,
-		};
-		c.board.spacing_meters = params->circles.distance_meters;
-		break;
-	case T_BOARD_ASYMMETRIC_CIRCLES:
-		c.board.dims = {
-		    params->asymmetric_circles.cols,
-		    params->asymmetric_circles.rows,
-		};
-		c.board.spacing_meters = params->asymmetric_circles.diagonal_distance_meters;
-		break;
-	default: assert(false);
-	}
+	setup_from_params(c, params);
 	c.num_cooldown_frames = params->num_cooldown_frames;
 	c.num_wait_for = params->num_wait_for;
 	c.num_collect_total = params->num_collect_total;
@@ -1329,26 +2042,24 @@ t_calibration_stereo_create(struct xrt_frame_context *xfctx,
 	P("Waiting for camera");
 	make_gui_str(c);
 
-	int ret = 0;
+	struct xrt_frame_sink *sink = &c.base;
+
 	if (debug_get_bool_option_hsv_filter()) {
-		ret = t_debug_hsv_filter_create(xfctx, *out_sink, out_sink);
+		ret = t_debug_hsv_filter_create(xfctx, sink, &sink);
 	}
 
 	if (debug_get_bool_option_hsv_picker()) {
-		ret = t_debug_hsv_picker_create(xfctx, *out_sink, out_sink);
+		ret = t_debug_hsv_picker_create(xfctx, sink, &sink);
 	}
 
 	if (debug_get_bool_option_hsv_viewer()) {
-		ret = t_debug_hsv_viewer_create(xfctx, *out_sink, out_sink);
+		ret = t_debug_hsv_viewer_create(xfctx, sink, &sink);
 	}
 
 	// Ensure we only get rgb, yuv, yuyv, uyvy or l8 frames.
-	u_sink_create_to_rgb_yuv_yuyv_uyvy_or_l8(xfctx, *out_sink, out_sink);
+	u_sink_create_to_rgb_yuv_yuyv_uyvy_or_l8(xfctx, sink, &sink);
 
 
-	// Build the board model.
-	build_board_position(c);
-
 	// Pre allocate
 	c.state.view[0].current_f32.reserve(c.board.model_f32.size());
 	c.state.view[0].current_f64.reserve(c.board.model_f64.size());
@@ -1368,10 +2079,106 @@ t_calibration_stereo_create(struct xrt_frame_context *xfctx,
 	}
 #endif
 
+	// Only hand out the sink once everything has been setup.
+	*out_sink = sink;
 
 	return ret;
 }
 
+extern "C" int
+t_calibration_offline(const struct t_calibration_offline_params *params,
+                      const char *path,
+                      struct t_stereo_camera_calibration **out_data)
+{
+	const struct t_calibration_params *calib = &params->calib;
+
+#ifndef SB_CHEESBOARD_CORNERS_SUPPORTED
+	if (calib->pattern == T_BOARD_SB_CHECKERS) {
+		U_LOG_E("OpenCV %u.%u doesn't support SB chessboard!", CV_MAJOR_VERSION, CV_MINOR_VERSION);
+		return -1;
+	}
+#endif
+
+	std::vector<OfflineImage> images = {};
+	if (!find_offline_images(path, images)) {
+		return -1;
+	}
+
+	if (images.empty()) {
+		U_LOG_E("No images found in '%s'", path);
+		return -1;
+	}
+
+	uint32_t thread_count = params->thread_count;
+	if (thread_count == 0) {
+		thread_count = std::thread::hardware_concurrency();
+	}
+	thread_count = std::clamp(thread_count, 1u, 16u);
+
+	// The thread calling wait_all also does work.
+	struct u_worker_thread_pool *pool = u_worker_thread_pool_create(thread_count - 1, thread_count, "Calibration");
+
+	// Only used to hold the board and the collected samples, never started.
+	auto c = std::make_unique<Calibration>(pool);
+	setup_from_params(*c, calib);
+
+	std::string dataset = offline_cache_dataset_key(path);
+
+	if (params->cache_path != NULL) {
+		load_offline_cache(*c, params->cache_path, dataset, images);
+	}
+
+	uint64_t start_ns = os_monotonic_get_ns();
+	offline_detect(*c, pool, images, thread_count);
+	double detect_seconds = time_ns_to_s(os_monotonic_get_ns() - start_ns);
+
+	// The calibration holds a reference until it is destroyed.
+	u_worker_thread_pool_reference(&pool, NULL);
+
+	if (params->cache_path != NULL) {
+		save_offline_cache(*c, params->cache_path, dataset, images);
+	}
+
+	std::vector<const OfflineImage *> samples = select_offline_samples(images, params->max_samples);
+	U_LOG_I("Detection took %.1f seconds, using %zu samples", detect_seconds, samples.size());
+
+	if (samples.size() < 3) {
+		U_LOG_E("Too few images with the board visible in both views (%zu)!", samples.size());
+		return -1;
+	}
+
+	cv::Size size = samples[0]->size;
+	for (const OfflineImage *image : samples) {
+		if (image->size != size) {
+			U_LOG_E("Images have different sizes, '%s' is %ix%i not %ix%i!", image->name.c_str(),
+			        image->size.width, image->size.height, size.width, size.height);
+			return -1;
+		}
+
+		for (int i = 0; i < 2; i++) {
+			ViewState &view = c->state.view[i];
+			view.current_f32 = image->corners[i];
+			view.current_f64.clear();
+			for (const cv::Point2f &p : image->corners[i]) {
+				view.current_f64.emplace_back(p.x, p.y);
+			}
+			view.current_bounds = cv::boundingRect(view.current_f32);
+			push_measurement(view);
+		}
+
+		push_model(*c);
+	}
+
+	start_ns = os_monotonic_get_ns();
+	CalibrationResult res = {};
+	process_stereo_samples(*c, size.width, size.height, res);
+	U_LOG_I("%s, solve took %.1f seconds", res.text, time_ns_to_s(os_monotonic_get_ns() - start_ns));
+
+	*out_data = res.stereo_data; // Transfer the reference.
+
+	return 0;
+}
+
 //! Helper for NormalizedCoordsCache constructors
 static inline std::vector<cv::Vec2f>
 generateInputCoordsAndReserveOutputCoords(const cv::Size &size, std::vector<cv::Vec2f> &outputCoords)
@@ -27,6 +27,10 @@
 
 #include "os/os_threading.h"
 
+#ifdef XRT_OS_LINUX
+#include "util/u_linux.h"
+#endif
+
 #include <stdio.h>
 #include <assert.h>
 #include <pthread.h>
@@ -539,6 +543,11 @@ extern "C" void *
 t_psmv_run(void *ptr)
 {
 	auto &t = *(TrackerPSMV *)ptr;
+
+#ifdef XRT_OS_LINUX
+	u_linux_thread_class_apply(OS_THREAD_CLASS_TRACKING, U_LOGGING_WARN, "PSMV: Tracker");
+#endif
+
 	run(t);
 	return NULL;
 }
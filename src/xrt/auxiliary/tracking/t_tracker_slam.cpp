@@ -29,6 +29,10 @@
 #include "tracking/t_openvr_tracker.h"
 #include "tracking/t_tracking.h"
 
+#ifdef XRT_OS_LINUX
+#include "util/u_linux.h"
+#endif
+
 #include <slam_tracker.hpp>
 #include <opencv2/core/mat.hpp>
 #include <opencv2/core/version.hpp>
@@ -354,6 +358,8 @@ struct TrackerSlam
 	struct xrt_frame_sink cam_sinks[XRT_TRACKING_MAX_SLAM_CAMS]; //!< Sends camera frames to the SLAM system
 	struct xrt_imu_sink imu_sink = {};                           //!< Sends imu samples to the SLAM system
 	struct xrt_pose_sink gt_sink = {};                           //!< Register groundtruth trajectory for stats
+	decltype(t_slam_tracker_config::pose_cb) pose_cb = nullptr;  //!< Optional per pose callback
+	void *pose_cb_userdata = nullptr;                            //!< Userdata for @ref pose_cb
 	bool submit;   //!< Whether to submit data pushed to sinks to the SLAM tracker
 	int cam_count; //!< Number of cameras used for tracking
 
@@ -837,6 +843,10 @@ flush_poses(TrackerSlam &t)
 		auto tss = timing_ui_push(t, np);
 		t.slam_times_writer->push(tss);
 
+		if (t.pose_cb != nullptr) {
+			t.pose_cb(t.pose_cb_userdata, nts, &rel.pose, tss.data(), tss.size());
+		}
+
 		if (t.features.ext_enabled) {
 			vector feat_count = features_ui_push(t, np);
 			t.slam_features_writer->push(nts, feat_count);
@@ -1444,6 +1454,11 @@ t_slam_run(void *ptr)
 {
 	auto &t = *(TrackerSlam *)ptr;
 	SLAM_DEBUG("SLAM tracker starting");
+
+#ifdef XRT_OS_LINUX
+	u_linux_thread_class_apply(OS_THREAD_CLASS_TRACKING, t.log_level, "SLAM: Tracker");
+#endif
+
 	t.slam->start();
 	return NULL;
 }
@@ -1474,6 +1489,8 @@ t_slam_fill_default_config(struct t_slam_tracker_config *config)
 	config->features_stat = debug_get_bool_option_slam_features_stat();
 	config->cam_count = int(debug_get_num_option_slam_cam_count());
 	config->slam_calib = NULL;
+	config->pose_cb = NULL;
+	config->pose_cb_userdata = NULL;
 }
 
 extern "C" int
@@ -1548,6 +1565,8 @@ t_slam_create(struct xrt_frame_context *xfctx,
 
 	t.submit = config->submit_from_start;
 	t.cam_count = config->cam_count;
+	t.pose_cb = config->pose_cb;
+	t.pose_cb_userdata = config->pose_cb_userdata;
 
 	t.node.break_apart = t_slam_node_break_apart;
 	t.node.destroy = t_slam_node_destroy;
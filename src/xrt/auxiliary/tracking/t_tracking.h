@@ -660,6 +660,18 @@ struct t_slam_tracker_config
 
 	//!< Instead of a slam_config file you can set custom calibration data
 	const struct t_slam_calibration *slam_calib;
+
+	/*!
+	 * Optional, called for every pose dequeued from the SLAM system. The
+	 * @p timing array has the same columns as the timing CSV: the sample
+	 * timestamp, any timestamps the SLAM system adds and when Monado got it.
+	 */
+	void (*pose_cb)(void *userdata,
+	                timepoint_ns ts,
+	                const struct xrt_pose *pose,
+	                const timepoint_ns *timing,
+	                size_t timing_count);
+	void *pose_cb_userdata; //!< Passed to @ref pose_cb
 };
 
 /*!
@@ -715,6 +727,10 @@ struct t_calibration_status
 	int cooldown;
 	//! Number of non-moving frames before capture.
 	int waits_remaining;
+	//! Is the calibration being solved in the background?
+	bool solving;
+	//! How long the solve has been running for.
+	float solve_seconds;
 	//! Stereo calibration data that was produced.
 	struct t_stereo_camera_calibration *stereo_data;
 };
@@ -819,6 +835,48 @@ t_calibration_stereo_create(struct xrt_frame_context *xfctx,
                             struct xrt_frame_sink *gui,
                             struct xrt_frame_sink **out_sink);
 
+/*!
+ * Parameters for calibrating from images on disk.
+ *
+ * @see t_calibration_offline
+ */
+struct t_calibration_offline_params
+{
+	//! Board and camera parameters, the capture settings are not used.
+	struct t_calibration_params calib;
+
+	//! Number of threads used for detecting the board, zero for all cores.
+	uint32_t thread_count;
+
+	//! Maximum number of samples used for the solve, zero for no limit.
+	uint32_t max_samples;
+
+	/*!
+	 * File to cache board detections in between runs, NULL for no cache.
+	 * Keyed on the dataset path, so one file can be reused between datasets.
+	 */
+	const char *cache_path;
+};
+
+/*!
+ * @brief Calibrate a stereo camera from images on disk.
+ *
+ * The @p path is either a EuRoC dataset with a cam0 and cam1, or a directory
+ * of side by side stereo images. Board detection is done in parallel and the
+ * results are optionally cached, so re-running with different solve settings
+ * only costs the solve.
+ *
+ * @param params Parameters to use, pointer not retained.
+ * @param path Path to the dataset or image directory.
+ * @param out_data Output: the stereo calibration.
+ *
+ * @return Zero on success.
+ */
+int
+t_calibration_offline(const struct t_calibration_offline_params *params,
+                      const char *path,
+                      struct t_stereo_camera_calibration **out_data);
+
 
 /*
  *
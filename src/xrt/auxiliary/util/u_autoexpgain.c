@@ -19,6 +19,7 @@
 #include <math.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 DEBUG_GET_ONCE_LOG_OPTION(aeg_log, "AEG_LOG", U_LOGGING_WARN)
 
@@ -42,7 +43,8 @@ DEBUG_GET_ONCE_LOG_OPTION(aeg_log, "AEG_LOG", U_LOGGING_WARN)
 #define INITIAL_BRIGHTNESS 0.5
 #define INITIAL_MAX_BRIGHTNESS_STEP 0.1
 #define INITIAL_THRESHOLD 0.1
-#define GRID_COLS 32 //!< Amount of columns for the histogram sample grid
+#define GRID_COLS 32 //!< Default amount of columns for the histogram sample grid
+#define HISTOGRAM_BANKS 4 //!< Histogram copies, so consecutive samples don't wait on the same counter
 
 //! AEG State machine states
 enum u_aeg_state
@@ -62,6 +64,29 @@ enum u_aeg_action
 	BRIGHT,
 };
 
+//! A row of sample points, offsets in bytes from the start of the fed data.
+struct u_aeg_sample_row
+{
+	size_t offset;
+	size_t step;
+	uint32_t count;
+};
+
+//! Where in the fed data the image is, and how it is sampled.
+struct u_aeg_layout
+{
+	size_t origin;
+	uint32_t width;
+	uint32_t height;
+	size_t stride;
+	size_t pixel_size;
+
+	enum u_aeg_sampling sampling;
+	int grid_cols;
+	struct xrt_rect roi;
+	bool roi_ellipse;
+};
+
 //! Auto exposure and gain (AEG) adjustment algorithm state.
 struct u_autoexpgain
 {
@@ -88,6 +113,26 @@ struct u_autoexpgain
 	float histogram[LEVELS];                 //!< Pixel intensity histogram
 	struct u_var_histogram_f32 histogram_ui; //!< UI for `histogram`
 
+	//! How the image is sampled. @see u_autoexpgain_set_sampling.
+	enum u_aeg_sampling sampling;
+	struct u_var_combo sampling_combo; //!< UI combo box for selecting `sampling`
+	int grid_cols;                     //!< Amount of columns for the sample grid
+
+	//! Region of the image to sample, zero extent means all of it. @see u_autoexpgain_set_roi.
+	struct xrt_rect roi;
+	bool roi_ellipse;
+
+	//! Sample rows for `layout`, rebuilt when the layout or sampling changes.
+	struct u_aeg_layout layout;
+	struct u_aeg_sample_row *rows;
+	uint32_t row_count;
+	uint32_t row_capacity;
+	uint32_t row_cursor; //!< Next row to be fed by `u_autoexpgain_add_data`
+
+	//! Histogram being built for the current image.
+	uint32_t banks[HISTOGRAM_BANKS][LEVELS];
+	uint32_t sample_count;
+
 	//! This is a made up scalar that lives in the [0, 1] range. 0 maps to minimum
 	//! exp/gain values while 1 to their maximums. An autoexposure strategy limits
 	//! itself to modify this value. The mapping between the scalar and the
@@ -318,33 +363,135 @@ update_expgain(struct u_autoexpgain *aeg)
 	brightness_to_expgain(aeg, brightness, &aeg->exposure, &aeg->gain);
 }
 
-//! Returns a value in the range [-1, 1] describing how dark-bright the image
-//! is, 0 means it's alright.
-static float
-get_score(struct u_autoexpgain *aeg, struct xrt_frame *xf)
+/*
+ *
+ * Histogram functions
+ *
+ */
+
+static bool
+layout_equal(const struct u_aeg_layout *a, const struct u_aeg_layout *b)
 {
-	uint32_t w = xf->width;
-	uint32_t h = xf->height;
-	uint32_t s = w / GRID_COLS; // Grid cell size
+	return a->origin == b->origin && a->width == b->width && a->height == b->height && a->stride == b->stride &&
+	       a->pixel_size == b->pixel_size && a->sampling == b->sampling && a->grid_cols == b->grid_cols &&
+	       a->roi.offset.w == b->roi.offset.w && a->roi.offset.h == b->roi.offset.h &&
+	       a->roi.extent.w == b->roi.extent.w && a->roi.extent.h == b->roi.extent.h &&
+	       a->roi_ellipse == b->roi_ellipse;
+}
 
-	// Compute histogram (PDF)
-	int histogram[LEVELS] = {0};
-	int samples_count = 0;
-	size_t pixel_size = u_format_block_size(xf->format);
-	for (uint32_t y = 0; y < h; y += s) {
-		for (uint32_t x = 0; x < w; x += s) {
-			// Note that for multichannel images only the first channel is in use.
-			uint8_t intensity = xf->data[y * xf->stride + x * pixel_size];
-			histogram[intensity]++;
-			samples_count++;
+//! Builds the rows of sample points for `aeg->layout`, sorted by offset.
+static void
+build_sample_rows(struct u_autoexpgain *aeg)
+{
+	const struct u_aeg_layout *l = &aeg->layout;
+
+	aeg->row_count = 0;
+
+	// Region to sample, clamped to the image.
+	int32_t x0 = 0;
+	int32_t y0 = 0;
+	int32_t x1 = (int32_t)l->width;
+	int32_t y1 = (int32_t)l->height;
+	if (l->roi.extent.w > 0 && l->roi.extent.h > 0) {
+		x0 = CLAMP(l->roi.offset.w, 0, x1);
+		y0 = CLAMP(l->roi.offset.h, 0, y1);
+		x1 = CLAMP(l->roi.offset.w + l->roi.extent.w, x0, x1);
+		y1 = CLAMP(l->roi.offset.h + l->roi.extent.h, y0, y1);
+	}
+	if (x1 <= x0 || y1 <= y0) {
+		return;
+	}
+
+	// Grid cell size
+	int32_t cols = CLAMP(l->grid_cols, 1, (int32_t)l->width);
+	int32_t s = MAX((int32_t)l->width / cols, 1);
+
+	uint32_t capacity = (uint32_t)((y1 - y0 - 1) / s + 1);
+	if (capacity > aeg->row_capacity) {
+		U_ARRAY_REALLOC_OR_FREE(aeg->rows, struct u_aeg_sample_row, capacity);
+		aeg->row_capacity = capacity;
+	}
+
+	const double cx = (x0 + x1) / 2.0;
+	const double cy = (y0 + y1) / 2.0;
+	const double rx = (x1 - x0) / 2.0;
+	const double ry = (y1 - y0) / 2.0;
+
+	for (int32_t y = y0, k = 0; y < y1; y += s, k++) {
+		int32_t first = x0;
+		int32_t end = x1;
+
+		if (l->roi_ellipse) {
+			double dy = (y + 0.5 - cy) / ry;
+			if (dy <= -1.0 || dy >= 1.0) {
+				continue;
+			}
+			double half = rx * sqrt(1.0 - dy * dy);
+			first = MAX(x0, (int32_t)ceil(cx - half - 0.5));
+			end = MIN(x1, (int32_t)floor(cx + half - 0.5) + 1);
+		}
+
+		int32_t step = s;
+		int32_t phase = x0;
+		if (l->sampling == U_AEG_SAMPLING_STAGGERED && (k & 1) != 0) {
+			phase += s / 2;
+		} else if (l->sampling == U_AEG_SAMPLING_ROWS) {
+			step = 1;
 		}
+
+		// First point on the lattice of this row at or after `first`.
+		int32_t aligned = first + ((phase - first) % step + step) % step;
+		if (aligned >= end) {
+			continue;
+		}
+
+		struct u_aeg_sample_row *row = &aeg->rows[aeg->row_count++];
+		row->offset = l->origin + (size_t)y * l->stride + (size_t)aligned * l->pixel_size;
+		row->step = (size_t)step * l->pixel_size;
+		row->count = (uint32_t)((end - 1 - aligned) / step + 1);
 	}
+}
 
-	// Draw histogram
-	for (int i = 0; i < LEVELS; i++) {
-		aeg->histogram[i] = histogram[i];
+//! Adds @p count samples @p step bytes apart to the histogram banks.
+static inline void
+histogram_add(uint32_t banks[HISTOGRAM_BANKS][LEVELS], const uint8_t *data, size_t count, size_t step)
+{
+	size_t i = 0;
+
+	if (step == 1) {
+		// Contiguous samples, load eight at a time.
+		for (; i + 8 <= count; i += 8) {
+			uint64_t v;
+			memcpy(&v, data + i, sizeof(v));
+			banks[0][v & 0xff]++;
+			banks[1][(v >> 8) & 0xff]++;
+			banks[2][(v >> 16) & 0xff]++;
+			banks[3][(v >> 24) & 0xff]++;
+			banks[0][(v >> 32) & 0xff]++;
+			banks[1][(v >> 40) & 0xff]++;
+			banks[2][(v >> 48) & 0xff]++;
+			banks[3][(v >> 56) & 0xff]++;
+		}
+	} else {
+		for (; i + 4 <= count; i += 4) {
+			const uint8_t *p = data + i * step;
+			banks[0][p[0]]++;
+			banks[1][p[step]]++;
+			banks[2][p[step * 2]]++;
+			banks[3][p[step * 3]]++;
+		}
+	}
+
+	for (; i < count; i++) {
+		banks[0][data[i * step]]++;
 	}
+}
 
+//! Returns a value in the range [-1, 1] describing how dark-bright the image
+//! is, 0 means it's alright.
+static float
+get_score(struct u_autoexpgain *aeg, const uint32_t histogram[LEVELS], uint32_t samples_count)
+{
 	// Compute mean
 	float mean = 0;
 	for (int i = 0; i < LEVELS; i++) {
@@ -375,9 +522,8 @@ get_score(struct u_autoexpgain *aeg, struct xrt_frame *xf)
 }
 
 static void
-update_brightness(struct u_autoexpgain *aeg, struct xrt_frame *xf)
+update_brightness(struct u_autoexpgain *aeg, float score)
 {
-	float score = get_score(aeg, xf);
 	aeg->current_score = score;
 
 	if (!aeg->enable) {
@@ -438,6 +584,12 @@ u_autoexpgain_create(enum u_aeg_strategy strategy, bool enabled_from_start, int
 	aeg->histogram_ui.values = aeg->histogram;
 	aeg->histogram_ui.count = LEVELS;
 
+	aeg->sampling = U_AEG_SAMPLING_GRID;
+	aeg->sampling_combo.count = U_AEG_SAMPLING_COUNT;
+	aeg->sampling_combo.options = "Grid\0Staggered grid\0Grid rows\0\0";
+	aeg->sampling_combo.value = (int *)&aeg->sampling;
+	aeg->grid_cols = GRID_COLS;
+
 	aeg->brightness.max = 1;
 	aeg->brightness.min = 0;
 	aeg->brightness.step = 0.002;
@@ -485,6 +637,18 @@ u_autoexpgain_add_vars(struct u_autoexpgain *aeg, void *root, char *prefix)
 	(void)snprintf(tmp, sizeof(tmp), "%sIntensity histogram", prefix);
 	u_var_add_histogram_f32(root, &aeg->histogram_ui, tmp);
 
+	(void)snprintf(tmp, sizeof(tmp), "%sSampling", prefix);
+	u_var_add_combo(root, &aeg->sampling_combo, tmp);
+
+	(void)snprintf(tmp, sizeof(tmp), "%sGrid columns", prefix);
+	u_var_add_i32(root, &aeg->grid_cols, tmp);
+
+	(void)snprintf(tmp, sizeof(tmp), "%sOnly sample ellipse in region", prefix);
+	u_var_add_bool(root, &aeg->roi_ellipse, tmp);
+
+	(void)snprintf(tmp, sizeof(tmp), "%sSample points", prefix);
+	u_var_add_ro_u32(root, &aeg->sample_count, tmp);
+
 	(void)snprintf(tmp, sizeof(tmp), "%sAEG log level", prefix);
 	u_var_add_log_level(root, &aeg->log_level, tmp);
 
@@ -494,7 +658,121 @@ u_autoexpgain_add_vars(struct u_autoexpgain *aeg, void *root, char *prefix)
 void
 u_autoexpgain_update(struct u_autoexpgain *aeg, struct xrt_frame *xf)
 {
-	update_brightness(aeg, xf);
+	size_t pixel_size = u_format_block_size(xf->format);
+	size_t size = (size_t)(xf->height - 1) * xf->stride + xf->width * pixel_size;
+
+	u_autoexpgain_begin(aeg, 0, xf->width, xf->height, xf->stride, xf->format);
+	u_autoexpgain_add_data(aeg, 0, xf->data, size);
+	u_autoexpgain_end(aeg);
+}
+
+void
+u_autoexpgain_set_sampling(struct u_autoexpgain *aeg, enum u_aeg_sampling sampling, uint32_t grid_cols)
+{
+	AEG_ASSERT(sampling < U_AEG_SAMPLING_COUNT, "Unexpected sampling=%d", sampling);
+	aeg->sampling = sampling;
+	aeg->grid_cols = (int)MAX(grid_cols, 1u);
+}
+
+void
+u_autoexpgain_set_roi(struct u_autoexpgain *aeg, const struct xrt_rect *rect, bool ellipse)
+{
+	if (rect != NULL) {
+		aeg->roi = *rect;
+	} else {
+		U_ZERO(&aeg->roi);
+	}
+	aeg->roi_ellipse = ellipse;
+}
+
+void
+u_autoexpgain_begin(struct u_autoexpgain *aeg,
+                    size_t origin,
+                    uint32_t width,
+                    uint32_t height,
+                    size_t stride,
+                    enum xrt_format format)
+{
+	struct u_aeg_layout layout = {
+	    .origin = origin,
+	    .width = width,
+	    .height = height,
+	    .stride = stride,
+	    // Note that for multichannel images only the first channel is in use.
+	    .pixel_size = u_format_block_size(format),
+	    .sampling = aeg->sampling,
+	    .grid_cols = aeg->grid_cols,
+	    .roi = aeg->roi,
+	    .roi_ellipse = aeg->roi_ellipse,
+	};
+
+	if (aeg->rows == NULL || !layout_equal(&layout, &aeg->layout)) {
+		aeg->layout = layout;
+		build_sample_rows(aeg);
+	}
+
+	aeg->row_cursor = 0;
+	aeg->sample_count = 0;
+	U_ZERO_ARRAY(aeg->banks);
+}
+
+void
+u_autoexpgain_add_data(struct u_autoexpgain *aeg, size_t offset, const uint8_t *data, size_t size)
+{
+	const size_t end = offset + size;
+
+	while (aeg->row_cursor < aeg->row_count) {
+		const struct u_aeg_sample_row *row = &aeg->rows[aeg->row_cursor];
+		const size_t last = row->offset + (size_t)(row->count - 1) * row->step;
+
+		// Row starts after this data.
+		if (row->offset >= end) {
+			break;
+		}
+
+		// Samples from the start of this row that were in earlier data.
+		size_t first = 0;
+		if (row->offset < offset) {
+			first = (offset - row->offset + row->step - 1) / row->step;
+		}
+		size_t stop = last < end ? row->count : (end - 1 - row->offset) / row->step + 1;
+
+		if (stop > first) {
+			const uint8_t *ptr = data + (row->offset + first * row->step - offset);
+			histogram_add(aeg->banks, ptr, stop - first, row->step);
+			aeg->sample_count += (uint32_t)(stop - first);
+		}
+
+		// Rest of the row is in the next piece of data.
+		if (last >= end) {
+			break;
+		}
+
+		aeg->row_cursor++;
+	}
+}
+
+void
+u_autoexpgain_end(struct u_autoexpgain *aeg)
+{
+	uint32_t histogram[LEVELS];
+	for (int i = 0; i < LEVELS; i++) {
+		histogram[i] = aeg->banks[0][i] + aeg->banks[1][i] + aeg->banks[2][i] + aeg->banks[3][i];
+	}
+
+	// Draw histogram
+	for (int i = 0; i < LEVELS; i++) {
+		aeg->histogram[i] = histogram[i];
+	}
+
+	if (aeg->sample_count == 0) {
+		AEG_DEBUG("No samples in image, not updating");
+		return;
+	}
+
+	float score = get_score(aeg, histogram, aeg->sample_count);
+
+	update_brightness(aeg, score);
 	update_expgain(aeg);
 }
 
@@ -513,6 +791,7 @@ u_autoexpgain_get_gain(struct u_autoexpgain *aeg)
 void
 u_autoexpgain_destroy(struct u_autoexpgain **aeg)
 {
+	free((*aeg)->rows);
 	free(*aeg);
 	*aeg = NULL;
 }
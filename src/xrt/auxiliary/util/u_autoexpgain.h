@@ -10,6 +10,8 @@
 #pragma once
 
 #include "xrt/xrt_frame.h"
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -24,6 +26,15 @@ enum u_aeg_strategy
 	U_AEG_STRATEGY_COUNT
 };
 
+//! How the image is sampled when building the intensity histogram.
+enum u_aeg_sampling
+{
+	U_AEG_SAMPLING_GRID = 0,  //!< Square grid of sample points.
+	U_AEG_SAMPLING_STAGGERED, //!< Grid with every other row shifted half a cell, better coverage at the same cost.
+	U_AEG_SAMPLING_ROWS,      //!< Every pixel on the rows of the grid.
+	U_AEG_SAMPLING_COUNT
+};
+
 struct u_autoexpgain;
 
 /*!
@@ -45,6 +56,51 @@ u_autoexpgain_add_vars(struct u_autoexpgain *aeg, void *root, char *prefix);
 void
 u_autoexpgain_update(struct u_autoexpgain *aeg, struct xrt_frame *xf);
 
+/*!
+ * Select how the image is sampled, @p grid_cols is the number of grid cells
+ * across the width of the image, the default is a grid of 32 columns.
+ */
+void
+u_autoexpgain_set_sampling(struct u_autoexpgain *aeg, enum u_aeg_sampling sampling, uint32_t grid_cols);
+
+/*!
+ * Only sample the image within @p rect, given in pixels of the image. With
+ * @p ellipse only the ellipse inscribed in the rect is sampled, use it to skip
+ * the blacked out corners of fisheye cameras. A NULL @p rect samples all of the
+ * image.
+ */
+void
+u_autoexpgain_set_roi(struct u_autoexpgain *aeg, const struct xrt_rect *rect, bool ellipse);
+
+/*!
+ * Start building the histogram of an image that is fed with
+ * @ref u_autoexpgain_add_data, this lets the histogram be computed while the
+ * image is being copied or converted instead of reading it again afterwards.
+ *
+ * The image is @p width by @p height pixels of @p format, the first pixel is
+ * at byte @p origin of the data that will be fed and each row is @p stride
+ * bytes apart.
+ */
+void
+u_autoexpgain_begin(struct u_autoexpgain *aeg,
+                    size_t origin,
+                    uint32_t width,
+                    uint32_t height,
+                    size_t stride,
+                    enum xrt_format format);
+
+/*!
+ * Feed @p size bytes of image data that starts at byte @p offset, the data
+ * must be fed in order but can be split up any way. Only the bytes that are
+ * sampled are read.
+ */
+void
+u_autoexpgain_add_data(struct u_autoexpgain *aeg, size_t offset, const uint8_t *data, size_t size);
+
+//! Update the AEG with the histogram built since @ref u_autoexpgain_begin.
+void
+u_autoexpgain_end(struct u_autoexpgain *aeg);
+
 //! Get currently computed exposure value in usecs.
 float
 u_autoexpgain_get_exposure(struct u_autoexpgain *aeg);
@@ -17,6 +17,10 @@
 
 #include "u_config_json.h"
 
+#ifdef XRT_OS_LINUX
+#include "util/u_linux.h"
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -266,6 +270,14 @@ u_config_json_get_remote_port(struct u_config_json *json, int *out_port)
 	return true;
 }
 
+void
+u_config_json_load_thread_classes(struct u_config_json *json)
+{
+#ifdef XRT_OS_LINUX
+	u_linux_thread_classes_parse_json(cJSON_GetObjectItemCaseSensitive(json->root, "threads"));
+#endif
+}
+
 static cJSON *
 open_tracking_settings(struct u_config_json *json)
 {
@@ -102,6 +102,16 @@ u_config_json_get_tracking_overrides(struct u_config_json *json,
 bool
 u_config_json_get_remote_port(struct u_config_json *json, int *out_port);
 
+/*!
+ * Set the thread class scheduling policies from the "threads" node, does
+ * nothing on platforms other than Linux.
+ *
+ * @see u_linux_thread_classes_parse_json
+ * @ingroup aux_util
+ */
+void
+u_config_json_load_thread_classes(struct u_config_json *json);
+
 
 enum u_gui_state_scene
 {
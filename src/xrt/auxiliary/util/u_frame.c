@@ -11,6 +11,8 @@
 #include "util/u_frame.h"
 #include "util/u_format.h"
 
+#include "os/os_threading.h"
+
 #include <assert.h>
 
 
@@ -86,8 +88,9 @@ free_roi(struct xrt_frame *xf)
 	free(xf);
 }
 
-void
-u_frame_create_roi(struct xrt_frame *original, struct xrt_rect roi, struct xrt_frame **out_frame)
+//! Fills in @p xf as a view of @p roi in @p original, does not touch references.
+static void
+fill_roi(struct xrt_frame *original, struct xrt_rect roi, struct xrt_frame *xf)
 {
 	assert(roi.offset.w >= 0 && roi.offset.h >= 0 && roi.extent.w > 0 && roi.extent.h > 0);
 	uint32_t x = roi.offset.w;
@@ -120,12 +123,7 @@ u_frame_create_roi(struct xrt_frame *original, struct xrt_rect roi, struct xrt_f
 	size_t end_margin = original->stride - ((xb + wb) * bsz);
 	size_t size = hb * original->stride - start_margin - end_margin;
 
-	// Create and fill in ROI frame
-
-	struct xrt_frame *xf = U_TYPED_CALLOC(struct xrt_frame);
-
-	xf->destroy = free_roi;
-	xrt_frame_reference((struct xrt_frame **)&xf->owner, original);
+	// Fill in ROI frame
 
 	xf->width = w;
 	xf->height = h;
@@ -140,6 +138,213 @@ u_frame_create_roi(struct xrt_frame *original, struct xrt_rect roi, struct xrt_f
 	xf->source_timestamp = original->source_timestamp;
 	xf->source_sequence = original->source_sequence;
 	xf->source_id = original->source_id;
+}
+
+void
+u_frame_create_roi(struct xrt_frame *original, struct xrt_rect roi, struct xrt_frame **out_frame)
+{
+	// Create and fill in ROI frame
+
+	struct xrt_frame *xf = U_TYPED_CALLOC(struct xrt_frame);
+
+	xf->destroy = free_roi;
+	xrt_frame_reference((struct xrt_frame **)&xf->owner, original);
+
+	fill_roi(original, roi, xf);
+
+	xrt_frame_reference(out_frame, xf);
+}
+
+/*!
+ * All of the frames made by @ref u_frame_create_rois, they share one reference
+ * to the original frame that is released when the last of them is.
+ */
+struct u_frame_roi_set
+{
+	struct xrt_frame *original;
+
+	//! Number of frames in the set still alive.
+	struct xrt_reference alive;
+
+	struct xrt_frame frames[];
+};
+
+static void
+free_roi_set_frame(struct xrt_frame *xf)
+{
+	struct u_frame_roi_set *set = (struct u_frame_roi_set *)xf->owner;
+
+	if (!xrt_reference_dec(&set->alive)) {
+		return;
+	}
+
+	xrt_frame_reference(&set->original, NULL);
+	free(set);
+}
+
+void
+u_frame_create_rois(struct xrt_frame *original,
+                    const struct xrt_rect *rois,
+                    uint32_t count,
+                    struct xrt_frame **out_frames)
+{
+	assert(count > 0);
+
+	struct u_frame_roi_set *set = U_CALLOC_WITH_CAST(
+	    struct u_frame_roi_set, sizeof(struct u_frame_roi_set) + sizeof(struct xrt_frame) * count);
+
+	xrt_frame_reference(&set->original, original);
+	set->alive.count = (int32_t)count;
+
+	for (uint32_t i = 0; i < count; i++) {
+		struct xrt_frame *xf = &set->frames[i];
+
+		xf->destroy = free_roi_set_frame;
+		xf->owner = set;
+
+		fill_roi(original, rois[i], xf);
+
+		xrt_frame_reference(&out_frames[i], xf);
+	}
+}
+
+/*
+ *
+ * Pool functions.
+ *
+ */
+
+struct u_frame_pool_frame
+{
+	struct xrt_frame base;
+	struct u_frame_pool *pool;
+};
+
+struct u_frame_pool
+{
+	struct os_mutex mutex;
+
+	//! All frames, data for all of them is one allocation.
+	struct u_frame_pool_frame *frames;
+	uint8_t *data;
+	uint32_t count;
+
+	//! Stack of frames not in use.
+	struct u_frame_pool_frame **free_frames;
+	uint32_t free_count;
+
+	//! Set when the pool is destroyed with frames still in use.
+	bool destroyed;
+};
+
+static void
+pool_free(struct u_frame_pool *pool)
+{
+	os_mutex_destroy(&pool->mutex);
+	free(pool->free_frames);
+	free(pool->frames);
+	free(pool->data);
+	free(pool);
+}
+
+static void
+pool_frame_release(struct xrt_frame *xf)
+{
+	struct u_frame_pool_frame *pf = (struct u_frame_pool_frame *)xf;
+	struct u_frame_pool *pool = pf->pool;
+
+	assert(xf->reference.count == 0);
+
+	os_mutex_lock(&pool->mutex);
+	pool->free_frames[pool->free_count++] = pf;
+	bool last = pool->destroyed && pool->free_count == pool->count;
+	os_mutex_unlock(&pool->mutex);
+
+	if (last) {
+		pool_free(pool);
+	}
+}
+
+struct u_frame_pool *
+u_frame_pool_create(enum xrt_format f, uint32_t width, uint32_t height, uint32_t count)
+{
+	assert(width > 0);
+	assert(height > 0);
+	assert(count > 0);
+	assert(u_format_is_blocks(f));
+
+	struct u_frame_pool *pool = U_TYPED_CALLOC(struct u_frame_pool);
+	if (os_mutex_init(&pool->mutex) != 0) {
+		free(pool);
+		return NULL;
+	}
+
+	size_t stride = 0;
+	size_t size = 0;
+	u_format_size_for_dimensions(f, width, height, &stride, &size);
+
+	pool->count = count;
+	pool->frames = U_TYPED_ARRAY_CALLOC(struct u_frame_pool_frame, count);
+	pool->free_frames = U_TYPED_ARRAY_CALLOC(struct u_frame_pool_frame *, count);
+	pool->data = (uint8_t *)malloc(size * count);
+
+	for (uint32_t i = 0; i < count; i++) {
+		struct u_frame_pool_frame *pf = &pool->frames[i];
+		pf->pool = pool;
+		pf->base.format = f;
+		pf->base.width = width;
+		pf->base.height = height;
+		pf->base.stride = stride;
+		pf->base.size = size;
+		pf->base.data = pool->data + size * i;
+		pf->base.destroy = pool_frame_release;
+
+		pool->free_frames[pool->free_count++] = pf;
+	}
+
+	return pool;
+}
+
+bool
+u_frame_pool_get(struct u_frame_pool *pool, struct xrt_frame **out_frame)
+{
+	os_mutex_lock(&pool->mutex);
+	if (pool->free_count == 0) {
+		os_mutex_unlock(&pool->mutex);
+		return false;
+	}
+	struct u_frame_pool_frame *pf = pool->free_frames[--pool->free_count];
+	os_mutex_unlock(&pool->mutex);
+
+	struct xrt_frame *xf = &pf->base;
+
+	// Reset everything that the previous user might have changed.
+	xf->stereo_format = XRT_STEREO_FORMAT_NONE;
+	xf->timestamp = 0;
+	xf->source_timestamp = 0;
+	xf->source_sequence = 0;
+	xf->source_id = 0;
 
 	xrt_frame_reference(out_frame, xf);
+
+	return true;
+}
+
+void
+u_frame_pool_destroy(struct u_frame_pool **pool_ptr)
+{
+	struct u_frame_pool *pool = *pool_ptr;
+	if (pool == NULL) {
+		return;
+	}
+	*pool_ptr = NULL;
+
+	os_mutex_lock(&pool->mutex);
+	pool->destroyed = true;
+	bool all_free = pool->free_count == pool->count;
+	os_mutex_unlock(&pool->mutex);
+
+	if (all_free) {
+		pool_free(pool);
+	}
 }
@@ -23,6 +23,35 @@ extern "C" {
 void
 u_frame_create_one_off(enum xrt_format f, uint32_t width, uint32_t height, struct xrt_frame **out_frame);
 
+/*!
+ * A pool of frames with the same format and dimensions, the frames go back
+ * into the pool instead of being freed when their reference reaches zero. Used
+ * by drivers that produce frames at a high rate to avoid large allocations in
+ * hot paths.
+ */
+struct u_frame_pool;
+
+/*!
+ * Creates a pool of @p count frames, all allocated up front.
+ */
+struct u_frame_pool *
+u_frame_pool_create(enum xrt_format f, uint32_t width, uint32_t height, uint32_t count);
+
+/*!
+ * Gets a free frame from the pool, the frame fields other than the data,
+ * format and dimensions are reset. Returns false and does not touch
+ * @p out_frame if all frames are in use.
+ */
+bool
+u_frame_pool_get(struct u_frame_pool *pool, struct xrt_frame **out_frame);
+
+/*!
+ * Destroys the pool, frames still in use stay valid and the memory is freed
+ * when the last one is released.
+ */
+void
+u_frame_pool_destroy(struct u_frame_pool **pool_ptr);
+
 /*!
  * Clones a frame. The cloned frame is not freed when the original frame is freed; instead the cloned frame is freed
  * when its reference reaches zero.
@@ -37,6 +66,17 @@ u_frame_clone(struct xrt_frame *to_copy, struct xrt_frame **out_frame);
 void
 u_frame_create_roi(struct xrt_frame *original, struct xrt_rect roi, struct xrt_frame **out_frame);
 
+/*!
+ * Same as @ref u_frame_create_roi but for @p count regions at once, all of the
+ * frames are made in one allocation and share a single reference to
+ * @p original. Each frame in @p out_frames is released on its own as usual.
+ */
+void
+u_frame_create_rois(struct xrt_frame *original,
+                    const struct xrt_rect *rois,
+                    uint32_t count,
+                    struct xrt_frame **out_frames);
+
 #ifdef __cplusplus
 }
 #endif
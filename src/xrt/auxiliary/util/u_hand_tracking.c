@@ -14,6 +14,7 @@
 #include "math/m_mathinclude.h"
 #include "math/m_api.h"
 #include "math/m_space.h"
+#include "math/m_pose_batch.h"
 #include "math/m_vec3.h"
 #include "math/m_api.h"
 
@@ -68,34 +69,138 @@ u_hand_joint_is_thumb(enum xrt_hand_joint joint)
 	       joint == XRT_HAND_JOINT_THUMB_DISTAL || joint == XRT_HAND_JOINT_THUMB_TIP;
 }
 
+/*
+ * Thanks to Nick Klingensmith for this idea. The radius of each joint is the
+ * distance from the joint to the skin in meters. -OpenXR spec.
+ */
+#define FINGER_JOINT_0 (0.022f * .5f)
+#define FINGER_JOINT_1 (0.021f * .5f)
+#define FINGER_JOINT_2 (0.022f * .5f)
+#define FINGER_JOINT_3 (0.021f * .5f)
+#define FINGER_JOINT_4 (0.02f * .5f)
+#define FINGER(SIZE)                                                                                                   \
+	FINGER_JOINT_0 * (SIZE), FINGER_JOINT_1 * (SIZE), FINGER_JOINT_2 * (SIZE), FINGER_JOINT_3 * (SIZE),            \
+	    FINGER_JOINT_4 * (SIZE)
+
+static const float joint_widths[XRT_HAND_JOINT_COUNT] = {
+    .032f * .5f, // Palm, measured my palm thickness with calipers
+    .040f * .5f, // Wrist, measured my wrist thickness with calipers
+    0.016f,      // Thumb metacarpal
+    0.014f,      // Thumb proximal
+    0.012f,      // Thumb distal
+    0.012f,      // Thumb tip
+    FINGER(1.0f),  // Index
+    FINGER(1.0f),  // Middle
+    FINGER(0.83f), // Ring
+    FINGER(0.75f), // Little
+};
+
+#undef FINGER
+#undef FINGER_JOINT_0
+#undef FINGER_JOINT_1
+#undef FINGER_JOINT_2
+#undef FINGER_JOINT_3
+#undef FINGER_JOINT_4
+
 void
 u_hand_joints_apply_joint_width(struct xrt_hand_joint_set *set)
 {
-	// Thanks to Nick Klingensmith for this idea
 	struct xrt_hand_joint_value *gr = set->values.hand_joint_set_default;
 
-	static const float finger_joint_size[5] = {0.022f, 0.021f, 0.022f, 0.021f, 0.02f};
-	static const float hand_finger_size[5] = {1.0f, 1.0f, 0.83f, 0.75f};
+	for (int i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+		gr[i].radius = joint_widths[i];
+	}
+}
+
+void
+u_hand_joints_soa_from_set(const struct xrt_hand_joint_set *set, struct u_hand_joints_soa *out_soa)
+{
+	const struct xrt_hand_joint_value *v = set->values.hand_joint_set_default;
+
+	for (int i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+		const struct xrt_space_relation *r = &v[i].relation;
+
+		out_soa->flags[i] = r->relation_flags;
+		out_soa->orientation[0][i] = r->pose.orientation.x;
+		out_soa->orientation[1][i] = r->pose.orientation.y;
+		out_soa->orientation[2][i] = r->pose.orientation.z;
+		out_soa->orientation[3][i] = r->pose.orientation.w;
+		out_soa->position[0][i] = r->pose.position.x;
+		out_soa->position[1][i] = r->pose.position.y;
+		out_soa->position[2][i] = r->pose.position.z;
+		out_soa->linear_velocity[0][i] = r->linear_velocity.x;
+		out_soa->linear_velocity[1][i] = r->linear_velocity.y;
+		out_soa->linear_velocity[2][i] = r->linear_velocity.z;
+		out_soa->angular_velocity[0][i] = r->angular_velocity.x;
+		out_soa->angular_velocity[1][i] = r->angular_velocity.y;
+		out_soa->angular_velocity[2][i] = r->angular_velocity.z;
+		out_soa->radius[i] = v[i].radius;
+	}
+}
+
+void
+u_hand_joints_soa_to_set(const struct u_hand_joints_soa *soa, struct xrt_hand_joint_set *out_set)
+{
+	struct xrt_hand_joint_value *v = out_set->values.hand_joint_set_default;
+
+	for (int i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+		struct xrt_space_relation *r = &v[i].relation;
+
+		r->relation_flags = soa->flags[i];
+		r->pose.orientation.x = soa->orientation[0][i];
+		r->pose.orientation.y = soa->orientation[1][i];
+		r->pose.orientation.z = soa->orientation[2][i];
+		r->pose.orientation.w = soa->orientation[3][i];
+		r->pose.position.x = soa->position[0][i];
+		r->pose.position.y = soa->position[1][i];
+		r->pose.position.z = soa->position[2][i];
+		r->linear_velocity.x = soa->linear_velocity[0][i];
+		r->linear_velocity.y = soa->linear_velocity[1][i];
+		r->linear_velocity.z = soa->linear_velocity[2][i];
+		r->angular_velocity.x = soa->angular_velocity[0][i];
+		r->angular_velocity.y = soa->angular_velocity[1][i];
+		r->angular_velocity.z = soa->angular_velocity[2][i];
+		v[i].radius = soa->radius[i];
+	}
+}
+
+void
+u_hand_joints_soa_transform(struct u_hand_joints_soa *soa, const struct xrt_space_relation *base)
+{
+	struct m_relation_soa r = u_hand_joints_soa_relations(soa);
 
-	static const float thumb_size[4] = {0.016f, 0.014f, 0.012f, 0.012f};
-	float mul = 1.0f;
+	m_batch_relation_soa_apply_one(base, &r, &r, XRT_HAND_JOINT_COUNT);
+}
 
+void
+u_hand_joints_soa_estimate_velocities(struct u_hand_joints_soa *soa,
+                                      const struct u_hand_joints_soa *prev,
+                                      float dt)
+{
+	const enum xrt_space_relation_flags pose_bits =
+	    XRT_SPACE_RELATION_ORIENTATION_VALID_BIT | XRT_SPACE_RELATION_POSITION_VALID_BIT;
 
-	for (int i = XRT_HAND_JOINT_THUMB_METACARPAL; i <= XRT_HAND_JOINT_THUMB_TIP; i++) {
-		int j = i - XRT_HAND_JOINT_THUMB_METACARPAL;
-		gr[i].radius = thumb_size[j] * mul;
+	for (int i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+		for (int k = 0; k < 3; k++) {
+			soa->linear_velocity[k][i] = (soa->position[k][i] - prev->position[k][i]) / dt;
+		}
 	}
 
-	for (int finger = 0; finger < 4; finger++) {
-		for (int joint = 0; joint < 5; joint++) {
-			int set_idx = finger * 5 + joint + XRT_HAND_JOINT_INDEX_METACARPAL;
-			float val = finger_joint_size[joint] * hand_finger_size[finger] * .5 * mul;
-			gr[set_idx].radius = val;
+	// The const is cast away, prev is only read from.
+	struct m_relation_soa cur = u_hand_joints_soa_relations(soa);
+	struct m_relation_soa old = u_hand_joints_soa_relations((struct u_hand_joints_soa *)prev);
+	m_batch_quat_finite_difference(&old.pose.orientation, &cur.pose.orientation, dt, &cur.angular_velocity,
+	                               XRT_HAND_JOINT_COUNT);
+
+	for (int i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+		int flags = soa->flags[i];
+		flags &= ~(XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT | XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT);
+
+		if ((soa->flags[i] & prev->flags[i] & pose_bits) == pose_bits) {
+			flags |= XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT;
+			flags |= XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT;
 		}
+
+		soa->flags[i] = (enum xrt_space_relation_flags)flags;
 	}
-	// The radius of each joint is the distance from the joint to the skin in meters. -OpenXR spec.
-	set->values.hand_joint_set_default[XRT_HAND_JOINT_PALM].radius =
-	    .032f * .5f; // Measured my palm thickness with calipers
-	set->values.hand_joint_set_default[XRT_HAND_JOINT_WRIST].radius =
-	    .040f * .5f; // Measured my wrist thickness with calipers
 }
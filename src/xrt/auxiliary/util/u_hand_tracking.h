@@ -11,6 +11,7 @@
 
 #include "xrt/xrt_defines.h"
 #include "util/u_misc.h"
+#include "math/m_pose_batch.h"
 
 
 #ifdef __cplusplus
@@ -103,6 +104,82 @@ struct u_hand_tracking
 	uint64_t timestamp_ns;
 };
 
+/*!
+ * A hand joint set as a structure of arrays, used by code that works on all of
+ * the joints at the same time, see @ref m_pose_batch.h. Only the joints are
+ * stored, the hand pose and active state stays in the @ref xrt_hand_joint_set.
+ *
+ * @ingroup aux_util
+ */
+struct u_hand_joints_soa
+{
+	enum xrt_space_relation_flags flags[XRT_HAND_JOINT_COUNT];
+	float orientation[4][XRT_HAND_JOINT_COUNT];
+	float position[3][XRT_HAND_JOINT_COUNT];
+	float linear_velocity[3][XRT_HAND_JOINT_COUNT];
+	float angular_velocity[3][XRT_HAND_JOINT_COUNT];
+	float radius[XRT_HAND_JOINT_COUNT];
+};
+
+/*!
+ * Returns the joints of @p soa as a @ref m_relation_soa for use with the
+ * batched math functions.
+ *
+ * @ingroup aux_util
+ */
+static inline struct m_relation_soa
+u_hand_joints_soa_relations(struct u_hand_joints_soa *soa)
+{
+	struct m_relation_soa r = {
+	    soa->flags,
+	    {
+	        {soa->orientation[0], soa->orientation[1], soa->orientation[2], soa->orientation[3]},
+	        {soa->position[0], soa->position[1], soa->position[2]},
+	    },
+	    {soa->linear_velocity[0], soa->linear_velocity[1], soa->linear_velocity[2]},
+	    {soa->angular_velocity[0], soa->angular_velocity[1], soa->angular_velocity[2]},
+	};
+	return r;
+}
+
+/*!
+ * Copies the joints of @p set into @p out_soa.
+ *
+ * @ingroup aux_util
+ */
+void
+u_hand_joints_soa_from_set(const struct xrt_hand_joint_set *set, struct u_hand_joints_soa *out_soa);
+
+/*!
+ * Copies the joints of @p soa into @p out_set, the hand pose and active state
+ * of @p out_set are left untouched.
+ *
+ * @ingroup aux_util
+ */
+void
+u_hand_joints_soa_to_set(const struct u_hand_joints_soa *soa, struct xrt_hand_joint_set *out_set);
+
+/*!
+ * Moves all joints into the space that @p base is in, same as pushing each
+ * joint relation and then @p base to a relation chain and resolving it.
+ *
+ * @ingroup aux_util
+ */
+void
+u_hand_joints_soa_transform(struct u_hand_joints_soa *soa, const struct xrt_space_relation *base);
+
+/*!
+ * Sets the velocities of the joints from the difference between @p prev and
+ * @p soa, that are @p dt seconds apart. Only joints that have a valid pose in
+ * both sets gets a velocity.
+ *
+ * @ingroup aux_util
+ */
+void
+u_hand_joints_soa_estimate_velocities(struct u_hand_joints_soa *soa,
+                                      const struct u_hand_joints_soa *prev,
+                                      float dt);
+
 /*!
  * Applies joint width to set.
  * @ingroup aux_util
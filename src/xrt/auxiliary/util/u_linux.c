@@ -9,13 +9,19 @@
  */
 
 #include "util/u_linux.h"
+#include "util/u_json.h"
 #include "util/u_pretty_print.h"
 
 #include <pthread.h>
 #include <assert.h>
+#include <errno.h>
 #include <unistd.h>
 #include <sched.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 
 #define LOG_D(...) U_LOG_IFL_D(log_level, __VA_ARGS__)
 #define LOG_I(...) U_LOG_IFL_I(log_level, __VA_ARGS__)
@@ -24,6 +30,83 @@
 
 #define NAME_LENGTH 32
 
+//! How many live threads the class registry remembers for the report.
+#define MAX_REGISTERED_THREADS 128
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+
+//! Leave the scheduling policy alone.
+#define POLICY_UNCHANGED -1
+
+
+/*
+ *
+ * Structs.
+ *
+ */
+
+/*!
+ * Policy of one thread class.
+ */
+struct thread_class_policy
+{
+	//! One of the SCHED_* values or @ref POLICY_UNCHANGED.
+	int policy;
+
+	//! For SCHED_FIFO and SCHED_RR, negative means the max.
+	int priority;
+
+	//! For SCHED_OTHER and SCHED_BATCH.
+	int nice;
+
+	//! For SCHED_DEADLINE.
+	uint64_t runtime_ns, deadline_ns, period_ns;
+
+	bool has_cpus;
+	cpu_set_t cpus;
+};
+
+/*!
+ * A thread that has been put into a class.
+ */
+struct registered_thread
+{
+	char name[NAME_LENGTH];
+	enum os_thread_class cls;
+	pid_t tid;
+	int sched_ret;
+	int affinity_ret;
+};
+
+/*!
+ * Layout expected by the sched_setattr syscall, glibc does not have it.
+ */
+struct sched_attr_compat
+{
+	uint32_t size;
+	uint32_t sched_policy;
+	uint64_t sched_flags;
+	int32_t sched_nice;
+	uint32_t sched_priority;
+	uint64_t sched_runtime;
+	uint64_t sched_deadline;
+	uint64_t sched_period;
+};
+
+static pthread_mutex_t registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static struct thread_class_policy class_policies[OS_THREAD_CLASS_COUNT];
+static bool class_policies_initialized = false;
+
+static struct registered_thread registered_threads[MAX_REGISTERED_THREADS];
+static uint32_t registered_thread_count = 0;
+
+//! Its destructor removes threads from the registry when they exit.
+static pthread_key_t registry_key;
+static pthread_once_t registry_key_once = PTHREAD_ONCE_INIT;
+
 
 /*
  *
@@ -40,10 +123,273 @@ policy_to_string(int policy)
 	case SCHED_OTHER: return "SCHED_OTHER(normal)";
 	case SCHED_IDLE: return "SCHED_IDLE";
 	case SCHED_BATCH: return "SCHED_BATCH";
+	case SCHED_DEADLINE: return "SCHED_DEADLINE";
 	default: return "SCHED_<UNKNOWN>";
 	}
 }
 
+static bool
+string_to_policy(const char *str, int *out_policy)
+{
+	static const struct
+	{
+		const char *str;
+		int policy;
+	} table[] = {
+	    {"unchanged", POLICY_UNCHANGED}, {"other", SCHED_OTHER}, {"batch", SCHED_BATCH}, {"idle", SCHED_IDLE},
+	    {"fifo", SCHED_FIFO},            {"rr", SCHED_RR},       {"deadline", SCHED_DEADLINE},
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(table); i++) {
+		if (strcmp(str, table[i].str) == 0) {
+			*out_policy = table[i].policy;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//! Parses a CPU list in the same format as taskset, "0,2-4,7".
+static bool
+parse_cpu_list(const char *str, cpu_set_t *out_cpus)
+{
+	CPU_ZERO(out_cpus);
+
+	const char *p = str;
+	while (*p != '\0') {
+		char *end = NULL;
+		long first = strtol(p, &end, 10);
+		if (end == p || first < 0) {
+			return false;
+		}
+
+		long last = first;
+		p = end;
+		if (*p == '-') {
+			p++;
+			last = strtol(p, &end, 10);
+			if (end == p || last < first) {
+				return false;
+			}
+			p = end;
+		}
+
+		for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+			CPU_SET((int)cpu, out_cpus);
+		}
+
+		if (*p == ',') {
+			p++;
+		} else if (*p != '\0') {
+			return false;
+		}
+	}
+
+	return CPU_COUNT(out_cpus) > 0;
+}
+
+static void
+print_cpu_list(struct u_pp_delegate dg, const cpu_set_t *cpus)
+{
+	long cpu_count = sysconf(_SC_NPROCESSORS_CONF);
+	bool first = true;
+
+	for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+		if (!CPU_ISSET(cpu, cpus)) {
+			continue;
+		}
+
+		int last = cpu;
+		while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, cpus)) {
+			last++;
+		}
+
+		if (cpu == 0 && last + 1 >= cpu_count) {
+			u_pp(dg, "all");
+			return;
+		}
+
+		u_pp(dg, first ? "%i" : ",%i", cpu);
+		if (last != cpu) {
+			u_pp(dg, "-%i", last);
+		}
+
+		first = false;
+		cpu = last;
+	}
+}
+
+static void
+init_default_policies_locked(void)
+{
+	if (class_policies_initialized) {
+		return;
+	}
+
+	for (int i = 0; i < OS_THREAD_CLASS_COUNT; i++) {
+		class_policies[i].policy = POLICY_UNCHANGED;
+		class_policies[i].priority = -1;
+	}
+
+	// What these threads have always done.
+	class_policies[OS_THREAD_CLASS_COMPOSITOR].policy = SCHED_FIFO;
+	class_policies[OS_THREAD_CLASS_DRIVER_IO].policy = SCHED_FIFO;
+
+	class_policies_initialized = true;
+}
+
+static bool
+parse_class_policy(const cJSON *node, const char *class_name, struct thread_class_policy *out_policy)
+{
+	struct thread_class_policy p = *out_policy;
+	char str[64];
+
+	const cJSON *policy = u_json_get(node, "policy");
+	if (policy != NULL) {
+		if (!u_json_get_string_into_array(policy, str, sizeof(str)) || !string_to_policy(str, &p.policy)) {
+			U_LOG_E("Unknown policy for thread class '%s'", class_name);
+			return false;
+		}
+	}
+
+	u_json_get_int(u_json_get(node, "priority"), &p.priority);
+	u_json_get_int(u_json_get(node, "nice"), &p.nice);
+
+	int us = 0;
+	if (u_json_get_int(u_json_get(node, "runtime_us"), &us)) {
+		p.runtime_ns = (uint64_t)us * 1000;
+	}
+	if (u_json_get_int(u_json_get(node, "deadline_us"), &us)) {
+		p.deadline_ns = (uint64_t)us * 1000;
+	}
+	if (u_json_get_int(u_json_get(node, "period_us"), &us)) {
+		p.period_ns = (uint64_t)us * 1000;
+	}
+
+	if (p.policy == SCHED_DEADLINE && (p.runtime_ns == 0 || p.runtime_ns > p.deadline_ns)) {
+		U_LOG_E("Thread class '%s' needs 0 < runtime_us <= deadline_us", class_name);
+		return false;
+	}
+
+	const cJSON *cpus = u_json_get(node, "cpus");
+	if (cpus != NULL) {
+		if (!u_json_get_string_into_array(cpus, str, sizeof(str)) || !parse_cpu_list(str, &p.cpus)) {
+			U_LOG_E("Invalid cpus for thread class '%s'", class_name);
+			return false;
+		}
+		p.has_cpus = true;
+	}
+
+	// The kernel refuses to restrict the CPUs of deadline threads, use cpusets instead.
+	if (p.policy == SCHED_DEADLINE && p.has_cpus) {
+		U_LOG_E("Thread class '%s' can't have both the deadline policy and cpus", class_name);
+		return false;
+	}
+
+	*out_policy = p;
+
+	return true;
+}
+
+static int
+apply_policy(const struct thread_class_policy *p)
+{
+	struct sched_param params = {0};
+
+	switch (p->policy) {
+	case POLICY_UNCHANGED: return 0;
+	case SCHED_OTHER:
+	case SCHED_BATCH: {
+		int ret = pthread_setschedparam(pthread_self(), p->policy, &params);
+		if (ret != 0) {
+			return ret;
+		}
+		// On Linux the nice value is per thread.
+		return setpriority(PRIO_PROCESS, gettid(), p->nice) != 0 ? errno : 0;
+	}
+	case SCHED_IDLE: return pthread_setschedparam(pthread_self(), p->policy, &params);
+	case SCHED_FIFO:
+	case SCHED_RR:
+		params.sched_priority = p->priority >= 0 ? p->priority : sched_get_priority_max(p->policy);
+		return pthread_setschedparam(pthread_self(), p->policy, &params);
+	case SCHED_DEADLINE: {
+#ifdef SYS_sched_setattr
+		struct sched_attr_compat attr = {
+		    .size = sizeof(attr),
+		    .sched_policy = SCHED_DEADLINE,
+		    .sched_runtime = p->runtime_ns,
+		    .sched_deadline = p->deadline_ns,
+		    .sched_period = p->period_ns,
+		};
+		return syscall(SYS_sched_setattr, 0, &attr, 0) != 0 ? errno : 0;
+#else
+		return ENOSYS;
+#endif
+	}
+	default: return EINVAL;
+	}
+}
+
+static void
+unregister_thread(void *value)
+{
+	(void)value;
+
+	pid_t tid = gettid();
+
+	pthread_mutex_lock(&registry_mutex);
+
+	for (uint32_t i = 0; i < registered_thread_count; i++) {
+		if (registered_threads[i].tid != tid) {
+			continue;
+		}
+
+		// Order doesn't matter, move the last one here.
+		registered_threads[i] = registered_threads[--registered_thread_count];
+		break;
+	}
+
+	pthread_mutex_unlock(&registry_mutex);
+}
+
+static void
+create_registry_key(void)
+{
+	pthread_key_create(&registry_key, unregister_thread);
+}
+
+static void
+register_thread_locked(const char *name, enum os_thread_class cls, int sched_ret, int affinity_ret)
+{
+	pid_t tid = gettid();
+	struct registered_thread *rt = NULL;
+
+	// A thread that changes class replaces its old entry.
+	for (uint32_t i = 0; i < registered_thread_count; i++) {
+		if (registered_threads[i].tid == tid) {
+			rt = &registered_threads[i];
+			break;
+		}
+	}
+
+	if (rt == NULL) {
+		if (registered_thread_count >= MAX_REGISTERED_THREADS) {
+			return;
+		}
+		rt = &registered_threads[registered_thread_count++];
+	}
+
+	snprintf(rt->name, sizeof(rt->name), "%s", name);
+	rt->cls = cls;
+	rt->tid = tid;
+	rt->sched_ret = sched_ret;
+	rt->affinity_ret = affinity_ret;
+
+	// Any non-NULL value makes the destructor run on thread exit.
+	pthread_setspecific(registry_key, rt);
+}
+
 static void
 get_name(char *str, size_t count)
 {
@@ -137,3 +483,111 @@ u_linux_try_to_set_realtime_priority_on_thread(enum u_logging_level log_level, c
 		LOG_I("%s", sink.buffer);
 	}
 }
+
+void
+u_linux_thread_classes_parse_json(const cJSON *threads_node)
+{
+	pthread_mutex_lock(&registry_mutex);
+	init_default_policies_locked();
+
+	int ver = -1;
+	if (threads_node != NULL && (!u_json_get_int(u_json_get(threads_node, "version"), &ver) || ver >= 1)) {
+		U_LOG_E("Missing or unknown version tag for thread classes!");
+		threads_node = NULL;
+	}
+
+	for (int i = OS_THREAD_CLASS_DEFAULT + 1; threads_node != NULL && i < OS_THREAD_CLASS_COUNT; i++) {
+		const char *class_name = os_thread_class_str((enum os_thread_class)i);
+		const cJSON *node = u_json_get(threads_node, class_name);
+		if (node != NULL) {
+			parse_class_policy(node, class_name, &class_policies[i]);
+		}
+	}
+
+	pthread_mutex_unlock(&registry_mutex);
+}
+
+void
+u_linux_thread_class_apply(enum os_thread_class cls, enum u_logging_level log_level, const char *name)
+{
+	struct thread_class_policy policy;
+	char str[NAME_LENGTH];
+
+	assert(cls < OS_THREAD_CLASS_COUNT);
+
+	// Always have some name.
+	if (name == NULL) {
+		get_name(str, ARRAY_SIZE(str));
+		name = str;
+	}
+
+	pthread_mutex_lock(&registry_mutex);
+	init_default_policies_locked();
+	policy = class_policies[cls];
+	pthread_mutex_unlock(&registry_mutex);
+
+	// Before the policy, some policies restrict changing the affinity.
+	int affinity_ret = 0;
+	if (policy.has_cpus) {
+		affinity_ret = pthread_setaffinity_np(pthread_self(), sizeof(policy.cpus), &policy.cpus);
+	}
+
+	int sched_ret = apply_policy(&policy);
+
+	if (sched_ret != 0 || affinity_ret != 0) {
+		LOG_W("Could not fully apply the '%s' thread class policy to '%s' (sched: %s, affinity: %s)",
+		      os_thread_class_str(cls), name, strerror(sched_ret), strerror(affinity_ret));
+	} else if (policy.policy != POLICY_UNCHANGED || policy.has_cpus) {
+		LOG_I("Applied the '%s' thread class policy to '%s'", os_thread_class_str(cls), name);
+	}
+
+	pthread_once(&registry_key_once, create_registry_key);
+
+	pthread_mutex_lock(&registry_mutex);
+	register_thread_locked(name, cls, sched_ret, affinity_ret);
+	pthread_mutex_unlock(&registry_mutex);
+}
+
+void
+u_linux_thread_classes_report(enum u_logging_level log_level)
+{
+	struct u_pp_sink_stack_only sink;
+	struct u_pp_delegate dg = u_pp_sink_stack_only_init(&sink);
+
+	u_pp(dg, "Thread classes:");
+
+	pthread_mutex_lock(&registry_mutex);
+
+	for (uint32_t i = 0; i < registered_thread_count; i++) {
+		const struct registered_thread *rt = &registered_threads[i];
+
+		u_pp(dg, "\n\t%-10s %-24s tid: %6i", os_thread_class_str(rt->cls), rt->name, rt->tid);
+
+		int policy = sched_getscheduler(rt->tid);
+		if (policy < 0) {
+			u_pp(dg, " (exited)");
+			continue;
+		}
+
+		struct sched_param params = {0};
+		sched_getparam(rt->tid, &params);
+
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		sched_getaffinity(rt->tid, sizeof(cpus), &cpus);
+
+		// Reset on fork is reported as part of the policy.
+		policy &= ~SCHED_RESET_ON_FORK;
+
+		u_pp(dg, ", policy: '%s', priority: %i, cpus: ", policy_to_string(policy), params.sched_priority);
+		print_cpu_list(dg, &cpus);
+
+		if (rt->sched_ret != 0 || rt->affinity_ret != 0) {
+			u_pp(dg, " (not fully applied)");
+		}
+	}
+
+	pthread_mutex_unlock(&registry_mutex);
+
+	LOG_I("%s", sink.buffer);
+}
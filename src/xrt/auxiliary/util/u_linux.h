@@ -13,12 +13,15 @@
 #include "xrt/xrt_compiler.h"
 #include "xrt/xrt_windows.h"
 #include "util/u_logging.h"
+#include "os/os_threading.h"
 
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+struct cJSON;
+
 
 /*!
  * Try to set realtime priority on this thread. Passing in log_level to control
@@ -33,6 +36,58 @@ extern "C" {
 void
 u_linux_try_to_set_realtime_priority_on_thread(enum u_logging_level log_level, const char *name);
 
+/*!
+ * Set the scheduling policies of the thread classes from the "threads" node
+ * of the config file, classes not in it keep their default policy. Only
+ * threads that are put into a class after this call are affected.
+ *
+ * ```json
+ * "threads": {
+ *     "version": 0,
+ *     "compositor": { "policy": "fifo", "priority": 60, "cpus": "2-3" },
+ *     "tracking": { "policy": "other", "nice": -5, "cpus": "4-7" },
+ *     "driver_io": { "policy": "deadline", "runtime_us": 500, "deadline_us": 1000, "period_us": 1000 }
+ * }
+ * ```
+ *
+ * The policy is one of "unchanged", "other", "batch", "idle", "fifo", "rr"
+ * or "deadline", a missing priority for "fifo" and "rr" means the max. The
+ * kernel doesn't allow "cpus" together with "deadline", such classes are
+ * rejected.
+ *
+ * @param threads_node The "threads" JSON object, may be NULL.
+ *
+ * @ingroup aux_util
+ */
+void
+u_linux_thread_classes_parse_json(const struct cJSON *threads_node);
+
+/*!
+ * Put the calling thread into the given class, applying the scheduling policy
+ * and CPU affinity configured for it. The thread is recorded so that it shows
+ * up in @ref u_linux_thread_classes_report until it exits.
+ *
+ * By default the compositor and driver IO classes try to get the max
+ * SCHED_FIFO priority, the other classes are left as they are.
+ *
+ * @param cls       Class of the calling thread.
+ * @param log_level Logging level to control chattiness.
+ * @param name      Thread name to be used in logging, can be NULL.
+ *
+ * @ingroup aux_util
+ */
+void
+u_linux_thread_class_apply(enum os_thread_class cls, enum u_logging_level log_level, const char *name);
+
+/*!
+ * Log all threads that have been put into a class, with the policy, priority
+ * and CPUs they actually ended up with.
+ *
+ * @ingroup aux_util
+ */
+void
+u_linux_thread_classes_report(enum u_logging_level log_level);
+
 
 #ifdef __cplusplus
 }
@@ -7,18 +7,21 @@
  * @ingroup aux_util
  */
 
+#include "os/os_time.h"
 #include "os/os_threading.h"
 
 #include "util/u_metrics.h"
 #include "util/u_debug.h"
+#include "util/u_telemetry.h"
 
 #include "monado_metrics.pb.h"
 #include "pb_encode.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #define VERSION_MAJOR 1
-#define VERSION_MINOR 1
+#define VERSION_MINOR 2
 
 static FILE *g_file = NULL;
 static struct os_mutex g_file_mutex;
@@ -133,12 +136,30 @@ u_metrics_close(void)
 bool
 u_metrics_is_active(void)
 {
-	return g_metrics_initialized;
+	return g_metrics_initialized || u_telemetry_is_active();
 }
 
 void
 u_metrics_write_session_frame(struct u_metrics_session_frame *umsf)
 {
+	if (u_telemetry_is_active()) {
+		struct u_telemetry_client_frame utcf = {
+		    .session_id = umsf->session_id,
+		    .frame_id = umsf->frame_id,
+		    .predicted_display_time_ns = umsf->predicted_display_time_ns,
+		    .predicted_display_period_ns = umsf->predicted_display_period_ns,
+		    .display_time_ns = umsf->display_time_ns,
+		    .when_predicted_ns = umsf->when_predicted_ns,
+		    .when_wait_woke_ns = umsf->when_wait_woke_ns,
+		    .when_begin_ns = umsf->when_begin_ns,
+		    .when_delivered_ns = umsf->when_delivered_ns,
+		    .when_gpu_done_ns = umsf->when_gpu_done_ns,
+		    .discarded = umsf->discarded,
+		};
+
+		u_telemetry_push_client_frame(os_monotonic_get_ns(), &utcf);
+	}
+
 	if (!g_metrics_initialized) {
 		return;
 	}
@@ -179,6 +200,18 @@ u_metrics_write_used(struct u_metrics_used *umu)
 void
 u_metrics_write_system_frame(struct u_metrics_system_frame *umsf)
 {
+	if (u_telemetry_is_active()) {
+		struct u_telemetry_compositor_frame utcf = {
+		    .frame_id = umsf->frame_id,
+		    .predicted_display_time_ns = umsf->predicted_display_time_ns,
+		    .predicted_display_period_ns = umsf->predicted_display_period_ns,
+		    .desired_present_time_ns = umsf->desired_present_time_ns,
+		    .present_slop_ns = umsf->present_slop_ns,
+		};
+
+		u_telemetry_push_compositor_frame(os_monotonic_get_ns(), &utcf);
+	}
+
 	if (!g_metrics_initialized) {
 		return;
 	}
@@ -219,6 +252,23 @@ u_metrics_write_system_gpu_info(struct u_metrics_system_gpu_info *umgi)
 void
 u_metrics_write_system_present_info(struct u_metrics_system_present_info *umpi)
 {
+	if (u_telemetry_is_active()) {
+		struct u_telemetry_compositor_frame utcf = {
+		    .frame_id = umpi->frame_id,
+		    .predicted_display_time_ns = umpi->predicted_display_time_ns,
+		    .desired_present_time_ns = umpi->desired_present_time_ns,
+		    .actual_present_time_ns = umpi->actual_present_time_ns,
+		    .when_predict_ns = umpi->when_predict_ns,
+		    .when_woke_ns = umpi->when_woke_ns,
+		    .when_began_ns = umpi->when_began_ns,
+		    .when_submitted_ns = umpi->when_submitted_ns,
+		    .present_margin_ns = umpi->present_margin_ns,
+		    .present_slop_ns = umpi->present_slop_ns,
+		};
+
+		u_telemetry_push_compositor_frame(umpi->when_infoed_ns, &utcf);
+	}
+
 	if (!g_metrics_initialized) {
 		return;
 	}
@@ -233,5 +283,35 @@ u_metrics_write_system_present_info(struct u_metrics_system_present_info *umpi)
 #undef COPY
 
 
+	write_record(&record);
+}
+
+void
+u_metrics_write_device_prediction(struct u_metrics_device_prediction *umdp)
+{
+	if (!g_metrics_initialized) {
+		return;
+	}
+
+	monado_metrics_Record record = monado_metrics_Record_init_default;
+
+	// Select which filed is used.
+	record.which_record = monado_metrics_Record_device_prediction_tag;
+
+	// Strings can't be assigned, the rest is copied below.
+	snprintf(record.record.device_prediction.device_name, sizeof(record.record.device_prediction.device_name),
+	         "%s", umdp->device_name);
+
+#define COPY_STRING(...)
+#define COPY_UINT64(FIELD) (record.record.device_prediction.FIELD = umdp->FIELD);
+#define COPY_INT64(FIELD) (record.record.device_prediction.FIELD = umdp->FIELD);
+#define COPY(_0, _1, _2, TYPE, FIELD, _4) COPY_##TYPE(FIELD)
+	monado_metrics_DevicePrediction_FIELDLIST(COPY, 0);
+#undef COPY
+#undef COPY_INT64
+#undef COPY_UINT64
+#undef COPY_STRING
+
+
 	write_record(&record);
 }
@@ -79,6 +79,29 @@ struct u_metrics_system_present_info
 	uint64_t earliest_present_time_ns;
 };
 
+/*!
+ * How a device was asked for poses over a period, counts and times are for
+ * that period only.
+ */
+struct u_metrics_device_prediction
+{
+	char device_name[64];
+	uint64_t when_ns;
+	uint64_t exact_count;
+	uint64_t interpolated_count;
+	uint64_t predicted_count;
+	uint64_t reverse_predicted_count;
+	//! Query time minus current time, how far ahead callers ask.
+	int64_t horizon_mean_ns;
+	int64_t horizon_max_ns;
+	//! Query time minus newest sample time, only for extrapolated queries.
+	int64_t extrapolation_mean_ns;
+	int64_t extrapolation_max_ns;
+	//! Current time minus newest sample time.
+	int64_t sample_age_mean_ns;
+	int64_t sample_age_max_ns;
+};
+
 
 void
 u_metrics_init(void);
@@ -104,6 +127,9 @@ u_metrics_write_system_gpu_info(struct u_metrics_system_gpu_info *umgi);
 void
 u_metrics_write_system_present_info(struct u_metrics_system_present_info *umpi);
 
+void
+u_metrics_write_device_prediction(struct u_metrics_device_prediction *umdp);
+
 
 #ifdef __cplusplus
 }
@@ -739,12 +739,27 @@ u_pc_fake_create(uint64_t estimated_frame_period_ns, uint64_t now_ns, struct u_p
 /*!
  * Creates a new application pacing factory helper.
  *
+ * The app rate divisor is read from `U_PACING_APP_RATE_DIVISOR`, see
+ * @ref u_pa_factory_create_with_rate_divisor.
+ *
  * @ingroup aux_pacing
  * @see u_pacing_app
  */
 xrt_result_t
 u_pa_factory_create(struct u_pacing_app_factory **out_upaf);
 
+/*!
+ * Creates a new application pacing factory helper, whose app pacers pace the
+ * apps at 1/@p rate_divisor of the display rate, 1 being full rate. Frames
+ * are displayed on every @p rate_divisor display frame and the compositor
+ * reprojects them for the display frames in between.
+ *
+ * @ingroup aux_pacing
+ * @see u_pacing_app
+ */
+xrt_result_t
+u_pa_factory_create_with_rate_divisor(uint32_t rate_divisor, struct u_pacing_app_factory **out_upaf);
+
 
 #ifdef __cplusplus
 }
@@ -25,6 +25,7 @@
 DEBUG_GET_ONCE_LOG_OPTION(log_level, "U_PACING_APP_LOG", U_LOGGING_WARN)
 DEBUG_GET_ONCE_FLOAT_OPTION(min_app_time_ms, "U_PACING_APP_MIN_TIME_MS", 1.0f)
 DEBUG_GET_ONCE_FLOAT_OPTION(min_margin_ms, "U_PACING_APP_MIN_MARGIN_MS", 2.0f)
+DEBUG_GET_ONCE_NUM_OPTION(rate_divisor, "U_PACING_APP_RATE_DIVISOR", 1)
 
 #define UPA_LOG_T(...) U_LOG_IFL_T(debug_get_log_option_log_level(), __VA_ARGS__)
 #define UPA_LOG_D(...) U_LOG_IFL_D(debug_get_log_option_log_level(), __VA_ARGS__)
@@ -53,6 +54,9 @@ DEBUG_GET_ONCE_FLOAT_OPTION(min_margin_ms, "U_PACING_APP_MIN_MARGIN_MS", 2.0f)
  */
 #define FRAME_COUNT (128)
 
+//! Largest supported rate divisor, beyond that reprojection artifacts get too noticeable.
+#define MAX_RATE_DIVISOR (4)
+
 enum u_pa_state
 {
 	U_PA_READY,
@@ -137,6 +141,14 @@ struct pacing_app
 	 */
 	struct u_var_draggable_f32 min_margin_ms;
 
+	/*!
+	 * Run the app at this fraction of the display rate, the compositor
+	 * reprojects the latest frame for the display frames in between. The
+	 * app may still go slower then this if it can't keep up.
+	 */
+	uint16_t rate_divisor;
+	struct u_var_draggable_u16 rate_divisor_ui;
+
 	struct
 	{
 		//! App time between wait returning and begin being called.
@@ -224,6 +236,14 @@ min_period(const struct pacing_app *pa)
 	return pa->last_input.predicted_display_period_ns;
 }
 
+static uint64_t
+app_period(const struct pacing_app *pa)
+{
+	uint64_t divisor = pa->rate_divisor < 1 ? 1 : pa->rate_divisor;
+
+	return min_period(pa) * divisor;
+}
+
 static uint64_t
 min_app_time(const struct pacing_app *pa)
 {
@@ -283,8 +303,12 @@ calc_period(const struct pacing_app *pa)
 		base_period_ns = U_TIME_1MS_IN_NS * 16; // Sure
 	}
 
-	// Calculate the using both values separately.
-	uint64_t period_ns = base_period_ns;
+	// Calculate the using both values separately, starting from the selected rate.
+	uint64_t period_ns = app_period(pa);
+	if (period_ns < base_period_ns) {
+		period_ns = base_period_ns;
+	}
+
 	while (pa->app.cpu_time_ns > period_ns) {
 		period_ns += base_period_ns;
 	}
@@ -310,11 +334,19 @@ predict_display_time(const struct pacing_app *pa, uint64_t now_ns, uint64_t peri
 	// Start from the last time that the driver displayed something.
 	uint64_t val = last_sample_displayed(pa);
 
-	// Return a time after the last returned display time. Add half the
-	// display period to the comparison for robustness when the last display
-	// time shifts slightly with respect to the last sample.
-	while (val <= last_return_predicted_display(pa) + (period_ns / 2)) {
-		val += period_ns;
+	// The display period, the app period is a multiple of it.
+	uint64_t display_period_ns = min_period(pa);
+	if (display_period_ns == 0 || display_period_ns > period_ns) {
+		display_period_ns = period_ns;
+	}
+
+	// Return a time one app period after the last returned display time,
+	// stepping by display periods so the app keeps a steady cadence that
+	// lines up with the displays refresh. Subtract half the display period
+	// in the comparison for robustness when the last display time shifts
+	// slightly with respect to the last sample.
+	while (val <= last_return_predicted_display(pa) + period_ns - (display_period_ns / 2)) {
+		val += display_period_ns;
 	}
 
 	// Have to have enough time to perform app work.
@@ -679,7 +711,7 @@ pa_destroy(struct u_pacing_app *upa)
 }
 
 static xrt_result_t
-pa_create(int64_t session_id, struct u_pacing_app **out_upa)
+pa_create(int64_t session_id, uint16_t rate_divisor, struct u_pacing_app **out_upa)
 {
 	struct pacing_app *pa = U_TYPED_CALLOC(struct pacing_app);
 	pa->base.predict = pa_predict;
@@ -692,6 +724,7 @@ pa_create(int64_t session_id, struct u_pacing_app **out_upa)
 	pa->base.info = pa_info;
 	pa->base.destroy = pa_destroy;
 	pa->session_id = session_id;
+	pa->rate_divisor = rate_divisor;
 	pa->app.cpu_time_ns = U_TIME_1MS_IN_NS * 2;
 	pa->app.draw_time_ns = U_TIME_1MS_IN_NS * 2;
 
@@ -709,6 +742,13 @@ pa_create(int64_t session_id, struct u_pacing_app **out_upa)
 	    .max = +120.0, // There are some really slow applications out there.
 	};
 
+	pa->rate_divisor_ui = (struct u_var_draggable_u16){
+	    .val = &pa->rate_divisor,
+	    .step = 1,
+	    .min = 1,
+	    .max = MAX_RATE_DIVISOR,
+	};
+
 	for (size_t i = 0; i < ARRAY_SIZE(pa->frames); i++) {
 		pa->frames[i].state = U_PA_READY;
 		pa->frames[i].frame_id = -1;
@@ -718,6 +758,7 @@ pa_create(int64_t session_id, struct u_pacing_app **out_upa)
 	u_var_add_root(pa, "App timing info", true);
 	u_var_add_draggable_f32(pa, &pa->min_margin_ms, "Minimum margin(ms)");
 	u_var_add_draggable_f32(pa, &pa->min_app_time_ms, "Minimum app time(ms)");
+	u_var_add_draggable_u16(pa, &pa->rate_divisor_ui, "Rate divisor");
 	u_var_add_ro_u64(pa, &pa->app.cpu_time_ns, "CPU time(ns)");
 	u_var_add_ro_u64(pa, &pa->app.draw_time_ns, "Draw time(ns)");
 	u_var_add_ro_u64(pa, &pa->app.gpu_time_ns, "GPU time(ns)");
@@ -734,12 +775,21 @@ pa_create(int64_t session_id, struct u_pacing_app **out_upa)
  *
  */
 
+struct pacing_app_factory
+{
+	struct u_pacing_app_factory base;
+
+	//! Rate divisor given to all created app pacers.
+	uint16_t rate_divisor;
+};
+
 static xrt_result_t
 paf_create(struct u_pacing_app_factory *upaf, struct u_pacing_app **out_upa)
 {
+	struct pacing_app_factory *paf = (struct pacing_app_factory *)upaf;
 	static int64_t session_id_gen = 0; // For now until global session id is introduced.
 
-	return pa_create(session_id_gen++, out_upa);
+	return pa_create(session_id_gen++, paf->rate_divisor, out_upa);
 }
 
 static void
@@ -756,13 +806,34 @@ paf_destroy(struct u_pacing_app_factory *upaf)
  */
 
 xrt_result_t
-u_pa_factory_create(struct u_pacing_app_factory **out_upaf)
+u_pa_factory_create_with_rate_divisor(uint32_t rate_divisor, struct u_pacing_app_factory **out_upaf)
 {
-	struct u_pacing_app_factory *upaf = U_TYPED_CALLOC(struct u_pacing_app_factory);
-	upaf->create = paf_create;
-	upaf->destroy = paf_destroy;
+	if (rate_divisor < 1 || rate_divisor > MAX_RATE_DIVISOR) {
+		UPA_LOG_W("Rate divisor %u out of range [1, %u], clamping", rate_divisor, MAX_RATE_DIVISOR);
+		rate_divisor = rate_divisor < 1 ? 1 : MAX_RATE_DIVISOR;
+	}
+
+	if (rate_divisor > 1) {
+		UPA_LOG_I("Running apps at 1/%u of the display rate", rate_divisor);
+	}
 
-	*out_upaf = upaf;
+	struct pacing_app_factory *paf = U_TYPED_CALLOC(struct pacing_app_factory);
+	paf->base.create = paf_create;
+	paf->base.destroy = paf_destroy;
+	paf->rate_divisor = (uint16_t)rate_divisor;
+
+	*out_upaf = &paf->base;
 
 	return XRT_SUCCESS;
 }
+
+xrt_result_t
+u_pa_factory_create(struct u_pacing_app_factory **out_upaf)
+{
+	long rate_divisor = debug_get_num_option_rate_divisor();
+	if (rate_divisor < 1) {
+		rate_divisor = 1;
+	}
+
+	return u_pa_factory_create_with_rate_divisor((uint32_t)rate_divisor, out_upaf);
+}
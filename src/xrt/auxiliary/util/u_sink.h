@@ -142,6 +142,52 @@ u_sink_split_create(struct xrt_frame_context *xfctx,
                     struct xrt_frame_sink *right,
                     struct xrt_frame_sink **out_xfs);
 
+//! Max number of consumers on a @ref u_sink_hub.
+#define U_SINK_HUB_MAX_CONSUMERS 8
+
+//! Max number of distinct converted or downscaled frames a @ref u_sink_hub makes.
+#define U_SINK_HUB_MAX_VARIANTS 8
+
+/*!
+ * Fans out the frames from one camera to several consumers, such as the SLAM
+ * tracker, hand tracking and recorders. Consumers can ask for a converted
+ * format and/or a downscaled pyramid level instead of the frame as is, each
+ * such variant is made only once per frame and the same refcounted frame is
+ * given to every consumer that asked for it.
+ *
+ * Add all consumers before frames start being pushed.
+ *
+ * @see u_sink_hub_create
+ */
+struct u_sink_hub;
+
+/*!
+ * @public @memberof xrt_frame_sink
+ * @see xrt_frame_context
+ */
+void
+u_sink_hub_create(struct xrt_frame_context *xfctx, struct u_sink_hub **out_hub, struct xrt_frame_sink **out_xfs);
+
+/*!
+ * Add a consumer that gets the frames as they are pushed into the hub.
+ *
+ * @public @memberof u_sink_hub
+ */
+bool
+u_sink_hub_add(struct u_sink_hub *hub, struct xrt_frame_sink *downstream);
+
+/*!
+ * Add a consumer that gets the frames converted to @p format, only L8 and
+ * R8G8B8 are supported, and downscaled by two @p level times.
+ *
+ * @public @memberof u_sink_hub
+ */
+bool
+u_sink_hub_add_derived(struct u_sink_hub *hub,
+                       enum xrt_format format,
+                       uint32_t level,
+                       struct xrt_frame_sink *downstream);
+
 /*!
  * Splits Stereo SBS frames into two independent frames
  */
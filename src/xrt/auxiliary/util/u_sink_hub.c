@@ -0,0 +1,314 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  An @ref xrt_frame_sink that fans out frames and shared derived frames.
+ * @author agent <agent@local>
+ * @ingroup aux_util
+ */
+
+#include "util/u_misc.h"
+#include "util/u_sink.h"
+#include "util/u_frame.h"
+#include "util/u_format.h"
+#include "util/u_logging.h"
+#include "util/u_trace_marker.h"
+
+#include <assert.h>
+
+
+/*
+ *
+ * Structs and defines.
+ *
+ */
+
+/*!
+ * One derived version of the incoming frame, converted and/or downscaled.
+ */
+struct u_sink_hub_variant
+{
+	//! Receives the frame from the converter.
+	struct xrt_frame_sink capture;
+
+	//! Converter sink for level zero, NULL for downscaled levels.
+	struct xrt_frame_sink *convert;
+
+	//! Index of the variant one level up, only valid if @ref level > 0.
+	uint32_t parent;
+
+	enum xrt_format format;
+	uint32_t level;
+
+	//! Only valid during a push.
+	struct xrt_frame *frame;
+};
+
+struct u_sink_hub_consumer
+{
+	struct xrt_frame_sink *downstream;
+
+	//! Index into the variants, or @ref U_SINK_HUB_RAW for the frame as is.
+	uint32_t variant;
+};
+
+#define U_SINK_HUB_RAW UINT32_MAX
+
+/*!
+ * An @ref xrt_frame_sink that gives each consumer the version of the frame it
+ * wants, making every version only once per frame no matter how many
+ * consumers share it.
+ *
+ * @implements xrt_frame_sink
+ * @implements xrt_frame_node
+ */
+struct u_sink_hub
+{
+	struct xrt_frame_sink base;
+	struct xrt_frame_node node;
+
+	struct xrt_frame_context *xfctx;
+
+	struct u_sink_hub_variant variants[U_SINK_HUB_MAX_VARIANTS];
+	uint32_t variant_count;
+
+	struct u_sink_hub_consumer consumers[U_SINK_HUB_MAX_CONSUMERS];
+	uint32_t consumer_count;
+};
+
+
+/*
+ *
+ * Helpers.
+ *
+ */
+
+static uint32_t
+channels_of(enum xrt_format format)
+{
+	switch (format) {
+	case XRT_FORMAT_L8: return 1;
+	case XRT_FORMAT_R8G8B8: return 3;
+	default: return 0;
+	}
+}
+
+//! 2x2 box filter, odd last rows and columns are dropped.
+static struct xrt_frame *
+downscale_half(struct xrt_frame *src)
+{
+	uint32_t channels = channels_of(src->format);
+	uint32_t w = src->width / 2;
+	uint32_t h = src->height / 2;
+
+	if (w == 0 || h == 0) {
+		return NULL;
+	}
+
+	struct xrt_frame *dst = NULL;
+	u_frame_create_one_off(src->format, w, h, &dst);
+	if (dst == NULL) {
+		return NULL;
+	}
+
+	dst->timestamp = src->timestamp;
+	dst->source_timestamp = src->source_timestamp;
+	dst->source_sequence = src->source_sequence;
+	dst->source_id = src->source_id;
+	dst->stereo_format = src->stereo_format;
+
+	for (uint32_t y = 0; y < h; y++) {
+		const uint8_t *row0 = src->data + (size_t)(y * 2) * src->stride;
+		const uint8_t *row1 = row0 + src->stride;
+		uint8_t *out = dst->data + (size_t)y * dst->stride;
+
+		for (uint32_t x = 0; x < w * channels; x++) {
+			uint32_t i = (x / channels) * 2 * channels + (x % channels);
+			uint32_t sum = row0[i] + row0[i + channels] + row1[i] + row1[i + channels];
+			out[x] = (uint8_t)((sum + 2) / 4);
+		}
+	}
+
+	return dst;
+}
+
+static uint32_t
+find_variant(struct u_sink_hub *hub, enum xrt_format format, uint32_t level)
+{
+	for (uint32_t i = 0; i < hub->variant_count; i++) {
+		if (hub->variants[i].format == format && hub->variants[i].level == level) {
+			return i;
+		}
+	}
+
+	return U_SINK_HUB_RAW;
+}
+
+static void
+capture_frame(struct xrt_frame_sink *xfs, struct xrt_frame *xf)
+{
+	struct u_sink_hub_variant *v = container_of(xfs, struct u_sink_hub_variant, capture);
+
+	xrt_frame_reference(&v->frame, xf);
+}
+
+static uint32_t
+get_or_add_variant(struct u_sink_hub *hub, enum xrt_format format, uint32_t level)
+{
+	uint32_t index = find_variant(hub, format, level);
+	if (index != U_SINK_HUB_RAW) {
+		return index;
+	}
+
+	// Pyramid levels are made from the level above, which must come first.
+	uint32_t parent = 0;
+	if (level > 0) {
+		parent = get_or_add_variant(hub, format, level - 1);
+		if (parent == U_SINK_HUB_RAW) {
+			return U_SINK_HUB_RAW;
+		}
+	}
+
+	if (hub->variant_count >= U_SINK_HUB_MAX_VARIANTS) {
+		U_LOG_E("Too many variants on sink hub!");
+		return U_SINK_HUB_RAW;
+	}
+
+	index = hub->variant_count;
+	struct u_sink_hub_variant *v = &hub->variants[index];
+	v->capture.push_frame = capture_frame;
+	v->format = format;
+	v->level = level;
+	v->parent = parent;
+
+	if (level == 0) {
+		// Passes the frame through untouched if it already has the format.
+		u_sink_create_format_converter(hub->xfctx, format, &v->capture, &v->convert);
+		if (v->convert == NULL) {
+			return U_SINK_HUB_RAW;
+		}
+	}
+
+	hub->variant_count++;
+
+	return index;
+}
+
+
+/*
+ *
+ * Sink and node functions.
+ *
+ */
+
+static void
+hub_push_frame(struct xrt_frame_sink *xfs, struct xrt_frame *xf)
+{
+	SINK_TRACE_MARKER();
+
+	struct u_sink_hub *hub = container_of(xfs, struct u_sink_hub, base);
+
+	// Parents are always before their children.
+	for (uint32_t i = 0; i < hub->variant_count; i++) {
+		struct u_sink_hub_variant *v = &hub->variants[i];
+
+		if (v->level == 0) {
+			xrt_sink_push_frame(v->convert, xf);
+		} else if (hub->variants[v->parent].frame != NULL) {
+			v->frame = downscale_half(hub->variants[v->parent].frame);
+		}
+	}
+
+	for (uint32_t i = 0; i < hub->consumer_count; i++) {
+		struct u_sink_hub_consumer *c = &hub->consumers[i];
+		struct xrt_frame *frame = c->variant == U_SINK_HUB_RAW ? xf : hub->variants[c->variant].frame;
+
+		if (frame != NULL) {
+			xrt_sink_push_frame(c->downstream, frame);
+		}
+	}
+
+	for (uint32_t i = 0; i < hub->variant_count; i++) {
+		xrt_frame_reference(&hub->variants[i].frame, NULL);
+	}
+}
+
+static void
+hub_break_apart(struct xrt_frame_node *node)
+{
+	// Noop
+}
+
+static void
+hub_destroy(struct xrt_frame_node *node)
+{
+	struct u_sink_hub *hub = container_of(node, struct u_sink_hub, node);
+
+	free(hub);
+}
+
+
+/*
+ *
+ * 'Exported' functions.
+ *
+ */
+
+void
+u_sink_hub_create(struct xrt_frame_context *xfctx, struct u_sink_hub **out_hub, struct xrt_frame_sink **out_xfs)
+{
+	struct u_sink_hub *hub = U_TYPED_CALLOC(struct u_sink_hub);
+
+	hub->base.push_frame = hub_push_frame;
+	hub->node.break_apart = hub_break_apart;
+	hub->node.destroy = hub_destroy;
+	hub->xfctx = xfctx;
+
+	xrt_frame_context_add(xfctx, &hub->node);
+
+	*out_hub = hub;
+	*out_xfs = &hub->base;
+}
+
+bool
+u_sink_hub_add(struct u_sink_hub *hub, struct xrt_frame_sink *downstream)
+{
+	assert(downstream != NULL);
+
+	if (hub->consumer_count >= U_SINK_HUB_MAX_CONSUMERS) {
+		U_LOG_E("Too many consumers on sink hub!");
+		return false;
+	}
+
+	hub->consumers[hub->consumer_count++] = (struct u_sink_hub_consumer){downstream, U_SINK_HUB_RAW};
+
+	return true;
+}
+
+bool
+u_sink_hub_add_derived(struct u_sink_hub *hub,
+                       enum xrt_format format,
+                       uint32_t level,
+                       struct xrt_frame_sink *downstream)
+{
+	assert(downstream != NULL);
+
+	if (channels_of(format) == 0) {
+		U_LOG_E("Format '%s' not supported by sink hub", u_format_str(format));
+		return false;
+	}
+
+	if (hub->consumer_count >= U_SINK_HUB_MAX_CONSUMERS) {
+		U_LOG_E("Too many consumers on sink hub!");
+		return false;
+	}
+
+	uint32_t variant = get_or_add_variant(hub, format, level);
+	if (variant == U_SINK_HUB_RAW) {
+		return false;
+	}
+
+	hub->consumers[hub->consumer_count++] = (struct u_sink_hub_consumer){downstream, variant};
+
+	return true;
+}
@@ -573,3 +573,25 @@ u_space_overseer_link_space_to_device(struct u_space_overseer *uso, struct xrt_s
 	struct xrt_space *old_space = (struct xrt_space *)ptr;
 	xrt_space_reference(&old_space, NULL);
 }
+
+bool
+u_space_overseer_get_device_space(struct u_space_overseer *uso,
+                                  struct xrt_device *xdev,
+                                  struct xrt_space **out_space)
+{
+	assert(out_space != NULL);
+	assert(*out_space == NULL);
+
+	pthread_rwlock_rdlock(&uso->lock);
+
+	void *ptr = NULL;
+	uint64_t key = (uint64_t)(intptr_t)xdev;
+	u_hashmap_int_find(uso->xdev_map, key, &ptr);
+
+	// Add the reference while still holding the lock.
+	xrt_space_reference(out_space, (struct xrt_space *)ptr);
+
+	pthread_rwlock_unlock(&uso->lock);
+
+	return ptr != NULL;
+}
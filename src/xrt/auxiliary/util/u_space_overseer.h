@@ -70,6 +70,18 @@ u_space_overseer_create_null_space(struct u_space_overseer *uso,
 void
 u_space_overseer_link_space_to_device(struct u_space_overseer *uso, struct xrt_space *xs, struct xrt_device *xdev);
 
+/*!
+ * Get the space that @p xdev has been linked to, adds a reference to the space
+ * returned in @p out_space. Returns false if no space has been linked to the
+ * device, in which case @p out_space is left untouched.
+ *
+ * @ingroup aux_util
+ */
+bool
+u_space_overseer_get_device_space(struct u_space_overseer *uso,
+                                  struct xrt_device *xdev,
+                                  struct xrt_space **out_space);
+
 
 /*
  *
@@ -0,0 +1,263 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Shared memory ring of high rate timing telemetry.
+ * @author agent <agent@local>
+ * @ingroup aux_util
+ */
+
+#include "util/u_telemetry.h"
+
+#include <atomic>
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+
+/*
+ *
+ * Helpers.
+ *
+ */
+
+namespace {
+
+// The ring is shared between processes, so the atomics must not use locks.
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "Atomic must be plain 64 bit value");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Atomic must be lock free");
+static_assert((U_TELEMETRY_ENTRY_COUNT & (U_TELEMETRY_ENTRY_COUNT - 1)) == 0, "Must be power of two");
+
+//! Everything after the sequence number is copied as plain memory.
+constexpr size_t kPayloadOffset = offsetof(struct u_telemetry_entry, type);
+constexpr size_t kPayloadSize = sizeof(struct u_telemetry_entry) - kPayloadOffset;
+
+std::atomic<struct u_telemetry_ring *> g_ring{nullptr};
+std::atomic<uint32_t> g_subscriber_count{0};
+
+inline std::atomic<uint64_t> &
+as_atomic(uint64_t &value)
+{
+	return *reinterpret_cast<std::atomic<uint64_t> *>(&value);
+}
+
+inline const std::atomic<uint64_t> &
+as_atomic(const uint64_t &value)
+{
+	return *reinterpret_cast<const std::atomic<uint64_t> *>(&value);
+}
+
+inline std::atomic<uint32_t> &
+as_atomic(uint32_t &value)
+{
+	return *reinterpret_cast<std::atomic<uint32_t> *>(&value);
+}
+
+inline const std::atomic<uint32_t> &
+as_atomic(const uint32_t &value)
+{
+	return *reinterpret_cast<const std::atomic<uint32_t> *>(&value);
+}
+
+//! Sequence number of a completely written entry at @p index.
+inline uint64_t
+complete_seq(uint64_t index)
+{
+	return (index + 1) * 2;
+}
+
+void
+push(struct u_telemetry_entry &entry)
+{
+	struct u_telemetry_ring *ring = g_ring.load(std::memory_order_acquire);
+	if (ring == nullptr || g_subscriber_count.load(std::memory_order_relaxed) == 0) {
+		return;
+	}
+
+	u_telemetry_ring_push(ring, &entry);
+}
+
+} // namespace
+
+
+/*
+ *
+ * 'Exported' writing functions.
+ *
+ */
+
+extern "C" void
+u_telemetry_init(struct u_telemetry_ring *ring)
+{
+	memset(ring, 0, sizeof(*ring));
+	ring->version = U_TELEMETRY_VERSION;
+	ring->entry_count = U_TELEMETRY_ENTRY_COUNT;
+	ring->entry_size = sizeof(struct u_telemetry_entry);
+
+	// Readers check the magic last, so it is written last.
+	as_atomic(ring->magic).store(U_TELEMETRY_MAGIC, std::memory_order_release);
+
+	g_ring.store(ring, std::memory_order_release);
+}
+
+extern "C" void
+u_telemetry_close(void)
+{
+	g_ring.store(nullptr, std::memory_order_release);
+}
+
+extern "C" void
+u_telemetry_add_subscriber(void)
+{
+	g_subscriber_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+extern "C" void
+u_telemetry_remove_subscriber(void)
+{
+	uint32_t old = g_subscriber_count.fetch_sub(1, std::memory_order_relaxed);
+	assert(old > 0);
+	(void)old;
+}
+
+extern "C" bool
+u_telemetry_is_active(void)
+{
+	return g_subscriber_count.load(std::memory_order_relaxed) > 0 &&
+	       g_ring.load(std::memory_order_relaxed) != nullptr;
+}
+
+extern "C" void
+u_telemetry_push_compositor_frame(uint64_t when_ns, const struct u_telemetry_compositor_frame *frame)
+{
+	struct u_telemetry_entry entry = {};
+	entry.type = U_TELEMETRY_TYPE_COMPOSITOR_FRAME;
+	entry.when_ns = when_ns;
+	entry.compositor_frame = *frame;
+
+	push(entry);
+}
+
+extern "C" void
+u_telemetry_push_client_frame(uint64_t when_ns, const struct u_telemetry_client_frame *frame)
+{
+	struct u_telemetry_entry entry = {};
+	entry.type = U_TELEMETRY_TYPE_CLIENT_FRAME;
+	entry.when_ns = when_ns;
+	entry.client_frame = *frame;
+
+	push(entry);
+}
+
+extern "C" void
+u_telemetry_push_device_poses(uint64_t when_ns, const struct u_telemetry_device_poses *poses)
+{
+	struct u_telemetry_entry entry = {};
+	entry.type = U_TELEMETRY_TYPE_DEVICE_POSES;
+	entry.when_ns = when_ns;
+	entry.device_poses = *poses;
+
+	push(entry);
+}
+
+extern "C" void
+u_telemetry_ring_push(struct u_telemetry_ring *ring, const struct u_telemetry_entry *entry)
+{
+	// Claim a slot, writers never wait on each other or the readers.
+	uint64_t index = as_atomic(ring->write_index).fetch_add(1, std::memory_order_relaxed);
+	struct u_telemetry_entry &dst = ring->entries[index % U_TELEMETRY_ENTRY_COUNT];
+
+	// Odd while writing.
+	as_atomic(dst.seq).store(complete_seq(index) - 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	memcpy(reinterpret_cast<uint8_t *>(&dst) + kPayloadOffset,
+	       reinterpret_cast<const uint8_t *>(entry) + kPayloadOffset, kPayloadSize);
+
+	as_atomic(dst.seq).store(complete_seq(index), std::memory_order_release);
+}
+
+
+/*
+ *
+ * 'Exported' reading functions.
+ *
+ */
+
+extern "C" bool
+u_telemetry_ring_is_valid(const struct u_telemetry_ring *ring)
+{
+	if (as_atomic(ring->magic).load(std::memory_order_acquire) != U_TELEMETRY_MAGIC) {
+		return false;
+	}
+
+	return ring->version == U_TELEMETRY_VERSION &&            //
+	       ring->entry_count == U_TELEMETRY_ENTRY_COUNT &&    //
+	       ring->entry_size == sizeof(struct u_telemetry_entry); //
+}
+
+extern "C" uint64_t
+u_telemetry_ring_get_write_index(const struct u_telemetry_ring *ring)
+{
+	return as_atomic(ring->write_index).load(std::memory_order_acquire);
+}
+
+extern "C" uint32_t
+u_telemetry_ring_read(const struct u_telemetry_ring *ring,
+                      uint64_t *read_index,
+                      struct u_telemetry_entry *out_entries,
+                      uint32_t capacity,
+                      uint64_t *out_dropped)
+{
+	uint64_t write_index = u_telemetry_ring_get_write_index(ring);
+	uint64_t index = *read_index;
+	uint64_t dropped = 0;
+	uint32_t count = 0;
+
+	// Ahead of the writer, the service was probably restarted.
+	if (index > write_index) {
+		index = write_index;
+	}
+
+	// Lapped by the writers, skip to the oldest entry that can still be there.
+	if (write_index - index > U_TELEMETRY_ENTRY_COUNT) {
+		dropped += write_index - index - U_TELEMETRY_ENTRY_COUNT;
+		index = write_index - U_TELEMETRY_ENTRY_COUNT;
+	}
+
+	while (index < write_index && count < capacity) {
+		const struct u_telemetry_entry &src = ring->entries[index % U_TELEMETRY_ENTRY_COUNT];
+		struct u_telemetry_entry &dst = out_entries[count];
+		const uint64_t expected = complete_seq(index);
+
+		uint64_t before = as_atomic(src.seq).load(std::memory_order_acquire);
+		if (before < expected) {
+			break; // Claimed but not written yet, read it next time.
+		}
+
+		if (before == expected) {
+			memcpy(reinterpret_cast<uint8_t *>(&dst) + kPayloadOffset,
+			       reinterpret_cast<const uint8_t *>(&src) + kPayloadOffset, kPayloadSize);
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+
+		uint64_t after = as_atomic(src.seq).load(std::memory_order_relaxed);
+		index++;
+
+		if (before != expected || after != expected) {
+			dropped++; // Overwritten before or while being copied.
+			continue;
+		}
+
+		dst.seq = expected;
+		count++;
+	}
+
+	*read_index = index;
+
+	if (out_dropped != NULL) {
+		*out_dropped = dropped;
+	}
+
+	return count;
+}
@@ -0,0 +1,269 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Shared memory ring of high rate timing telemetry.
+ * @author agent <agent@local>
+ * @ingroup aux_util
+ */
+
+#pragma once
+
+#include "xrt/xrt_compiler.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+//! Written to @ref u_telemetry_ring::magic once the ring is ready, "MNDT".
+#define U_TELEMETRY_MAGIC (0x54444e4du)
+
+//! Bumped whenever the layout of the ring changes.
+#define U_TELEMETRY_VERSION (1u)
+
+//! Number of entries in the ring, must be a power of two.
+#define U_TELEMETRY_ENTRY_COUNT (4096u)
+
+/*!
+ * What kind of data a @ref u_telemetry_entry holds.
+ *
+ * @ingroup aux_util
+ */
+enum u_telemetry_type
+{
+	U_TELEMETRY_TYPE_NONE = 0,
+	U_TELEMETRY_TYPE_COMPOSITOR_FRAME = 1,
+	U_TELEMETRY_TYPE_CLIENT_FRAME = 2,
+	U_TELEMETRY_TYPE_DEVICE_POSES = 3,
+};
+
+/*!
+ * A frame of the compositor from the compositor pacing, fields that the
+ * pacing helper in use doesn't know are zero.
+ *
+ * @ingroup aux_util
+ */
+struct u_telemetry_compositor_frame
+{
+	int64_t frame_id;
+	uint64_t predicted_display_time_ns;
+	uint64_t predicted_display_period_ns;
+	uint64_t desired_present_time_ns;
+	uint64_t actual_present_time_ns;
+	uint64_t when_predict_ns;
+	uint64_t when_woke_ns;
+	uint64_t when_began_ns;
+	uint64_t when_submitted_ns;
+	uint64_t present_margin_ns;
+	uint64_t present_slop_ns;
+};
+
+/*!
+ * A frame of a client session from the app pacing.
+ *
+ * @ingroup aux_util
+ */
+struct u_telemetry_client_frame
+{
+	int64_t session_id;
+	int64_t frame_id;
+	uint64_t predicted_display_time_ns;
+	uint64_t predicted_display_period_ns;
+	uint64_t display_time_ns;
+	uint64_t when_predicted_ns;
+	uint64_t when_wait_woke_ns;
+	uint64_t when_begin_ns;
+	uint64_t when_delivered_ns;
+	uint64_t when_gpu_done_ns;
+	uint32_t discarded;
+	uint32_t _padding;
+};
+
+/*!
+ * How often a device got new pose samples and was asked for poses over a
+ * period, about a second long.
+ *
+ * @ingroup aux_util
+ */
+struct u_telemetry_device_poses
+{
+	char device_name[64];
+	uint64_t period_ns;
+	uint64_t sample_count;
+	uint64_t query_count;
+	uint64_t predicted_count;
+	int64_t horizon_mean_ns;
+	int64_t sample_age_mean_ns;
+	int64_t sample_age_max_ns;
+};
+
+/*!
+ * One entry in the ring.
+ *
+ * The @p seq field is used as a sequence lock: it is odd while the entry is
+ * being written and `2 * (index + 1)` once entry `index` is complete.
+ *
+ * @ingroup aux_util
+ */
+struct u_telemetry_entry
+{
+	uint64_t seq;
+	uint32_t type;
+	uint32_t _padding;
+	uint64_t when_ns;
+
+	union {
+		struct u_telemetry_compositor_frame compositor_frame;
+		struct u_telemetry_client_frame client_frame;
+		struct u_telemetry_device_poses device_poses;
+	};
+};
+
+/*!
+ * The ring as laid out in shared memory, written by the service and only
+ * read by everybody else.
+ *
+ * @ingroup aux_util
+ */
+struct u_telemetry_ring
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t entry_count;
+	uint32_t entry_size;
+
+	//! Total number of entries ever started, the next one goes in this index modulo the count.
+	uint64_t write_index;
+
+	struct u_telemetry_entry entries[U_TELEMETRY_ENTRY_COUNT];
+};
+
+
+/*
+ *
+ * Writing functions.
+ *
+ */
+
+/*!
+ * Set up the ring in @p ring and make the push functions write to it once it
+ * has a subscriber, only one ring can be active per process.
+ *
+ * @ingroup aux_util
+ */
+void
+u_telemetry_init(struct u_telemetry_ring *ring);
+
+/*!
+ * Stop writing to the ring, it is not touched after this returns.
+ *
+ * @ingroup aux_util
+ */
+void
+u_telemetry_close(void);
+
+/*!
+ * Somebody started reading the ring, nothing is written to it while there
+ * are no readers. Callers keep track of their readers and must call
+ * @ref u_telemetry_remove_subscriber once for every call to this.
+ *
+ * @ingroup aux_util
+ */
+void
+u_telemetry_add_subscriber(void);
+
+/*!
+ * A reader added with @ref u_telemetry_add_subscriber is gone.
+ *
+ * @ingroup aux_util
+ */
+void
+u_telemetry_remove_subscriber(void);
+
+/*!
+ * Is there a ring to write to and somebody reading it, callers use this to
+ * skip gathering the data when not.
+ *
+ * @ingroup aux_util
+ */
+bool
+u_telemetry_is_active(void);
+
+/*!
+ * @ingroup aux_util
+ */
+void
+u_telemetry_push_compositor_frame(uint64_t when_ns, const struct u_telemetry_compositor_frame *frame);
+
+/*!
+ * @ingroup aux_util
+ */
+void
+u_telemetry_push_client_frame(uint64_t when_ns, const struct u_telemetry_client_frame *frame);
+
+/*!
+ * @ingroup aux_util
+ */
+void
+u_telemetry_push_device_poses(uint64_t when_ns, const struct u_telemetry_device_poses *poses);
+
+/*!
+ * Write an entry to @p ring, safe to call from multiple threads at once.
+ *
+ * @ingroup aux_util
+ */
+void
+u_telemetry_ring_push(struct u_telemetry_ring *ring, const struct u_telemetry_entry *entry);
+
+
+/*
+ *
+ * Reading functions.
+ *
+ */
+
+/*!
+ * Is @p ring set up and of a version that this code can read.
+ *
+ * @ingroup aux_util
+ */
+bool
+u_telemetry_ring_is_valid(const struct u_telemetry_ring *ring);
+
+/*!
+ * Index to start reading from to only get entries written after this call.
+ *
+ * @ingroup aux_util
+ */
+uint64_t
+u_telemetry_ring_get_write_index(const struct u_telemetry_ring *ring);
+
+/*!
+ * Copy out the entries written since @p read_index, which is advanced past
+ * the entries read and any that were overwritten before they could be read.
+ * Never blocks the writers, an entry that is still being written ends the
+ * read and is returned on the next call.
+ *
+ * @param      ring          The ring, may be mapped read-only.
+ * @param[in,out] read_index Index of the next entry to read.
+ * @param[out] out_entries   Array to copy the entries to.
+ * @param      capacity      Size of @p out_entries.
+ * @param[out] out_dropped   Number of entries lost to overwriting, optional.
+ *
+ * @return Number of entries copied.
+ *
+ * @ingroup aux_util
+ */
+uint32_t
+u_telemetry_ring_read(const struct u_telemetry_ring *ring,
+                      uint64_t *read_index,
+                      struct u_telemetry_entry *out_entries,
+                      uint32_t capacity,
+                      uint64_t *out_dropped);
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -14,6 +14,10 @@
 #include "util/u_worker.h"
 #include "util/u_trace_marker.h"
 
+#ifdef XRT_OS_LINUX
+#include "util/u_linux.h"
+#endif
+
 
 #define MAX_TASK_COUNT (64)
 #define MAX_THREAD_COUNT (16)
@@ -344,6 +348,10 @@ run_func(void *ptr)
 	snprintf(t->name, sizeof(t->name), "%s: Worker", p->prefix);
 	U_TRACE_SET_THREAD_NAME(t->name);
 
+#ifdef XRT_OS_LINUX
+	u_linux_thread_class_apply(OS_THREAD_CLASS_WORKER, U_LOGGING_WARN, t->name);
+#endif
+
 	os_mutex_lock(&p->mutex);
 
 	while (p->running) {
@@ -1424,6 +1424,22 @@ vk_csci_get_image_external_support(struct vk_bundle *vk,
 XRT_CHECK_RESULT bool
 vk_can_import_and_export_timeline_semaphore(struct vk_bundle *vk);
 
+/*!
+ * @brief Creates a Vulkan fence and submits it to the default VkQueue with no
+ * work attached to it.
+ *
+ * The fence signals once all work submitted to the queue before this call has
+ * completed, which makes it a non-blocking alternative to vkQueueWaitIdle for
+ * finding out when resources used by earlier submissions can be destroyed.
+ * The caller owns the returned fence.
+ *
+ * In case of error, out_fence is not touched by the function.
+ *
+ * @ingroup aux_vk
+ */
+XRT_CHECK_RESULT VkResult
+vk_create_and_submit_fence(struct vk_bundle *vk, VkFence *out_fence);
+
 /*!
  * @brief Creates a Vulkan fence, submits it to the default VkQueue and return
  * its native graphics sync handle.
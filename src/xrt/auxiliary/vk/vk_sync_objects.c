@@ -15,6 +15,7 @@
 #include "util/u_debug.h"
 
 #include "vk/vk_helpers.h"
+#include "vk/vk_cmd.h"
 
 
 /*
@@ -101,6 +102,40 @@ vk_can_import_and_export_timeline_semaphore(struct vk_bundle *vk)
  *
  */
 
+XRT_CHECK_RESULT VkResult
+vk_create_and_submit_fence(struct vk_bundle *vk, VkFence *out_fence)
+{
+	VkFence fence = VK_NULL_HANDLE;
+	VkResult ret;
+
+	VkFenceCreateInfo create_info = {
+	    .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+	    .flags = 0, // Not signalled.
+	};
+
+	ret = vk->vkCreateFence(vk->device, &create_info, NULL, &fence);
+	if (ret != VK_SUCCESS) {
+		VK_ERROR(vk, "vkCreateFence: %s", vk_result_string(ret));
+		return ret;
+	}
+
+	VK_NAME_OBJECT(vk, FENCE, fence, "VK Create Submit Fence");
+
+	/*
+	 * A fence signal operation from vkQueueSubmit includes all commands
+	 * that occur earlier in submission order, so no work is needed.
+	 */
+	ret = vk_cmd_submit_locked(vk, 0, NULL, fence);
+	if (ret != VK_SUCCESS) {
+		vk->vkDestroyFence(vk->device, fence, NULL);
+		return ret;
+	}
+
+	*out_fence = fence;
+
+	return VK_SUCCESS;
+}
+
 XRT_CHECK_RESULT VkResult
 vk_create_and_submit_fence_native(struct vk_bundle *vk, xrt_graphics_sync_handle_t *out_native)
 {
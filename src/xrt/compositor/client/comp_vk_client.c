@@ -241,19 +241,13 @@ submit_fallback(struct client_vk_compositor *c, xrt_result_t *out_xret)
  */
 
 static void
-client_vk_swapchain_destroy(struct xrt_swapchain *xsc)
+really_destroy(struct client_vk_swapchain *sc)
 {
-	COMP_TRACE_MARKER();
+	struct vk_bundle *vk = &sc->c->vk;
 
-	struct client_vk_swapchain *sc = client_vk_swapchain(xsc);
-	struct client_vk_compositor *c = sc->c;
-	struct vk_bundle *vk = &c->vk;
-
-	// Make sure images are not used anymore.
-	if (BREAK_OPENXR_SPEC_IN_DESTROY_SWAPCHAIN) {
-		os_mutex_lock(&vk->queue_mutex);
-		vk->vkQueueWaitIdle(vk->queue);
-		os_mutex_unlock(&vk->queue_mutex);
+	if (sc->retire_fence != VK_NULL_HANDLE) {
+		vk->vkDestroyFence(vk->device, sc->retire_fence, NULL);
+		sc->retire_fence = VK_NULL_HANDLE;
 	}
 
 	for (uint32_t i = 0; i < sc->base.base.image_count; i++) {
@@ -274,6 +268,82 @@ client_vk_swapchain_destroy(struct xrt_swapchain *xsc)
 	free(sc);
 }
 
+/*!
+ * Frees the retired swapchains whose fence has signalled, never waits.
+ *
+ * @private @memberof client_vk_compositor
+ */
+static void
+collect_retired_swapchains(struct client_vk_compositor *c)
+{
+	struct vk_bundle *vk = &c->vk;
+	struct client_vk_swapchain *sc;
+
+	os_mutex_lock(&c->retired.mutex);
+
+	// Fences submitted in order to the same queue signal in order.
+	while ((sc = c->retired.head) != NULL) {
+		if (sc->retire_fence != VK_NULL_HANDLE) {
+			VkResult ret = vk->vkGetFenceStatus(vk->device, sc->retire_fence);
+			if (ret == VK_NOT_READY) {
+				break;
+			}
+			if (ret != VK_SUCCESS) {
+				VK_ERROR(vk, "vkGetFenceStatus: %s", vk_result_string(ret));
+			}
+		}
+
+		c->retired.head = sc->retired_next;
+		if (c->retired.head == NULL) {
+			c->retired.tail = NULL;
+		}
+
+		really_destroy(sc);
+	}
+
+	os_mutex_unlock(&c->retired.mutex);
+}
+
+static void
+client_vk_swapchain_destroy(struct xrt_swapchain *xsc)
+{
+	COMP_TRACE_MARKER();
+
+	struct client_vk_swapchain *sc = client_vk_swapchain(xsc);
+	struct client_vk_compositor *c = sc->c;
+	struct vk_bundle *vk = &c->vk;
+
+	if (!BREAK_OPENXR_SPEC_IN_DESTROY_SWAPCHAIN) {
+		really_destroy(sc);
+		return;
+	}
+
+	/*
+	 * Make sure images are not used anymore, instead of waiting for the
+	 * queue to go idle, submit a fence that signals once all work the app
+	 * has submitted so far is done and free the images once it has.
+	 */
+	VkResult ret = vk_create_and_submit_fence(vk, &sc->retire_fence);
+	if (ret != VK_SUCCESS) {
+		os_mutex_lock(&vk->queue_mutex);
+		vk->vkQueueWaitIdle(vk->queue);
+		os_mutex_unlock(&vk->queue_mutex);
+		sc->retire_fence = VK_NULL_HANDLE;
+	}
+
+	os_mutex_lock(&c->retired.mutex);
+	sc->retired_next = NULL;
+	if (c->retired.tail != NULL) {
+		c->retired.tail->retired_next = sc;
+	} else {
+		c->retired.head = sc;
+	}
+	c->retired.tail = sc;
+	os_mutex_unlock(&c->retired.mutex);
+
+	collect_retired_swapchains(c);
+}
+
 static xrt_result_t
 client_vk_swapchain_acquire_image(struct xrt_swapchain *xsc, uint32_t *out_index)
 {
@@ -374,6 +444,11 @@ client_vk_compositor_destroy(struct xrt_compositor *xc)
 	vk->vkQueueWaitIdle(vk->queue);
 	os_mutex_unlock(&vk->queue_mutex);
 
+	// The queue is idle so all retire fences have signalled.
+	collect_retired_swapchains(c);
+	assert(c->retired.head == NULL);
+	os_mutex_destroy(&c->retired.mutex);
+
 	// Now safe to free the pool.
 	vk_cmd_pool_destroy(vk, &c->pool);
 
@@ -578,6 +653,9 @@ client_vk_compositor_layer_commit(struct xrt_compositor *xc, xrt_graphics_sync_h
 
 	struct client_vk_compositor *c = client_vk_compositor(xc);
 
+	// Once per frame is often enough to free destroyed swapchains.
+	collect_retired_swapchains(c);
+
 	xrt_result_t xret = XRT_SUCCESS;
 	if (submit_handle(c, sync_handle, &xret)) {
 		return xret;
@@ -827,17 +905,23 @@ client_vk_compositor_create(struct xrt_compositor_native *xcn,
 		goto err_mutex;
 	}
 
+	if (os_mutex_init(&c->retired.mutex) != 0) {
+		goto err_pool;
+	}
+
 #ifdef VK_KHR_timeline_semaphore
 	if (vk_can_import_and_export_timeline_semaphore(&c->vk)) {
 		xret = setup_semaphore(c);
 		if (xret != XRT_SUCCESS) {
-			goto err_pool;
+			goto err_retired;
 		}
 	}
 #endif
 
 	return c;
 
+err_retired:
+	os_mutex_destroy(&c->retired.mutex);
 err_pool:
 	vk_cmd_pool_destroy(&c->vk, &c->pool);
 err_mutex:
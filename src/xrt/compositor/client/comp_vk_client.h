@@ -51,6 +51,12 @@ struct client_vk_swapchain
 	// Prerecorded swapchain image ownership/layout transition barriers
 	VkCommandBuffer acquire[XRT_MAX_SWAPCHAIN_IMAGES];
 	VkCommandBuffer release[XRT_MAX_SWAPCHAIN_IMAGES];
+
+	//! Signalled when the app's queue is done with the images, set when destroyed.
+	VkFence retire_fence;
+
+	//! Next (newer) swapchain waiting on its retire fence.
+	struct client_vk_swapchain *retired_next;
 };
 
 /*!
@@ -78,6 +84,16 @@ struct client_vk_compositor
 	struct vk_bundle vk;
 
 	struct vk_cmd_pool pool;
+
+	/*!
+	 * Destroyed swapchains whose images might still be used by work the
+	 * app has submitted, oldest first, freed once their fence signals.
+	 */
+	struct
+	{
+		struct os_mutex mutex;
+		struct client_vk_swapchain *head, *tail;
+	} retired;
 };
 
 
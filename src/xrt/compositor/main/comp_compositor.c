@@ -1166,6 +1166,7 @@ comp_main_create_system_compositor(struct xrt_device *xdev,
 
 	u_var_add_ro_f32(c, &c->compositor_frame_times.fps, "FPS (Compositor)");
 	u_var_add_bool(c, &c->debug.atw_off, "Debug: ATW OFF");
+	u_var_add_bool(c, &c->settings.depth_reprojection, "Depth reprojection (compute)");
 	u_var_add_f32_timing(c, c->compositor_frame_times.debug_var, "Frame Times (Compositor)");
 
 
@@ -1105,6 +1105,7 @@ dispatch_compute(struct comp_renderer *r, struct render_compute *crc)
 	uint32_t layer_count = c->base.slot.layer_count;
 	bool fast_path = c->base.slot.one_projection_layer_fast_path;
 	bool do_timewarp = !c->debug.atw_off;
+	bool do_depth_reprojection = c->settings.depth_reprojection;
 
 	// Device view information.
 	struct xrt_fov fovs[2]; // Unused
@@ -1134,7 +1135,8 @@ dispatch_compute(struct comp_renderer *r, struct render_compute *crc)
 	    target_image_view,        // target_image_view
 	    views,                    // views
 	    fast_path,                // fast_path
-	    do_timewarp);             // do_timewarp
+	    do_timewarp,              // do_timewarp
+	    do_depth_reprojection);   // do_depth_reprojection
 
 	render_compute_end(crc);
 
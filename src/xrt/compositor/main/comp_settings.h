@@ -50,6 +50,9 @@ struct comp_settings
 
 	bool use_compute;
 
+	//! Reproject layers with depth using the full pose change, compute only.
+	bool depth_reprojection;
+
 	VkFormat color_format;
 	VkColorSpaceKHR color_space;
 	VkPresentModeKHR present_mode;
@@ -144,81 +144,27 @@ drain_events(struct multi_compositor *mc)
 
 /*
  *
- * Wait helper thread.
+ * Scheduling helpers.
  *
  */
 
 static bool
-is_pushed_or_waiting_locked(struct multi_compositor *mc)
-{
-	return mc->wait_thread.waiting ||     //
-	       mc->wait_thread.xcf != NULL || //
-	       mc->wait_thread.xcsem != NULL; //
-}
-
-static void
-wait_fence(struct xrt_compositor_fence **xcf_ptr)
+can_schedule_progress(struct multi_compositor *mc)
 {
 	COMP_TRACE_MARKER();
-	xrt_result_t ret = XRT_SUCCESS;
-
-	// 100ms
-	uint64_t timeout_ns = 100 * U_TIME_1MS_IN_NS;
-
-	do {
-		ret = xrt_compositor_fence_wait(*xcf_ptr, timeout_ns);
-		if (ret != XRT_TIMEOUT) {
-			break;
-		}
-
-		U_LOG_W("Waiting on client fence timed out > 100ms!");
-	} while (true);
 
-	xrt_compositor_fence_destroy(xcf_ptr);
-
-	if (ret != XRT_SUCCESS) {
-		U_LOG_E("Fence waiting failed!");
-	}
-}
-
-static void
-wait_semaphore(struct xrt_compositor_semaphore **xcsem_ptr, uint64_t value)
-{
-	COMP_TRACE_MARKER();
-	xrt_result_t ret = XRT_SUCCESS;
+	os_mutex_lock(&mc->slot_lock);
 
-	// 100ms
-	uint64_t timeout_ns = 100 * U_TIME_1MS_IN_NS;
+	struct multi_compositor volatile *v_mc = mc;
+	uint64_t now_ns = os_monotonic_get_ns();
+	bool is_free = true;
 
 	do {
-		ret = xrt_compositor_semaphore_wait(*xcsem_ptr, value, timeout_ns);
-		if (ret != XRT_TIMEOUT) {
+		// Nothing there, free to schedule.
+		if (!v_mc->scheduled.active) {
 			break;
 		}
 
-		U_LOG_W("Waiting on client semaphore value '%" PRIu64 "' timed out > 100ms!", value);
-	} while (true);
-
-	xrt_compositor_semaphore_reference(xcsem_ptr, NULL);
-
-	if (ret != XRT_SUCCESS) {
-		U_LOG_E("Semaphore waiting failed!");
-	}
-}
-
-static void
-wait_for_scheduled_free(struct multi_compositor *mc)
-{
-	COMP_TRACE_MARKER();
-
-	os_mutex_lock(&mc->slot_lock);
-
-	struct multi_compositor volatile *v_mc = mc;
-
-	// Block here if the scheduled slot is not clear.
-	while (v_mc->scheduled.active) {
-		uint64_t now_ns = os_monotonic_get_ns();
-
 		// This frame is for the next frame, drop the old one no matter what.
 		if (time_is_within_half_ms(mc->progress.data.display_time_ns, mc->slot_next_frame_display)) {
 			U_LOG_W("%.3fms: Dropping old missed frame in favour for completed new frame",
@@ -247,188 +193,25 @@ wait_for_scheduled_free(struct multi_compositor *mc)
 		    time_ns_to_ms_f((int64_t)v_mc->scheduled.data.display_time_ns - now_ns), //
 		    v_mc->scheduled.data.display_time_ns);                                   //
 
-		os_mutex_unlock(&mc->slot_lock);
-
-		os_precise_sleeper_nanosleep(&mc->scheduled_sleeper, U_TIME_1MS_IN_NS);
-
-		os_mutex_lock(&mc->slot_lock);
-	}
+		is_free = false;
+	} while (false); // Goto without the labels.
 
 	os_mutex_unlock(&mc->slot_lock);
 
-	/*
-	 * Need to take list_and_timing_lock before slot_lock because slot_lock
-	 * is taken in multi_compositor_deliver_any_frames with list_and_timing_lock
-	 * held to stop clients from going away.
-	 */
-	os_mutex_lock(&mc->msc->list_and_timing_lock);
-	os_mutex_lock(&mc->slot_lock);
-	slot_move_and_clear_locked(mc, &mc->scheduled, &mc->progress);
-	os_mutex_unlock(&mc->slot_lock);
-	os_mutex_unlock(&mc->msc->list_and_timing_lock);
-}
-
-static void *
-run_func(void *ptr)
-{
-	struct multi_compositor *mc = (struct multi_compositor *)ptr;
-
-	U_TRACE_SET_THREAD_NAME("Multi Client Module: Waiter");
-	os_thread_helper_name(&mc->wait_thread.oth, "Multi Client Module: Waiter");
-
-	os_thread_helper_lock(&mc->wait_thread.oth);
-
-	// Signal the start function that we are enterting the loop.
-	mc->wait_thread.alive = true;
-	os_thread_helper_signal_locked(&mc->wait_thread.oth);
-
-	/*
-	 * One can view the layer_commit function and the wait thread as a
-	 * producer/consumer pair. This loop is the consumer side of that pair.
-	 * We look for either a fence or a semaphore on each loop, if none are
-	 * found we check if we are running then wait on the conditional
-	 * variable once again waiting to be signalled by the producer.
-	 */
-	while (os_thread_helper_is_running_locked(&mc->wait_thread.oth)) {
-		/*
-		 * Here we wait for the either a semaphore or a fence, if
-		 * neither has been set we wait/sleep here (again).
-		 */
-		if (mc->wait_thread.xcsem == NULL && mc->wait_thread.xcf == NULL) {
-			// Spurious wakeups are handled below.
-			os_thread_helper_wait_locked(&mc->wait_thread.oth);
-			// Fall through here on stopping to clean up and outstanding waits.
-		}
-
-		int64_t frame_id = mc->wait_thread.frame_id;
-		struct xrt_compositor_fence *xcf = mc->wait_thread.xcf;
-		struct xrt_compositor_semaphore *xcsem = mc->wait_thread.xcsem; // No need to ref, a move.
-		uint64_t value = mc->wait_thread.value;
-
-		// Ok to clear these on spurious wakeup as they are empty then anyways.
-		mc->wait_thread.frame_id = 0;
-		mc->wait_thread.xcf = NULL;
-		mc->wait_thread.xcsem = NULL;
-		mc->wait_thread.value = 0;
-
-		// We are being stopped, or a spurious wakeup, loop back and check running.
-		if (xcf == NULL && xcsem == NULL) {
-			continue;
-		}
-
-		// We now know that we should wait.
-		mc->wait_thread.waiting = true;
-
-		os_thread_helper_unlock(&mc->wait_thread.oth);
-
-		if (xcsem != NULL) {
-			wait_semaphore(&xcsem, value);
-		}
-		if (xcf != NULL) {
-			wait_fence(&xcf);
-		}
-
-		// Sample time outside of lock.
-		uint64_t now_ns = os_monotonic_get_ns();
-
-		os_mutex_lock(&mc->msc->list_and_timing_lock);
-		u_pa_mark_gpu_done(mc->upa, frame_id, now_ns);
-		os_mutex_unlock(&mc->msc->list_and_timing_lock);
-
-		// Wait for the delivery slot.
-		wait_for_scheduled_free(mc);
-
-		os_thread_helper_lock(&mc->wait_thread.oth);
-
-		/*
-		 * Finally no longer waiting, this must be done after
-		 * wait_for_scheduled_free because it moves the slots/layers
-		 * from progress to scheduled to be picked up by the compositor.
-		 */
-		mc->wait_thread.waiting = false;
-
-		if (mc->wait_thread.blocked) {
-			// Release one thread
-			mc->wait_thread.blocked = false;
-			os_thread_helper_signal_locked(&mc->wait_thread.oth);
-		}
-	}
-
-	os_thread_helper_unlock(&mc->wait_thread.oth);
-
-	return NULL;
+	return is_free;
 }
 
 static void
-wait_for_wait_thread_locked(struct multi_compositor *mc)
+wait_for_scheduled_free(struct multi_compositor *mc)
 {
-	// Should we wait for the last frame.
-	if (is_pushed_or_waiting_locked(mc)) {
-		COMP_TRACE_IDENT(blocked);
-
-		// There should only be one thread entering here.
-		assert(mc->wait_thread.blocked == false);
+	COMP_TRACE_MARKER();
 
-		// OK, wait until the wait thread releases us by setting blocked to false
-		mc->wait_thread.blocked = true;
-		while (mc->wait_thread.blocked) {
-			os_thread_helper_wait_locked(&mc->wait_thread.oth);
-		}
+	// Block here if the scheduled slot is not clear.
+	while (!multi_compositor_try_schedule_progress(mc)) {
+		os_precise_sleeper_nanosleep(&mc->scheduled_sleeper, U_TIME_1MS_IN_NS);
 	}
 }
 
-static void
-wait_for_wait_thread(struct multi_compositor *mc)
-{
-	os_thread_helper_lock(&mc->wait_thread.oth);
-
-	wait_for_wait_thread_locked(mc);
-
-	os_thread_helper_unlock(&mc->wait_thread.oth);
-}
-
-static void
-push_fence_to_wait_thread(struct multi_compositor *mc, int64_t frame_id, struct xrt_compositor_fence *xcf)
-{
-	os_thread_helper_lock(&mc->wait_thread.oth);
-
-	// The function begin_layer should have waited, but just in case.
-	assert(!mc->wait_thread.waiting);
-	wait_for_wait_thread_locked(mc);
-
-	assert(mc->wait_thread.xcf == NULL);
-
-	mc->wait_thread.frame_id = frame_id;
-	mc->wait_thread.xcf = xcf;
-
-	os_thread_helper_signal_locked(&mc->wait_thread.oth);
-
-	os_thread_helper_unlock(&mc->wait_thread.oth);
-}
-
-static void
-push_semaphore_to_wait_thread(struct multi_compositor *mc,
-                              int64_t frame_id,
-                              struct xrt_compositor_semaphore *xcsem,
-                              uint64_t value)
-{
-	os_thread_helper_lock(&mc->wait_thread.oth);
-
-	// The function begin_layer should have waited, but just in case.
-	assert(!mc->wait_thread.waiting);
-	wait_for_wait_thread_locked(mc);
-
-	assert(mc->wait_thread.xcsem == NULL);
-
-	mc->wait_thread.frame_id = frame_id;
-	xrt_compositor_semaphore_reference(&mc->wait_thread.xcsem, xcsem);
-	mc->wait_thread.value = value;
-
-	os_thread_helper_signal_locked(&mc->wait_thread.oth);
-
-	os_thread_helper_unlock(&mc->wait_thread.oth);
-}
-
 
 /*
  *
@@ -457,7 +240,7 @@ multi_compositor_create_swapchain(struct xrt_compositor *xc,
 
 	struct multi_compositor *mc = multi_compositor(xc);
 
-	return xrt_comp_create_swapchain(&mc->msc->xcn->base, info, out_xsc);
+	return xrt_comp_native_create_client_swapchain(mc->msc->xcn, mc->client_id, info, out_xsc);
 }
 
 static xrt_result_t
@@ -670,7 +453,7 @@ multi_compositor_layer_begin(struct xrt_compositor *xc, const struct xrt_layer_f
 	 * the GPU for this frame. This should have very little impact on GPU
 	 * utilisation, if any.
 	 */
-	wait_for_wait_thread(mc);
+	multi_waiter_wait_for_client(&mc->msc->waiter, mc);
 
 	assert(mc->progress.layer_count == 0);
 	U_ZERO(&mc->progress);
@@ -816,6 +599,13 @@ multi_compositor_layer_commit(struct xrt_compositor *xc, xrt_graphics_sync_handl
 			break;
 		}
 
+#ifdef MULTI_WAITER_USE_EPOLL
+		// Poll the sync file directly, no need to import it.
+		if (multi_waiter_push_sync_handle(&mc->msc->waiter, mc, frame_id, sync_handle)) {
+			return XRT_SUCCESS;
+		}
+#endif
+
 		xrt_result_t xret = xrt_comp_import_fence( //
 		    &mc->msc->xcn->base,                   //
 		    sync_handle,                           //
@@ -833,7 +623,7 @@ multi_compositor_layer_commit(struct xrt_compositor *xc, xrt_graphics_sync_handl
 	} while (false); // Goto without the labels.
 
 	if (xcf != NULL) {
-		push_fence_to_wait_thread(mc, frame_id, xcf);
+		multi_waiter_push_fence(&mc->msc->waiter, mc, frame_id, xcf);
 	} else {
 		// Assume that the app side compositor waited.
 		uint64_t now_ns = os_monotonic_get_ns();
@@ -858,7 +648,7 @@ multi_compositor_layer_commit_with_semaphore(struct xrt_compositor *xc,
 	struct multi_compositor *mc = multi_compositor(xc);
 	int64_t frame_id = mc->progress.data.frame_id;
 
-	push_semaphore_to_wait_thread(mc, frame_id, xcsem, value);
+	multi_waiter_push_semaphore(&mc->msc->waiter, mc, frame_id, xcsem, value);
 
 	return XRT_SUCCESS;
 }
@@ -894,6 +684,9 @@ multi_compositor_destroy(struct xrt_compositor *xc)
 		mc->state.session_active = false;
 	}
 
+	// Let the waiter finish with the last frame, the render thread still picks it up.
+	multi_waiter_wait_for_client(&mc->msc->waiter, mc);
+
 	os_mutex_lock(&mc->msc->list_and_timing_lock);
 
 	// Remove it from the list of clients.
@@ -907,9 +700,6 @@ multi_compositor_destroy(struct xrt_compositor *xc)
 
 	drain_events(mc);
 
-	// Destroy the wait thread, destroy also stops the thread.
-	os_thread_helper_destroy(&mc->wait_thread.oth);
-
 	// We are now off the rendering list, clear slots for any swapchains.
 	os_mutex_lock(&mc->msc->list_and_timing_lock);
 	slot_clear_locked(mc, &mc->progress);
@@ -917,12 +707,16 @@ multi_compositor_destroy(struct xrt_compositor *xc)
 	slot_clear_locked(mc, &mc->delivered);
 	os_mutex_unlock(&mc->msc->list_and_timing_lock);
 
+	// No more swapchains will be created by this client.
+	xrt_comp_native_release_client(mc->msc->xcn, mc->client_id);
+
 	// Does null checking.
 	u_pa_destroy(&mc->upa);
 
 	os_precise_sleeper_deinit(&mc->frame_sleeper);
 	os_precise_sleeper_deinit(&mc->scheduled_sleeper);
 
+	os_cond_destroy(&mc->wait.cond);
 	os_mutex_destroy(&mc->slot_lock);
 	os_mutex_destroy(&mc->event.mutex);
 
@@ -970,6 +764,27 @@ multi_compositor_latch_frame_locked(struct multi_compositor *mc, uint64_t when_n
 	u_pa_latched(mc->upa, mc->delivered.data.frame_id, when_ns, system_frame_id);
 }
 
+bool
+multi_compositor_try_schedule_progress(struct multi_compositor *mc)
+{
+	if (!can_schedule_progress(mc)) {
+		return false;
+	}
+
+	/*
+	 * Need to take list_and_timing_lock before slot_lock because slot_lock
+	 * is taken in multi_compositor_deliver_any_frames with list_and_timing_lock
+	 * held to stop clients from going away.
+	 */
+	os_mutex_lock(&mc->msc->list_and_timing_lock);
+	os_mutex_lock(&mc->slot_lock);
+	slot_move_and_clear_locked(mc, &mc->scheduled, &mc->progress);
+	os_mutex_unlock(&mc->slot_lock);
+	os_mutex_unlock(&mc->msc->list_and_timing_lock);
+
+	return true;
+}
+
 void
 multi_compositor_retire_delivered_locked(struct multi_compositor *mc, uint64_t when_ns)
 {
@@ -1015,7 +830,10 @@ multi_compositor_create(struct multi_system_compositor *msc,
 
 	os_mutex_init(&mc->event.mutex);
 	os_mutex_init(&mc->slot_lock);
-	os_thread_helper_init(&mc->wait_thread.oth);
+	os_cond_init(&mc->wait.cond);
+#ifdef MULTI_WAITER_USE_EPOLL
+	mc->wait.sync_fd = -1;
+#endif
 
 	// Passthrough our formats from the native compositor to the client.
 	mc->base.base.info = msc->xcn->base.info;
@@ -1031,6 +849,9 @@ multi_compositor_create(struct multi_system_compositor *msc,
 
 	os_mutex_lock(&msc->list_and_timing_lock);
 
+	// Never reused, so swapchain allocations are never shared between clients.
+	mc->client_id = ++msc->last_client_id;
+
 	// If we have too many clients, just ignore it.
 	for (size_t i = 0; i < MULTI_MAX_CLIENTS; i++) {
 		if (mc->msc->clients[i] != NULL) {
@@ -1048,19 +869,6 @@ multi_compositor_create(struct multi_system_compositor *msc,
 
 	os_mutex_unlock(&msc->list_and_timing_lock);
 
-	// Last start the wait thread.
-	os_thread_helper_start(&mc->wait_thread.oth, run_func, mc);
-
-	os_thread_helper_lock(&mc->wait_thread.oth);
-
-	// Wait for the wait thread to fully start.
-	while (!mc->wait_thread.alive) {
-		os_thread_helper_wait_locked(&mc->wait_thread.oth);
-	}
-
-	os_thread_helper_unlock(&mc->wait_thread.oth);
-
-
 	*out_xcn = &mc->base;
 
 	return XRT_SUCCESS;
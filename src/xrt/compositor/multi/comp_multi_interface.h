@@ -23,7 +23,7 @@ struct u_pacing_app_factory;
  * Create a "system compositor" that can handle multiple clients (each
  * through a "multi compositor") and that drives a single native compositor.
  * Both the native compositor and the pacing factory is owned by the system
- * compositor and destroyed by it.
+ * compositor and destroyed by it, also if this fails.
  *
  * @param xcn           Native compositor that client are multi-plexed to.
  * @param upaf          App pacing factory, one pacer created per client.
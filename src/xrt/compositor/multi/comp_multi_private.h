@@ -11,6 +11,7 @@
 
 #include "xrt/xrt_compiler.h"
 #include "xrt/xrt_defines.h"
+#include "xrt/xrt_config_os.h"
 #include "xrt/xrt_compositor.h"
 
 #include "os/os_time.h"
@@ -26,6 +27,11 @@ extern "C" {
 #define MULTI_MAX_CLIENTS 64
 #define MULTI_MAX_LAYERS 16
 
+#if defined(XRT_OS_LINUX) && defined(XRT_GRAPHICS_SYNC_HANDLE_IS_FD)
+//! Sync files are pollable, so the waiter can use epoll for them.
+#define MULTI_WAITER_USE_EPOLL
+#endif
+
 
 /*
  *
@@ -123,8 +129,23 @@ struct multi_compositor
 		bool session_active;
 	} state;
 
+	/*!
+	 * The GPU work of the last committed frame, waited on by the shared
+	 * @ref multi_waiter, protected by multi_waiter::mutex.
+	 */
 	struct
 	{
+#ifdef MULTI_WAITER_USE_EPOLL
+		//! Sync file polled directly by the waiter, -1 if not used.
+		int sync_fd;
+#endif
+
+		//! Set when @p sync_fd, @p xcf or @p xcsem has signalled.
+		bool signalled;
+
+		//! Result of waiting on @p xcf or @p xcsem.
+		xrt_result_t result;
+
 		//! Fence to wait for.
 		struct xrt_compositor_fence *xcf;
 
@@ -137,23 +158,26 @@ struct multi_compositor
 		//! Frame id of frame being waited on.
 		int64_t frame_id;
 
-		//! The wait thread itself
-		struct os_thread_helper oth;
+		//! When we last warned about the wait, or when it started.
+		uint64_t warn_ns;
 
-		//! Have we gotten to the loop?
-		bool alive;
+		//! The GPU work is done, waiting for the scheduled slot to be free.
+		bool gpu_done;
 
-		//! Is the thread waiting, if so the client should block.
+		//! Is the frame being waited on, if so the client should block.
 		bool waiting;
 
 		/*!
 		 * Is the client thread blocked?
 		 *
 		 * Set to true by the client thread,
-		 * cleared by the wait thread to release the client thread.
+		 * cleared by the waiter to release the client thread.
 		 */
 		bool blocked;
-	} wait_thread;
+
+		//! Signalled by the waiter to release the client thread.
+		struct os_cond cond;
+	} wait;
 
 	//! Lock for all of the slots.
 	struct os_mutex slot_lock;
@@ -179,6 +203,9 @@ struct multi_compositor
 	struct multi_layer_slot delivered;
 
 	struct u_pacing_app *upa;
+
+	//! Id given to the native compositor when creating swapchains, unique per client.
+	uint64_t client_id;
 };
 
 static inline struct multi_compositor *
@@ -226,6 +253,17 @@ multi_compositor_deliver_any_frames(struct multi_compositor *mc, uint64_t displa
 void
 multi_compositor_latch_frame_locked(struct multi_compositor *mc, uint64_t when_ns, int64_t system_frame_id);
 
+/*!
+ * Moves the progress slot into the scheduled slot if the scheduled slot is
+ * free or holds a frame that can be dropped, returns false if it has to wait.
+ * Called by the waiter once the GPU work of the frame has completed.
+ *
+ * @ingroup comp_multi
+ * @private @memberof multi_compositor
+ */
+bool
+multi_compositor_try_schedule_progress(struct multi_compositor *mc);
+
 /*!
  * Clears and retires the delivered frame, called by the render thread.
  * The list_and_timing_lock is held when this function is called.
@@ -237,6 +275,124 @@ void
 multi_compositor_retire_delivered_locked(struct multi_compositor *mc, uint64_t when_ns);
 
 
+/*
+ *
+ * Waiter
+ *
+ */
+
+/*!
+ * Waits on the GPU work of all clients' committed frames on a single thread,
+ * marks them GPU done in batches and moves them to the scheduled slots.
+ *
+ * Sync files are polled with epoll where available. Fences and semaphores of
+ * all clients are waited on together, in short slices so that new frames and
+ * sync files are picked up too.
+ *
+ * @ingroup comp_multi
+ */
+struct multi_waiter
+{
+	//! Owning system compositor.
+	struct multi_system_compositor *msc;
+
+	//! The waiter thread.
+	struct os_thread thread;
+
+	//! Protects this struct and multi_compositor::wait of all clients.
+	struct os_mutex mutex;
+
+	//! Wakes up the thread when there is nothing to wait on.
+	struct os_cond cond;
+
+	//! Cleared to stop the thread.
+	bool running;
+
+	//! Clients with a frame being waited on.
+	struct multi_compositor *clients[MULTI_MAX_CLIENTS];
+	uint32_t client_count;
+
+#ifdef MULTI_WAITER_USE_EPOLL
+	//! Epoll set of all sync files and the event fd.
+	int epoll_fd;
+
+	//! Wakes up the thread when something it needs to look at changes.
+	int event_fd;
+#else
+	//! Wakes up the thread when something it needs to look at changes.
+	struct os_semaphore wake_up;
+#endif
+};
+
+/*!
+ * Init the waiter and start its thread.
+ *
+ * @ingroup comp_multi
+ * @public @memberof multi_waiter
+ */
+xrt_result_t
+multi_waiter_init(struct multi_waiter *mw, struct multi_system_compositor *msc);
+
+/*!
+ * Stop the thread and free all resources, all clients must be gone.
+ *
+ * @ingroup comp_multi
+ * @public @memberof multi_waiter
+ */
+void
+multi_waiter_fini(struct multi_waiter *mw);
+
+/*!
+ * Blocks the calling client thread until the last pushed frame of the client
+ * has completed its GPU work and has been moved to the scheduled slot.
+ *
+ * @ingroup comp_multi
+ * @public @memberof multi_waiter
+ */
+void
+multi_waiter_wait_for_client(struct multi_waiter *mw, struct multi_compositor *mc);
+
+#ifdef MULTI_WAITER_USE_EPOLL
+/*!
+ * Wait on the given sync file directly, takes ownership of @p handle on
+ * success. Returns false if it can not be polled, the caller still owns it.
+ *
+ * @ingroup comp_multi
+ * @public @memberof multi_waiter
+ */
+bool
+multi_waiter_push_sync_handle(struct multi_waiter *mw,
+                              struct multi_compositor *mc,
+                              int64_t frame_id,
+                              xrt_graphics_sync_handle_t handle);
+#endif
+
+/*!
+ * Wait on the given fence, takes ownership of @p xcf.
+ *
+ * @ingroup comp_multi
+ * @public @memberof multi_waiter
+ */
+void
+multi_waiter_push_fence(struct multi_waiter *mw,
+                        struct multi_compositor *mc,
+                        int64_t frame_id,
+                        struct xrt_compositor_fence *xcf);
+
+/*!
+ * Wait on the given semaphore to reach @p value, takes a reference.
+ *
+ * @ingroup comp_multi
+ * @public @memberof multi_waiter
+ */
+void
+multi_waiter_push_semaphore(struct multi_waiter *mw,
+                            struct multi_compositor *mc,
+                            int64_t frame_id,
+                            struct xrt_compositor_semaphore *xcsem,
+                            uint64_t value);
+
+
 /*
  *
  * Multi-client-capable system compositor
@@ -315,6 +471,9 @@ struct multi_system_compositor
 	//! Render loop thread.
 	struct os_thread_helper oth;
 
+	//! Shared thread waiting on the GPU work of all clients.
+	struct multi_waiter waiter;
+
 	struct
 	{
 		/*!
@@ -343,6 +502,9 @@ struct multi_system_compositor
 	} last_timings;
 
 	struct multi_compositor *clients[MULTI_MAX_CLIENTS];
+
+	//! Last id given to a client, protected by list_and_timing_lock.
+	uint64_t last_client_id;
 };
 
 /*!
@@ -432,8 +432,8 @@ multi_main_loop(struct multi_system_compositor *msc)
 	os_thread_helper_name(&msc->oth, "Multi Client Module");
 
 #ifdef XRT_OS_LINUX
-	// Try to raise priority of this thread.
-	u_linux_try_to_set_realtime_priority_on_thread(U_LOGGING_INFO, "Multi Client Module");
+	// Policy and CPUs from the config, raises priority by default.
+	u_linux_thread_class_apply(OS_THREAD_CLASS_COMPOSITOR, U_LOGGING_INFO, "Multi Client Module");
 #endif
 
 	struct xrt_compositor *xc = &msc->xcn->base;
@@ -656,6 +656,9 @@ system_compositor_destroy(struct xrt_system_compositor *xsc)
 	// Destroy the render thread first, destroy also stops the thread.
 	os_thread_helper_destroy(&msc->oth);
 
+	// All clients are gone, stop the waiter.
+	multi_waiter_fini(&msc->waiter);
+
 	u_paf_destroy(&msc->upaf);
 
 	xrt_comp_native_destroy(&msc->xcn);
@@ -666,6 +669,20 @@ system_compositor_destroy(struct xrt_system_compositor *xsc)
 }
 
 
+//! Used on the error paths before any of the threads have been started.
+static void
+destroy_on_error(struct multi_system_compositor *msc)
+{
+	// Owned by us even when we fail.
+	u_paf_destroy(&msc->upaf);
+	xrt_comp_native_destroy(&msc->xcn);
+
+	os_mutex_destroy(&msc->list_and_timing_lock);
+
+	free(msc);
+}
+
+
 /*
  *
  * 'Exported' functions.
@@ -721,8 +738,16 @@ comp_multi_create_system_compositor(struct xrt_compositor_native *xcn,
 	msc->last_timings.predicted_display_period_ns = U_TIME_1MS_IN_NS * 16; // Just a wild guess.
 	msc->last_timings.diff_ns = U_TIME_1MS_IN_NS * 5;                      // Make sure it's not zero at least.
 
+	xrt_result_t xret = multi_waiter_init(&msc->waiter, msc);
+	if (xret != XRT_SUCCESS) {
+		destroy_on_error(msc);
+		return xret;
+	}
+
 	int ret = os_thread_helper_init(&msc->oth);
 	if (ret < 0) {
+		multi_waiter_fini(&msc->waiter);
+		destroy_on_error(msc);
 		return XRT_ERROR_THREADING_INIT_FAILURE;
 	}
 
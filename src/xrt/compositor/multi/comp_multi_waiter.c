@@ -0,0 +1,641 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Shared thread waiting on the GPU work of all multi clients.
+ * @author agent <agent@local>
+ * @ingroup comp_multi
+ */
+
+#include "os/os_time.h"
+#include "os/os_threading.h"
+
+#include "util/u_misc.h"
+#include "util/u_time.h"
+#include "util/u_logging.h"
+#include "util/u_trace_marker.h"
+
+#ifdef XRT_OS_LINUX
+#include "util/u_linux.h"
+#endif
+
+#include "multi/comp_multi_private.h"
+
+#include <assert.h>
+#include <inttypes.h>
+
+#ifdef MULTI_WAITER_USE_EPOLL
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+
+/*
+ *
+ * Defines.
+ *
+ */
+
+//! How long to wait before retrying frames whose scheduled slot was occupied.
+#define RETRY_INTERVAL_NS (U_TIME_1MS_IN_NS)
+
+//! Warn about GPU work that has been going on for longer then this.
+#define WARN_TIMEOUT_NS (100 * U_TIME_1MS_IN_NS)
+
+/*!
+ * Longest a wait on fences and semaphores blocks, they can't be waited on
+ * together with sync files or new frames so this bounds how late those are.
+ */
+#define SYNC_SLICE_NS (U_TIME_1MS_IN_NS)
+
+/*!
+ * Fences and semaphores of all clients gathered for one wait. The client owns
+ * them until they have signalled, so they can be used without the lock.
+ */
+struct waiter_syncs
+{
+	struct multi_compositor *fence_clients[MULTI_MAX_CLIENTS];
+	struct xrt_compositor_fence *xcfs[MULTI_MAX_CLIENTS];
+	xrt_result_t fence_results[MULTI_MAX_CLIENTS];
+	uint32_t fence_count;
+
+	struct multi_compositor *semaphore_clients[MULTI_MAX_CLIENTS];
+	struct xrt_compositor_semaphore *xcsems[MULTI_MAX_CLIENTS];
+	uint64_t values[MULTI_MAX_CLIENTS];
+	xrt_result_t semaphore_results[MULTI_MAX_CLIENTS];
+	uint32_t semaphore_count;
+};
+
+
+/*
+ *
+ * Helpers.
+ *
+ */
+
+//! Are there frames whose GPU work is done but couldn't be scheduled yet.
+static bool
+needs_retry_locked(struct multi_waiter *mw)
+{
+	for (uint32_t i = 0; i < mw->client_count; i++) {
+		if (mw->clients[i]->wait.gpu_done) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void
+wake_up_locked(struct multi_waiter *mw)
+{
+	os_cond_signal(&mw->cond);
+
+	// Cut any wait short, something changed.
+#ifdef MULTI_WAITER_USE_EPOLL
+	uint64_t one = 1;
+	ssize_t ret = write(mw->event_fd, &one, sizeof(one));
+	(void)ret; // Only fails if the counter is already huge.
+#else
+	os_semaphore_release(&mw->wake_up);
+#endif
+}
+
+static void
+wait_for_client_locked(struct multi_waiter *mw, struct multi_compositor *mc)
+{
+	if (!mc->wait.waiting) {
+		return;
+	}
+
+	COMP_TRACE_IDENT(blocked);
+
+	// There should only be one thread entering here.
+	assert(mc->wait.blocked == false);
+
+	// OK, wait until the waiter releases us by setting blocked to false.
+	mc->wait.blocked = true;
+	while (mc->wait.blocked) {
+		os_cond_wait(&mc->wait.cond, &mw->mutex);
+	}
+}
+
+static void
+push_locked(struct multi_waiter *mw, struct multi_compositor *mc, int64_t frame_id)
+{
+	assert(!mc->wait.waiting);
+	assert(!mc->wait.gpu_done);
+	assert(mw->client_count < ARRAY_SIZE(mw->clients));
+
+	mc->wait.frame_id = frame_id;
+	mc->wait.warn_ns = os_monotonic_get_ns();
+	mc->wait.waiting = true;
+
+	mw->clients[mw->client_count++] = mc;
+
+	wake_up_locked(mw);
+}
+
+static void
+release_client_locked(struct multi_waiter *mw, struct multi_compositor *mc)
+{
+	for (uint32_t i = 0; i < mw->client_count; i++) {
+		if (mw->clients[i] != mc) {
+			continue;
+		}
+
+		// Order doesn't matter, move the last one here.
+		mw->clients[i] = mw->clients[--mw->client_count];
+		mw->clients[mw->client_count] = NULL;
+		break;
+	}
+
+	mc->wait.frame_id = 0;
+	mc->wait.gpu_done = false;
+	mc->wait.waiting = false;
+
+	if (mc->wait.blocked) {
+		// Release the client thread.
+		mc->wait.blocked = false;
+		os_cond_signal(&mc->wait.cond);
+	}
+}
+
+/*!
+ * Checks if the GPU work of the client is done, cleaning up the sync object
+ * if it is. Errors are logged and treated as done, nothing more can be done.
+ */
+static bool
+check_gpu_done_locked(struct multi_waiter *mw, struct multi_compositor *mc)
+{
+#ifdef MULTI_WAITER_USE_EPOLL
+	if (mc->wait.sync_fd >= 0) {
+		if (!mc->wait.signalled) {
+			return false;
+		}
+
+		epoll_ctl(mw->epoll_fd, EPOLL_CTL_DEL, mc->wait.sync_fd, NULL);
+		close(mc->wait.sync_fd);
+		mc->wait.sync_fd = -1;
+		mc->wait.signalled = false;
+
+		return true;
+	}
+#endif
+
+	if (mc->wait.xcf != NULL || mc->wait.xcsem != NULL) {
+		if (!mc->wait.signalled) {
+			return false;
+		}
+
+		if (mc->wait.result != XRT_SUCCESS) {
+			U_LOG_E("%s waiting failed!", mc->wait.xcf != NULL ? "Fence" : "Semaphore");
+		}
+
+		xrt_compositor_fence_destroy(&mc->wait.xcf);
+		xrt_compositor_semaphore_reference(&mc->wait.xcsem, NULL);
+		mc->wait.value = 0;
+		mc->wait.signalled = false;
+	}
+
+	return true;
+}
+
+static void
+gather_syncs_locked(struct multi_waiter *mw, struct waiter_syncs *syncs)
+{
+	syncs->fence_count = 0;
+	syncs->semaphore_count = 0;
+
+	for (uint32_t i = 0; i < mw->client_count; i++) {
+		struct multi_compositor *mc = mw->clients[i];
+
+		if (mc->wait.gpu_done || mc->wait.signalled) {
+			continue;
+		}
+
+		if (mc->wait.xcf != NULL) {
+			uint32_t k = syncs->fence_count++;
+			syncs->fence_clients[k] = mc;
+			syncs->xcfs[k] = mc->wait.xcf;
+		} else if (mc->wait.xcsem != NULL) {
+			uint32_t k = syncs->semaphore_count++;
+			syncs->semaphore_clients[k] = mc;
+			syncs->xcsems[k] = mc->wait.xcsem;
+			syncs->values[k] = mc->wait.value;
+		}
+	}
+}
+
+//! Checks each gathered fence and semaphore without blocking.
+static void
+check_syncs(struct waiter_syncs *syncs)
+{
+	for (uint32_t i = 0; i < syncs->fence_count; i++) {
+		syncs->fence_results[i] = xrt_compositor_fence_wait(syncs->xcfs[i], 0);
+	}
+
+	for (uint32_t i = 0; i < syncs->semaphore_count; i++) {
+		syncs->semaphore_results[i] = xrt_compositor_semaphore_wait(syncs->xcsems[i], syncs->values[i], 0);
+	}
+}
+
+//! Errors also count as signalled, they are reported when cleaning up.
+static void
+apply_syncs_locked(struct waiter_syncs *syncs)
+{
+	for (uint32_t i = 0; i < syncs->fence_count; i++) {
+		if (syncs->fence_results[i] != XRT_TIMEOUT) {
+			syncs->fence_clients[i]->wait.result = syncs->fence_results[i];
+			syncs->fence_clients[i]->wait.signalled = true;
+		}
+	}
+
+	for (uint32_t i = 0; i < syncs->semaphore_count; i++) {
+		if (syncs->semaphore_results[i] != XRT_TIMEOUT) {
+			syncs->semaphore_clients[i]->wait.result = syncs->semaphore_results[i];
+			syncs->semaphore_clients[i]->wait.signalled = true;
+		}
+	}
+}
+
+/*!
+ * Sleeps until any sync object signals, the timeout expires or we are woken
+ * up. With fences or semaphores pending it only blocks for a short slice.
+ */
+static void
+wait_for_any(struct multi_waiter *mw, bool retry, struct waiter_syncs *syncs)
+{
+	COMP_TRACE_MARKER();
+
+	uint64_t timeout_ns = retry ? RETRY_INTERVAL_NS : WARN_TIMEOUT_NS;
+
+	if (syncs->fence_count > 0 || syncs->semaphore_count > 0) {
+		if (timeout_ns > SYNC_SLICE_NS) {
+			timeout_ns = SYNC_SLICE_NS;
+		}
+
+		// Results are ignored, each one is checked afterwards.
+		if (syncs->semaphore_count > 0) {
+			xrt_compositor_semaphore_wait_any( //
+			    syncs->xcsems,                 //
+			    syncs->values,                 //
+			    syncs->semaphore_count,        //
+			    timeout_ns);                   //
+		}
+
+		// The slice has been used up by the semaphores if there were any.
+		if (syncs->fence_count > 0) {
+			uint64_t fence_timeout_ns = syncs->semaphore_count > 0 ? 0 : timeout_ns;
+			xrt_compositor_fence_wait_any(syncs->xcfs, syncs->fence_count, fence_timeout_ns);
+		}
+
+		// Only pick up sync files and wake ups that are already there.
+		timeout_ns = 0;
+	}
+
+#ifdef MULTI_WAITER_USE_EPOLL
+	struct epoll_event events[MULTI_MAX_CLIENTS + 1];
+	int timeout_ms = (int)(timeout_ns / U_TIME_1MS_IN_NS);
+
+	int count = epoll_wait(mw->epoll_fd, events, ARRAY_SIZE(events), timeout_ms);
+	if (count < 0) {
+		if (errno != EINTR) {
+			U_LOG_E("epoll_wait: %s", strerror(errno));
+		}
+		return;
+	}
+
+	os_mutex_lock(&mw->mutex);
+
+	for (int i = 0; i < count; i++) {
+		struct multi_compositor *mc = (struct multi_compositor *)events[i].data.ptr;
+
+		// The event fd, just drain it.
+		if (mc == NULL) {
+			uint64_t value = 0;
+			ssize_t ret = read(mw->event_fd, &value, sizeof(value));
+			(void)ret;
+			continue;
+		}
+
+		// Errors also count, they are reported by the sync file.
+		mc->wait.signalled = true;
+	}
+
+	os_mutex_unlock(&mw->mutex);
+#else
+	// Zero waits forever, spurious wake ups from skipping it are handled by looping.
+	if (timeout_ns > 0) {
+		os_semaphore_wait(&mw->wake_up, timeout_ns);
+	}
+#endif
+}
+
+static void
+mark_gpu_done(struct multi_waiter *mw, struct multi_compositor **done, uint32_t done_count, uint64_t now_ns)
+{
+	if (done_count == 0) {
+		return;
+	}
+
+	COMP_TRACE_MARKER();
+
+	// One lock for all of them instead of one per client.
+	os_mutex_lock(&mw->msc->list_and_timing_lock);
+
+	for (uint32_t i = 0; i < done_count; i++) {
+		// The client is blocked from pushing a new frame, safe to read.
+		u_pa_mark_gpu_done(done[i]->upa, done[i]->wait.frame_id, now_ns);
+	}
+
+	os_mutex_unlock(&mw->msc->list_and_timing_lock);
+}
+
+
+/*
+ *
+ * Thread.
+ *
+ */
+
+static void *
+run_func(void *ptr)
+{
+	struct multi_waiter *mw = (struct multi_waiter *)ptr;
+
+	U_TRACE_SET_THREAD_NAME("Multi Client Module: Waiter");
+	os_thread_name(&mw->thread, "Multi Client Module: Waiter");
+
+#ifdef XRT_OS_LINUX
+	// Timestamps GPU completion for pacing, so same class as the render loop.
+	u_linux_thread_class_apply(OS_THREAD_CLASS_COMPOSITOR, U_LOGGING_INFO, "Multi Client Module: Waiter");
+#endif
+
+	struct multi_compositor *done[MULTI_MAX_CLIENTS];
+	struct multi_compositor *ready[MULTI_MAX_CLIENTS];
+	bool scheduled[MULTI_MAX_CLIENTS];
+	struct waiter_syncs syncs;
+
+	os_mutex_lock(&mw->mutex);
+
+	/*
+	 * One can view the layer_commit functions of all clients and this
+	 * thread as a producer/consumer pair. Each loop we wait for any sync
+	 * object to signal, then mark all completed frames as GPU done in one
+	 * go and try to move them to the scheduled slot. Frames whose
+	 * scheduled slot is still occupied are retried on the next loop.
+	 */
+	while (mw->running) {
+		if (mw->client_count == 0) {
+			// Spurious wakeups are handled by looping.
+			os_cond_wait(&mw->cond, &mw->mutex);
+			continue;
+		}
+
+		bool retry = needs_retry_locked(mw);
+		gather_syncs_locked(mw, &syncs);
+
+		os_mutex_unlock(&mw->mutex);
+
+		wait_for_any(mw, retry, &syncs);
+		check_syncs(&syncs);
+
+		// Sample time once, as close to the wakeup as possible.
+		uint64_t now_ns = os_monotonic_get_ns();
+		uint32_t done_count = 0;
+		uint32_t ready_count = 0;
+
+		os_mutex_lock(&mw->mutex);
+
+		apply_syncs_locked(&syncs);
+
+		for (uint32_t i = 0; i < mw->client_count; i++) {
+			struct multi_compositor *mc = mw->clients[i];
+
+			if (!mc->wait.gpu_done && check_gpu_done_locked(mw, mc)) {
+				mc->wait.gpu_done = true;
+				done[done_count++] = mc;
+			} else if (!mc->wait.gpu_done && now_ns - mc->wait.warn_ns > WARN_TIMEOUT_NS) {
+				U_LOG_W("Waiting on client frame %" PRIi64 " timed out > 100ms!", mc->wait.frame_id);
+				mc->wait.warn_ns = now_ns;
+			}
+
+			if (mc->wait.gpu_done) {
+				ready[ready_count++] = mc;
+			}
+		}
+
+		// Clients with a frame waiting can't go away, safe to use without our lock.
+		os_mutex_unlock(&mw->mutex);
+
+		mark_gpu_done(mw, done, done_count, now_ns);
+
+		for (uint32_t i = 0; i < ready_count; i++) {
+			scheduled[i] = multi_compositor_try_schedule_progress(ready[i]);
+		}
+
+		os_mutex_lock(&mw->mutex);
+
+		/*
+		 * Finally no longer waiting, this must be done after the frame
+		 * has been moved from the progress slot to the scheduled slot,
+		 * to be picked up by the compositor.
+		 */
+		for (uint32_t i = 0; i < ready_count; i++) {
+			if (scheduled[i]) {
+				release_client_locked(mw, ready[i]);
+			}
+		}
+	}
+
+	os_mutex_unlock(&mw->mutex);
+
+	return NULL;
+}
+
+
+/*
+ *
+ * 'Exported' functions.
+ *
+ */
+
+xrt_result_t
+multi_waiter_init(struct multi_waiter *mw, struct multi_system_compositor *msc)
+{
+	U_ZERO(mw);
+	mw->msc = msc;
+
+#ifdef MULTI_WAITER_USE_EPOLL
+	mw->epoll_fd = -1;
+	mw->event_fd = -1;
+
+	mw->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (mw->epoll_fd < 0) {
+		U_LOG_E("epoll_create1: %s", strerror(errno));
+		return XRT_ERROR_THREADING_INIT_FAILURE;
+	}
+
+	mw->event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (mw->event_fd < 0) {
+		U_LOG_E("eventfd: %s", strerror(errno));
+		close(mw->epoll_fd);
+		return XRT_ERROR_THREADING_INIT_FAILURE;
+	}
+
+	// A NULL pointer marks the event fd.
+	struct epoll_event ev = {.events = EPOLLIN, .data.ptr = NULL};
+	if (epoll_ctl(mw->epoll_fd, EPOLL_CTL_ADD, mw->event_fd, &ev) < 0) {
+		U_LOG_E("epoll_ctl: %s", strerror(errno));
+		close(mw->event_fd);
+		close(mw->epoll_fd);
+		return XRT_ERROR_THREADING_INIT_FAILURE;
+	}
+#endif
+
+	os_mutex_init(&mw->mutex);
+	os_cond_init(&mw->cond);
+	os_thread_init(&mw->thread);
+#ifndef MULTI_WAITER_USE_EPOLL
+	os_semaphore_init(&mw->wake_up, 0);
+#endif
+
+	mw->running = true;
+
+	int ret = os_thread_start(&mw->thread, run_func, mw);
+	if (ret != 0) {
+		U_LOG_E("Failed to start waiter thread!");
+		mw->running = false;
+		multi_waiter_fini(mw);
+		return XRT_ERROR_THREADING_INIT_FAILURE;
+	}
+
+	return XRT_SUCCESS;
+}
+
+void
+multi_waiter_fini(struct multi_waiter *mw)
+{
+	os_mutex_lock(&mw->mutex);
+	bool was_running = mw->running;
+	mw->running = false;
+	wake_up_locked(mw);
+	os_mutex_unlock(&mw->mutex);
+
+	if (was_running) {
+		os_thread_join(&mw->thread);
+	}
+
+	// All clients should have been destroyed, and waited on, before this.
+	assert(mw->client_count == 0);
+
+	os_thread_destroy(&mw->thread);
+	os_cond_destroy(&mw->cond);
+	os_mutex_destroy(&mw->mutex);
+
+#ifdef MULTI_WAITER_USE_EPOLL
+	close(mw->event_fd);
+	close(mw->epoll_fd);
+	mw->event_fd = -1;
+	mw->epoll_fd = -1;
+#else
+	os_semaphore_destroy(&mw->wake_up);
+#endif
+}
+
+void
+multi_waiter_wait_for_client(struct multi_waiter *mw, struct multi_compositor *mc)
+{
+	os_mutex_lock(&mw->mutex);
+
+	wait_for_client_locked(mw, mc);
+
+	os_mutex_unlock(&mw->mutex);
+}
+
+#ifdef MULTI_WAITER_USE_EPOLL
+bool
+multi_waiter_push_sync_handle(struct multi_waiter *mw,
+                              struct multi_compositor *mc,
+                              int64_t frame_id,
+                              xrt_graphics_sync_handle_t handle)
+{
+	os_mutex_lock(&mw->mutex);
+
+	// The function begin_layer should have waited, but just in case.
+	assert(!mc->wait.waiting);
+	wait_for_client_locked(mw, mc);
+
+	assert(mc->wait.sync_fd < 0);
+
+	/*
+	 * Sync files become readable once signalled, anything that isn't
+	 * pollable fails here and the caller falls back to importing it.
+	 */
+	struct epoll_event ev = {.events = EPOLLIN, .data.ptr = mc};
+	if (epoll_ctl(mw->epoll_fd, EPOLL_CTL_ADD, handle, &ev) < 0) {
+		U_LOG_D("Can't poll sync handle, falling back to fence: %s", strerror(errno));
+		os_mutex_unlock(&mw->mutex);
+		return false;
+	}
+
+	mc->wait.sync_fd = handle;
+	mc->wait.signalled = false;
+
+	push_locked(mw, mc, frame_id);
+
+	os_mutex_unlock(&mw->mutex);
+
+	return true;
+}
+#endif
+
+void
+multi_waiter_push_fence(struct multi_waiter *mw,
+                        struct multi_compositor *mc,
+                        int64_t frame_id,
+                        struct xrt_compositor_fence *xcf)
+{
+	os_mutex_lock(&mw->mutex);
+
+	// The function begin_layer should have waited, but just in case.
+	assert(!mc->wait.waiting);
+	wait_for_client_locked(mw, mc);
+
+	assert(mc->wait.xcf == NULL);
+
+	mc->wait.xcf = xcf;
+	mc->wait.signalled = false;
+
+	push_locked(mw, mc, frame_id);
+
+	os_mutex_unlock(&mw->mutex);
+}
+
+void
+multi_waiter_push_semaphore(struct multi_waiter *mw,
+                            struct multi_compositor *mc,
+                            int64_t frame_id,
+                            struct xrt_compositor_semaphore *xcsem,
+                            uint64_t value)
+{
+	os_mutex_lock(&mw->mutex);
+
+	// The function begin_layer should have waited, but just in case.
+	assert(!mc->wait.waiting);
+	wait_for_client_locked(mw, mc);
+
+	assert(mc->wait.xcsem == NULL);
+
+	xrt_compositor_semaphore_reference(&mc->wait.xcsem, xcsem);
+	mc->wait.value = value;
+	mc->wait.signalled = false;
+
+	push_locked(mw, mc, frame_id);
+
+	os_mutex_unlock(&mw->mutex);
+}
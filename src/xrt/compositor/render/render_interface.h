@@ -95,6 +95,35 @@ render_calc_time_warp_matrix(const struct xrt_pose *src_pose,
                              const struct xrt_pose *new_pose,
                              struct xrt_matrix_4x4 *matrix);
 
+/*!
+ * Like @ref render_calc_time_warp_matrix but includes the change in position,
+ * it takes points in the new view space (not NDC coords) and gives out results
+ * in the [-1, 1] space of the source view that needs a perspective divide.
+ * Used to reproject layers with depth.
+ */
+void
+render_calc_reprojection_matrix(const struct xrt_pose *src_pose,
+                                 const struct xrt_fov *src_fov,
+                                 const struct xrt_pose *new_pose,
+                                 struct xrt_matrix_4x4 *matrix);
+
+/*!
+ * Calculates @p out_offset and @p out_scale so that the inverse view depth of
+ * a depth value is `1 / z = offset + scale * depth`, the arguments are the
+ * same as the fields of @ref xrt_layer_depth_data. Returns false if they are
+ * unusable.
+ *
+ * @param      min_depth  Depth value that maps to @p near_z.
+ * @param      max_depth  Depth value that maps to @p far_z.
+ * @param      near_z     View depth of @p min_depth, positive.
+ * @param      far_z      View depth of @p max_depth, positive and may be infinite.
+ * @param[out] out_offset Inverse depth at depth value zero.
+ * @param[out] out_scale  Change of inverse depth per depth value.
+ */
+bool
+render_calc_inverse_depth_params(
+    float min_depth, float max_depth, float near_z, float far_z, float *out_offset, float *out_scale);
+
 /*!
  * This function constructs a transformation in the form of a normalized rect
  * that lets you go from a UV coordinate on a projection plane to the a point on
@@ -107,8 +136,8 @@ render_calc_time_warp_matrix(const struct xrt_pose *src_pose,
  * `[0 .. 1]` to `[-1 .. 1]` the expected returns are `x = -1`, `y = -1`,
  * `w = 2` and `h = 2`.
  *
- * param      fov      The fov of the projection image.
- * param[out] out_rect Transformation from UV to tangent lengths.
+ * @param      fov      The fov of the projection image.
+ * @param[out] out_rect Transformation from UV to tangent lengths.
  */
 void
 render_calc_uv_to_tangent_lengths_rect(const struct xrt_fov *fov, struct xrt_normalized_rect *out_rect);
@@ -981,6 +1010,21 @@ struct render_compute_layer_ubo_data
 	//! Timewarp matrices
 	struct xrt_matrix_4x4 transforms[RENDER_MAX_LAYERS];
 
+	//! Positional reprojection matrices, only for layers with depth.
+	struct xrt_matrix_4x4 reprojections[RENDER_MAX_LAYERS];
+
+	//! Depth image sub image transform, like post_transforms.
+	struct xrt_normalized_rect depth_post_transforms[RENDER_MAX_LAYERS];
+
+	//! std140 vec4, inverse depth params and if reprojection is enabled.
+	struct
+	{
+		float inv_z_offset;
+		float inv_z_scale;
+		float enabled;
+		float padding;
+	} depth[RENDER_MAX_LAYERS];
+
 
 	/*!
 	 * For quad layers
@@ -8,6 +8,7 @@
  */
 
 #include "math/m_api.h"
+#include "math/m_mathinclude.h"
 #include "math/m_matrix_4x4_f64.h"
 
 #include "render/render_interface.h"
@@ -123,6 +124,65 @@ render_calc_time_warp_matrix(const struct xrt_pose *src_pose,
 	}
 }
 
+void
+render_calc_reprojection_matrix(const struct xrt_pose *src_pose,
+                                 const struct xrt_fov *src_fov,
+                                 const struct xrt_pose *new_pose,
+                                 struct xrt_matrix_4x4 *matrix)
+{
+	// Src projection matrix.
+	struct xrt_matrix_4x4_f64 src_proj;
+	calc_projection(src_fov, &src_proj);
+
+	// Unlike timewarp include the position, the pose of the new view in the src view's space.
+	struct xrt_pose src_pose_inv, new_in_src;
+	math_pose_invert(src_pose, &src_pose_inv);
+	math_pose_transform(&src_pose_inv, new_pose, &new_in_src);
+
+	// Takes points from the new view to the src view.
+	struct xrt_matrix_4x4_f64 new_to_src;
+	m_mat4_f64_orientation(&new_in_src.orientation, &new_to_src);
+	new_to_src.v[12] = new_in_src.position.x;
+	new_to_src.v[13] = new_in_src.position.y;
+	new_to_src.v[14] = new_in_src.position.z;
+
+	struct xrt_matrix_4x4_f64 result;
+	m_mat4_f64_multiply(&src_proj, &new_to_src, &result);
+
+	// Convert from f64 to f32.
+	for (int i = 0; i < 16; i++) {
+		matrix->v[i] = (float)result.v[i];
+	}
+}
+
+bool
+render_calc_inverse_depth_params(
+    float min_depth, float max_depth, float near_z, float far_z, float *out_offset, float *out_scale)
+{
+	const double range = (double)max_depth - (double)min_depth;
+
+	// Can't do anything sensible with these, also catches NaNs.
+	if (!(range > 0.0) || !(near_z > 0.0) || !(far_z > 0.0) || near_z == far_z) {
+		return false;
+	}
+
+	/*
+	 * Depth values from min_depth to max_depth maps to near_z to far_z,
+	 * works for reversed depth where far_z is smaller then near_z. In
+	 * perspective projections the inverse of the view depth is linear in
+	 * the depth value, with an infinite far_z giving zero.
+	 */
+	const double inv_near = 1.0 / (double)near_z;
+	const double inv_far = isinf(far_z) ? 0.0 : 1.0 / (double)far_z;
+	const double scale = (inv_far - inv_near) / range;
+	const double offset = inv_near - (double)min_depth * scale;
+
+	*out_offset = (float)offset;
+	*out_scale = (float)scale;
+
+	return true;
+}
+
 void
 render_calc_uv_to_tangent_lengths_rect(const struct xrt_fov *fov, struct xrt_normalized_rect *out_rect)
 {
@@ -70,7 +70,30 @@ base_create_swapchain(struct xrt_compositor *xc,
 	struct xrt_swapchain_create_properties xsccp = {0};
 	xrt_comp_get_swapchain_create_properties(xc, info, &xsccp);
 
-	return comp_swapchain_create(&cb->vk, &cb->cscs, info, &xsccp, out_xsc);
+	// Not tied to any client, so never pooled.
+	return comp_swapchain_create(&cb->vk, &cb->cscs, 0, info, &xsccp, out_xsc);
+}
+
+static xrt_result_t
+base_create_client_swapchain(struct xrt_compositor_native *xcn,
+                             uint64_t client_id,
+                             const struct xrt_swapchain_create_info *info,
+                             struct xrt_swapchain **out_xsc)
+{
+	struct comp_base *cb = comp_base(&xcn->base);
+
+	struct xrt_swapchain_create_properties xsccp = {0};
+	xrt_comp_get_swapchain_create_properties(&xcn->base, info, &xsccp);
+
+	return comp_swapchain_create(&cb->vk, &cb->cscs, client_id, info, &xsccp, out_xsc);
+}
+
+static void
+base_release_client(struct xrt_compositor_native *xcn, uint64_t client_id)
+{
+	struct comp_base *cb = comp_base(&xcn->base);
+
+	comp_image_pool_release_owner(&cb->cscs.image_pool, &cb->vk, client_id);
 }
 
 static xrt_result_t
@@ -252,6 +275,8 @@ comp_base_init(struct comp_base *cb)
 {
 	cb->base.base.get_swapchain_create_properties = base_get_swapchain_create_properties;
 	cb->base.base.create_swapchain = base_create_swapchain;
+	cb->base.create_client_swapchain = base_create_client_swapchain;
+	cb->base.release_client = base_release_client;
 	cb->base.base.import_swapchain = base_import_swapchain;
 	cb->base.base.create_semaphore = base_create_semaphore;
 	cb->base.base.import_fence = base_import_fence;
@@ -0,0 +1,315 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Pool that recycles swapchain image allocations.
+ * @author agent <agent@local>
+ * @ingroup comp_util
+ */
+
+#include "util/u_var.h"
+#include "util/u_misc.h"
+#include "util/u_debug.h"
+#include "util/u_logging.h"
+
+#include "util/comp_image_pool.h"
+
+#include <assert.h>
+#include <inttypes.h>
+
+
+DEBUG_GET_ONCE_NUM_OPTION(image_pool_mb, "XRT_COMPOSITOR_IMAGE_POOL_MB", 256)
+
+
+/*
+ *
+ * Helper functions.
+ *
+ */
+
+static bool
+info_matches(const struct xrt_swapchain_create_info *a, const struct xrt_swapchain_create_info *b)
+{
+	return a->create == b->create &&             //
+	       a->bits == b->bits &&                 //
+	       a->format == b->format &&             //
+	       a->sample_count == b->sample_count && //
+	       a->width == b->width &&               //
+	       a->height == b->height &&             //
+	       a->face_count == b->face_count &&     //
+	       a->array_size == b->array_size &&     //
+	       a->mip_count == b->mip_count;
+}
+
+static void
+free_image(struct vk_bundle *vk, const struct xrt_swapchain_create_info *info, struct vk_image *image)
+{
+	// Reuse the collection helper to destroy a single image.
+	struct vk_image_collection vkic = {
+	    .info = *info,
+	    .image_count = 1,
+	};
+	vkic.images[0] = *image;
+
+	vk_ic_destroy(vk, &vkic);
+
+	U_ZERO(image);
+}
+
+static void
+remove_entry_locked(struct comp_image_pool *pool, uint32_t index)
+{
+	struct comp_image_pool_entry *e = &pool->entries[index];
+
+	pool->stats.cached_bytes -= (uint64_t)e->image.size;
+	pool->stats.cached_images--;
+
+	// Order doesn't matter, move the last one into the hole.
+	pool->entry_count--;
+	if (index != pool->entry_count) {
+		*e = pool->entries[pool->entry_count];
+	}
+	U_ZERO(&pool->entries[pool->entry_count]);
+}
+
+static bool
+find_owner_locked(struct comp_image_pool *pool, uint64_t owner, uint32_t *out_index)
+{
+	for (uint32_t i = 0; i < pool->owner_count; i++) {
+		if (pool->owners[i] == owner) {
+			*out_index = i;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void
+track_owner_locked(struct comp_image_pool *pool, uint64_t owner)
+{
+	uint32_t index;
+	if (find_owner_locked(pool, owner, &index)) {
+		return;
+	}
+
+	// When full the owner's images are simply not pooled.
+	if (pool->owner_count >= COMP_IMAGE_POOL_MAX_OWNERS) {
+		return;
+	}
+
+	pool->owners[pool->owner_count++] = owner;
+}
+
+static bool
+take_locked(struct comp_image_pool *pool,
+            uint64_t owner,
+            const struct xrt_swapchain_create_info *info,
+            struct vk_image *out_image)
+{
+	// Take the newest matching image, the memory is most likely still hot.
+	int32_t best = -1;
+	for (uint32_t i = 0; i < pool->entry_count; i++) {
+		if (pool->entries[i].owner != owner) {
+			continue;
+		}
+		if (!info_matches(&pool->entries[i].info, info)) {
+			continue;
+		}
+		if (best < 0 || pool->entries[i].release_seq > pool->entries[best].release_seq) {
+			best = (int32_t)i;
+		}
+	}
+
+	if (best < 0) {
+		return false;
+	}
+
+	*out_image = pool->entries[best].image;
+	remove_entry_locked(pool, (uint32_t)best);
+
+	return true;
+}
+
+static void
+evict_oldest_locked(struct comp_image_pool *pool, struct vk_bundle *vk)
+{
+	uint32_t oldest = 0;
+	for (uint32_t i = 1; i < pool->entry_count; i++) {
+		if (pool->entries[i].release_seq < pool->entries[oldest].release_seq) {
+			oldest = i;
+		}
+	}
+
+	struct comp_image_pool_entry e = pool->entries[oldest];
+	remove_entry_locked(pool, oldest);
+	free_image(vk, &e.info, &e.image);
+
+	pool->stats.evictions++;
+}
+
+
+/*
+ *
+ * 'Exported' functions.
+ *
+ */
+
+int
+comp_image_pool_init(struct comp_image_pool *pool)
+{
+	int ret = os_mutex_init(&pool->mutex);
+	if (ret != 0) {
+		return ret;
+	}
+
+	long mb = debug_get_num_option_image_pool_mb();
+	pool->budget_bytes = mb > 0 ? (uint64_t)mb * 1024 * 1024 : 0;
+
+	u_var_add_root(pool, "Swapchain image pool", false);
+	u_var_add_ro_u64(pool, &pool->budget_bytes, "Budget (bytes)");
+	u_var_add_ro_u32(pool, &pool->stats.cached_images, "Cached images");
+	u_var_add_ro_u64(pool, &pool->stats.cached_bytes, "Cached (bytes)");
+	u_var_add_ro_u64(pool, &pool->stats.hits, "Hits");
+	u_var_add_ro_u64(pool, &pool->stats.misses, "Misses");
+	u_var_add_ro_u64(pool, &pool->stats.evictions, "Evictions");
+
+	return 0;
+}
+
+void
+comp_image_pool_destroy(struct comp_image_pool *pool, struct vk_bundle *vk)
+{
+	u_var_remove_root(pool);
+
+	for (uint32_t i = 0; i < pool->entry_count; i++) {
+		free_image(vk, &pool->entries[i].info, &pool->entries[i].image);
+	}
+
+	pool->entry_count = 0;
+	pool->owner_count = 0;
+	U_ZERO(&pool->stats);
+
+	os_mutex_destroy(&pool->mutex);
+}
+
+VkResult
+comp_image_pool_allocate(struct comp_image_pool *pool,
+                         struct vk_bundle *vk,
+                         uint64_t owner,
+                         const struct xrt_swapchain_create_info *xscci,
+                         uint32_t image_count,
+                         struct vk_image_collection *out_vkic)
+{
+	assert(owner != 0);
+
+	if (image_count > ARRAY_SIZE(out_vkic->images)) {
+		U_LOG_E("Too many images for vk_image_collection");
+		return VK_ERROR_OUT_OF_HOST_MEMORY;
+	}
+
+	uint32_t found = 0;
+
+	os_mutex_lock(&pool->mutex);
+	track_owner_locked(pool, owner);
+	while (found < image_count && take_locked(pool, owner, xscci, &out_vkic->images[found])) {
+		found++;
+	}
+	pool->stats.hits += found;
+	pool->stats.misses += image_count - found;
+	os_mutex_unlock(&pool->mutex);
+
+	// Allocate the rest, if any.
+	struct vk_image_collection fresh = {0};
+	if (found < image_count) {
+		VkResult ret = vk_ic_allocate(vk, xscci, image_count - found, &fresh);
+		if (ret != VK_SUCCESS) {
+			// Give back what we took.
+			out_vkic->info = *xscci;
+			out_vkic->image_count = found;
+			comp_image_pool_release(pool, vk, owner, out_vkic);
+			return ret;
+		}
+	}
+
+	for (uint32_t i = 0; i < fresh.image_count; i++) {
+		out_vkic->images[found + i] = fresh.images[i];
+	}
+
+	out_vkic->info = *xscci;
+	out_vkic->image_count = image_count;
+
+	return VK_SUCCESS;
+}
+
+void
+comp_image_pool_release(struct comp_image_pool *pool,
+                        struct vk_bundle *vk,
+                        uint64_t owner,
+                        struct vk_image_collection *vkic)
+{
+	os_mutex_lock(&pool->mutex);
+
+	uint32_t owner_index;
+	bool tracked = find_owner_locked(pool, owner, &owner_index);
+
+	for (uint32_t i = 0; i < vkic->image_count; i++) {
+		struct vk_image *image = &vkic->images[i];
+		uint64_t size = (uint64_t)image->size;
+
+		// Owner gone or not tracked, too big to ever fit, or pool disabled.
+		if (!tracked || size > pool->budget_bytes) {
+			free_image(vk, &vkic->info, image);
+			continue;
+		}
+
+		while (pool->entry_count > 0 && (pool->entry_count >= COMP_IMAGE_POOL_MAX_IMAGES ||
+		                                 pool->stats.cached_bytes + size > pool->budget_bytes)) {
+			evict_oldest_locked(pool, vk);
+		}
+
+		struct comp_image_pool_entry *e = &pool->entries[pool->entry_count++];
+		e->info = vkic->info;
+		e->image = *image;
+		e->owner = owner;
+		e->release_seq = pool->seq++;
+
+		pool->stats.cached_bytes += size;
+		pool->stats.cached_images++;
+
+		U_ZERO(image);
+	}
+
+	os_mutex_unlock(&pool->mutex);
+
+	vkic->image_count = 0;
+	U_ZERO(&vkic->info);
+}
+
+void
+comp_image_pool_release_owner(struct comp_image_pool *pool, struct vk_bundle *vk, uint64_t owner)
+{
+	os_mutex_lock(&pool->mutex);
+
+	uint32_t owner_index;
+	if (find_owner_locked(pool, owner, &owner_index)) {
+		pool->owner_count--;
+		pool->owners[owner_index] = pool->owners[pool->owner_count];
+		pool->owners[pool->owner_count] = 0;
+	}
+
+	uint32_t i = 0;
+	while (i < pool->entry_count) {
+		if (pool->entries[i].owner != owner) {
+			i++;
+			continue;
+		}
+
+		// Moves the last entry into i, so don't advance.
+		struct comp_image_pool_entry e = pool->entries[i];
+		remove_entry_locked(pool, i);
+		free_image(vk, &e.info, &e.image);
+	}
+
+	os_mutex_unlock(&pool->mutex);
+}
@@ -0,0 +1,165 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Pool that recycles swapchain image allocations.
+ * @author agent <agent@local>
+ * @ingroup comp_util
+ */
+
+#pragma once
+
+#include "os/os_threading.h"
+#include "vk/vk_image_allocator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*!
+ * Max number of images that are kept around in the pool.
+ *
+ * @ingroup comp_util
+ */
+#define COMP_IMAGE_POOL_MAX_IMAGES (32)
+
+/*!
+ * Max number of owners, clients, that can have images in the pool at once.
+ *
+ * @ingroup comp_util
+ */
+#define COMP_IMAGE_POOL_MAX_OWNERS (32)
+
+/*!
+ * A single cached image, with the info it was created from.
+ *
+ * @ingroup comp_util
+ */
+struct comp_image_pool_entry
+{
+	struct xrt_swapchain_create_info info;
+	struct vk_image image;
+
+	//! The owner that released the image, only it may take it again.
+	uint64_t owner;
+
+	//! When it was put into the pool, used to evict the oldest first.
+	uint64_t release_seq;
+};
+
+/*!
+ * Keeps images from destroyed swapchains around so that a swapchain created
+ * later with the same create info can reuse them instead of allocating new
+ * memory. Apps that use dynamic resolution or per-frame layer swapchains
+ * otherwise allocate and free large images all of the time, which adds
+ * latency and fragments memory.
+ *
+ * Only images that were allocated by the compositor are pooled, imported
+ * images are owned by somebody else. Images are only reused for an exact match
+ * of the create info, as the VkImage is reused and not just the memory. The
+ * total size of cached images is kept under @ref budget_bytes, the oldest ones
+ * are freed first.
+ *
+ * The memory of the images has been exported to a client, which can keep its
+ * import alive after destroying the swapchain. So images are tagged with an
+ * owner, normally a client of the system compositor, and are only handed back
+ * to that same owner. Owners are tracked from their first allocation until
+ * @ref comp_image_pool_release_owner, images released by an owner that isn't
+ * tracked are freed directly.
+ *
+ * Thread safe, all functions take @ref mutex.
+ *
+ * @ingroup comp_util
+ */
+struct comp_image_pool
+{
+	struct os_mutex mutex;
+
+	//! Cached images, unordered.
+	struct comp_image_pool_entry entries[COMP_IMAGE_POOL_MAX_IMAGES];
+	uint32_t entry_count;
+
+	//! Owners that may put images into the pool, unordered.
+	uint64_t owners[COMP_IMAGE_POOL_MAX_OWNERS];
+	uint32_t owner_count;
+
+	//! Counter for @ref comp_image_pool_entry::release_seq.
+	uint64_t seq;
+
+	//! Max number of bytes of images to keep around, zero disables the pool.
+	uint64_t budget_bytes;
+
+	struct
+	{
+		//! Number of images currently cached.
+		uint32_t cached_images;
+		//! Size of images currently cached.
+		uint64_t cached_bytes;
+		//! Number of images handed out from the pool.
+		uint64_t hits;
+		//! Number of images that had to be allocated.
+		uint64_t misses;
+		//! Number of images freed to stay under the budget.
+		uint64_t evictions;
+	} stats;
+};
+
+/*!
+ * Init the pool and add it to the debug UI, the budget is read from the
+ * `XRT_COMPOSITOR_IMAGE_POOL_MB` environment variable.
+ *
+ * @public @memberof comp_image_pool
+ */
+XRT_CHECK_RESULT int
+comp_image_pool_init(struct comp_image_pool *pool);
+
+/*!
+ * Free all cached images and de-init the pool.
+ *
+ * @public @memberof comp_image_pool
+ */
+void
+comp_image_pool_destroy(struct comp_image_pool *pool, struct vk_bundle *vk);
+
+/*!
+ * Same as @ref vk_ic_allocate but takes matching images released by @p owner
+ * from the pool first, only allocating the ones that are missing.
+ *
+ * @param owner Non-zero id of the owner, see @ref comp_image_pool.
+ *
+ * @public @memberof comp_image_pool
+ */
+VkResult
+comp_image_pool_allocate(struct comp_image_pool *pool,
+                         struct vk_bundle *vk,
+                         uint64_t owner,
+                         const struct xrt_swapchain_create_info *xscci,
+                         uint32_t image_count,
+                         struct vk_image_collection *out_vkic);
+
+/*!
+ * Same as @ref vk_ic_destroy but gives the images to the pool, the GPU must be
+ * done using the images.
+ *
+ * @public @memberof comp_image_pool
+ */
+void
+comp_image_pool_release(struct comp_image_pool *pool,
+                        struct vk_bundle *vk,
+                        uint64_t owner,
+                        struct vk_image_collection *vkic);
+
+/*!
+ * The @p owner is gone, free all of its images in the pool and stop tracking
+ * it, any of its images released after this are freed directly.
+ *
+ * @public @memberof comp_image_pool
+ */
+void
+comp_image_pool_release_owner(struct comp_image_pool *pool, struct vk_bundle *vk, uint64_t owner);
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -154,6 +154,7 @@ do_projection_layer(const struct xrt_layer_data *data,
                     VkImageView src_image_views[RENDER_MAX_IMAGES],
                     struct render_compute_layer_ubo_data *ubo_data,
                     bool do_timewarp,
+                    bool do_depth_reprojection,
                     uint32_t *out_cur_image)
 {
 	const struct xrt_layer_projection_view_data *vd = NULL;
@@ -200,6 +201,35 @@ do_projection_layer(const struct xrt_layer_data *data,
 		    &ubo_data->transforms[cur_layer]); //
 	}
 
+	// Positional reprojection if we have usable depth, otherwise just timewarp.
+	bool reproject = false;
+	if (do_timewarp && do_depth_reprojection && dvd != NULL) {
+		reproject = render_calc_inverse_depth_params( //
+		    dvd->min_depth,                           //
+		    dvd->max_depth,                           //
+		    dvd->near_z,                              //
+		    dvd->far_z,                               //
+		    &ubo_data->depth[cur_layer].inv_z_offset, //
+		    &ubo_data->depth[cur_layer].inv_z_scale); //
+	}
+
+	if (reproject) {
+		render_calc_reprojection_matrix(          //
+		    &vd->pose,                            //
+		    &vd->fov,                             //
+		    world_pose,                           //
+		    &ubo_data->reprojections[cur_layer]); //
+
+		// The depth image has its own sub-image rect.
+		set_post_transform_rect(                          //
+		    data,                                         // data
+		    &dvd->sub.norm_rect,                          // src_norm_rect
+		    false,                                        // invert_flip
+		    &ubo_data->depth_post_transforms[cur_layer]); // out_norm_rect
+	}
+
+	ubo_data->depth[cur_layer].enabled = reproject ? 1.0f : 0.0f;
+
 	*out_cur_image = cur_image;
 }
 
@@ -412,7 +442,8 @@ comp_render_layer(struct render_compute *crc,
                   const VkImage target_image,
                   const VkImageView target_image_view,
                   const struct render_viewport_data *target_view,
-                  bool do_timewarp)
+                  bool do_timewarp,
+                  bool do_depth_reprojection)
 {
 	VkSampler clamp_to_edge = crc->r->samplers.clamp_to_edge;
 	VkSampler clamp_to_border_black = crc->r->samplers.clamp_to_border_black;
@@ -484,6 +515,7 @@ comp_render_layer(struct render_compute *crc,
 			    src_image_views,       // src_image_views
 			    ubo_data,              // ubo_data
 			    do_timewarp,           // do_timewarp
+			    do_depth_reprojection, // do_depth_reprojection
 			    &cur_image);           // out_cur_image
 		} break;
 		case XRT_LAYER_QUAD: {
@@ -555,7 +587,8 @@ comp_render_stereo_layers(struct render_compute *crc,
                           const VkImageView target_image_views[2],
                           const struct render_viewport_data target_views[2],
                           VkImageLayout transition_to,
-                          bool do_timewarp)
+                          bool do_timewarp,
+                          bool do_depth_reprojection)
 {
 	VkImageSubresourceRange first_color_level_subresource_range = {
 	    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
@@ -599,7 +632,8 @@ comp_render_stereo_layers(struct render_compute *crc,
 		    target_images[view_index],      //
 		    target_image_views[view_index], //
 		    &target_views[view_index],      //
-		    do_timewarp);                   //
+		    do_timewarp,                    //
+		    do_depth_reprojection);         //
 	}
 
 	vk_cmd_image_barrier_locked(              //
@@ -638,7 +672,8 @@ comp_render_stereo_layers_to_scratch(struct render_compute *crc,
                                      const uint32_t layer_count,
                                      struct render_scratch_images *rsi,
                                      VkImageLayout transition_to,
-                                     bool do_timewarp)
+                                     bool do_timewarp,
+                                     bool do_depth_reprojection)
 {
 	struct render_viewport_data target_views[2] = {
 	    {.w = rsi->extent.width, .h = rsi->extent.height},
@@ -655,18 +690,19 @@ comp_render_stereo_layers_to_scratch(struct render_compute *crc,
 	    rsi->color[1].unorm_view,
 	};
 
-	comp_render_stereo_layers( //
-	    crc,                   // crc
-	    layers,                // layers
-	    layer_count,           // layer_count
-	    pre_transforms,        // pre_transforms
-	    world_poses,           // world_poses
-	    eye_poses,             // eye_poses
-	    target_images,         // target_images
-	    target_image_views,    // target_image_views
-	    target_views,          // target_views
-	    transition_to,         // transition_to
-	    do_timewarp);          // do_timewarp
+	comp_render_stereo_layers(  //
+	    crc,                    // crc
+	    layers,                 // layers
+	    layer_count,            // layer_count
+	    pre_transforms,         // pre_transforms
+	    world_poses,            // world_poses
+	    eye_poses,              // eye_poses
+	    target_images,          // target_images
+	    target_image_views,     // target_image_views
+	    target_views,           // target_views
+	    transition_to,          // transition_to
+	    do_timewarp,            // do_timewarp
+	    do_depth_reprojection); // do_depth_reprojection
 }
 
 void
@@ -680,7 +716,8 @@ comp_render_dispatch_compute(struct render_compute *crc,
                              VkImageView target_image_view,
                              const struct render_viewport_data views[2],
                              bool fast_path,
-                             bool do_timewarp)
+                             bool do_timewarp,
+                             bool do_depth_reprojection)
 {
 	assert(!fast_path || layer_count > 0);
 
@@ -710,7 +747,7 @@ comp_render_dispatch_compute(struct render_compute *crc,
 		    target_image_view,   // target_image_view
 		    views,               // views
 		    do_timewarp);        // do_timewarp
-	} else if (fast_path && layers[0].data.type == XRT_LAYER_STEREO_PROJECTION_DEPTH) {
+	} else if (fast_path && layers[0].data.type == XRT_LAYER_STEREO_PROJECTION_DEPTH && !do_depth_reprojection) {
 		int i = 0;
 		const struct comp_layer *layer = &layers[i];
 		const struct xrt_layer_stereo_projection_depth_data *stereo = &layer->data.stereo_depth;
@@ -737,7 +774,8 @@ comp_render_dispatch_compute(struct render_compute *crc,
 		    layer_count,                      //
 		    rsi,                              //
 		    transition_to,                    //
-		    do_timewarp);                     //
+		    do_timewarp,                      //
+		    do_depth_reprojection);           //
 
 		do_distortion_for_scratch( //
 		    crc,                   //
@@ -30,6 +30,9 @@ struct comp_layer;
  * to grab a pre-allocated UBO from the @ref render_resources and to correctly
  * select left/right data from various layers.
  *
+ * Layers with depth are reprojected using the depth and full pose change if
+ * @p do_depth_reprojection and @p do_timewarp are set, others only timewarped.
+ *
  * Expected layouts:
  * * Layer images: VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
  * * Target images: VK_IMAGE_LAYOUT_GENERAL
@@ -45,7 +48,8 @@ comp_render_layer(struct render_compute *crc,
                   const VkImage target_image,
                   const VkImageView target_image_view,
                   const struct render_viewport_data *target_view,
-                  bool do_timewarp);
+                  bool do_timewarp,
+                  bool do_depth_reprojection);
 
 /*!
  * Helper function to dispatch the layer squasher, designed for stereo views.
@@ -75,7 +79,8 @@ comp_render_stereo_layers(struct render_compute *crc,
                           const VkImageView target_image_views[2],
                           const struct render_viewport_data target_views[2],
                           VkImageLayout transition_to,
-                          bool do_timewarp);
+                          bool do_timewarp,
+                          bool do_depth_reprojection);
 
 /*!
  * Helper function that takes a set of layers, new device poses, a scratch
@@ -102,14 +107,17 @@ comp_render_stereo_layers_to_scratch(struct render_compute *crc,
                                      const uint32_t layer_count,
                                      struct render_scratch_images *rsi,
                                      VkImageLayout transition_to,
-                                     bool do_timewarp);
+                                     bool do_timewarp,
+                                     bool do_depth_reprojection);
 
 /*!
  * Helper function that takes a set of layers, new device poses, a scratch
  * images and writes the needed commands to the @ref render_compute to do a full
  * composition with distortion. The scratch images are optionally used to squash
  * layers should it not be possible to do a fast_path. Will insert barriers to
- * change the scratch images and target images to the needed layout.
+ * change the scratch images and target images to the needed layout. A depth
+ * layer never takes the fast path with @p do_depth_reprojection set, as the
+ * reprojection is done by the layer squasher.
  *
  * Expected layouts:
  * * Layer images: VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
@@ -134,7 +142,8 @@ comp_render_dispatch_compute(struct render_compute *crc,
                              VkImageView target_image_view,
                              const struct render_viewport_data views[2],
                              bool fast_path,
-                             bool do_timewarp);
+                             bool do_timewarp,
+                             bool do_depth_reprojection);
 
 
 #ifdef __cplusplus
@@ -49,6 +49,44 @@ semaphore_wait(struct xrt_compositor_semaphore *xcsem, uint64_t value, uint64_t
 	return XRT_SUCCESS;
 }
 
+static xrt_result_t
+semaphore_wait_any(struct xrt_compositor_semaphore **xcsems, const uint64_t *values, uint32_t count, uint64_t timeout_ns)
+{
+	struct vk_bundle *vk = comp_semaphore(xcsems[0])->vk;
+	VkSemaphore semaphores[64];
+	VkResult ret;
+
+	// Callers check all of them after waking up, so only waiting on some is fine.
+	if (count > ARRAY_SIZE(semaphores)) {
+		count = (uint32_t)ARRAY_SIZE(semaphores);
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		semaphores[i] = comp_semaphore(xcsems[i])->semaphore;
+	}
+
+	VkSemaphoreWaitInfo wait_info = {
+	    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+	    .flags = VK_SEMAPHORE_WAIT_ANY_BIT,
+	    .semaphoreCount = count,
+	    .pSemaphores = semaphores,
+	    .pValues = values,
+	};
+
+	ret = vk->vkWaitSemaphores( //
+	    vk->device,             // device
+	    &wait_info,             // pWaitInfo
+	    timeout_ns);            // timeout
+	if (ret == VK_TIMEOUT) {
+		return XRT_TIMEOUT;
+	}
+	if (ret != VK_SUCCESS) {
+		VK_ERROR(vk, "vkWaitSemaphores: %s", vk_result_string(ret));
+		return XRT_ERROR_VULKAN;
+	}
+
+	return XRT_SUCCESS;
+}
+
 static void
 semaphore_destroy(struct xrt_compositor_semaphore *xcsem)
 {
@@ -103,6 +141,7 @@ comp_semaphore_create(struct vk_bundle *vk,
 	csem->base.reference.count = 1;
 	csem->base.destroy = semaphore_destroy;
 	csem->base.wait = semaphore_wait;
+	csem->base.wait_any = semaphore_wait_any;
 	csem->semaphore = semaphore;
 	csem->handle = handle;
 	csem->vk = vk;
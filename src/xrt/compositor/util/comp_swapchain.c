@@ -411,15 +411,10 @@ static void
 image_cleanup(struct vk_bundle *vk, struct comp_swapchain_image *image)
 {
 	/*
-	 * This makes sure that any pending command buffer has completed and all
-	 * resources referred by it can now be manipulated. This make sure that
-	 * validation doesn't complain. This is done during image destruction so
-	 * isn't time critical.
+	 * Any command buffer referring to these resources has completed, the
+	 * garbage collector only destroys swapchains once their retire fence
+	 * has signalled, see comp_swapchain_shared_garbage_collect.
 	 */
-	os_mutex_lock(&vk->queue_mutex);
-	vk->vkDeviceWaitIdle(vk->device);
-	os_mutex_unlock(&vk->queue_mutex);
-
 	clean_image_views(vk, image->array_size, &image->views.alpha);
 	clean_image_views(vk, image->array_size, &image->views.no_alpha);
 }
@@ -427,7 +422,7 @@ image_cleanup(struct vk_bundle *vk, struct comp_swapchain_image *image)
 /*!
  * Swapchain destruct is delayed until it is safe to destroy them, this function
  * does the actual destruction and is called from @ref
- * comp_swapchain_garbage_collect.
+ * comp_swapchain_shared_garbage_collect.
  *
  * @ingroup comp_util
  */
@@ -447,13 +442,14 @@ really_destroy(struct comp_swapchain *sc)
  *
  */
 
-xrt_result_t
-comp_swapchain_create_init(struct comp_swapchain *sc,
-                           comp_swapchain_destroy_func_t destroy_func,
-                           struct vk_bundle *vk,
-                           struct comp_swapchain_shared *cscs,
-                           const struct xrt_swapchain_create_info *info,
-                           const struct xrt_swapchain_create_properties *xsccp)
+static xrt_result_t
+create_init(struct comp_swapchain *sc,
+            comp_swapchain_destroy_func_t destroy_func,
+            struct vk_bundle *vk,
+            struct comp_swapchain_shared *cscs,
+            uint64_t pool_owner,
+            const struct xrt_swapchain_create_info *info,
+            const struct xrt_swapchain_create_properties *xsccp)
 {
 	VkResult ret;
 
@@ -471,8 +467,12 @@ comp_swapchain_create_init(struct comp_swapchain *sc,
 
 	set_common_fields(sc, destroy_func, vk, cscs, xsccp->image_count);
 
-	// Use the image helper to allocate the images.
-	ret = vk_ic_allocate(vk, info, xsccp->image_count, &sc->vkic);
+	if (pool_owner != 0) {
+		// Use the image pool to allocate the images, reusing old ones of the same owner if possible.
+		ret = comp_image_pool_allocate(&cscs->image_pool, vk, pool_owner, info, xsccp->image_count, &sc->vkic);
+	} else {
+		ret = vk_ic_allocate(vk, info, xsccp->image_count, &sc->vkic);
+	}
 	if (ret == VK_ERROR_FEATURE_NOT_PRESENT) {
 		return XRT_ERROR_SWAPCHAIN_FLAG_VALID_BUT_UNSUPPORTED;
 	}
@@ -483,6 +483,8 @@ comp_swapchain_create_init(struct comp_swapchain *sc,
 		return XRT_ERROR_VULKAN;
 	}
 
+	sc->pool_owner = pool_owner;
+
 	xrt_graphics_buffer_handle_t handles[ARRAY_SIZE(sc->vkic.images)];
 
 	vk_ic_get_handles(vk, &sc->vkic, ARRAY_SIZE(handles), handles);
@@ -497,6 +499,17 @@ comp_swapchain_create_init(struct comp_swapchain *sc,
 	return XRT_SUCCESS;
 }
 
+xrt_result_t
+comp_swapchain_create_init(struct comp_swapchain *sc,
+                           comp_swapchain_destroy_func_t destroy_func,
+                           struct vk_bundle *vk,
+                           struct comp_swapchain_shared *cscs,
+                           const struct xrt_swapchain_create_info *info,
+                           const struct xrt_swapchain_create_properties *xsccp)
+{
+	return create_init(sc, destroy_func, vk, cscs, 0, info, xsccp);
+}
+
 xrt_result_t
 comp_swapchain_import_init(struct comp_swapchain *sc,
                            comp_swapchain_destroy_func_t destroy_func,
@@ -553,7 +566,61 @@ comp_swapchain_teardown(struct comp_swapchain *sc)
 		u_graphics_buffer_unref(&sc->base.images[i].handle);
 	}
 
-	vk_ic_destroy(vk, &sc->vkic);
+	if (sc->pool_owner != 0) {
+		comp_image_pool_release(&sc->cscs->image_pool, vk, sc->pool_owner, &sc->vkic);
+	} else {
+		vk_ic_destroy(vk, &sc->vkic);
+	}
+}
+
+
+/*
+ *
+ * Retire helpers.
+ *
+ */
+
+/*!
+ * Puts the swapchain at the end of the retired list, with a fence that
+ * signals once the GPU is done with everything submitted so far.
+ */
+static void
+retire_swapchain_locked(struct comp_swapchain_shared *cscs, struct comp_swapchain *sc)
+{
+	struct vk_bundle *vk = sc->vk;
+
+	VkResult ret = vk_create_and_submit_fence(vk, &sc->retire_fence);
+	if (ret != VK_SUCCESS) {
+		VK_ERROR(vk, "vk_create_and_submit_fence: %s, waiting for the queue instead", vk_result_string(ret));
+
+		// Keep the old, slow, behaviour if we can't get a fence.
+		os_mutex_lock(&vk->queue_mutex);
+		vk->vkQueueWaitIdle(vk->queue);
+		os_mutex_unlock(&vk->queue_mutex);
+
+		sc->retire_fence = VK_NULL_HANDLE;
+	}
+
+	sc->retired_next = NULL;
+	if (cscs->retired_tail != NULL) {
+		cscs->retired_tail->retired_next = sc;
+	} else {
+		cscs->retired_head = sc;
+	}
+	cscs->retired_tail = sc;
+}
+
+static void
+destroy_retired(struct comp_swapchain *sc)
+{
+	struct vk_bundle *vk = sc->vk;
+
+	if (sc->retire_fence != VK_NULL_HANDLE) {
+		vk->vkDestroyFence(vk->device, sc->retire_fence, NULL);
+		sc->retire_fence = VK_NULL_HANDLE;
+	}
+
+	sc->real_destroy(sc);
 }
 
 
@@ -572,12 +639,55 @@ comp_swapchain_shared_init(struct comp_swapchain_shared *cscs, struct vk_bundle
 		return XRT_ERROR_VULKAN;
 	}
 
+	if (os_mutex_init(&cscs->retired_mutex) != 0) {
+		VK_ERROR(vk, "os_mutex_init: failed");
+		vk_cmd_pool_destroy(vk, &cscs->pool);
+		return XRT_ERROR_VULKAN;
+	}
+
+	if (comp_image_pool_init(&cscs->image_pool) != 0) {
+		VK_ERROR(vk, "comp_image_pool_init: failed");
+		os_mutex_destroy(&cscs->retired_mutex);
+		vk_cmd_pool_destroy(vk, &cscs->pool);
+		return XRT_ERROR_VULKAN;
+	}
+
+	cscs->retired_head = NULL;
+	cscs->retired_tail = NULL;
+
 	return XRT_SUCCESS;
 }
 
 void
 comp_swapchain_shared_destroy(struct comp_swapchain_shared *cscs, struct vk_bundle *vk)
 {
+	struct comp_swapchain *sc;
+
+	// Anything left must have been pushed by the caller's final garbage collect.
+	while ((sc = u_threading_stack_pop(&cscs->destroy_swapchains))) {
+		retire_swapchain_locked(cscs, sc);
+	}
+
+	// Must not be called while other threads are using the struct.
+	while ((sc = cscs->retired_head) != NULL) {
+		cscs->retired_head = sc->retired_next;
+
+		if (sc->retire_fence != VK_NULL_HANDLE) {
+			VkResult ret = vk->vkWaitForFences(vk->device, 1, &sc->retire_fence, VK_TRUE, UINT64_MAX);
+			if (ret != VK_SUCCESS) {
+				VK_ERROR(vk, "vkWaitForFences: %s", vk_result_string(ret));
+			}
+		}
+
+		destroy_retired(sc);
+	}
+	cscs->retired_tail = NULL;
+
+	os_mutex_destroy(&cscs->retired_mutex);
+
+	// After the retired swapchains, they give their images to the pool.
+	comp_image_pool_destroy(&cscs->image_pool, vk);
+
 	vk_cmd_pool_destroy(vk, &cscs->pool);
 }
 
@@ -586,9 +696,36 @@ comp_swapchain_shared_garbage_collect(struct comp_swapchain_shared *cscs)
 {
 	struct comp_swapchain *sc;
 
+	os_mutex_lock(&cscs->retired_mutex);
+
 	while ((sc = u_threading_stack_pop(&cscs->destroy_swapchains))) {
-		sc->real_destroy(sc);
+		retire_swapchain_locked(cscs, sc);
+	}
+
+	/*
+	 * The retire fences are submitted in list order on the same queue, so
+	 * they signal in order; stop at the first one that hasn't.
+	 */
+	while ((sc = cscs->retired_head) != NULL) {
+		if (sc->retire_fence != VK_NULL_HANDLE) {
+			VkResult ret = sc->vk->vkGetFenceStatus(sc->vk->device, sc->retire_fence);
+			if (ret == VK_NOT_READY) {
+				break;
+			}
+			if (ret != VK_SUCCESS) {
+				VK_ERROR(sc->vk, "vkGetFenceStatus: %s", vk_result_string(ret));
+			}
+		}
+
+		cscs->retired_head = sc->retired_next;
+		if (cscs->retired_head == NULL) {
+			cscs->retired_tail = NULL;
+		}
+
+		destroy_retired(sc);
 	}
+
+	os_mutex_unlock(&cscs->retired_mutex);
 }
 
 
@@ -618,6 +755,7 @@ comp_swapchain_get_create_properties(const struct xrt_swapchain_create_info *inf
 xrt_result_t
 comp_swapchain_create(struct vk_bundle *vk,
                       struct comp_swapchain_shared *cscs,
+                      uint64_t pool_owner,
                       const struct xrt_swapchain_create_info *info,
                       const struct xrt_swapchain_create_properties *xsccp,
                       struct xrt_swapchain **out_xsc)
@@ -625,13 +763,14 @@ comp_swapchain_create(struct vk_bundle *vk,
 	struct comp_swapchain *sc = U_TYPED_CALLOC(struct comp_swapchain);
 	xrt_result_t xret;
 
-	xret = comp_swapchain_create_init( //
-	    sc,                            //
-	    really_destroy,                //
-	    vk,                            //
-	    cscs,                          //
-	    info,                          //
-	    xsccp);                        //
+	xret = create_init( //
+	    sc,             //
+	    really_destroy, //
+	    vk,             //
+	    cscs,           //
+	    pool_owner,     //
+	    info,           //
+	    xsccp);         //
 	if (xret != XRT_SUCCESS) {
 		free(sc);
 		return xret;
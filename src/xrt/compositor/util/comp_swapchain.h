@@ -12,6 +12,7 @@
 
 #include "vk/vk_image_allocator.h"
 #include "vk/vk_cmd_pool.h"
+#include "util/comp_image_pool.h"
 
 #include "util/u_threading.h"
 #include "util/u_index_fifo.h"
@@ -38,6 +39,13 @@ typedef void (*comp_swapchain_destroy_func_t)(struct comp_swapchain *sc);
  * The lifetime of @p pool is handled by the compositor that implements this
  * struct.
  *
+ * Swapchains are destroyed in two steps: when popped off
+ * @ref destroy_swapchains they are given a fence that signals once all work
+ * already submitted to the queue has finished and put on the retired list,
+ * they are then really destroyed by a later garbage collection once that
+ * fence has signalled. This avoids stalling the whole device when a
+ * swapchain is destroyed.
+ *
  * @ingroup comp_util
  */
 struct comp_swapchain_shared
@@ -45,6 +53,15 @@ struct comp_swapchain_shared
 	//! Thread object for safely destroying swapchain.
 	struct u_threading_stack destroy_swapchains;
 
+	//! Protects the retired list.
+	struct os_mutex retired_mutex;
+
+	//! Oldest and newest swapchain waiting for their retire fence.
+	struct comp_swapchain *retired_head, *retired_tail;
+
+	//! Images of destroyed swapchains, reused by new swapchains.
+	struct comp_image_pool image_pool;
+
 	struct vk_cmd_pool pool;
 };
 
@@ -106,6 +123,15 @@ struct comp_swapchain
 
 	//! Virtual real destroy function.
 	comp_swapchain_destroy_func_t real_destroy;
+
+	//! Signalled when the GPU is done with all work that was submitted before this swapchain was destroyed.
+	VkFence retire_fence;
+
+	//! Next (newer) swapchain on the retired list, see @ref comp_swapchain_shared.
+	struct comp_swapchain *retired_next;
+
+	//! Owner the images were allocated for from @ref comp_swapchain_shared::image_pool, zero if not pooled.
+	uint64_t pool_owner;
 };
 
 
@@ -189,7 +215,8 @@ XRT_CHECK_RESULT xrt_result_t
 comp_swapchain_shared_init(struct comp_swapchain_shared *cscs, struct vk_bundle *vk);
 
 /*!
- * Destroy the shared struct.
+ * Destroy the shared struct, waits for and destroys any swapchains that are
+ * still waiting on the GPU.
  *
  * @ingroup comp_util
  */
@@ -198,7 +225,8 @@ comp_swapchain_shared_destroy(struct comp_swapchain_shared *cscs, struct vk_bund
 
 /*!
  * Do garbage collection, destroying any resources that has been scheduled for
- * destruction from other threads.
+ * destruction from other threads. Never waits on the GPU, swapchains that
+ * might still be in use are destroyed by a later call.
  *
  * @ingroup comp_util
  */
@@ -224,11 +252,15 @@ comp_swapchain_get_create_properties(const struct xrt_swapchain_create_info *inf
 /*!
  * A compositor function that is implemented in the swapchain code.
  *
+ * If @p pool_owner is non-zero the images are allocated from, and returned to,
+ * @ref comp_swapchain_shared::image_pool, only reusing images of that owner.
+ *
  * @ingroup comp_util
  */
 xrt_result_t
 comp_swapchain_create(struct vk_bundle *vk,
                       struct comp_swapchain_shared *cscs,
+                      uint64_t pool_owner,
                       const struct xrt_swapchain_create_info *info,
                       const struct xrt_swapchain_create_properties *xsccp,
                       struct xrt_swapchain **out_xsc);
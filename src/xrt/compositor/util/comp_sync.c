@@ -73,6 +73,39 @@ fence_wait(struct xrt_compositor_fence *xcf, uint64_t timeout)
 	return XRT_SUCCESS;
 }
 
+static xrt_result_t
+fence_wait_any(struct xrt_compositor_fence **xcfs, uint32_t count, uint64_t timeout)
+{
+	COMP_TRACE_MARKER();
+
+	struct vk_bundle *vk = ((struct fence *)xcfs[0])->vk;
+	VkFence fences[64];
+	uint32_t fence_count = 0;
+
+	// Callers check all of them after waking up, so only waiting on some is fine.
+	for (uint32_t i = 0; i < count && fence_count < ARRAY_SIZE(fences); i++) {
+		struct fence *f = (struct fence *)xcfs[i];
+
+		// Count no handle as signled fence.
+		if (f->fence == VK_NULL_HANDLE) {
+			return XRT_SUCCESS;
+		}
+
+		fences[fence_count++] = f->fence;
+	}
+
+	VkResult ret = vk->vkWaitForFences(vk->device, fence_count, fences, VK_FALSE, timeout);
+	if (ret == VK_TIMEOUT) {
+		return XRT_TIMEOUT;
+	}
+	if (ret != VK_SUCCESS) {
+		VK_ERROR(vk, "vkWaitForFences: %s", vk_result_string(ret));
+		return XRT_ERROR_VULKAN;
+	}
+
+	return XRT_SUCCESS;
+}
+
 static void
 fence_destroy(struct xrt_compositor_fence *xcf)
 {
@@ -113,6 +146,7 @@ comp_fence_import(struct vk_bundle *vk, xrt_graphics_sync_handle_t handle, struc
 
 	struct fence *f = U_TYPED_CALLOC(struct fence);
 	f->base.wait = fence_wait;
+	f->base.wait_any = fence_wait_any;
 	f->base.destroy = fence_destroy;
 	f->fence = fence;
 	f->vk = vk;
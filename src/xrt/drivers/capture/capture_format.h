@@ -0,0 +1,161 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  On disk format of device captures.
+ *
+ * A capture is a @ref capture_file_header followed by a stream of records, each
+ * starting with a @ref capture_record_header. Records are padded to 8 bytes so
+ * that a mmap:ed capture can be read in place. Everything is stored in the
+ * native byte order and struct layout, the header has enough information to
+ * reject captures from incompatible builds.
+ *
+ * @author agent <agent@local>
+ * @ingroup drv_capture
+ */
+
+#pragma once
+
+#include "xrt/xrt_defines.h"
+#include "xrt/xrt_device.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define CAPTURE_MAGIC "XRTCAPT"
+#define CAPTURE_VERSION 1
+#define CAPTURE_MAX_DEVICES 32
+#define CAPTURE_MAX_INPUTS 64
+#define CAPTURE_RECORD_ALIGN 8
+
+//! Which roles a captured device had, bit field.
+enum capture_role_bits
+{
+	CAPTURE_ROLE_HEAD = 1u << 0,
+	CAPTURE_ROLE_LEFT = 1u << 1,
+	CAPTURE_ROLE_RIGHT = 1u << 2,
+	CAPTURE_ROLE_GAMEPAD = 1u << 3,
+	CAPTURE_ROLE_EYES = 1u << 4,
+	CAPTURE_ROLE_HAND_TRACKING_LEFT = 1u << 5,
+	CAPTURE_ROLE_HAND_TRACKING_RIGHT = 1u << 6,
+};
+
+/*!
+ * Static information about a captured device, enough to recreate it.
+ */
+struct capture_device_desc
+{
+	char str[XRT_DEVICE_NAME_LEN];
+	char serial[XRT_DEVICE_NAME_LEN];
+
+	uint32_t name;        //!< enum xrt_device_name
+	uint32_t device_type; //!< enum xrt_device_type
+	uint32_t roles;       //!< enum capture_role_bits
+
+	uint8_t orientation_tracking_supported;
+	uint8_t position_tracking_supported;
+	uint8_t hand_tracking_supported;
+	uint8_t has_hmd;
+
+	struct xrt_pose tracking_origin_offset;
+
+	uint32_t input_count;
+	uint32_t input_names[CAPTURE_MAX_INPUTS]; //!< enum xrt_input_name
+
+	//! Only valid if @ref has_hmd is set.
+	struct
+	{
+		int32_t screen_w_pixels;
+		int32_t screen_h_pixels;
+		uint64_t nominal_frame_interval_ns;
+		uint32_t view_w_pixels[2];
+		uint32_t view_h_pixels[2];
+		struct xrt_fov fov[2];
+	} hmd;
+};
+
+struct capture_file_header
+{
+	char magic[8];
+	uint32_t version;
+
+	//! Size of this struct, records start right after it.
+	uint32_t header_size;
+
+	//! Sizes of the records, guards against layout changes.
+	uint32_t pose_record_size;
+	uint32_t hand_record_size;
+	uint32_t input_record_size;
+
+	uint32_t device_count;
+
+	//! Monotonic time when the capture was started.
+	int64_t start_ns;
+
+	struct capture_device_desc devices[CAPTURE_MAX_DEVICES];
+};
+
+enum capture_record_type
+{
+	CAPTURE_RECORD_POSE = 1,
+	CAPTURE_RECORD_HAND = 2,
+	CAPTURE_RECORD_INPUT = 3,
+};
+
+struct capture_record_header
+{
+	uint16_t type;   //!< enum capture_record_type
+	uint16_t device; //!< Index into capture_file_header::devices
+	uint32_t size;   //!< Total size of the record, including this header and padding.
+
+	//! Monotonic time the call was made.
+	int64_t timestamp_ns;
+};
+
+//! One call to @ref xrt_device::get_tracked_pose.
+struct capture_record_pose
+{
+	struct capture_record_header hdr;
+
+	uint32_t input_name;
+	uint32_t _pad;
+	int64_t at_timestamp_ns;
+
+	struct xrt_space_relation relation;
+};
+
+//! One call to @ref xrt_device::get_hand_tracking.
+struct capture_record_hand
+{
+	struct capture_record_header hdr;
+
+	uint32_t input_name;
+	uint32_t _pad;
+	int64_t at_timestamp_ns;
+	int64_t out_timestamp_ns;
+
+	struct xrt_hand_joint_set value;
+};
+
+//! An input that changed during a call to @ref xrt_device::update_inputs.
+struct capture_record_input
+{
+	struct capture_record_header hdr;
+
+	uint32_t input_index;
+	uint32_t active;
+	int64_t input_timestamp_ns;
+
+	union xrt_input_value value;
+};
+
+//! Size of a record of type @p T as written to disk.
+#define CAPTURE_RECORD_SIZE(T) ((uint32_t)((sizeof(T) + CAPTURE_RECORD_ALIGN - 1) & ~(CAPTURE_RECORD_ALIGN - 1)))
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,65 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Interface to the device capture and replay driver.
+ * @author agent <agent@local>
+ * @ingroup drv_capture
+ */
+
+#pragma once
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_system.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*!
+ * @defgroup drv_capture Device capture and replay driver
+ * @ingroup drv
+ *
+ * @brief Records what devices report into a file and plays it back later.
+ *
+ * The capture side wraps devices, in the spirit of @ref drv_multi, and writes
+ * every pose, hand joint set and changed input they report to a compact
+ * binary log, see @ref capture_format.h. The replay side mmaps such a log and
+ * exposes the same devices again, reporting the recorded data with the
+ * original timing. This allows load testing apps and the IPC and compositor
+ * stack with realistic motion on machines without any hardware.
+ */
+
+/*!
+ * Wraps all of the devices in @p xsysd with capture devices that record into
+ * the file at @p path, roles are updated to point to the wrappers. The
+ * wrappers take ownership of the wrapped devices.
+ *
+ * @ingroup drv_capture
+ */
+xrt_result_t
+capture_wrap_system_devices(struct xrt_system_devices *xsysd, const char *path);
+
+/*!
+ * Creates devices that replays the capture at @p path, roles are set to the
+ * devices as they were during capture.
+ *
+ * @ingroup drv_capture
+ */
+xrt_result_t
+capture_replay_create_system_devices(const char *path, struct xrt_system_devices **out_xsysd);
+
+/*!
+ * Reads which roles the devices in the capture at @p path had, returned as a
+ * bit field of @ref capture_role_bits in @p out_roles. Only the header is read.
+ *
+ * @ingroup drv_capture
+ */
+xrt_result_t
+capture_replay_read_roles(const char *path, uint32_t *out_roles);
+
+
+#ifdef __cplusplus
+}
+#endif
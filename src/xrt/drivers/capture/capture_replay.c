@@ -0,0 +1,811 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Devices that replay a capture.
+ * @author agent <agent@local>
+ * @ingroup drv_capture
+ */
+
+#include "xrt/xrt_config_os.h"
+#include "xrt/xrt_tracking.h"
+
+#include "os/os_time.h"
+
+#include "math/m_api.h"
+#include "math/m_space.h"
+
+#include "util/u_misc.h"
+#include "util/u_debug.h"
+#include "util/u_device.h"
+#include "util/u_logging.h"
+#include "util/u_system_helpers.h"
+#include "util/u_distortion_mesh.h"
+
+#include "capture_format.h"
+#include "capture_interface.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#ifdef XRT_OS_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+DEBUG_GET_ONCE_LOG_OPTION(replay_log, "CAPTURE_LOG", U_LOGGING_INFO)
+
+#define REPLAY_TRACE(...) U_LOG_IFL_T(debug_get_log_option_replay_log(), __VA_ARGS__)
+#define REPLAY_DEBUG(...) U_LOG_IFL_D(debug_get_log_option_replay_log(), __VA_ARGS__)
+#define REPLAY_INFO(...) U_LOG_IFL_I(debug_get_log_option_replay_log(), __VA_ARGS__)
+#define REPLAY_WARN(...) U_LOG_IFL_W(debug_get_log_option_replay_log(), __VA_ARGS__)
+#define REPLAY_ERROR(...) U_LOG_IFL_E(debug_get_log_option_replay_log(), __VA_ARGS__)
+
+
+/*
+ *
+ * Structs.
+ *
+ */
+
+/*!
+ * The loaded capture, shared between all replay devices.
+ */
+struct replay_file
+{
+	struct xrt_reference reference;
+
+	uint8_t *data;
+	size_t size;
+
+	//! Was @ref data mmap:ed or malloc:ed.
+	bool mapped;
+
+	const struct capture_file_header *header;
+
+	//! Timestamp of the last record, log time.
+	int64_t end_ns;
+
+	//! Length of the log, replay loops after this.
+	int64_t duration_ns;
+
+	//! Monotonic time when replay started.
+	int64_t replay_start_ns;
+};
+
+//! All pose records for one input, sorted on @ref capture_record_pose::at_timestamp_ns.
+struct replay_pose_track
+{
+	uint32_t input_name;
+	size_t count;
+	const struct capture_record_pose **records;
+};
+
+/*!
+ * A device replaying the records of one captured device.
+ *
+ * @implements xrt_device
+ */
+struct replay_device
+{
+	struct xrt_device base;
+
+	//! One reference.
+	struct replay_file *file;
+
+	//! Index into capture_file_header::devices.
+	uint16_t index;
+
+	//! Has its own tracking origin so offsets are kept per device.
+	struct xrt_tracking_origin origin;
+
+	struct replay_pose_track tracks[CAPTURE_MAX_INPUTS + 1];
+	uint32_t track_count;
+
+	//! Sorted on @ref capture_record_hand::at_timestamp_ns, per hand.
+	struct
+	{
+		uint32_t input_name;
+		size_t count;
+		const struct capture_record_hand **records;
+	} hands[2];
+
+	//! In file order, which is also timestamp order.
+	const struct capture_record_input **inputs;
+	size_t input_record_count;
+
+	//! Next input record to apply, and the log time it was last applied at.
+	size_t input_cursor;
+	int64_t input_last_log_ns;
+};
+
+static inline struct replay_device *
+replay_device(struct xrt_device *xdev)
+{
+	return (struct replay_device *)xdev;
+}
+
+
+/*
+ *
+ * File functions.
+ *
+ */
+
+static void
+file_unref(struct replay_file **file_ptr)
+{
+	struct replay_file *f = *file_ptr;
+	if (f == NULL) {
+		return;
+	}
+	*file_ptr = NULL;
+
+	if (!xrt_reference_dec(&f->reference)) {
+		return;
+	}
+
+#ifdef XRT_OS_LINUX
+	if (f->mapped) {
+		munmap(f->data, f->size);
+	} else {
+		free(f->data);
+	}
+#else
+	free(f->data);
+#endif
+
+	free(f);
+}
+
+static bool
+file_load(struct replay_file *f, const char *path)
+{
+#ifdef XRT_OS_LINUX
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		REPLAY_ERROR("Could not open '%s'.", path);
+		return false;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		REPLAY_ERROR("Could not stat '%s'.", path);
+		close(fd);
+		return false;
+	}
+
+	void *ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (ptr == MAP_FAILED) {
+		REPLAY_ERROR("Could not mmap '%s'.", path);
+		return false;
+	}
+
+	// Read mostly in order, let the kernel read ahead.
+	madvise(ptr, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+	f->data = (uint8_t *)ptr;
+	f->size = (size_t)st.st_size;
+	f->mapped = true;
+
+	return true;
+#else
+	FILE *file = fopen(path, "rb");
+	if (file == NULL) {
+		REPLAY_ERROR("Could not open '%s'.", path);
+		return false;
+	}
+
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	if (size <= 0) {
+		REPLAY_ERROR("Empty file '%s'.", path);
+		fclose(file);
+		return false;
+	}
+
+	f->data = U_TYPED_ARRAY_CALLOC(uint8_t, (size_t)size);
+	f->size = (size_t)size;
+
+	bool ok = fread(f->data, f->size, 1, file) == 1;
+	fclose(file);
+
+	if (!ok) {
+		REPLAY_ERROR("Could not read '%s'.", path);
+		return false;
+	}
+
+	return true;
+#endif
+}
+
+static bool
+file_validate_header(struct replay_file *f)
+{
+	if (f->size < sizeof(struct capture_file_header)) {
+		REPLAY_ERROR("File too small for header.");
+		return false;
+	}
+
+	const struct capture_file_header *h = (const struct capture_file_header *)f->data;
+
+	if (memcmp(h->magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0) {
+		REPLAY_ERROR("Not a capture file.");
+		return false;
+	}
+
+	if (h->version != CAPTURE_VERSION || h->header_size != sizeof(*h) ||
+	    h->pose_record_size != CAPTURE_RECORD_SIZE(struct capture_record_pose) ||
+	    h->hand_record_size != CAPTURE_RECORD_SIZE(struct capture_record_hand) ||
+	    h->input_record_size != CAPTURE_RECORD_SIZE(struct capture_record_input)) {
+		REPLAY_ERROR("Capture from an incompatible build (version %u).", h->version);
+		return false;
+	}
+
+	if (h->device_count == 0 || h->device_count > CAPTURE_MAX_DEVICES) {
+		REPLAY_ERROR("Invalid device count %u.", h->device_count);
+		return false;
+	}
+
+	f->header = h;
+
+	return true;
+}
+
+static uint32_t
+record_size_for_type(const struct capture_file_header *h, uint16_t type)
+{
+	switch (type) {
+	case CAPTURE_RECORD_POSE: return h->pose_record_size;
+	case CAPTURE_RECORD_HAND: return h->hand_record_size;
+	case CAPTURE_RECORD_INPUT: return h->input_record_size;
+	default: return 0;
+	}
+}
+
+/*!
+ * Walks all of the records, calling @p func on each valid one. Stops at the
+ * first invalid record, which is what a capture cut short looks like.
+ */
+static size_t
+file_walk(struct replay_file *f, void (*func)(void *ptr, const struct capture_record_header *hdr), void *ptr)
+{
+	const struct capture_file_header *h = f->header;
+	size_t offset = h->header_size;
+	size_t count = 0;
+
+	while (offset + sizeof(struct capture_record_header) <= f->size) {
+		const struct capture_record_header *hdr = (const struct capture_record_header *)(f->data + offset);
+
+		if (hdr->size != record_size_for_type(h, hdr->type) || offset + hdr->size > f->size ||
+		    hdr->device >= h->device_count) {
+			break;
+		}
+
+		func(ptr, hdr);
+
+		offset += hdr->size;
+		count++;
+	}
+
+	if (offset != f->size) {
+		REPLAY_WARN("Trailing %zu bytes ignored, was the capture cut short?", f->size - offset);
+	}
+
+	return count;
+}
+
+static void
+file_find_end(void *ptr, const struct capture_record_header *hdr)
+{
+	struct replay_file *f = (struct replay_file *)ptr;
+	f->end_ns = MAX(f->end_ns, hdr->timestamp_ns);
+}
+
+/*!
+ * Maps a monotonic timestamp to the log, looping over the log duration.
+ */
+static int64_t
+file_to_log_ns(struct replay_file *f, int64_t timestamp_ns)
+{
+	int64_t since_ns = timestamp_ns - f->replay_start_ns;
+	int64_t looped_ns = since_ns % f->duration_ns;
+	if (looped_ns < 0) {
+		looped_ns += f->duration_ns;
+	}
+
+	return f->header->start_ns + looped_ns;
+}
+
+
+/*
+ *
+ * Indexing functions.
+ *
+ */
+
+static struct replay_pose_track *
+get_track(struct replay_device *d, uint32_t input_name, bool create)
+{
+	for (uint32_t i = 0; i < d->track_count; i++) {
+		if (d->tracks[i].input_name == input_name) {
+			return &d->tracks[i];
+		}
+	}
+
+	if (!create || d->track_count >= ARRAY_SIZE(d->tracks)) {
+		return NULL;
+	}
+
+	struct replay_pose_track *t = &d->tracks[d->track_count++];
+	t->input_name = input_name;
+
+	return t;
+}
+
+static uint32_t
+hand_index(uint32_t input_name)
+{
+	return input_name == XRT_INPUT_GENERIC_HAND_TRACKING_RIGHT ? 1 : 0;
+}
+
+struct index_state
+{
+	struct replay_device **devices;
+
+	//! First pass counts, second pass fills.
+	bool fill;
+};
+
+static void
+index_record(void *ptr, const struct capture_record_header *hdr)
+{
+	struct index_state *s = (struct index_state *)ptr;
+	struct replay_device *d = s->devices[hdr->device];
+
+	switch (hdr->type) {
+	case CAPTURE_RECORD_POSE: {
+		const struct capture_record_pose *rec = (const struct capture_record_pose *)hdr;
+		struct replay_pose_track *t = get_track(d, rec->input_name, !s->fill);
+		if (t == NULL) {
+			break;
+		}
+		if (s->fill) {
+			t->records[t->count] = rec;
+		}
+		t->count++;
+	} break;
+	case CAPTURE_RECORD_HAND: {
+		const struct capture_record_hand *rec = (const struct capture_record_hand *)hdr;
+		uint32_t hi = hand_index(rec->input_name);
+		d->hands[hi].input_name = rec->input_name;
+		if (s->fill) {
+			d->hands[hi].records[d->hands[hi].count] = rec;
+		}
+		d->hands[hi].count++;
+	} break;
+	case CAPTURE_RECORD_INPUT: {
+		const struct capture_record_input *rec = (const struct capture_record_input *)hdr;
+		if (rec->input_index >= d->base.input_count) {
+			break;
+		}
+		if (s->fill) {
+			d->inputs[d->input_record_count] = rec;
+		}
+		d->input_record_count++;
+	} break;
+	default: break;
+	}
+}
+
+static int
+cmp_pose_records(const void *a, const void *b)
+{
+	const struct capture_record_pose *ra = *(const struct capture_record_pose *const *)a;
+	const struct capture_record_pose *rb = *(const struct capture_record_pose *const *)b;
+	return (ra->at_timestamp_ns > rb->at_timestamp_ns) - (ra->at_timestamp_ns < rb->at_timestamp_ns);
+}
+
+static int
+cmp_hand_records(const void *a, const void *b)
+{
+	const struct capture_record_hand *ra = *(const struct capture_record_hand *const *)a;
+	const struct capture_record_hand *rb = *(const struct capture_record_hand *const *)b;
+	return (ra->at_timestamp_ns > rb->at_timestamp_ns) - (ra->at_timestamp_ns < rb->at_timestamp_ns);
+}
+
+static void
+index_devices(struct replay_file *f, struct replay_device **devices)
+{
+	struct index_state s = {devices, false};
+
+	// Count.
+	file_walk(f, index_record, &s);
+
+	// Allocate and reset counts.
+	for (uint32_t i = 0; i < f->header->device_count; i++) {
+		struct replay_device *d = devices[i];
+		for (uint32_t k = 0; k < d->track_count; k++) {
+			d->tracks[k].records = U_TYPED_ARRAY_CALLOC(const struct capture_record_pose *, d->tracks[k].count);
+			d->tracks[k].count = 0;
+		}
+		for (uint32_t k = 0; k < ARRAY_SIZE(d->hands); k++) {
+			d->hands[k].records = U_TYPED_ARRAY_CALLOC(const struct capture_record_hand *, d->hands[k].count);
+			d->hands[k].count = 0;
+		}
+		d->inputs = U_TYPED_ARRAY_CALLOC(const struct capture_record_input *, d->input_record_count);
+		d->input_record_count = 0;
+	}
+
+	// Fill.
+	s.fill = true;
+	file_walk(f, index_record, &s);
+
+	// Prediction makes at_timestamp_ns go back and forth, sort.
+	for (uint32_t i = 0; i < f->header->device_count; i++) {
+		struct replay_device *d = devices[i];
+		for (uint32_t k = 0; k < d->track_count; k++) {
+			qsort(d->tracks[k].records, d->tracks[k].count, sizeof(void *), cmp_pose_records);
+		}
+		for (uint32_t k = 0; k < ARRAY_SIZE(d->hands); k++) {
+			qsort(d->hands[k].records, d->hands[k].count, sizeof(void *), cmp_hand_records);
+		}
+	}
+}
+
+
+/*
+ *
+ * Device functions.
+ *
+ */
+
+static void
+replay_device_update_inputs(struct xrt_device *xdev)
+{
+	struct replay_device *d = replay_device(xdev);
+
+	int64_t now_ns = (int64_t)os_monotonic_get_ns();
+	int64_t log_ns = file_to_log_ns(d->file, now_ns);
+
+	// Looped, start over.
+	if (log_ns < d->input_last_log_ns) {
+		d->input_cursor = 0;
+	}
+	d->input_last_log_ns = log_ns;
+
+	while (d->input_cursor < d->input_record_count) {
+		const struct capture_record_input *rec = d->inputs[d->input_cursor];
+		if (rec->hdr.timestamp_ns > log_ns) {
+			break;
+		}
+
+		struct xrt_input *in = &d->base.inputs[rec->input_index];
+		in->active = rec->active != 0;
+		in->value = rec->value;
+		in->timestamp = now_ns;
+
+		d->input_cursor++;
+	}
+}
+
+static void
+replay_device_get_tracked_pose(struct xrt_device *xdev,
+                               enum xrt_input_name name,
+                               uint64_t at_timestamp_ns,
+                               struct xrt_space_relation *out_relation)
+{
+	struct replay_device *d = replay_device(xdev);
+
+	*out_relation = (struct xrt_space_relation)XRT_SPACE_RELATION_ZERO;
+
+	struct replay_pose_track *t = get_track(d, (uint32_t)name, false);
+	if (t == NULL || t->count == 0) {
+		return;
+	}
+
+	int64_t log_ns = file_to_log_ns(d->file, (int64_t)at_timestamp_ns);
+
+	// First record with at_timestamp_ns >= log_ns.
+	size_t lo = 0;
+	size_t hi = t->count;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (t->records[mid]->at_timestamp_ns < log_ns) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	if (lo == 0) {
+		*out_relation = t->records[0]->relation;
+		return;
+	}
+	if (lo == t->count) {
+		*out_relation = t->records[t->count - 1]->relation;
+		return;
+	}
+
+	const struct capture_record_pose *a = t->records[lo - 1];
+	const struct capture_record_pose *b = t->records[lo];
+
+	int64_t span_ns = b->at_timestamp_ns - a->at_timestamp_ns;
+	float f = span_ns > 0 ? (float)((double)(log_ns - a->at_timestamp_ns) / (double)span_ns) : 0.0f;
+
+	struct xrt_space_relation ra = a->relation;
+	struct xrt_space_relation rb = b->relation;
+	enum xrt_space_relation_flags flags = ra.relation_flags & rb.relation_flags;
+
+	m_space_relation_interpolate(&ra, &rb, f, flags, out_relation);
+}
+
+static void
+replay_device_get_hand_tracking(struct xrt_device *xdev,
+                                enum xrt_input_name name,
+                                uint64_t at_timestamp_ns,
+                                struct xrt_hand_joint_set *out_value,
+                                uint64_t *out_timestamp_ns)
+{
+	struct replay_device *d = replay_device(xdev);
+
+	U_ZERO(out_value);
+	*out_timestamp_ns = at_timestamp_ns;
+
+	uint32_t hi = hand_index((uint32_t)name);
+	if (d->hands[hi].count == 0) {
+		return;
+	}
+
+	int64_t log_ns = file_to_log_ns(d->file, (int64_t)at_timestamp_ns);
+
+	// Nearest record, joint sets are too large to interpolate cheaply.
+	size_t best = 0;
+	size_t lo = 0;
+	size_t high = d->hands[hi].count;
+	while (lo < high) {
+		size_t mid = lo + (high - lo) / 2;
+		if (d->hands[hi].records[mid]->at_timestamp_ns < log_ns) {
+			lo = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	best = lo == d->hands[hi].count ? lo - 1 : lo;
+	if (lo > 0 && lo < d->hands[hi].count) {
+		int64_t before = log_ns - d->hands[hi].records[lo - 1]->at_timestamp_ns;
+		int64_t after = d->hands[hi].records[lo]->at_timestamp_ns - log_ns;
+		best = before < after ? lo - 1 : lo;
+	}
+
+	const struct capture_record_hand *rec = d->hands[hi].records[best];
+	*out_value = rec->value;
+
+	// Keep the same distance between asked and returned time as in the capture.
+	*out_timestamp_ns = at_timestamp_ns - (uint64_t)(rec->at_timestamp_ns - rec->out_timestamp_ns);
+}
+
+static void
+replay_device_get_view_poses(struct xrt_device *xdev,
+                             const struct xrt_vec3 *default_eye_relation,
+                             uint64_t at_timestamp_ns,
+                             uint32_t view_count,
+                             struct xrt_space_relation *out_head_relation,
+                             struct xrt_fov *out_fovs,
+                             struct xrt_pose *out_poses)
+{
+	u_device_get_view_poses(xdev, default_eye_relation, at_timestamp_ns, view_count, out_head_relation, out_fovs,
+	                        out_poses);
+}
+
+static void
+replay_device_set_output(struct xrt_device *xdev, enum xrt_output_name name, const union xrt_output_value *value)
+{
+	// Haptics go nowhere.
+}
+
+static void
+replay_device_destroy(struct xrt_device *xdev)
+{
+	struct replay_device *d = replay_device(xdev);
+
+	for (uint32_t k = 0; k < d->track_count; k++) {
+		free(d->tracks[k].records);
+	}
+	for (uint32_t k = 0; k < ARRAY_SIZE(d->hands); k++) {
+		free(d->hands[k].records);
+	}
+	free(d->inputs);
+
+	file_unref(&d->file);
+
+	u_device_free(&d->base);
+}
+
+static bool
+setup_hmd(struct replay_device *d, const struct capture_device_desc *desc)
+{
+	struct u_device_simple_info info;
+	info.display.w_pixels = (uint32_t)desc->hmd.screen_w_pixels;
+	info.display.h_pixels = (uint32_t)desc->hmd.screen_h_pixels;
+	info.display.w_meters = 0.13f;
+	info.display.h_meters = 0.07f;
+	info.lens_horizontal_separation_meters = 0.13f / 2.0f;
+	info.lens_vertical_position_meters = 0.07f / 2.0f;
+	info.fov[0] = desc->hmd.fov[0].angle_right - desc->hmd.fov[0].angle_left;
+	info.fov[1] = desc->hmd.fov[1].angle_right - desc->hmd.fov[1].angle_left;
+
+	if (!u_device_setup_split_side_by_side(&d->base, &info)) {
+		return false;
+	}
+
+	// Restore what was captured exactly.
+	struct xrt_hmd_parts *hmd = d->base.hmd;
+	hmd->screens[0].nominal_frame_interval_ns = desc->hmd.nominal_frame_interval_ns;
+	for (uint32_t i = 0; i < 2; i++) {
+		hmd->views[i].display.w_pixels = desc->hmd.view_w_pixels[i];
+		hmd->views[i].display.h_pixels = desc->hmd.view_h_pixels[i];
+		hmd->distortion.fov[i] = desc->hmd.fov[i];
+	}
+
+	u_distortion_mesh_set_none(&d->base);
+
+	d->base.get_view_poses = replay_device_get_view_poses;
+
+	return true;
+}
+
+static struct replay_device *
+replay_device_create(struct replay_file *f, uint16_t index)
+{
+	const struct capture_device_desc *desc = &f->header->devices[index];
+
+	enum u_device_alloc_flags flags = desc->has_hmd ? U_DEVICE_ALLOC_HMD : U_DEVICE_ALLOC_NO_FLAGS;
+	uint32_t input_count = MIN(desc->input_count, CAPTURE_MAX_INPUTS);
+
+	struct replay_device *d = U_DEVICE_ALLOCATE(struct replay_device, flags, input_count, 0);
+
+	xrt_reference_inc(&f->reference);
+	d->file = f;
+	d->index = index;
+
+	d->base.update_inputs = replay_device_update_inputs;
+	d->base.get_tracked_pose = replay_device_get_tracked_pose;
+	d->base.get_hand_tracking = replay_device_get_hand_tracking;
+	d->base.set_output = replay_device_set_output;
+	d->base.destroy = replay_device_destroy;
+
+	snprintf(d->base.str, sizeof(d->base.str), "%s", desc->str);
+	snprintf(d->base.serial, sizeof(d->base.serial), "%s", desc->serial);
+	d->base.name = (enum xrt_device_name)desc->name;
+	d->base.device_type = (enum xrt_device_type)desc->device_type;
+	d->base.orientation_tracking_supported = desc->orientation_tracking_supported != 0;
+	d->base.position_tracking_supported = desc->position_tracking_supported != 0;
+	d->base.hand_tracking_supported = desc->hand_tracking_supported != 0;
+
+	for (uint32_t i = 0; i < input_count; i++) {
+		d->base.inputs[i].name = (enum xrt_input_name)desc->input_names[i];
+		d->base.inputs[i].active = true;
+	}
+
+	snprintf(d->origin.name, sizeof(d->origin.name), "Replay %u", index);
+	d->origin.type = XRT_TRACKING_TYPE_OTHER;
+	d->origin.offset = desc->tracking_origin_offset;
+	d->base.tracking_origin = &d->origin;
+
+	if (desc->has_hmd && !setup_hmd(d, desc)) {
+		REPLAY_ERROR("Failed to setup HMD '%s'.", desc->str);
+		replay_device_destroy(&d->base);
+		return NULL;
+	}
+
+	return d;
+}
+
+
+/*
+ *
+ * 'Exported' functions.
+ *
+ */
+
+xrt_result_t
+capture_replay_create_system_devices(const char *path, struct xrt_system_devices **out_xsysd)
+{
+	struct replay_file *f = U_TYPED_CALLOC(struct replay_file);
+	xrt_reference_inc(&f->reference);
+
+	if (!file_load(f, path) || !file_validate_header(f)) {
+		file_unref(&f);
+		return XRT_ERROR_DEVICE_CREATION_FAILED;
+	}
+
+	const struct capture_file_header *h = f->header;
+
+	f->end_ns = h->start_ns;
+	size_t record_count = file_walk(f, file_find_end, f);
+	f->duration_ns = MAX(f->end_ns - h->start_ns, 1);
+	f->replay_start_ns = (int64_t)os_monotonic_get_ns();
+
+	struct replay_device *devices[CAPTURE_MAX_DEVICES] = {0};
+	for (uint32_t i = 0; i < h->device_count; i++) {
+		devices[i] = replay_device_create(f, (uint16_t)i);
+		if (devices[i] == NULL) {
+			for (uint32_t k = 0; k < i; k++) {
+				replay_device_destroy(&devices[k]->base);
+			}
+			file_unref(&f);
+			return XRT_ERROR_DEVICE_CREATION_FAILED;
+		}
+	}
+
+	index_devices(f, devices);
+
+	struct u_system_devices *usysd = u_system_devices_allocate();
+	for (uint32_t i = 0; i < h->device_count; i++) {
+		struct xrt_device *xdev = &devices[i]->base;
+		uint32_t roles = h->devices[i].roles;
+
+		usysd->base.xdevs[usysd->base.xdev_count++] = xdev;
+
+		usysd->base.roles.head = (roles & CAPTURE_ROLE_HEAD) ? xdev : usysd->base.roles.head;
+		usysd->base.roles.left = (roles & CAPTURE_ROLE_LEFT) ? xdev : usysd->base.roles.left;
+		usysd->base.roles.right = (roles & CAPTURE_ROLE_RIGHT) ? xdev : usysd->base.roles.right;
+		usysd->base.roles.gamepad = (roles & CAPTURE_ROLE_GAMEPAD) ? xdev : usysd->base.roles.gamepad;
+		usysd->base.roles.eyes = (roles & CAPTURE_ROLE_EYES) ? xdev : usysd->base.roles.eyes;
+		usysd->base.roles.hand_tracking.left =
+		    (roles & CAPTURE_ROLE_HAND_TRACKING_LEFT) ? xdev : usysd->base.roles.hand_tracking.left;
+		usysd->base.roles.hand_tracking.right =
+		    (roles & CAPTURE_ROLE_HAND_TRACKING_RIGHT) ? xdev : usysd->base.roles.hand_tracking.right;
+	}
+
+	REPLAY_INFO("Replaying %u devices and %zu records from '%s', looping every %.2fs.", h->device_count,
+	            record_count, path, (double)f->duration_ns / 1e9);
+
+	// The devices hold the references now.
+	file_unref(&f);
+
+	*out_xsysd = &usysd->base;
+
+	return XRT_SUCCESS;
+}
+
+xrt_result_t
+capture_replay_read_roles(const char *path, uint32_t *out_roles)
+{
+	FILE *file = fopen(path, "rb");
+	if (file == NULL) {
+		REPLAY_ERROR("Could not open '%s'.", path);
+		return XRT_ERROR_DEVICE_CREATION_FAILED;
+	}
+
+	struct replay_file f = {0};
+	f.data = (uint8_t *)U_TYPED_CALLOC(struct capture_file_header);
+	f.size = fread(f.data, 1, sizeof(struct capture_file_header), file);
+	fclose(file);
+
+	if (!file_validate_header(&f)) {
+		free(f.data);
+		return XRT_ERROR_DEVICE_CREATION_FAILED;
+	}
+
+	uint32_t roles = 0;
+	for (uint32_t i = 0; i < f.header->device_count; i++) {
+		roles |= f.header->devices[i].roles;
+	}
+
+	free(f.data);
+
+	*out_roles = roles;
+
+	return XRT_SUCCESS;
+}
@@ -0,0 +1,455 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Wrapper devices that record what the wrapped devices report.
+ * @author agent <agent@local>
+ * @ingroup drv_capture
+ */
+
+#include "xrt/xrt_tracking.h"
+
+#include "os/os_time.h"
+#include "os/os_threading.h"
+
+#include "math/m_api.h"
+
+#include "util/u_misc.h"
+#include "util/u_debug.h"
+#include "util/u_logging.h"
+
+#include "capture_format.h"
+#include "capture_interface.h"
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+
+
+DEBUG_GET_ONCE_LOG_OPTION(capture_log, "CAPTURE_LOG", U_LOGGING_INFO)
+
+#define CAPTURE_TRACE(...) U_LOG_IFL_T(debug_get_log_option_capture_log(), __VA_ARGS__)
+#define CAPTURE_DEBUG(...) U_LOG_IFL_D(debug_get_log_option_capture_log(), __VA_ARGS__)
+#define CAPTURE_INFO(...) U_LOG_IFL_I(debug_get_log_option_capture_log(), __VA_ARGS__)
+#define CAPTURE_WARN(...) U_LOG_IFL_W(debug_get_log_option_capture_log(), __VA_ARGS__)
+#define CAPTURE_ERROR(...) U_LOG_IFL_E(debug_get_log_option_capture_log(), __VA_ARGS__)
+
+//! Size of the stdio buffer, keeps the number of write syscalls down.
+#define CAPTURE_WRITE_BUFFER_SIZE (1024 * 1024)
+
+
+/*
+ *
+ * Structs.
+ *
+ */
+
+/*!
+ * The file being written to, shared between all capture devices.
+ */
+struct capture_writer
+{
+	struct xrt_reference reference;
+
+	//! Protects the file.
+	struct os_mutex mutex;
+
+	FILE *file;
+	char *buffer;
+
+	uint64_t record_count;
+	bool write_failed;
+};
+
+/*!
+ * Wraps a device and records everything it reports.
+ *
+ * @implements xrt_device
+ */
+struct capture_device
+{
+	struct xrt_device base;
+
+	//! Owned.
+	struct xrt_device *target;
+
+	//! One reference.
+	struct capture_writer *writer;
+
+	//! Index into capture_file_header::devices.
+	uint16_t index;
+
+	//! Inputs as they were after the last update, only changes are written.
+	struct xrt_input last_inputs[CAPTURE_MAX_INPUTS];
+};
+
+static inline struct capture_device *
+capture_device(struct xrt_device *xdev)
+{
+	return (struct capture_device *)xdev;
+}
+
+
+/*
+ *
+ * Writer functions.
+ *
+ */
+
+static void
+writer_unref(struct capture_writer **writer_ptr)
+{
+	struct capture_writer *w = *writer_ptr;
+	if (w == NULL) {
+		return;
+	}
+	*writer_ptr = NULL;
+
+	if (!xrt_reference_dec(&w->reference)) {
+		return;
+	}
+
+	CAPTURE_INFO("Closing capture, %" PRIu64 " records written.", w->record_count);
+
+	fclose(w->file);
+	os_mutex_destroy(&w->mutex);
+	free(w->buffer);
+	free(w);
+}
+
+static void
+write_record(struct capture_writer *w, struct capture_record_header *hdr, size_t struct_size)
+{
+	static const uint8_t zeros[CAPTURE_RECORD_ALIGN] = {0};
+	size_t pad = hdr->size - struct_size;
+
+	os_mutex_lock(&w->mutex);
+
+	if (!w->write_failed) {
+		bool ok = fwrite(hdr, struct_size, 1, w->file) == 1;
+		ok = ok && (pad == 0 || fwrite(zeros, pad, 1, w->file) == 1);
+		if (!ok) {
+			CAPTURE_ERROR("Failed to write record, stopping capture!");
+			w->write_failed = true;
+		}
+		w->record_count++;
+	}
+
+	os_mutex_unlock(&w->mutex);
+}
+
+#define WRITE_RECORD(W, REC) write_record(W, &(REC)->hdr, sizeof(*(REC)))
+
+static void
+fill_header(struct capture_device *d, struct capture_record_header *hdr, enum capture_record_type type, uint32_t size)
+{
+	hdr->type = (uint16_t)type;
+	hdr->device = d->index;
+	hdr->size = size;
+	hdr->timestamp_ns = (int64_t)os_monotonic_get_ns();
+}
+
+static void
+fill_desc(struct xrt_system_devices *xsysd, struct xrt_device *xdev, struct capture_device_desc *desc)
+{
+	snprintf(desc->str, sizeof(desc->str), "%s", xdev->str);
+	snprintf(desc->serial, sizeof(desc->serial), "%s", xdev->serial);
+
+	desc->name = (uint32_t)xdev->name;
+	desc->device_type = (uint32_t)xdev->device_type;
+	desc->orientation_tracking_supported = xdev->orientation_tracking_supported;
+	desc->position_tracking_supported = xdev->position_tracking_supported;
+	desc->hand_tracking_supported = xdev->hand_tracking_supported;
+	desc->tracking_origin_offset = xdev->tracking_origin->offset;
+
+	desc->roles = 0;
+	desc->roles |= xsysd->roles.head == xdev ? CAPTURE_ROLE_HEAD : 0;
+	desc->roles |= xsysd->roles.left == xdev ? CAPTURE_ROLE_LEFT : 0;
+	desc->roles |= xsysd->roles.right == xdev ? CAPTURE_ROLE_RIGHT : 0;
+	desc->roles |= xsysd->roles.gamepad == xdev ? CAPTURE_ROLE_GAMEPAD : 0;
+	desc->roles |= xsysd->roles.eyes == xdev ? CAPTURE_ROLE_EYES : 0;
+	desc->roles |= xsysd->roles.hand_tracking.left == xdev ? CAPTURE_ROLE_HAND_TRACKING_LEFT : 0;
+	desc->roles |= xsysd->roles.hand_tracking.right == xdev ? CAPTURE_ROLE_HAND_TRACKING_RIGHT : 0;
+
+	if (xdev->input_count > CAPTURE_MAX_INPUTS) {
+		CAPTURE_WARN("'%s' has %zu inputs, only capturing the first %u.", xdev->str, xdev->input_count,
+		             CAPTURE_MAX_INPUTS);
+	}
+	desc->input_count = (uint32_t)MIN(xdev->input_count, CAPTURE_MAX_INPUTS);
+	for (uint32_t i = 0; i < desc->input_count; i++) {
+		desc->input_names[i] = (uint32_t)xdev->inputs[i].name;
+	}
+
+	if (xdev->hmd == NULL) {
+		return;
+	}
+
+	desc->has_hmd = true;
+	desc->hmd.screen_w_pixels = xdev->hmd->screens[0].w_pixels;
+	desc->hmd.screen_h_pixels = xdev->hmd->screens[0].h_pixels;
+	desc->hmd.nominal_frame_interval_ns = xdev->hmd->screens[0].nominal_frame_interval_ns;
+	for (uint32_t i = 0; i < 2; i++) {
+		desc->hmd.view_w_pixels[i] = xdev->hmd->views[i].display.w_pixels;
+		desc->hmd.view_h_pixels[i] = xdev->hmd->views[i].display.h_pixels;
+		desc->hmd.fov[i] = xdev->hmd->distortion.fov[i];
+	}
+}
+
+
+/*
+ *
+ * Device functions.
+ *
+ */
+
+static void
+capture_device_update_inputs(struct xrt_device *xdev)
+{
+	struct capture_device *d = capture_device(xdev);
+
+	xrt_device_update_inputs(d->target);
+
+	// The inputs array is shared with the target.
+	uint32_t count = (uint32_t)MIN(d->target->input_count, CAPTURE_MAX_INPUTS);
+	for (uint32_t i = 0; i < count; i++) {
+		const struct xrt_input *in = &d->target->inputs[i];
+		struct xrt_input *last = &d->last_inputs[i];
+
+		if (in->active == last->active && memcmp(&in->value, &last->value, sizeof(in->value)) == 0) {
+			continue;
+		}
+		*last = *in;
+
+		// Poses are captured through get_tracked_pose.
+		if (XRT_GET_INPUT_TYPE(in->name) == XRT_INPUT_TYPE_POSE ||
+		    XRT_GET_INPUT_TYPE(in->name) == XRT_INPUT_TYPE_HAND_TRACKING) {
+			continue;
+		}
+
+		struct capture_record_input rec = {0};
+		fill_header(d, &rec.hdr, CAPTURE_RECORD_INPUT, CAPTURE_RECORD_SIZE(struct capture_record_input));
+		rec.input_index = i;
+		rec.active = in->active;
+		rec.input_timestamp_ns = in->timestamp;
+		rec.value = in->value;
+
+		WRITE_RECORD(d->writer, &rec);
+	}
+}
+
+static void
+capture_device_get_tracked_pose(struct xrt_device *xdev,
+                                enum xrt_input_name name,
+                                uint64_t at_timestamp_ns,
+                                struct xrt_space_relation *out_relation)
+{
+	struct capture_device *d = capture_device(xdev);
+
+	xrt_device_get_tracked_pose(d->target, name, at_timestamp_ns, out_relation);
+
+	struct capture_record_pose rec = {0};
+	fill_header(d, &rec.hdr, CAPTURE_RECORD_POSE, CAPTURE_RECORD_SIZE(struct capture_record_pose));
+	rec.input_name = (uint32_t)name;
+	rec.at_timestamp_ns = (int64_t)at_timestamp_ns;
+	rec.relation = *out_relation;
+
+	WRITE_RECORD(d->writer, &rec);
+}
+
+static void
+capture_device_get_hand_tracking(struct xrt_device *xdev,
+                                 enum xrt_input_name name,
+                                 uint64_t at_timestamp_ns,
+                                 struct xrt_hand_joint_set *out_value,
+                                 uint64_t *out_timestamp_ns)
+{
+	struct capture_device *d = capture_device(xdev);
+
+	xrt_device_get_hand_tracking(d->target, name, at_timestamp_ns, out_value, out_timestamp_ns);
+
+	// Big records, don't write inactive hands.
+	if (!out_value->is_active) {
+		return;
+	}
+
+	struct capture_record_hand rec = {0};
+	fill_header(d, &rec.hdr, CAPTURE_RECORD_HAND, CAPTURE_RECORD_SIZE(struct capture_record_hand));
+	rec.input_name = (uint32_t)name;
+	rec.at_timestamp_ns = (int64_t)at_timestamp_ns;
+	rec.out_timestamp_ns = (int64_t)*out_timestamp_ns;
+	rec.value = *out_value;
+
+	WRITE_RECORD(d->writer, &rec);
+}
+
+static void
+capture_device_get_view_poses(struct xrt_device *xdev,
+                              const struct xrt_vec3 *default_eye_relation,
+                              uint64_t at_timestamp_ns,
+                              uint32_t view_count,
+                              struct xrt_space_relation *out_head_relation,
+                              struct xrt_fov *out_fovs,
+                              struct xrt_pose *out_poses)
+{
+	struct capture_device *d = capture_device(xdev);
+
+	xrt_device_get_view_poses(d->target, default_eye_relation, at_timestamp_ns, view_count, out_head_relation,
+	                          out_fovs, out_poses);
+
+	// The head pose used for rendering is the most interesting one.
+	struct capture_record_pose rec = {0};
+	fill_header(d, &rec.hdr, CAPTURE_RECORD_POSE, CAPTURE_RECORD_SIZE(struct capture_record_pose));
+	rec.input_name = (uint32_t)XRT_INPUT_GENERIC_HEAD_POSE;
+	rec.at_timestamp_ns = (int64_t)at_timestamp_ns;
+	rec.relation = *out_head_relation;
+
+	WRITE_RECORD(d->writer, &rec);
+}
+
+static void
+capture_device_set_output(struct xrt_device *xdev, enum xrt_output_name name, const union xrt_output_value *value)
+{
+	struct capture_device *d = capture_device(xdev);
+	xrt_device_set_output(d->target, name, value);
+}
+
+static bool
+capture_device_compute_distortion(struct xrt_device *xdev, uint32_t view, float u, float v, struct xrt_uv_triplet *result)
+{
+	struct capture_device *d = capture_device(xdev);
+	return xrt_device_compute_distortion(d->target, view, u, v, result);
+}
+
+static bool
+capture_device_is_form_factor_available(struct xrt_device *xdev, enum xrt_form_factor form_factor)
+{
+	struct capture_device *d = capture_device(xdev);
+	return xrt_device_is_form_factor_available(d->target, form_factor);
+}
+
+static void
+capture_device_destroy(struct xrt_device *xdev)
+{
+	struct capture_device *d = capture_device(xdev);
+
+	xrt_device_destroy(&d->target);
+	writer_unref(&d->writer);
+
+	free(d);
+}
+
+static struct xrt_device *
+capture_device_create(struct capture_writer *w, struct xrt_device *target, uint16_t index)
+{
+	struct capture_device *d = U_TYPED_CALLOC(struct capture_device);
+
+	// Mimic the target, inputs and outputs arrays are shared.
+	d->base = *target;
+	d->target = target;
+	d->index = index;
+
+	d->base.update_inputs = capture_device_update_inputs;
+	d->base.get_tracked_pose = capture_device_get_tracked_pose;
+	d->base.get_hand_tracking = capture_device_get_hand_tracking;
+	d->base.set_output = capture_device_set_output;
+	d->base.destroy = capture_device_destroy;
+	if (target->get_view_poses != NULL) {
+		d->base.get_view_poses = capture_device_get_view_poses;
+	}
+	if (target->compute_distortion != NULL) {
+		d->base.compute_distortion = capture_device_compute_distortion;
+	}
+	if (target->is_form_factor_available != NULL) {
+		d->base.is_form_factor_available = capture_device_is_form_factor_available;
+	}
+
+	xrt_reference_inc(&w->reference);
+	d->writer = w;
+
+	return &d->base;
+}
+
+
+/*
+ *
+ * 'Exported' functions.
+ *
+ */
+
+xrt_result_t
+capture_wrap_system_devices(struct xrt_system_devices *xsysd, const char *path)
+{
+	if (xsysd->xdev_count > CAPTURE_MAX_DEVICES) {
+		CAPTURE_ERROR("Too many devices to capture: %zu", xsysd->xdev_count);
+		return XRT_ERROR_DEVICE_CREATION_FAILED;
+	}
+
+	FILE *file = fopen(path, "wb");
+	if (file == NULL) {
+		CAPTURE_ERROR("Could not open '%s' for writing.", path);
+		return XRT_ERROR_DEVICE_CREATION_FAILED;
+	}
+
+	struct capture_writer *w = U_TYPED_CALLOC(struct capture_writer);
+	w->file = file;
+	w->buffer = U_TYPED_ARRAY_CALLOC(char, CAPTURE_WRITE_BUFFER_SIZE);
+	setvbuf(w->file, w->buffer, _IOFBF, CAPTURE_WRITE_BUFFER_SIZE);
+	os_mutex_init(&w->mutex);
+
+	// Hold a reference while wrapping, released at the end.
+	xrt_reference_inc(&w->reference);
+
+	struct capture_file_header *header = U_TYPED_CALLOC(struct capture_file_header);
+	memcpy(header->magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));
+	header->version = CAPTURE_VERSION;
+	header->header_size = sizeof(*header);
+	header->pose_record_size = CAPTURE_RECORD_SIZE(struct capture_record_pose);
+	header->hand_record_size = CAPTURE_RECORD_SIZE(struct capture_record_hand);
+	header->input_record_size = CAPTURE_RECORD_SIZE(struct capture_record_input);
+	header->device_count = (uint32_t)xsysd->xdev_count;
+	header->start_ns = (int64_t)os_monotonic_get_ns();
+
+	for (size_t i = 0; i < xsysd->xdev_count; i++) {
+		fill_desc(xsysd, xsysd->xdevs[i], &header->devices[i]);
+	}
+
+	bool ok = fwrite(header, sizeof(*header), 1, w->file) == 1;
+	free(header);
+
+	if (!ok) {
+		CAPTURE_ERROR("Could not write header to '%s'.", path);
+		writer_unref(&w);
+		return XRT_ERROR_DEVICE_CREATION_FAILED;
+	}
+
+	for (size_t i = 0; i < xsysd->xdev_count; i++) {
+		struct xrt_device *target = xsysd->xdevs[i];
+		struct xrt_device *wrapper = capture_device_create(w, target, (uint16_t)i);
+
+		// Swap out the device in all roles.
+#define SWAP(ROLE)                                                                                                     \
+	do {                                                                                                           \
+		if (xsysd->roles.ROLE == target) {                                                                     \
+			xsysd->roles.ROLE = wrapper;                                                                   \
+		}                                                                                                      \
+	} while (false)
+
+		SWAP(head);
+		SWAP(left);
+		SWAP(right);
+		SWAP(gamepad);
+		SWAP(eyes);
+		SWAP(hand_tracking.left);
+		SWAP(hand_tracking.right);
+
+#undef SWAP
+
+		xsysd->xdevs[i] = wrapper;
+	}
+
+	CAPTURE_INFO("Capturing %zu devices to '%s'.", xsysd->xdev_count, path);
+
+	writer_unref(&w);
+
+	return XRT_SUCCESS;
+}
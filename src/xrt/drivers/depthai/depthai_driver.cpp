@@ -621,8 +621,8 @@ depthai_imu_mainloop(void *ptr)
 	os_thread_helper_name(&depthai->imu_thread, "DepthAI: IMU");
 
 #ifdef XRT_OS_LINUX
-	// Try to raise priority of this thread.
-	u_linux_try_to_set_realtime_priority_on_thread(depthai->log_level, "DepthAI: IMU");
+	// Policy and CPUs from the config, raises priority by default.
+	u_linux_thread_class_apply(OS_THREAD_CLASS_DRIVER_IO, depthai->log_level, "DepthAI: IMU");
 #endif
 
 	DEPTHAI_DEBUG(depthai, "DepthAI: IMU thread called");
@@ -0,0 +1,576 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Headless benchmark of the SLAM and hand trackers on EuRoC datasets.
+ * @author agent <agent@local>
+ * @ingroup drv_euroc
+ */
+
+#include "euroc_interface.h"
+
+#include "os/os_time.h"
+#include "math/m_api.h"
+#include "math/m_vec3.h"
+#include "tracking/t_tracking.h"
+#include "util/u_file.h"
+#include "util/u_json.h"
+#include "util/u_logging.h"
+#include "util/u_misc.h"
+
+#include "xrt/xrt_config_build.h"
+#include "xrt/xrt_config_drivers.h"
+#include "xrt/xrt_frame.h"
+#include "xrt/xrt_frameserver.h"
+#include "xrt/xrt_tracking.h"
+
+#ifdef XRT_BUILD_DRIVER_HANDTRACKING
+#include "tracking/t_hand_tracking.h"
+#include "../../tracking/hand/mercury/hg_interface.h"
+#endif
+
+#include <opencv2/core.hpp>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+#include <stdio.h>
+
+using std::map;
+using std::mutex;
+using std::unique_lock;
+using std::unordered_map;
+using std::vector;
+
+
+/*
+ *
+ * Structs and defines.
+ *
+ */
+
+//! How long the SLAM system can go without giving a pose before we consider it done.
+#define DRAIN_TIMEOUT_NS (2 * U_TIME_1S_IN_NS)
+
+struct euroc_benchmark;
+
+//! Sits between the player and the trackers, one per camera.
+struct benchmark_cam_sink
+{
+	struct xrt_frame_sink base;
+	struct euroc_benchmark *eb;
+	int index;
+};
+
+//! Records the groundtruth and passes it on to the SLAM tracker.
+struct benchmark_gt_sink
+{
+	struct xrt_pose_sink base;
+	struct euroc_benchmark *eb;
+};
+
+struct euroc_benchmark
+{
+	//! What the player pushes into.
+	struct xrt_slam_sinks sinks;
+	struct benchmark_cam_sink cam_sinks[2];
+	struct benchmark_gt_sink gt_sink;
+
+	//! SLAM tracker sinks, NULL if not benchmarking SLAM.
+	struct xrt_slam_sinks *slam_sinks;
+
+	//! Protects everything below, the SLAM callback comes from its own thread.
+	mutex lock;
+
+	struct
+	{
+		//! Monotonic time each frame was pushed, keyed on frame timestamp.
+		unordered_map<timepoint_ns, timepoint_ns> pushed;
+		map<timepoint_ns, xrt_vec3> gt;
+		map<timepoint_ns, xrt_vec3> tracked;
+
+		vector<double> processing_ms;
+		vector<double> latency_ms;
+		vector<double> interval_ms;
+
+		timepoint_ns last_pose_ns;
+		uint64_t frame_count;
+		uint64_t pose_count;
+	} slam;
+
+#ifdef XRT_BUILD_DRIVER_HANDTRACKING
+	struct
+	{
+		struct t_hand_tracking_sync *sync;
+		struct xrt_frame *left;
+
+		vector<double> processing_ms;
+		uint64_t frame_count;
+		uint64_t left_count;
+		uint64_t right_count;
+	} hand;
+#endif
+};
+
+
+/*
+ *
+ * Statistics.
+ *
+ */
+
+static void
+add_distribution(cJSON *parent, const char *name, vector<double> values)
+{
+	cJSON *obj = cJSON_AddObjectToObject(parent, name);
+	cJSON_AddNumberToObject(obj, "count", (double)values.size());
+	if (values.empty()) {
+		return;
+	}
+
+	std::sort(values.begin(), values.end());
+	auto percentile = [&](double p) { return values[(size_t)(p * (double)(values.size() - 1) + 0.5)]; };
+	double sum = std::accumulate(values.begin(), values.end(), 0.0);
+
+	cJSON_AddNumberToObject(obj, "mean", sum / (double)values.size());
+	cJSON_AddNumberToObject(obj, "min", values.front());
+	cJSON_AddNumberToObject(obj, "p50", percentile(0.50));
+	cJSON_AddNumberToObject(obj, "p90", percentile(0.90));
+	cJSON_AddNumberToObject(obj, "p99", percentile(0.99));
+	cJSON_AddNumberToObject(obj, "max", values.back());
+}
+
+static bool
+gt_position_at(const map<timepoint_ns, xrt_vec3> &gt, timepoint_ns ts, xrt_vec3 *out_pos)
+{
+	auto rit = gt.lower_bound(ts);
+	if (rit == gt.end()) {
+		return false;
+	}
+	if (rit->first == ts) {
+		*out_pos = rit->second;
+		return true;
+	}
+	if (rit == gt.begin()) {
+		return false;
+	}
+
+	auto lit = std::prev(rit);
+	float t = (float)((double)(ts - lit->first) / (double)(rit->first - lit->first));
+	*out_pos = m_vec3_lerp(lit->second, rit->second, t);
+	return true;
+}
+
+/*!
+ * Absolute trajectory error, the tracked positions are rigidly aligned to the
+ * groundtruth over the whole run (Horn/Umeyama without scale) before
+ * comparing, so this does not depend on the origin the tracker picked.
+ */
+static void
+add_trajectory_error(cJSON *parent, const map<timepoint_ns, xrt_vec3> &gt, const map<timepoint_ns, xrt_vec3> &tracked)
+{
+	vector<cv::Vec3d> a; // Tracked
+	vector<cv::Vec3d> b; // Groundtruth
+	for (const auto &[ts, pos] : tracked) {
+		xrt_vec3 gt_pos;
+		if (gt_position_at(gt, ts, &gt_pos)) {
+			a.emplace_back(pos.x, pos.y, pos.z);
+			b.emplace_back(gt_pos.x, gt_pos.y, gt_pos.z);
+		}
+	}
+
+	cJSON *obj = cJSON_AddObjectToObject(parent, "trajectory_error_mm");
+	cJSON_AddNumberToObject(obj, "count", (double)a.size());
+	if (a.size() < 3) {
+		return;
+	}
+
+	cv::Vec3d mean_a = std::accumulate(a.begin(), a.end(), cv::Vec3d{}) / (double)a.size();
+	cv::Vec3d mean_b = std::accumulate(b.begin(), b.end(), cv::Vec3d{}) / (double)b.size();
+
+	cv::Matx33d cov = cv::Matx33d::zeros();
+	for (size_t i = 0; i < a.size(); i++) {
+		cov += (b[i] - mean_b) * (a[i] - mean_a).t();
+	}
+
+	cv::Matx33d u;
+	cv::Matx33d vt;
+	cv::Matx31d w;
+	cv::SVD::compute(cov, w, u, vt);
+
+	// Make sure we get a rotation and not a reflection.
+	cv::Matx33d s = cv::Matx33d::eye();
+	if (cv::determinant(u * vt) < 0) {
+		s(2, 2) = -1;
+	}
+	cv::Matx33d r = u * s * vt;
+	cv::Vec3d t = mean_b - r * mean_a;
+
+	vector<double> errors_mm;
+	errors_mm.reserve(a.size());
+	double sum_sq = 0.0;
+	for (size_t i = 0; i < a.size(); i++) {
+		double e = cv::norm(r * a[i] + t - b[i]) * 1000.0;
+		errors_mm.push_back(e);
+		sum_sq += e * e;
+	}
+
+	cJSON_AddNumberToObject(obj, "rmse", sqrt(sum_sq / (double)errors_mm.size()));
+	add_distribution(obj, "distribution", errors_mm);
+}
+
+
+/*
+ *
+ * Sinks.
+ *
+ */
+
+#ifdef XRT_BUILD_DRIVER_HANDTRACKING
+static void
+hand_push(struct euroc_benchmark *eb, struct xrt_frame *xf, int index)
+{
+	// The player pushes the cameras in order from the same thread.
+	if (index == 0) {
+		xrt_frame_reference(&eb->hand.left, xf);
+		return;
+	}
+
+	if (eb->hand.left == NULL || eb->hand.left->timestamp != xf->timestamp) {
+		return;
+	}
+
+	struct xrt_hand_joint_set left = {};
+	struct xrt_hand_joint_set right = {};
+	uint64_t out_ts = 0;
+
+	timepoint_ns start = os_monotonic_get_ns();
+	t_ht_sync_process(eb->hand.sync, eb->hand.left, xf, &left, &right, &out_ts);
+	timepoint_ns end = os_monotonic_get_ns();
+
+	xrt_frame_reference(&eb->hand.left, NULL);
+
+	eb->hand.processing_ms.push_back(time_ns_to_ms_f(end - start));
+	eb->hand.frame_count++;
+	eb->hand.left_count += left.is_active ? 1 : 0;
+	eb->hand.right_count += right.is_active ? 1 : 0;
+}
+#endif
+
+static void
+benchmark_cam_push(struct xrt_frame_sink *xfs, struct xrt_frame *xf)
+{
+	struct benchmark_cam_sink *bcs = container_of(xfs, struct benchmark_cam_sink, base);
+	struct euroc_benchmark *eb = bcs->eb;
+
+	if (eb->slam_sinks != NULL) {
+		if (bcs->index == 0) {
+			unique_lock<mutex> lk(eb->lock);
+			eb->slam.pushed[(timepoint_ns)xf->timestamp] = os_monotonic_get_ns();
+			eb->slam.frame_count++;
+		}
+		xrt_sink_push_frame(eb->slam_sinks->cams[bcs->index], xf);
+	}
+
+#ifdef XRT_BUILD_DRIVER_HANDTRACKING
+	if (eb->hand.sync != NULL) {
+		hand_push(eb, xf, bcs->index);
+	}
+#endif
+}
+
+static void
+benchmark_gt_push(struct xrt_pose_sink *xps, struct xrt_pose_sample *sample)
+{
+	struct benchmark_gt_sink *bgs = container_of(xps, struct benchmark_gt_sink, base);
+	struct euroc_benchmark *eb = bgs->eb;
+
+	{
+		unique_lock<mutex> lk(eb->lock);
+		eb->slam.gt[sample->timestamp_ns] = sample->pose.position;
+	}
+
+	if (eb->slam_sinks != NULL && eb->slam_sinks->gt != NULL) {
+		xrt_sink_push_pose(eb->slam_sinks->gt, sample);
+	}
+}
+
+static void
+benchmark_slam_pose(
+    void *userdata, timepoint_ns ts, const struct xrt_pose *pose, const timepoint_ns *timing, size_t timing_count)
+{
+	struct euroc_benchmark *eb = (struct euroc_benchmark *)userdata;
+	unique_lock<mutex> lk(eb->lock);
+
+	timepoint_ns now = os_monotonic_get_ns();
+
+	/*
+	 * The columns are sampled, [SLAM system timestamps...], received. When
+	 * the SLAM system gives us timestamps they are more precise than when
+	 * we got around to dequeuing the pose.
+	 */
+	timepoint_ns done = timing[timing_count - 1];
+	if (timing_count > 2) {
+		done = timing[timing_count - 2];
+		eb->slam.processing_ms.push_back(time_ns_to_ms_f(done - timing[1]));
+	}
+
+	auto it = eb->slam.pushed.find(ts);
+	if (it != eb->slam.pushed.end()) {
+		eb->slam.latency_ms.push_back(time_ns_to_ms_f(done - it->second));
+		eb->slam.pushed.erase(it);
+	}
+
+	if (eb->slam.pose_count > 0) {
+		eb->slam.interval_ms.push_back(time_ns_to_ms_f(now - eb->slam.last_pose_ns));
+	}
+
+	eb->slam.tracked[ts] = pose->position;
+	eb->slam.last_pose_ns = now;
+	eb->slam.pose_count++;
+}
+
+
+/*
+ *
+ * Setup.
+ *
+ */
+
+#ifdef XRT_FEATURE_SLAM
+static struct xrt_tracked_slam *
+create_slam(struct euroc_benchmark *eb,
+            struct xrt_frame_context *xfctx,
+            const struct euroc_benchmark_config *config,
+            int cam_count)
+{
+	struct t_slam_tracker_config st_config;
+	t_slam_fill_default_config(&st_config);
+
+	if (getenv("SLAM_LOG") == NULL) {
+		st_config.log_level = U_LOGGING_WARN;
+	}
+	st_config.slam_config = config->slam_config;
+	st_config.cam_count = cam_count;
+	st_config.submit_from_start = true;
+	st_config.prediction = SLAM_PRED_NONE;
+	st_config.write_csvs = false;
+	st_config.timing_stat = true;
+	st_config.pose_cb = benchmark_slam_pose;
+	st_config.pose_cb_userdata = eb;
+
+	struct xrt_tracked_slam *xts = NULL;
+	int ret = t_slam_create(xfctx, &st_config, &xts, &eb->slam_sinks);
+	if (ret != 0) {
+		return NULL;
+	}
+
+	t_slam_start(xts);
+	return xts;
+}
+#endif
+
+#ifdef XRT_BUILD_DRIVER_HANDTRACKING
+static bool
+create_hand(struct euroc_benchmark *eb, const struct euroc_benchmark_config *config)
+{
+	char models[1024] = {0};
+	if (u_file_get_hand_tracking_models_dir(models, ARRAY_SIZE(models)) < 0) {
+		U_LOG_E("Could not find any directory with hand-tracking models!");
+		return false;
+	}
+
+	struct t_stereo_camera_calibration *calib = NULL;
+	if (!t_stereo_camera_calibration_load(config->hand_calib, &calib)) {
+		U_LOG_E("Could not load stereo calibration '%s'", config->hand_calib);
+		return false;
+	}
+
+	struct t_camera_extra_info extra = {};
+	extra.views[0].boundary_type = HT_IMAGE_BOUNDARY_NONE;
+	extra.views[1].boundary_type = HT_IMAGE_BOUNDARY_NONE;
+
+	eb->hand.sync = t_hand_tracking_sync_mercury_create(calib, extra, models);
+	t_stereo_camera_calibration_reference(&calib, NULL);
+
+	return eb->hand.sync != NULL;
+}
+#endif
+
+static cJSON *
+make_report(struct euroc_benchmark *eb, const struct euroc_benchmark_config *config, timepoint_ns duration_ns)
+{
+	cJSON *root = cJSON_CreateObject();
+	cJSON_AddStringToObject(root, "dataset", config->euroc_path);
+	cJSON_AddNumberToObject(root, "speed", config->speed);
+	cJSON_AddNumberToObject(root, "wall_time_s", time_ns_to_s(duration_ns));
+
+	unique_lock<mutex> lk(eb->lock);
+
+	if (eb->slam_sinks != NULL) {
+		cJSON *slam = cJSON_AddObjectToObject(root, "slam");
+		cJSON_AddNumberToObject(slam, "frames", (double)eb->slam.frame_count);
+		cJSON_AddNumberToObject(slam, "poses", (double)eb->slam.pose_count);
+		add_distribution(slam, "processing_ms", eb->slam.processing_ms);
+		add_distribution(slam, "latency_ms", eb->slam.latency_ms);
+		add_distribution(slam, "interval_ms", eb->slam.interval_ms);
+		if (!eb->slam.gt.empty()) {
+			add_trajectory_error(slam, eb->slam.gt, eb->slam.tracked);
+		}
+	}
+
+#ifdef XRT_BUILD_DRIVER_HANDTRACKING
+	if (eb->hand.sync != NULL) {
+		cJSON *hand = cJSON_AddObjectToObject(root, "hand");
+		cJSON_AddNumberToObject(hand, "frames", (double)eb->hand.frame_count);
+		cJSON_AddNumberToObject(hand, "left_tracked", (double)eb->hand.left_count);
+		cJSON_AddNumberToObject(hand, "right_tracked", (double)eb->hand.right_count);
+		add_distribution(hand, "processing_ms", eb->hand.processing_ms);
+	}
+#endif
+
+	return root;
+}
+
+
+/*
+ *
+ * 'Exported' functions.
+ *
+ */
+
+extern "C" int
+euroc_run_benchmark(const struct euroc_benchmark_config *config,
+                    const char *output_path,
+                    const volatile bool *should_exit)
+{
+#ifndef XRT_FEATURE_SLAM
+	if (config->slam_config != NULL) {
+		U_LOG_E("No SLAM system built.");
+		return -1;
+	}
+#endif
+#ifndef XRT_BUILD_DRIVER_HANDTRACKING
+	if (config->hand_calib != NULL) {
+		U_LOG_E("Hand tracking not built.");
+		return -1;
+	}
+#endif
+
+	struct euroc_player_config ep_config;
+	euroc_player_fill_default_config_for(&ep_config, config->euroc_path);
+	if (getenv("EUROC_LOG") == NULL) {
+		ep_config.log_level = U_LOGGING_WARN;
+	}
+	ep_config.playback.play_from_start = true;
+	ep_config.playback.print_progress = false;
+	ep_config.playback.use_source_ts = true;
+	ep_config.playback.max_speed = config->speed <= 0.0;
+	ep_config.playback.speed = config->speed > 0.0 ? config->speed : 1.0;
+	ep_config.playback.gt = ep_config.dataset.has_gt;
+
+	if (config->hand_calib != NULL && ep_config.dataset.cam_count < 2) {
+		U_LOG_E("Hand tracking needs a stereo dataset.");
+		return -1;
+	}
+
+	auto eb = new euroc_benchmark{};
+	struct xrt_frame_context xfctx = {};
+	int cam_count = MIN(ep_config.dataset.cam_count, 2);
+	int ret = 0;
+
+#ifdef XRT_FEATURE_SLAM
+	if (config->slam_config != NULL && create_slam(eb, &xfctx, config, cam_count) == NULL) {
+		U_LOG_E("Failed to create the SLAM tracker.");
+		ret = -1;
+	}
+#endif
+#ifdef XRT_BUILD_DRIVER_HANDTRACKING
+	if (ret == 0 && config->hand_calib != NULL && !create_hand(eb, config)) {
+		U_LOG_E("Failed to create the hand tracker.");
+		ret = -1;
+	}
+#endif
+
+	if (ret != 0) {
+		xrt_frame_context_destroy_nodes(&xfctx);
+		delete eb;
+		return ret;
+	}
+
+	ep_config.playback.cam_count = cam_count;
+	eb->sinks.cam_count = cam_count;
+	for (int i = 0; i < cam_count; i++) {
+		eb->cam_sinks[i].base.push_frame = benchmark_cam_push;
+		eb->cam_sinks[i].eb = eb;
+		eb->cam_sinks[i].index = i;
+		eb->sinks.cams[i] = &eb->cam_sinks[i].base;
+	}
+	eb->sinks.imu = eb->slam_sinks != NULL ? eb->slam_sinks->imu : NULL;
+	eb->gt_sink.base.push_pose = benchmark_gt_push;
+	eb->gt_sink.eb = eb;
+	eb->sinks.gt = &eb->gt_sink.base;
+
+	timepoint_ns start_ns = os_monotonic_get_ns();
+
+	struct xrt_fs *xfs = euroc_player_create(&xfctx, config->euroc_path, &ep_config);
+	xrt_fs_slam_stream_start(xfs, &eb->sinks);
+
+	while (xrt_fs_is_running(xfs) && !*should_exit) {
+		os_nanosleep(U_TIME_1MS_IN_NS * 50);
+	}
+
+	// Give the SLAM system time to work through its queue.
+	timepoint_ns last_progress_ns = os_monotonic_get_ns();
+	uint64_t last_pose_count = 0;
+	while (eb->slam_sinks != NULL && !*should_exit) {
+		os_nanosleep(U_TIME_1MS_IN_NS * 50);
+
+		timepoint_ns now = os_monotonic_get_ns();
+		unique_lock<mutex> lk(eb->lock);
+		if (eb->slam.pose_count >= eb->slam.frame_count) {
+			break;
+		}
+		if (eb->slam.pose_count != last_pose_count) {
+			last_pose_count = eb->slam.pose_count;
+			last_progress_ns = now;
+		} else if (now - last_progress_ns > DRAIN_TIMEOUT_NS) {
+			break;
+		}
+	}
+
+	timepoint_ns end_ns = os_monotonic_get_ns();
+
+	// Stops the player and the SLAM tracker, nothing is pushed after this.
+	xrt_frame_context_destroy_nodes(&xfctx);
+
+	cJSON *report = make_report(eb, config, end_ns - start_ns);
+	char *str = cJSON_Print(report);
+	cJSON_Delete(report);
+
+#ifdef XRT_BUILD_DRIVER_HANDTRACKING
+	xrt_frame_reference(&eb->hand.left, NULL);
+	t_ht_sync_destroy(&eb->hand.sync);
+#endif
+	delete eb;
+
+	FILE *file = output_path != NULL ? fopen(output_path, "w") : stdout;
+	if (file == NULL) {
+		U_LOG_E("Could not open '%s' for writing", output_path);
+		free(str);
+		return -1;
+	}
+
+	fprintf(file, "%s\n", str);
+	free(str);
+
+	if (file != stdout) {
+		fclose(file);
+	}
+
+	return 0;
+}
@@ -117,6 +117,35 @@ euroc_run_dataset(const char *euroc_path,
                   const char *output_path,
                   const volatile bool *should_exit);
 
+/*!
+ * Configuration for @ref euroc_run_benchmark.
+ *
+ * @ingroup drv_euroc
+ */
+struct euroc_benchmark_config
+{
+	const char *euroc_path;  //!< Dataset path
+	const char *slam_config; //!< Config file for the SLAM system, NULL to not run SLAM
+	const char *hand_calib;  //!< Stereo calibration for Mercury hand tracking, NULL to not run it
+	double speed;            //!< Playback speed factor, zero to push samples as fast as possible
+};
+
+/*!
+ * Plays a dataset through the SLAM and/or hand tracker without any UI and
+ * writes per frame processing time, pose latency and trajectory error
+ * statistics as JSON.
+ *
+ * @param config What to run and how fast
+ * @param output_path File to write the JSON report to, NULL for stdout
+ * @param should_exit External exit condition, the run will end if it becomes true
+ *
+ * @ingroup drv_euroc
+ */
+int
+euroc_run_benchmark(const struct euroc_benchmark_config *config,
+                    const char *output_path,
+                    const volatile bool *should_exit);
+
 /*!
  * @dir drivers/euroc
  *
@@ -281,7 +281,7 @@ parse_frame_data(const struct xrt_frame *xf, union rift_s_frame_data *row_data)
 	if (xf->width != 50 * 8 * 8 || xf->height < 8)
 		return false;
 
-	uint8_t *pix = &xf->data[xf->width * 4];
+	uint8_t *pix = &xf->data[xf->stride * 4];
 
 	int bit = 7;
 	for (x = 4, out_x = 0; x < xf->width; x += 8) {
@@ -329,22 +329,15 @@ get_y_offset(struct rift_s_camera *cam, enum rift_s_camera_id cam_id, union rift
 	return y_offset;
 }
 
-static struct xrt_frame *
-rift_s_camera_extract_frame(struct rift_s_camera *cam,
-                            enum rift_s_camera_id cam_id,
-                            struct xrt_frame *full_frame,
-                            union rift_s_frame_data *row_data)
+static struct xrt_rect
+get_camera_roi(struct rift_s_camera *cam, enum rift_s_camera_id cam_id, union rift_s_frame_data *row_data)
 {
 	struct rift_s_camera_calibration *calib = &cam->camera_calibration->cameras[cam_id];
 	struct xrt_rect roi = calib->roi;
 
 	roi.offset.h = get_y_offset(cam, cam_id, row_data);
 
-	struct xrt_frame *xf_crop = NULL;
-
-	u_frame_create_roi(full_frame, roi, &xf_crop);
-
-	return xf_crop;
+	return roi;
 }
 
 static void
@@ -375,7 +368,7 @@ receive_cam_frame(struct xrt_frame_sink *sink, struct xrt_frame *xf)
 
 	if (!parse_frame_data(xf, &row_data)) {
 		RIFT_S_TRACE("Invalid frame top-row data. Skipping");
-		return;
+		goto out;
 	}
 
 	RIFT_S_DEBUG("frame ctr %u ts %" PRIu64
@@ -390,20 +383,25 @@ receive_cam_frame(struct xrt_frame_sink *sink, struct xrt_frame *xf)
 
 	// If the top left pixel is > 128, send as SLAM frame else controller
 	if (row_data.data.frame_type & 0x80) {
-		int y_offset = get_y_offset(cam, 0, &row_data);
-		struct xrt_rect roi = {.offset = {0, y_offset}, .extent = {.w = xf->width, .h = 480}};
-
-		struct xrt_frame *xf_crop = NULL;
-		u_frame_create_roi(xf, roi, &xf_crop);
-		u_sink_debug_push_frame(&cam->debug_sinks[0], xf_crop);
-		xrt_frame_reference(&xf_crop, NULL);
+		if (u_sink_debug_is_active(&cam->debug_sinks[0])) {
+			int y_offset = get_y_offset(cam, 0, &row_data);
+			struct xrt_rect roi = {.offset = {0, y_offset}, .extent = {.w = xf->width, .h = 480}};
+
+			struct xrt_frame *xf_crop = NULL;
+			u_frame_create_roi(xf, roi, &xf_crop);
+			u_sink_debug_push_frame(&cam->debug_sinks[0], xf_crop);
+			xrt_frame_reference(&xf_crop, NULL);
+		}
 
-		/* Extract camera frames and push to the tracker */
-		struct xrt_frame *frames[RIFT_S_CAMERA_COUNT] = {0};
+		/* Extract camera views, they all reference the full frame without copying */
+		struct xrt_rect rois[RIFT_S_CAMERA_COUNT];
 		for (int i = 0; i < RIFT_S_CAMERA_COUNT; i++) {
-			frames[i] = rift_s_camera_extract_frame(cam, CAM_IDX_TO_ID[i], xf, &row_data);
+			rois[i] = get_camera_roi(cam, CAM_IDX_TO_ID[i], &row_data);
 		}
 
+		struct xrt_frame *frames[RIFT_S_CAMERA_COUNT] = {0};
+		u_frame_create_rois(xf, rois, RIFT_S_CAMERA_COUNT, frames);
+
 		/* Update the exposure for all cameras based on the auto exposure for the left camera view */
 		//! @todo Update expgain independently for each camera like in WMR
 		update_expgain(cam, frames[0]);
@@ -414,7 +412,7 @@ receive_cam_frame(struct xrt_frame_sink *sink, struct xrt_frame *xf)
 		for (int i = 0; i < RIFT_S_CAMERA_COUNT; i++) {
 			xrt_frame_reference(&frames[i], NULL);
 		}
-	} else {
+	} else if (u_sink_debug_is_active(&cam->debug_sinks[1])) {
 		struct xrt_rect roi = {.offset = {0, 40}, .extent = {.w = xf->width, .h = 480}};
 		struct xrt_frame *xf_crop = NULL;
 
@@ -422,6 +420,8 @@ receive_cam_frame(struct xrt_frame_sink *sink, struct xrt_frame *xf)
 		u_sink_debug_push_frame(&cam->debug_sinks[1], xf_crop);
 		xrt_frame_reference(&xf_crop, NULL);
 	}
+
+out:
 	if (release_xf)
 		xrt_frame_reference(&xf, NULL);
 }
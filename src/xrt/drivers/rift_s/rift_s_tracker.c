@@ -298,6 +298,8 @@ rift_s_tracker_add_debug_ui(struct rift_s_tracker *t, void *root)
 	u_var_add_gui_header(root, NULL, "3DoF Tracking");
 	m_imu_3dof_add_vars(&t->fusion.i3dof, root, "");
 
+	m_clock_offset_estimator_add_vars(&t->hw2mono_est, root, "HMD Clock");
+
 	u_var_add_gui_header(root, NULL, "SLAM Tracking");
 	u_var_add_ro_text(root, t->gui.slam_status, "Tracker status");
 
@@ -377,6 +379,7 @@ rift_s_tracker_create(struct xrt_tracking_origin *origin,
 
 	// Initialize 3DoF tracker
 	m_imu_3dof_init(&t->fusion.i3dof, M_IMU_3DOF_USE_GRAVITY_DUR_20MS);
+	m_clock_offset_estimator_init(&t->hw2mono_est, 0);
 
 	t->pose.orientation.w = 1.0f; // All other values set to zero by U_DEVICE_ALLOCATE (which calls U_CALLOC)
 
@@ -412,15 +415,15 @@ rift_s_tracker_create(struct xrt_tracking_origin *origin,
 	// Setup sinks depending on tracking configuration
 	struct xrt_slam_sinks entry_sinks = {0};
 	if (slam_enabled && hand_enabled) {
-		struct xrt_frame_sink *entry_cam0_sink = NULL;
-		struct xrt_frame_sink *entry_cam1_sink = NULL;
-
-		u_sink_split_create(xfctx, slam_sinks->cams[0], hand_sinks->cams[0], &entry_cam0_sink);
-		u_sink_split_create(xfctx, slam_sinks->cams[1], hand_sinks->cams[1], &entry_cam1_sink);
-
 		entry_sinks = *slam_sinks;
-		entry_sinks.cams[0] = entry_cam0_sink;
-		entry_sinks.cams[1] = entry_cam1_sink;
+
+		// One hub per camera shared by all consumers of it.
+		for (int i = 0; i < 2; i++) {
+			struct u_sink_hub *hub = NULL;
+			u_sink_hub_create(xfctx, &hub, &entry_sinks.cams[i]);
+			u_sink_hub_add_derived(hub, XRT_FORMAT_L8, 0, slam_sinks->cams[i]);
+			u_sink_hub_add_derived(hub, XRT_FORMAT_L8, 0, hand_sinks->cams[i]);
+		}
 	} else if (slam_enabled) {
 		entry_sinks = *slam_sinks;
 	} else if (hand_enabled) {
@@ -461,13 +464,14 @@ rift_s_tracker_clock_update(struct rift_s_tracker *t, uint64_t device_timestamp_
 {
 	os_mutex_lock(&t->mutex);
 	time_duration_ns last_hw2mono = t->hw2mono;
-	const float freq = 250.0;
 
 	t->seen_clock_observations++;
 	if (t->seen_clock_observations < 100)
 		goto done;
 
-	m_clock_offset_a2b(freq, device_timestamp_ns, local_timestamp_ns, &t->hw2mono);
+	timepoint_ns mapped_ns =
+	    m_clock_offset_estimator_update(&t->hw2mono_est, (timepoint_ns)device_timestamp_ns, local_timestamp_ns);
+	t->hw2mono = mapped_ns - (timepoint_ns)device_timestamp_ns;
 
 	if (!t->have_hw2mono) {
 		time_duration_ns change_ns = last_hw2mono - t->hw2mono;
@@ -484,7 +488,7 @@ done:
 static void
 clock_hw2mono_get(struct rift_s_tracker *t, uint64_t device_ts, timepoint_ns *out)
 {
-	*out = t->hw2mono + device_ts;
+	*out = m_clock_offset_estimator_a2b(&t->hw2mono_est, (timepoint_ns)device_ts);
 }
 
 void
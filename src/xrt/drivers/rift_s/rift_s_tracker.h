@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include "math/m_clock_offset.h"
 #include "math/m_imu_3dof.h"
 #include "os/os_threading.h"
 #include "util/u_var.h"
@@ -87,6 +88,7 @@ struct rift_s_tracker
 	uint64_t seen_clock_observations;
 	bool have_hw2mono;
 	time_duration_ns hw2mono;
+	struct m_clock_offset_estimator hw2mono_est;
 	timepoint_ns last_frame_time;
 
 	//! Adjustment to apply to camera timestamps to bring them into the
@@ -279,8 +279,8 @@ rokid_usb_thread(void *ptr)
 	struct rokid_hmd *rokid = ptr;
 
 #ifdef XRT_OS_LINUX
-	// Try to raise priority of this thread, so we don't miss packets under load
-	u_linux_try_to_set_realtime_priority_on_thread(U_LOGGING_INFO, "Rokid USB thread");
+	// Raise priority of this thread by default, so we don't miss packets under load
+	u_linux_thread_class_apply(OS_THREAD_CLASS_DRIVER_IO, U_LOGGING_INFO, "Rokid USB thread");
 #endif
 
 	int last_libusb_result = LIBUSB_SUCCESS;
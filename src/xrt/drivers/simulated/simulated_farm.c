@@ -0,0 +1,685 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  A farm of synthetic devices, for load testing without hardware.
+ * @author agent <agent@local>
+ * @ingroup drv_simulated
+ */
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_system.h"
+#include "xrt/xrt_tracking.h"
+
+#include "os/os_time.h"
+#include "os/os_threading.h"
+
+#include "math/m_api.h"
+#include "math/m_mathinclude.h"
+#include "math/m_relation_history.h"
+
+#include "util/u_var.h"
+#include "util/u_misc.h"
+#include "util/u_json.h"
+#include "util/u_time.h"
+#include "util/u_debug.h"
+#include "util/u_device.h"
+#include "util/u_logging.h"
+#include "util/u_hand_tracking.h"
+#include "util/u_hand_simulation.h"
+
+#include "simulated_interface.h"
+
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+
+
+/*
+ *
+ * Structs and defines.
+ *
+ */
+
+//! Longest the thread sleeps, bounds how long stopping takes.
+#define FARM_MAX_SLEEP_NS (10 * U_TIME_1MS_IN_NS)
+
+struct farm_device;
+
+/*!
+ * Owns the thread, shared by all devices in the farm.
+ */
+struct simulated_farm
+{
+	struct xrt_reference reference;
+
+	//! Protects @ref devices and the device histories pushing.
+	struct os_thread_helper oth;
+
+	struct farm_device *devices[XRT_SYSTEM_MAX_DEVICES];
+	uint32_t device_count;
+
+	//! All movement is relative to this.
+	uint64_t start_ns;
+
+	//! Total number of poses pushed, all devices.
+	uint64_t push_count;
+
+	//! Number of times a device was late and skipped ahead.
+	uint64_t skip_count;
+};
+
+/*!
+ * A single synthetic device.
+ *
+ * @implements xrt_device
+ */
+struct farm_device
+{
+	struct xrt_device base;
+
+	//! One reference.
+	struct simulated_farm *farm;
+
+	//! Index in the farm.
+	uint32_t index;
+
+	enum simulated_farm_kind kind;
+
+	//! Only valid for SIMULATED_FARM_KIND_HAND.
+	enum xrt_hand hand;
+
+	//! Pushed to by the farm thread, read by get_tracked_pose.
+	struct m_relation_history *history;
+
+	//! Movement parameters.
+	struct xrt_pose center;
+	float radius_m;
+	uint32_t complexity;
+	float phase;
+	float speed;
+
+	//! Thread bookkeeping.
+	uint64_t period_ns;
+	uint64_t next_ns;
+};
+
+static inline struct farm_device *
+farm_device(struct xrt_device *xdev)
+{
+	return (struct farm_device *)xdev;
+}
+
+
+/*
+ *
+ * Movement.
+ *
+ */
+
+/*!
+ * Sum of @p complexity circles of decreasing size and increasing frequency,
+ * plus a slow spin around the up axis, velocities are exact derivatives.
+ */
+static void
+compute_relation(const struct farm_device *fd, double t, struct xrt_space_relation *out_relation)
+{
+	struct xrt_vec3 pos = fd->center.position;
+	struct xrt_vec3 vel = XRT_VEC3_ZERO;
+
+	for (uint32_t k = 1; k <= fd->complexity; k++) {
+		double r = fd->radius_m / (double)k;
+		double w = fd->speed * (double)k;
+		double a = w * t + fd->phase * (double)k;
+
+		pos.x += (float)(r * sin(a));
+		pos.y += (float)(r * 0.5 * sin(2.0 * a));
+		pos.z += (float)(r * cos(a));
+
+		vel.x += (float)(r * w * cos(a));
+		vel.y += (float)(r * w * cos(2.0 * a));
+		vel.z += (float)(-r * w * sin(a));
+	}
+
+	const struct xrt_vec3 up = {0.0f, 1.0f, 0.0f};
+	float spin = fd->speed * 0.5f;
+	struct xrt_quat rot;
+	math_quat_from_angle_vector((float)fmod(spin * t + fd->phase, 2.0 * M_PI), &up, &rot);
+	math_quat_rotate(&rot, &fd->center.orientation, &out_relation->pose.orientation);
+
+	out_relation->pose.position = pos;
+	out_relation->linear_velocity = vel;
+	out_relation->angular_velocity = (struct xrt_vec3){0.0f, spin, 0.0f};
+	out_relation->relation_flags = (enum xrt_space_relation_flags)(
+	    XRT_SPACE_RELATION_ORIENTATION_VALID_BIT | XRT_SPACE_RELATION_POSITION_VALID_BIT |
+	    XRT_SPACE_RELATION_ORIENTATION_TRACKED_BIT | XRT_SPACE_RELATION_POSITION_TRACKED_BIT |
+	    XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT | XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT);
+}
+
+static double
+farm_seconds(const struct simulated_farm *farm, uint64_t timestamp_ns)
+{
+	return time_ns_to_s((int64_t)(timestamp_ns - farm->start_ns));
+}
+
+
+/*
+ *
+ * Farm functions.
+ *
+ */
+
+static void *
+farm_run_thread(void *ptr)
+{
+	struct simulated_farm *farm = (struct simulated_farm *)ptr;
+
+	os_thread_helper_name(&farm->oth, "Simulated Farm");
+
+	os_thread_helper_lock(&farm->oth);
+
+	while (os_thread_helper_is_running_locked(&farm->oth)) {
+		uint64_t now_ns = os_monotonic_get_ns();
+		uint64_t wake_ns = now_ns + FARM_MAX_SLEEP_NS;
+
+		for (uint32_t i = 0; i < farm->device_count; i++) {
+			struct farm_device *fd = farm->devices[i];
+			if (fd == NULL) {
+				continue;
+			}
+
+			if (fd->next_ns <= now_ns) {
+				struct xrt_space_relation rel;
+				compute_relation(fd, farm_seconds(farm, now_ns), &rel);
+				m_relation_history_push(fd->history, &rel, now_ns);
+				farm->push_count++;
+
+				fd->next_ns += fd->period_ns;
+
+				// Don't try to catch up, that would just burst.
+				if (fd->next_ns <= now_ns) {
+					fd->next_ns = now_ns + fd->period_ns;
+					farm->skip_count++;
+				}
+			}
+
+			wake_ns = MIN(wake_ns, fd->next_ns);
+		}
+
+		os_thread_helper_unlock(&farm->oth);
+		os_nanosleep((int64_t)(wake_ns - now_ns));
+		os_thread_helper_lock(&farm->oth);
+	}
+
+	os_thread_helper_unlock(&farm->oth);
+
+	return NULL;
+}
+
+static void
+farm_unref(struct simulated_farm **farm_ptr)
+{
+	struct simulated_farm *farm = *farm_ptr;
+	if (farm == NULL) {
+		return;
+	}
+	*farm_ptr = NULL;
+
+	if (!xrt_reference_dec(&farm->reference)) {
+		return;
+	}
+
+	u_var_remove_root(farm);
+	os_thread_helper_destroy(&farm->oth);
+	free(farm);
+}
+
+
+/*
+ *
+ * Device functions.
+ *
+ */
+
+static void
+farm_device_update_inputs(struct xrt_device *xdev)
+{
+	struct farm_device *fd = farm_device(xdev);
+
+	uint64_t now_ns = os_monotonic_get_ns();
+
+	for (uint32_t i = 0; i < xdev->input_count; i++) {
+		xdev->inputs[i].timestamp = now_ns;
+	}
+
+	if (fd->kind != SIMULATED_FARM_KIND_CONTROLLER) {
+		return;
+	}
+
+	// Toggle select once a second, staggered per device, to exercise the action paths.
+	uint64_t seconds = (now_ns - fd->farm->start_ns) / U_TIME_1S_IN_NS + fd->index;
+	xdev->inputs[0].value.boolean = (seconds % 2) == 1;
+}
+
+static void
+farm_device_get_tracked_pose(struct xrt_device *xdev,
+                             enum xrt_input_name name,
+                             uint64_t at_timestamp_ns,
+                             struct xrt_space_relation *out_relation)
+{
+	struct farm_device *fd = farm_device(xdev);
+
+	switch (name) {
+	case XRT_INPUT_GENERIC_TRACKER_POSE:
+	case XRT_INPUT_SIMPLE_GRIP_POSE:
+	case XRT_INPUT_SIMPLE_AIM_POSE: break;
+	default:
+		U_LOG_E("Unknown input name: 0x%0x", name);
+		*out_relation = (struct xrt_space_relation)XRT_SPACE_RELATION_ZERO;
+		return;
+	}
+
+	m_relation_history_get(fd->history, at_timestamp_ns, out_relation);
+}
+
+static void
+farm_device_get_hand_tracking(struct xrt_device *xdev,
+                              enum xrt_input_name name,
+                              uint64_t at_timestamp_ns,
+                              struct xrt_hand_joint_set *out_value,
+                              uint64_t *out_timestamp_ns)
+{
+	struct farm_device *fd = farm_device(xdev);
+
+	enum xrt_input_name expected = fd->hand == XRT_HAND_LEFT ? XRT_INPUT_GENERIC_HAND_TRACKING_LEFT //
+	                                                         : XRT_INPUT_GENERIC_HAND_TRACKING_RIGHT;
+	if (fd->kind != SIMULATED_FARM_KIND_HAND || name != expected) {
+		U_LOG_E("Unknown input name for hand tracker: 0x%0x", name);
+		U_ZERO(out_value);
+		*out_timestamp_ns = at_timestamp_ns;
+		return;
+	}
+
+	struct xrt_space_relation root;
+	m_relation_history_get(fd->history, at_timestamp_ns, &root);
+
+	// Slowly open and close the hand, fingers a bit out of phase.
+	double t = farm_seconds(fd->farm, at_timestamp_ns) * fd->speed + fd->phase;
+	struct u_hand_tracking_curl_values curls = {
+	    .little = (float)(0.5 + 0.5 * sin(t + 0.4)),
+	    .ring = (float)(0.5 + 0.5 * sin(t + 0.3)),
+	    .middle = (float)(0.5 + 0.5 * sin(t + 0.2)),
+	    .index = (float)(0.5 + 0.5 * sin(t + 0.1)),
+	    .thumb = (float)(0.5 + 0.5 * sin(t)),
+	};
+
+	u_hand_sim_simulate_for_valve_index_knuckles(&curls, fd->hand, &root, out_value);
+
+	*out_timestamp_ns = at_timestamp_ns;
+}
+
+static void
+farm_device_get_view_poses(struct xrt_device *xdev,
+                           const struct xrt_vec3 *default_eye_relation,
+                           uint64_t at_timestamp_ns,
+                           uint32_t view_count,
+                           struct xrt_space_relation *out_head_relation,
+                           struct xrt_fov *out_fovs,
+                           struct xrt_pose *out_poses)
+{
+	assert(false);
+}
+
+static void
+farm_device_set_output(struct xrt_device *xdev, enum xrt_output_name name, const union xrt_output_value *value)
+{
+	// Haptics go nowhere.
+}
+
+static void
+farm_device_destroy(struct xrt_device *xdev)
+{
+	struct farm_device *fd = farm_device(xdev);
+	struct simulated_farm *farm = fd->farm;
+
+	// Take it out of the farm first so the thread stops touching it.
+	bool last = true;
+	os_thread_helper_lock(&farm->oth);
+	farm->devices[fd->index] = NULL;
+	for (uint32_t i = 0; i < farm->device_count; i++) {
+		last = last && farm->devices[i] == NULL;
+	}
+	os_thread_helper_unlock(&farm->oth);
+
+	// Last device, stop the thread before the farm goes away.
+
+	if (last) {
+		os_thread_helper_stop_and_wait(&farm->oth);
+	}
+
+	m_relation_history_destroy(&fd->history);
+	farm_unref(&fd->farm);
+
+	u_device_free(&fd->base);
+}
+
+
+/*
+ *
+ * Various data driven arrays.
+ *
+ */
+
+static enum xrt_input_name tracker_inputs_array[] = {
+    XRT_INPUT_GENERIC_TRACKER_POSE,
+};
+
+static enum xrt_input_name controller_inputs_array[] = {
+    XRT_INPUT_SIMPLE_SELECT_CLICK,
+    XRT_INPUT_SIMPLE_MENU_CLICK,
+    XRT_INPUT_SIMPLE_GRIP_POSE,
+    XRT_INPUT_SIMPLE_AIM_POSE,
+};
+
+static enum xrt_output_name controller_outputs_array[] = {
+    XRT_OUTPUT_NAME_SIMPLE_VIBRATION,
+};
+
+
+/*
+ *
+ * Creation.
+ *
+ */
+
+static struct farm_device *
+farm_device_create(struct simulated_farm *farm,
+                   const struct simulated_farm_group *group,
+                   uint32_t index,
+                   uint32_t index_in_group,
+                   struct xrt_tracking_origin *origin)
+{
+	const enum u_device_alloc_flags flags = U_DEVICE_ALLOC_NO_FLAGS;
+	enum xrt_input_name *inputs = NULL;
+	uint32_t input_count = 0;
+	enum xrt_output_name *outputs = NULL;
+	uint32_t output_count = 0;
+	enum xrt_hand hand = index_in_group % 2 == 0 ? XRT_HAND_LEFT : XRT_HAND_RIGHT;
+	enum xrt_input_name hand_input =
+	    hand == XRT_HAND_LEFT ? XRT_INPUT_GENERIC_HAND_TRACKING_LEFT : XRT_INPUT_GENERIC_HAND_TRACKING_RIGHT;
+
+	switch (group->kind) {
+	case SIMULATED_FARM_KIND_TRACKER:
+		inputs = tracker_inputs_array;
+		input_count = ARRAY_SIZE(tracker_inputs_array);
+		break;
+	case SIMULATED_FARM_KIND_CONTROLLER:
+		inputs = controller_inputs_array;
+		input_count = ARRAY_SIZE(controller_inputs_array);
+		outputs = controller_outputs_array;
+		output_count = ARRAY_SIZE(controller_outputs_array);
+		break;
+	case SIMULATED_FARM_KIND_HAND:
+		inputs = &hand_input;
+		input_count = 1;
+		break;
+	default: assert(false); return NULL;
+	}
+
+	struct farm_device *fd = U_DEVICE_ALLOCATE(struct farm_device, flags, input_count, output_count);
+	fd->base.update_inputs = farm_device_update_inputs;
+	fd->base.get_tracked_pose = farm_device_get_tracked_pose;
+	fd->base.get_hand_tracking = farm_device_get_hand_tracking;
+	fd->base.get_view_poses = farm_device_get_view_poses;
+	fd->base.set_output = farm_device_set_output;
+	fd->base.destroy = farm_device_destroy;
+	fd->base.tracking_origin = origin;
+
+	for (uint32_t i = 0; i < input_count; i++) {
+		fd->base.inputs[i].active = true;
+		fd->base.inputs[i].name = inputs[i];
+	}
+
+	for (uint32_t i = 0; i < output_count; i++) {
+		fd->base.outputs[i].name = outputs[i];
+	}
+
+	const char *kind_str = "";
+	switch (group->kind) {
+	case SIMULATED_FARM_KIND_TRACKER:
+		kind_str = "Tracker";
+		fd->base.name = XRT_DEVICE_VIVE_TRACKER;
+		fd->base.device_type = XRT_DEVICE_TYPE_GENERIC_TRACKER;
+		fd->base.orientation_tracking_supported = true;
+		fd->base.position_tracking_supported = true;
+		break;
+	case SIMULATED_FARM_KIND_CONTROLLER:
+		kind_str = "Controller";
+		fd->base.name = XRT_DEVICE_SIMPLE_CONTROLLER;
+		fd->base.device_type = XRT_DEVICE_TYPE_ANY_HAND_CONTROLLER;
+		fd->base.orientation_tracking_supported = true;
+		fd->base.position_tracking_supported = true;
+		break;
+	case SIMULATED_FARM_KIND_HAND:
+		kind_str = hand == XRT_HAND_LEFT ? "Left Hand" : "Right Hand";
+		fd->base.name = XRT_DEVICE_HAND_TRACKER;
+		fd->base.device_type = XRT_DEVICE_TYPE_HAND_TRACKER;
+		fd->base.hand_tracking_supported = true;
+		break;
+	}
+
+	snprintf(fd->base.str, sizeof(fd->base.str), "%s %u (Simulated Farm)", kind_str, index);
+	snprintf(fd->base.serial, sizeof(fd->base.serial), "Simulated Farm %u", index);
+
+	// Spread the devices out so they don't all overlap.
+	float angle = (float)(2.0 * M_PI) * (float)index_in_group / (float)MAX(group->count, 1u);
+	fd->center = group->center;
+	fd->center.position.x += sinf(angle) * group->radius_m * 2.0f;
+	fd->center.position.z += cosf(angle) * group->radius_m * 2.0f;
+	fd->radius_m = group->radius_m;
+	fd->complexity = MAX(group->complexity, 1u);
+	fd->phase = angle;
+	fd->speed = 1.0f + 0.1f * (float)(index % 7);
+	fd->kind = group->kind;
+	fd->hand = hand;
+	fd->index = index;
+
+	fd->period_ns = U_TIME_1S_IN_NS / MAX(group->rate_hz, 1u);
+	fd->next_ns = farm->start_ns;
+
+	m_relation_history_create(&fd->history);
+
+	// Prime the history so poses are valid straight away.
+	struct xrt_space_relation rel;
+	compute_relation(fd, 0.0, &rel);
+	m_relation_history_push(fd->history, &rel, farm->start_ns);
+
+	xrt_reference_inc(&farm->reference);
+	fd->farm = farm;
+
+	return fd;
+}
+
+static bool
+parse_group(const cJSON *json, struct simulated_farm_group *group)
+{
+	char type[32] = {0};
+	if (!u_json_get_string_into_array(u_json_get(json, "type"), type, sizeof(type))) {
+		U_LOG_E("Farm group without a \"type\".");
+		return false;
+	}
+
+	if (strcmp(type, "tracker") == 0) {
+		group->kind = SIMULATED_FARM_KIND_TRACKER;
+	} else if (strcmp(type, "controller") == 0) {
+		group->kind = SIMULATED_FARM_KIND_CONTROLLER;
+	} else if (strcmp(type, "hand") == 0) {
+		group->kind = SIMULATED_FARM_KIND_HAND;
+	} else {
+		U_LOG_E("Unknown farm group type '%s' available are: tracker, controller, hand.", type);
+		return false;
+	}
+
+	// Defaults.
+	int count = 1;
+	int rate_hz = 250;
+	int complexity = 2;
+	group->radius_m = 0.1f;
+	group->center = (struct xrt_pose)XRT_POSE_IDENTITY;
+	group->center.position.y = 1.3f;
+	group->center.position.z = -0.5f;
+
+	u_json_get_int(u_json_get(json, "count"), &count);
+	u_json_get_int(u_json_get(json, "rate_hz"), &rate_hz);
+	u_json_get_int(u_json_get(json, "complexity"), &complexity);
+	u_json_get_float(u_json_get(json, "radius"), &group->radius_m);
+	u_json_get_pose_permissive(u_json_get(json, "center"), &group->center);
+
+	group->count = (uint32_t)MAX(count, 0);
+	group->rate_hz = (uint32_t)MAX(rate_hz, 1);
+	group->complexity = (uint32_t)MAX(complexity, 1);
+
+	return true;
+}
+
+
+/*
+ *
+ * 'Exported' functions.
+ *
+ */
+
+bool
+simulated_farm_config_parse(const cJSON *json, struct simulated_farm_config *out_config)
+{
+	U_ZERO(out_config);
+
+	if (json == NULL) {
+		return false;
+	}
+
+	bool hmd = true;
+	u_json_get_bool(u_json_get(json, "hmd"), &hmd);
+	out_config->hmd = hmd;
+
+	const cJSON *group_json = NULL;
+	cJSON_ArrayForEach(group_json, u_json_get(json, "groups"))
+	{
+		if (out_config->group_count >= SIMULATED_FARM_MAX_GROUPS) {
+			U_LOG_W("Too many farm groups, ignoring the rest.");
+			break;
+		}
+
+		if (parse_group(group_json, &out_config->groups[out_config->group_count])) {
+			out_config->group_count++;
+		}
+	}
+
+	return true;
+}
+
+uint32_t
+simulated_farm_config_count(const struct simulated_farm_config *config, enum simulated_farm_kind kind)
+{
+	uint32_t count = 0;
+	for (uint32_t g = 0; g < config->group_count && g < SIMULATED_FARM_MAX_GROUPS; g++) {
+		if (config->groups[g].kind == kind) {
+			count += config->groups[g].count;
+		}
+	}
+
+	return count;
+}
+
+uint32_t
+simulated_farm_create(const struct simulated_farm_config *config,
+                      struct xrt_tracking_origin *origin,
+                      struct xrt_device **out_xdevs,
+                      uint32_t max_xdevs)
+{
+	struct simulated_farm *farm = U_TYPED_CALLOC(struct simulated_farm);
+	farm->start_ns = os_monotonic_get_ns();
+
+	int ret = os_thread_helper_init(&farm->oth);
+	if (ret < 0) {
+		U_LOG_E("Failed to init thread helper!");
+		free(farm);
+		return 0;
+	}
+
+	// Hold a reference while creating, released at the end.
+	xrt_reference_inc(&farm->reference);
+
+	uint32_t count = 0;
+	max_xdevs = MIN(max_xdevs, (uint32_t)ARRAY_SIZE(farm->devices));
+
+	uint32_t wanted = simulated_farm_config_count(config, SIMULATED_FARM_KIND_TRACKER) +
+	                  simulated_farm_config_count(config, SIMULATED_FARM_KIND_CONTROLLER) +
+	                  simulated_farm_config_count(config, SIMULATED_FARM_KIND_HAND);
+	if (wanted > max_xdevs) {
+		U_LOG_W("Too many farm devices (%u), only creating %u.", wanted, max_xdevs);
+	}
+
+	for (uint32_t g = 0; g < config->group_count && g < SIMULATED_FARM_MAX_GROUPS && count < max_xdevs; g++) {
+		const struct simulated_farm_group *group = &config->groups[g];
+
+		for (uint32_t i = 0; i < group->count && count < max_xdevs; i++) {
+			struct farm_device *fd = farm_device_create(farm, group, count, i, origin);
+			if (fd == NULL) {
+				continue;
+			}
+
+			farm->devices[count] = fd;
+			out_xdevs[count] = &fd->base;
+			count++;
+		}
+	}
+
+	farm->device_count = count;
+
+	u_var_add_root(farm, "Simulated Farm", false);
+	u_var_add_ro_u32(farm, &farm->device_count, "Device count");
+	u_var_add_ro_u64(farm, &farm->push_count, "Poses pushed");
+	u_var_add_ro_u64(farm, &farm->skip_count, "Late skips");
+
+	if (count > 0) {
+		ret = os_thread_helper_start(&farm->oth, farm_run_thread, farm);
+		if (ret != 0) {
+			U_LOG_E("Failed to start farm thread, poses will not move!");
+		}
+	}
+
+	U_LOG_I("Created %u farm devices.", count);
+
+	farm_unref(&farm);
+
+	return count;
+}
+
+void
+simulated_farm_setup_roles(struct xrt_system_devices *xsysd)
+{
+	// First devices of each kind gets the roles.
+	for (size_t i = 0; i < xsysd->xdev_count; i++) {
+		struct xrt_device *xdev = xsysd->xdevs[i];
+
+		if (xdev->device_type == XRT_DEVICE_TYPE_ANY_HAND_CONTROLLER) {
+			if (xsysd->roles.left == NULL) {
+				xsysd->roles.left = xdev;
+			} else if (xsysd->roles.right == NULL) {
+				xsysd->roles.right = xdev;
+			}
+		}
+
+		if (xdev->device_type == XRT_DEVICE_TYPE_HAND_TRACKER) {
+			if (xdev->inputs[0].name == XRT_INPUT_GENERIC_HAND_TRACKING_LEFT &&
+			    xsysd->roles.hand_tracking.left == NULL) {
+				xsysd->roles.hand_tracking.left = xdev;
+			}
+			if (xdev->inputs[0].name == XRT_INPUT_GENERIC_HAND_TRACKING_RIGHT &&
+			    xsysd->roles.hand_tracking.right == NULL) {
+				xsysd->roles.hand_tracking.right = xdev;
+			}
+		}
+	}
+}
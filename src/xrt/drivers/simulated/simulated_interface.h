@@ -10,6 +10,7 @@
 #pragma once
 
 #include "xrt/xrt_compiler.h"
+#include "xrt/xrt_defines.h"
 #include "util/u_logging.h"
 
 
@@ -17,6 +18,10 @@
 extern "C" {
 #endif
 
+typedef struct cJSON cJSON;
+struct xrt_device;
+struct xrt_tracking_origin;
+struct xrt_system_devices;
 
 /*!
  * @defgroup drv_simulated Simulated driver
@@ -89,6 +94,127 @@ simulated_create_controller(enum xrt_device_name name,
                             struct xrt_tracking_origin *origin);
 
 
+/*
+ *
+ * Device farm.
+ *
+ */
+
+//! Max number of groups in a @ref simulated_farm_config.
+#define SIMULATED_FARM_MAX_GROUPS (16)
+
+/*!
+ * What kind of devices a farm group creates.
+ *
+ * @ingroup drv_simulated
+ */
+enum simulated_farm_kind
+{
+	//! Generic trackers with a single pose input.
+	SIMULATED_FARM_KIND_TRACKER,
+	//! Simple controllers, the select button toggles once a second.
+	SIMULATED_FARM_KIND_CONTROLLER,
+	//! Hand trackers with full joint sets, alternating left and right.
+	SIMULATED_FARM_KIND_HAND,
+};
+
+/*!
+ * A group of identical devices in a farm.
+ *
+ * @ingroup drv_simulated
+ */
+struct simulated_farm_group
+{
+	enum simulated_farm_kind kind;
+
+	//! Number of devices in this group.
+	uint32_t count;
+
+	//! How often each device pushes a new pose into its history.
+	uint32_t rate_hz;
+
+	//! Number of harmonics summed up for the movement, at least one.
+	uint32_t complexity;
+
+	//! Size of the movement.
+	float radius_m;
+
+	//! Devices are spread around this pose.
+	struct xrt_pose center;
+};
+
+/*!
+ * Config for @ref simulated_farm_create.
+ *
+ * @ingroup drv_simulated
+ */
+struct simulated_farm_config
+{
+	//! Should a simulated HMD be created as head, done by the builder.
+	bool hmd;
+
+	struct simulated_farm_group groups[SIMULATED_FARM_MAX_GROUPS];
+	uint32_t group_count;
+};
+
+/*!
+ * Parse a farm config, all group fields but "type" are optional:
+ *
+ * ```json
+ * {
+ *   "hmd": true,
+ *   "groups": [
+ *     { "type": "tracker", "count": 24, "rate_hz": 1000, "complexity": 4, "radius": 0.2 },
+ *     { "type": "controller", "count": 2, "rate_hz": 500 },
+ *     { "type": "hand", "count": 2, "rate_hz": 90,
+ *       "center": { "position": { "x": 0, "y": 1.2, "z": -0.4 } } }
+ *   ]
+ * }
+ * ```
+ *
+ * Invalid groups are logged and skipped.
+ *
+ * @ingroup drv_simulated
+ */
+bool
+simulated_farm_config_parse(const cJSON *json, struct simulated_farm_config *out_config);
+
+/*!
+ * Total number of devices of @p kind in @p config.
+ *
+ * @ingroup drv_simulated
+ */
+uint32_t
+simulated_farm_config_count(const struct simulated_farm_config *config, enum simulated_farm_kind kind);
+
+/*!
+ * Create a farm of synthetic devices, a single thread generates poses for all
+ * of them at their configured rate and pushes them into a per device
+ * @ref m_relation_history, the devices then report poses from that history.
+ * All devices share @p origin. The farm lives until the last device is
+ * destroyed.
+ *
+ * @return Number of devices written to @p out_xdevs, at most @p max_xdevs.
+ *
+ * @ingroup drv_simulated
+ */
+uint32_t
+simulated_farm_create(const struct simulated_farm_config *config,
+                      struct xrt_tracking_origin *origin,
+                      struct xrt_device **out_xdevs,
+                      uint32_t max_xdevs);
+
+/*!
+ * Gives the first two controllers in @p xsysd the left and right roles, and
+ * the first left and right hand trackers the hand tracking roles. Roles that
+ * are already set are left alone.
+ *
+ * @ingroup drv_simulated
+ */
+void
+simulated_farm_setup_roles(struct xrt_system_devices *xsysd);
+
+
 #ifdef __cplusplus
 }
 #endif
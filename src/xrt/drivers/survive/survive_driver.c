@@ -221,11 +221,11 @@ survive_device_destroy(struct xrt_device *xdev)
 		survive_simple_close(survive->sys->ctx);
 		free(survive->sys);
 	}
-	m_relation_history_destroy(&survive->relation_hist);
-
-	// Remove the variable tracking.
+	// Remove the variable tracking, before the history it points into.
 	u_var_remove_root(survive);
 
+	m_relation_history_destroy(&survive->relation_hist);
+
 	free(survive->last_inputs);
 	u_device_free(&survive->base);
 }
@@ -976,6 +976,7 @@ _create_hmd_device(struct survive_system *sys, const struct SurviveSimpleObject
 	survive->hmd.use_default_ipd = debug_get_bool_option_survive_default_ipd();
 
 	u_var_add_root(survive, "Survive HMD Device", true);
+	m_relation_history_enable_stats(survive->relation_hist, survive, survive->base.str);
 	u_var_add_bool(survive, &survive->hmd.use_default_ipd, "Use default IPD");
 	u_var_add_f32(survive, &survive->hmd.ipd, "IPD");
 
@@ -1172,6 +1173,7 @@ _create_controller_device(struct survive_system *sys,
 	SURVIVE_DEBUG(survive, "Created Controller %d", idx);
 
 	u_var_add_root(survive, "Survive Device", true);
+	m_relation_history_enable_stats(survive->relation_hist, survive, survive->base.str);
 
 	return true;
 }
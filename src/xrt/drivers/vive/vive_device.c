@@ -36,6 +36,12 @@
 #include "xrt/xrt_tracking.h"
 
 
+/*!
+ * Write every raw headset pulse report to this file, can be replayed by the
+ * lighthouse tests to benchmark the decoder.
+ */
+DEBUG_GET_ONCE_OPTION(vive_lighthouse_record, "VIVE_LIGHTHOUSE_RECORD", NULL)
+
 static bool
 vive_mainboard_power_off(struct vive_device *d);
 
@@ -82,11 +88,11 @@ vive_device_destroy(struct xrt_device *xdev)
 
 	vive_config_teardown(&d->config);
 
-	m_relation_history_destroy(&d->fusion.relation_hist);
-
-	// Remove the variable tracking.
+	// Remove the variable tracking, before the history it points into.
 	u_var_remove_root(d);
 
+	m_relation_history_destroy(&d->fusion.relation_hist);
+
 	u_device_free(&d->base);
 }
 
@@ -327,9 +333,12 @@ update_imu(struct vive_device *d, const void *buffer)
 	const struct vive_imu_report *report = buffer;
 	const struct vive_imu_sample *sample = report->sample;
 	uint8_t last_seq = d->imu.sequence;
+	struct m_imu_3dof_batch batch;
 	int i;
 	int j;
 
+	batch.count = 0;
+
 	/*
 	 * The three samples are updated round-robin. New messages
 	 * can contain already seen samples in any place, but the
@@ -434,22 +443,28 @@ update_imu(struct vive_device *d, const void *buffer)
 
 		d->imu.sequence = seq;
 
-		struct xrt_space_relation rel = {0};
-		rel.relation_flags =
-		    XRT_SPACE_RELATION_ORIENTATION_VALID_BIT | XRT_SPACE_RELATION_ORIENTATION_TRACKED_BIT;
-
-		os_mutex_lock(&d->fusion.mutex);
-		m_imu_3dof_update(&d->fusion.i3dof, d->imu.last_sample_ts_ns, &acceleration, &angular_velocity);
-		rel.pose.orientation = d->fusion.i3dof.rot;
-		os_mutex_unlock(&d->fusion.mutex);
-
-		m_relation_history_push(d->fusion.relation_hist, &rel, now_ns);
+		m_imu_3dof_batch_add(&batch, d->imu.last_sample_ts_ns, &acceleration, &angular_velocity);
 
 		assert(j > 0);
 		uint32_t age = j <= 0 ? 0 : (uint32_t)(j - 1);
 
 		vive_source_push_imu_packet(d->source, age, d->imu.last_sample_ts_ns, acceleration, angular_velocity);
 	}
+
+	if (batch.count == 0) {
+		return;
+	}
+
+	// All new samples of the report in one go, only the latest orientation is pushed.
+	struct xrt_space_relation rel = {0};
+	rel.relation_flags = XRT_SPACE_RELATION_ORIENTATION_VALID_BIT | XRT_SPACE_RELATION_ORIENTATION_TRACKED_BIT;
+
+	os_mutex_lock(&d->fusion.mutex);
+	m_imu_3dof_update_many(&d->fusion.i3dof, &batch);
+	rel.pose.orientation = d->fusion.i3dof.rot;
+	os_mutex_unlock(&d->fusion.mutex);
+
+	m_relation_history_push(d->fusion.relation_hist, &rel, now_ns);
 }
 
 static void
@@ -554,54 +569,23 @@ _print_v1_pulse(struct vive_device *d, uint8_t sensor_id, uint32_t timestamp, ui
 }
 
 static void
-_decode_pulse_report(struct vive_device *d, const void *buffer)
+_handle_pulse_batch(struct vive_device *d, struct lighthouse_pulse_batch *batch)
 {
 	XRT_TRACE_MARKER();
 
-	const struct vive_headset_lighthouse_pulse_report *report = buffer;
-	unsigned int i;
-
-	/* The pulses may appear in arbitrary order */
-	for (i = 0; i < 9; i++) {
-		const struct vive_headset_lighthouse_pulse *pulse;
-		uint8_t sensor_id;
-		uint16_t duration;
-		uint32_t timestamp;
-
-		pulse = &report->pulse[i];
-
-		sensor_id = pulse->id;
-		if (sensor_id == 0xff)
-			continue;
-
-		timestamp = __le32_to_cpu(pulse->timestamp);
-		if (sensor_id == 0xfe) {
-			/* TODO: handle vsync timestamp */
-			continue;
-		}
-
-		if (sensor_id == 0xfd) { // Camera frame timestamp
-			vive_source_push_frame_ticks(d->source, timestamp);
-			continue;
-		}
-
-		if (sensor_id == 0xfb) {
-			/* TODO: Only turns on when the camera is running but not every frame. It
-			 * seems to come with every 16h frame on an Index (~3.37hz) */
-			continue;
-		}
+	for (uint32_t i = 0; i < batch->camera_tick_count; i++) {
+		vive_source_push_frame_ticks(d->source, batch->camera_ticks[i]);
+	}
 
-		if (sensor_id > 31) {
-			VIVE_ERROR(d, "Unexpected sensor id: %04x", sensor_id);
-			return;
+	if (d->log_level <= U_LOGGING_TRACE) {
+		for (uint32_t i = 0; i < batch->count; i++) {
+			_print_v1_pulse(d, batch->id[i], batch->timestamp[i], batch->duration[i]);
 		}
+	}
 
-		duration = __le16_to_cpu(pulse->duration);
-
-		_print_v1_pulse(d, sensor_id, timestamp, duration);
+	lighthouse_watchman_handle_pulse_batch(&d->watchman, batch);
 
-		lighthouse_watchman_handle_pulse(&d->watchman, sensor_id, duration, timestamp);
-	}
+	lighthouse_pulse_batch_clear(batch);
 }
 
 static const char *
@@ -719,27 +703,37 @@ _print_pulse_report_v2(struct vive_device *d, const void *buffer)
 	return true;
 }
 
-static bool
-vive_sensors_read_lighthouse_msg(struct vive_device *d)
+/*!
+ * Reads one report, pulse reports are only decoded into the batch.
+ *
+ * Returns 1 if a report was read, 0 on timeout and -1 on errors.
+ */
+static int
+vive_sensors_read_lighthouse_msg(struct vive_device *d,
+                                 struct lighthouse_pulse_batch *batch,
+                                 FILE *record,
+                                 int timeout_ms)
 {
 	uint8_t buffer[64];
 
-	int ret = os_hid_read(d->watchman_dev, buffer, sizeof(buffer), 1000);
+	int ret = os_hid_read(d->watchman_dev, buffer, sizeof(buffer), timeout_ms);
 	if (ret == 0) {
 		// basestations not present/powered off
-		VIVE_TRACE(d, "Watchman device timed out.");
-		return true;
+		if (timeout_ms > 0) {
+			VIVE_TRACE(d, "Watchman device timed out.");
+		}
+		return 0;
 	}
 	if (ret < 0) {
 		VIVE_ERROR(d, "Failed to read Watchman device: %i.", ret);
-		return false;
+		return -1;
 	}
 	if (ret > 64) {
 		VIVE_ERROR(d,
 		           "Buffer too big from Watchman device: %i."
 		           " Max size is 64",
 		           ret);
-		return false;
+		return -1;
 	}
 
 	DRV_TRACE_IDENT(packet);
@@ -750,8 +744,11 @@ vive_sensors_read_lighthouse_msg(struct vive_device *d)
 	case VIVE_HEADSET_LIGHTHOUSE_PULSE_REPORT_ID:
 		expected = sizeof(struct vive_headset_lighthouse_pulse_report);
 		if (!_is_report_size_valid(d, ret, expected, buffer[0]))
-			return false;
-		_decode_pulse_report(d, buffer);
+			return -1;
+		if (record != NULL) {
+			fwrite(buffer, expected, 1, record);
+		}
+		lighthouse_pulse_batch_add_report(batch, buffer);
 		break;
 	case VIVE_CONTROLLER_LIGHTHOUSE_PULSE_REPORT_ID:
 		expected = sizeof(struct vive_controller_report1);
@@ -760,42 +757,68 @@ vive_sensors_read_lighthouse_msg(struct vive_device *d)
 		break;
 	case VIVE_HEADSET_LIGHTHOUSE_V2_PULSE_REPORT_ID:
 		if (!_is_report_size_valid(d, ret, 59, buffer[0]))
-			return false;
+			return -1;
 		if (!_print_pulse_report_v2(d, buffer))
-			return false;
+			return -1;
 		break;
 	case VIVE_HEADSET_LIGHTHOUSE_V2_PULSE_RAW_REPORT_ID:
 		// Report starts coming when lighthouses are in sight
 		if (!_is_report_size_valid(d, ret, 64, buffer[0]))
-			return false;
+			return -1;
 		break;
 	default:
 		VIVE_ERROR(d, "Unexpected sensor report type %s (0x%x). %d bytes.",
 		           _sensors_get_report_string(buffer[0]), buffer[0], ret);
 	}
 
-	return true;
+	return 1;
 }
 
 static void *
 vive_watchman_run_thread(void *ptr)
 {
 	struct vive_device *d = (struct vive_device *)ptr;
+	struct lighthouse_pulse_batch batch;
+	FILE *record = NULL;
 
 	U_TRACE_SET_THREAD_NAME("Vive: Watchman");
 
+	lighthouse_pulse_batch_clear(&batch);
+
+	const char *record_path = debug_get_option_vive_lighthouse_record();
+	if (record_path != NULL && d->watchman_dev != NULL) {
+		record = fopen(record_path, "wb");
+		if (record == NULL) {
+			VIVE_ERROR(d, "Could not open '%s' for recording lighthouse reports.", record_path);
+		}
+	}
+
 	os_thread_helper_lock(&d->watchman_thread);
 	while (os_thread_helper_is_running_locked(&d->watchman_thread)) {
 		os_thread_helper_unlock(&d->watchman_thread);
 
-		if (d->watchman_dev)
-			if (!vive_sensors_read_lighthouse_msg(d))
-				return NULL;
+		if (d->watchman_dev) {
+			// Wait for one report, then take the ones already queued up.
+			int ret = vive_sensors_read_lighthouse_msg(d, &batch, record, 1000);
+			while (ret > 0 && lighthouse_pulse_batch_has_room(&batch)) {
+				ret = vive_sensors_read_lighthouse_msg(d, &batch, record, 0);
+			}
+
+			_handle_pulse_batch(d, &batch);
+
+			if (ret < 0) {
+				break;
+			}
+		}
 
 		// Just keep swimming.
 		os_thread_helper_lock(&d->watchman_thread);
 	}
 
+	if (record != NULL) {
+		fclose(record);
+	}
+
 	return NULL;
 }
 
@@ -808,8 +831,8 @@ vive_sensors_run_thread(void *ptr)
 	os_thread_helper_name(&d->sensors_thread, "Vive: Sensors");
 
 #ifdef XRT_OS_LINUX
-	// Try to raise priority of this thread.
-	u_linux_try_to_set_realtime_priority_on_thread(d->log_level, "Vive: Sensors");
+	// Policy and CPUs from the config, raises priority by default.
+	u_linux_thread_class_apply(OS_THREAD_CLASS_DRIVER_IO, d->log_level, "Vive: Sensors");
 #endif
 
 	/*
@@ -875,6 +898,7 @@ vive_device_setup_ui(struct vive_device *d)
 		u_var_add_button(d, &d->gui.switch_tracker_btn, "Switch to 3DoF Tracking");
 	}
 	u_var_add_pose(d, &d->pose, "Tracked Pose");
+	m_relation_history_enable_stats(d->fusion.relation_hist, d, d->base.str);
 	u_var_add_pose(d, &d->offset, "Pose Offset");
 	u_var_add_draggable_f32(d, &d->tracked_offset_ms, "Timecode offset(ms)");
 
@@ -19,6 +19,9 @@
 #include "util/u_logging.h"
 
 #include "vive_lighthouse.h"
+#include "vive_protocol.h"
+
+#include <assert.h>
 
 static enum u_logging_level log_level;
 
@@ -466,11 +469,8 @@ accumulate_sync_pulse(struct lighthouse_watchman *watchman, uint8_t id, uint32_t
 	}
 }
 
-void
-lighthouse_watchman_handle_pulse(struct lighthouse_watchman *watchman,
-                                 uint8_t id,
-                                 uint16_t duration,
-                                 uint32_t timestamp)
+static inline void
+handle_pulse(struct lighthouse_watchman *watchman, uint8_t id, uint16_t duration, uint32_t timestamp)
 {
 	int32_t dt;
 
@@ -529,6 +529,106 @@ lighthouse_watchman_handle_pulse(struct lighthouse_watchman *watchman,
 	}
 }
 
+bool
+lighthouse_pulse_batch_add_report(struct lighthouse_pulse_batch *batch, const void *buffer)
+{
+	const struct vive_headset_lighthouse_pulse_report *report = buffer;
+	uint32_t start = batch->count;
+	uint32_t n = start;
+	uint32_t special = 0;
+
+	assert(lighthouse_pulse_batch_has_room(batch));
+
+	/*
+	 * Write every slot but only advance for sensor ids, most reports are
+	 * partly filled with empty (0xff) slots. The pulses may appear in
+	 * arbitrary order.
+	 */
+	for (uint32_t i = 0; i < 9; i++) {
+		const struct vive_headset_lighthouse_pulse *pulse = &report->pulse[i];
+		uint8_t id = pulse->id;
+
+		batch->id[n] = id;
+		batch->duration[n] = __le16_to_cpu(pulse->duration);
+		batch->timestamp[n] = __le32_to_cpu(pulse->timestamp);
+		n += id < 32;
+		special |= (uint32_t)(id >= 32 && id != 0xff) << i;
+	}
+
+	batch->count = n;
+
+	if (special == 0) {
+		return true;
+	}
+
+	for (uint32_t i = 0; i < 9; i++) {
+		if ((special & (1u << i)) == 0) {
+			continue;
+		}
+
+		uint8_t id = report->pulse[i].id;
+
+		if (id == 0xfd) { // Camera frame timestamp
+			if (batch->camera_tick_count < LIGHTHOUSE_PULSE_BATCH_MAX_CAMERA) {
+				uint32_t ticks = __le32_to_cpu(report->pulse[i].timestamp);
+				batch->camera_ticks[batch->camera_tick_count++] = ticks;
+			}
+			continue;
+		}
+
+		if (id == 0xfe) {
+			/* TODO: handle vsync timestamp */
+			continue;
+		}
+
+		if (id == 0xfb) {
+			/* TODO: Only turns on when the camera is running but not every frame. It
+			 * seems to come with every 16h frame on an Index (~3.37hz) */
+			continue;
+		}
+
+		LH_ERROR("Unexpected sensor id: %04x", id);
+
+		// Drop the pulses after the bad one.
+		batch->count = start;
+		for (uint32_t k = 0; k < i; k++) {
+			batch->count += report->pulse[k].id < 32;
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+void
+lighthouse_watchman_handle_pulse(struct lighthouse_watchman *watchman,
+                                 uint8_t id,
+                                 uint16_t duration,
+                                 uint32_t timestamp)
+{
+	handle_pulse(watchman, id, duration, timestamp);
+}
+
+void
+lighthouse_watchman_handle_pulse_batch(struct lighthouse_watchman *watchman,
+                                       const struct lighthouse_pulse_batch *batch)
+{
+	for (uint32_t i = 0; i < batch->count; i++) {
+		uint16_t duration = batch->duration[i];
+
+		/*
+		 * Until locked only sync length pulses do anything, skip the
+		 * sweeps without looking at the timestamps.
+		 */
+		if (!watchman->sync_lock && (duration < 2750 || duration > 6750)) {
+			continue;
+		}
+
+		handle_pulse(watchman, batch->id[i], duration, batch->timestamp[i]);
+	}
+}
+
 void
 lighthouse_watchman_init(struct lighthouse_watchman *watchman, const char *name)
 {
@@ -19,6 +19,10 @@
 
 #include "xrt/xrt_defines.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 struct lighthouse_rotor_calibration
 {
 	float tilt;
@@ -100,10 +104,72 @@ struct lighthouse_watchman
 	bool sync_lock;
 };
 
+/*!
+ * Max number of pulses in a @ref lighthouse_pulse_batch, sixteen full headset
+ * reports.
+ */
+#define LIGHTHOUSE_PULSE_BATCH_MAX (9 * 16)
+
+//! Max number of camera frame timestamps in a @ref lighthouse_pulse_batch.
+#define LIGHTHOUSE_PULSE_BATCH_MAX_CAMERA (16)
+
+/*!
+ * Sensor pulses decoded from one or more headset reports, kept as separate
+ * arrays so the decoder can write them without branching on every slot.
+ */
+struct lighthouse_pulse_batch
+{
+	uint32_t timestamp[LIGHTHOUSE_PULSE_BATCH_MAX];
+	uint16_t duration[LIGHTHOUSE_PULSE_BATCH_MAX];
+	uint8_t id[LIGHTHOUSE_PULSE_BATCH_MAX];
+	uint32_t count;
+
+	//! Camera frame timestamps found in the reports, in device ticks.
+	uint32_t camera_ticks[LIGHTHOUSE_PULSE_BATCH_MAX_CAMERA];
+	uint32_t camera_tick_count;
+};
+
+static inline void
+lighthouse_pulse_batch_clear(struct lighthouse_pulse_batch *batch)
+{
+	batch->count = 0;
+	batch->camera_tick_count = 0;
+}
+
+//! Is there room for one more report in the batch.
+static inline bool
+lighthouse_pulse_batch_has_room(const struct lighthouse_pulse_batch *batch)
+{
+	return batch->count + 9 <= LIGHTHOUSE_PULSE_BATCH_MAX &&
+	       batch->camera_tick_count < LIGHTHOUSE_PULSE_BATCH_MAX_CAMERA;
+}
+
+/*!
+ * Decode one @ref vive_headset_lighthouse_pulse_report and append its sensor
+ * pulses and camera frame timestamps to the batch, which must have room.
+ *
+ * Returns false on an unexpected sensor id, pulses after it are dropped.
+ */
+bool
+lighthouse_pulse_batch_add_report(struct lighthouse_pulse_batch *batch, const void *buffer);
+
 void
 lighthouse_watchman_handle_pulse(struct lighthouse_watchman *watchman,
                                  uint8_t id,
                                  uint16_t duration,
                                  uint32_t timestamp);
+
+/*!
+ * Same as calling @ref lighthouse_watchman_handle_pulse on every pulse in the
+ * batch in order.
+ */
+void
+lighthouse_watchman_handle_pulse_batch(struct lighthouse_watchman *watchman,
+                                       const struct lighthouse_pulse_batch *batch);
+
 void
 lighthouse_watchman_init(struct lighthouse_watchman *watchman, const char *name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -18,6 +18,7 @@
 #include "util/u_deque.h"
 #include "util/u_logging.h"
 #include "util/u_trace_marker.h"
+#include "util/u_var.h"
 
 #include "vive.h"
 
@@ -49,8 +50,10 @@ struct vive_source
 	timepoint_ns last_frame_ts_ns;                //! Last frame timestamp in device nanoseconds
 
 	// Clock offsets
-	time_duration_ns hw2mono; //!< Estimated offset from IMU to monotonic clock
+	time_duration_ns hw2mono; //!< Estimated offset from IMU to monotonic clock at the last sample
 	time_duration_ns hw2v4l2; //!< Estimated offset from IMU to V4L2 clock
+
+	struct m_clock_offset_estimator hw2mono_est; //!< Offset and skew from IMU to monotonic clock
 };
 
 /*
@@ -164,6 +167,7 @@ static void
 vive_source_node_destroy(struct xrt_frame_node *node)
 {
 	struct vive_source *vs = container_of(node, struct vive_source, node);
+	u_var_remove_root(vs);
 	os_mutex_destroy(&vs->frame_timestamps_lock);
 	u_deque_timepoint_ns_destroy(&vs->frame_timestamps);
 
@@ -196,6 +200,13 @@ vive_source_create(struct xrt_frame_context *xfctx)
 	vs->frame_timestamps = u_deque_timepoint_ns_create();
 	os_mutex_init(&vs->frame_timestamps_lock);
 
+	m_clock_offset_estimator_init(&vs->hw2mono_est, 0);
+
+	// Setup UI
+	u_var_add_root(vs, "Vive Source", false);
+	u_var_add_log_level(vs, &vs->log_level, "Log Level");
+	m_clock_offset_estimator_add_vars(&vs->hw2mono_est, vs, "IMU Clock");
+
 	// Setup node
 	struct xrt_frame_node *xfn = &vs->node;
 	xfn->break_apart = vive_source_node_break_apart;
@@ -239,7 +250,9 @@ vive_source_push_imu_packet(struct vive_source *vs, uint32_t age, timepoint_ns t
 	timepoint_ns sample_point = now_ns - t2ms_ns - age_diff_ns;
 
 	// Time adjustment.
-	t = m_clock_offset_a2b(IMU_FREQUENCY, t, sample_point, &vs->hw2mono);
+	timepoint_ns hw_t = t;
+	t = m_clock_offset_estimator_update(&vs->hw2mono_est, hw_t, sample_point);
+	vs->hw2mono = t - hw_t;
 
 	// Finished sample.
 	struct xrt_imu_sample sample = {
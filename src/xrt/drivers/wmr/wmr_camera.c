@@ -35,6 +35,9 @@ DEBUG_GET_ONCE_BOOL_OPTION(wmr_autoexposure, "WMR_AUTOEXPOSURE", true)
 //! Specifies whether the user wants to use the same exp/gain values for all cameras
 DEBUG_GET_ONCE_BOOL_OPTION(wmr_unify_expgain, "WMR_UNIFY_EXPGAIN", false)
 
+//! Number of USB transfers kept in flight, more gives more slack before the device overruns.
+DEBUG_GET_ONCE_NUM_OPTION(wmr_camera_xfers, "WMR_CAMERA_XFERS", 4)
+
 static int
 update_expgain(struct wmr_camera *cam, struct xrt_frame **frames);
 
@@ -52,7 +55,15 @@ update_expgain(struct wmr_camera *cam, struct xrt_frame **frames);
 
 #define CAM_ENDPOINT 0x05
 
-#define NUM_XFERS 4
+#define MIN_XFERS 2
+#define MAX_XFERS 16
+
+//! Raw buffers on top of the ones in the transfers, lets the worker fall a few frames behind.
+#define EXTRA_BUFFERS 2
+#define MAX_BUFFERS (MAX_XFERS + EXTRA_BUFFERS)
+
+//! Number of assembled frames, downstream holds on to them for a while.
+#define FRAME_POOL_SIZE 8
 
 #define WMR_CAMERA_CMD_GAIN 0x80
 #define WMR_CAMERA_CMD_ON 0x81
@@ -90,8 +101,25 @@ struct wmr_camera
 	libusb_context *ctx;
 	libusb_device_handle *dev;
 
+	/*!
+	 * Are the transfers being resubmitted, protected by @ref xfer_lock.
+	 * Cleared by stop, after which transfers complete instead of
+	 * being resubmitted.
+	 */
 	bool running;
 
+	//! Number of transfers submitted and not yet completed for good.
+	uint32_t xfers_in_flight;
+
+	//! Protects @ref running and @ref xfers_in_flight.
+	struct os_mutex xfer_lock;
+
+	//! Signalled when @ref xfers_in_flight drops to zero.
+	struct os_cond xfer_cond;
+
+	//! Were @ref xfer_lock and @ref xfer_cond initialised.
+	bool xfer_sync_initialized;
+
 	struct os_thread_helper usb_thread;
 	int usb_complete;
 
@@ -107,7 +135,38 @@ struct wmr_camera
 	/* Unwrapped frame sequence number */
 	uint64_t frame_sequence;
 
-	struct libusb_transfer *xfers[NUM_XFERS];
+	uint32_t xfer_count;
+	struct libusb_transfer *xfers[MAX_XFERS];
+
+	/*!
+	 * Raw transfer buffers, owned by us and not libusb. They move between
+	 * the transfers, the pending queue, the worker and the free stack, and
+	 * each buffer is always in exactly one of them. Set up once on the first
+	 * start and kept over stop and start, stop waits for the transfers to
+	 * complete so they can be resubmitted with the buffer they hold. The
+	 * queue and stack are protected by the worker thread helper's mutex.
+	 */
+	struct
+	{
+		uint8_t *all[MAX_BUFFERS];
+		uint32_t count;
+
+		uint8_t *free[MAX_BUFFERS];
+		uint32_t free_count;
+
+		uint8_t *pending[MAX_BUFFERS];
+		uint32_t pending_head;
+		uint32_t pending_count;
+	} bufs;
+
+	//! Assembles frames out of raw transfer buffers and pushes them to the sinks.
+	struct os_thread_helper worker;
+
+	//! Assembled frames, falls back to one-off frames when downstream holds on to all of them.
+	struct u_frame_pool *frame_pool;
+
+	uint64_t dropped_xfers;
+	uint64_t pool_fallbacks;
 
 	struct wmr_camera_expgain
 	{
@@ -116,6 +175,7 @@ struct wmr_camera
 		uint8_t last_gain, gain;
 		struct u_var_draggable_u16 exposure_ui; //! Widget to control `exposure` value
 		struct u_autoexpgain *aeg;
+		bool aeg_fed; //!< The histogram for the current frame was built during the copy
 	} ceg[WMR_MAX_CAMERAS]; //!< Camera exposure-gain control
 	bool unify_expgains;    //!< Whether to use the same exposure/gain values for all cameras
 
@@ -276,33 +336,40 @@ set_active(struct wmr_camera *cam, bool active)
 	return send_buffer_to_device(cam, (uint8_t *)&cmd, sizeof(cmd));
 }
 
-static void LIBUSB_CALL
-img_xfer_cb(struct libusb_transfer *xfer)
+static void
+process_buffer(struct wmr_camera *cam, const uint8_t *buffer)
 {
 	DRV_TRACE_MARKER();
 
-	struct wmr_camera *cam = xfer->user_data;
-
-	if (xfer->status != LIBUSB_TRANSFER_COMPLETED) {
-		WMR_CAM_DEBUG(cam, "Camera transfer completed with status: %s (%u)", libusb_error_name(xfer->status),
-		              xfer->status);
-		goto out;
-	}
-
-	if (xfer->actual_length < xfer->length) {
-		WMR_CAM_DEBUG(cam, "Camera transfer only delivered %d bytes", xfer->actual_length);
-		goto out;
-	}
-
-	WMR_CAM_TRACE(cam, "Camera transfer complete - %d bytes of %d", xfer->actual_length, xfer->length);
-
 	/* Convert the output into frames and send them off to debug / tracking */
 	struct xrt_frame *xf = NULL;
 
 	/* There's always one extra line of pixels with exposure info */
-	u_frame_create_one_off(XRT_FORMAT_L8, cam->frame_width, cam->frame_height + 1, &xf);
+	if (!u_frame_pool_get(cam->frame_pool, &xf)) {
+		cam->pool_fallbacks++;
+		u_frame_create_one_off(XRT_FORMAT_L8, cam->frame_width, cam->frame_height + 1, &xf);
+	}
 
-	const uint8_t *src = xfer->buffer;
+	/*
+	 * The frame type is at the end of the footer, peek at it so that auto
+	 * exposure for SLAM frames can be fed while the frame is being copied.
+	 */
+	const uint8_t *frametype_ptr = buffer + cam->xfer_size - 2;
+	if (read16(&frametype_ptr) == WMR_FRAMETYPE_SLAM) {
+		for (int i = 0; i < cam->slam_cam_count; i++) {
+			struct wmr_camera_expgain *ceg = &cam->ceg[i];
+			if (ceg->manual_control || (cam->unify_expgains && i != 0)) {
+				continue;
+			}
+
+			const struct xrt_rect *roi = &cam->tcam_confs[i].roi;
+			size_t origin = (size_t)roi->offset.h * xf->stride + roi->offset.w;
+			u_autoexpgain_begin(ceg->aeg, origin, roi->extent.w, roi->extent.h, xf->stride, xf->format);
+			ceg->aeg_fed = true;
+		}
+	}
+
+	const uint8_t *src = buffer;
 
 	uint8_t *dst = xf->data;
 	size_t dst_remain = xf->size;
@@ -323,6 +390,13 @@ img_xfer_cb(struct libusb_transfer *xfer)
 		src += 0x20;
 
 		memcpy(dst, src, to_copy);
+
+		for (int i = 0; i < cam->slam_cam_count; i++) {
+			if (cam->ceg[i].aeg_fed) {
+				u_autoexpgain_add_data(cam->ceg[i].aeg, dst - xf->data, dst, to_copy);
+			}
+		}
+
 		src += to_copy;
 		dst += to_copy;
 		dst_remain -= to_copy;
@@ -330,7 +404,7 @@ img_xfer_cb(struct libusb_transfer *xfer)
 	DRV_TRACE_END(copy_to_frame);
 
 	/* There should be exactly a 26 byte footer left over */
-	assert(xfer->buffer + xfer->length - src == 26);
+	assert(buffer + cam->xfer_size - src == 26);
 
 	/* Footer contains:
 	 * __le64 start_ts; - 100ns unit timestamp, from same clock as video_timestamps on the IMU feed
@@ -403,9 +477,99 @@ img_xfer_cb(struct libusb_transfer *xfer)
 	}
 
 	xrt_frame_reference(&xf, NULL);
+}
+
+static void *
+wmr_cam_worker_thread(void *ptr)
+{
+	U_TRACE_SET_THREAD_NAME("WMR: Camera-Worker");
+
+	struct wmr_camera *cam = ptr;
+
+	os_thread_helper_lock(&cam->worker);
+	while (os_thread_helper_is_running_locked(&cam->worker)) {
+		if (cam->bufs.pending_count == 0) {
+			os_thread_helper_wait_locked(&cam->worker);
+			continue;
+		}
+
+		uint8_t *buffer = cam->bufs.pending[cam->bufs.pending_head];
+		cam->bufs.pending_head = (cam->bufs.pending_head + 1) % MAX_BUFFERS;
+		cam->bufs.pending_count--;
+
+		os_thread_helper_unlock(&cam->worker);
+
+		process_buffer(cam, buffer);
+
+		os_thread_helper_lock(&cam->worker);
+		cam->bufs.free[cam->bufs.free_count++] = buffer;
+	}
+	os_thread_helper_unlock(&cam->worker);
+
+	return NULL;
+}
+
+/*!
+ * Runs on the libusb event thread, only swaps the filled buffer for a free one
+ * and resubmits, everything else is done on the worker thread.
+ */
+static void LIBUSB_CALL
+img_xfer_cb(struct libusb_transfer *xfer)
+{
+	DRV_TRACE_MARKER();
+
+	struct wmr_camera *cam = xfer->user_data;
+	int res;
+
+	if (xfer->status != LIBUSB_TRANSFER_COMPLETED) {
+		WMR_CAM_DEBUG(cam, "Camera transfer completed with status: %s (%u)", libusb_error_name(xfer->status),
+		              xfer->status);
+		goto out;
+	}
+
+	if (xfer->actual_length < xfer->length) {
+		WMR_CAM_DEBUG(cam, "Camera transfer only delivered %d bytes", xfer->actual_length);
+		goto out;
+	}
+
+	WMR_CAM_TRACE(cam, "Camera transfer complete - %d bytes of %d", xfer->actual_length, xfer->length);
+
+	os_thread_helper_lock(&cam->worker);
+
+	if (cam->bufs.free_count == 0) {
+		// The worker is behind, drop this frame and reuse the buffer.
+		cam->dropped_xfers++;
+		os_thread_helper_unlock(&cam->worker);
+		WMR_CAM_DEBUG(cam, "Camera worker is behind, dropping frame");
+		goto out;
+	}
+
+	uint32_t tail = (cam->bufs.pending_head + cam->bufs.pending_count) % MAX_BUFFERS;
+	cam->bufs.pending[tail] = xfer->buffer;
+	cam->bufs.pending_count++;
+
+	xfer->buffer = cam->bufs.free[--cam->bufs.free_count];
+
+	os_thread_helper_signal_locked(&cam->worker);
+	os_thread_helper_unlock(&cam->worker);
 
 out:
-	libusb_submit_transfer(xfer);
+	// Only resubmit while running, the transfer keeps its buffer either way.
+	os_mutex_lock(&cam->xfer_lock);
+
+	res = cam->running ? libusb_submit_transfer(xfer) : LIBUSB_ERROR_INTERRUPTED;
+	if (res < 0) {
+		if (res != LIBUSB_ERROR_INTERRUPTED) {
+			WMR_CAM_ERROR(cam, "Failed to resubmit transfer: %s", libusb_error_name(res));
+		}
+
+		assert(cam->xfers_in_flight > 0);
+		if (--cam->xfers_in_flight == 0) {
+			os_cond_signal(&cam->xfer_cond);
+		}
+	}
+
+	os_mutex_unlock(&cam->xfer_lock);
 }
 
 
@@ -433,11 +597,35 @@ wmr_camera_open(struct wmr_camera_open_config *config)
 		cam->cam_sinks[i] = config->tcam_sinks[i];
 	}
 
+	int64_t xfer_count = debug_get_num_option_wmr_camera_xfers();
+	cam->xfer_count = (uint32_t)CLAMP(xfer_count, MIN_XFERS, MAX_XFERS);
+
+	// Each piece is tracked on its own so free only tears down what was initialised.
 	if (os_thread_helper_init(&cam->usb_thread) != 0) {
-		WMR_CAM_ERROR(cam, "Failed to initialise threading");
+		WMR_CAM_ERROR(cam, "Failed to initialise USB thread");
+		wmr_camera_free(cam);
+		return NULL;
+	}
+
+	if (os_thread_helper_init(&cam->worker) != 0) {
+		WMR_CAM_ERROR(cam, "Failed to initialise worker thread");
+		wmr_camera_free(cam);
+		return NULL;
+	}
+
+	if (os_mutex_init(&cam->xfer_lock) != 0) {
+		WMR_CAM_ERROR(cam, "Failed to initialise transfer mutex");
+		wmr_camera_free(cam);
+		return NULL;
+	}
+
+	if (os_cond_init(&cam->xfer_cond) != 0) {
+		WMR_CAM_ERROR(cam, "Failed to initialise transfer condition");
+		os_mutex_destroy(&cam->xfer_lock);
 		wmr_camera_free(cam);
 		return NULL;
 	}
+	cam->xfer_sync_initialized = true;
 
 	res = libusb_init(&cam->ctx);
 	if (res < 0) {
@@ -461,7 +649,12 @@ wmr_camera_open(struct wmr_camera_open_config *config)
 		goto fail;
 	}
 
-	for (i = 0; i < NUM_XFERS; i++) {
+	if (os_thread_helper_start(&cam->worker, wmr_cam_worker_thread, cam) != 0) {
+		WMR_CAM_ERROR(cam, "Failed to start camera worker thread");
+		goto fail;
+	}
+
+	for (i = 0; i < (int)cam->xfer_count; i++) {
 		cam->xfers[i] = libusb_alloc_transfer(0);
 		if (cam->xfers[i] == NULL) {
 			res = LIBUSB_ERROR_NO_MEM;
@@ -492,6 +685,10 @@ wmr_camera_open(struct wmr_camera_open_config *config)
 	u_var_add_root(cam, "WMR Camera", true);
 	u_var_add_log_level(cam, &cam->log_level, "Log level");
 
+	u_var_add_ro_u32(cam, &cam->xfer_count, "USB transfers");
+	u_var_add_ro_u64(cam, &cam->dropped_xfers, "Dropped transfers");
+	u_var_add_ro_u64(cam, &cam->pool_fallbacks, "Frame pool misses");
+
 	u_var_add_gui_header_begin(cam, NULL, "Camera Streams");
 	u_var_add_sink_debug(cam, &cam->debug_sinks[WMR_DEBUG_SINK_SLAM], "SLAM Tracking Streams");
 	u_var_add_sink_debug(cam, &cam->debug_sinks[WMR_DEBUG_SINK_CONTROLLER], "Controller Tracking Streams");
@@ -551,9 +748,10 @@ wmr_camera_free(struct wmr_camera *cam)
 			libusb_close(cam->dev);
 		}
 
+		// The context is only created after the helper has been initialised.
 		os_thread_helper_destroy(&cam->usb_thread);
 
-		for (i = 0; i < NUM_XFERS; i++) {
+		for (i = 0; i < MAX_XFERS; i++) {
 			if (cam->xfers[i] == NULL) {
 				continue;
 			}
@@ -566,6 +764,26 @@ wmr_camera_free(struct wmr_camera *cam)
 		cam->ctx = NULL;
 	}
 
+	if (cam->ctx == NULL && cam->usb_thread.initialized) {
+		os_thread_helper_destroy(&cam->usb_thread);
+	}
+
+	// No more buffers will come in, safe to stop the worker.
+	if (cam->worker.initialized) {
+		os_thread_helper_destroy(&cam->worker);
+	}
+
+	if (cam->xfer_sync_initialized) {
+		os_cond_destroy(&cam->xfer_cond);
+		os_mutex_destroy(&cam->xfer_lock);
+	}
+
+	for (uint32_t b = 0; b < cam->bufs.count; b++) {
+		free(cam->bufs.all[b]);
+	}
+
+	u_frame_pool_destroy(&cam->frame_pool);
+
 	// Tidy the variable tracking.
 	u_var_remove_root(cam);
 	u_sink_debug_destroy(&cam->debug_sinks[WMR_DEBUG_SINK_SLAM]);
@@ -601,17 +819,55 @@ wmr_camera_start(struct wmr_camera *cam)
 		goto fail;
 	}
 
-	for (int i = 0; i < NUM_XFERS; i++) {
-		uint8_t *recv_buf = malloc(cam->xfer_size);
+	/*
+	 * The buffers and frames are set up once and kept over stop and start,
+	 * stop has waited for all transfers so each one still holds its buffer.
+	 */
+	if (cam->bufs.count == 0) {
+		cam->bufs.count = cam->xfer_count + EXTRA_BUFFERS;
+		for (uint32_t b = 0; b < cam->bufs.count; b++) {
+			cam->bufs.all[b] = malloc(cam->xfer_size);
+		}
 
-		libusb_fill_bulk_transfer(cam->xfers[i], cam->dev, LIBUSB_ENDPOINT_IN | 5, recv_buf, cam->xfer_size,
-		                          img_xfer_cb, cam, 0);
-		cam->xfers[i]->flags |= LIBUSB_TRANSFER_FREE_BUFFER;
+		for (uint32_t i = 0; i < cam->xfer_count; i++) {
+			libusb_fill_bulk_transfer(cam->xfers[i], cam->dev, LIBUSB_ENDPOINT_IN | 5, cam->bufs.all[i],
+			                          cam->xfer_size, img_xfer_cb, cam, 0);
+		}
 
+		os_thread_helper_lock(&cam->worker);
+		for (uint32_t b = cam->xfer_count; b < cam->bufs.count; b++) {
+			cam->bufs.free[cam->bufs.free_count++] = cam->bufs.all[b];
+		}
+		os_thread_helper_unlock(&cam->worker);
+
+		cam->frame_pool =
+		    u_frame_pool_create(XRT_FORMAT_L8, cam->frame_width, cam->frame_height + 1, FRAME_POOL_SIZE);
+	} else {
+		// Drop anything left in the queue from a previous run, the worker may still hold one.
+		os_thread_helper_lock(&cam->worker);
+		while (cam->bufs.pending_count > 0) {
+			cam->bufs.free[cam->bufs.free_count++] = cam->bufs.pending[cam->bufs.pending_head];
+			cam->bufs.pending_head = (cam->bufs.pending_head + 1) % MAX_BUFFERS;
+			cam->bufs.pending_count--;
+		}
+		os_thread_helper_unlock(&cam->worker);
+	}
+
+	os_mutex_lock(&cam->xfer_lock);
+	assert(cam->xfers_in_flight == 0);
+	cam->running = true;
+
+	for (uint32_t i = 0; i < cam->xfer_count; i++) {
 		res = libusb_submit_transfer(cam->xfers[i]);
 		if (res < 0) {
-			goto fail;
+			break;
 		}
+		cam->xfers_in_flight++;
+	}
+	os_mutex_unlock(&cam->xfer_lock);
+
+	if (res < 0) {
+		goto fail;
 	}
 
 	WMR_CAM_INFO(cam, "WMR camera started");
@@ -637,17 +893,30 @@ wmr_camera_stop(struct wmr_camera *cam)
 	int res;
 	int i;
 
+	// Nothing was ever set up.
+	if (!cam->xfer_sync_initialized) {
+		return true;
+	}
+
+	os_mutex_lock(&cam->xfer_lock);
 	if (!cam->running) {
+		os_mutex_unlock(&cam->xfer_lock);
 		return true;
 	}
 	cam->running = false;
 
-	for (i = 0; i < NUM_XFERS; i++) {
+	for (i = 0; i < (int)cam->xfer_count; i++) {
 		if (cam->xfers[i] != NULL) {
 			libusb_cancel_transfer(cam->xfers[i]);
 		}
 	}
 
+	// Completions come on the USB thread, after this no transfer is using its buffer.
+	while (cam->xfers_in_flight > 0) {
+		os_cond_wait(&cam->xfer_cond, &cam->xfer_lock);
+	}
+	os_mutex_unlock(&cam->xfer_lock);
+
 	res = set_active(cam, false);
 	if (res < 0) {
 		goto fail;
@@ -676,7 +945,11 @@ update_expgain(struct wmr_camera *cam, struct xrt_frame **frames)
 		struct wmr_camera_expgain *ceg = &cam->ceg[i];
 
 		if (!ceg->manual_control && frames != NULL && frames[i] != NULL) {
-			if (!cam->unify_expgains || i == 0) {
+			if (ceg->aeg_fed) {
+				u_autoexpgain_end(ceg->aeg);
+				ceg->exposure = (uint16_t)u_autoexpgain_get_exposure(ceg->aeg);
+				ceg->gain = (uint8_t)u_autoexpgain_get_gain(ceg->aeg);
+			} else if (!cam->unify_expgains || i == 0) {
 				u_autoexpgain_update(ceg->aeg, frames[i]);
 				ceg->exposure = (uint16_t)u_autoexpgain_get_exposure(ceg->aeg);
 				ceg->gain = (uint8_t)u_autoexpgain_get_gain(ceg->aeg);
@@ -686,6 +959,8 @@ update_expgain(struct wmr_camera *cam, struct xrt_frame **frames)
 			}
 		}
 
+		ceg->aeg_fed = false;
+
 		if (ceg->last_exposure == ceg->exposure && ceg->last_gain == ceg->gain) {
 			continue;
 		}
@@ -408,6 +408,7 @@ hololens_handle_sensors_avg(struct wmr_hmd *wh, const unsigned char *buffer, int
 	m_imu_3dof_update(&wh->fusion.i3dof, t, &avg_calib_accel, &avg_calib_gyro);
 	wh->fusion.last_imu_timestamp_ns = now_ns;
 	wh->fusion.last_angular_velocity = avg_calib_gyro;
+	m_prediction_stats_add_sample(&wh->fusion.prediction_stats);
 	os_mutex_unlock(&wh->fusion.mutex);
 
 	// SLAM tracking
@@ -456,6 +457,7 @@ hololens_handle_sensors_all(struct wmr_hmd *wh, const unsigned char *buffer, int
 	}
 	wh->fusion.last_imu_timestamp_ns = now_ns;
 	wh->fusion.last_angular_velocity = calib_gyro[3];
+	m_prediction_stats_add_sample(&wh->fusion.prediction_stats);
 	os_mutex_unlock(&wh->fusion.mutex);
 
 	// SLAM tracking
@@ -656,8 +658,8 @@ wmr_run_thread(void *ptr)
 	os_thread_helper_name(&wh->oth, "WMR: USB-HMD");
 
 #ifdef XRT_OS_LINUX
-	// Try to raise priority of this thread.
-	u_linux_try_to_set_realtime_priority_on_thread(wh->log_level, "WMR: USB-HMD");
+	// Policy and CPUs from the config, raises priority by default.
+	u_linux_thread_class_apply(OS_THREAD_CLASS_DRIVER_IO, wh->log_level, "WMR: USB-HMD");
 #endif
 
 
@@ -1102,6 +1104,12 @@ wmr_hmd_get_3dof_tracked_pose(struct xrt_device *xdev,
 	relation.pose.orientation = wh->fusion.i3dof.rot;
 	relation.angular_velocity = wh->fusion.last_angular_velocity;
 	last_imu_timestamp_ns = wh->fusion.last_imu_timestamp_ns;
+
+	// Asking for the past just gets the latest pose, count it as such.
+	enum m_prediction_kind kind = at_timestamp_ns < last_imu_timestamp_ns ? M_PREDICTION_KIND_REVERSE_PREDICTED
+	                                                                      : M_PREDICTION_KIND_PREDICTED;
+	m_prediction_stats_add(&wh->fusion.prediction_stats, kind, (int64_t)os_monotonic_get_ns(),
+	                       (int64_t)at_timestamp_ns, (int64_t)last_imu_timestamp_ns);
 	os_mutex_unlock(&wh->fusion.mutex);
 
 	// No prediction needed.
@@ -1724,6 +1732,7 @@ wmr_hmd_setup_ui(struct wmr_hmd *wh)
 
 	u_var_add_gui_header(wh, NULL, "3DoF Tracking");
 	m_imu_3dof_add_vars(&wh->fusion.i3dof, wh, "");
+	m_prediction_stats_add_vars(&wh->fusion.prediction_stats, wh);
 
 	u_var_add_gui_header(wh, NULL, "SLAM Tracking");
 	u_var_add_ro_text(wh, wh->gui.slam_status, "Tracker status");
@@ -1813,6 +1822,7 @@ wmr_hmd_setup_trackers(struct wmr_hmd *wh, struct xrt_slam_sinks *out_sinks, str
 
 	// Initialize 3DoF tracker
 	m_imu_3dof_init(&wh->fusion.i3dof, M_IMU_3DOF_USE_GRAVITY_DUR_20MS);
+	m_prediction_stats_init(&wh->fusion.prediction_stats, "WMR HMD");
 
 	// Initialize SLAM tracker
 	struct xrt_slam_sinks *slam_sinks = NULL;
@@ -1840,15 +1850,15 @@ wmr_hmd_setup_trackers(struct wmr_hmd *wh, struct xrt_slam_sinks *out_sinks, str
 	// Setup sinks depending on tracking configuration
 	struct xrt_slam_sinks entry_sinks = {0};
 	if (slam_enabled && hand_enabled) {
-		struct xrt_frame_sink *entry_cam0_sink = NULL;
-		struct xrt_frame_sink *entry_cam1_sink = NULL;
-
-		u_sink_split_create(&wh->tracking.xfctx, slam_sinks->cams[0], hand_sinks->cams[0], &entry_cam0_sink);
-		u_sink_split_create(&wh->tracking.xfctx, slam_sinks->cams[1], hand_sinks->cams[1], &entry_cam1_sink);
-
 		entry_sinks = *slam_sinks;
-		entry_sinks.cams[0] = entry_cam0_sink;
-		entry_sinks.cams[1] = entry_cam1_sink;
+
+		// One hub per camera shared by all consumers of it.
+		for (int i = 0; i < 2; i++) {
+			struct u_sink_hub *hub = NULL;
+			u_sink_hub_create(&wh->tracking.xfctx, &hub, &entry_sinks.cams[i]);
+			u_sink_hub_add_derived(hub, XRT_FORMAT_L8, 0, slam_sinks->cams[i]);
+			u_sink_hub_add_derived(hub, XRT_FORMAT_L8, 0, hand_sinks->cams[i]);
+		}
 	} else if (slam_enabled) {
 		entry_sinks = *slam_sinks;
 	} else if (hand_enabled) {
@@ -20,6 +20,7 @@
 #include "xrt/xrt_prober.h"
 #include "os/os_threading.h"
 #include "math/m_imu_3dof.h"
+#include "math/m_prediction_stats.h"
 #include "util/u_logging.h"
 #include "util/u_distortion_mesh.h"
 #include "util/u_var.h"
@@ -130,6 +131,9 @@ struct wmr_hmd
 
 		//! When did we get the last IMU sample, in CPU time.
 		uint64_t last_imu_timestamp_ns;
+
+		//! How far ahead the 3dof pose is asked for.
+		struct m_prediction_stats prediction_stats;
 	} fusion;
 
 	//! Fields related to camera-based tracking (SLAM and hand tracking)
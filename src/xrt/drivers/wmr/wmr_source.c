@@ -75,8 +75,10 @@ struct wmr_source
 	bool is_running;              //!< Whether the device is streaming
 	bool first_imu_received;      //!< Don't send frames until first IMU sample
 	timepoint_ns last_imu_ns;     //!< Last timepoint received.
-	time_duration_ns hw2mono;     //!< Estimated offset from IMU to monotonic clock
+	time_duration_ns hw2mono;     //!< Estimated offset from IMU to monotonic clock at the last sample
 	time_duration_ns cam_hw2mono; //!< Caches hw2mono for use in the full frame bundle
+
+	struct m_clock_offset_estimator hw2mono_est; //!< Offset and skew from IMU to monotonic clock
 };
 
 /*
@@ -121,10 +123,10 @@ receive_imu_sample(struct xrt_imu_sink *sink, struct xrt_imu_sample *s)
 
 	// Convert hardware timestamp into monotonic clock. Update offset estimate hw2mono.
 	// Note this is only done with IMU samples as they have the smallest USB transmission time.
-	const float IMU_FREQ = 250.f; //!< @todo use 1000 if "average_imus" is false
 	timepoint_ns now_hw = s->timestamp_ns;
 	timepoint_ns now_mono = (timepoint_ns)os_monotonic_get_ns();
-	timepoint_ns ts = m_clock_offset_a2b(IMU_FREQ, now_hw, now_mono, &ws->hw2mono);
+	timepoint_ns ts = m_clock_offset_estimator_update(&ws->hw2mono_est, now_hw, now_mono);
+	ws->hw2mono = ts - now_hw;
 
 	/*
 	 * Check if the timepoint does time travel, we get one or two
@@ -301,6 +303,7 @@ wmr_source_create(struct xrt_frame_context *xfctx, struct xrt_prober_device *dev
 
 	struct wmr_source *ws = U_TYPED_CALLOC(struct wmr_source);
 	ws->log_level = debug_get_log_option_wmr_log();
+	m_clock_offset_estimator_init(&ws->hw2mono_est, 0);
 
 	// Setup xrt_fs
 	struct xrt_fs *xfs = &ws->xfs;
@@ -355,6 +358,7 @@ wmr_source_create(struct xrt_frame_context *xfctx, struct xrt_prober_device *dev
 		(void)snprintf(label, sizeof(label), "Camera %d", i);
 		u_var_add_sink_debug(ws, &ws->ui_cam_sinks[i], label);
 	}
+	m_clock_offset_estimator_add_vars(&ws->hw2mono_est, ws, "IMU Clock");
 
 	// Setup node
 	struct xrt_frame_node *xfn = &ws->node;
@@ -599,6 +599,13 @@ struct xrt_compositor_fence
 	 */
 	xrt_result_t (*wait)(struct xrt_compositor_fence *xcf, uint64_t timeout);
 
+	/*!
+	 * Optional, waits until any of the given fences has signalled or the
+	 * timeout expires. Called on the first fence, all of them must come
+	 * from the same compositor.
+	 */
+	xrt_result_t (*wait_any)(struct xrt_compositor_fence **xcfs, uint32_t count, uint64_t timeout);
+
 	/*!
 	 * Destroys the fence.
 	 */
@@ -618,6 +625,25 @@ xrt_compositor_fence_wait(struct xrt_compositor_fence *xcf, uint64_t timeout)
 	return xcf->wait(xcf, timeout);
 }
 
+/*!
+ * @copydoc xrt_compositor_fence::wait_any
+ *
+ * Helper for calling through the function pointer: @p count must be at least
+ * one. If not supported it only waits on the first fence, so check all of them
+ * afterwards.
+ *
+ * @public @memberof xrt_compositor_fence
+ */
+static inline xrt_result_t
+xrt_compositor_fence_wait_any(struct xrt_compositor_fence **xcfs, uint32_t count, uint64_t timeout)
+{
+	if (xcfs[0]->wait_any == NULL) {
+		return xrt_compositor_fence_wait(xcfs[0], timeout);
+	}
+
+	return xcfs[0]->wait_any(xcfs, count, timeout);
+}
+
 /*!
  * @copydoc xrt_compositor_fence::destroy
  *
@@ -661,6 +687,16 @@ struct xrt_compositor_semaphore
 	 */
 	xrt_result_t (*wait)(struct xrt_compositor_semaphore *xcsem, uint64_t value, uint64_t timeout_ns);
 
+	/*!
+	 * Optional, does a CPU side wait until any of the given semaphores has
+	 * reached its value. Called on the first semaphore, all of them must
+	 * come from the same compositor.
+	 */
+	xrt_result_t (*wait_any)(struct xrt_compositor_semaphore **xcsems,
+	                         const uint64_t *values,
+	                         uint32_t count,
+	                         uint64_t timeout_ns);
+
 	/*!
 	 * Destroys the semaphore.
 	 */
@@ -713,6 +749,28 @@ xrt_compositor_semaphore_wait(struct xrt_compositor_semaphore *xcsem, uint64_t v
 	return xcsem->wait(xcsem, value, timeout);
 }
 
+/*!
+ * @copydoc xrt_compositor_semaphore::wait_any
+ *
+ * Helper for calling through the function pointer: @p count must be at least
+ * one. If not supported it only waits on the first semaphore, so check all of
+ * them afterwards.
+ *
+ * @public @memberof xrt_compositor_semaphore
+ */
+static inline xrt_result_t
+xrt_compositor_semaphore_wait_any(struct xrt_compositor_semaphore **xcsems,
+                                  const uint64_t *values,
+                                  uint32_t count,
+                                  uint64_t timeout)
+{
+	if (xcsems[0]->wait_any == NULL) {
+		return xrt_compositor_semaphore_wait(xcsems[0], values[0], timeout);
+	}
+
+	return xcsems[0]->wait_any(xcsems, values, count, timeout);
+}
+
 
 /*
  *
@@ -1975,8 +2033,72 @@ struct xrt_compositor_native
 {
 	//! @public Base
 	struct xrt_compositor base;
+
+	/*!
+	 * Optional, create a swapchain on behalf of the client @p client_id of
+	 * a system compositor. The native compositor may reuse the allocations
+	 * of swapchains previously destroyed by the same client, but never
+	 * those of another client, as the memory has been exported to it.
+	 *
+	 * @param      xcn       Self pointer
+	 * @param      client_id Non-zero id, unique for the lifetime of the
+	 *                       native compositor.
+	 * @param      info      Creation info.
+	 * @param[out] out_xsc   Output swapchain.
+	 */
+	xrt_result_t (*create_client_swapchain)(struct xrt_compositor_native *xcn,
+	                                        uint64_t client_id,
+	                                        const struct xrt_swapchain_create_info *info,
+	                                        struct xrt_swapchain **out_xsc);
+
+	/*!
+	 * Optional, the client @p client_id is gone and won't create any more
+	 * swapchains, free anything kept around for it.
+	 *
+	 * @param xcn       Self pointer
+	 * @param client_id Id given to @ref create_client_swapchain.
+	 */
+	void (*release_client)(struct xrt_compositor_native *xcn, uint64_t client_id);
 };
 
+/*!
+ * @copydoc xrt_compositor_native::create_client_swapchain
+ *
+ * Helper for calling through the function pointer, falls back to
+ * @ref xrt_comp_create_swapchain if the function is not implemented.
+ *
+ * @public @memberof xrt_compositor_native
+ */
+static inline xrt_result_t
+xrt_comp_native_create_client_swapchain(struct xrt_compositor_native *xcn,
+                                        uint64_t client_id,
+                                        const struct xrt_swapchain_create_info *info,
+                                        struct xrt_swapchain **out_xsc)
+{
+	if (xcn->create_client_swapchain == NULL) {
+		return xrt_comp_create_swapchain(&xcn->base, info, out_xsc);
+	}
+
+	return xcn->create_client_swapchain(xcn, client_id, info, out_xsc);
+}
+
+/*!
+ * @copydoc xrt_compositor_native::release_client
+ *
+ * Helper for calling through the function pointer, does a null check.
+ *
+ * @public @memberof xrt_compositor_native
+ */
+static inline void
+xrt_comp_native_release_client(struct xrt_compositor_native *xcn, uint64_t client_id)
+{
+	if (xcn->release_client == NULL) {
+		return;
+	}
+
+	xcn->release_client(xcn, client_id);
+}
+
 /*!
  * @brief Create a native swapchain with a set of images.
  *
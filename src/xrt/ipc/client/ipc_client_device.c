@@ -98,6 +98,39 @@ ipc_client_device_get_tracked_pose(struct xrt_device *xdev,
 	}
 }
 
+static inline float
+unpack_joint_velocity(int16_t value)
+{
+	return (float)value / IPC_HAND_JOINT_VELOCITY_SCALE;
+}
+
+static void
+unpack_hand_joint_set(const struct ipc_hand_joint_set_compact *compact, struct xrt_hand_joint_set *out_value)
+{
+	out_value->hand_pose = compact->hand_pose;
+	out_value->is_active = compact->is_active;
+
+	for (uint32_t i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+		struct xrt_hand_joint_value *v = &out_value->values.hand_joint_set_default[i];
+
+		v->relation.relation_flags = (enum xrt_space_relation_flags)compact->flags[i];
+		v->relation.pose.orientation.x = compact->orientation[0][i];
+		v->relation.pose.orientation.y = compact->orientation[1][i];
+		v->relation.pose.orientation.z = compact->orientation[2][i];
+		v->relation.pose.orientation.w = compact->orientation[3][i];
+		v->relation.pose.position.x = compact->position[0][i];
+		v->relation.pose.position.y = compact->position[1][i];
+		v->relation.pose.position.z = compact->position[2][i];
+		v->relation.linear_velocity.x = unpack_joint_velocity(compact->linear_velocity[0][i]);
+		v->relation.linear_velocity.y = unpack_joint_velocity(compact->linear_velocity[1][i]);
+		v->relation.linear_velocity.z = unpack_joint_velocity(compact->linear_velocity[2][i]);
+		v->relation.angular_velocity.x = unpack_joint_velocity(compact->angular_velocity[0][i]);
+		v->relation.angular_velocity.y = unpack_joint_velocity(compact->angular_velocity[1][i]);
+		v->relation.angular_velocity.z = unpack_joint_velocity(compact->angular_velocity[2][i]);
+		v->radius = compact->radius[i];
+	}
+}
+
 void
 ipc_client_device_get_hand_tracking(struct xrt_device *xdev,
                                     enum xrt_input_name name,
@@ -107,11 +140,15 @@ ipc_client_device_get_hand_tracking(struct xrt_device *xdev,
 {
 	ipc_client_device_t *icd = ipc_client_device(xdev);
 
-	xrt_result_t r = ipc_call_device_get_hand_tracking(icd->ipc_c, icd->device_id, name, at_timestamp_ns, out_value,
-	                                                   out_timestamp_ns);
+	struct ipc_hand_joint_set_compact compact;
+	xrt_result_t r = ipc_call_device_get_hand_tracking_compact(icd->ipc_c, icd->device_id, name, at_timestamp_ns,
+	                                                           &compact, out_timestamp_ns);
 	if (r != XRT_SUCCESS) {
 		IPC_ERROR(icd->ipc_c, "Error sending input update!");
+		return;
 	}
+
+	unpack_hand_joint_set(&compact, out_value);
 }
 
 static void
@@ -111,27 +111,18 @@ ipc_client_hmd_get_view_poses(struct xrt_device *xdev,
 {
 	ipc_client_hmd_t *ich = ipc_client_hmd(xdev);
 
-	struct ipc_info_get_view_poses_2 info = {0};
-
-	if (view_count == 2) {
-		xrt_result_t r = ipc_call_device_get_view_poses_2( //
-		    ich->ipc_c,                                    //
-		    ich->device_id,                                //
-		    default_eye_relation,                          //
-		    at_timestamp_ns,                               //
-		    &info);                                        //
-		if (r != XRT_SUCCESS) {
-			IPC_ERROR(ich->ipc_c, "Error calling view poses!");
-		}
-
-		*out_head_relation = info.head_relation;
-		for (int i = 0; i < 2; i++) {
-			out_fovs[i] = info.fovs[i];
-			out_poses[i] = info.poses[i];
-		}
-	} else {
-		IPC_ERROR(ich->ipc_c, "Cannot handle %u view_count, only 2 supported.", view_count);
-		assert(false && !"Can only handle view_count of 2.");
+	// All views in one round trip, the server fills the arrays directly.
+	xrt_result_t r = ipc_call_device_get_view_poses( //
+	    ich->ipc_c,                                  //
+	    ich->device_id,                              //
+	    default_eye_relation,                        //
+	    at_timestamp_ns,                             //
+	    view_count,                                  //
+	    out_head_relation,                           //
+	    out_fovs,                                    //
+	    out_poses);                                  //
+	if (r != XRT_SUCCESS) {
+		IPC_ERROR(ich->ipc_c, "Error calling view poses!");
 	}
 }
 
@@ -54,6 +54,7 @@ extern "C" {
 struct xrt_instance;
 struct xrt_compositor;
 struct xrt_compositor_native;
+struct u_telemetry_ring;
 
 
 /*!
@@ -121,6 +122,9 @@ struct ipc_client_state
 
 	struct ipc_app_state client_state;
 
+	//! Has this client subscribed to the telemetry ring.
+	bool telemetry_subscribed;
+
 	int server_thread_index;
 };
 
@@ -328,6 +332,12 @@ struct ipc_server
 	struct ipc_shared_memory *ism;
 	xrt_shmem_handle_t ism_handle;
 
+	//! Telemetry ring, NULL if it couldn't be created.
+	struct u_telemetry_ring *telemetry;
+	xrt_shmem_handle_t telemetry_handle;
+	//! Read-only handle to the telemetry ring, the one given to clients.
+	xrt_shmem_handle_t telemetry_ro_handle;
+
 	struct ipc_server_mainloop ml;
 
 	// Is the mainloop supposed to run.
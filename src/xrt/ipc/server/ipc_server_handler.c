@@ -11,11 +11,14 @@
 
 #include "util/u_misc.h"
 #include "util/u_handles.h"
+#include "util/u_telemetry.h"
 #include "util/u_trace_marker.h"
 
 #include "server/ipc_server.h"
 #include "ipc_server_generated.h"
 
+#include <string.h>
+
 #ifdef XRT_GRAPHICS_SYNC_HANDLE_IS_FD
 #include <unistd.h>
 #endif
@@ -202,6 +205,11 @@ ipc_handle_session_create(volatile struct ipc_client_state *ics, const struct xr
 		return XRT_ERROR_IPC_SESSION_ALREADY_CREATED;
 	}
 
+	// Telemetry readers don't get to create sessions.
+	if (ics->telemetry_subscribed) {
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
 	xrt_result_t xret = xrt_syscomp_create_native_compositor(ics->server->xsysc, xsi, &xcn);
 	if (xret != XRT_SUCCESS) {
 		return xret;
@@ -1033,6 +1041,49 @@ ipc_handle_system_toggle_io_device(volatile struct ipc_client_state *ics, uint32
 	return XRT_SUCCESS;
 }
 
+xrt_result_t
+ipc_handle_system_get_telemetry_shm(volatile struct ipc_client_state *ics,
+                                    uint32_t max_handle_capacity,
+                                    xrt_shmem_handle_t *out_handles,
+                                    uint32_t *out_handle_count)
+{
+	IPC_TRACE_MARKER();
+
+	assert(max_handle_capacity >= 1);
+
+	if (ics->server->telemetry == NULL) {
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	// Readers are tools, not applications with a session.
+	if (ics->xc != NULL) {
+		return XRT_ERROR_IPC_SESSION_ALREADY_CREATED;
+	}
+
+	/*
+	 * The name is what the client told us, so this only keeps applications
+	 * from using it by mistake, the handle being read-only is what keeps
+	 * them from writing to the ring.
+	 */
+	if (strncmp((const char *)ics->client_state.info.application_name, IPC_LIBMONADO_APPLICATION_NAME,
+	            sizeof(ics->client_state.info.application_name)) != 0) {
+		IPC_WARN(ics->server, "Client '%s' isn't libmonado, refusing telemetry!",
+		         ics->client_state.info.application_name);
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	// Telemetry is only gathered while there is somebody reading it.
+	if (!ics->telemetry_subscribed) {
+		ics->telemetry_subscribed = true;
+		u_telemetry_add_subscriber();
+	}
+
+	out_handles[0] = ics->server->telemetry_ro_handle;
+	*out_handle_count = 1;
+
+	return XRT_SUCCESS;
+}
+
 xrt_result_t
 ipc_handle_swapchain_get_properties(volatile struct ipc_client_state *ics,
                                     const struct xrt_swapchain_create_info *info,
@@ -1419,25 +1470,100 @@ ipc_handle_device_get_hand_tracking(volatile struct ipc_client_state *ics,
 	return XRT_SUCCESS;
 }
 
+static inline int16_t
+pack_joint_velocity(float value)
+{
+	float scaled = value * IPC_HAND_JOINT_VELOCITY_SCALE;
+
+	if (!(scaled > (float)INT16_MIN)) {
+		// Also catches NaN.
+		return scaled < 0.0f ? INT16_MIN : 0;
+	}
+	if (scaled >= (float)INT16_MAX) {
+		return INT16_MAX;
+	}
+
+	return (int16_t)(scaled + (scaled < 0.0f ? -0.5f : 0.5f));
+}
+
 xrt_result_t
-ipc_handle_device_get_view_poses_2(volatile struct ipc_client_state *ics,
-                                   uint32_t id,
-                                   const struct xrt_vec3 *default_eye_relation,
-                                   uint64_t at_timestamp_ns,
-                                   struct ipc_info_get_view_poses_2 *out_info)
+ipc_handle_device_get_hand_tracking_compact(volatile struct ipc_client_state *ics,
+                                            uint32_t id,
+                                            enum xrt_input_name name,
+                                            uint64_t at_timestamp,
+                                            struct ipc_hand_joint_set_compact *out_value,
+                                            uint64_t *out_timestamp)
 {
 	// To make the code a bit more readable.
 	uint32_t device_id = id;
 	struct xrt_device *xdev = get_xdev(ics, device_id);
 
-	xrt_device_get_view_poses(    //
-	    xdev,                     //
-	    default_eye_relation,     //
-	    at_timestamp_ns,          //
-	    2,                        //
-	    &out_info->head_relation, //
-	    out_info->fovs,           //
-	    out_info->poses);         //
+	struct xrt_hand_joint_set set = {0};
+	xrt_device_get_hand_tracking(xdev, name, at_timestamp, &set, out_timestamp);
+
+	// Sent as is to the client, don't leak anything in the padding.
+	U_ZERO(out_value);
+
+	out_value->hand_pose = set.hand_pose;
+	out_value->is_active = set.is_active;
+
+	for (uint32_t i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+		const struct xrt_hand_joint_value *v = &set.values.hand_joint_set_default[i];
+		enum xrt_space_relation_flags flags = v->relation.relation_flags;
+
+		out_value->orientation[0][i] = v->relation.pose.orientation.x;
+		out_value->orientation[1][i] = v->relation.pose.orientation.y;
+		out_value->orientation[2][i] = v->relation.pose.orientation.z;
+		out_value->orientation[3][i] = v->relation.pose.orientation.w;
+		out_value->position[0][i] = v->relation.pose.position.x;
+		out_value->position[1][i] = v->relation.pose.position.y;
+		out_value->position[2][i] = v->relation.pose.position.z;
+		out_value->radius[i] = v->radius;
+		out_value->flags[i] = (uint16_t)flags;
+
+		if ((flags & XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT) != 0) {
+			out_value->linear_velocity[0][i] = pack_joint_velocity(v->relation.linear_velocity.x);
+			out_value->linear_velocity[1][i] = pack_joint_velocity(v->relation.linear_velocity.y);
+			out_value->linear_velocity[2][i] = pack_joint_velocity(v->relation.linear_velocity.z);
+		}
+
+		if ((flags & XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT) != 0) {
+			out_value->angular_velocity[0][i] = pack_joint_velocity(v->relation.angular_velocity.x);
+			out_value->angular_velocity[1][i] = pack_joint_velocity(v->relation.angular_velocity.y);
+			out_value->angular_velocity[2][i] = pack_joint_velocity(v->relation.angular_velocity.z);
+		}
+	}
+
+	return XRT_SUCCESS;
+}
+
+xrt_result_t
+ipc_handle_device_get_view_poses(volatile struct ipc_client_state *ics,
+                                 uint32_t id,
+                                 const struct xrt_vec3 *fallback_eye_relation,
+                                 uint64_t at_timestamp_ns,
+                                 uint32_t view_count,
+                                 struct xrt_space_relation *out_head_relation,
+                                 struct xrt_fov *out_fovs,
+                                 struct xrt_pose *out_poses)
+{
+	// To make the code a bit more readable.
+	uint32_t device_id = id;
+	struct xrt_device *xdev = get_xdev(ics, device_id);
+
+	if (view_count == 0 || view_count > IPC_MAX_VIEWS) {
+		IPC_ERROR(ics->server, "Invalid view count '%u'!", view_count);
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	xrt_device_get_view_poses( //
+	    xdev,                  //
+	    fallback_eye_relation, //
+	    at_timestamp_ns,       //
+	    view_count,            //
+	    out_head_relation,     //
+	    out_fovs,              //
+	    out_poses);            //
 
 	return XRT_SUCCESS;
 }
@@ -9,11 +9,16 @@
  */
 
 #include "util/u_misc.h"
+#include "util/u_telemetry.h"
 #include "util/u_trace_marker.h"
 
 #include "server/ipc_server.h"
 #include "ipc_server_generated.h"
 
+#ifdef XRT_OS_LINUX
+#include "util/u_linux.h"
+#endif
+
 #ifndef XRT_OS_WINDOWS
 
 #include <unistd.h>
@@ -72,13 +77,18 @@ client_loop(volatile struct ipc_client_state *ics)
 
 	IPC_INFO(ics->server, "Client %u connected", ics->client_state.id);
 
+#ifdef XRT_OS_LINUX
+	u_linux_thread_class_apply(OS_THREAD_CLASS_IPC, ics->server->log_level, "IPC Client");
+#endif
+
 	// Claim the client fd.
 	int epoll_fd = setup_epoll(ics);
 	if (epoll_fd < 0) {
 		return;
 	}
 
-	uint8_t buf[IPC_BUF_SIZE] = {0};
+	// Grows to fit the largest request and any arrays in its reply.
+	struct ipc_message_buffer buf = {0};
 
 	while (ics->server->running) {
 		const int half_a_second_ms = 500;
@@ -102,19 +112,16 @@ client_loop(volatile struct ipc_client_state *ics)
 			break;
 		}
 
-		// Finally get the data that is waiting for us.
-		//! @todo replace this call
-		ssize_t len = recv(ics->imc.ipc_handle, &buf, IPC_BUF_SIZE, 0);
-		if (len < 4) {
+		// Finally get the whole request that is waiting for us.
+		size_t size = 0;
+		xrt_result_t xret = ipc_receive_request((struct ipc_message_channel *)&ics->imc, &buf, &size);
+		if (xret != XRT_SUCCESS) {
 			IPC_ERROR(ics->server, "Invalid packet received, disconnecting client.");
 			break;
 		}
 
-		// Check the first 4 bytes of the message and dispatch.
-		ipc_command_t *ipc_command = (ipc_command_t *)buf;
-
 		IPC_TRACE_BEGIN(ipc_dispatch);
-		xrt_result_t result = ipc_dispatch(ics, ipc_command);
+		xrt_result_t result = ipc_dispatch(ics, &buf, size);
 		IPC_TRACE_END(ipc_dispatch);
 
 		if (result != XRT_SUCCESS) {
@@ -123,6 +130,8 @@ client_loop(volatile struct ipc_client_state *ics)
 		}
 	}
 
+	ipc_message_buffer_fini(&buf);
+
 	close(epoll_fd);
 	epoll_fd = -1;
 
@@ -139,6 +148,12 @@ client_loop(volatile struct ipc_client_state *ics)
 
 	ipc_server_client_destroy_compositor(ics);
 
+	// Stop gathering telemetry if this was the last reader.
+	if (ics->telemetry_subscribed) {
+		ics->telemetry_subscribed = false;
+		u_telemetry_remove_subscriber();
+	}
+
 	// Make sure undestroyed spaces are unreferenced
 	for (uint32_t i = 0; i < IPC_MAX_CLIENT_SPACES; i++) {
 		// Cast away volatile.
@@ -162,37 +177,29 @@ client_loop(volatile struct ipc_client_state *ics)
 
 	IPC_INFO(ics->server, "Client connected");
 
-	uint8_t buf[IPC_BUF_SIZE];
+	// Grows to fit the largest request and any arrays in its reply.
+	struct ipc_message_buffer buf = {0};
 
 	while (ics->server->running) {
-		DWORD len;
-		if (!ReadFile(ics->imc.ipc_handle, buf, sizeof(buf), &len, NULL)) {
-			DWORD err = GetLastError();
-			if (err == ERROR_BROKEN_PIPE) {
-				IPC_INFO(ics->server, "ReadFile from pipe: %d %s", err, ipc_winerror(err));
-			} else {
-				IPC_ERROR(ics->server, "ReadFile from pipe failed: %d %s", err, ipc_winerror(err));
-			}
+		// Logs the error, broken pipe is the client going away.
+		size_t size = 0;
+		xrt_result_t xret = ipc_receive_request((struct ipc_message_channel *)&ics->imc, &buf, &size);
+		if (xret != XRT_SUCCESS) {
 			break;
 		}
-		if (len < sizeof(ipc_command_t)) {
-			IPC_ERROR(ics->server, "Invalid packet received, disconnecting client.");
+
+		IPC_TRACE_BEGIN(ipc_dispatch);
+		xrt_result_t result = ipc_dispatch(ics, &buf, size);
+		IPC_TRACE_END(ipc_dispatch);
+
+		if (result != XRT_SUCCESS) {
+			IPC_ERROR(ics->server, "During packet handling, disconnecting client.");
 			break;
-		} else {
-			// Check the first 4 bytes of the message and dispatch.
-			ipc_command_t *ipc_command = (ipc_command_t *)buf;
-
-			IPC_TRACE_BEGIN(ipc_dispatch);
-			xrt_result_t result = ipc_dispatch(ics, ipc_command);
-			IPC_TRACE_END(ipc_dispatch);
-
-			if (result != XRT_SUCCESS) {
-				IPC_ERROR(ics->server, "During packet handling, disconnecting client.");
-				break;
-			}
 		}
 	}
 
+	ipc_message_buffer_fini(&buf);
+
 	// Multiple threads might be looking at these fields.
 	os_mutex_lock(&ics->server->global_state.lock);
 
@@ -206,6 +213,12 @@ client_loop(volatile struct ipc_client_state *ics)
 
 	ipc_server_client_destroy_compositor(ics);
 
+	// Stop gathering telemetry if this was the last reader.
+	if (ics->telemetry_subscribed) {
+		ics->telemetry_subscribed = false;
+		u_telemetry_remove_subscriber();
+	}
+
 	// Make sure undestroyed spaces are unreferenced
 	for (uint32_t i = 0; i < IPC_MAX_CLIENT_SPACES; i++) {
 		// Cast away volatile.
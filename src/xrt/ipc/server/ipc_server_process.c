@@ -24,9 +24,14 @@
 #include "util/u_verify.h"
 #include "util/u_process.h"
 #include "util/u_debug_gui.h"
+#include "util/u_telemetry.h"
 
 #include "util/u_git_tag.h"
 
+#ifdef XRT_OS_LINUX
+#include "util/u_linux.h"
+#endif
+
 #include "shared/ipc_shmem.h"
 #include "server/ipc_server.h"
 #include "server/ipc_server_interface.h"
@@ -124,6 +129,20 @@ teardown_idevs(struct ipc_server *s)
  *
  */
 
+static void
+teardown_telemetry(struct ipc_server *s)
+{
+	if (s->telemetry == NULL) {
+		return;
+	}
+
+	// Everything that writes to the ring has been destroyed by now.
+	u_telemetry_close();
+
+	ipc_shmem_destroy(&s->telemetry_ro_handle, NULL, 0);
+	ipc_shmem_destroy(&s->telemetry_handle, (void **)&s->telemetry, sizeof(struct u_telemetry_ring));
+}
+
 static void
 teardown_all(struct ipc_server *s)
 {
@@ -145,6 +164,8 @@ teardown_all(struct ipc_server *s)
 	os_mutex_destroy(&s->global_state.lock);
 
 	ipc_shmem_destroy(&s->ism_handle, (void **)&s->ism, sizeof(struct ipc_shared_memory));
+
+	teardown_telemetry(s);
 }
 
 static int
@@ -454,6 +475,33 @@ ipc_server_handle_client_connected(struct ipc_server *vs, xrt_ipc_handle_t ipc_h
 	os_mutex_unlock(&vs->global_state.lock);
 }
 
+static void
+init_telemetry(struct ipc_server *s)
+{
+	const size_t size = sizeof(struct u_telemetry_ring);
+	xrt_shmem_handle_t handle;
+	xrt_result_t result = ipc_shmem_create(size, &handle, (void **)&s->telemetry);
+	if (result != XRT_SUCCESS) {
+		IPC_WARN(s, "Could not create telemetry shared memory, telemetry disabled!");
+		s->telemetry = NULL;
+		return;
+	}
+
+	s->telemetry_handle = handle;
+
+	// Passed to clients that subscribe to the telemetry, they must not be able to write to it.
+	result = ipc_shmem_create_read_only_handle(handle, &s->telemetry_ro_handle);
+	if (result != XRT_SUCCESS) {
+		IPC_WARN(s, "Could not create read-only telemetry handle, telemetry disabled!");
+		ipc_shmem_destroy(&s->telemetry_handle, (void **)&s->telemetry, size);
+		s->telemetry = NULL;
+		return;
+	}
+
+	// Before the system is created, so everything writes to it from the start.
+	u_telemetry_init(s->telemetry);
+}
+
 static int
 init_all(struct ipc_server *s)
 {
@@ -480,6 +528,8 @@ init_all(struct ipc_server *s)
 	s->exit_on_disconnect = debug_get_bool_option_exit_on_disconnect();
 	s->log_level = debug_get_log_option_ipc_log();
 
+	init_telemetry(s);
+
 	xret = xrt_instance_create(NULL, &s->xinst);
 	if (xret != XRT_SUCCESS) {
 		IPC_ERROR(s, "Failed to create instance!");
@@ -527,6 +577,11 @@ init_all(struct ipc_server *s)
 	u_var_add_bool(s, &s->exit_on_disconnect, "exit_on_disconnect");
 	u_var_add_bool(s, (bool *)&s->running, "running");
 
+#ifdef XRT_OS_LINUX
+	// The compositor and driver threads have all been started by now.
+	u_linux_thread_classes_report(s->log_level);
+#endif
+
 	return 0;
 }
 
@@ -26,7 +26,7 @@
 
 
 #define IPC_CRED_SIZE 1    // auth not implemented
-#define IPC_BUF_SIZE 512   // must be >= largest message length in bytes
+#define IPC_BUF_SIZE 512   // initial size of receive buffers, grown as needed
 #define IPC_MAX_VIEWS 8    // max views we will return configs for
 #define IPC_MAX_FORMATS 32 // max formats our server-side compositor supports
 #define IPC_MAX_DEVICES 8  // max number of devices we will map using shared mem
@@ -35,6 +35,12 @@
 #define IPC_MAX_CLIENTS 8
 #define IPC_EVENT_QUEUE_SIZE 32
 
+//! Largest request or reply, including any arrays, that we accept.
+#define IPC_MAX_MESSAGE_SIZE (1024 * 1024)
+
+//! Application name libmonado connects with, only it may read the telemetry.
+#define IPC_LIBMONADO_APPLICATION_NAME "libmonado"
+
 #define IPC_SHARED_MAX_INPUTS 1024
 #define IPC_SHARED_MAX_OUTPUTS 128
 #define IPC_SHARED_MAX_BINDINGS 64
@@ -320,11 +326,26 @@ struct ipc_arg_swapchain_from_native
 };
 
 /*!
- * Arguments for xrt_device::get_view_poses with two views.
+ * Steps per m/s and rad/s of the joint velocities in
+ * @ref ipc_hand_joint_set_compact, giving a range of about ±32 m/s and rad/s.
+ */
+#define IPC_HAND_JOINT_VELOCITY_SCALE (1000.0f)
+
+/*!
+ * Compact form of @ref xrt_hand_joint_set used by xrt_device::get_hand_tracking,
+ * the joints are sent as a structure of arrays with the velocities as 16 bit
+ * fixed point, see @ref IPC_HAND_JOINT_VELOCITY_SCALE, making it about four
+ * fifths of the size. The velocity flags are kept as is, the velocities are
+ * zero where they are not valid.
  */
-struct ipc_info_get_view_poses_2
+struct ipc_hand_joint_set_compact
 {
-	struct xrt_fov fovs[2];
-	struct xrt_pose poses[2];
-	struct xrt_space_relation head_relation;
+	struct xrt_space_relation hand_pose;
+	float orientation[4][XRT_HAND_JOINT_COUNT];
+	float position[3][XRT_HAND_JOINT_COUNT];
+	float radius[XRT_HAND_JOINT_COUNT];
+	int16_t linear_velocity[3][XRT_HAND_JOINT_COUNT];
+	int16_t angular_velocity[3][XRT_HAND_JOINT_COUNT];
+	uint16_t flags[XRT_HAND_JOINT_COUNT];
+	bool is_active;
 };
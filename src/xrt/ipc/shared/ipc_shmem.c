@@ -24,6 +24,7 @@
 // non-android unix
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <stdio.h>
 #endif
 
 #if defined(XRT_OS_ANDROID)
@@ -49,6 +50,23 @@ ipc_shmem_create(size_t size, xrt_shmem_handle_t *out_handle, void **out_map)
 	return XRT_SUCCESS;
 }
 
+xrt_result_t
+ipc_shmem_create_read_only_handle(xrt_shmem_handle_t handle, xrt_shmem_handle_t *out_handle)
+{
+	// Existing mappings keep their protection, all new ones are read-only.
+	if (ASharedMemory_setProt(handle, PROT_READ) != 0) {
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	int fd = dup(handle);
+	if (fd < 0) {
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	*out_handle = fd;
+	return XRT_SUCCESS;
+}
+
 #elif defined(XRT_OS_UNIX)
 
 #define MONADO_SHMEM_NAME "/monado_shm"
@@ -78,6 +96,28 @@ ipc_shmem_create(size_t size, xrt_shmem_handle_t *out_handle, void **out_map)
 	return XRT_SUCCESS;
 }
 
+xrt_result_t
+ipc_shmem_create_read_only_handle(xrt_shmem_handle_t handle, xrt_shmem_handle_t *out_handle)
+{
+	char path[64];
+	snprintf(path, sizeof(path), "/proc/self/fd/%d", handle);
+
+	// A new open file description, a dup would share the read-write access mode.
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	// Otherwise the receiver could reopen its handle through /proc the same way.
+	if (fchmod(handle, S_IRUSR) < 0) {
+		close(fd);
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	*out_handle = fd;
+	return XRT_SUCCESS;
+}
+
 #elif defined(XRT_OS_WINDOWS)
 
 xrt_result_t
@@ -100,6 +140,19 @@ ipc_shmem_create(size_t size, xrt_shmem_handle_t *out_handle, void **out_map)
 	return XRT_SUCCESS;
 }
 
+xrt_result_t
+ipc_shmem_create_read_only_handle(xrt_shmem_handle_t handle, xrt_shmem_handle_t *out_handle)
+{
+	HANDLE process = GetCurrentProcess();
+	HANDLE ro_handle = NULL;
+	if (!DuplicateHandle(process, handle, process, &ro_handle, FILE_MAP_READ, FALSE, 0)) {
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	*out_handle = ro_handle;
+	return XRT_SUCCESS;
+}
+
 #else
 #error "OS not yet supported"
 #endif
@@ -137,6 +190,17 @@ ipc_shmem_map(xrt_shmem_handle_t handle, size_t size, void **out_map)
 	return XRT_SUCCESS;
 }
 
+xrt_result_t
+ipc_shmem_map_read_only(xrt_shmem_handle_t handle, size_t size, const void **out_map)
+{
+	void *ptr = mmap(NULL, size, PROT_READ, MAP_SHARED, handle, 0);
+	if (ptr == MAP_FAILED) {
+		return XRT_ERROR_IPC_FAILURE;
+	}
+	*out_map = ptr;
+	return XRT_SUCCESS;
+}
+
 void
 ipc_shmem_unmap(void **map_ptr, size_t size)
 {
@@ -174,6 +238,17 @@ ipc_shmem_map(xrt_shmem_handle_t handle, size_t size, void **out_map)
 	return XRT_SUCCESS;
 }
 
+xrt_result_t
+ipc_shmem_map_read_only(xrt_shmem_handle_t handle, size_t size, const void **out_map)
+{
+	void *ptr = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, size);
+	if (ptr == NULL) {
+		return XRT_ERROR_IPC_FAILURE;
+	}
+	*out_map = ptr;
+	return XRT_SUCCESS;
+}
+
 void
 ipc_shmem_unmap(void **map_ptr, size_t size)
 {
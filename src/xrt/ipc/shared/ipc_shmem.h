@@ -39,6 +39,20 @@ extern "C" {
 xrt_result_t
 ipc_shmem_create(size_t size, xrt_shmem_handle_t *out_handle, void **out_map);
 
+/*!
+ * Create a second handle to a region created with @ref ipc_shmem_create that
+ * can only be mapped read-only, for handing to processes that must not write
+ * to it. After this the region can no longer be mapped writable again, on some
+ * platforms also not through @p handle, existing mappings are not affected.
+ *
+ * @param[in] handle Handle for region
+ * @param[in,out] out_handle Pointer to the handle to populate.
+ *
+ * @public @memberof xrt_shmem_handle_t
+ */
+xrt_result_t
+ipc_shmem_create_read_only_handle(xrt_shmem_handle_t handle, xrt_shmem_handle_t *out_handle);
+
 /*!
  * Map a shared memory region.
  *
@@ -52,6 +66,19 @@ ipc_shmem_create(size_t size, xrt_shmem_handle_t *out_handle, void **out_map);
 xrt_result_t
 ipc_shmem_map(xrt_shmem_handle_t handle, size_t size, void **out_map);
 
+/*!
+ * Map a shared memory region read-only, writes through the mapping fault.
+ *
+ * @param[in] handle Handle for region
+ * @param[in] size Size of region
+ * @param[in,out] out_map Pointer to the pointer to populate with the mapping of
+ * this shared memory region.
+ *
+ * @public @memberof xrt_shmem_handle_t
+ */
+xrt_result_t
+ipc_shmem_map_read_only(xrt_shmem_handle_t handle, size_t size, const void **out_map);
+
 /*!
  * Unmap a shared memory region.
  *
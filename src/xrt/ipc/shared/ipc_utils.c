@@ -21,6 +21,7 @@
 #endif
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <assert.h>
@@ -110,6 +111,188 @@ ipc_receive(struct ipc_message_channel *imc, void *out_data, size_t size)
 	return XRT_SUCCESS;
 }
 
+/*!
+ * Lays out the parts with padding in between, @p padding is used for the
+ * padding and needs to be @ref IPC_MESSAGE_PART_ALIGN bytes.
+ */
+static size_t
+fill_part_iovecs(const struct ipc_message_part *parts,
+                 uint32_t part_count,
+                 uint8_t *padding,
+                 struct iovec *iov,
+                 size_t *out_iov_count)
+{
+	size_t offset = 0;
+	size_t count = 0;
+
+	for (uint32_t i = 0; i < part_count; i++) {
+		size_t pad = ipc_message_part_offset(offset) - offset;
+		if (pad > 0) {
+			iov[count++] = (struct iovec){padding, pad};
+			offset += pad;
+		}
+
+		iov[count++] = (struct iovec){parts[i].data, parts[i].size};
+		offset += parts[i].size;
+	}
+
+	*out_iov_count = count;
+
+	return offset;
+}
+
+static xrt_result_t
+send_iovecs(struct ipc_message_channel *imc, struct iovec *iov, size_t iov_count, size_t size)
+{
+	struct msghdr msg = {0};
+	msg.msg_iov = iov;
+	msg.msg_iovlen = iov_count;
+
+	ssize_t ret = sendmsg(imc->ipc_handle, &msg, MSG_NOSIGNAL);
+	if (ret < 0) {
+		int code = errno;
+		IPC_ERROR(imc, "ERROR: Sending message on socket %d failed with error: '%i' '%s'!",
+		          (int)imc->ipc_handle, code, strerror(code));
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	if ((size_t)ret != size) {
+		IPC_ERROR(imc, "sendmsg failed: sent '%zi' of '%zu' bytes!", ret, size);
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	return XRT_SUCCESS;
+}
+
+xrt_result_t
+ipc_send_request(struct ipc_message_channel *imc, const struct ipc_message_part *parts, uint32_t part_count)
+{
+	assert(part_count > 0 && part_count <= IPC_MAX_MESSAGE_PARTS);
+
+	uint8_t padding[IPC_MESSAGE_PART_ALIGN] = {0};
+	struct iovec iov[1 + IPC_MAX_MESSAGE_PARTS * 2];
+	size_t iov_count = 0;
+
+	// The header is not part of the layout, the server does not receive it into the buffer.
+	size_t size = fill_part_iovecs(parts, part_count, padding, &iov[1], &iov_count);
+	if (size > IPC_MAX_MESSAGE_SIZE) {
+		IPC_ERROR(imc, "Request too large '%zu'!", size);
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	struct ipc_message_header header = {(uint32_t)size};
+	iov[0] = (struct iovec){&header, sizeof(header)};
+
+	return send_iovecs(imc, iov, iov_count + 1, sizeof(header) + size);
+}
+
+xrt_result_t
+ipc_receive_request(struct ipc_message_channel *imc, struct ipc_message_buffer *buf, size_t *out_size)
+{
+	if (!ipc_message_buffer_reserve(buf, IPC_BUF_SIZE)) {
+		return XRT_ERROR_ALLOCATION;
+	}
+
+	// Most requests fit, get the header and the whole request in one call.
+	struct ipc_message_header header = {0};
+	struct iovec iov[2] = {
+	    {&header, sizeof(header)},
+	    {buf->data, buf->capacity},
+	};
+
+	struct msghdr msg = {0};
+	msg.msg_iov = iov;
+	msg.msg_iovlen = ARRAY_SIZE(iov);
+
+	ssize_t len = recvmsg(imc->ipc_handle, &msg, 0);
+	if (len < 0) {
+		int code = errno;
+		IPC_ERROR(imc, "ERROR: Receiving request on socket '%d' failed with error: '%i' '%s'!",
+		          (int)imc->ipc_handle, code, strerror(code));
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	if ((size_t)len < sizeof(header)) {
+		IPC_ERROR(imc, "Invalid request received, only got '%zi' bytes!", len);
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	if (header.size < sizeof(uint32_t) || header.size > IPC_MAX_MESSAGE_SIZE) {
+		IPC_ERROR(imc, "Invalid request size '%u'!", header.size);
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	// Requests and replies are in lockstep, so there can't be another request queued up behind this one.
+	size_t got = (size_t)len - sizeof(header);
+	if (got > header.size) {
+		IPC_ERROR(imc, "Got '%zu' bytes more than the request size!", got - header.size);
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	if (got < header.size) {
+		if (!ipc_message_buffer_reserve(buf, header.size)) {
+			return XRT_ERROR_ALLOCATION;
+		}
+
+		size_t left = header.size - got;
+		len = recv(imc->ipc_handle, buf->data + got, left, MSG_WAITALL);
+		if (len < 0 || (size_t)len != left) {
+			IPC_ERROR(imc, "Failed to receive the rest of the request, '%zi' of '%zu' bytes!", len, left);
+			return XRT_ERROR_IPC_FAILURE;
+		}
+	}
+
+	*out_size = header.size;
+
+	return XRT_SUCCESS;
+}
+
+xrt_result_t
+ipc_send_parts(struct ipc_message_channel *imc, const struct ipc_message_part *parts, uint32_t part_count)
+{
+	assert(part_count > 0 && part_count <= IPC_MAX_MESSAGE_PARTS);
+
+	uint8_t padding[IPC_MESSAGE_PART_ALIGN] = {0};
+	struct iovec iov[IPC_MAX_MESSAGE_PARTS * 2];
+	size_t iov_count = 0;
+
+	size_t size = fill_part_iovecs(parts, part_count, padding, iov, &iov_count);
+
+	return send_iovecs(imc, iov, iov_count, size);
+}
+
+xrt_result_t
+ipc_receive_parts(struct ipc_message_channel *imc, const struct ipc_message_part *parts, uint32_t part_count)
+{
+	assert(part_count > 0 && part_count <= IPC_MAX_MESSAGE_PARTS);
+
+	uint8_t padding[IPC_MESSAGE_PART_ALIGN];
+	struct iovec iov[IPC_MAX_MESSAGE_PARTS * 2];
+	size_t iov_count = 0;
+
+	size_t size = fill_part_iovecs(parts, part_count, padding, iov, &iov_count);
+
+	struct msghdr msg = {0};
+	msg.msg_iov = iov;
+	msg.msg_iovlen = iov_count;
+
+	// Larger messages may arrive in pieces, wait for all of it.
+	ssize_t len = recvmsg(imc->ipc_handle, &msg, MSG_WAITALL);
+	if (len < 0) {
+		int code = errno;
+		IPC_ERROR(imc, "ERROR: Receiving message on socket '%d' failed with error: '%i' '%s'!",
+		          (int)imc->ipc_handle, code, strerror(code));
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	if ((size_t)len != size) {
+		IPC_ERROR(imc, "recvmsg failed with error: wrong size '%zi', expected '%zu'!", len, size);
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	return XRT_SUCCESS;
+}
+
 union imcontrol_buf {
 	uint8_t buf[512];
 	struct cmsghdr align;
@@ -204,6 +387,52 @@ ipc_send_fds(struct ipc_message_channel *imc, const void *data, size_t size, con
 
 #endif
 
+
+/*
+ *
+ * Message buffer functions.
+ *
+ */
+
+bool
+ipc_message_buffer_reserve(struct ipc_message_buffer *buf, size_t size)
+{
+	if (size <= buf->capacity) {
+		return true;
+	}
+
+	size_t capacity = buf->capacity > 0 ? buf->capacity : IPC_BUF_SIZE;
+	while (capacity < size) {
+		capacity *= 2;
+	}
+
+	uint8_t *data = realloc(buf->data, capacity);
+	if (data == NULL) {
+		U_LOG_E("Failed to grow message buffer to '%zu' bytes!", capacity);
+		return false;
+	}
+
+	buf->data = data;
+	buf->capacity = capacity;
+
+	return true;
+}
+
+void
+ipc_message_buffer_fini(struct ipc_message_buffer *buf)
+{
+	free(buf->data);
+	buf->data = NULL;
+	buf->capacity = 0;
+}
+
+
+/*
+ *
+ * Shared memory handle functions.
+ *
+ */
+
 xrt_result_t
 ipc_receive_handles_shmem(struct ipc_message_channel *imc,
                           void *out_data,
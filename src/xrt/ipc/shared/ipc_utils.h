@@ -69,6 +69,115 @@ ipc_send(struct ipc_message_channel *imc, const void *data, size_t size);
 xrt_result_t
 ipc_receive(struct ipc_message_channel *imc, void *out_data, size_t size);
 
+
+/*!
+ * @name Variable length messages
+ * @brief Requests are framed with a @ref ipc_message_header so the server can
+ * receive messages of any size, replies are made of parts that the receiver
+ * already knows the size of.
+ * @{
+ */
+
+//! Every part of a message after the first starts at a multiple of this.
+#define IPC_MESSAGE_PART_ALIGN (8)
+
+//! Maximum number of parts in a single message.
+#define IPC_MAX_MESSAGE_PARTS (8)
+
+/*!
+ * Sent in front of every request, @p size does not include the header.
+ */
+struct ipc_message_header
+{
+	uint32_t size;
+};
+
+/*!
+ * One part of a message, like the fixed message struct or an array.
+ */
+struct ipc_message_part
+{
+	void *data;
+	size_t size;
+};
+
+/*!
+ * A receive buffer that grows to fit the largest message seen.
+ */
+struct ipc_message_buffer
+{
+	uint8_t *data;
+	size_t capacity;
+};
+
+/*!
+ * Round @p offset up to where the next message part starts.
+ */
+static inline size_t
+ipc_message_part_offset(size_t offset)
+{
+	return (offset + IPC_MESSAGE_PART_ALIGN - 1) & ~(size_t)(IPC_MESSAGE_PART_ALIGN - 1);
+}
+
+/*!
+ * Make sure the buffer can hold at least @p size bytes, keeping the contents.
+ *
+ * @public @memberof ipc_message_buffer
+ */
+bool
+ipc_message_buffer_reserve(struct ipc_message_buffer *buf, size_t size);
+
+/*!
+ * Free the memory of the buffer.
+ *
+ * @public @memberof ipc_message_buffer
+ */
+void
+ipc_message_buffer_fini(struct ipc_message_buffer *buf);
+
+/*!
+ * Send a request made up of @p parts, with a @ref ipc_message_header in front,
+ * as a single message.
+ *
+ * @public @memberof ipc_message_channel
+ */
+xrt_result_t
+ipc_send_request(struct ipc_message_channel *imc, const struct ipc_message_part *parts, uint32_t part_count);
+
+/*!
+ * Receive a whole request sent with @ref ipc_send_request, @p buf is grown as
+ * needed and holds the request without the header.
+ *
+ * @param imc Message channel to use
+ * @param buf Buffer to receive into.
+ * @param[out] out_size Size of the request.
+ *
+ * @public @memberof ipc_message_channel
+ */
+xrt_result_t
+ipc_receive_request(struct ipc_message_channel *imc, struct ipc_message_buffer *buf, size_t *out_size);
+
+/*!
+ * Send @p parts as a single message, gathered from where they are.
+ *
+ * @public @memberof ipc_message_channel
+ */
+xrt_result_t
+ipc_send_parts(struct ipc_message_channel *imc, const struct ipc_message_part *parts, uint32_t part_count);
+
+/*!
+ * Receive a message sent with @ref ipc_send_parts straight into @p parts, the
+ * sizes of the parts must match the sending side.
+ *
+ * @public @memberof ipc_message_channel
+ */
+xrt_result_t
+ipc_receive_parts(struct ipc_message_channel *imc, const struct ipc_message_part *parts, uint32_t part_count);
+
+/*!
+ * @}
+ */
+
 /*!
  * @name File Descriptor utilities
  * @brief These are typically called from within the send/receive_handles
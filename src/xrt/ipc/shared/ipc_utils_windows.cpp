@@ -79,6 +79,138 @@ ipc_receive(struct ipc_message_channel *imc, void *out_data, size_t size)
 	return XRT_SUCCESS;
 }
 
+/*!
+ * Pipes are in message mode, so the parts are gathered into one buffer and
+ * written as a single message, laid out with the same padding as on Linux.
+ */
+static void
+gather_parts(const struct ipc_message_part *parts, uint32_t part_count, std::vector<uint8_t> &out)
+{
+	for (uint32_t i = 0; i < part_count; i++) {
+		out.resize(ipc_message_part_offset(out.size()), 0);
+		if (parts[i].size == 0) {
+			continue;
+		}
+		const uint8_t *data = (const uint8_t *)parts[i].data;
+		out.insert(out.end(), data, data + parts[i].size);
+	}
+}
+
+xrt_result_t
+ipc_send_request(struct ipc_message_channel *imc, const struct ipc_message_part *parts, uint32_t part_count)
+{
+	assert(part_count > 0 && part_count <= IPC_MAX_MESSAGE_PARTS);
+
+	std::vector<uint8_t> payload;
+	gather_parts(parts, part_count, payload);
+	if (payload.size() > IPC_MAX_MESSAGE_SIZE) {
+		IPC_ERROR(imc, "Request too large '%zu'!", payload.size());
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	struct ipc_message_header header = {(uint32_t)payload.size()};
+	const uint8_t *h = (const uint8_t *)&header;
+	payload.insert(payload.begin(), h, h + sizeof(header));
+
+	return ipc_send(imc, payload.data(), payload.size());
+}
+
+xrt_result_t
+ipc_receive_request(struct ipc_message_channel *imc, struct ipc_message_buffer *buf, size_t *out_size)
+{
+	if (!ipc_message_buffer_reserve(buf, IPC_BUF_SIZE)) {
+		return XRT_ERROR_ALLOCATION;
+	}
+
+	// The header is read into the buffer and moved out of the way after.
+	size_t got = 0;
+	while (true) {
+		DWORD len = 0;
+		if (ReadFile(imc->ipc_handle, buf->data + got, DWORD(buf->capacity - got), &len, NULL)) {
+			got += len;
+			break;
+		}
+
+		DWORD err = GetLastError();
+		if (err != ERROR_MORE_DATA) {
+			if (err == ERROR_BROKEN_PIPE) {
+				IPC_INFO(imc, "ReadFile from pipe: %d %s", err, ipc_winerror(err));
+			} else {
+				IPC_ERROR(imc, "ReadFile from pipe %p failed: %d %s", imc->ipc_handle, err,
+				          ipc_winerror(err));
+			}
+			return XRT_ERROR_IPC_FAILURE;
+		}
+
+		got += len;
+		if (got >= IPC_MAX_MESSAGE_SIZE + sizeof(struct ipc_message_header)) {
+			IPC_ERROR(imc, "Request too large!");
+			return XRT_ERROR_IPC_FAILURE;
+		}
+		if (!ipc_message_buffer_reserve(buf, buf->capacity * 2)) {
+			return XRT_ERROR_ALLOCATION;
+		}
+	}
+
+	struct ipc_message_header header = {};
+	if (got < sizeof(header)) {
+		IPC_ERROR(imc, "Invalid request received, only got '%zu' bytes!", got);
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	memcpy(&header, buf->data, sizeof(header));
+	if (header.size < sizeof(uint32_t) || header.size != got - sizeof(header)) {
+		IPC_ERROR(imc, "Invalid request size '%u', got '%zu' bytes!", header.size, got - sizeof(header));
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	memmove(buf->data, buf->data + sizeof(header), header.size);
+	*out_size = header.size;
+
+	return XRT_SUCCESS;
+}
+
+xrt_result_t
+ipc_send_parts(struct ipc_message_channel *imc, const struct ipc_message_part *parts, uint32_t part_count)
+{
+	assert(part_count > 0 && part_count <= IPC_MAX_MESSAGE_PARTS);
+
+	std::vector<uint8_t> message;
+	gather_parts(parts, part_count, message);
+
+	return ipc_send(imc, message.data(), message.size());
+}
+
+xrt_result_t
+ipc_receive_parts(struct ipc_message_channel *imc, const struct ipc_message_part *parts, uint32_t part_count)
+{
+	assert(part_count > 0 && part_count <= IPC_MAX_MESSAGE_PARTS);
+
+	size_t size = 0;
+	for (uint32_t i = 0; i < part_count; i++) {
+		size = ipc_message_part_offset(size) + parts[i].size;
+	}
+
+	std::vector<uint8_t> message(size);
+	DWORD len = 0;
+	if (!ReadFile(imc->ipc_handle, message.data(), DWORD(size), &len, NULL) || len != size) {
+		DWORD err = GetLastError();
+		IPC_ERROR(imc, "ReadFile from pipe %p failed: %d %s", imc->ipc_handle, err, ipc_winerror(err));
+		return XRT_ERROR_IPC_FAILURE;
+	}
+
+	size_t offset = 0;
+	for (uint32_t i = 0; i < part_count; i++) {
+		offset = ipc_message_part_offset(offset);
+		if (parts[i].size > 0) {
+			memcpy(parts[i].data, message.data() + offset, parts[i].size);
+		}
+		offset += parts[i].size;
+	}
+
+	return XRT_SUCCESS;
+}
+
 xrt_result_t
 ipc_receive_fds(
     struct ipc_message_channel *imc, void *out_data, size_t size, HANDLE *out_handles, uint32_t handle_count)
@@ -83,7 +83,9 @@ class Arg:
 
     def get_func_argument_in(self):
         """Get the type and name of this argument as an input parameter."""
-        if self.is_aggregate:
+        if self.is_array:
+            return "const " + self.typename + " *" + self.name
+        elif self.is_aggregate:
             return "const " + self.typename + " *" + self.name
         else:
             return self.typename + " " + self.name
@@ -98,12 +100,22 @@ class Arg:
 
     def dump(self):
         """Dump human-readable output to standard out."""
-        print("\t\t" + self.typename + ": " + self.name)
+        if self.is_array:
+            print("\t\t" + self.typename + "[" + self.count + "]: " +
+                  self.name)
+        else:
+            print("\t\t" + self.typename + ": " + self.name)
+
+    @property
+    def is_array(self):
+        """Is this a variable length array sent after the message struct."""
+        return self.count is not None
 
     def __init__(self, data):
         """Construct an argument."""
         self.name = data['name']
         self.typename = data['type']
+        self.count = data.get('count')
         self.is_standard_scalar = False
         self.is_aggregate = False
         self.is_enum = False
@@ -227,7 +239,44 @@ class Call:
     @property
     def needs_msg_struct(self):
         """Decide whether this call needs a msg struct."""
-        return self.in_args or self.in_handles
+        return self.in_struct_args or self.in_handles
+
+    @property
+    def in_struct_args(self):
+        """Get the input arguments that go in the msg struct."""
+        return [arg for arg in self.in_args if not arg.is_array]
+
+    @property
+    def in_arrays(self):
+        """Get the input arrays sent after the msg struct."""
+        return [arg for arg in self.in_args if arg.is_array]
+
+    @property
+    def out_struct_args(self):
+        """Get the output arguments that go in the reply struct."""
+        return [arg for arg in self.out_args if not arg.is_array]
+
+    @property
+    def out_arrays(self):
+        """Get the output arrays sent after the reply struct."""
+        return [arg for arg in self.out_args if arg.is_array]
+
+    def validate_arrays(self):
+        """Check that the arrays of this call can be sent."""
+        counts = dict((arg.name, arg) for arg in self.in_struct_args)
+        arrays = self.in_arrays + self.out_arrays
+        for arg in arrays:
+            count = counts.get(arg.count)
+            if count is None or count.typename != "uint32_t":
+                raise RuntimeError("Count of array '%s' in call '%s' must "
+                                   "be a uint32_t input argument"
+                                   % (arg.name, self.name))
+        if arrays and (self.in_handles or self.out_handles):
+            raise RuntimeError("Call '%s' can not have both arrays and "
+                               "handles" % self.name)
+        # Keep synchronized with IPC_MAX_MESSAGE_PARTS.
+        if len(self.in_arrays) >= 8 or len(self.out_arrays) >= 8:
+            raise RuntimeError("Too many arrays in call '%s'" % self.name)
 
     def __init__(self, name, data):
         """Construct a call from call name and call data dictionary."""
@@ -252,6 +301,7 @@ class Call:
                 raise RuntimeError("Unrecognized key")
         if not self.id:
             self.id = "IPC_" + name.upper()
+        self.validate_arrays()
 
 
 class Proto:
@@ -75,18 +75,18 @@ ipc_cmd_to_str(ipc_command_t id)
             f.write("\nstruct ipc_" + call.name + "_msg\n")
             f.write("{\n")
             f.write("\tenum ipc_command cmd;\n")
-            for arg in call.in_args:
+            for arg in call.in_struct_args:
                 f.write("\t" + arg.get_struct_field() + ";\n")
             if call.in_handles:
                 f.write("\t%s %s;\n" % (call.in_handles.count_arg_type,
                                         call.in_handles.count_arg_name))
             f.write("};\n")
         # Should we emit a reply struct.
-        if call.out_args:
+        if call.out_struct_args:
             f.write("\nstruct ipc_" + call.name + "_reply\n")
             f.write("{\n")
             f.write("\txrt_result_t result;\n")
-            for arg in call.out_args:
+            for arg in call.out_struct_args:
                 f.write("\t" + arg.get_struct_field() + ";\n")
             f.write("};\n")
 
@@ -119,7 +119,7 @@ def generate_client_c(file, p):
         else:
             f.write("\tstruct ipc_command_msg _msg = {\n")
         f.write("\t    .cmd = " + str(call.id) + ",\n")
-        for arg in call.in_args:
+        for arg in call.in_struct_args:
             if arg.is_aggregate:
                 f.write("\t    ." + arg.name + " = *" + arg.name + ",\n")
             else:
@@ -129,11 +129,27 @@ def generate_client_c(file, p):
                     " = " + call.in_handles.count_arg_name + ",\n")
         f.write("\t};\n")
 
+        # The request, with any arrays sent straight from the arguments.
+        f.write("\tstruct ipc_message_part _request[] = {\n")
+        f.write("\t    {&_msg, sizeof(_msg)},\n")
+        for arg in call.in_arrays:
+            f.write("\t    {(void *)%s, sizeof(*%s) * %s},\n" % (
+                arg.name, arg.name, arg.count))
+        f.write("\t};\n")
+
         # Reply struct
-        if call.out_args:
+        if call.out_struct_args:
             f.write("\tstruct ipc_" + call.name + "_reply _reply;\n")
         else:
             f.write("\tstruct ipc_result_reply _reply = {0};\n")
+        if call.out_arrays:
+            # Received straight into the arguments.
+            f.write("\tstruct ipc_message_part _reply_parts[] = {\n")
+            f.write("\t    {&_reply, sizeof(_reply)},\n")
+            for arg in call.out_arrays:
+                f.write("\t    {out_%s, sizeof(*out_%s) * %s},\n" % (
+                    arg.name, arg.name, arg.count))
+            f.write("\t};\n")
         if call.in_handles:
             f.write("\tstruct ipc_result_reply _sync = {0};\n")
 
@@ -144,8 +160,8 @@ def generate_client_c(file, p):
         cleanup = "os_mutex_unlock(&ipc_c->mutex);"
 
         # Prepare initial sending
-        func = 'ipc_send'
-        args = ['&ipc_c->imc', '&_msg', 'sizeof(_msg)']
+        func = 'ipc_send_request'
+        args = ['&ipc_c->imc', '_request', 'ARRAY_SIZE(_request)']
         f.write("\n\t// Send our request")
         write_invocation(f, 'xrt_result_t ret', func, args, indent="\t")
         f.write(';')
@@ -194,6 +210,9 @@ def generate_client_c(file, p):
         f.write("\n\t// Await the reply")
         func = 'ipc_receive'
         args = ['&ipc_c->imc', '&_reply', 'sizeof(_reply)']
+        if call.out_arrays:
+            func = 'ipc_receive_parts'
+            args = ['&ipc_c->imc', '_reply_parts', 'ARRAY_SIZE(_reply_parts)']
         if call.out_handles:
             func += '_handles_' + call.out_handles.stem
             args.extend(call.out_handles.arg_names)
@@ -201,7 +220,7 @@ def generate_client_c(file, p):
         f.write(';')
         write_result_handler(f, 'ret', cleanup, indent="\t")
 
-        for arg in call.out_args:
+        for arg in call.out_struct_args:
             f.write("\t*out_" + arg.name + " = _reply." + arg.name + ";\n")
         f.write("\n\t" + cleanup)
         f.write("\n\treturn _reply.result;\n}\n")
@@ -235,6 +254,45 @@ def generate_client_h(file, p):
     f.close()
 
 
+def write_array_layout(f, call, msg_type):
+    """Write the checks and pointers for the arrays of a call.
+
+    Input arrays follow the msg struct in the receive buffer, output arrays
+    are put after them in the same buffer before being sent back.
+    """
+    f.write("\t\tsize_t _size = sizeof(*msg);\n")
+    for prefix, arrays in (("in", call.in_arrays), ("out", call.out_arrays)):
+        for arg in arrays:
+            f.write("\t\tif (msg->%s > IPC_MAX_MESSAGE_SIZE / sizeof(%s)) {\n"
+                    % (arg.count, arg.typename))
+            f.write("\t\t\treturn XRT_ERROR_IPC_FAILURE;\n")
+            f.write("\t\t}\n")
+            f.write("\t\tsize_t _%s_%s_offset = ipc_message_part_offset(_size);\n"
+                    % (prefix, arg.name))
+            f.write("\t\t_size = _%s_%s_offset + sizeof(%s) * msg->%s;\n"
+                    % (prefix, arg.name, arg.typename, arg.count))
+        if prefix == "in" and arrays:
+            f.write("\t\tif (_size != size) {\n")
+            f.write("\t\t\treturn XRT_ERROR_IPC_FAILURE;\n")
+            f.write("\t\t}\n")
+
+    if call.out_arrays:
+        f.write("\t\tif (!ipc_message_buffer_reserve(buf, _size)) {\n")
+        f.write("\t\t\treturn XRT_ERROR_ALLOCATION;\n")
+        f.write("\t\t}\n")
+        f.write("\t\t// The buffer might have moved.\n")
+        f.write("\t\tmsg = (%s *)buf->data;\n" % msg_type)
+
+    for arg in call.in_arrays:
+        f.write("\t\tconst {0} *in_{1} = (const {0} *)(buf->data + _in_{1}_offset);\n"
+                .format(arg.typename, arg.name))
+    for arg in call.out_arrays:
+        f.write("\t\t{0} *out_{1} = ({0} *)(buf->data + _out_{1}_offset);\n"
+                .format(arg.typename, arg.name))
+        f.write("\t\tmemset(out_{0}, 0, sizeof(*out_{0}) * msg->{1});\n"
+                .format(arg.name, arg.count))
+
+
 def generate_server_c(file, p):
     """Generate IPC server stub/dispatch source."""
     f = open(file, "w")
@@ -249,12 +307,16 @@ def generate_server_c(file, p):
 
 #include "ipc_server_generated.h"
 
+#include <string.h>
+
 ''')
 
     f.write('''
 xrt_result_t
-ipc_dispatch(volatile struct ipc_client_state *ics, ipc_command_t *ipc_command)
+ipc_dispatch(volatile struct ipc_client_state *ics, struct ipc_message_buffer *buf, size_t size)
 {
+\tipc_command_t *ipc_command = (ipc_command_t *)buf->data;
+
 \tswitch (*ipc_command) {
 ''')
 
@@ -265,10 +327,19 @@ ipc_dispatch(volatile struct ipc_client_state *ics, ipc_command_t *ipc_command)
                 "\");\n\n")
 
         if call.needs_msg_struct:
-            f.write(
-                "\t\tstruct ipc_{}_msg *msg = ".format(call.name))
-            f.write("(struct ipc_{}_msg *)ipc_command;\n".format(call.name))
-        if call.out_args:
+            msg_type = "struct ipc_{}_msg".format(call.name)
+        else:
+            msg_type = "struct ipc_command_msg"
+        # Arrays follow the msg struct, so only its size is fixed.
+        size_op = "<" if call.in_arrays else "!="
+        f.write("\t\tif (size %s sizeof(%s)) {\n" % (size_op, msg_type))
+        f.write("\t\t\treturn XRT_ERROR_IPC_FAILURE;\n")
+        f.write("\t\t}\n")
+        if call.needs_msg_struct:
+            f.write("\t\t%s *msg = (%s *)buf->data;\n" % (msg_type, msg_type))
+        if call.in_arrays or call.out_arrays:
+            write_array_layout(f, call, msg_type)
+        if call.out_struct_args:
             f.write("\t\tstruct ipc_%s_reply reply = {0};\n" % call.name)
         else:
             f.write("\t\tstruct ipc_result_reply reply = {0};\n")
@@ -330,10 +401,17 @@ ipc_dispatch(volatile struct ipc_client_state *ics, ipc_command_t *ipc_command)
         # Write call to ipc_handle_CALLNAME
         args = ["ics"]
         for arg in call.in_args:
-            args.append(("&msg->" + arg.name)
-                        if arg.is_aggregate
-                        else ("msg->" + arg.name))
-        args.extend("&reply." + arg.name for arg in call.out_args)
+            if arg.is_array:
+                args.append("in_" + arg.name)
+            elif arg.is_aggregate:
+                args.append("&msg->" + arg.name)
+            else:
+                args.append("msg->" + arg.name)
+        for arg in call.out_args:
+            if arg.is_array:
+                args.append("out_" + arg.name)
+            else:
+                args.append("&reply." + arg.name)
         if call.out_handles:
             args.extend(("XRT_MAX_IPC_HANDLES",
                          call.out_handles.arg_name,
@@ -353,6 +431,17 @@ ipc_dispatch(volatile struct ipc_client_state *ics, ipc_command_t *ipc_command)
         args = ["(struct ipc_message_channel *)&ics->imc",
                 "&reply",
                 "sizeof(reply)"]
+        if call.out_arrays:
+            f.write("\t\tstruct ipc_message_part reply_parts[] = {\n")
+            f.write("\t\t    {&reply, sizeof(reply)},\n")
+            for arg in call.out_arrays:
+                f.write("\t\t    {out_%s, sizeof(*out_%s) * msg->%s},\n" % (
+                    arg.name, arg.name, arg.count))
+            f.write("\t\t};\n")
+            func = 'ipc_send_parts'
+            args = ["(struct ipc_message_channel *)&ics->imc",
+                    "reply_parts",
+                    "ARRAY_SIZE(reply_parts)"]
         if call.out_handles:
             func += '_handles_' + call.out_handles.stem
             args.extend(call.out_handles.arg_names)
@@ -399,7 +488,8 @@ def generate_server_header(file, p):
         "ipc_dispatch",
         [
             "volatile struct ipc_client_state *ics",
-            "ipc_command_t *ipc_command"
+            "struct ipc_message_buffer *buf",
+            "size_t size"
         ]
     )
     f.write(";\n")
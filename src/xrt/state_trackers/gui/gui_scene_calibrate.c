@@ -160,7 +160,9 @@ render_progress(struct calibration_scene *cs)
 	}
 
 	static const ImVec2 progress_dims = {150, 0};
-	if (cs->status.cooldown > 0) {
+	if (cs->status.solving) {
+		igText("Solving calibration, %.1f seconds", cs->status.solve_seconds);
+	} else if (cs->status.cooldown > 0) {
 		// This progress bar intentionally counts down to 0.
 		float cooldown = (float)(cs->status.cooldown) / (float)cs->params.num_cooldown_frames;
 		igText("Move to a new position");
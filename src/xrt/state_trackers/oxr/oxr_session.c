@@ -27,6 +27,7 @@
 #include "util/u_misc.h"
 #include "util/u_time.h"
 #include "util/u_verify.h"
+#include "util/u_hand_tracking.h"
 
 #include "math/m_api.h"
 #include "math/m_mathinclude.h"
@@ -1052,39 +1053,44 @@ oxr_session_hand_joints(struct oxr_logger *log,
 	// We know we are active.
 	locations->isActive = true;
 
-	for (uint32_t i = 0; i < locations->jointCount; i++) {
+	// Move all of the joints into the base space in one go.
+	struct u_hand_joints_soa joints;
+	u_hand_joints_soa_from_set(&value, &joints);
+	u_hand_joints_soa_transform(&joints, &T_base_hand);
+
+	uint32_t joint_count = MIN(locations->jointCount, XRT_HAND_JOINT_COUNT);
+	for (uint32_t i = 0; i < joint_count; i++) {
 		locations->jointLocations[i].locationFlags =
 		    xrt_to_xr_space_location_flags(value.values.hand_joint_set_default[i].relation.relation_flags);
-		locations->jointLocations[i].radius = value.values.hand_joint_set_default[i].radius;
-
-		struct xrt_space_relation r = value.values.hand_joint_set_default[i].relation;
-
-		struct xrt_space_relation result;
-		struct xrt_relation_chain chain = {0};
-		m_relation_chain_push_relation(&chain, &r);
-		m_relation_chain_push_relation(&chain, &T_base_hand);
-		m_relation_chain_resolve(&chain, &result);
+		locations->jointLocations[i].radius = joints.radius[i];
 
-		xrt_to_xr_pose(&result.pose, &locations->jointLocations[i].pose);
+		XrPosef *pose = &locations->jointLocations[i].pose;
+		pose->orientation.x = joints.orientation[0][i];
+		pose->orientation.y = joints.orientation[1][i];
+		pose->orientation.z = joints.orientation[2][i];
+		pose->orientation.w = joints.orientation[3][i];
+		pose->position.x = joints.position[0][i];
+		pose->position.y = joints.position[1][i];
+		pose->position.z = joints.position[2][i];
 
 		if (vel) {
 			XrHandJointVelocityEXT *v = &vel->jointVelocities[i];
 
 			v->velocityFlags = 0;
-			if ((result.relation_flags & XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT)) {
+			if ((joints.flags[i] & XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT)) {
 				v->velocityFlags |= XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
 			}
-			if ((result.relation_flags & XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT)) {
+			if ((joints.flags[i] & XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT)) {
 				v->velocityFlags |= XR_SPACE_VELOCITY_ANGULAR_VALID_BIT;
 			}
 
-			v->linearVelocity.x = result.linear_velocity.x;
-			v->linearVelocity.y = result.linear_velocity.y;
-			v->linearVelocity.z = result.linear_velocity.z;
+			v->linearVelocity.x = joints.linear_velocity[0][i];
+			v->linearVelocity.y = joints.linear_velocity[1][i];
+			v->linearVelocity.z = joints.linear_velocity[2][i];
 
-			v->angularVelocity.x = result.angular_velocity.x;
-			v->angularVelocity.y = result.angular_velocity.y;
-			v->angularVelocity.z = result.angular_velocity.z;
+			v->angularVelocity.x = joints.angular_velocity[0][i];
+			v->angularVelocity.y = joints.angular_velocity[1][i];
+			v->angularVelocity.z = joints.angular_velocity[2][i];
 		}
 	}
 
@@ -455,6 +455,7 @@ initialize(struct prober *p, struct xrt_prober_entry_lists *lists)
 	int ret;
 
 	u_config_json_open_or_create_main_file(&p->json);
+	u_config_json_load_thread_classes(&p->json);
 
 	ret = collect_entries(p);
 	if (ret != 0) {
@@ -11,11 +11,13 @@
  * @ingroup st_ovrd
  */
 
+#include <algorithm>
 #include <cstring>
 #include <thread>
 
 #include "math/m_api.h"
 #include "ovrd_log.hpp"
+#include "ovrd_pose_pusher.hpp"
 #include "openvr_driver.h"
 
 extern "C" {
@@ -25,6 +27,7 @@ extern "C" {
 
 #include <math/m_space.h>
 #include "os/os_time.h"
+#include "util/u_time.h"
 #include "util/u_debug.h"
 #include "util/u_device.h"
 #include "util/u_builders.h"
@@ -52,6 +55,9 @@ DEBUG_GET_ONCE_BOOL_OPTION(emulate_index_controller, "STEAMVR_EMULATE_INDEX_CONT
 
 DEBUG_GET_ONCE_NUM_OPTION(scale_percentage, "XRT_COMPOSITOR_SCALE_PERCENTAGE", 140)
 
+//! How many times per display frame the poses of all devices are pushed to SteamVR.
+DEBUG_GET_ONCE_NUM_OPTION(pose_updates_per_frame, "STEAMVR_POSE_UPDATES_PER_FRAME", 4)
+
 #define MODELNUM_LEN (XRT_DEVICE_NAME_LEN + 9) // "[Monado] "
 
 #define OPENVR_BONE_COUNT 31
@@ -363,11 +369,14 @@ hand_joint_set_to_bone_transform(struct xrt_hand_joint_set hand_joint_set,
 	flexion_joints_to_bone_transform(&hand_joint_set, out_bone_transforms, hand);
 }
 
-class CDeviceDriver_Monado_Controller : public vr::ITrackedDeviceServerDriver
+class CDeviceDriver_Monado_Controller : public vr::ITrackedDeviceServerDriver, public IPoseSource_Monado
 {
 public:
-	CDeviceDriver_Monado_Controller(struct xrt_instance *xinst, struct xrt_device *xdev, enum xrt_hand hand)
-	    : m_xdev(xdev), m_hand(hand)
+	CDeviceDriver_Monado_Controller(struct xrt_instance *xinst,
+	                                struct xrt_device *xdev,
+	                                enum xrt_hand hand,
+	                                CPosePusher_Monado *pose_pusher)
+	    : m_xdev(xdev), m_hand(hand), m_pose_pusher(pose_pusher)
 	{
 		ovrd_log("Creating Controller %s\n", xdev->str);
 
@@ -706,24 +715,6 @@ public:
 		}
 	}
 
-	void
-	PoseUpdateThreadFunction()
-	{
-		ovrd_log("Starting controller pose update thread for %s\n", m_xdev->str);
-
-		while (m_poseUpdating) {
-			//! @todo figure out the best pose update rate
-			std::this_thread::sleep_for(std::chrono::milliseconds(1));
-
-			if (m_unObjectId != vr::k_unTrackedDeviceIndexInvalid) {
-				vr::VRServerDriverHost()->TrackedDevicePoseUpdated(m_unObjectId, GetPose(),
-				                                                   sizeof(vr::DriverPose_t));
-			}
-		}
-
-		ovrd_log("Stopping controller pose update thread for %s\n", m_xdev->str);
-	}
-
 	vr::EVRInitError
 	Activate(vr::TrackedDeviceIndex_t unObjectId)
 	{
@@ -801,11 +792,7 @@ public:
 
 		ovrd_log("Controller %d activated\n", m_unObjectId);
 
-		m_poseUpdateThread = new std::thread(&CDeviceDriver_Monado_Controller::PoseUpdateThreadFunction, this);
-		if (!m_poseUpdateThread) {
-			ovrd_log("Unable to create pose updated thread for %s\n", m_xdev->str);
-			return vr::VRInitError_Driver_Failed;
-		}
+		m_pose_pusher->AddSource(this);
 
 		return vr::VRInitError_None;
 	}
@@ -814,8 +801,7 @@ public:
 	Deactivate()
 	{
 		ovrd_log("deactivate controller\n");
-		m_poseUpdating = false;
-		m_poseUpdateThread->join();
+		m_pose_pusher->RemoveSource(this);
 		m_unObjectId = vr::k_unTrackedDeviceIndexInvalid;
 	}
 
@@ -845,7 +831,19 @@ public:
 	vr::DriverPose_t
 	GetPose()
 	{
-		// monado predicts pose "now", see xrt_device_get_tracked_pose
+		return GetPoseAt(os_monotonic_get_ns());
+	}
+
+	vr::TrackedDeviceIndex_t
+	GetPoseSourceIndex()
+	{
+		return m_unObjectId;
+	}
+
+	vr::DriverPose_t
+	GetPoseAt(int64_t at_ns)
+	{
+		// monado predicts pose to at_ns which is "now", see xrt_device_get_tracked_pose
 		m_pose.poseTimeOffset = 0;
 
 		m_pose.poseIsValid = true;
@@ -874,10 +872,8 @@ public:
 			grip_name = XRT_INPUT_GENERIC_HEAD_POSE; // ???
 		}
 
-		timepoint_ns now_ns = os_monotonic_get_ns();
-
 		struct xrt_space_relation rel;
-		xrt_device_get_tracked_pose(m_xdev, grip_name, now_ns, &rel);
+		xrt_device_get_tracked_pose(m_xdev, grip_name, at_ns, &rel);
 
 		struct xrt_pose *offset = &m_xdev->tracking_origin->offset;
 
@@ -1042,8 +1038,7 @@ private:
 
 	std::string m_input_profile;
 
-	bool m_poseUpdating = true;
-	std::thread *m_poseUpdateThread = NULL;
+	CPosePusher_Monado *m_pose_pusher = NULL;
 };
 
 /*
@@ -1052,10 +1047,13 @@ private:
  *
  */
 
-class CDeviceDriver_Monado : public vr::ITrackedDeviceServerDriver, public vr::IVRDisplayComponent
+class CDeviceDriver_Monado : public vr::ITrackedDeviceServerDriver,
+                             public vr::IVRDisplayComponent,
+                             public IPoseSource_Monado
 {
 public:
-	CDeviceDriver_Monado(struct xrt_instance *xinst, struct xrt_device *xdev) : m_xdev(xdev)
+	CDeviceDriver_Monado(struct xrt_instance *xinst, struct xrt_device *xdev, CPosePusher_Monado *pose_pusher)
+	    : m_xdev(xdev), m_pose_pusher(pose_pusher)
 	{
 		//! @todo latency
 		m_flSecondsFromVsyncToPhotons = 0.011f;
@@ -1101,6 +1099,10 @@ public:
 	virtual void DebugRequest(const char *pchRequest, char *pchResponseBuffer, uint32_t unResponseBufferSize);
 	virtual vr::DriverPose_t GetPose();
 
+	// IPoseSource_Monado
+	virtual vr::TrackedDeviceIndex_t GetPoseSourceIndex();
+	virtual vr::DriverPose_t GetPoseAt(int64_t at_ns);
+
 	// IVRDisplayComponent
 	virtual void GetWindowBounds(int32_t *pnX, int32_t *pnY, uint32_t *pnWidth, uint32_t *pnHeight);
 	virtual bool IsDisplayOnDesktop();
@@ -1127,9 +1129,8 @@ private:
 	struct xrt_fov m_fovs[2];
 	struct xrt_pose m_view_pose[2];
 
-	bool m_poseUpdating = true;
-	std::thread *m_poseUpdateThread = NULL;
-	virtual void PoseUpdateThreadFunction();
+	CPosePusher_Monado *m_pose_pusher = NULL;
+	bool m_active = false;
 
 	// clang-format on
 };
@@ -1153,20 +1154,6 @@ create_translation_rotation_matrix(struct xrt_pose *pose, struct vr::HmdMatrix34
 	res->m[2][3] = t.z;
 }
 
-void
-CDeviceDriver_Monado::PoseUpdateThreadFunction()
-{
-	ovrd_log("Starting HMD pose update thread\n");
-
-	while (m_poseUpdating) {
-		//! @todo figure out the best pose update rate
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-		vr::VRServerDriverHost()->TrackedDevicePoseUpdated(m_trackedDeviceIndex, GetPose(),
-		                                                   sizeof(vr::DriverPose_t));
-	}
-	ovrd_log("Stopping HMD pose update thread\n");
-}
-
 vr::EVRInitError
 CDeviceDriver_Monado::Activate(vr::TrackedDeviceIndex_t unObjectId)
 {
@@ -1201,12 +1188,8 @@ CDeviceDriver_Monado::Activate(vr::TrackedDeviceIndex_t unObjectId)
 
 	vr::VRServerDriverHost()->SetDisplayEyeToHead(m_trackedDeviceIndex, left, right);
 
-
-	m_poseUpdateThread = new std::thread(&CDeviceDriver_Monado::PoseUpdateThreadFunction, this);
-	if (!m_poseUpdateThread) {
-		ovrd_log("Unable to create pose updated thread for %s\n", m_xdev->str);
-		return vr::VRInitError_Driver_Failed;
-	}
+	m_active = true;
+	m_pose_pusher->AddSource(this);
 
 	return vr::VRInitError_None;
 }
@@ -1214,8 +1197,8 @@ CDeviceDriver_Monado::Activate(vr::TrackedDeviceIndex_t unObjectId)
 void
 CDeviceDriver_Monado::Deactivate()
 {
-	m_poseUpdating = false;
-	m_poseUpdateThread->join();
+	m_pose_pusher->RemoveSource(this);
+	m_active = false;
 	ovrd_log("Deactivate\n");
 }
 
@@ -1257,10 +1240,20 @@ HmdQuaternion_Init(double w, double x, double y, double z)
 vr::DriverPose_t
 CDeviceDriver_Monado::GetPose()
 {
+	return GetPoseAt(os_monotonic_get_ns());
+}
+
+vr::TrackedDeviceIndex_t
+CDeviceDriver_Monado::GetPoseSourceIndex()
+{
+	return m_active ? m_trackedDeviceIndex : vr::k_unTrackedDeviceIndexInvalid;
+}
 
-	timepoint_ns now_ns = os_monotonic_get_ns();
+vr::DriverPose_t
+CDeviceDriver_Monado::GetPoseAt(int64_t at_ns)
+{
 	struct xrt_space_relation rel;
-	xrt_device_get_tracked_pose(m_xdev, XRT_INPUT_GENERIC_HEAD_POSE, now_ns, &rel);
+	xrt_device_get_tracked_pose(m_xdev, XRT_INPUT_GENERIC_HEAD_POSE, at_ns, &rel);
 
 	struct xrt_pose *offset = &m_xdev->tracking_origin->offset;
 
@@ -1272,7 +1265,7 @@ CDeviceDriver_Monado::GetPose()
 	vr::DriverPose_t t = {};
 
 
-	// monado predicts pose "now", see xrt_device_get_tracked_pose
+	// monado predicts pose to at_ns which is "now", see xrt_device_get_tracked_pose
 	t.poseTimeOffset = 0;
 
 	//! @todo: Monado head model?
@@ -1447,6 +1440,9 @@ private:
 	CDeviceDriver_Monado *m_MonadoDeviceDriver = NULL;
 	CDeviceDriver_Monado_Controller *m_left = NULL;
 	CDeviceDriver_Monado_Controller *m_right = NULL;
+
+	//! Shared by all devices, pushes their poses from one thread.
+	CPosePusher_Monado *m_pose_pusher = NULL;
 };
 
 CServerDriver_Monado g_serverDriverMonado;
@@ -1487,8 +1483,17 @@ CServerDriver_Monado::Init(vr::IVRDriverContext *pDriverContext)
 
 	m_xhmd = m_xsysd->roles.head;
 
+	int64_t frame_interval_ns = m_xhmd->hmd->screens[0].nominal_frame_interval_ns;
+	if (frame_interval_ns <= 0) {
+		frame_interval_ns = U_TIME_1S_IN_NS / 60;
+	}
+	long updates_per_frame = debug_get_num_option_pose_updates_per_frame();
+	m_pose_pusher = new CPosePusher_Monado(vr::VRServerDriverHost(), frame_interval_ns,
+	                                       (uint32_t)std::max(updates_per_frame, 1L));
+	ovrd_log("Pushing poses every %fms\n", (double)m_pose_pusher->GetPeriod() / (double)U_TIME_1MS_IN_NS);
+
 	ovrd_log("Selected HMD %s\n", m_xhmd->str);
-	m_MonadoDeviceDriver = new CDeviceDriver_Monado(m_xinst, m_xhmd);
+	m_MonadoDeviceDriver = new CDeviceDriver_Monado(m_xinst, m_xhmd, m_pose_pusher);
 	//! @todo provide a serial number
 	vr::VRServerDriverHost()->TrackedDeviceAdded(m_xhmd->str, vr::TrackedDeviceClass_HMD, m_MonadoDeviceDriver);
 
@@ -1500,20 +1505,27 @@ CServerDriver_Monado::Init(vr::IVRDriverContext *pDriverContext)
 	u_builder_setup_tracking_origins(m_xhmd, left_xdev, right_xdev, &offset);
 
 	if (left_xdev) {
-		m_left = new CDeviceDriver_Monado_Controller(m_xinst, left_xdev, XRT_HAND_LEFT);
+		m_left = new CDeviceDriver_Monado_Controller(m_xinst, left_xdev, XRT_HAND_LEFT, m_pose_pusher);
 		ovrd_log("Added left Controller: %s\n", left_xdev->str);
 	}
 	if (right_xdev) {
-		m_right = new CDeviceDriver_Monado_Controller(m_xinst, right_xdev, XRT_HAND_RIGHT);
+		m_right = new CDeviceDriver_Monado_Controller(m_xinst, right_xdev, XRT_HAND_RIGHT, m_pose_pusher);
 		ovrd_log("Added right Controller: %s\n", right_xdev->str);
 	}
 
+	m_pose_pusher->Start();
+
 	return vr::VRInitError_None;
 }
 
 void
 CServerDriver_Monado::Cleanup()
 {
+	// Stop pushing poses before the devices go away.
+	if (m_pose_pusher != NULL) {
+		m_pose_pusher->Stop();
+	}
+
 	if (m_MonadoDeviceDriver != NULL) {
 		delete m_MonadoDeviceDriver;
 		m_MonadoDeviceDriver = NULL;
@@ -1528,6 +1540,9 @@ CServerDriver_Monado::Cleanup()
 	if (m_xinst) {
 		xrt_instance_destroy(&m_xinst);
 	}
+
+	delete m_pose_pusher;
+	m_pose_pusher = NULL;
 }
 
 void
@@ -1577,6 +1592,11 @@ CServerDriver_Monado::HandleHapticEvent(vr::VREvent_t *event)
 void
 CServerDriver_Monado::RunFrame()
 {
+	// Called once per frame by SteamVR, keep the pose updates in step with it.
+	if (m_pose_pusher != NULL) {
+		m_pose_pusher->Vsync(os_monotonic_get_ns());
+	}
+
 	if (m_left) {
 		m_left->RunFrame();
 	}
@@ -0,0 +1,191 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Single thread that pushes the poses of all devices to SteamVR.
+ * @author agent <agent@local>
+ * @ingroup st_ovrd
+ */
+
+#include "ovrd_pose_pusher.hpp"
+
+#include "os/os_time.h"
+#include "util/u_time.h"
+
+#include <algorithm>
+#include <chrono>
+
+
+CPosePusher_Monado::CPosePusher_Monado(vr::IVRServerDriverHost *host,
+                                       int64_t frame_interval_ns,
+                                       uint32_t updates_per_frame)
+    : m_host(host)
+{
+	updates_per_frame = std::max(updates_per_frame, 1u);
+	m_period_ns = std::max<int64_t>(frame_interval_ns / updates_per_frame, U_TIME_1MS_IN_NS / 4);
+	m_phase_ns = os_monotonic_get_ns();
+}
+
+CPosePusher_Monado::~CPosePusher_Monado()
+{
+	Stop();
+}
+
+void
+CPosePusher_Monado::Start()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (m_running) {
+		return;
+	}
+
+	m_running = true;
+	m_thread = std::thread(&CPosePusher_Monado::ThreadFunction, this);
+}
+
+void
+CPosePusher_Monado::Stop()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_running = false;
+	}
+	m_cond.notify_all();
+
+	if (m_thread.joinable()) {
+		m_thread.join();
+	}
+}
+
+void
+CPosePusher_Monado::AddSource(IPoseSource_Monado *source)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (std::find(m_sources.begin(), m_sources.end(), source) == m_sources.end()) {
+		m_sources.push_back(source);
+	}
+}
+
+void
+CPosePusher_Monado::RemoveSource(IPoseSource_Monado *source)
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_sources.erase(std::remove(m_sources.begin(), m_sources.end(), source), m_sources.end());
+
+		if (m_pass_thread == std::this_thread::get_id()) {
+			// Called from a source during a pass, that thread holds m_push_mutex.
+			// Clear it from the pass copy instead, the pass skips it from now on.
+			std::replace(m_pass_sources.begin(), m_pass_sources.end(), source,
+			             (IPoseSource_Monado *)nullptr);
+			return;
+		}
+	}
+
+	// Wait out any pass that still has the source in its copy.
+	std::unique_lock<std::mutex> push_lock(m_push_mutex);
+}
+
+void
+CPosePusher_Monado::Notify()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_wake = true;
+	}
+	m_cond.notify_one();
+}
+
+void
+CPosePusher_Monado::Vsync(int64_t vsync_ns)
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_phase_ns = vsync_ns;
+		m_wake = true;
+	}
+	m_cond.notify_one();
+}
+
+void
+CPosePusher_Monado::PushAll()
+{
+	std::unique_lock<std::mutex> push_lock(m_push_mutex);
+	PushPass();
+}
+
+uint64_t
+CPosePusher_Monado::GetPassCount()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_pass_count;
+}
+
+void
+CPosePusher_Monado::PushPass()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_pass_sources = m_sources;
+		m_pass_thread = std::this_thread::get_id();
+	}
+
+	// Same prediction time for all devices, so they are consistent with each other.
+	int64_t now_ns = os_monotonic_get_ns();
+
+	// Indexed, entries are only cleared during the pass, never erased.
+	for (size_t i = 0; i < m_pass_sources.size(); i++) {
+		IPoseSource_Monado *source = m_pass_sources[i];
+		if (source == nullptr) {
+			continue;
+		}
+
+		vr::TrackedDeviceIndex_t index = source->GetPoseSourceIndex();
+		if (index == vr::k_unTrackedDeviceIndexInvalid) {
+			continue;
+		}
+
+		vr::DriverPose_t pose = source->GetPoseAt(now_ns);
+
+		// The source removed itself while being queried.
+		if (m_pass_sources[i] == nullptr) {
+			continue;
+		}
+
+		m_host->TrackedDevicePoseUpdated(index, pose, sizeof(vr::DriverPose_t));
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_pass_thread = std::thread::id();
+	m_pass_count++;
+}
+
+void
+CPosePusher_Monado::ThreadFunction()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (m_running) {
+		int64_t now_ns = os_monotonic_get_ns();
+
+		// Next point on the grid m_phase_ns + n * m_period_ns that is in the future.
+		int64_t since_ns = now_ns - m_phase_ns;
+		int64_t periods = since_ns >= 0 ? since_ns / m_period_ns + 1 : -(-since_ns / m_period_ns);
+		int64_t next_ns = m_phase_ns + periods * m_period_ns;
+
+		m_cond.wait_for(lock, std::chrono::nanoseconds(next_ns - now_ns), [this] { return m_wake || !m_running; });
+		if (!m_running) {
+			break;
+		}
+
+		m_wake = false;
+
+		// Don't block the other functions while talking to the devices and SteamVR.
+		lock.unlock();
+		{
+			std::unique_lock<std::mutex> push_lock(m_push_mutex);
+			PushPass();
+		}
+		lock.lock();
+	}
+}
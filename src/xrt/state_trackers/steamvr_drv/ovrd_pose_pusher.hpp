@@ -0,0 +1,134 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Single thread that pushes the poses of all devices to SteamVR.
+ * @author agent <agent@local>
+ * @ingroup st_ovrd
+ */
+
+#pragma once
+
+#include "xrt/xrt_defines.h"
+
+#include "openvr_driver.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/*!
+ * Something that has a pose to push to SteamVR, implemented by the device
+ * drivers.
+ *
+ * @ingroup st_ovrd
+ */
+class IPoseSource_Monado
+{
+public:
+	//! Index given to the device in Activate, or k_unTrackedDeviceIndexInvalid.
+	virtual vr::TrackedDeviceIndex_t
+	GetPoseSourceIndex() = 0;
+
+	//! Pose predicted to @p at_ns, on the monotonic clock.
+	virtual vr::DriverPose_t
+	GetPoseAt(int64_t at_ns) = 0;
+
+protected:
+	~IPoseSource_Monado() = default;
+};
+
+/*!
+ * Pushes the poses of all registered sources to SteamVR from one thread, all
+ * predicted to the same timestamp.
+ *
+ * The thread wakes up @p updates_per_frame times per display frame, with the
+ * phase aligned to the last call to @ref Vsync, or as soon as @ref Notify is
+ * called. The sources are queried and the poses pushed without holding the lock
+ * the other functions take, so sources can call into the pusher, including
+ * removing themselves. The host is given in the constructor so that it can be
+ * stubbed out for testing.
+ *
+ * @ingroup st_ovrd
+ */
+class CPosePusher_Monado
+{
+public:
+	CPosePusher_Monado(vr::IVRServerDriverHost *host, int64_t frame_interval_ns, uint32_t updates_per_frame);
+	~CPosePusher_Monado();
+
+	//! Start the thread, does nothing if already started.
+	void
+	Start();
+
+	//! Stop and join the thread, safe to call multiple times.
+	void
+	Stop();
+
+	void
+	AddSource(IPoseSource_Monado *source);
+
+	/*!
+	 * After this returns the source will not be called again. When called
+	 * from a source during a pass it returns straight away, the rest of the
+	 * pass skips the source.
+	 */
+	void
+	RemoveSource(IPoseSource_Monado *source);
+
+	//! A device has a new sample, push all poses now.
+	void
+	Notify();
+
+	//! A new frame started at @p vsync_ns, realign the update phase to it and push all poses now.
+	void
+	Vsync(int64_t vsync_ns);
+
+	//! Push the poses of all sources right now, on the calling thread.
+	void
+	PushAll();
+
+	//! Number of times all poses have been pushed.
+	uint64_t
+	GetPassCount();
+
+	//! Time between two updates.
+	int64_t
+	GetPeriod() const
+	{
+		return m_period_ns;
+	}
+
+private:
+	void
+	ThreadFunction();
+
+	//! Must be called with m_push_mutex held and m_mutex not held.
+	void
+	PushPass();
+
+	vr::IVRServerDriverHost *m_host;
+	int64_t m_period_ns;
+
+	std::mutex m_mutex;
+	std::condition_variable m_cond;
+	std::vector<IPoseSource_Monado *> m_sources;
+	std::thread m_thread;
+
+	//! Held for a whole pass, taken before m_mutex, RemoveSource waits on it.
+	std::mutex m_push_mutex;
+
+	//! Copy of m_sources used during a pass, protected by m_push_mutex, removed sources are set to null.
+	std::vector<IPoseSource_Monado *> m_pass_sources;
+
+	//! Thread running a pass, if any, protected by m_mutex.
+	std::thread::id m_pass_thread;
+
+	//! Updates are done at m_phase_ns + n * m_period_ns.
+	int64_t m_phase_ns = 0;
+	uint64_t m_pass_count = 0;
+	bool m_running = false;
+	bool m_wake = false;
+};
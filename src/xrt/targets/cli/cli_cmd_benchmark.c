@@ -0,0 +1,92 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Headless tracking benchmark on EuRoC datasets.
+ * @author agent <agent@local>
+ */
+
+#include "xrt/xrt_config_build.h"
+#include "xrt/xrt_config_drivers.h"
+
+#include "cli_common.h"
+
+#ifdef XRT_BUILD_DRIVER_EUROC
+#include "euroc/euroc_interface.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+
+#define P(...) fprintf(stderr, __VA_ARGS__)
+
+
+#ifdef XRT_BUILD_DRIVER_EUROC
+//! Set on Ctrl-C, stops the playback early, the report is still written.
+static volatile bool should_exit = false;
+
+static void
+sigint_handler(int sig)
+{
+	should_exit = true;
+}
+
+static int
+print_usage(const char **argv)
+{
+	P("Runs the SLAM and/or hand tracker on a EuRoC dataset without any UI and\n");
+	P("reports processing time, pose latency and trajectory error as JSON.\n");
+	P("\n");
+	P("Usage: %s %s [options] <euroc_path>\n", argv[0], argv[1]);
+	P("\n");
+	P("Options:\n");
+	P("  --slam <config>     Run the SLAM tracker with the given config file.\n");
+	P("  --hand <calib.json> Run Mercury hand tracking with the given stereo calibration.\n");
+	P("  --speed <factor>    Play back at this speed instead of as fast as possible.\n");
+	P("  --output <file>     Write the JSON report to a file instead of stdout.\n");
+
+	return EXIT_FAILURE;
+}
+#endif
+
+int
+cli_cmd_benchmark(int argc, const char **argv)
+{
+#ifndef XRT_BUILD_DRIVER_EUROC
+	P("Euroc driver not built, can't reproduce datasets.\n");
+	return EXIT_FAILURE;
+#else
+	struct euroc_benchmark_config config = {0};
+	const char *output_path = NULL;
+
+	for (int i = 2; i < argc; i++) {
+		bool has_value = i + 1 < argc;
+
+		if (strcmp(argv[i], "--slam") == 0 && has_value) {
+			config.slam_config = argv[++i];
+		} else if (strcmp(argv[i], "--hand") == 0 && has_value) {
+			config.hand_calib = argv[++i];
+		} else if (strcmp(argv[i], "--speed") == 0 && has_value) {
+			config.speed = atof(argv[++i]);
+		} else if (strcmp(argv[i], "--output") == 0 && has_value) {
+			output_path = argv[++i];
+		} else if (argv[i][0] != '-' && config.euroc_path == NULL) {
+			config.euroc_path = argv[i];
+		} else {
+			return print_usage(argv);
+		}
+	}
+
+	if (config.euroc_path == NULL || (config.slam_config == NULL && config.hand_calib == NULL)) {
+		return print_usage(argv);
+	}
+
+	signal(SIGINT, sigint_handler);
+	int ret = euroc_run_benchmark(&config, output_path, &should_exit);
+	signal(SIGINT, SIG_DFL);
+
+	return ret == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+#endif
+}
@@ -6,16 +6,24 @@
  * @author Jakob Bornecrantz <jakob@collabora.com>
  */
 
+#include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <sys/types.h>
 
+#include "xrt/xrt_config_have.h"
 #include "xrt/xrt_instance.h"
 #include "xrt/xrt_prober.h"
 #include "util/u_misc.h"
 #include "cli_common.h"
 
+#ifdef XRT_HAVE_OPENCV
+#include "tracking/t_tracking.h"
+#endif
+
+#define P(...) fprintf(stderr, __VA_ARGS__)
+
 
 struct program
 {
@@ -138,12 +146,113 @@ do_exit(struct program *p, int ret)
 	return ret;
 }
 
+#ifdef XRT_HAVE_OPENCV
+static int
+print_offline_usage(const char **argv)
+{
+	P("Calibrates a stereo camera from a EuRoC dataset or a directory of side by\n");
+	P("side images, using the board settings from the calibration GUI.\n");
+	P("\n");
+	P("Usage: %s %s --offline [options] <path>\n", argv[0], argv[1]);
+	P("\n");
+	P("Options:\n");
+	P("  --output <file>      Where to save the calibration, default 'calibration.json'.\n");
+	P("  --threads <count>    Threads used for board detection, default all cores.\n");
+	P("  --max-samples <num>  Use at most this many of the detected samples, default 100.\n");
+	P("  --cache <file>       Where to cache board detections, default next to the output.\n");
+	P("  --no-cache           Don't read or write the detection cache.\n");
+
+	return EXIT_FAILURE;
+}
+#endif
+
+static int
+calibrate_offline(int argc, const char **argv)
+{
+#ifndef XRT_HAVE_OPENCV
+	P("OpenCV not available, can't calibrate.\n");
+	return EXIT_FAILURE;
+#else
+	struct t_calibration_offline_params params = {0};
+	const char *output_path = "calibration.json";
+	const char *path = NULL;
+	const char *cache_path = NULL;
+	bool use_cache = true;
+	char default_cache_path[1024];
+
+	params.max_samples = 100;
+
+	for (int i = 3; i < argc; i++) {
+		bool has_value = i + 1 < argc;
+
+		if (strcmp(argv[i], "--output") == 0 && has_value) {
+			output_path = argv[++i];
+		} else if (strcmp(argv[i], "--threads") == 0 && has_value) {
+			params.thread_count = (uint32_t)strtoul(argv[++i], NULL, 10);
+		} else if (strcmp(argv[i], "--max-samples") == 0 && has_value) {
+			params.max_samples = (uint32_t)strtoul(argv[++i], NULL, 10);
+		} else if (strcmp(argv[i], "--cache") == 0 && has_value) {
+			cache_path = argv[++i];
+		} else if (strcmp(argv[i], "--no-cache") == 0) {
+			use_cache = false;
+		} else if (argv[i][0] != '-' && path == NULL) {
+			path = argv[i];
+		} else {
+			return print_offline_usage(argv);
+		}
+	}
+
+	if (path == NULL) {
+		return print_offline_usage(argv);
+	}
+
+	// Never write into the dataset, it might be read-only or shared.
+	if (use_cache && cache_path == NULL) {
+		size_t len = strlen(output_path);
+		if (len > 5 && strcmp(output_path + len - 5, ".json") == 0) {
+			len -= 5;
+		}
+		snprintf(default_cache_path, sizeof(default_cache_path), "%.*s_detections.json", (int)len, output_path);
+		cache_path = default_cache_path;
+	}
+
+	if (use_cache) {
+		params.cache_path = cache_path;
+	}
+
+	t_calibration_gui_params_load_or_default(&params.calib);
+
+	struct t_stereo_camera_calibration *data = NULL;
+	int ret = t_calibration_offline(&params, path, &data);
+	if (ret != 0) {
+		P("Calibration failed!\n");
+		return EXIT_FAILURE;
+	}
+
+	bool saved = t_stereo_camera_calibration_save(output_path, data);
+	t_stereo_camera_calibration_reference(&data, NULL);
+
+	if (!saved) {
+		P("Failed to save calibration to '%s'!\n", output_path);
+		return EXIT_FAILURE;
+	}
+
+	printf(" :: Saved calibration to '%s'\n", output_path);
+
+	return EXIT_SUCCESS;
+#endif
+}
+
 int
 cli_cmd_calibrate(int argc, const char **argv)
 {
 	struct program p = {0};
 	int ret;
 
+	if (argc > 2 && strcmp(argv[2], "--offline") == 0) {
+		return calibrate_offline(argc, argv);
+	}
+
 	printf(" :: Starting!\n");
 
 	// Init the prober and other things.
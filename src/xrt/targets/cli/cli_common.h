@@ -14,6 +14,9 @@ extern "C" {
 #endif
 
 
+int
+cli_cmd_benchmark(int argc, const char **argv);
+
 int
 cli_cmd_calibrate(int argc, const char **argv);
 
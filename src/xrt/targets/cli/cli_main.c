@@ -30,9 +30,10 @@ cli_print_help(int argc, const char **argv)
 	P("  test       - List found devices, for prober testing.\n");
 	P("  probe      - Just probe and then exit.\n");
 	P("  lighthouse - Control the power of lighthouses [on|off].\n");
-	P("  calibrate  - Calibrate a camera and save config (not implemented yet).\n");
+	P("  calibrate  - Calibrate a stereo camera from images on disk [--offline <path>].\n");
 	P("  calib-dumb - Load and dump a calibration to stdout.\n");
 	P("  slambatch  - Runs a sequence of EuRoC datasets with the SLAM tracker.\n");
+	P("  benchmark  - Time the SLAM and hand trackers on a EuRoC dataset, JSON output.\n");
 
 	return 1;
 }
@@ -64,5 +65,8 @@ main(int argc, const char **argv)
 	if (strcmp(argv[1], "slambatch") == 0) {
 		return cli_cmd_slambatch(argc, argv);
 	}
+	if (strcmp(argv[1], "benchmark") == 0) {
+		return cli_cmd_benchmark(argc, argv);
+	}
 	return cli_print_help(argc, argv);
 }
@@ -39,6 +39,10 @@
 #define T_BUILDER_RGB_TRACKING
 #endif
 
+#if defined(XRT_BUILD_DRIVER_CAPTURE) || defined(XRT_DOXYGEN)
+#define T_BUILDER_REPLAY
+#endif
+
 #if defined(XRT_BUILD_DRIVER_SIMULATED) || defined(XRT_DOXYGEN)
 #define T_BUILDER_SIMULATED
 #endif
@@ -98,6 +102,14 @@ struct xrt_builder *
 t_builder_remote_create(void);
 #endif
 
+#ifdef T_BUILDER_REPLAY
+/*!
+ * Builder for replaying captures made with @ref drv_capture.
+ */
+struct xrt_builder *
+t_builder_replay_create(void);
+#endif
+
 #ifdef T_BUILDER_RGB_TRACKING
 /*!
  * RGB tracking based drivers, like @ref drv_psmv and @ref drv_psvr.
@@ -112,6 +124,12 @@ t_builder_rgb_tracking_create(void);
  */
 struct xrt_builder *
 t_builder_simulated_create(void);
+
+/*!
+ * Builder for a farm of synthetic @ref drv_simulated devices, for load testing.
+ */
+struct xrt_builder *
+t_builder_simulated_farm_create(void);
 #endif
 
 
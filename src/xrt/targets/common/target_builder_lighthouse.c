@@ -447,32 +447,30 @@ valve_index_setup_visual_trackers(struct lighthouse_system *lhs,
 
 	// Setup frame graph
 
-	struct xrt_frame_sink *entry_left_sink = NULL;
-	struct xrt_frame_sink *entry_right_sink = NULL;
+	struct xrt_frame_sink *entry_cam_sinks[2] = {NULL, NULL};
 	struct xrt_frame_sink *entry_sbs_sink = NULL;
 
-	if (slam_enabled && hand_enabled) {
-		u_sink_split_create(&lhs->devices->xfctx, slam_sinks->cams[0], hand_sinks->cams[0], &entry_left_sink);
-		u_sink_split_create(&lhs->devices->xfctx, slam_sinks->cams[1], hand_sinks->cams[1], &entry_right_sink);
-		u_sink_stereo_sbs_to_slam_sbs_create(&lhs->devices->xfctx, entry_left_sink, entry_right_sink,
-		                                     &entry_sbs_sink);
-		u_sink_create_format_converter(&lhs->devices->xfctx, XRT_FORMAT_L8, entry_sbs_sink, &entry_sbs_sink);
-	} else if (slam_enabled) {
-		entry_left_sink = slam_sinks->cams[0];
-		entry_right_sink = slam_sinks->cams[1];
-		u_sink_stereo_sbs_to_slam_sbs_create(&lhs->devices->xfctx, entry_left_sink, entry_right_sink,
-		                                     &entry_sbs_sink);
-		u_sink_create_format_converter(&lhs->devices->xfctx, XRT_FORMAT_L8, entry_sbs_sink, &entry_sbs_sink);
-	} else if (hand_enabled) {
-		entry_left_sink = hand_sinks->cams[0];
-		entry_right_sink = hand_sinks->cams[1];
-		u_sink_stereo_sbs_to_slam_sbs_create(&lhs->devices->xfctx, entry_left_sink, entry_right_sink,
-		                                     &entry_sbs_sink);
-		u_sink_create_format_converter(&lhs->devices->xfctx, XRT_FORMAT_L8, entry_sbs_sink, &entry_sbs_sink);
-	} else {
+	if (!slam_enabled && !hand_enabled) {
 		LH_WARN("No visual trackers were set");
 		return false;
 	}
+
+	// One hub per camera shared by all consumers of it.
+	for (int i = 0; i < 2; i++) {
+		struct u_sink_hub *hub = NULL;
+		u_sink_hub_create(&lhs->devices->xfctx, &hub, &entry_cam_sinks[i]);
+		if (slam_enabled) {
+			u_sink_hub_add_derived(hub, XRT_FORMAT_L8, 0, slam_sinks->cams[i]);
+		}
+		if (hand_enabled) {
+			u_sink_hub_add_derived(hub, XRT_FORMAT_L8, 0, hand_sinks->cams[i]);
+		}
+	}
+
+	// Converted once for the whole side by side frame.
+	u_sink_stereo_sbs_to_slam_sbs_create(&lhs->devices->xfctx, entry_cam_sinks[0], entry_cam_sinks[1],
+	                                     &entry_sbs_sink);
+	u_sink_create_format_converter(&lhs->devices->xfctx, XRT_FORMAT_L8, entry_sbs_sink, &entry_sbs_sink);
 	//! @todo Using a single slot queue is wrong for SLAM
 	u_sink_simple_queue_create(&lhs->devices->xfctx, entry_sbs_sink, &entry_sbs_sink);
 
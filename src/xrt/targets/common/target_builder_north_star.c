@@ -338,8 +338,14 @@ ns_setup_depthai_device(struct ns_builder *nsb,
 	struct xrt_frame_sink *entry_right_sink = NULL;
 
 #ifdef XRT_BUILD_DRIVER_HANDTRACKING
-	u_sink_split_create(&usysd->xfctx, slam_sinks->cams[0], hand_sinks->cams[0], &entry_left_sink);
-	u_sink_split_create(&usysd->xfctx, slam_sinks->cams[1], hand_sinks->cams[1], &entry_right_sink);
+	struct u_sink_hub *left_hub = NULL;
+	struct u_sink_hub *right_hub = NULL;
+	u_sink_hub_create(&usysd->xfctx, &left_hub, &entry_left_sink);
+	u_sink_hub_create(&usysd->xfctx, &right_hub, &entry_right_sink);
+	u_sink_hub_add_derived(left_hub, XRT_FORMAT_L8, 0, slam_sinks->cams[0]);
+	u_sink_hub_add_derived(left_hub, XRT_FORMAT_L8, 0, hand_sinks->cams[0]);
+	u_sink_hub_add_derived(right_hub, XRT_FORMAT_L8, 0, slam_sinks->cams[1]);
+	u_sink_hub_add_derived(right_hub, XRT_FORMAT_L8, 0, hand_sinks->cams[1]);
 #else
 	entry_left_sink = slam_sinks->cams[0];
 	entry_right_sink = slam_sinks->cams[1];
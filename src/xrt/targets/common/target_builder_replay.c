@@ -0,0 +1,135 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Builder that replays a device capture.
+ * @author agent <agent@local>
+ * @ingroup xrt_iface
+ */
+
+#include "xrt/xrt_config_drivers.h"
+#include "xrt/xrt_prober.h"
+
+#include "util/u_misc.h"
+#include "util/u_debug.h"
+#include "util/u_space_overseer.h"
+
+#include "target_builder_interface.h"
+
+#include "capture/capture_format.h"
+#include "capture/capture_interface.h"
+
+#include <assert.h>
+
+
+#ifndef XRT_BUILD_DRIVER_CAPTURE
+#error "Must only be built with XRT_BUILD_DRIVER_CAPTURE set"
+#endif
+
+DEBUG_GET_ONCE_OPTION(replay_path, "XRT_CAPTURE_REPLAY", NULL)
+
+
+/*
+ *
+ * Helper functions.
+ *
+ */
+
+static const char *driver_list[] = {
+    "capture",
+};
+
+
+/*
+ *
+ * Member functions.
+ *
+ */
+
+static xrt_result_t
+replay_estimate_system(struct xrt_builder *xb,
+                       cJSON *config,
+                       struct xrt_prober *xp,
+                       struct xrt_builder_estimate *estimate)
+{
+	const char *path = debug_get_option_replay_path();
+	if (path == NULL) {
+		return XRT_SUCCESS;
+	}
+
+	uint32_t roles = 0;
+	xrt_result_t xret = capture_replay_read_roles(path, &roles);
+	if (xret != XRT_SUCCESS) {
+		return xret;
+	}
+
+	estimate->certain.head = (roles & CAPTURE_ROLE_HEAD) != 0;
+	estimate->certain.left = (roles & CAPTURE_ROLE_LEFT) != 0;
+	estimate->certain.right = (roles & CAPTURE_ROLE_RIGHT) != 0;
+	estimate->priority = -50;
+
+	return XRT_SUCCESS;
+}
+
+static xrt_result_t
+replay_open_system(struct xrt_builder *xb,
+                   cJSON *config,
+                   struct xrt_prober *xp,
+                   struct xrt_system_devices **out_xsysd,
+                   struct xrt_space_overseer **out_xso)
+{
+	assert(out_xsysd != NULL);
+	assert(*out_xsysd == NULL);
+
+	struct xrt_system_devices *xsysd = NULL;
+	xrt_result_t xret = capture_replay_create_system_devices(debug_get_option_replay_path(), &xsysd);
+	if (xret != XRT_SUCCESS) {
+		return xret;
+	}
+
+	/*
+	 * The tracking origin offsets were captured after being set up, so
+	 * don't use u_builder_create_space_overseer which would apply the
+	 * global offset a second time.
+	 */
+	struct u_space_overseer *uso = u_space_overseer_create();
+
+	struct xrt_pose T_stage_local = XRT_POSE_IDENTITY;
+	T_stage_local.position.y = 1.6f;
+
+	u_space_overseer_legacy_setup(uso, xsysd->xdevs, xsysd->xdev_count, xsysd->roles.head, &T_stage_local);
+
+	*out_xsysd = xsysd;
+	*out_xso = (struct xrt_space_overseer *)uso;
+
+	return XRT_SUCCESS;
+}
+
+static void
+replay_destroy(struct xrt_builder *xb)
+{
+	free(xb);
+}
+
+
+/*
+ *
+ * 'Exported' functions.
+ *
+ */
+
+struct xrt_builder *
+t_builder_replay_create(void)
+{
+	struct xrt_builder *xb = U_TYPED_CALLOC(struct xrt_builder);
+	xb->estimate_system = replay_estimate_system;
+	xb->open_system = replay_open_system;
+	xb->destroy = replay_destroy;
+	xb->identifier = "replay";
+	xb->name = "Device capture replay builder";
+	xb->driver_identifiers = driver_list;
+	xb->driver_identifier_count = ARRAY_SIZE(driver_list);
+	xb->exclude_from_automatic_discovery = debug_get_option_replay_path() == NULL;
+
+	return xb;
+}
@@ -0,0 +1,195 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Builder for a farm of synthetic devices, configured from JSON.
+ * @author agent <agent@local>
+ * @ingroup xrt_iface
+ */
+
+#include "xrt/xrt_config_drivers.h"
+#include "xrt/xrt_prober.h"
+
+#include "math/m_api.h"
+
+#include "util/u_misc.h"
+#include "util/u_file.h"
+#include "util/u_json.h"
+#include "util/u_debug.h"
+#include "util/u_builders.h"
+#include "util/u_system_helpers.h"
+
+#include "target_builder_interface.h"
+
+#include "simulated/simulated_interface.h"
+
+#include <assert.h>
+#include <string.h>
+
+
+#ifndef XRT_BUILD_DRIVER_SIMULATED
+#error "Must only be built with XRT_BUILD_DRIVER_SIMULATED set"
+#endif
+
+//! Path to a JSON farm config, see @ref simulated_farm_config_parse for the format.
+DEBUG_GET_ONCE_OPTION(farm_config_path, "SIMULATED_FARM_CONFIG", NULL)
+
+
+/*
+ *
+ * Helper functions.
+ *
+ */
+
+static const char *driver_list[] = {
+    "simulated",
+};
+
+static void
+default_config(struct simulated_farm_config *out_config)
+{
+	// Same as the plain simulated builder: HMD plus two controllers.
+	U_ZERO(out_config);
+	out_config->hmd = true;
+	out_config->group_count = 1;
+
+	struct simulated_farm_group *group = &out_config->groups[0];
+	group->kind = SIMULATED_FARM_KIND_CONTROLLER;
+	group->count = 2;
+	group->rate_hz = 250;
+	group->complexity = 2;
+	group->radius_m = 0.1f;
+	group->center = (struct xrt_pose)XRT_POSE_IDENTITY;
+	group->center.position.y = 1.3f;
+	group->center.position.z = -0.5f;
+}
+
+static bool
+load_config(const char *path, struct simulated_farm_config *out_config)
+{
+	if (path == NULL) {
+		U_LOG_I("No farm config set with SIMULATED_FARM_CONFIG, using the default.");
+		default_config(out_config);
+		return true;
+	}
+
+	char *file_content = u_file_read_content_from_path(path);
+	if (file_content == NULL) {
+		U_LOG_E("Could not read farm config '%s'.", path);
+		return false;
+	}
+
+	cJSON *json = cJSON_Parse(file_content);
+	free(file_content);
+
+	if (json == NULL) {
+		U_LOG_E("Could not parse farm config '%s'.", path);
+		return false;
+	}
+
+	bool ret = simulated_farm_config_parse(json, out_config);
+	cJSON_Delete(json);
+
+	return ret;
+}
+
+
+/*
+ *
+ * Member functions.
+ *
+ */
+
+static xrt_result_t
+farm_estimate_system(struct xrt_builder *xb, cJSON *config, struct xrt_prober *xp, struct xrt_builder_estimate *estimate)
+{
+	struct simulated_farm_config farm_config;
+	if (!load_config(debug_get_option_farm_config_path(), &farm_config)) {
+		return XRT_SUCCESS;
+	}
+
+	uint32_t controllers = simulated_farm_config_count(&farm_config, SIMULATED_FARM_KIND_CONTROLLER);
+
+	estimate->certain.head = farm_config.hmd;
+	estimate->certain.left = controllers >= 1;
+	estimate->certain.right = controllers >= 2;
+	estimate->priority = -50;
+
+	return XRT_SUCCESS;
+}
+
+static xrt_result_t
+farm_open_system(struct xrt_builder *xb,
+                 cJSON *config,
+                 struct xrt_prober *xp,
+                 struct xrt_system_devices **out_xsysd,
+                 struct xrt_space_overseer **out_xso)
+{
+	assert(out_xsysd != NULL);
+	assert(*out_xsysd == NULL);
+
+	struct simulated_farm_config farm_config;
+	if (!load_config(debug_get_option_farm_config_path(), &farm_config)) {
+		return XRT_ERROR_DEVICE_CREATION_FAILED;
+	}
+
+	struct u_system_devices *usysd = u_system_devices_allocate();
+	struct xrt_system_devices *xsysd = &usysd->base;
+
+	// All farm devices share the system tracking origin.
+	snprintf(usysd->origin.name, sizeof(usysd->origin.name), "Simulated Farm");
+	usysd->origin.type = XRT_TRACKING_TYPE_OTHER;
+	usysd->origin.offset = (struct xrt_pose)XRT_POSE_IDENTITY;
+
+	if (farm_config.hmd) {
+		const struct xrt_pose head_center = {XRT_QUAT_IDENTITY, {0.0f, 1.6f, 0.0f}}; // "nominal height" 1.6m
+
+		struct xrt_device *head = simulated_hmd_create(SIMULATED_MOVEMENT_WOBBLE, &head_center);
+		head->orientation_tracking_supported = true;
+		head->position_tracking_supported = true;
+		head->tracking_origin->type = XRT_TRACKING_TYPE_OTHER;
+
+		xsysd->roles.head = head;
+		xsysd->xdevs[xsysd->xdev_count++] = head;
+	}
+
+	uint32_t max = ARRAY_SIZE(xsysd->xdevs) - (uint32_t)xsysd->xdev_count;
+	uint32_t count = simulated_farm_create(&farm_config, &usysd->origin, &xsysd->xdevs[xsysd->xdev_count], max);
+	xsysd->xdev_count += count;
+
+	simulated_farm_setup_roles(xsysd);
+
+	*out_xsysd = xsysd;
+	u_builder_create_space_overseer(xsysd, out_xso);
+
+	return XRT_SUCCESS;
+}
+
+static void
+farm_destroy(struct xrt_builder *xb)
+{
+	free(xb);
+}
+
+
+/*
+ *
+ * 'Exported' functions.
+ *
+ */
+
+struct xrt_builder *
+t_builder_simulated_farm_create(void)
+{
+	struct xrt_builder *xb = U_TYPED_CALLOC(struct xrt_builder);
+	xb->estimate_system = farm_estimate_system;
+	xb->open_system = farm_open_system;
+	xb->destroy = farm_destroy;
+	xb->identifier = "simulated_farm";
+	xb->name = "Simulated device farm builder";
+	xb->driver_identifiers = driver_list;
+	xb->driver_identifier_count = ARRAY_SIZE(driver_list);
+	xb->exclude_from_automatic_discovery = debug_get_option_farm_config_path() == NULL;
+
+	return xb;
+}
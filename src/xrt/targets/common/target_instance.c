@@ -9,17 +9,23 @@
 #include "xrt/xrt_space.h"
 #include "xrt/xrt_system.h"
 #include "xrt/xrt_config_build.h"
+#include "xrt/xrt_config_drivers.h"
 
 #include "os/os_time.h"
 
 #include "util/u_debug.h"
 #include "util/u_trace_marker.h"
 #include "util/u_system_helpers.h"
+#include "util/u_space_overseer.h"
 
 #ifdef XRT_MODULE_COMPOSITOR_MAIN
 #include "main/comp_main_interface.h"
 #endif
 
+#ifdef XRT_BUILD_DRIVER_CAPTURE
+#include "capture/capture_interface.h"
+#endif
+
 #include "target_instance_parts.h"
 
 #include <assert.h>
@@ -32,6 +38,9 @@
 #endif
 
 DEBUG_GET_ONCE_BOOL_OPTION(use_null, "XRT_COMPOSITOR_NULL", USE_NULL_DEFAULT)
+#ifdef XRT_BUILD_DRIVER_CAPTURE
+DEBUG_GET_ONCE_OPTION(capture_path, "XRT_CAPTURE_PATH", NULL)
+#endif
 
 xrt_result_t
 null_compositor_create_system(struct xrt_device *xdev, struct xrt_system_compositor **out_xsysc);
@@ -44,6 +53,51 @@ null_compositor_create_system(struct xrt_device *xdev, struct xrt_system_composi
  *
  */
 
+#ifdef XRT_BUILD_DRIVER_CAPTURE
+static void
+maybe_wrap_in_capture(struct xrt_system_devices *xsysd, struct xrt_space_overseer *xso)
+{
+	const char *path = debug_get_option_capture_path();
+	if (path == NULL) {
+		return;
+	}
+
+	// All builders use the util space overseer.
+	struct u_space_overseer *uso = (struct u_space_overseer *)xso;
+
+	struct xrt_device *wrapped[XRT_SYSTEM_MAX_DEVICES];
+	struct xrt_device *wrapped_head = xsysd->roles.head;
+	size_t xdev_count = xsysd->xdev_count;
+	for (size_t i = 0; i < xdev_count; i++) {
+		wrapped[i] = xsysd->xdevs[i];
+	}
+
+	xrt_result_t xret = capture_wrap_system_devices(xsysd, path);
+	if (xret != XRT_SUCCESS) {
+		U_LOG_E("Failed to start capture to '%s', continuing without it.", path);
+		return;
+	}
+
+	// Put the wrappers in the same spaces as the devices they wrap.
+	for (size_t i = 0; i < xdev_count; i++) {
+		struct xrt_space *xs = NULL;
+		if (!u_space_overseer_get_device_space(uso, wrapped[i], &xs)) {
+			continue;
+		}
+
+		u_space_overseer_link_space_to_device(uso, xs, xsysd->xdevs[i]);
+		xrt_space_reference(&xs, NULL);
+	}
+
+	// The view space queries the head directly, make it go through the wrapper.
+	if (xso->semantic.view != NULL && wrapped_head != xsysd->roles.head) {
+		xrt_space_reference(&xso->semantic.view, NULL);
+		u_space_overseer_create_pose_space(uso, xsysd->roles.head, XRT_INPUT_GENERIC_HEAD_POSE,
+		                                   &xso->semantic.view);
+	}
+}
+#endif
+
 static xrt_result_t
 t_instance_create_system(struct xrt_instance *xinst,
                          struct xrt_system_devices **out_xsysd,
@@ -68,6 +122,10 @@ t_instance_create_system(struct xrt_instance *xinst,
 		return xret;
 	}
 
+#ifdef XRT_BUILD_DRIVER_CAPTURE
+	maybe_wrap_in_capture(xsysd, xso);
+#endif
+
 	// Early out if we only want devices.
 	if (out_xsysc == NULL) {
 		*out_xsysd = xsysd;
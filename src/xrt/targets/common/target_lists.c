@@ -108,7 +108,12 @@ xrt_builder_create_func_t target_builder_list[] = {
     t_builder_remote_create,
 #endif // T_BUILDER_REMOTE
 
+#ifdef T_BUILDER_REPLAY // High up to override any real hardware.
+    t_builder_replay_create,
+#endif // T_BUILDER_REPLAY
+
 #ifdef T_BUILDER_SIMULATED // High up to override any real hardware.
+    t_builder_simulated_farm_create,
     t_builder_simulated_create,
 #endif // T_BUILDER_SIMULATED
 
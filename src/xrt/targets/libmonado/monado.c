@@ -15,7 +15,9 @@
 #include "util/u_misc.h"
 #include "util/u_file.h"
 #include "util/u_logging.h"
+#include "util/u_telemetry.h"
 
+#include "shared/ipc_shmem.h"
 #include "shared/ipc_protocol.h"
 
 #include "client/ipc_client_connection.h"
@@ -38,6 +40,18 @@ struct mnd_root
 	struct ipc_app_state app_state;
 };
 
+struct mnd_telemetry
+{
+	//! Mapped read-only, the service is the only writer.
+	const struct u_telemetry_ring *ring;
+
+	//! Index of the next entry to read.
+	uint64_t read_index;
+
+	//! Entries are read into here before being converted.
+	struct u_telemetry_entry scratch[64];
+};
+
 #define P(...) fprintf(stdout, __VA_ARGS__)
 #define PE(...) fprintf(stderr, __VA_ARGS__)
 
@@ -86,6 +100,61 @@ get_client_info(mnd_root_t *root, uint32_t client_id)
 	return MND_SUCCESS;
 }
 
+static void
+convert_telemetry_entry(const struct u_telemetry_entry *entry, mnd_telemetry_event_t *out_event)
+{
+	U_ZERO(out_event);
+	out_event->type = (mnd_telemetry_type_t)entry->type;
+	out_event->when_ns = entry->when_ns;
+
+	switch (entry->type) {
+	case U_TELEMETRY_TYPE_COMPOSITOR_FRAME: {
+		const struct u_telemetry_compositor_frame *src = &entry->compositor_frame;
+		mnd_telemetry_compositor_frame_t *dst = &out_event->data.compositor_frame;
+		dst->frame_id = src->frame_id;
+		dst->predicted_display_time_ns = src->predicted_display_time_ns;
+		dst->predicted_display_period_ns = src->predicted_display_period_ns;
+		dst->desired_present_time_ns = src->desired_present_time_ns;
+		dst->actual_present_time_ns = src->actual_present_time_ns;
+		dst->when_predict_ns = src->when_predict_ns;
+		dst->when_woke_ns = src->when_woke_ns;
+		dst->when_began_ns = src->when_began_ns;
+		dst->when_submitted_ns = src->when_submitted_ns;
+		dst->present_margin_ns = src->present_margin_ns;
+		dst->present_slop_ns = src->present_slop_ns;
+	} break;
+	case U_TELEMETRY_TYPE_CLIENT_FRAME: {
+		const struct u_telemetry_client_frame *src = &entry->client_frame;
+		mnd_telemetry_client_frame_t *dst = &out_event->data.client_frame;
+		dst->session_id = src->session_id;
+		dst->frame_id = src->frame_id;
+		dst->predicted_display_time_ns = src->predicted_display_time_ns;
+		dst->predicted_display_period_ns = src->predicted_display_period_ns;
+		dst->display_time_ns = src->display_time_ns;
+		dst->when_predicted_ns = src->when_predicted_ns;
+		dst->when_wait_woke_ns = src->when_wait_woke_ns;
+		dst->when_begin_ns = src->when_begin_ns;
+		dst->when_delivered_ns = src->when_delivered_ns;
+		dst->when_gpu_done_ns = src->when_gpu_done_ns;
+		dst->discarded = src->discarded;
+	} break;
+	case U_TELEMETRY_TYPE_DEVICE_POSES: {
+		const struct u_telemetry_device_poses *src = &entry->device_poses;
+		mnd_telemetry_device_poses_t *dst = &out_event->data.device_poses;
+		snprintf(dst->device_name, sizeof(dst->device_name), "%.*s", (int)sizeof(src->device_name),
+		         src->device_name);
+		dst->period_ns = src->period_ns;
+		dst->sample_count = src->sample_count;
+		dst->query_count = src->query_count;
+		dst->predicted_count = src->predicted_count;
+		dst->horizon_mean_ns = src->horizon_mean_ns;
+		dst->sample_age_mean_ns = src->sample_age_mean_ns;
+		dst->sample_age_max_ns = src->sample_age_max_ns;
+	} break;
+	default: break; // Newer service, type is passed through.
+	}
+}
+
 
 /*
  *
@@ -116,7 +185,7 @@ mnd_root_create(mnd_root_t **out_root)
 	mnd_root_t *r = U_TYPED_CALLOC(mnd_root_t);
 
 	struct xrt_instance_info info = {0};
-	snprintf(info.application_name, sizeof(info.application_name), "%s", "libmonado");
+	snprintf(info.application_name, sizeof(info.application_name), "%s", IPC_LIBMONADO_APPLICATION_NAME);
 
 	xrt_result_t xret = ipc_client_connection_init(&r->ipc_c, U_LOGGING_INFO, &info);
 	if (xret != XRT_SUCCESS) {
@@ -334,3 +403,120 @@ mnd_root_get_device_from_role(mnd_root_t *root, const char *role_name, int32_t *
 	PE("Invalid role name (%s)", role_name);
 	return MND_ERROR_INVALID_VALUE;
 }
+
+
+/*
+ *
+ * Telemetry API.
+ *
+ */
+
+mnd_result_t
+mnd_root_telemetry_subscribe(mnd_root_t *root, mnd_telemetry_t **out_telemetry)
+{
+	CHECK_NOT_NULL(root);
+	CHECK_NOT_NULL(out_telemetry);
+
+	xrt_shmem_handle_t handle = XRT_SHMEM_HANDLE_INVALID;
+	xrt_result_t xret = ipc_call_system_get_telemetry_shm(&root->ipc_c, &handle, 1);
+	if (xret != XRT_SUCCESS) {
+		PE("Failed to get telemetry shared memory.\n");
+		return MND_ERROR_OPERATION_FAILED;
+	}
+
+	const size_t size = sizeof(struct u_telemetry_ring);
+	const void *map = NULL;
+	xret = ipc_shmem_map_read_only(handle, size, &map);
+
+	// The mapping keeps the memory alive, not needed anymore.
+	ipc_shmem_destroy(&handle, NULL, 0);
+
+	if (xret != XRT_SUCCESS) {
+		PE("Failed to map telemetry shared memory.\n");
+		return MND_ERROR_OPERATION_FAILED;
+	}
+
+	const struct u_telemetry_ring *ring = (const struct u_telemetry_ring *)map;
+	if (!u_telemetry_ring_is_valid(ring)) {
+		PE("Telemetry layout of the service doesn't match (version %u, expected %u).\n", ring->version,
+		   U_TELEMETRY_VERSION);
+		ipc_shmem_unmap((void **)&map, size);
+		return MND_ERROR_INVALID_VERSION;
+	}
+
+	mnd_telemetry_t *t = U_TYPED_CALLOC(mnd_telemetry_t);
+	t->ring = ring;
+	t->read_index = u_telemetry_ring_get_write_index(ring);
+
+	*out_telemetry = t;
+
+	return MND_SUCCESS;
+}
+
+mnd_result_t
+mnd_telemetry_read(mnd_telemetry_t *telemetry,
+                   mnd_telemetry_event_t *out_events,
+                   uint32_t capacity,
+                   uint32_t *out_count,
+                   uint64_t *out_dropped)
+{
+	CHECK_NOT_NULL(telemetry);
+	CHECK_NOT_NULL(out_events);
+	CHECK_NOT_NULL(out_count);
+
+	uint64_t dropped = 0;
+	uint32_t count = 0;
+
+	while (count < capacity) {
+		uint32_t max = capacity - count;
+		if (max > ARRAY_SIZE(telemetry->scratch)) {
+			max = ARRAY_SIZE(telemetry->scratch);
+		}
+
+		uint64_t read_dropped = 0;
+
+		uint32_t read = u_telemetry_ring_read( //
+		    telemetry->ring,                   //
+		    &telemetry->read_index,            //
+		    telemetry->scratch,                //
+		    max,                               //
+		    &read_dropped);                    //
+
+		for (uint32_t i = 0; i < read; i++) {
+			convert_telemetry_entry(&telemetry->scratch[i], &out_events[count++]);
+		}
+
+		dropped += read_dropped;
+
+		// Caught up with the service.
+		if (read < max) {
+			break;
+		}
+	}
+
+	*out_count = count;
+
+	if (out_dropped != NULL) {
+		*out_dropped = dropped;
+	}
+
+	return MND_SUCCESS;
+}
+
+void
+mnd_telemetry_destroy(mnd_telemetry_t **telemetry_ptr)
+{
+	if (telemetry_ptr == NULL) {
+		return;
+	}
+
+	mnd_telemetry_t *t = *telemetry_ptr;
+	if (t == NULL) {
+		return;
+	}
+
+	ipc_shmem_unmap((void **)&t->ring, sizeof(struct u_telemetry_ring));
+	free(t);
+
+	*telemetry_ptr = NULL;
+}
@@ -24,7 +24,7 @@ extern "C" {
 //! Major version of the API.
 #define MND_API_VERSION_MAJOR 1
 //! Minor version of the API.
-#define MND_API_VERSION_MINOR 0
+#define MND_API_VERSION_MINOR 1
 //! Patch version of the API.
 #define MND_API_VERSION_PATCH 0
 
@@ -59,6 +59,93 @@ typedef enum mnd_client_flags
  */
 typedef struct mnd_root mnd_root_t;
 
+/*!
+ * Opaque type for a subscription to the telemetry of the service.
+ */
+typedef struct mnd_telemetry mnd_telemetry_t;
+
+/*!
+ * Kinds of telemetry events, selects the member of
+ * @ref mnd_telemetry_event::data to use.
+ */
+typedef enum mnd_telemetry_type
+{
+	MND_TELEMETRY_COMPOSITOR_FRAME = 1,
+	MND_TELEMETRY_CLIENT_FRAME = 2,
+	MND_TELEMETRY_DEVICE_POSES = 3,
+} mnd_telemetry_type_t;
+
+/*!
+ * Timing of one compositor frame, fields not known to the compositor's pacing
+ * are zero. All times are in the service's monotonic clock.
+ */
+typedef struct mnd_telemetry_compositor_frame
+{
+	int64_t frame_id;
+	uint64_t predicted_display_time_ns;
+	uint64_t predicted_display_period_ns;
+	uint64_t desired_present_time_ns;
+	uint64_t actual_present_time_ns;
+	uint64_t when_predict_ns;
+	uint64_t when_woke_ns;
+	uint64_t when_began_ns;
+	uint64_t when_submitted_ns;
+	uint64_t present_margin_ns;
+	uint64_t present_slop_ns;
+} mnd_telemetry_compositor_frame_t;
+
+/*!
+ * Timing of one frame of a client session, sessions are numbered in the order
+ * they were created. All times are in the service's monotonic clock.
+ */
+typedef struct mnd_telemetry_client_frame
+{
+	int64_t session_id;
+	int64_t frame_id;
+	uint64_t predicted_display_time_ns;
+	uint64_t predicted_display_period_ns;
+	uint64_t display_time_ns;
+	uint64_t when_predicted_ns;
+	uint64_t when_wait_woke_ns;
+	uint64_t when_begin_ns;
+	uint64_t when_delivered_ns;
+	uint64_t when_gpu_done_ns;
+	uint32_t discarded;
+} mnd_telemetry_client_frame_t;
+
+/*!
+ * Pose samples a device got and poses it was asked for over a period of about
+ * a second, divide the counts by the period to get the rates.
+ */
+typedef struct mnd_telemetry_device_poses
+{
+	char device_name[64];
+	uint64_t period_ns;
+	uint64_t sample_count;
+	uint64_t query_count;
+	uint64_t predicted_count;
+	int64_t horizon_mean_ns;
+	int64_t sample_age_mean_ns;
+	int64_t sample_age_max_ns;
+} mnd_telemetry_device_poses_t;
+
+/*!
+ * A single telemetry event.
+ */
+typedef struct mnd_telemetry_event
+{
+	mnd_telemetry_type_t type;
+
+	//! When the service produced the event, in its monotonic clock.
+	uint64_t when_ns;
+
+	union {
+		mnd_telemetry_compositor_frame_t compositor_frame;
+		mnd_telemetry_client_frame_t client_frame;
+		mnd_telemetry_device_poses_t device_poses;
+	} data;
+} mnd_telemetry_event_t;
+
 
 /*
  *
@@ -241,6 +328,50 @@ mnd_root_get_device_info(mnd_root_t *root, uint32_t device_index, uint32_t *out_
 mnd_result_t
 mnd_root_get_device_from_role(mnd_root_t *root, const char *role_name, int32_t *out_device_id);
 
+/*!
+ * Subscribe to the telemetry of the service, this maps a read-only ring of
+ * events that the service writes to, so reading it makes no IPC calls. Only
+ * events written after this call are returned.
+ *
+ * The subscription may outlive the root.
+ *
+ * @param root               The libmonado state.
+ * @param[out] out_telemetry Pointer to populate with the subscription.
+ *
+ * @return MND_SUCCESS on success, MND_ERROR_INVALID_VERSION if the service's
+ * telemetry has a different layout.
+ */
+mnd_result_t
+mnd_root_telemetry_subscribe(mnd_root_t *root, mnd_telemetry_t **out_telemetry);
+
+/*!
+ * Copy out the events written since the last call, never waits for the
+ * service. Read often enough, at least a few times a second, or the service
+ * will overwrite events before they are read.
+ *
+ * @param telemetry        The subscription.
+ * @param[out] out_events  Array to copy the events to.
+ * @param capacity         Size of @p out_events.
+ * @param[out] out_count   Number of events copied.
+ * @param[out] out_dropped Number of events overwritten before they could be read, optional.
+ *
+ * @return MND_SUCCESS on success
+ */
+mnd_result_t
+mnd_telemetry_read(mnd_telemetry_t *telemetry,
+                   mnd_telemetry_event_t *out_events,
+                   uint32_t capacity,
+                   uint32_t *out_count,
+                   uint64_t *out_dropped);
+
+/*!
+ * Unmap the telemetry and free the subscription, zeroing the pointer.
+ *
+ * @param telemetry_ptr Pointer to the subscription. Null-checked, will be set to null.
+ */
+void
+mnd_telemetry_destroy(mnd_telemetry_t **telemetry_ptr);
+
 
 #ifdef __cplusplus
 }
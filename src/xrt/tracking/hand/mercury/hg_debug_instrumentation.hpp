@@ -43,6 +43,7 @@ struct hg_tuneable_values
 	size_t num_frames_before_display = 10;
 	bool enable_pose_predicted_input = true;
 	bool enable_framerate_based_smoothing = false;
+	bool coarse_grid_distort = true;
 
 	// Stuff that's only really useful for dataset playback:
 	bool detection_model_in_both_views = false;
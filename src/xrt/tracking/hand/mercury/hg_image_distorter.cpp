@@ -7,6 +7,7 @@
  * @ingroup tracking
  */
 
+#include <algorithm>
 #include <cmath>
 #include <opencv2/core.hpp>
 #include <stdio.h>
@@ -37,6 +38,12 @@ namespace xrt::tracking::hand::mercury {
 
 constexpr int wsize = 128;
 
+// Spacing, in output pixels, between the points where the coarse-grid path evaluates the real projection.
+constexpr int coarse_step = 8;
+constexpr int coarse_size = (wsize / coarse_step) + 1;
+
+static_assert(wsize % coarse_step == 0, "The coarse grid has to land exactly on the output's edges");
+
 template <typename T> using OutputSizedArray = Eigen::Array<T, wsize, wsize, Eigen::RowMajor>;
 using OutputSizedFloatArray = OutputSizedArray<float>;
 
@@ -299,6 +306,134 @@ StereographicDistort(projection_state &mi)
 	naive_remap(mi.image_x, mi.image_y, mi.input, mi.distorted_image_eigen);
 }
 
+/*!
+ * Evaluates the real stereographic-to-camera projection on a @ref coarse_size x @ref coarse_size grid and linearly
+ * interpolates it to every output pixel. The projection is very smooth over one ROI, so this is off by a small
+ * fraction of a pixel while doing ~1/50th of the transcendental math.
+ */
+static void
+coarse_grid_maps(projection_state &mi, OutputSizedFloatArray &out_x, OutputSizedFloatArray &out_y)
+{
+	XRT_TRACE_MARKER();
+
+	Eigen::Array<float, coarse_size, coarse_size, Eigen::RowMajor> grid_x;
+	Eigen::Array<float, coarse_size, coarse_size, Eigen::RowMajor> grid_y;
+
+	const float r = mi.instructions.stereographic_radius;
+	const float x_from = mi.instructions.flip ? r : -r;
+
+	for (int gy = 0; gy < coarse_size; gy++) {
+		float sg_y = map_ranges<float>((float)(gy * coarse_step), 0.0f, (float)wsize, r, -r);
+
+		for (int gx = 0; gx < coarse_size; gx++) {
+			float sg_x = map_ranges<float>((float)(gx * coarse_step), 0.0f, (float)wsize, x_from, -x_from);
+
+			Eigen::Vector3f dir = mi.instructions.rot_quat * stereographic_unprojection(sg_x, sg_y);
+
+			// Same as in StereographicDistort and slow.
+			dir.y() *= -1;
+			dir.z() *= -1;
+
+			// Like the full-resolution path, we don't care whether the point is in front of the camera; those
+			// land far outside of the image and get cleared to black by the sampler.
+			t_camera_models_project(&mi.dist, dir.x(), dir.y(), dir.z(), &grid_x(gy, gx), &grid_y(gy, gx));
+		}
+	}
+
+	Eigen::Array<float, 1, coarse_step> frac;
+	for (int i = 0; i < coarse_step; i++) {
+		frac(i) = (float)i / (float)coarse_step;
+	}
+
+	for (int y = 0; y < wsize; y++) {
+		int gy = y / coarse_step;
+		float ty = (float)(y % coarse_step) / (float)coarse_step;
+
+		Eigen::Array<float, 1, coarse_size> row_x = grid_x.row(gy) + (grid_x.row(gy + 1) - grid_x.row(gy)) * ty;
+		Eigen::Array<float, 1, coarse_size> row_y = grid_y.row(gy) + (grid_y.row(gy + 1) - grid_y.row(gy)) * ty;
+
+		for (int gx = 0; gx < coarse_size - 1; gx++) {
+			out_x.row(y).segment<coarse_step>(gx * coarse_step) = row_x(gx) + (row_x(gx + 1) - row_x(gx)) * frac;
+			out_y.row(y).segment<coarse_step>(gx * coarse_step) = row_y(gx) + (row_y(gx + 1) - row_y(gx)) * frac;
+		}
+	}
+}
+
+/*!
+ * Bilinear sampling of @p input at the given sub-pixel coordinates. Taps that fall outside of the image count as
+ * black, which is what @ref naive_remap does for whole pixels. There are no branches in the inner loop, so everything
+ * but the four gathers gets vectorised.
+ */
+static void
+bilinear_remap(const OutputSizedFloatArray &map_x,
+               const OutputSizedFloatArray &map_y,
+               cv::Mat &input,
+               Eigen::Map<OutputSizedArray<uint8_t>> &output)
+{
+	XRT_TRACE_MARKER();
+
+	const int max_x = input.cols - 1;
+	const int max_y = input.rows - 1;
+	const size_t stride = input.step;
+	const uint8_t *data = input.data;
+
+	for (int y = 0; y < wsize; y++) {
+		for (int x = 0; x < wsize; x++) {
+			// Clamp before converting to int; this also gets rid of NaNs.
+			float fx = fminf(fmaxf(map_x(y, x), -2.0f), (float)input.cols + 1.0f);
+			float fy = fminf(fmaxf(map_y(y, x), -2.0f), (float)input.rows + 1.0f);
+
+			float floor_x = floorf(fx);
+			float floor_y = floorf(fy);
+			float wx = fx - floor_x;
+			float wy = fy - floor_y;
+
+			int x0 = (int)floor_x;
+			int y0 = (int)floor_y;
+			int x1 = x0 + 1;
+			int y1 = y0 + 1;
+
+			float in_x0 = (x0 >= 0 && x0 <= max_x) ? 1.0f : 0.0f;
+			float in_x1 = (x1 >= 0 && x1 <= max_x) ? 1.0f : 0.0f;
+			float in_y0 = (y0 >= 0 && y0 <= max_y) ? 1.0f : 0.0f;
+			float in_y1 = (y1 >= 0 && y1 <= max_y) ? 1.0f : 0.0f;
+
+			x0 = std::clamp(x0, 0, max_x);
+			x1 = std::clamp(x1, 0, max_x);
+			y0 = std::clamp(y0, 0, max_y);
+			y1 = std::clamp(y1, 0, max_y);
+
+			const uint8_t *row0 = data + (size_t)y0 * stride;
+			const uint8_t *row1 = data + (size_t)y1 * stride;
+
+			float top = row0[x0] * (1.0f - wx) * in_x0 + row0[x1] * wx * in_x1;
+			float bottom = row1[x0] * (1.0f - wx) * in_x0 + row1[x1] * wx * in_x1;
+
+			float value = top * (1.0f - wy) * in_y0 + bottom * wy * in_y1;
+
+			output(y, x) = (uint8_t)(value + 0.5f);
+		}
+	}
+}
+
+static void
+StereographicDistortCoarseBilinear(projection_state &mi)
+{
+	XRT_TRACE_MARKER();
+
+	OutputSizedFloatArray &image_x_f = mi.stack.get();
+	OutputSizedFloatArray &image_y_f = mi.stack.get();
+
+	coarse_grid_maps(mi, image_x_f, image_y_f);
+
+	// The full-resolution path truncates, effectively sampling half a pixel up and left of where it should.
+	// Keep that so that switching between the two doesn't shift the image under the keypoint model.
+	image_x_f -= 0.5f;
+	image_y_f -= 0.5f;
+
+	bilinear_remap(image_x_f, image_y_f, mi.input, mi.distorted_image_eigen);
+}
+
 
 
 bool
@@ -613,7 +748,11 @@ stereographic_project_image(const t_camera_model_params &dist,
 
 	mi.dist = dist;
 
-	StereographicDistort(mi);
+	if (instructions.coarse_grid_bilinear) {
+		StereographicDistortCoarseBilinear(mi);
+	} else {
+		StereographicDistort(mi);
+	}
 
 	if (debug_image) {
 		draw_boundary(mi, boundary_color, *debug_image);
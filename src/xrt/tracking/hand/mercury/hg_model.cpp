@@ -12,6 +12,7 @@
 #include "hg_sync.hpp"
 #include "hg_image_math.inl"
 #include "hg_numerics_checker.hpp"
+#include "os/os_time.h"
 
 
 #include <filesystem>
@@ -750,9 +751,13 @@ run_keypoint_estimation(void *ptr)
 		}
 	}
 
+	instr.coarse_grid_bilinear = hgt->tuneable_values.coarse_grid_distort;
+
+	uint64_t distort_start_ns = os_monotonic_get_ns();
 	stereographic_project_image(dist, instr, hgt->views[view_idx].run_model_on_this,
 	                            &hgt->views[view_idx].debug_out_to_this, info.hand_idx ? RED : YELLOW,
 	                            data_128x128_uint8);
+	info.view->distort_time_us[hand_idx] = (float)(os_monotonic_get_ns() - distort_start_ns) / 1000.0f;
 
 
 	xrt::auxiliary::math::map_quat(this_output.look_dir) = instr.rot_quat;
@@ -27,6 +27,8 @@ namespace xrt::tracking::hand::mercury {
 DEBUG_GET_ONCE_LOG_OPTION(mercury_log, "MERCURY_LOG", U_LOGGING_WARN)
 DEBUG_GET_ONCE_BOOL_OPTION(mercury_optimize_hand_size, "MERCURY_optimize_hand_size", true)
 DEBUG_GET_ONCE_FLOAT_OPTION(mercury_min_detection_confidence, "MERCURY_MIN_DETECTION_CONFIDENCE", 0.3)
+DEBUG_GET_ONCE_BOOL_OPTION(mercury_lm_padded_jets, "MERCURY_LM_PADDED_JETS", true)
+DEBUG_GET_ONCE_OPTION(mercury_lm_record, "MERCURY_LM_RECORD", NULL)
 
 // Flags to tell state tracker that these are indeed valid joints
 static const enum xrt_space_relation_flags valid_flags_ht = (enum xrt_space_relation_flags)(
@@ -673,6 +675,11 @@ HandTracking::~HandTracking()
 	lm::optimizer_destroy(&this->kinematic_hands[0]);
 	lm::optimizer_destroy(&this->kinematic_hands[1]);
 
+	if (this->lm_record_file != nullptr) {
+		fclose(this->lm_record_file);
+		this->lm_record_file = nullptr;
+	}
+
 	u_var_remove_root((void *)&this->base);
 	u_frame_times_widget_teardown(&this->ft_widget);
 }
@@ -925,6 +932,22 @@ HandTracking::cCallbackProcess(struct t_hand_tracking_sync *ht_sync,
 
 		//!@todo optimize: We can have one of these on each thread
 		float reprojection_error;
+
+		if (hgt->lm_record_file != nullptr) {
+			// Has to happen before optimizer_run, it mutates the observation.
+			lm::replay_frame frame = {};
+			frame.observation = hgt->keypoint_outputs[hand_idx];
+			frame.left_in_right = hgt->left_in_right;
+			frame.is_right = hand_idx == 1;
+			frame.hand_was_untracked_last_frame = !hgt->last_frame_hand_detected[hand_idx];
+			frame.optimize_hand_size = optimize_hand_size;
+			frame.smoothing_factor = smoothing_factor;
+			frame.target_hand_size = hgt->target_hand_size;
+			frame.hand_size_err_mul = hgt->refinement.hand_size_refinement_schedule_y;
+			frame.amt_use_depth = hgt->tuneable_values.amt_use_depth.val;
+			lm::replay_write_frame(hgt->lm_record_file, frame);
+		}
+
 		lm::optimizer_run(hand,                                     //
 		                  hgt->keypoint_outputs[hand_idx],          //
 		                  !hgt->last_frame_hand_detected[hand_idx], //
@@ -1118,6 +1141,23 @@ t_hand_tracking_sync_mercury_create(struct t_stereo_camera_calibration *calib,
 	lm::optimizer_create(hgt->left_in_right, false, hgt->log_level, &hgt->kinematic_hands[0]);
 	lm::optimizer_create(hgt->left_in_right, true, hgt->log_level, &hgt->kinematic_hands[1]);
 
+	lm::JacobianMode jacobian_mode = debug_get_bool_option_mercury_lm_padded_jets() ? lm::JacobianMode::PaddedJet
+	                                                                               : lm::JacobianMode::Autodiff;
+	lm::optimizer_set_jacobian_mode(hgt->kinematic_hands[0], jacobian_mode);
+	lm::optimizer_set_jacobian_mode(hgt->kinematic_hands[1], jacobian_mode);
+
+	const char *lm_record_path = debug_get_option_mercury_lm_record();
+	if (lm_record_path != NULL) {
+		hgt->lm_record_file = fopen(lm_record_path, "wb");
+		if (hgt->lm_record_file == NULL) {
+			HG_ERROR(hgt, "Could not open '%s' for recording optimizer inputs", lm_record_path);
+		} else if (!lm::replay_write_header(hgt->lm_record_file)) {
+			HG_ERROR(hgt, "Could not write header to '%s', not recording optimizer inputs", lm_record_path);
+			fclose(hgt->lm_record_file);
+			hgt->lm_record_file = nullptr;
+		}
+	}
+
 	u_frame_times_widget_init(&hgt->ft_widget, 10.0f, 10.0f);
 
 	u_var_add_root(hgt, "Camera-based Hand Tracker", true);
@@ -1233,6 +1273,12 @@ t_hand_tracking_sync_mercury_create(struct t_stereo_camera_calibration *calib,
 	u_var_add_bool(hgt, &hgt->tuneable_values.enable_framerate_based_smoothing,
 	               "Enable framerate-based smoothing (Don't use; surprisingly seems to make things worse)");
 	u_var_add_bool(hgt, &hgt->tuneable_values.detection_model_in_both_views, "Run detection model in both views ");
+	u_var_add_bool(hgt, &hgt->tuneable_values.coarse_grid_distort,
+	               "Coarse-grid bilinear ROI distortion (off: full-resolution nearest-neighbour)");
+	u_var_add_ro_f32(hgt, &hgt->views[0].distort_time_us[0], "ROI distortion time (us), left view, left hand");
+	u_var_add_ro_f32(hgt, &hgt->views[0].distort_time_us[1], "ROI distortion time (us), left view, right hand");
+	u_var_add_ro_f32(hgt, &hgt->views[1].distort_time_us[0], "ROI distortion time (us), right view, left hand");
+	u_var_add_ro_f32(hgt, &hgt->views[1].distort_time_us[1], "ROI distortion time (us), right view, right hand");
 
 
 
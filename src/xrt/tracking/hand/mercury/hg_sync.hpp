@@ -46,6 +46,7 @@
 
 #include "kine_common.hpp"
 #include "kine_lm/lm_interface.hpp"
+#include "kine_lm/lm_replay.hpp"
 
 
 namespace xrt::tracking::hand::mercury {
@@ -136,6 +137,8 @@ struct projection_instructions
 	Eigen::Quaternionf rot_quat = Eigen::Quaternionf::Identity();
 	float stereographic_radius = 0;
 	bool flip = false;
+	//! Interpolate the projection from a coarse grid and sample bilinearly instead of nearest-neighbour.
+	bool coarse_grid_bilinear = false;
 	const t_camera_model_params &dist;
 
 	projection_instructions(const t_camera_model_params &dist) : dist(dist) {}
@@ -216,6 +219,9 @@ struct ht_view
 	struct hand_region_of_interest regions_of_interest_this_frame[2]; // left, right
 
 	struct keypoint_estimation_run_info run_info[2];
+
+	//! How long stereographic_project_image took for each hand's ROI last frame, in microseconds.
+	float distort_time_us[2] = {};
 };
 
 
@@ -286,6 +292,9 @@ public:
 
 	lm::KinematicHandLM *kinematic_hands[2];
 
+	//! If set, every kinematic optimizer input is appended here so it can be replayed with mercury_lm_benchmark.
+	FILE *lm_record_file = nullptr;
+
 	// These are produced by the keypoint estimator and consumed by the nonlinear optimizer
 	// left hand, right hand THEN left view, right view
 	struct one_frame_input keypoint_outputs[2];
@@ -0,0 +1,179 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Replays recorded kinematic optimizer inputs and reports how fast and how well the optimizer converges.
+ *
+ * Record inputs by running Mercury with `MERCURY_LM_RECORD=<file>`, then run `mercury_lm_benchmark <file>`.
+ *
+ * @author agent <agent@local>
+ * @ingroup tracking
+ */
+
+#include "os/os_time.h"
+#include "util/u_logging.h"
+
+#include "lm_interface.hpp"
+#include "lm_replay.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace xrt::tracking::hand::mercury;
+
+namespace {
+
+struct run_result
+{
+	std::vector<uint64_t> solve_ns;
+	std::vector<int> iterations;
+	std::vector<float> final_cost;
+	std::vector<xrt_hand_joint_set> hands;
+	uint64_t total_ns = 0;
+};
+
+void
+run_all(const std::vector<lm::replay_frame> &frames, lm::JacobianMode mode, run_result &out)
+{
+	lm::KinematicHandLM *hands[2] = {};
+	bool created[2] = {};
+
+	for (const lm::replay_frame &frame : frames) {
+		int idx = frame.is_right ? 1 : 0;
+		if (!created[idx]) {
+			lm::optimizer_create(frame.left_in_right, frame.is_right, U_LOGGING_WARN, &hands[idx]);
+			lm::optimizer_set_jacobian_mode(hands[idx], mode);
+			created[idx] = true;
+		}
+
+		// optimizer_run mutates the observation.
+		one_frame_input observation = frame.observation;
+		xrt_hand_joint_set hand = {};
+		float hand_size = 0;
+		float reprojection_error = 0;
+
+		uint64_t start = os_monotonic_get_ns();
+		lm::optimizer_run(hands[idx], observation, frame.hand_was_untracked_last_frame, frame.smoothing_factor,
+		                  frame.optimize_hand_size, frame.target_hand_size, frame.hand_size_err_mul,
+		                  frame.amt_use_depth, hand, hand_size, reprojection_error);
+		out.total_ns += os_monotonic_get_ns() - start;
+
+		lm::optimizer_stats stats = {};
+		lm::optimizer_get_last_stats(hands[idx], stats);
+		out.solve_ns.push_back(stats.solve_ns);
+		out.iterations.push_back(stats.iterations);
+		out.final_cost.push_back(stats.final_cost);
+		out.hands.push_back(hand);
+	}
+
+	for (int i = 0; i < 2; i++) {
+		if (created[i]) {
+			lm::optimizer_destroy(&hands[i]);
+		}
+	}
+}
+
+uint64_t
+percentile(std::vector<uint64_t> values, double p)
+{
+	if (values.empty()) {
+		return 0;
+	}
+	std::sort(values.begin(), values.end());
+	size_t idx = (size_t)(p * (double)(values.size() - 1));
+	return values[idx];
+}
+
+void
+print_result(const char *name, const run_result &r)
+{
+	size_t n = r.solve_ns.size();
+	double avg_iterations = 0;
+	double avg_cost = 0;
+	for (size_t i = 0; i < n; i++) {
+		avg_iterations += r.iterations[i];
+		avg_cost += r.final_cost[i];
+	}
+	avg_iterations /= (double)n;
+	avg_cost /= (double)n;
+
+	U_LOG_RAW("%-10s hands: %zu, avg iterations: %.2f, avg final cost: %g", name, n, avg_iterations, avg_cost);
+	U_LOG_RAW("%-10s us/hand (whole optimizer_run): %.1f", name, (double)r.total_ns / (double)n / 1000.0);
+	U_LOG_RAW("%-10s us/hand solve p50: %.1f p90: %.1f p99: %.1f", name, //
+	          (double)percentile(r.solve_ns, 0.50) / 1000.0,              //
+	          (double)percentile(r.solve_ns, 0.90) / 1000.0,              //
+	          (double)percentile(r.solve_ns, 0.99) / 1000.0);
+}
+
+float
+max_joint_difference(const xrt_hand_joint_set &a, const xrt_hand_joint_set &b)
+{
+	float max_diff = 0;
+	for (int i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+		const xrt_vec3 &pa = a.values.hand_joint_set_default[i].relation.pose.position;
+		const xrt_vec3 &pb = b.values.hand_joint_set_default[i].relation.pose.position;
+		float d = sqrtf((pa.x - pb.x) * (pa.x - pb.x) + (pa.y - pb.y) * (pa.y - pb.y) +
+		                (pa.z - pb.z) * (pa.z - pb.z));
+		max_diff = std::max(max_diff, d);
+	}
+	return max_diff;
+}
+
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		U_LOG_RAW("Usage: %s <recording> [repeat count]", argv[0]);
+		return 1;
+	}
+
+	int repeat = argc > 2 ? atoi(argv[2]) : 1;
+
+	FILE *file = fopen(argv[1], "rb");
+	if (file == NULL) {
+		U_LOG_E("Could not open '%s'", argv[1]);
+		return 1;
+	}
+	if (!lm::replay_read_header(file)) {
+		U_LOG_E("'%s' is not a recording from this build of Mercury", argv[1]);
+		fclose(file);
+		return 1;
+	}
+
+	std::vector<lm::replay_frame> frames;
+	lm::replay_frame frame = {};
+	while (lm::replay_read_frame(file, frame)) {
+		frames.push_back(frame);
+	}
+	fclose(file);
+
+	if (frames.empty()) {
+		U_LOG_E("No frames in '%s'", argv[1]);
+		return 1;
+	}
+
+	std::vector<lm::replay_frame> all_frames;
+	for (int i = 0; i < std::max(repeat, 1); i++) {
+		all_frames.insert(all_frames.end(), frames.begin(), frames.end());
+	}
+
+	run_result autodiff = {};
+	run_result padded = {};
+	run_all(all_frames, lm::JacobianMode::Autodiff, autodiff);
+	run_all(all_frames, lm::JacobianMode::PaddedJet, padded);
+
+	print_result("autodiff", autodiff);
+	print_result("padded", padded);
+
+	float worst = 0;
+	for (size_t i = 0; i < all_frames.size(); i++) {
+		worst = std::max(worst, max_joint_difference(autodiff.hands[i], padded.hands[i]));
+	}
+	U_LOG_RAW("Largest joint position difference between modes: %g m", worst);
+
+	return 0;
+}
@@ -13,6 +13,7 @@
 #include "math/m_eigen_interop.hpp"
 #include "util/u_logging.h"
 #include "../kine_common.hpp"
+#include "lm_interface.hpp"
 
 namespace xrt::tracking::hand::mercury::lm {
 
@@ -541,6 +542,9 @@ struct KinematicHandLM
 
 	u_logging_level log_level = U_LOGGING_INFO;
 
+	JacobianMode jacobian_mode = JacobianMode::PaddedJet;
+	optimizer_stats last_stats = {};
+
 	// Squashed final pose from last frame. We start from here.
 	// At some point this might turn into a pose-prediction instead, we'll see :)
 	Quat<HandScalar> this_frame_pre_rotation = {};
@@ -19,6 +19,26 @@ namespace xrt::tracking::hand::mercury::lm {
 // Opaque struct.
 struct KinematicHandLM;
 
+//! How the optimizer computes the Jacobian of the cost function.
+enum class JacobianMode
+{
+	//! Plain `ceres::TinySolverAutoDiffFunction`, one Jet lane per parameter.
+	Autodiff,
+	//! Same as autodiff, but with the Jet padded to a whole number of SIMD registers. Same results, faster.
+	PaddedJet,
+};
+
+//! Numbers about the last call to @ref optimizer_run, mostly for benchmarking.
+struct optimizer_stats
+{
+	int iterations;
+	//! A `ceres::TinySolver::Status`.
+	int status;
+	float initial_cost;
+	float final_cost;
+	uint64_t solve_ns;
+};
+
 // Constructor
 void
 optimizer_create(xrt_pose left_in_right,
@@ -57,6 +77,12 @@ optimizer_run(KinematicHandLM *hand,
               float &out_hand_size,
               float &out_reprojection_error);
 
+void
+optimizer_set_jacobian_mode(KinematicHandLM *hand, JacobianMode mode);
+
+void
+optimizer_get_last_stats(const KinematicHandLM *hand, optimizer_stats &out_stats);
+
 // Destructor
 void
 optimizer_destroy(KinematicHandLM **hand);
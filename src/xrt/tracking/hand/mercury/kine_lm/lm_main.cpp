@@ -17,6 +17,7 @@
 #include "tinyceres/tiny_solver.hpp"
 #include "tinyceres/tiny_solver_autodiff_function.hpp"
 #include "lm_rotations.inl"
+#include "lm_padded_autodiff.hpp"
 
 #include <iostream>
 #include <cmath>
@@ -840,7 +841,7 @@ eval_to_viz_hand(KinematicHandLM &state,
 	out_viz_hand.is_active = true;
 }
 
-template <bool optimize_hand_size>
+template <bool optimize_hand_size, typename DiffCostFunctor>
 inline float
 opt_run(KinematicHandLM &state, one_frame_input &observation, xrt_hand_joint_set &out_viz_hand)
 {
@@ -853,12 +854,9 @@ opt_run(KinematicHandLM &state, one_frame_input &observation, xrt_hand_joint_set
 
 	CostFunctor<optimize_hand_size> cf(state, residual_size);
 
-	using AutoDiffCostFunctor =
-	    ceres::TinySolverAutoDiffFunction<CostFunctor<optimize_hand_size>, Eigen::Dynamic, input_size, HandScalar>;
-
-	AutoDiffCostFunctor f(cf);
+	DiffCostFunctor f(cf);
 
-	ceres::TinySolver<AutoDiffCostFunctor> solver = {};
+	ceres::TinySolver<DiffCostFunctor> solver = {};
 	solver.options.max_num_iterations = 30;
 
 	//!@todo We don't yet know what "good" termination conditions are.
@@ -872,13 +870,19 @@ opt_run(KinematicHandLM &state, one_frame_input &observation, xrt_hand_joint_set
 
 	Eigen::Matrix<HandScalar, input_size, 1> inp = state.TinyOptimizerInput.head<input_size>();
 
-	XRT_MAYBE_UNUSED uint64_t start = os_monotonic_get_ns();
-	XRT_MAYBE_UNUSED auto summary = solver.Solve(f, &inp);
-	XRT_MAYBE_UNUSED uint64_t end = os_monotonic_get_ns();
+	uint64_t start = os_monotonic_get_ns();
+	auto summary = solver.Solve(f, &inp);
+	uint64_t end = os_monotonic_get_ns();
 
 	//!@todo Is there a zero-copy way of doing this?
 	state.TinyOptimizerInput.head<input_size>() = inp;
 
+	state.last_stats.iterations = summary.iterations;
+	state.last_stats.status = summary.status;
+	state.last_stats.initial_cost = summary.initial_cost;
+	state.last_stats.final_cost = summary.final_cost;
+	state.last_stats.solve_ns = end - start;
+
 	if (state.log_level <= U_LOGGING_DEBUG) {
 
 		uint64_t diff = end - start;
@@ -915,6 +919,25 @@ opt_run(KinematicHandLM &state, one_frame_input &observation, xrt_hand_joint_set
 	return 0;
 }
 
+template <bool optimize_hand_size>
+inline float
+opt_run(KinematicHandLM &state, one_frame_input &observation, xrt_hand_joint_set &out_viz_hand)
+{
+	constexpr int input_size = calc_input_size(optimize_hand_size);
+
+	using AutoDiffCostFunctor =
+	    ceres::TinySolverAutoDiffFunction<CostFunctor<optimize_hand_size>, Eigen::Dynamic, input_size, HandScalar>;
+	using PaddedAutoDiffCostFunctor =
+	    TinySolverPaddedAutoDiffFunction<CostFunctor<optimize_hand_size>, Eigen::Dynamic, input_size, HandScalar>;
+
+	switch (state.jacobian_mode) {
+	case JacobianMode::Autodiff:
+		return opt_run<optimize_hand_size, AutoDiffCostFunctor>(state, observation, out_viz_hand);
+	case JacobianMode::PaddedJet:
+	default: return opt_run<optimize_hand_size, PaddedAutoDiffCostFunctor>(state, observation, out_viz_hand);
+	}
+}
+
 void
 optimizer_finish(KinematicHandLM &state, xrt_hand_joint_set &out_viz_hand, float &out_reprojection_error)
 {
@@ -1118,6 +1141,18 @@ optimizer_create(xrt_pose left_in_right, bool is_right, u_logging_level log_leve
 	*out_kinematic_hand = hand;
 }
 
+void
+optimizer_set_jacobian_mode(KinematicHandLM *hand, JacobianMode mode)
+{
+	hand->jacobian_mode = mode;
+}
+
+void
+optimizer_get_last_stats(const KinematicHandLM *hand, optimizer_stats &out_stats)
+{
+	out_stats = hand->last_stats;
+}
+
 void
 optimizer_destroy(KinematicHandLM **hand)
 {
@@ -0,0 +1,120 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Autodiff adapter for TinySolver that pads the Jet derivative part to a SIMD-friendly size.
+ * @author agent <agent@local>
+ * @ingroup tracking
+ */
+#pragma once
+
+#include "tinyceres/jet.hpp"
+#include "tinyceres/tiny_solver_autodiff_function.hpp"
+
+#include <Eigen/Core>
+
+namespace xrt::tracking::hand::mercury::lm {
+
+/*!
+ * Number of floats in one SIMD register on the platform we are compiled for. Eigen only vectorises fixed-size
+ * vectors whose byte size is a multiple of the packet size, so the derivative part of a `ceres::Jet<float, 27>` is
+ * done entirely with scalar instructions.
+ */
+#if defined(EIGEN_VECTORIZE_AVX512)
+static constexpr int kJetLanes = 16;
+#elif defined(EIGEN_VECTORIZE_AVX)
+static constexpr int kJetLanes = 8;
+#elif defined(EIGEN_VECTORIZE_SSE) || defined(EIGEN_VECTORIZE_NEON)
+static constexpr int kJetLanes = 4;
+#else
+static constexpr int kJetLanes = 1;
+#endif
+
+//! Rounds the number of parameters up to a whole number of SIMD registers.
+constexpr int
+padded_jet_size(int num_parameters)
+{
+	return ((num_parameters + kJetLanes - 1) / kJetLanes) * kJetLanes;
+}
+
+/*!
+ * Drop-in replacement for `ceres::TinySolverAutoDiffFunction`.
+ *
+ * The cost functor is evaluated on `ceres::Jet<T, padded_jet_size(kNumParameters)>`; the extra derivative lanes are
+ * always zero and are simply not copied out to the Jacobian. Every Jet operation then runs on whole SIMD registers,
+ * which is a lot faster than the scalar tail loops Eigen generates for odd sizes. The values and derivatives are the
+ * same as the ones @ref ceres::TinySolverAutoDiffFunction computes.
+ */
+template <typename CostFunctor, int kNumResiduals, int kNumParameters, typename T = float>
+class TinySolverPaddedAutoDiffFunction
+{
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+	static constexpr int kJetSize = padded_jet_size(kNumParameters);
+
+	using Scalar = T;
+	enum
+	{
+		NUM_PARAMETERS = kNumParameters,
+		NUM_RESIDUALS = kNumResiduals,
+	};
+
+	explicit TinySolverPaddedAutoDiffFunction(const CostFunctor &cost_functor) : cost_functor_(cost_functor)
+	{
+		num_residuals_ = cost_functor.NumResiduals();
+		jet_residuals_.resize(num_residuals_);
+
+		// The seeds never change, only the scalar part does.
+		for (int i = 0; i < kNumParameters; ++i) {
+			jet_parameters_[i].v.setZero();
+			jet_parameters_[i].v[i] = T(1.0);
+		}
+	}
+
+	bool
+	operator()(const T *parameters, T *residuals, T *jacobian) const
+	{
+		if (jacobian == nullptr) {
+			return cost_functor_(parameters, residuals);
+		}
+
+		for (int i = 0; i < kNumParameters; ++i) {
+			jet_parameters_[i].a = parameters[i];
+		}
+
+		for (int i = 0; i < num_residuals_; ++i) {
+			jet_residuals_[i].a = kImpossibleValue;
+			jet_residuals_[i].v.setConstant(kImpossibleValue);
+		}
+
+		if (!cost_functor_(jet_parameters_, jet_residuals_.data())) {
+			return false;
+		}
+
+		Eigen::Map<Eigen::Matrix<T, kNumResiduals, kNumParameters>> jacobian_matrix(jacobian, num_residuals_,
+		                                                                             kNumParameters);
+		for (int r = 0; r < num_residuals_; ++r) {
+			residuals[r] = jet_residuals_[r].a;
+			jacobian_matrix.row(r) = jet_residuals_[r].v.template head<kNumParameters>();
+		}
+		return true;
+	}
+
+	int
+	NumResiduals() const
+	{
+		return num_residuals_;
+	}
+
+private:
+	using JetType = ceres::Jet<T, kJetSize>;
+
+	const CostFunctor &cost_functor_;
+	int num_residuals_ = 0;
+
+	mutable JetType jet_parameters_[kNumParameters];
+	mutable Eigen::Matrix<JetType, kNumResiduals, 1> jet_residuals_;
+};
+
+} // namespace xrt::tracking::hand::mercury::lm
@@ -0,0 +1,84 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Raw recording format for kinematic optimizer inputs, used to replay and benchmark the optimizer offline.
+ * @author agent <agent@local>
+ * @ingroup tracking
+ */
+#pragma once
+
+#include "xrt/xrt_defines.h"
+#include "../kine_common.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <type_traits>
+
+namespace xrt::tracking::hand::mercury::lm {
+
+/*!
+ * Everything @ref optimizer_run and @ref optimizer_create got for one hand in one frame.
+ *
+ * This is written out as-is, so recordings only work between builds for the same architecture with the same
+ * @ref one_frame_input layout; the header's `frame_size` catches the common mistakes.
+ */
+struct replay_frame
+{
+	one_frame_input observation;
+	xrt_pose left_in_right;
+	uint8_t is_right;
+	uint8_t hand_was_untracked_last_frame;
+	uint8_t optimize_hand_size;
+	float smoothing_factor;
+	float target_hand_size;
+	float hand_size_err_mul;
+	float amt_use_depth;
+};
+
+static_assert(std::is_trivially_copyable_v<replay_frame>, "replay_frame is written with fwrite");
+
+struct replay_header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t frame_size;
+};
+
+static constexpr char kReplayMagic[8] = {'M', 'E', 'R', 'C', 'L', 'M', 'I', 'N'};
+static constexpr uint32_t kReplayVersion = 1;
+
+static inline bool
+replay_write_header(FILE *file)
+{
+	replay_header header = {};
+	memcpy(header.magic, kReplayMagic, sizeof(kReplayMagic));
+	header.version = kReplayVersion;
+	header.frame_size = sizeof(replay_frame);
+	return fwrite(&header, sizeof(header), 1, file) == 1;
+}
+
+static inline bool
+replay_read_header(FILE *file)
+{
+	replay_header header = {};
+	if (fread(&header, sizeof(header), 1, file) != 1) {
+		return false;
+	}
+	return memcmp(header.magic, kReplayMagic, sizeof(kReplayMagic)) == 0 && header.version == kReplayVersion &&
+	       header.frame_size == sizeof(replay_frame);
+}
+
+static inline bool
+replay_write_frame(FILE *file, const replay_frame &frame)
+{
+	return fwrite(&frame, sizeof(frame), 1, file) == 1;
+}
+
+static inline bool
+replay_read_frame(FILE *file, replay_frame &out_frame)
+{
+	return fread(&out_frame, sizeof(out_frame), 1, file) == 1;
+}
+
+} // namespace xrt::tracking::hand::mercury::lm
@@ -16,6 +16,8 @@
 #include "util/u_misc.h"
 #include "util/u_debug.h"
 #include "util/u_logging.h"
+#include "util/u_time.h"
+#include "util/u_hand_tracking.h"
 #include "util/u_trace_marker.h"
 
 #include "tracking/t_hand_tracking.h"
@@ -45,6 +47,11 @@ struct ht_async_impl
 	{
 		struct xrt_hand_joint_set hands[2];
 		uint64_t timestamp;
+
+		//! Joints of the previous frame, used to estimate joint velocities.
+		struct u_hand_joints_soa prev_joints[2];
+		bool prev_active[2];
+		uint64_t prev_timestamp;
 	} working;
 
 	struct
@@ -123,6 +130,31 @@ ht_async_mainloop(void *ptr)
 		 * Post process.
 		 */
 
+		float dt = (float)time_ns_to_s((int64_t)(hta->working.timestamp - hta->working.prev_timestamp));
+
+		for (int i = 0; i < 2; i++) {
+			struct xrt_hand_joint_set *set = &hta->working.hands[i];
+			struct u_hand_joints_soa joints;
+
+			if (!set->is_active) {
+				hta->working.prev_active[i] = false;
+				continue;
+			}
+
+			u_hand_joints_soa_from_set(set, &joints);
+
+			// Velocities for all joints from the last two frames.
+			if (hta->working.prev_active[i] && dt > 0.0f) {
+				u_hand_joints_soa_estimate_velocities(&joints, &hta->working.prev_joints[i], dt);
+				u_hand_joints_soa_to_set(&joints, set);
+			}
+
+			hta->working.prev_joints[i] = joints;
+			hta->working.prev_active[i] = true;
+		}
+
+		hta->working.prev_timestamp = hta->working.timestamp;
+
 		os_mutex_lock(&hta->present.mutex);
 
 		hta->present.timestamp = hta->working.timestamp;
@@ -296,17 +328,18 @@ ht_async_get_hand(struct t_hand_tracking_async *ht_async,
 
 	*out_value = latest_hand;
 
-	// apply the pose change from the latest wrist to the predicted wrist
-	// to all the joints on the hand.
-
-	//! @todo We could slightly reduce the total number of transforms by putting some of this in ht_async_mainloop
-	for (int i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
-		struct xrt_relation_chain xrc = {0};
-		m_relation_chain_push_relation(&xrc, &latest_hand.values.hand_joint_set_default[i].relation);
-		m_relation_chain_push_inverted_relation(&xrc, &latest_wrist);
-		m_relation_chain_push_relation(&xrc, &predicted_wrist);
-		m_relation_chain_resolve(&xrc, &out_value->values.hand_joint_set_default[i].relation);
-	}
+	// The pose change from the latest wrist to the predicted wrist.
+	struct xrt_space_relation delta;
+	struct xrt_relation_chain xrc = {0};
+	m_relation_chain_push_inverted_relation(&xrc, &latest_wrist);
+	m_relation_chain_push_relation(&xrc, &predicted_wrist);
+	m_relation_chain_resolve(&xrc, &delta);
+
+	// Apply it to all the joints on the hand in one go.
+	struct u_hand_joints_soa joints;
+	u_hand_joints_soa_from_set(&latest_hand, &joints);
+	u_hand_joints_soa_transform(&joints, &delta);
+	u_hand_joints_soa_to_set(&joints, out_value);
 
 	*out_timestamp_ns = desired_timestamp_ns;
 }
@@ -0,0 +1,189 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Test auto exposure and gain histogram sampling.
+ * @author agent <agent@local>
+ */
+
+#include "util/u_autoexpgain.h"
+#include "util/u_frame.h"
+
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+
+namespace {
+
+/*!
+ * A fisheye looking frame, a disc of @p inside surrounded by corners of
+ * @p outside, with some texture so the sample pattern matters.
+ */
+xrt_frame *
+make_frame(uint32_t w, uint32_t h, uint8_t inside, uint8_t outside)
+{
+	xrt_frame *xf = nullptr;
+	u_frame_create_one_off(XRT_FORMAT_L8, w, h, &xf);
+
+	float cx = w / 2.0f;
+	float cy = h / 2.0f;
+	float r = (h < w ? h : w) / 2.0f;
+	for (uint32_t y = 0; y < h; y++) {
+		for (uint32_t x = 0; x < w; x++) {
+			float dx = (x + 0.5f - cx) / r;
+			float dy = (y + 0.5f - cy) / r;
+			uint8_t base = dx * dx + dy * dy < 1.0f ? inside : outside;
+			xf->data[y * xf->stride + x] = (uint8_t)(base + ((x * 7 + y * 13) % 16));
+		}
+	}
+
+	return xf;
+}
+
+struct Result
+{
+	float exposure;
+	float gain;
+};
+
+template <typename Func>
+Result
+run(Func setup_and_update, int frames = 8)
+{
+	u_autoexpgain *aeg = u_autoexpgain_create(U_AEG_STRATEGY_TRACKING, true, 0);
+	for (int i = 0; i < frames; i++) {
+		setup_and_update(aeg);
+	}
+	Result r = {u_autoexpgain_get_exposure(aeg), u_autoexpgain_get_gain(aeg)};
+	u_autoexpgain_destroy(&aeg);
+	return r;
+}
+
+} // namespace
+
+
+TEST_CASE("u_autoexpgain")
+{
+	xrt_frame *xf = make_frame(640, 480, 20, 200);
+	const Result initial = run([](u_autoexpgain *) {});
+
+	SECTION("Fed in pieces is the same as the whole frame")
+	{
+		auto sampling = GENERATE(U_AEG_SAMPLING_GRID, U_AEG_SAMPLING_STAGGERED, U_AEG_SAMPLING_ROWS);
+		size_t piece = GENERATE((size_t)1, (size_t)77, (size_t)(0x6000 - 32), (size_t)1000000);
+		CAPTURE(sampling, piece);
+
+		Result whole = run([&](u_autoexpgain *aeg) {
+			u_autoexpgain_set_sampling(aeg, sampling, 32);
+			u_autoexpgain_update(aeg, xf);
+		});
+
+		Result pieces = run([&](u_autoexpgain *aeg) {
+			u_autoexpgain_set_sampling(aeg, sampling, 32);
+			u_autoexpgain_begin(aeg, 0, xf->width, xf->height, xf->stride, xf->format);
+			for (size_t offset = 0; offset < xf->size; offset += piece) {
+				size_t size = xf->size - offset < piece ? xf->size - offset : piece;
+				u_autoexpgain_add_data(aeg, offset, xf->data + offset, size);
+			}
+			u_autoexpgain_end(aeg);
+		});
+
+		CHECK(whole.exposure == pieces.exposure);
+		CHECK(whole.gain == pieces.gain);
+	}
+
+	SECTION("Image inside a larger buffer")
+	{
+		// Like one camera in the side by side frame of a headset.
+		xrt_frame *big = nullptr;
+		u_frame_create_one_off(XRT_FORMAT_L8, 1280, 481, &big);
+		memset(big->data, 255, big->size);
+		for (uint32_t y = 0; y < 480; y++) {
+			memcpy(big->data + (y + 1) * big->stride + 640, xf->data + y * xf->stride, 640);
+		}
+
+		Result direct = run([&](u_autoexpgain *aeg) { u_autoexpgain_update(aeg, xf); });
+		Result fused = run([&](u_autoexpgain *aeg) {
+			u_autoexpgain_begin(aeg, big->stride + 640, 640, 480, big->stride, XRT_FORMAT_L8);
+			u_autoexpgain_add_data(aeg, 0, big->data, big->size);
+			u_autoexpgain_end(aeg);
+		});
+
+		CHECK(direct.exposure == fused.exposure);
+		CHECK(direct.gain == fused.gain);
+
+		xrt_frame_reference(&big, nullptr);
+	}
+
+	SECTION("Region of interest")
+	{
+		// The bright corners make the whole image look too bright.
+		Result full = run([&](u_autoexpgain *aeg) { u_autoexpgain_update(aeg, xf); });
+		CHECK(full.gain < initial.gain);
+
+		// Only looking at the dark disc makes it look too dark instead.
+		xrt_rect rect = {{80, 0}, {480, 480}};
+		Result ellipse = run([&](u_autoexpgain *aeg) {
+			u_autoexpgain_set_roi(aeg, &rect, true);
+			u_autoexpgain_update(aeg, xf);
+		});
+		CHECK(ellipse.gain > initial.gain);
+
+		// Back to the full image.
+		Result cleared = run([&](u_autoexpgain *aeg) {
+			u_autoexpgain_set_roi(aeg, &rect, true);
+			u_autoexpgain_set_roi(aeg, nullptr, false);
+			u_autoexpgain_update(aeg, xf);
+		});
+		CHECK(cleared.gain == full.gain);
+	}
+
+	SECTION("Empty region leaves the values alone")
+	{
+		xrt_rect rect = {{1000, 1000}, {10, 10}};
+		Result r = run([&](u_autoexpgain *aeg) {
+			u_autoexpgain_set_roi(aeg, &rect, false);
+			u_autoexpgain_update(aeg, xf);
+		});
+		CHECK(r.exposure == initial.exposure);
+		CHECK(r.gain == initial.gain);
+	}
+
+	xrt_frame_reference(&xf, nullptr);
+}
+
+TEST_CASE("u_autoexpgain throughput", "[.][benchmark]")
+{
+	xrt_frame *xf = make_frame(640, 480, 20, 200);
+	const int iterations = 10000;
+
+	auto time_it = [&](enum u_aeg_sampling sampling, bool ellipse) {
+		u_autoexpgain *aeg = u_autoexpgain_create(U_AEG_STRATEGY_TRACKING, true, 2);
+		u_autoexpgain_set_sampling(aeg, sampling, 32);
+		xrt_rect rect = {{80, 0}, {480, 480}};
+		if (ellipse) {
+			u_autoexpgain_set_roi(aeg, &rect, true);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++) {
+			u_autoexpgain_update(aeg, xf);
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		u_autoexpgain_destroy(&aeg);
+		return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+	};
+
+	double grid_ns = time_it(U_AEG_SAMPLING_GRID, false);
+	double staggered_ns = time_it(U_AEG_SAMPLING_STAGGERED, true);
+	double rows_ns = time_it(U_AEG_SAMPLING_ROWS, false);
+
+	WARN("ns per 640x480 frame, grid: " << grid_ns << ", staggered ellipse: " << staggered_ns
+	                                   << ", grid rows: " << rows_ns);
+
+	xrt_frame_reference(&xf, nullptr);
+}
@@ -0,0 +1,211 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Write a device capture and read it back with the replay driver.
+ * @author agent <agent@local>
+ */
+
+#include "xrt/xrt_tracking.h"
+
+#include "util/u_device.h"
+#include "util/u_system_helpers.h"
+
+#include "capture/capture_format.h"
+#include "capture/capture_interface.h"
+
+#include "catch/catch.hpp"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+
+namespace {
+
+struct FakeDevice
+{
+	struct xrt_device base;
+	struct xrt_tracking_origin origin;
+	float x;
+};
+
+void
+fake_update_inputs(struct xrt_device *xdev)
+{
+	// The test writes the inputs directly.
+}
+
+void
+fake_get_tracked_pose(struct xrt_device *xdev,
+                      enum xrt_input_name name,
+                      uint64_t at_timestamp_ns,
+                      struct xrt_space_relation *out_relation)
+{
+	FakeDevice *d = (FakeDevice *)xdev;
+
+	*out_relation = XRT_SPACE_RELATION_ZERO;
+	out_relation->pose = XRT_POSE_IDENTITY;
+	out_relation->pose.position.x = d->x;
+	out_relation->relation_flags = (enum xrt_space_relation_flags)(
+	    XRT_SPACE_RELATION_ORIENTATION_VALID_BIT | XRT_SPACE_RELATION_POSITION_VALID_BIT |
+	    XRT_SPACE_RELATION_ORIENTATION_TRACKED_BIT | XRT_SPACE_RELATION_POSITION_TRACKED_BIT);
+}
+
+void
+fake_destroy(struct xrt_device *xdev)
+{
+	u_device_free(xdev);
+}
+
+FakeDevice *
+fake_create(const char *str)
+{
+	FakeDevice *d = U_DEVICE_ALLOCATE(FakeDevice, U_DEVICE_ALLOC_NO_FLAGS, 2, 0);
+	d->base.update_inputs = fake_update_inputs;
+	d->base.get_tracked_pose = fake_get_tracked_pose;
+	d->base.destroy = fake_destroy;
+	d->base.name = XRT_DEVICE_SIMPLE_CONTROLLER;
+	d->base.device_type = XRT_DEVICE_TYPE_ANY_HAND_CONTROLLER;
+	d->base.orientation_tracking_supported = true;
+	d->base.position_tracking_supported = true;
+	d->base.inputs[0].name = XRT_INPUT_SIMPLE_GRIP_POSE;
+	d->base.inputs[1].name = XRT_INPUT_SIMPLE_SELECT_CLICK;
+	snprintf(d->base.str, sizeof(d->base.str), "%s", str);
+	snprintf(d->base.serial, sizeof(d->base.serial), "%s", str);
+
+	d->origin.type = XRT_TRACKING_TYPE_OTHER;
+	d->origin.offset = XRT_POSE_IDENTITY;
+	d->origin.offset.position.y = 1.0f;
+	d->base.tracking_origin = &d->origin;
+
+	return d;
+}
+
+std::string
+make_temp_path()
+{
+	char path[] = "/tmp/monado_capture_XXXXXX";
+	int fd = mkstemp(path);
+	REQUIRE(fd >= 0);
+	close(fd);
+	return path;
+}
+
+void
+write_capture(const std::string &path)
+{
+	struct u_system_devices *usysd = u_system_devices_allocate();
+
+	FakeDevice *left = fake_create("Left");
+	FakeDevice *right = fake_create("Right");
+	usysd->base.xdevs[usysd->base.xdev_count++] = &left->base;
+	usysd->base.xdevs[usysd->base.xdev_count++] = &right->base;
+	usysd->base.roles.left = &left->base;
+
+	REQUIRE(capture_wrap_system_devices(&usysd->base, path.c_str()) == XRT_SUCCESS);
+
+	// Roles now point at the wrappers.
+	struct xrt_device *xdev = usysd->base.xdevs[0];
+	CHECK(xdev != &left->base);
+	CHECK(usysd->base.roles.left == xdev);
+
+	for (int i = 0; i < 3; i++) {
+		left->x = (float)(i + 1);
+
+		struct xrt_space_relation rel;
+		xrt_device_get_tracked_pose(xdev, XRT_INPUT_SIMPLE_GRIP_POSE, (uint64_t)(i + 1) * 1000000, &rel);
+		CHECK(rel.pose.position.x == left->x);
+
+		// Inputs are shared with the wrapped device.
+		left->base.inputs[1].value.boolean = (i % 2) == 1;
+		xrt_device_update_inputs(xdev);
+	}
+
+	// Closes the file.
+	xrt_system_devices_destroy((struct xrt_system_devices **)&usysd);
+}
+
+} // namespace
+
+
+TEST_CASE("capture_format")
+{
+	std::string path = make_temp_path();
+
+	write_capture(path);
+
+	SECTION("Roles")
+	{
+		uint32_t roles = 0;
+		REQUIRE(capture_replay_read_roles(path.c_str(), &roles) == XRT_SUCCESS);
+		CHECK(roles == CAPTURE_ROLE_LEFT);
+	}
+
+	SECTION("Replay")
+	{
+		struct xrt_system_devices *xsysd = NULL;
+		REQUIRE(capture_replay_create_system_devices(path.c_str(), &xsysd) == XRT_SUCCESS);
+		REQUIRE(xsysd->xdev_count == 2);
+
+		struct xrt_device *xdev = xsysd->xdevs[0];
+		CHECK(std::string(xdev->str) == "Left");
+		CHECK(std::string(xsysd->xdevs[1]->str) == "Right");
+		CHECK(xdev->name == XRT_DEVICE_SIMPLE_CONTROLLER);
+		CHECK(xdev->input_count == 2);
+		CHECK(xdev->inputs[0].name == XRT_INPUT_SIMPLE_GRIP_POSE);
+		CHECK(xdev->inputs[1].name == XRT_INPUT_SIMPLE_SELECT_CLICK);
+		CHECK(xdev->tracking_origin->offset.position.y == 1.0f);
+
+		CHECK(xsysd->roles.head == NULL);
+		CHECK(xsysd->roles.left == xdev);
+		CHECK(xsysd->roles.right == NULL);
+
+		// Any time maps into the recording, poses stay within what was recorded.
+		struct xrt_space_relation rel;
+		xrt_device_get_tracked_pose(xdev, XRT_INPUT_SIMPLE_GRIP_POSE, 1000, &rel);
+		CHECK((rel.relation_flags & XRT_SPACE_RELATION_POSITION_VALID_BIT) != 0);
+		CHECK(rel.pose.position.x >= 1.0f);
+		CHECK(rel.pose.position.x <= 3.0f);
+
+		// Nothing was recorded for the right device.
+		xrt_device_get_tracked_pose(xsysd->xdevs[1], XRT_INPUT_SIMPLE_GRIP_POSE, 1000, &rel);
+		CHECK(rel.relation_flags == 0);
+
+		xrt_system_devices_destroy(&xsysd);
+	}
+
+	SECTION("Cut short")
+	{
+		// A partially written record at the end is ignored.
+		FILE *file = fopen(path.c_str(), "ab");
+		REQUIRE(file != NULL);
+		uint8_t junk[CAPTURE_RECORD_ALIGN] = {CAPTURE_RECORD_POSE};
+		fwrite(junk, sizeof(junk), 1, file);
+		fclose(file);
+
+		struct xrt_system_devices *xsysd = NULL;
+		REQUIRE(capture_replay_create_system_devices(path.c_str(), &xsysd) == XRT_SUCCESS);
+		CHECK(xsysd->xdev_count == 2);
+		xrt_system_devices_destroy(&xsysd);
+	}
+
+	SECTION("Bad magic")
+	{
+		FILE *file = fopen(path.c_str(), "r+b");
+		REQUIRE(file != NULL);
+		fwrite("NOTCAPT", 8, 1, file);
+		fclose(file);
+
+		uint32_t roles = 0;
+		CHECK(capture_replay_read_roles(path.c_str(), &roles) != XRT_SUCCESS);
+
+		struct xrt_system_devices *xsysd = NULL;
+		CHECK(capture_replay_create_system_devices(path.c_str(), &xsysd) != XRT_SUCCESS);
+		CHECK(xsysd == NULL);
+	}
+
+	remove(path.c_str());
+}
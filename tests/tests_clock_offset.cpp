@@ -0,0 +1,182 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Test the skew aware clock offset estimator.
+ * @author agent <agent@local>
+ */
+
+#include "math/m_clock_offset.h"
+
+#include "catch/catch.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+
+namespace {
+
+struct Pair
+{
+	//! When the event really happened, in host clock.
+	timepoint_ns truth;
+	//! Device timestamp.
+	timepoint_ns a;
+	//! When the host saw it.
+	timepoint_ns b;
+};
+
+//! Smallest transport delay, can't be observed so estimates are relative to it.
+constexpr time_duration_ns kMinDelay = 300 * 1000;
+
+/*!
+ * Timestamp pairs shaped like a USB IMU: device clock running @p skew_ppm
+ * slower than the host, a delay that is mostly close to the minimum with a
+ * long tail, and now and then a spike of several milliseconds.
+ */
+std::vector<Pair>
+make_pairs(double skew_ppm, uint32_t seconds, uint32_t hz)
+{
+	std::vector<Pair> pairs;
+	uint32_t state = 0x9e3779b9;
+	auto rand01 = [&state]() {
+		state = state * 1664525u + 1013904223u;
+		return (double)(state >> 8) / (double)(1u << 24);
+	};
+
+	const double device_rate = 1.0 - skew_ppm / 1000000.0;
+	const timepoint_ns host_start = (timepoint_ns)3000 * U_TIME_1S_IN_NS;
+	const timepoint_ns device_start = 12345678901;
+	const uint32_t count = seconds * hz;
+
+	for (uint32_t i = 0; i < count; i++) {
+		time_duration_ns t = (time_duration_ns)i * U_TIME_1S_IN_NS / hz;
+
+		double delay = (double)kMinDelay - 200000.0 * log(1.0 - rand01() * 0.999);
+		if (rand01() < 0.01) {
+			delay += 5000000.0 + rand01() * 25000000.0;
+		}
+
+		Pair p;
+		p.truth = host_start + t;
+		p.a = device_start + (timepoint_ns)((double)t * device_rate);
+		p.b = p.truth + (time_duration_ns)delay;
+		pairs.push_back(p);
+	}
+
+	return pairs;
+}
+
+//! Mean absolute timestamp error after @p warmup samples.
+template <typename Func>
+double
+mean_error_us(const std::vector<Pair> &pairs, size_t warmup, Func func)
+{
+	double sum = 0.0;
+	size_t count = 0;
+	for (size_t i = 0; i < pairs.size(); i++) {
+		timepoint_ns mapped = func(pairs[i]);
+		if (i < warmup) {
+			continue;
+		}
+		sum += fabs((double)(mapped - pairs[i].truth - kMinDelay)) / 1000.0;
+		count++;
+	}
+	return sum / (double)count;
+}
+
+} // namespace
+
+
+TEST_CASE("m_clock_offset_estimator")
+{
+	m_clock_offset_estimator est;
+	m_clock_offset_estimator_init(&est, 0);
+
+	SECTION("Unknown estimate maps to itself")
+	{
+		CHECK(m_clock_offset_estimator_a2b(&est, 1000) == 1000);
+		CHECK(m_clock_offset_estimator_b2a(&est, 1000) == 1000);
+	}
+
+	SECTION("First sample is taken as is")
+	{
+		CHECK(m_clock_offset_estimator_update(&est, 1000, 5000) == 5000);
+		CHECK(m_clock_offset_estimator_a2b(&est, 2000) == 6000);
+		CHECK(est.stats.offset_ns == 4000);
+	}
+
+	SECTION("Delay spikes do not move the estimate")
+	{
+		m_clock_offset_estimator_update(&est, 0, 1000);
+		m_clock_offset_estimator_update(&est, 1000000, 1001000 + 20 * U_TIME_1MS_IN_NS);
+		m_clock_offset_estimator_update(&est, 2000000, 2001000 + 3 * U_TIME_1MS_IN_NS);
+		CHECK(m_clock_offset_estimator_a2b(&est, 3000000) == 3001000);
+		CHECK(est.stats.reset_count == 0);
+	}
+
+	const double skew_ppm = GENERATE(-80.0, 0.0, 35.0);
+	const std::vector<Pair> pairs = make_pairs(skew_ppm, 60, 1000);
+	const size_t warmup = 20 * 1000;
+
+	CAPTURE(skew_ppm);
+
+	SECTION("Less error than the moving average")
+	{
+		time_duration_ns hw2mono = 0;
+		double ema_us = mean_error_us(pairs, warmup, [&](const Pair &p) {
+			return m_clock_offset_a2b(1000.0f, p.a, p.b, &hw2mono); //
+		});
+
+		double est_us = mean_error_us(pairs, warmup, [&](const Pair &p) {
+			return m_clock_offset_estimator_update(&est, p.a, p.b); //
+		});
+
+		CAPTURE(ema_us, est_us);
+
+		// The moving average follows the mean delay and the spikes.
+		CHECK(ema_us > 150.0);
+		CHECK(est_us < 20.0);
+		CHECK(est.stats.skew_ppm == Approx(skew_ppm / (1.0 - skew_ppm / 1000000.0)).margin(3.0));
+		CHECK(est.stats.delay_mean_us > 100.0);
+		CHECK(est.stats.jitter_us > 0.0f);
+		CHECK(est.stats.reset_count == 0);
+
+		// Orientation error from the timestamp error at a brisk 3 rad/s head turn.
+		const double ang_vel = 3.0;
+		CHECK(est_us * ang_vel < ema_us * ang_vel / 5.0);
+	}
+
+	SECTION("Mapping back and forth")
+	{
+		for (const Pair &p : pairs) {
+			m_clock_offset_estimator_update(&est, p.a, p.b);
+		}
+
+		for (timepoint_ns a : {pairs.back().a, pairs.back().a + U_TIME_1S_IN_NS, pairs.front().a}) {
+			timepoint_ns b = m_clock_offset_estimator_a2b(&est, a);
+			CHECK(std::llabs(m_clock_offset_estimator_b2a(&est, b) - a) <= 1);
+		}
+	}
+
+	SECTION("Device clock reset")
+	{
+		size_t half = pairs.size() / 2;
+		for (size_t i = 0; i < half; i++) {
+			m_clock_offset_estimator_update(&est, pairs[i].a, pairs[i].b);
+		}
+
+		// Device restarts its clock from zero.
+		const timepoint_ns a_base = pairs[half].a;
+		double est_us = mean_error_us(pairs, half + 10 * 1000, [&](const Pair &p) {
+			if (p.a < a_base) {
+				return p.truth + kMinDelay;
+			}
+			return m_clock_offset_estimator_update(&est, p.a - a_base, p.b);
+		});
+
+		CHECK(est.stats.reset_count == 1);
+		CHECK(est_us < 20.0);
+	}
+}
@@ -0,0 +1,127 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Test the frame pool and ROI helpers.
+ * @author agent <agent@local>
+ */
+
+#include "util/u_frame.h"
+
+#include "catch/catch.hpp"
+
+
+TEST_CASE("u_frame_pool")
+{
+	struct u_frame_pool *pool = u_frame_pool_create(XRT_FORMAT_L8, 64, 33, 2);
+	REQUIRE(pool != nullptr);
+
+	struct xrt_frame *a = nullptr;
+	struct xrt_frame *b = nullptr;
+	struct xrt_frame *c = nullptr;
+
+	SECTION("Frames are sized and runs out")
+	{
+		REQUIRE(u_frame_pool_get(pool, &a));
+		REQUIRE(u_frame_pool_get(pool, &b));
+		CHECK(a != b);
+		CHECK(a->width == 64);
+		CHECK(a->height == 33);
+		CHECK(a->stride == 64);
+		CHECK(a->size == 64 * 33);
+		CHECK(a->format == XRT_FORMAT_L8);
+		CHECK(a->reference.count == 1);
+
+		CHECK_FALSE(u_frame_pool_get(pool, &c));
+		CHECK(c == nullptr);
+
+		xrt_frame_reference(&a, nullptr);
+		CHECK(u_frame_pool_get(pool, &c));
+		CHECK(c != nullptr);
+
+		xrt_frame_reference(&b, nullptr);
+		xrt_frame_reference(&c, nullptr);
+		u_frame_pool_destroy(&pool);
+		CHECK(pool == nullptr);
+	}
+
+	SECTION("Reused frames are reset")
+	{
+		REQUIRE(u_frame_pool_get(pool, &a));
+		a->timestamp = 1234;
+		a->source_sequence = 42;
+		a->stereo_format = XRT_STEREO_FORMAT_SBS;
+		struct xrt_frame *old = a;
+		xrt_frame_reference(&a, nullptr);
+
+		REQUIRE(u_frame_pool_get(pool, &a));
+		CHECK(a == old);
+		CHECK(a->timestamp == 0);
+		CHECK(a->source_sequence == 0);
+		CHECK(a->stereo_format == XRT_STEREO_FORMAT_NONE);
+
+		xrt_frame_reference(&a, nullptr);
+		u_frame_pool_destroy(&pool);
+	}
+
+	SECTION("Frames outlive the pool")
+	{
+		REQUIRE(u_frame_pool_get(pool, &a));
+		a->data[0] = 0xab;
+		a->data[a->size - 1] = 0xcd;
+
+		u_frame_pool_destroy(&pool);
+
+		// Still valid after destroy, freed with the last frame.
+		CHECK(a->data[0] == 0xab);
+		CHECK(a->data[a->size - 1] == 0xcd);
+		xrt_frame_reference(&a, nullptr);
+	}
+}
+
+TEST_CASE("u_frame_create_rois")
+{
+	struct xrt_frame *original = nullptr;
+	u_frame_create_one_off(XRT_FORMAT_L8, 64, 32, &original);
+	original->timestamp = 77;
+	for (uint32_t i = 0; i < original->size; i++) {
+		original->data[i] = (uint8_t)i;
+	}
+
+	struct xrt_rect rois[3] = {
+	    {{0, 0}, {64, 32}},
+	    {{8, 4}, {16, 8}},
+	    {{63, 31}, {1, 1}},
+	};
+	struct xrt_frame *frames[3] = {};
+
+	u_frame_create_rois(original, rois, 3, frames);
+	CHECK(original->reference.count == 2);
+
+	for (int i = 0; i < 3; i++) {
+		struct xrt_frame *single = nullptr;
+		u_frame_create_roi(original, rois[i], &single);
+
+		CAPTURE(i);
+		CHECK(frames[i]->reference.count == 1);
+		CHECK(frames[i]->data == single->data);
+		CHECK(frames[i]->width == single->width);
+		CHECK(frames[i]->height == single->height);
+		CHECK(frames[i]->stride == single->stride);
+		CHECK(frames[i]->size == single->size);
+		CHECK(frames[i]->timestamp == 77);
+
+		xrt_frame_reference(&single, nullptr);
+	}
+
+	CHECK(frames[1]->data[0] == (uint8_t)(4 * 64 + 8));
+
+	// The original lives until the last view is gone.
+	xrt_frame_reference(&frames[0], nullptr);
+	xrt_frame_reference(&frames[2], nullptr);
+	CHECK(original->reference.count == 2);
+	xrt_frame_reference(&frames[1], nullptr);
+	CHECK(original->reference.count == 1);
+
+	xrt_frame_reference(&original, nullptr);
+}
@@ -0,0 +1,181 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Test batched 3dof IMU fusion against the per sample path.
+ * @author agent <agent@local>
+ */
+
+#include "math/m_api.h"
+#include "math/m_imu_3dof.h"
+#include "math/m_mathinclude.h"
+
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <vector>
+
+
+namespace {
+
+struct Sample
+{
+	uint64_t timestamp_ns;
+	xrt_vec3 accel;
+	xrt_vec3 gyro;
+};
+
+/*!
+ * A 1kHz stream shaped like a recording of a headset: sitting tilted on a
+ * desk, picked up and turned around, then put down again. Has a bit of
+ * deterministic noise so the fusion has something to chew on.
+ */
+std::vector<Sample>
+make_stream(uint32_t seconds)
+{
+	std::vector<Sample> stream;
+	uint32_t state = 0x12345678;
+	auto noise = [&state](float scale) {
+		state = state * 1664525u + 1013904223u;
+		return ((float)(state >> 8) / (float)(1u << 24) - 0.5f) * scale;
+	};
+
+	const uint64_t period_ns = 1000 * 1000;
+	const uint32_t count = seconds * 1000;
+
+	for (uint32_t i = 0; i < count; i++) {
+		float t = (float)i / 1000.0f;
+		float phase = t / (float)seconds;
+
+		Sample s = {};
+		s.timestamp_ns = 1000 * period_ns + i * period_ns;
+
+		// Tilted gravity, then moving, then still again.
+		bool moving = phase > 0.3f && phase < 0.7f;
+		s.accel = {1.5f + noise(0.05f), 9.7f + noise(0.05f), 0.4f + noise(0.05f)};
+		s.gyro = {noise(0.004f), noise(0.004f), noise(0.004f)};
+
+		if (moving) {
+			s.gyro.x += 0.8f * sinf(t * 3.0f);
+			s.gyro.y += 1.5f * cosf(t * 1.3f);
+			s.gyro.z += 0.4f * sinf(t * 5.0f);
+			s.accel.x += 2.0f * sinf(t * 7.0f);
+		}
+
+		stream.push_back(s);
+	}
+
+	return stream;
+}
+
+float
+quat_angle_between(const xrt_quat &a, const xrt_quat &b)
+{
+	float dot = fabsf(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w);
+	return 2.0f * acosf(fminf(dot, 1.0f));
+}
+
+void
+run_single(m_imu_3dof &f, const std::vector<Sample> &stream)
+{
+	for (const Sample &s : stream) {
+		m_imu_3dof_update(&f, s.timestamp_ns, &s.accel, &s.gyro);
+	}
+}
+
+void
+run_batched(m_imu_3dof &f, const std::vector<Sample> &stream, uint32_t batch_size)
+{
+	m_imu_3dof_batch batch = {};
+	for (const Sample &s : stream) {
+		m_imu_3dof_batch_add(&batch, s.timestamp_ns, &s.accel, &s.gyro);
+		if (batch.count >= batch_size) {
+			m_imu_3dof_update_many(&f, &batch);
+			batch.count = 0;
+		}
+	}
+	m_imu_3dof_update_many(&f, &batch);
+}
+
+} // namespace
+
+
+TEST_CASE("IMU 3dof batched update")
+{
+	const std::vector<Sample> stream = make_stream(10);
+	const int flags = M_IMU_3DOF_USE_GRAVITY_DUR_20MS;
+
+	SECTION("Empty batch does nothing")
+	{
+		m_imu_3dof f;
+		m_imu_3dof_init(&f, flags);
+
+		m_imu_3dof_batch batch = {};
+		m_imu_3dof_update_many(&f, &batch);
+		CHECK(f.state == M_IMU_3DOF_STATE_START);
+		CHECK(f.rot.w == 1.0f);
+
+		m_imu_3dof_close(&f);
+	}
+
+	SECTION("Batch add stops when full")
+	{
+		m_imu_3dof_batch batch = {};
+		xrt_vec3 v = {};
+		for (uint32_t i = 0; i < M_IMU_3DOF_BATCH_MAX_SAMPLES; i++) {
+			CHECK(m_imu_3dof_batch_add(&batch, i, &v, &v));
+		}
+		CHECK_FALSE(m_imu_3dof_batch_add(&batch, 100, &v, &v));
+		CHECK(batch.count == M_IMU_3DOF_BATCH_MAX_SAMPLES);
+	}
+
+	SECTION("Matches the per sample path")
+	{
+		// Vive sends three samples per report, also test a full batch.
+		uint32_t batch_size = GENERATE(1u, 3u, (uint32_t)M_IMU_3DOF_BATCH_MAX_SAMPLES);
+
+		m_imu_3dof single;
+		m_imu_3dof batched;
+		m_imu_3dof_init(&single, flags);
+		m_imu_3dof_init(&batched, flags);
+
+		run_single(single, stream);
+		run_batched(batched, stream, batch_size);
+
+		CAPTURE(batch_size);
+
+		// Gravity correction has been running the same on both.
+		CHECK(single.grav.error_angle > 0.0f);
+		CHECK(batched.grav.error_angle == Approx(single.grav.error_angle).margin(0.001));
+		CHECK(quat_angle_between(single.rot, batched.rot) < 0.002f);
+		CHECK(single.last.timestamp_ns == batched.last.timestamp_ns);
+		CHECK(single.last.gyro_length == Approx(batched.last.gyro_length));
+		CHECK(single.last.accel_length == Approx(batched.last.accel_length));
+
+		m_imu_3dof_close(&single);
+		m_imu_3dof_close(&batched);
+	}
+}
+
+TEST_CASE("IMU 3dof batched update throughput", "[.][benchmark]")
+{
+	const std::vector<Sample> stream = make_stream(60);
+	const int flags = M_IMU_3DOF_USE_GRAVITY_DUR_20MS;
+
+	auto time_it = [&](auto func) {
+		m_imu_3dof f;
+		m_imu_3dof_init(&f, flags);
+		auto start = std::chrono::steady_clock::now();
+		func(f);
+		auto end = std::chrono::steady_clock::now();
+		m_imu_3dof_close(&f);
+		return std::chrono::duration<double, std::nano>(end - start).count() / (double)stream.size();
+	};
+
+	double single_ns = time_it([&](m_imu_3dof &f) { run_single(f, stream); });
+	double batch3_ns = time_it([&](m_imu_3dof &f) { run_batched(f, stream, 3); });
+	double batch16_ns = time_it([&](m_imu_3dof &f) { run_batched(f, stream, M_IMU_3DOF_BATCH_MAX_SAMPLES); });
+
+	WARN("ns per sample, single: " << single_ns << ", batch of 3: " << batch3_ns
+	                               << ", batch of 16: " << batch16_ns);
+}
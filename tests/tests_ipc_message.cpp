@@ -0,0 +1,166 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Test the variable length IPC message framing.
+ * @author agent <agent@local>
+ */
+
+#include "shared/ipc_utils.h"
+#include "shared/ipc_protocol.h"
+
+#include "catch/catch.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+struct Channels
+{
+	ipc_message_channel client{};
+	ipc_message_channel server{};
+
+	Channels()
+	{
+		int fds[2] = {-1, -1};
+		REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+		client.ipc_handle = fds[0];
+		client.log_level = U_LOGGING_WARN;
+		server.ipc_handle = fds[1];
+		server.log_level = U_LOGGING_WARN;
+	}
+
+	~Channels()
+	{
+		ipc_message_channel_close(&client);
+		ipc_message_channel_close(&server);
+	}
+};
+
+#pragma pack(push, 1)
+struct TestMsg
+{
+	uint32_t cmd;
+	uint8_t odd; // Makes the struct size not a multiple of the alignment.
+	uint32_t count;
+};
+#pragma pack(pop)
+
+} // namespace
+
+
+TEST_CASE("ipc_message_part_offset")
+{
+	CHECK(ipc_message_part_offset(0) == 0);
+	CHECK(ipc_message_part_offset(1) == IPC_MESSAGE_PART_ALIGN);
+	CHECK(ipc_message_part_offset(IPC_MESSAGE_PART_ALIGN) == IPC_MESSAGE_PART_ALIGN);
+	CHECK(ipc_message_part_offset(IPC_MESSAGE_PART_ALIGN + 1) == 2 * IPC_MESSAGE_PART_ALIGN);
+}
+
+TEST_CASE("ipc_request")
+{
+	Channels c;
+	ipc_message_buffer buf = {};
+
+	// Bigger than the initial buffer so it has to grow.
+	const uint32_t count = GENERATE(0u, 3u, 1000u);
+	CAPTURE(count);
+
+	std::vector<float> values(count);
+	for (uint32_t i = 0; i < count; i++) {
+		values[i] = (float)i * 0.5f;
+	}
+
+	TestMsg msg = {42, 7, count};
+	ipc_message_part parts[] = {
+	    {&msg, sizeof(msg)},
+	    {values.data(), sizeof(float) * count},
+	};
+
+	REQUIRE(ipc_send_request(&c.client, parts, ARRAY_SIZE(parts)) == XRT_SUCCESS);
+
+	size_t size = 0;
+	REQUIRE(ipc_receive_request(&c.server, &buf, &size) == XRT_SUCCESS);
+
+	size_t offset = ipc_message_part_offset(sizeof(msg));
+	REQUIRE(size == offset + sizeof(float) * count);
+	CHECK(buf.capacity >= size);
+
+	TestMsg got;
+	memcpy(&got, buf.data, sizeof(got));
+	CHECK(got.cmd == 42);
+	CHECK(got.odd == 7);
+	CHECK(got.count == count);
+	CHECK(memcmp(buf.data + offset, values.data(), sizeof(float) * count) == 0);
+
+	ipc_message_buffer_fini(&buf);
+	CHECK(buf.data == nullptr);
+}
+
+TEST_CASE("ipc_parts")
+{
+	Channels c;
+
+	uint32_t reply = 0xdeadbeef;
+	uint8_t odd[3] = {1, 2, 3};
+	std::vector<uint64_t> big(20000);
+	for (size_t i = 0; i < big.size(); i++) {
+		big[i] = i * 3;
+	}
+
+	ipc_message_part send_parts[] = {
+	    {&reply, sizeof(reply)},
+	    {odd, sizeof(odd)},
+	    {big.data(), sizeof(uint64_t) * big.size()},
+	};
+
+	uint32_t got_reply = 0;
+	uint8_t got_odd[3] = {};
+	std::vector<uint64_t> got_big(big.size());
+
+	ipc_message_part receive_parts[] = {
+	    {&got_reply, sizeof(got_reply)},
+	    {got_odd, sizeof(got_odd)},
+	    {got_big.data(), sizeof(uint64_t) * got_big.size()},
+	};
+
+	// Too large for the socket buffer, so send from another thread.
+	xrt_result_t send_result = XRT_ERROR_IPC_FAILURE;
+	std::thread sender([&] { send_result = ipc_send_parts(&c.server, send_parts, ARRAY_SIZE(send_parts)); });
+
+	CHECK(ipc_receive_parts(&c.client, receive_parts, ARRAY_SIZE(receive_parts)) == XRT_SUCCESS);
+	sender.join();
+
+	CHECK(send_result == XRT_SUCCESS);
+	CHECK(got_reply == reply);
+	CHECK(memcmp(got_odd, odd, sizeof(odd)) == 0);
+	CHECK(got_big == big);
+}
+
+TEST_CASE("ipc_request_invalid")
+{
+	Channels c;
+	ipc_message_buffer buf = {};
+	size_t size = 0;
+
+	SECTION("Too large")
+	{
+		ipc_message_header header = {IPC_MAX_MESSAGE_SIZE + 1};
+		REQUIRE(ipc_send(&c.client, &header, sizeof(header)) == XRT_SUCCESS);
+		CHECK(ipc_receive_request(&c.server, &buf, &size) == XRT_ERROR_IPC_FAILURE);
+	}
+
+	SECTION("Closed")
+	{
+		ipc_message_channel_close(&c.client);
+		CHECK(ipc_receive_request(&c.server, &buf, &size) == XRT_ERROR_IPC_FAILURE);
+	}
+
+	ipc_message_buffer_fini(&buf);
+}
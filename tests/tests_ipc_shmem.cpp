@@ -0,0 +1,71 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Test the shared memory helpers.
+ * @author agent <agent@local>
+ */
+
+#include "shared/ipc_shmem.h"
+
+#include "catch/catch.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <cstdint>
+#include <cstdio>
+
+
+TEST_CASE("ipc_shmem_read_only_handle")
+{
+	const size_t size = 4096;
+
+	xrt_shmem_handle_t handle = -1;
+	void *map = nullptr;
+	REQUIRE(ipc_shmem_create(size, &handle, &map) == XRT_SUCCESS);
+	static_cast<uint32_t *>(map)[0] = 0xcafe;
+
+	xrt_shmem_handle_t ro_handle = -1;
+	REQUIRE(ipc_shmem_create_read_only_handle(handle, &ro_handle) == XRT_SUCCESS);
+
+	SECTION("Can be read")
+	{
+		const void *ro_map = nullptr;
+		REQUIRE(ipc_shmem_map_read_only(ro_handle, size, &ro_map) == XRT_SUCCESS);
+		CHECK(static_cast<const uint32_t *>(ro_map)[0] == 0xcafe);
+
+		// Writes through the original mapping still show up.
+		static_cast<uint32_t *>(map)[0] = 0xbeef;
+		CHECK(static_cast<const uint32_t *>(ro_map)[0] == 0xbeef);
+
+		munmap(const_cast<void *>(ro_map), size);
+	}
+
+	SECTION("Can't be mapped writable")
+	{
+		void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, ro_handle, 0);
+		CHECK(ptr == MAP_FAILED);
+	}
+
+	SECTION("Can't be reopened writable")
+	{
+		char path[64];
+		snprintf(path, sizeof(path), "/proc/self/fd/%d", ro_handle);
+
+		// Root ignores the file mode.
+		if (geteuid() != 0) {
+			int fd = open(path, O_RDWR);
+			CHECK(fd < 0);
+			if (fd >= 0) {
+				close(fd);
+			}
+		}
+	}
+
+	ipc_shmem_destroy(&ro_handle, NULL, 0);
+	ipc_shmem_destroy(&handle, &map, size);
+	CHECK(handle == -1);
+	CHECK(map == nullptr);
+}
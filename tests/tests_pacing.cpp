@@ -386,3 +386,161 @@ TEST_CASE("u_pacing_compositor_fake")
 	}
 	u_pc_destroy(&upc);
 }
+
+TEST_CASE("u_pacing_app_rate_divisor")
+{
+	MockClock clock;
+	u_pacing_app_factory *upaf = nullptr;
+	u_pacing_app *upa = nullptr;
+
+	const uint32_t divisor = GENERATE(1u, 2u, 3u);
+	CAPTURE(divisor);
+
+	REQUIRE(XRT_SUCCESS == u_pa_factory_create_with_rate_divisor(divisor, &upaf));
+	REQUIRE(upaf != nullptr);
+	u_paf_create(upaf, &upa);
+	REQUIRE(upa != nullptr);
+
+	clock.advance(1ms);
+	u_pa_info(upa, clock.now() + frame_interval_ns.count(), frame_interval_ns.count(), 0);
+
+	uint64_t last_display_time_ns = 0;
+	for (int i = 0; i < 10; ++i) {
+		int64_t frame_id = -1;
+		uint64_t wake_up_time_ns = 0;
+		uint64_t predicted_display_time_ns = 0;
+		uint64_t predicted_display_period_ns = 0;
+
+		u_pa_predict(upa, clock.now(), &frame_id, &wake_up_time_ns, &predicted_display_time_ns,
+		             &predicted_display_period_ns);
+		INFO(frame_id);
+
+		CHECK(predicted_display_period_ns == frame_interval_ns.count() * divisor);
+		CHECK(predicted_display_time_ns > clock.now());
+		if (last_display_time_ns != 0) {
+			CHECK(predicted_display_time_ns - last_display_time_ns == frame_interval_ns.count() * divisor);
+		}
+		last_display_time_ns = predicted_display_time_ns;
+
+		// Quick app that finishes way before its deadline.
+		if (wake_up_time_ns > clock.now()) {
+			clock.advance_to(wake_up_time_ns);
+		}
+		u_pa_mark_point(upa, frame_id, U_TIMING_POINT_WAKE_UP, clock.now());
+		u_pa_mark_point(upa, frame_id, U_TIMING_POINT_BEGIN, clock.now());
+		clock.advance(1ms);
+		u_pa_mark_delivered(upa, frame_id, clock.now(), predicted_display_time_ns);
+		u_pa_mark_gpu_done(upa, frame_id, clock.now());
+		u_pa_latched(upa, frame_id, clock.now(), frame_id);
+		u_pa_retired(upa, frame_id, clock.now());
+	}
+
+	u_pa_destroy(&upa);
+	u_paf_destroy(&upaf);
+}
+
+namespace {
+
+struct AppPrediction
+{
+	int64_t frame_id{-1};
+	uint64_t wake_up_time_ns{0};
+	uint64_t predicted_display_time_ns{0};
+	uint64_t predicted_display_period_ns{0};
+};
+
+//! Runs one app frame that spends @p cpu_time between begin and delivered.
+AppPrediction
+run_app_frame(u_pacing_app *upa, MockClock &clock, unanoseconds cpu_time)
+{
+	AppPrediction p{};
+	u_pa_predict(upa, clock.now(), &p.frame_id, &p.wake_up_time_ns, &p.predicted_display_time_ns,
+	             &p.predicted_display_period_ns);
+
+	if (p.wake_up_time_ns > clock.now()) {
+		clock.advance_to(p.wake_up_time_ns);
+	}
+	u_pa_mark_point(upa, p.frame_id, U_TIMING_POINT_WAKE_UP, clock.now());
+	u_pa_mark_point(upa, p.frame_id, U_TIMING_POINT_BEGIN, clock.now());
+	clock.advance(cpu_time);
+	u_pa_mark_delivered(upa, p.frame_id, clock.now(), p.predicted_display_time_ns);
+	u_pa_mark_gpu_done(upa, p.frame_id, clock.now());
+	u_pa_latched(upa, p.frame_id, clock.now(), p.frame_id);
+	u_pa_retired(upa, p.frame_id, clock.now());
+
+	return p;
+}
+
+} // namespace
+
+TEST_CASE("u_pacing_app_rate_divisor_clamped")
+{
+	MockClock clock;
+	u_pacing_app_factory *upaf = nullptr;
+	u_pacing_app *upa = nullptr;
+
+	uint32_t divisor = 0;
+	uint64_t expected_period_ns = 0;
+	SECTION("Zero is full rate")
+	{
+		divisor = 0;
+		expected_period_ns = frame_interval_ns.count();
+	}
+	SECTION("Too large is clamped to the max")
+	{
+		divisor = 100;
+		expected_period_ns = frame_interval_ns.count() * 4;
+	}
+
+	REQUIRE(XRT_SUCCESS == u_pa_factory_create_with_rate_divisor(divisor, &upaf));
+	u_paf_create(upaf, &upa);
+	REQUIRE(upa != nullptr);
+
+	clock.advance(1ms);
+	u_pa_info(upa, clock.now() + frame_interval_ns.count(), frame_interval_ns.count(), 0);
+
+	AppPrediction p = run_app_frame(upa, clock, 1ms);
+	CHECK(p.predicted_display_period_ns == expected_period_ns);
+
+	u_pa_destroy(&upa);
+	u_paf_destroy(&upaf);
+}
+
+TEST_CASE("u_pacing_app_rate_divisor_slow_app")
+{
+	MockClock clock;
+	u_pacing_app_factory *upaf = nullptr;
+	u_pacing_app *upa = nullptr;
+
+	// Half rate is 32ms, the app needs more than that.
+	REQUIRE(XRT_SUCCESS == u_pa_factory_create_with_rate_divisor(2, &upaf));
+	u_paf_create(upaf, &upa);
+	REQUIRE(upa != nullptr);
+
+	clock.advance(1ms);
+	const uint64_t first_display_ns = clock.now() + frame_interval_ns.count();
+	u_pa_info(upa, first_display_ns, frame_interval_ns.count(), 0);
+
+	AppPrediction p{};
+	uint64_t last_display_time_ns = 0;
+	for (int i = 0; i < 60; ++i) {
+		p = run_app_frame(upa, clock, 40ms);
+		INFO(i);
+
+		// Always a whole number of display periods away from the display grid.
+		CHECK((p.predicted_display_time_ns - first_display_ns) % frame_interval_ns.count() == 0);
+		CHECK(p.predicted_display_period_ns % frame_interval_ns.count() == 0);
+		CHECK(p.predicted_display_period_ns >= frame_interval_ns.count() * 2);
+
+		if (last_display_time_ns != 0) {
+			CHECK(p.predicted_display_time_ns > last_display_time_ns);
+		}
+		last_display_time_ns = p.predicted_display_time_ns;
+	}
+
+	// Once the CPU time estimate has caught up the app runs at a third of the rate.
+	CHECK(p.predicted_display_period_ns == frame_interval_ns.count() * 3);
+
+	u_pa_destroy(&upa);
+	u_paf_destroy(&upaf);
+}
@@ -0,0 +1,430 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Test batched pose functions against the single pose functions.
+ * @author agent <agent@local>
+ */
+
+#include "math/m_api.h"
+#include "math/m_space.h"
+#include "math/m_pose_batch.h"
+#include "util/u_misc.h"
+#include "util/u_hand_tracking.h"
+
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <vector>
+
+
+namespace {
+
+constexpr float margin = 0.0001f;
+
+float
+rnd(uint32_t &state)
+{
+	state = state * 1664525u + 1013904223u;
+	return (float)(state >> 8) / (float)(1u << 24) * 2.0f - 1.0f;
+}
+
+xrt_vec3
+rnd_vec3(uint32_t &state, float scale)
+{
+	return {rnd(state) * scale, rnd(state) * scale, rnd(state) * scale};
+}
+
+xrt_quat
+rnd_quat(uint32_t &state)
+{
+	xrt_quat q = {rnd(state), rnd(state), rnd(state), rnd(state) + 1.5f};
+	math_quat_normalize(&q);
+	return q;
+}
+
+//! Owns the arrays that a @ref m_pose_soa points to.
+struct PoseArrays
+{
+	std::vector<float> qx, qy, qz, qw, px, py, pz;
+
+	explicit PoseArrays(size_t count)
+	    : qx(count), qy(count), qz(count), qw(count), px(count), py(count), pz(count)
+	{}
+
+	void
+	set(size_t i, const xrt_pose &p)
+	{
+		qx[i] = p.orientation.x;
+		qy[i] = p.orientation.y;
+		qz[i] = p.orientation.z;
+		qw[i] = p.orientation.w;
+		px[i] = p.position.x;
+		py[i] = p.position.y;
+		pz[i] = p.position.z;
+	}
+
+	xrt_pose
+	get(size_t i) const
+	{
+		return {{qx[i], qy[i], qz[i], qw[i]}, {px[i], py[i], pz[i]}};
+	}
+
+	m_pose_soa
+	soa()
+	{
+		return {{qx.data(), qy.data(), qz.data(), qw.data()}, {px.data(), py.data(), pz.data()}};
+	}
+};
+
+void
+check_vec3(const xrt_vec3 &a, const xrt_vec3 &b)
+{
+	CHECK(a.x == Approx(b.x).margin(margin));
+	CHECK(a.y == Approx(b.y).margin(margin));
+	CHECK(a.z == Approx(b.z).margin(margin));
+}
+
+void
+check_quat(const xrt_quat &a, const xrt_quat &b)
+{
+	CHECK(a.x == Approx(b.x).margin(margin));
+	CHECK(a.y == Approx(b.y).margin(margin));
+	CHECK(a.z == Approx(b.z).margin(margin));
+	CHECK(a.w == Approx(b.w).margin(margin));
+}
+
+void
+check_relation(const xrt_space_relation &a, const xrt_space_relation &b)
+{
+	CHECK(a.relation_flags == b.relation_flags);
+	check_quat(a.pose.orientation, b.pose.orientation);
+	check_vec3(a.pose.position, b.pose.position);
+	check_vec3(a.linear_velocity, b.linear_velocity);
+	check_vec3(a.angular_velocity, b.angular_velocity);
+}
+
+xrt_space_relation
+rnd_relation(uint32_t &state, int flags)
+{
+	xrt_space_relation r = XRT_SPACE_RELATION_ZERO;
+	r.relation_flags = (xrt_space_relation_flags)flags;
+	r.pose = {rnd_quat(state), rnd_vec3(state, 2.0f)};
+	r.linear_velocity = rnd_vec3(state, 1.0f);
+	r.angular_velocity = rnd_vec3(state, 3.0f);
+	return r;
+}
+
+} // namespace
+
+
+TEST_CASE("Batched pose math matches single pose math")
+{
+	// Not a multiple of four to hit the tail handling.
+	const uint32_t count = GENERATE(1u, 4u, 26u, 67u);
+	uint32_t state = 0xfeedf00d + count;
+
+	CAPTURE(count);
+
+	PoseArrays a(count);
+	PoseArrays b(count);
+	PoseArrays out(count);
+	std::vector<float> t(count);
+
+	for (uint32_t i = 0; i < count; i++) {
+		a.set(i, {rnd_quat(state), rnd_vec3(state, 3.0f)});
+		b.set(i, {rnd_quat(state), rnd_vec3(state, 3.0f)});
+		t[i] = (rnd(state) + 1.0f) * 0.5f;
+	}
+
+	// Make sure the shortest path and nearly equal cases are hit.
+	b.qx[0] = -a.qx[0];
+	b.qy[0] = -a.qy[0];
+	b.qz[0] = -a.qz[0];
+	b.qw[0] = -a.qw[0];
+
+	m_pose_soa sa = a.soa();
+	m_pose_soa sb = b.soa();
+	m_pose_soa so = out.soa();
+
+	SECTION("Rotate vec3")
+	{
+		m_batch_quat_rotate_vec3(&sa.orientation, &sb.position, &so.position, count);
+		for (uint32_t i = 0; i < count; i++) {
+			xrt_quat q = a.get(i).orientation;
+			xrt_vec3 v = b.get(i).position;
+			xrt_vec3 expected;
+			math_quat_rotate_vec3(&q, &v, &expected);
+			check_vec3(out.get(i).position, expected);
+		}
+	}
+
+	SECTION("Pose transform")
+	{
+		m_batch_pose_transform(&sa, &sb, &so, count);
+		for (uint32_t i = 0; i < count; i++) {
+			xrt_pose pa = a.get(i);
+			xrt_pose pb = b.get(i);
+			xrt_pose expected;
+			math_pose_transform(&pa, &pb, &expected);
+			check_quat(out.get(i).orientation, expected.orientation);
+			check_vec3(out.get(i).position, expected.position);
+		}
+	}
+
+	SECTION("Pose transform one, in place")
+	{
+		const PoseArrays orig = b;
+		xrt_pose transform = {rnd_quat(state), rnd_vec3(state, 1.0f)};
+
+		m_batch_pose_transform_one(&transform, &sb, &sb, count);
+		for (uint32_t i = 0; i < count; i++) {
+			xrt_pose pb = orig.get(i);
+			xrt_pose expected;
+			math_pose_transform(&transform, &pb, &expected);
+			check_quat(b.get(i).orientation, expected.orientation);
+			check_vec3(b.get(i).position, expected.position);
+		}
+	}
+
+	SECTION("Slerp")
+	{
+		// Nearly the same quaternion.
+		b.set(count - 1, a.get(count - 1));
+		b.qw[count - 1] += 1e-7f;
+
+		m_batch_quat_slerp(&sa.orientation, &sb.orientation, t.data(), &so.orientation, count);
+		for (uint32_t i = 0; i < count; i++) {
+			xrt_quat qa = a.get(i).orientation;
+			xrt_quat qb = b.get(i).orientation;
+			xrt_quat expected;
+			math_quat_slerp(&qa, &qb, t[i], &expected);
+			check_quat(out.get(i).orientation, expected);
+		}
+	}
+}
+
+TEST_CASE("Batched relation apply matches relation chain")
+{
+	const int pose = XRT_SPACE_RELATION_POSITION_VALID_BIT | XRT_SPACE_RELATION_ORIENTATION_VALID_BIT;
+	const int tracked = XRT_SPACE_RELATION_POSITION_TRACKED_BIT | XRT_SPACE_RELATION_ORIENTATION_TRACKED_BIT;
+	const int vel = XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT | XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT;
+
+	const int base_flags = GENERATE_COPY(pose, pose | tracked, pose | vel, XRT_SPACE_RELATION_ORIENTATION_VALID_BIT,
+	                                     XRT_SPACE_RELATION_POSITION_VALID_BIT | vel, 0);
+	const int relation_flags[] = {
+	    pose | tracked | vel,
+	    pose,
+	    XRT_SPACE_RELATION_ORIENTATION_VALID_BIT,
+	    XRT_SPACE_RELATION_POSITION_VALID_BIT | XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT,
+	    pose | XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT,
+	    0,
+	};
+
+	CAPTURE(base_flags);
+
+	uint32_t state = 0x1234abcd;
+	xrt_space_relation base = rnd_relation(state, base_flags);
+
+	// Laid out like a hand joint set, with something between the relations.
+	std::vector<xrt_hand_joint_value> joints(XRT_HAND_JOINT_COUNT);
+	for (uint32_t i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+		joints[i].relation = rnd_relation(state, relation_flags[i % ARRAY_SIZE(relation_flags)]);
+		joints[i].radius = 0.01f;
+	}
+
+	xrt_space_relation out[XRT_HAND_JOINT_COUNT];
+	m_batch_relation_apply_one(&base, &joints[0].relation, sizeof(xrt_hand_joint_value), out,
+	                           XRT_HAND_JOINT_COUNT);
+
+	for (uint32_t i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+		xrt_space_relation expected;
+		xrt_relation_chain xrc = {};
+		m_relation_chain_push_relation(&xrc, &joints[i].relation);
+		m_relation_chain_push_relation(&xrc, &base);
+		m_relation_chain_resolve(&xrc, &expected);
+
+		CAPTURE(i);
+		check_relation(out[i], expected);
+	}
+}
+
+TEST_CASE("Batched relation interpolate")
+{
+	uint32_t state = 0xabad1dea;
+	const int all = XRT_SPACE_RELATION_POSITION_VALID_BIT | XRT_SPACE_RELATION_ORIENTATION_VALID_BIT |
+	                XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT | XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT;
+
+	xrt_space_relation a[3] = {rnd_relation(state, all), rnd_relation(state, all),
+	                           rnd_relation(state, XRT_SPACE_RELATION_POSITION_VALID_BIT)};
+	xrt_space_relation b[3] = {rnd_relation(state, all),
+	                           rnd_relation(state, XRT_SPACE_RELATION_ORIENTATION_VALID_BIT), rnd_relation(state, all)};
+	float t[3] = {0.25f, 0.5f, 0.9f};
+
+	xrt_space_relation out[3];
+	m_batch_relation_interpolate(a, b, t, out, 3);
+
+	for (uint32_t i = 0; i < 3; i++) {
+		auto flags = (xrt_space_relation_flags)(a[i].relation_flags & b[i].relation_flags);
+
+		// Invalid parts are expected to be zero.
+		xrt_space_relation expected = {};
+		m_space_relation_interpolate(&a[i], &b[i], t[i], flags, &expected);
+
+		CAPTURE(i);
+		check_relation(out[i], expected);
+	}
+}
+
+TEST_CASE("Batched quaternion finite difference")
+{
+	const uint32_t count = 11;
+	const float dt = 0.016f;
+	uint32_t state = 0xc0ffee;
+
+	PoseArrays a(count);
+	PoseArrays b(count);
+	for (uint32_t i = 0; i < count; i++) {
+		xrt_quat q0 = rnd_quat(state);
+		xrt_vec3 ang_vel = rnd_vec3(state, 4.0f);
+		xrt_quat q1;
+
+		// Also hit the small angle path.
+		if (i == 0) {
+			ang_vel = {};
+		}
+
+		math_quat_integrate_velocity(&q0, &ang_vel, dt, &q1);
+		a.set(i, {q0, {}});
+		b.set(i, {q1, {}});
+	}
+
+	m_pose_soa sa = a.soa();
+	m_pose_soa sb = b.soa();
+	m_batch_quat_finite_difference(&sa.orientation, &sb.orientation, dt, &sa.position, count);
+
+	for (uint32_t i = 0; i < count; i++) {
+		xrt_quat q0 = {a.qx[i], a.qy[i], a.qz[i], a.qw[i]};
+		xrt_quat q1 = b.get(i).orientation;
+		xrt_vec3 expected;
+		math_quat_finite_difference(&q0, &q1, dt, &expected);
+
+		CAPTURE(i);
+		CHECK(a.px[i] == Approx(expected.x).margin(0.01));
+		CHECK(a.py[i] == Approx(expected.y).margin(0.01));
+		CHECK(a.pz[i] == Approx(expected.z).margin(0.01));
+	}
+}
+
+TEST_CASE("Hand joints structure of arrays")
+{
+	const int all = XRT_SPACE_RELATION_POSITION_VALID_BIT | XRT_SPACE_RELATION_ORIENTATION_VALID_BIT |
+	                XRT_SPACE_RELATION_POSITION_TRACKED_BIT | XRT_SPACE_RELATION_ORIENTATION_TRACKED_BIT;
+	uint32_t state = 0xbeef;
+
+	xrt_hand_joint_set set = {};
+	set.is_active = true;
+	for (auto &v : set.values.hand_joint_set_default) {
+		v.relation = rnd_relation(state, all);
+	}
+	u_hand_joints_apply_joint_width(&set);
+
+	u_hand_joints_soa joints;
+	u_hand_joints_soa_from_set(&set, &joints);
+
+	SECTION("Round trip")
+	{
+		xrt_hand_joint_set out = {};
+		u_hand_joints_soa_to_set(&joints, &out);
+		for (uint32_t i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+			CAPTURE(i);
+			check_relation(out.values.hand_joint_set_default[i].relation,
+			               set.values.hand_joint_set_default[i].relation);
+			CHECK(out.values.hand_joint_set_default[i].radius == set.values.hand_joint_set_default[i].radius);
+		}
+		CHECK(joints.radius[XRT_HAND_JOINT_WRIST] == Approx(0.02f));
+		CHECK(joints.radius[XRT_HAND_JOINT_LITTLE_METACARPAL] == Approx(0.022f * 0.75f * 0.5f));
+	}
+
+	SECTION("Transform")
+	{
+		xrt_space_relation base = rnd_relation(state, all | XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT);
+		u_hand_joints_soa_transform(&joints, &base);
+
+		xrt_hand_joint_set out = {};
+		u_hand_joints_soa_to_set(&joints, &out);
+		for (uint32_t i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+			xrt_space_relation expected;
+			xrt_relation_chain xrc = {};
+			m_relation_chain_push_relation(&xrc, &set.values.hand_joint_set_default[i].relation);
+			m_relation_chain_push_relation(&xrc, &base);
+			m_relation_chain_resolve(&xrc, &expected);
+
+			CAPTURE(i);
+			check_relation(out.values.hand_joint_set_default[i].relation, expected);
+		}
+	}
+
+	SECTION("Estimate velocities")
+	{
+		const float dt = 0.02f;
+		u_hand_joints_soa prev = joints;
+
+		// Only moved, no velocities for a joint that lost tracking.
+		for (uint32_t i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+			joints.position[1][i] += 0.01f;
+		}
+		prev.flags[3] = XRT_SPACE_RELATION_BITMASK_NONE;
+
+		u_hand_joints_soa_estimate_velocities(&joints, &prev, dt);
+
+		const int vel = XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT | XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT;
+		CHECK((joints.flags[0] & vel) == vel);
+		CHECK((joints.flags[3] & vel) == 0);
+		CHECK(joints.linear_velocity[1][0] == Approx(0.5f));
+		CHECK(joints.linear_velocity[0][0] == Approx(0.0f).margin(margin));
+		CHECK(joints.angular_velocity[2][0] == Approx(0.0f).margin(margin));
+	}
+}
+
+TEST_CASE("Batched relation apply throughput", "[.][benchmark]")
+{
+	const int flags = XRT_SPACE_RELATION_POSITION_VALID_BIT | XRT_SPACE_RELATION_ORIENTATION_VALID_BIT |
+	                  XRT_SPACE_RELATION_LINEAR_VELOCITY_VALID_BIT | XRT_SPACE_RELATION_ANGULAR_VELOCITY_VALID_BIT;
+	const uint32_t iterations = 100000;
+
+	uint32_t state = 0x5eed;
+	xrt_space_relation base = rnd_relation(state, flags);
+	xrt_hand_joint_value joints[XRT_HAND_JOINT_COUNT];
+	for (auto &j : joints) {
+		j.relation = rnd_relation(state, flags);
+	}
+
+	xrt_space_relation out[XRT_HAND_JOINT_COUNT];
+	float sink = 0.0f;
+
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t k = 0; k < iterations; k++) {
+		for (uint32_t i = 0; i < XRT_HAND_JOINT_COUNT; i++) {
+			xrt_relation_chain xrc = {};
+			m_relation_chain_push_relation(&xrc, &joints[i].relation);
+			m_relation_chain_push_relation(&xrc, &base);
+			m_relation_chain_resolve(&xrc, &out[i]);
+		}
+		sink += out[k % XRT_HAND_JOINT_COUNT].pose.position.x;
+	}
+	auto middle = std::chrono::steady_clock::now();
+	for (uint32_t k = 0; k < iterations; k++) {
+		m_batch_relation_apply_one(&base, &joints[0].relation, sizeof(xrt_hand_joint_value), out,
+		                           XRT_HAND_JOINT_COUNT);
+		sink += out[k % XRT_HAND_JOINT_COUNT].pose.position.x;
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	auto per_set = [&](auto a, auto b) {
+		return std::chrono::duration<double, std::nano>(b - a).count() / (double)iterations;
+	};
+
+	WARN("ns per hand joint set, chain: " << per_set(start, middle) << ", batched: " << per_set(middle, end)
+	                                      << " (" << sink << ")");
+}
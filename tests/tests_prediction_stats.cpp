@@ -0,0 +1,141 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Test the pose query statistics.
+ * @author agent <agent@local>
+ */
+
+#include "math/m_prediction_stats.h"
+#include "math/m_relation_history.h"
+#include "util/u_time.h"
+#include "util/u_telemetry.h"
+
+#include "catch/catch.hpp"
+
+#include <memory>
+
+
+TEST_CASE("m_prediction_stats")
+{
+	m_prediction_stats stats;
+	m_prediction_stats_init(&stats, "test");
+
+	const int64_t now = (int64_t)10 * U_TIME_1S_IN_NS;
+	const int64_t ms = U_TIME_1MS_IN_NS;
+
+	SECTION("Counts and bins")
+	{
+		// 12ms ahead, newest sample 3ms old so extrapolating 15ms.
+		m_prediction_stats_add(&stats, M_PREDICTION_KIND_PREDICTED, now, now + 12 * ms, now - 3 * ms);
+		// Looking 1ms back, between samples.
+		m_prediction_stats_add(&stats, M_PREDICTION_KIND_INTERPOLATED, now, now - 1 * ms, now - 1 * ms / 2);
+
+		CHECK(stats.counts[M_PREDICTION_KIND_PREDICTED] == 1);
+		CHECK(stats.counts[M_PREDICTION_KIND_INTERPOLATED] == 1);
+		CHECK(stats.extrapolated_percent == Approx(50.0f));
+
+		CHECK(stats.horizon_bins[2] == 1.0f);
+		CHECK(stats.horizon_bins[0] == 1.0f);
+		CHECK(stats.extrapolation_bins[3] == 1.0f);
+		CHECK(stats.sample_age_bins[1] == 1.0f);
+		CHECK(stats.sample_age_bins[0] == 1.0f);
+
+		CHECK(stats.period.horizon_max_ns == 12 * ms);
+		CHECK(stats.period.extrapolation_max_ns == 15 * ms);
+		CHECK(stats.period.extrapolated_count == 1);
+	}
+
+	SECTION("Outliers go in the last bin")
+	{
+		m_prediction_stats_add(&stats, M_PREDICTION_KIND_PREDICTED, now, now + U_TIME_1S_IN_NS, now);
+		CHECK(stats.horizon_bins[M_PREDICTION_STATS_BIN_COUNT - 1] == 1.0f);
+	}
+
+	SECTION("Period restarts after a second")
+	{
+		m_prediction_stats_add(&stats, M_PREDICTION_KIND_EXACT, now, now, now);
+		m_prediction_stats_add(&stats, M_PREDICTION_KIND_EXACT, now + U_TIME_1S_IN_NS, now, now);
+
+		CHECK(stats.counts[M_PREDICTION_KIND_EXACT] == 2);
+		CHECK(stats.period.counts[M_PREDICTION_KIND_EXACT] == 1);
+		CHECK(stats.period.start_ns == now + U_TIME_1S_IN_NS);
+	}
+}
+
+TEST_CASE("m_prediction_stats telemetry")
+{
+	m_prediction_stats stats;
+	m_prediction_stats_init(&stats, "test");
+
+	std::unique_ptr<u_telemetry_ring> ring{new u_telemetry_ring()};
+	u_telemetry_init(ring.get());
+
+	const int64_t now = (int64_t)10 * U_TIME_1S_IN_NS;
+	const int64_t period = M_PREDICTION_STATS_TELEMETRY_PERIOD_NS;
+
+	u_telemetry_entry entries[4];
+	uint64_t read_index = 0;
+
+	SECTION("Nothing gathered without subscribers")
+	{
+		m_prediction_stats_add(&stats, M_PREDICTION_KIND_EXACT, now, now, now);
+		m_prediction_stats_add(&stats, M_PREDICTION_KIND_EXACT, now + period, now, now);
+
+		CHECK(stats.telemetry_period.start_ns == 0);
+		CHECK(u_telemetry_ring_read(ring.get(), &read_index, entries, 4, NULL) == 0);
+	}
+
+	SECTION("Pushed every period")
+	{
+		u_telemetry_add_subscriber();
+
+		m_prediction_stats_add(&stats, M_PREDICTION_KIND_EXACT, now, now, now);
+		m_prediction_stats_add_sample(&stats);
+		m_prediction_stats_add(&stats, M_PREDICTION_KIND_PREDICTED, now + period / 2, now + period, now);
+		m_prediction_stats_add_sample(&stats);
+		CHECK(u_telemetry_ring_read(ring.get(), &read_index, entries, 4, NULL) == 0);
+
+		m_prediction_stats_add(&stats, M_PREDICTION_KIND_EXACT, now + period, now + period, now + period);
+
+		u_telemetry_remove_subscriber();
+
+		REQUIRE(u_telemetry_ring_read(ring.get(), &read_index, entries, 4, NULL) == 1);
+		CHECK(entries[0].type == U_TELEMETRY_TYPE_DEVICE_POSES);
+		CHECK(entries[0].when_ns == (uint64_t)(now + period));
+		CHECK(entries[0].device_poses.period_ns == (uint64_t)period);
+		CHECK(entries[0].device_poses.query_count == 2);
+		CHECK(entries[0].device_poses.predicted_count == 1);
+		CHECK(entries[0].device_poses.sample_count == 2);
+
+		// The query that ended the period starts the next one.
+		CHECK(stats.telemetry_period.counts[M_PREDICTION_KIND_EXACT] == 1);
+	}
+
+	u_telemetry_close();
+}
+
+TEST_CASE("m_relation_history stats")
+{
+	xrt_space_relation rel{};
+	rel.relation_flags = XRT_SPACE_RELATION_BITMASK_ALL;
+	rel.pose.orientation.w = 1.0f;
+
+	m_relation_history *rh = nullptr;
+	m_relation_history_create(&rh);
+	m_relation_history_push(rh, &rel, 1000);
+	m_relation_history_push(rh, &rel, 2000);
+
+	// Collecting must not change the results.
+	m_relation_history_enable_stats(rh, rh, "test");
+
+	xrt_space_relation out{};
+	CHECK(m_relation_history_get(rh, 2000, &out) == M_RELATION_HISTORY_RESULT_EXACT);
+	CHECK(m_relation_history_get(rh, 1500, &out) == M_RELATION_HISTORY_RESULT_INTERPOLATED);
+	CHECK(m_relation_history_get(rh, 3000, &out) == M_RELATION_HISTORY_RESULT_PREDICTED);
+	CHECK(m_relation_history_get(rh, 500, &out) == M_RELATION_HISTORY_RESULT_REVERSE_PREDICTED);
+	CHECK(m_relation_history_get(rh, 0, &out) == M_RELATION_HISTORY_RESULT_INVALID);
+
+	m_relation_history_destroy(&rh);
+	CHECK(rh == nullptr);
+}
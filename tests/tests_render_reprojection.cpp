@@ -0,0 +1,193 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Testing the depth reprojection helpers.
+ * @author agent <agent@local>
+ */
+
+#include "catch/catch.hpp"
+
+#include "math/m_api.h"
+#include "math/m_mathinclude.h"
+#include "render/render_interface.h"
+
+#include <cstddef>
+
+
+#define QUARTER_PI (M_PI / 4)
+#define MARGIN (0.0001)
+
+static struct xrt_fov
+fov_45()
+{
+	struct xrt_fov fov = XRT_STRUCT_INIT;
+	fov.angle_down = -QUARTER_PI;
+	fov.angle_up = QUARTER_PI;
+	fov.angle_left = -QUARTER_PI;
+	fov.angle_right = QUARTER_PI;
+	return fov;
+}
+
+static struct xrt_vec3
+transform(const struct xrt_matrix_4x4 &m, const struct xrt_vec3 &p)
+{
+	// Column major, divide by w to get normalized device coords.
+	float x = m.v[0] * p.x + m.v[4] * p.y + m.v[8] * p.z + m.v[12];
+	float y = m.v[1] * p.x + m.v[5] * p.y + m.v[9] * p.z + m.v[13];
+	float w = m.v[3] * p.x + m.v[7] * p.y + m.v[11] * p.z + m.v[15];
+
+	struct xrt_vec3 result = {x / w, y / w, w};
+	return result;
+}
+
+static float
+inv_z(float offset, float scale, float depth)
+{
+	return offset + scale * depth;
+}
+
+
+TEST_CASE("render_calc_inverse_depth_params")
+{
+	float offset = 0.0f;
+	float scale = 0.0f;
+
+	SECTION("normal")
+	{
+		REQUIRE(render_calc_inverse_depth_params(0.0f, 1.0f, 0.1f, 100.0f, &offset, &scale));
+		CHECK_THAT(inv_z(offset, scale, 0.0f), Catch::WithinAbs(1.0 / 0.1, MARGIN));
+		CHECK_THAT(inv_z(offset, scale, 1.0f), Catch::WithinAbs(1.0 / 100.0, MARGIN));
+	}
+
+	SECTION("sub_range")
+	{
+		REQUIRE(render_calc_inverse_depth_params(0.25f, 0.75f, 1.0f, 2.0f, &offset, &scale));
+		CHECK_THAT(inv_z(offset, scale, 0.25f), Catch::WithinAbs(1.0, MARGIN));
+		CHECK_THAT(inv_z(offset, scale, 0.75f), Catch::WithinAbs(0.5, MARGIN));
+	}
+
+	SECTION("reversed")
+	{
+		REQUIRE(render_calc_inverse_depth_params(0.0f, 1.0f, 100.0f, 0.1f, &offset, &scale));
+		CHECK_THAT(inv_z(offset, scale, 0.0f), Catch::WithinAbs(1.0 / 100.0, MARGIN));
+		CHECK_THAT(inv_z(offset, scale, 1.0f), Catch::WithinAbs(1.0 / 0.1, MARGIN));
+	}
+
+	SECTION("infinite_far")
+	{
+		REQUIRE(render_calc_inverse_depth_params(0.0f, 1.0f, 0.1f, INFINITY, &offset, &scale));
+		CHECK_THAT(inv_z(offset, scale, 0.0f), Catch::WithinAbs(1.0 / 0.1, MARGIN));
+		CHECK_THAT(inv_z(offset, scale, 1.0f), Catch::WithinAbs(0.0, MARGIN));
+	}
+
+	SECTION("invalid")
+	{
+		CHECK_FALSE(render_calc_inverse_depth_params(1.0f, 1.0f, 0.1f, 100.0f, &offset, &scale));
+		CHECK_FALSE(render_calc_inverse_depth_params(1.0f, 0.0f, 0.1f, 100.0f, &offset, &scale));
+		CHECK_FALSE(render_calc_inverse_depth_params(0.0f, 1.0f, 0.0f, 100.0f, &offset, &scale));
+		CHECK_FALSE(render_calc_inverse_depth_params(0.0f, 1.0f, 0.1f, -1.0f, &offset, &scale));
+		CHECK_FALSE(render_calc_inverse_depth_params(0.0f, 1.0f, 1.0f, 1.0f, &offset, &scale));
+		CHECK_FALSE(render_calc_inverse_depth_params(0.0f, 1.0f, NAN, 100.0f, &offset, &scale));
+	}
+}
+
+TEST_CASE("render_calc_reprojection_matrix")
+{
+	struct xrt_fov fov = fov_45();
+	struct xrt_matrix_4x4 reproj;
+
+	SECTION("no_translation_matches_timewarp")
+	{
+		// Same position, rotated a bit.
+		struct xrt_pose src_pose = XRT_POSE_IDENTITY;
+		struct xrt_pose new_pose = XRT_POSE_IDENTITY;
+		src_pose.position = {1.0f, 2.0f, 3.0f};
+		new_pose.position = src_pose.position;
+		struct xrt_vec3 axis = {0.0f, 1.0f, 0.0f};
+		math_quat_from_angle_vector(0.1f, &axis, &new_pose.orientation);
+
+		struct xrt_matrix_4x4 warp;
+		render_calc_time_warp_matrix(&src_pose, &fov, &new_pose, &warp);
+		render_calc_reprojection_matrix(&src_pose, &fov, &new_pose, &reproj);
+
+		// Any depth along the ray lands on the same spot as timewarp.
+		const struct xrt_vec3 ray = {0.3f, -0.2f, -1.0f};
+		const struct xrt_vec3 expected = transform(warp, ray);
+		for (float z : {0.5f, 2.0f, 100.0f}) {
+			CAPTURE(z);
+			struct xrt_vec3 point = {ray.x * z, ray.y * z, ray.z * z};
+			struct xrt_vec3 result = transform(reproj, point);
+			CHECK_THAT(result.x, Catch::WithinAbs(expected.x, MARGIN));
+			CHECK_THAT(result.y, Catch::WithinAbs(expected.y, MARGIN));
+		}
+	}
+
+	SECTION("translation")
+	{
+		// Moved one meter to the right since the frame was rendered.
+		struct xrt_pose src_pose = XRT_POSE_IDENTITY;
+		struct xrt_pose new_pose = XRT_POSE_IDENTITY;
+		new_pose.position.x = 1.0f;
+
+		render_calc_reprojection_matrix(&src_pose, &fov, &new_pose, &reproj);
+
+		// Straight ahead of the new view at 2m, was 1m to the right in the source view.
+		struct xrt_vec3 point = {0.0f, 0.0f, -2.0f};
+		struct xrt_vec3 result = transform(reproj, point);
+		CHECK_THAT(result.x, Catch::WithinAbs(0.5, MARGIN));
+		CHECK_THAT(result.y, Catch::WithinAbs(0.0, MARGIN));
+
+		// Far away points barely move.
+		point.z = -10000.0f;
+		result = transform(reproj, point);
+		CHECK_THAT(result.x, Catch::WithinAbs(0.0, 0.001));
+	}
+}
+
+TEST_CASE("render_compute_layer_ubo_data")
+{
+	/*
+	 * Must match the std140 Config block in layer.comp, member by member.
+	 * Arrays of scalars and vectors are padded to a 16 byte stride in
+	 * std140, and mat4 is four vec4 columns.
+	 */
+	using Ubo = struct render_compute_layer_ubo_data;
+	constexpr size_t N = RENDER_MAX_LAYERS;
+	constexpr size_t vec4 = 16;
+	constexpr size_t mat4 = 64;
+
+	size_t offset = 0;
+
+#define CHECK_MEMBER(MEMBER, SIZE)                                                                                     \
+	do {                                                                                                           \
+		INFO(#MEMBER);                                                                                         \
+		CHECK(offsetof(Ubo, MEMBER) == offset);                                                                \
+		CHECK(sizeof(Ubo::MEMBER) == (SIZE));                                                                  \
+		offset += (SIZE);                                                                                      \
+	} while (false)
+
+	CHECK_MEMBER(view, vec4);                       // ivec4
+	CHECK_MEMBER(layer_count, vec4);                // ivec4
+	CHECK_MEMBER(pre_transform, vec4);              // vec4
+	CHECK_MEMBER(post_transforms, vec4 * N);        // vec4[]
+	CHECK_MEMBER(layer_type, vec4 * N);             // uvec2[]
+	CHECK_MEMBER(images_samplers, vec4 * N);        // ivec2[]
+	CHECK_MEMBER(transforms, mat4 * N);             // mat4[]
+	CHECK_MEMBER(reprojections, mat4 * N);          // mat4[]
+	CHECK_MEMBER(depth_post_transforms, vec4 * N);  // vec4[]
+	CHECK_MEMBER(depth, vec4 * N);                  // vec4[]
+	CHECK_MEMBER(quad_position, vec4 * N);          // vec4[]
+	CHECK_MEMBER(quad_normal, vec4 * N);            // vec4[]
+	CHECK_MEMBER(inverse_quad_transform, mat4 * N); // mat4[]
+	CHECK_MEMBER(quad_extent, vec4 * N);            // vec2[]
+
+#undef CHECK_MEMBER
+
+	CHECK(sizeof(Ubo) == offset);
+
+	// The shader reads the inverse depth params and the enable flag from x, y and z.
+	CHECK(offsetof(Ubo, depth[0].inv_z_offset) == offsetof(Ubo, depth));
+	CHECK(offsetof(Ubo, depth[0].inv_z_scale) == offsetof(Ubo, depth) + 4);
+	CHECK(offsetof(Ubo, depth[0].enabled) == offsetof(Ubo, depth) + 8);
+}
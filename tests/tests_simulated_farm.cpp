@@ -0,0 +1,95 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Load a small simulated farm config and check the created devices.
+ * @author agent <agent@local>
+ */
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_system.h"
+
+#include "util/u_json.h"
+#include "util/u_system_helpers.h"
+
+#include "simulated/simulated_interface.h"
+
+#include "catch/catch.hpp"
+
+
+static const char *config_str = R"({
+	"hmd": false,
+	"groups": [
+		{ "type": "tracker", "count": 3, "rate_hz": 100 },
+		{ "type": "controller", "count": 2 },
+		{ "type": "hand", "count": 2 },
+		{ "type": "unknown", "count": 5 }
+	]
+})";
+
+
+TEST_CASE("simulated_farm")
+{
+	cJSON *json = cJSON_Parse(config_str);
+	REQUIRE(json != NULL);
+
+	struct simulated_farm_config config;
+	REQUIRE(simulated_farm_config_parse(json, &config));
+	cJSON_Delete(json);
+
+	SECTION("Parse")
+	{
+		// The unknown group is skipped.
+		CHECK_FALSE(config.hmd);
+		CHECK(config.group_count == 3);
+		CHECK(config.groups[0].rate_hz == 100);
+		CHECK(config.groups[1].rate_hz == 250);
+		CHECK(simulated_farm_config_count(&config, SIMULATED_FARM_KIND_TRACKER) == 3);
+		CHECK(simulated_farm_config_count(&config, SIMULATED_FARM_KIND_CONTROLLER) == 2);
+		CHECK(simulated_farm_config_count(&config, SIMULATED_FARM_KIND_HAND) == 2);
+	}
+
+	SECTION("Devices and roles")
+	{
+		struct u_system_devices *usysd = u_system_devices_allocate();
+		struct xrt_system_devices *xsysd = &usysd->base;
+
+		uint32_t max = ARRAY_SIZE(xsysd->xdevs);
+		uint32_t count = simulated_farm_create(&config, &usysd->origin, xsysd->xdevs, max);
+		xsysd->xdev_count = count;
+		REQUIRE(count == 7);
+
+		simulated_farm_setup_roles(xsysd);
+
+		CHECK(xsysd->roles.head == NULL);
+		REQUIRE(xsysd->roles.left != NULL);
+		REQUIRE(xsysd->roles.right != NULL);
+		CHECK(xsysd->roles.left != xsysd->roles.right);
+		CHECK(xsysd->roles.left->device_type == XRT_DEVICE_TYPE_ANY_HAND_CONTROLLER);
+		CHECK(xsysd->roles.right->device_type == XRT_DEVICE_TYPE_ANY_HAND_CONTROLLER);
+
+		REQUIRE(xsysd->roles.hand_tracking.left != NULL);
+		REQUIRE(xsysd->roles.hand_tracking.right != NULL);
+		CHECK(xsysd->roles.hand_tracking.left->inputs[0].name == XRT_INPUT_GENERIC_HAND_TRACKING_LEFT);
+		CHECK(xsysd->roles.hand_tracking.right->inputs[0].name == XRT_INPUT_GENERIC_HAND_TRACKING_RIGHT);
+
+		xrt_system_devices_destroy(&xsysd);
+	}
+
+	SECTION("Capped")
+	{
+		struct u_system_devices *usysd = u_system_devices_allocate();
+		struct xrt_system_devices *xsysd = &usysd->base;
+
+		// Stops in the first group, nothing from the later groups.
+		uint32_t count = simulated_farm_create(&config, &usysd->origin, xsysd->xdevs, 2);
+		xsysd->xdev_count = count;
+		CHECK(count == 2);
+
+		simulated_farm_setup_roles(xsysd);
+		CHECK(xsysd->roles.left == NULL);
+		CHECK(xsysd->roles.hand_tracking.left == NULL);
+
+		xrt_system_devices_destroy(&xsysd);
+	}
+}
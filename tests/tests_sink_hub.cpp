@@ -0,0 +1,124 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Test the camera fan out sink hub.
+ * @author agent <agent@local>
+ */
+
+#include "util/u_sink.h"
+#include "util/u_frame.h"
+
+#include "catch/catch.hpp"
+
+#include <vector>
+
+
+namespace {
+
+//! Keeps a reference to every frame pushed to it.
+struct Recorder
+{
+	xrt_frame_sink base = {};
+	std::vector<xrt_frame *> frames;
+
+	Recorder()
+	{
+		base.push_frame = [](xrt_frame_sink *xfs, xrt_frame *xf) {
+			Recorder *r = reinterpret_cast<Recorder *>(xfs);
+			xrt_frame *ref = nullptr;
+			xrt_frame_reference(&ref, xf);
+			r->frames.push_back(ref);
+		};
+	}
+
+	~Recorder()
+	{
+		for (xrt_frame *&xf : frames) {
+			xrt_frame_reference(&xf, nullptr);
+		}
+	}
+};
+
+} // namespace
+
+
+TEST_CASE("u_sink_hub")
+{
+	xrt_frame_context xfctx = {};
+	u_sink_hub *hub = nullptr;
+	xrt_frame_sink *sink = nullptr;
+	u_sink_hub_create(&xfctx, &hub, &sink);
+	REQUIRE(hub != nullptr);
+	REQUIRE(sink != nullptr);
+
+	xrt_frame *xf = nullptr;
+	u_frame_create_one_off(XRT_FORMAT_L8, 8, 5, &xf);
+	for (uint32_t y = 0; y < xf->height; y++) {
+		for (uint32_t x = 0; x < xf->width; x++) {
+			xf->data[y * xf->stride + x] = (uint8_t)(y * 40 + x * 4);
+		}
+	}
+
+	Recorder raw_a;
+	Recorder raw_b;
+	Recorder l8;
+	Recorder half_a;
+	Recorder half_b;
+	Recorder quarter;
+	Recorder rgb;
+
+	SECTION("Consumers share frames")
+	{
+		REQUIRE(u_sink_hub_add(hub, &raw_a.base));
+		REQUIRE(u_sink_hub_add(hub, &raw_b.base));
+		REQUIRE(u_sink_hub_add_derived(hub, XRT_FORMAT_L8, 0, &l8.base));
+		REQUIRE(u_sink_hub_add_derived(hub, XRT_FORMAT_L8, 1, &half_a.base));
+		REQUIRE(u_sink_hub_add_derived(hub, XRT_FORMAT_L8, 2, &quarter.base));
+		REQUIRE(u_sink_hub_add_derived(hub, XRT_FORMAT_L8, 1, &half_b.base));
+		REQUIRE(u_sink_hub_add_derived(hub, XRT_FORMAT_R8G8B8, 0, &rgb.base));
+
+		xf->timestamp = 1234;
+		xrt_sink_push_frame(sink, xf);
+
+		REQUIRE(raw_a.frames.size() == 1);
+		REQUIRE(raw_b.frames.size() == 1);
+		REQUIRE(l8.frames.size() == 1);
+		REQUIRE(half_a.frames.size() == 1);
+		REQUIRE(half_b.frames.size() == 1);
+		REQUIRE(quarter.frames.size() == 1);
+		REQUIRE(rgb.frames.size() == 1);
+
+		// Already L8, so no copy.
+		CHECK(raw_a.frames[0] == xf);
+		CHECK(raw_b.frames[0] == xf);
+		CHECK(l8.frames[0] == xf);
+
+		// Made once and shared.
+		CHECK(half_a.frames[0] == half_b.frames[0]);
+		CHECK(half_a.frames[0]->width == 4);
+		CHECK(half_a.frames[0]->height == 2);
+		CHECK(half_a.frames[0]->timestamp == 1234);
+		CHECK(quarter.frames[0]->width == 2);
+		CHECK(quarter.frames[0]->height == 1);
+
+		// Average of the 2x2 block.
+		xrt_frame *half = half_a.frames[0];
+		CHECK(half->data[0] == (0 + 4 + 40 + 44 + 2) / 4);
+		CHECK(half->data[half->stride + 1] == (88 + 92 + 128 + 132 + 2) / 4);
+
+		CHECK(rgb.frames[0]->format == XRT_FORMAT_R8G8B8);
+		CHECK(rgb.frames[0]->data[3 * 3 + 1] == xf->data[3]);
+
+		// Only the consumers hold the derived frames now.
+		CHECK(half->reference.count == 2);
+	}
+
+	SECTION("Unsupported format")
+	{
+		CHECK_FALSE(u_sink_hub_add_derived(hub, XRT_FORMAT_YUYV422, 0, &l8.base));
+	}
+
+	xrt_frame_reference(&xf, nullptr);
+	xrt_frame_context_destroy_nodes(&xfctx);
+}
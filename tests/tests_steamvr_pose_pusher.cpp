@@ -0,0 +1,307 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief SteamVR driver pose pusher tests.
+ * @author agent <agent@local>
+ */
+
+#include "ovrd_pose_pusher.hpp"
+
+#include "os/os_time.h"
+#include "util/u_time.h"
+
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+//! Records the pose updates, everything else does nothing.
+class StubServerDriverHost : public vr::IVRServerDriverHost
+{
+public:
+	struct Update
+	{
+		uint32_t index;
+		double poseTimeOffset;
+		double x;
+	};
+
+	std::mutex mutex;
+	std::vector<Update> updates;
+
+	bool
+	TrackedDeviceAdded(const char *, vr::ETrackedDeviceClass, vr::ITrackedDeviceServerDriver *) override
+	{
+		return true;
+	}
+
+	void
+	TrackedDevicePoseUpdated(uint32_t unWhichDevice, const vr::DriverPose_t &newPose, uint32_t) override
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		updates.push_back({unWhichDevice, newPose.poseTimeOffset, newPose.vecPosition[0]});
+	}
+
+	void
+	VsyncEvent(double) override
+	{}
+
+	void
+	VendorSpecificEvent(uint32_t, vr::EVREventType, const vr::VREvent_Data_t &, double) override
+	{}
+
+	bool
+	IsExiting() override
+	{
+		return false;
+	}
+
+	bool
+	PollNextEvent(vr::VREvent_t *, uint32_t) override
+	{
+		return false;
+	}
+
+	void
+	GetRawTrackedDevicePoses(float, vr::TrackedDevicePose_t *, uint32_t) override
+	{}
+
+	void
+	RequestRestart(const char *, const char *, const char *, const char *) override
+	{}
+
+	uint32_t
+	GetFrameTimings(vr::Compositor_FrameTiming *, uint32_t) override
+	{
+		return 0;
+	}
+
+	void
+	SetDisplayEyeToHead(uint32_t, const vr::HmdMatrix34_t &, const vr::HmdMatrix34_t &) override
+	{}
+
+	void
+	SetDisplayProjectionRaw(uint32_t, const vr::HmdRect2_t &, const vr::HmdRect2_t &) override
+	{}
+
+	void
+	SetRecommendedRenderTargetSize(uint32_t, uint32_t, uint32_t) override
+	{}
+
+	size_t
+	count()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		return updates.size();
+	}
+};
+
+//! Returns the time it was asked to predict to in the x position.
+class StubPoseSource : public IPoseSource_Monado
+{
+public:
+	explicit StubPoseSource(vr::TrackedDeviceIndex_t index) : index(index) {}
+
+	vr::TrackedDeviceIndex_t index;
+
+	vr::TrackedDeviceIndex_t
+	GetPoseSourceIndex() override
+	{
+		return index;
+	}
+
+	vr::DriverPose_t
+	GetPoseAt(int64_t at_ns) override
+	{
+		vr::DriverPose_t pose = {};
+		pose.poseIsValid = true;
+		pose.vecPosition[0] = (double)at_ns;
+		return pose;
+	}
+};
+
+//! Calls back into the pusher while it is being queried.
+class ReentrantPoseSource : public StubPoseSource
+{
+public:
+	ReentrantPoseSource(vr::TrackedDeviceIndex_t index, CPosePusher_Monado &pusher)
+	    : StubPoseSource(index), pusher(pusher)
+	{}
+
+	CPosePusher_Monado &pusher;
+
+	vr::DriverPose_t
+	GetPoseAt(int64_t at_ns) override
+	{
+		pusher.Vsync(at_ns);
+		pusher.AddSource(this);
+		return StubPoseSource::GetPoseAt(at_ns);
+	}
+};
+
+//! Removes itself from the pusher the first time it is queried.
+class SelfRemovingPoseSource : public StubPoseSource
+{
+public:
+	SelfRemovingPoseSource(vr::TrackedDeviceIndex_t index, CPosePusher_Monado &pusher)
+	    : StubPoseSource(index), pusher(pusher)
+	{}
+
+	CPosePusher_Monado &pusher;
+	int calls = 0;
+
+	vr::DriverPose_t
+	GetPoseAt(int64_t at_ns) override
+	{
+		calls++;
+		pusher.RemoveSource(this);
+		return StubPoseSource::GetPoseAt(at_ns);
+	}
+};
+
+} // namespace
+
+
+TEST_CASE("PosePusher")
+{
+	StubServerDriverHost host;
+	StubPoseSource hmd(0);
+	StubPoseSource left(1);
+	StubPoseSource right(2);
+
+	SECTION("One pass pushes all sources with the same timestamp")
+	{
+		CPosePusher_Monado pusher(&host, U_TIME_1S_IN_NS / 90, 2);
+		pusher.AddSource(&hmd);
+		pusher.AddSource(&left);
+		pusher.AddSource(&right);
+		pusher.AddSource(&right); // Adding twice is a no-op.
+
+		pusher.PushAll();
+
+		REQUIRE(host.updates.size() == 3);
+		CHECK(host.updates[0].index == 0);
+		CHECK(host.updates[1].index == 1);
+		CHECK(host.updates[2].index == 2);
+		CHECK(host.updates[0].x == host.updates[1].x);
+		CHECK(host.updates[0].x == host.updates[2].x);
+		CHECK(host.updates[0].poseTimeOffset == 0.0);
+		CHECK(pusher.GetPassCount() == 1);
+	}
+
+	SECTION("Inactive and removed sources are skipped")
+	{
+		CPosePusher_Monado pusher(&host, U_TIME_1S_IN_NS / 90, 2);
+		StubPoseSource inactive(vr::k_unTrackedDeviceIndexInvalid);
+		pusher.AddSource(&hmd);
+		pusher.AddSource(&inactive);
+		pusher.AddSource(&left);
+		pusher.RemoveSource(&left);
+
+		pusher.PushAll();
+
+		REQUIRE(host.updates.size() == 1);
+		CHECK(host.updates[0].index == 0);
+	}
+
+	SECTION("Period is a fraction of the frame interval")
+	{
+		CPosePusher_Monado pusher(&host, U_TIME_1S_IN_NS / 100, 4);
+		CHECK(pusher.GetPeriod() == U_TIME_1S_IN_NS / 400);
+
+		// Zero updates per frame is treated as one.
+		CPosePusher_Monado once(&host, U_TIME_1S_IN_NS / 100, 0);
+		CHECK(once.GetPeriod() == U_TIME_1S_IN_NS / 100);
+	}
+
+	SECTION("Thread runs at the configured rate")
+	{
+		// 100 Hz display, 2 updates per frame: one pass every 5ms.
+		CPosePusher_Monado pusher(&host, U_TIME_1S_IN_NS / 100, 2);
+		pusher.AddSource(&hmd);
+		pusher.Start();
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+		pusher.Stop();
+
+		// Generous bounds, CI machines can be slow.
+		uint64_t passes = pusher.GetPassCount();
+		CHECK(passes >= 5);
+		CHECK(passes <= 25);
+		CHECK(host.count() == passes);
+	}
+
+	SECTION("Notify and Vsync wake the thread")
+	{
+		// Very long period so only wake ups cause passes.
+		CPosePusher_Monado pusher(&host, (int64_t)10 * U_TIME_1S_IN_NS, 1);
+		pusher.AddSource(&hmd);
+		pusher.Start();
+
+		pusher.Notify();
+		for (int i = 0; i < 1000 && pusher.GetPassCount() < 1; i++) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		CHECK(pusher.GetPassCount() == 1);
+
+		pusher.Vsync(os_monotonic_get_ns());
+		for (int i = 0; i < 1000 && pusher.GetPassCount() < 2; i++) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		CHECK(pusher.GetPassCount() == 2);
+
+		pusher.Stop();
+		CHECK(host.count() == 2);
+	}
+
+	SECTION("Sources can call into the pusher")
+	{
+		CPosePusher_Monado pusher(&host, (int64_t)10 * U_TIME_1S_IN_NS, 1);
+		ReentrantPoseSource reentrant(3, pusher);
+		pusher.AddSource(&reentrant);
+
+		pusher.PushAll();
+
+		CHECK(pusher.GetPassCount() == 1);
+		CHECK(host.count() == 1);
+
+		pusher.RemoveSource(&reentrant);
+	}
+
+	SECTION("Sources can remove themselves")
+	{
+		CPosePusher_Monado pusher(&host, (int64_t)10 * U_TIME_1S_IN_NS, 1);
+		SelfRemovingPoseSource removing(3, pusher);
+		pusher.AddSource(&removing);
+		pusher.AddSource(&hmd);
+
+		pusher.PushAll();
+
+		// Its own pose is dropped, the other sources are still pushed.
+		CHECK(removing.calls == 1);
+		REQUIRE(host.count() == 1);
+		CHECK(host.updates[0].index == 0);
+
+		pusher.PushAll();
+		CHECK(removing.calls == 1);
+		CHECK(host.count() == 2);
+
+		// Same on the thread.
+		pusher.AddSource(&removing);
+		pusher.Start();
+		pusher.Notify();
+		for (int i = 0; i < 1000 && pusher.GetPassCount() < 3; i++) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		pusher.Stop();
+		CHECK(pusher.GetPassCount() == 3);
+		CHECK(removing.calls == 2);
+	}
+}
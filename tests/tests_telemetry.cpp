@@ -0,0 +1,268 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief  Test the telemetry ring.
+ * @author agent <agent@local>
+ */
+
+#include "util/u_metrics.h"
+#include "util/u_telemetry.h"
+
+#include "catch/catch.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+struct Ring
+{
+	std::unique_ptr<u_telemetry_ring> ring{new u_telemetry_ring()};
+
+	Ring()
+	{
+		u_telemetry_init(ring.get());
+		u_telemetry_add_subscriber();
+	}
+
+	~Ring()
+	{
+		u_telemetry_remove_subscriber();
+		u_telemetry_close();
+	}
+
+	u_telemetry_ring *
+	get()
+	{
+		return ring.get();
+	}
+};
+
+u_telemetry_entry
+make_frame(int64_t frame_id)
+{
+	u_telemetry_entry entry = {};
+	entry.type = U_TELEMETRY_TYPE_COMPOSITOR_FRAME;
+	entry.when_ns = (uint64_t)frame_id * 10;
+	entry.compositor_frame.frame_id = frame_id;
+	entry.compositor_frame.predicted_display_time_ns = (uint64_t)frame_id * 2;
+	return entry;
+}
+
+void
+push_frames(u_telemetry_ring *ring, int64_t first, int64_t count)
+{
+	for (int64_t i = first; i < first + count; i++) {
+		u_telemetry_entry entry = make_frame(i);
+		u_telemetry_ring_push(ring, &entry);
+	}
+}
+
+} // namespace
+
+
+TEST_CASE("u_telemetry_ring")
+{
+	Ring r;
+	std::vector<u_telemetry_entry> entries(U_TELEMETRY_ENTRY_COUNT);
+	uint64_t read_index = 0;
+	uint64_t dropped = 0;
+
+	CHECK(u_telemetry_is_active());
+	CHECK(u_telemetry_ring_is_valid(r.get()));
+	CHECK(u_telemetry_ring_get_write_index(r.get()) == 0);
+
+	SECTION("empty")
+	{
+		CHECK(u_telemetry_ring_read(r.get(), &read_index, entries.data(), 16, &dropped) == 0);
+		CHECK(read_index == 0);
+		CHECK(dropped == 0);
+	}
+
+	SECTION("push_and_read")
+	{
+		u_telemetry_compositor_frame frame = {};
+		frame.frame_id = 42;
+		frame.actual_present_time_ns = 1234;
+		u_telemetry_push_compositor_frame(99, &frame);
+
+		u_telemetry_device_poses poses = {};
+		snprintf(poses.device_name, sizeof(poses.device_name), "HMD");
+		poses.sample_count = 1000;
+		u_telemetry_push_device_poses(100, &poses);
+
+		REQUIRE(u_telemetry_ring_read(r.get(), &read_index, entries.data(), 16, &dropped) == 2);
+		CHECK(read_index == 2);
+		CHECK(dropped == 0);
+
+		CHECK(entries[0].type == U_TELEMETRY_TYPE_COMPOSITOR_FRAME);
+		CHECK(entries[0].when_ns == 99);
+		CHECK(entries[0].compositor_frame.frame_id == 42);
+		CHECK(entries[0].compositor_frame.actual_present_time_ns == 1234);
+
+		CHECK(entries[1].type == U_TELEMETRY_TYPE_DEVICE_POSES);
+		CHECK(entries[1].when_ns == 100);
+		CHECK(std::string(entries[1].device_poses.device_name) == "HMD");
+		CHECK(entries[1].device_poses.sample_count == 1000);
+
+		// Nothing new.
+		CHECK(u_telemetry_ring_read(r.get(), &read_index, entries.data(), 16, &dropped) == 0);
+	}
+
+	SECTION("capacity")
+	{
+		push_frames(r.get(), 0, 20);
+
+		int64_t expected = 0;
+		uint32_t count = 0;
+		while ((count = u_telemetry_ring_read(r.get(), &read_index, entries.data(), 7, &dropped)) > 0) {
+			CHECK(count <= 7);
+			for (uint32_t i = 0; i < count; i++) {
+				CHECK(entries[i].compositor_frame.frame_id == expected++);
+			}
+		}
+
+		CHECK(expected == 20);
+		CHECK(dropped == 0);
+	}
+
+	SECTION("overwritten")
+	{
+		const int64_t extra = 10;
+		push_frames(r.get(), 0, U_TELEMETRY_ENTRY_COUNT + extra);
+
+		uint32_t count = u_telemetry_ring_read(r.get(), &read_index, entries.data(), U_TELEMETRY_ENTRY_COUNT,
+		                                       &dropped);
+
+		CHECK(count == U_TELEMETRY_ENTRY_COUNT);
+		CHECK(dropped == (uint64_t)extra);
+		CHECK(entries[0].compositor_frame.frame_id == extra);
+		CHECK(entries[count - 1].compositor_frame.frame_id == U_TELEMETRY_ENTRY_COUNT + extra - 1);
+	}
+
+	SECTION("in_progress")
+	{
+		push_frames(r.get(), 0, 1);
+
+		// Claimed by a writer that hasn't finished yet.
+		r.get()->write_index = 2;
+		r.get()->entries[1].seq = 3;
+
+		CHECK(u_telemetry_ring_read(r.get(), &read_index, entries.data(), 16, &dropped) == 1);
+		CHECK(read_index == 1);
+
+		// The writer finishes.
+		u_telemetry_entry entry = make_frame(1);
+		memcpy(&r.get()->entries[1].type, &entry.type, sizeof(entry) - offsetof(u_telemetry_entry, type));
+		r.get()->entries[1].seq = 4;
+
+		REQUIRE(u_telemetry_ring_read(r.get(), &read_index, entries.data(), 16, &dropped) == 1);
+		CHECK(entries[0].compositor_frame.frame_id == 1);
+		CHECK(dropped == 0);
+	}
+
+	SECTION("closed")
+	{
+		u_telemetry_close();
+		CHECK_FALSE(u_telemetry_is_active());
+
+		u_telemetry_compositor_frame frame = {};
+		u_telemetry_push_compositor_frame(1, &frame);
+		CHECK(u_telemetry_ring_get_write_index(r.get()) == 0);
+	}
+
+	SECTION("no_subscribers")
+	{
+		u_telemetry_remove_subscriber();
+		CHECK_FALSE(u_telemetry_is_active());
+
+		u_telemetry_compositor_frame frame = {};
+		u_telemetry_push_compositor_frame(1, &frame);
+		CHECK(u_telemetry_ring_get_write_index(r.get()) == 0);
+
+		u_telemetry_add_subscriber();
+		CHECK(u_telemetry_is_active());
+	}
+}
+
+TEST_CASE("u_telemetry_threads")
+{
+	Ring r;
+
+	const int64_t thread_count = 4;
+	const int64_t per_thread = 20000;
+	std::atomic<int> done{0};
+
+	std::vector<std::thread> writers;
+	for (int64_t t = 0; t < thread_count; t++) {
+		writers.emplace_back([&, t] {
+			push_frames(r.get(), t * per_thread, per_thread);
+			done++;
+		});
+	}
+
+	std::vector<u_telemetry_entry> entries(256);
+	uint64_t read_index = 0;
+	uint64_t total_read = 0;
+	uint64_t total_dropped = 0;
+	bool all_valid = true;
+
+	// Keep reading until the writers are done and the ring is drained.
+	while (true) {
+		bool writers_done = done.load() == thread_count;
+
+		uint64_t dropped = 0;
+		uint32_t count = u_telemetry_ring_read(r.get(), &read_index, entries.data(), 256, &dropped);
+		total_dropped += dropped;
+		total_read += count;
+
+		for (uint32_t i = 0; i < count; i++) {
+			const u_telemetry_compositor_frame &f = entries[i].compositor_frame;
+			all_valid = all_valid && entries[i].when_ns == (uint64_t)f.frame_id * 10 &&
+			            f.predicted_display_time_ns == (uint64_t)f.frame_id * 2;
+		}
+
+		if (writers_done && count == 0 && dropped == 0) {
+			break;
+		}
+	}
+
+	for (std::thread &t : writers) {
+		t.join();
+	}
+
+	// Torn entries are never returned.
+	CHECK(all_valid);
+	CHECK(total_read + total_dropped == (uint64_t)(thread_count * per_thread));
+}
+
+TEST_CASE("u_telemetry_metrics")
+{
+	Ring r;
+
+	// The metrics functions also feed the telemetry.
+	CHECK(u_metrics_is_active());
+
+	u_metrics_session_frame umsf = {};
+	umsf.session_id = 3;
+	umsf.frame_id = 7;
+	umsf.when_gpu_done_ns = 1000;
+	umsf.discarded = true;
+	u_metrics_write_session_frame(&umsf);
+
+	u_telemetry_entry entries[4];
+	uint64_t read_index = 0;
+	REQUIRE(u_telemetry_ring_read(r.get(), &read_index, entries, 4, NULL) == 1);
+
+	CHECK(entries[0].type == U_TELEMETRY_TYPE_CLIENT_FRAME);
+	CHECK(entries[0].client_frame.session_id == 3);
+	CHECK(entries[0].client_frame.frame_id == 7);
+	CHECK(entries[0].client_frame.when_gpu_done_ns == 1000);
+	CHECK(entries[0].client_frame.discarded == 1);
+}
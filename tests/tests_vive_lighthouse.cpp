@@ -0,0 +1,329 @@
+// Copyright 2026, Monado contributors
+// SPDX-License-Identifier: BSL-1.0
+/*!
+ * @file
+ * @brief Test and benchmark the batched lighthouse pulse decoder.
+ * @author agent <agent@local>
+ */
+
+#include "vive/vive_lighthouse.h"
+#include "vive/vive_protocol.h"
+
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+namespace {
+
+using Report = std::vector<uint8_t>;
+
+constexpr size_t kReportSize = sizeof(struct vive_headset_lighthouse_pulse_report);
+
+struct Pulse
+{
+	uint8_t id;
+	uint16_t duration;
+	uint32_t timestamp;
+};
+
+struct Generator
+{
+	uint32_t state = 0x1234567;
+
+	uint32_t
+	next(uint32_t max)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (state >> 8) % max;
+	}
+};
+
+/*!
+ * Pulses as seen by a headset with @p sensors sensors looking at two base
+ * stations in B/C mode, the bases take turns sweeping.
+ */
+std::vector<Pulse>
+make_pulses(uint32_t cycles, uint32_t sensors)
+{
+	std::vector<Pulse> pulses;
+	Generator gen;
+	uint32_t t = 1000000;
+
+	for (uint32_t c = 0; c < cycles; c++) {
+		for (uint32_t base = 0; base < 2; base++) {
+			uint32_t skip = (c % 2) != base;
+			uint32_t data = gen.next(2);
+			uint32_t rotor = (c / 2) % 2;
+			uint32_t code = skip * 4 + data * 2 + rotor;
+			uint16_t duration = (uint16_t)(2750 + code * 500 + 250);
+			uint32_t sync_t = t + base * 20000;
+
+			for (uint32_t s = 0; s < sensors; s++) {
+				pulses.push_back({(uint8_t)s, duration, sync_t + gen.next(40)});
+			}
+		}
+
+		// Nothing to sweep against until the sync has been seen.
+		for (uint32_t s = 0; s < sensors && c >= 2; s++) {
+			uint32_t offset = 60000 + s * (250000 / sensors) + gen.next(1000);
+			pulses.push_back({(uint8_t)s, (uint16_t)(100 + gen.next(300)), t + 20000 + offset});
+		}
+
+		t += 400000;
+	}
+
+	return pulses;
+}
+
+void
+put_pulse(Report &r, uint32_t slot, uint8_t id, uint16_t duration, uint32_t timestamp)
+{
+	uint8_t *p = r.data() + 1 + slot * 7;
+	p[0] = id;
+	p[1] = duration & 0xff;
+	p[2] = duration >> 8;
+	p[3] = timestamp & 0xff;
+	p[4] = (timestamp >> 8) & 0xff;
+	p[5] = (timestamp >> 16) & 0xff;
+	p[6] = timestamp >> 24;
+}
+
+//! Packs pulses into reports the way the headset does, with empty slots and now and then a camera timestamp.
+std::vector<Report>
+make_reports(const std::vector<Pulse> &pulses)
+{
+	std::vector<Report> reports;
+	Generator gen;
+	size_t i = 0;
+
+	while (i < pulses.size()) {
+		Report r(kReportSize, 0xff);
+		r[0] = VIVE_HEADSET_LIGHTHOUSE_PULSE_REPORT_ID;
+
+		uint32_t used = 1 + gen.next(9);
+		for (uint32_t slot = 0; slot < used && i < pulses.size(); slot++, i++) {
+			put_pulse(r, slot, pulses[i].id, pulses[i].duration, pulses[i].timestamp);
+		}
+
+		if (gen.next(8) == 0) {
+			put_pulse(r, 8, 0xfd, 0, pulses[i - 1].timestamp);
+		}
+
+		reports.push_back(r);
+	}
+
+	return reports;
+}
+
+//! Reports from a file recorded with VIVE_LIGHTHOUSE_RECORD, if set.
+std::vector<Report>
+load_recorded_reports()
+{
+	std::vector<Report> reports;
+	const char *path = getenv("VIVE_LIGHTHOUSE_REPLAY");
+	if (path == nullptr) {
+		return reports;
+	}
+
+	FILE *file = fopen(path, "rb");
+	if (file == nullptr) {
+		return reports;
+	}
+
+	Report r(kReportSize);
+	while (fread(r.data(), kReportSize, 1, file) == 1) {
+		reports.push_back(r);
+	}
+
+	fclose(file);
+
+	return reports;
+}
+
+//! The per pulse path, how the headset decoded reports before batching.
+void
+handle_report_per_pulse(lighthouse_watchman *watchman, const Report &r, std::vector<uint32_t> &camera_ticks)
+{
+	for (uint32_t i = 0; i < 9; i++) {
+		const uint8_t *p = r.data() + 1 + i * 7;
+		uint8_t id = p[0];
+		uint16_t duration = (uint16_t)(p[1] | (p[2] << 8));
+		uint32_t timestamp = p[3] | (p[4] << 8) | (p[5] << 16) | ((uint32_t)p[6] << 24);
+
+		if (id == 0xff || id == 0xfe || id == 0xfb) {
+			continue;
+		}
+		if (id == 0xfd) {
+			camera_ticks.push_back(timestamp);
+			continue;
+		}
+		if (id > 31) {
+			return;
+		}
+
+		lighthouse_watchman_handle_pulse(watchman, id, duration, timestamp);
+	}
+}
+
+void
+handle_reports_batched(lighthouse_watchman *watchman,
+                       const std::vector<Report> &reports,
+                       std::vector<uint32_t> &camera_ticks)
+{
+	lighthouse_pulse_batch batch;
+	lighthouse_pulse_batch_clear(&batch);
+
+	auto flush = [&]() {
+		camera_ticks.insert(camera_ticks.end(), batch.camera_ticks, batch.camera_ticks + batch.camera_tick_count);
+		lighthouse_watchman_handle_pulse_batch(watchman, &batch);
+		lighthouse_pulse_batch_clear(&batch);
+	};
+
+	for (const Report &r : reports) {
+		lighthouse_pulse_batch_add_report(&batch, r.data());
+		if (!lighthouse_pulse_batch_has_room(&batch)) {
+			flush();
+		}
+	}
+	flush();
+}
+
+void
+init_watchman(lighthouse_watchman *watchman)
+{
+	// Zero the padding too so the structs can be compared.
+	memset(watchman, 0, sizeof(*watchman));
+	lighthouse_watchman_init(watchman, "test");
+}
+
+} // namespace
+
+
+TEST_CASE("lighthouse_pulse_batch")
+{
+	lighthouse_pulse_batch batch;
+	lighthouse_pulse_batch_clear(&batch);
+
+	Report r(kReportSize, 0xff);
+	r[0] = VIVE_HEADSET_LIGHTHOUSE_PULSE_REPORT_ID;
+
+	SECTION("Empty slots are skipped")
+	{
+		put_pulse(r, 1, 3, 3000, 100);
+		put_pulse(r, 4, 31, 200, 0x12345678);
+		put_pulse(r, 6, 0xfd, 0, 555);
+
+		CHECK(lighthouse_pulse_batch_add_report(&batch, r.data()));
+		REQUIRE(batch.count == 2);
+		CHECK(batch.id[0] == 3);
+		CHECK(batch.duration[0] == 3000);
+		CHECK(batch.timestamp[0] == 100);
+		CHECK(batch.id[1] == 31);
+		CHECK(batch.timestamp[1] == 0x12345678);
+		REQUIRE(batch.camera_tick_count == 1);
+		CHECK(batch.camera_ticks[0] == 555);
+	}
+
+	SECTION("Unexpected id drops the rest of the report")
+	{
+		put_pulse(r, 0, 1, 3000, 100);
+		put_pulse(r, 1, 0x40, 3000, 100);
+		put_pulse(r, 2, 2, 3000, 100);
+
+		CHECK_FALSE(lighthouse_pulse_batch_add_report(&batch, r.data()));
+		REQUIRE(batch.count == 1);
+		CHECK(batch.id[0] == 1);
+	}
+
+	SECTION("Fills up")
+	{
+		for (uint32_t slot = 0; slot < 9; slot++) {
+			put_pulse(r, slot, (uint8_t)slot, 3000, 100 + slot);
+		}
+
+		uint32_t reports = 0;
+		while (lighthouse_pulse_batch_has_room(&batch)) {
+			lighthouse_pulse_batch_add_report(&batch, r.data());
+			reports++;
+		}
+		CHECK(reports == LIGHTHOUSE_PULSE_BATCH_MAX / 9);
+	}
+}
+
+TEST_CASE("lighthouse_watchman_handle_pulse_batch")
+{
+	const uint32_t sensors = GENERATE(5u, 32u);
+	CAPTURE(sensors);
+
+	std::vector<Report> reports = make_reports(make_pulses(200, sensors));
+
+	lighthouse_watchman single;
+	lighthouse_watchman batched;
+	init_watchman(&single);
+	init_watchman(&batched);
+
+	std::vector<uint32_t> single_ticks;
+	std::vector<uint32_t> batched_ticks;
+
+	for (const Report &r : reports) {
+		handle_report_per_pulse(&single, r, single_ticks);
+	}
+	handle_reports_batched(&batched, reports, batched_ticks);
+
+	// Make sure the data actually exercises the locked path.
+	REQUIRE(single.sync_lock);
+	CHECK((single.base[0].frame[0].sweep_ids | single.base[0].frame[1].sweep_ids) != 0);
+
+	CHECK(batched.sync_lock == single.sync_lock);
+	CHECK(batched.seen_by == single.seen_by);
+	CHECK(batched.last_timestamp == single.last_timestamp);
+	CHECK(batched.last_sync.timestamp == single.last_sync.timestamp);
+	CHECK(batched.last_sync.duration == single.last_sync.duration);
+	CHECK((batched.active_base - batched.base) == (single.active_base - single.base));
+	CHECK(memcmp(batched.base, single.base, sizeof(single.base)) == 0);
+	CHECK(batched_ticks == single_ticks);
+}
+
+TEST_CASE("lighthouse pulse replay throughput", "[.][benchmark]")
+{
+	std::vector<Report> reports = load_recorded_reports();
+	if (reports.empty()) {
+		reports = make_reports(make_pulses(4000, 32));
+	}
+
+	const int iterations = 20;
+
+	auto time_it = [&](bool batched) {
+		double total_ns = 0.0;
+		for (int i = 0; i < iterations; i++) {
+			lighthouse_watchman watchman;
+			init_watchman(&watchman);
+			std::vector<uint32_t> ticks;
+			ticks.reserve(reports.size());
+
+			auto start = std::chrono::steady_clock::now();
+			if (batched) {
+				handle_reports_batched(&watchman, reports, ticks);
+			} else {
+				for (const Report &r : reports) {
+					handle_report_per_pulse(&watchman, r, ticks);
+				}
+			}
+			auto end = std::chrono::steady_clock::now();
+
+			total_ns += std::chrono::duration<double, std::nano>(end - start).count();
+		}
+		return total_ns / ((double)iterations * (double)reports.size());
+	};
+
+	double single_ns = time_it(false);
+	double batched_ns = time_it(true);
+
+	WARN("ns per report over " << reports.size() << " reports, per pulse: " << single_ns
+	                           << ", batched: " << batched_ns);
+}